@@ -19,12 +19,21 @@
 #include <memory>
 #include <utility>
 #include <string>
+#include <map>
 #include "include/api/status.h"
 #include "include/api/context.h"
 namespace mindspore {
 struct RunnerConfig {
   std::shared_ptr<Context> context = nullptr;
   int workers_num = 0;
+  /// \brief The max batch size of the requests coalesced into one inference by the dynamic batching, the dynamic
+  /// batching is disabled if it is not greater than 1. Only the requests waiting for the busy workers are coalesced.
+  int max_batch_size = 0;
+  /// \brief The max time in microseconds that a request waits for the other requests to be batched with.
+  int max_batch_delay_us = 1000;
+  /// \brief The config sections in the format of Model::LoadConfig. The thread_cost_model section is applied once by
+  /// the pool before the workers start.
+  std::map<std::string, std::map<std::string, std::string>> config_info;
 };
 class ModelPool;
 
@@ -115,6 +115,7 @@ class BACKEND_EXPORT KernelGraph : public FuncGraph {
     first_step_ = graph.first_step_;
     has_optimizer_ = graph.has_optimizer_;
     is_dynamic_shape_ = graph.is_dynamic_shape_;
+    static_memory_arena_ = graph.static_memory_arena_;
   }
 
   ~KernelGraph() override;
@@ -417,6 +418,8 @@ class BACKEND_EXPORT KernelGraph : public FuncGraph {
   void set_is_executing_sink(bool is_executing_sink) { is_executing_sink_ = is_executing_sink; }
   bool is_loop_count_sink() const { return is_loop_count_sink_; }
   void set_is_loop_count_sink(bool is_loop_count_sink) { is_loop_count_sink_ = is_loop_count_sink; }
+  // The arena of the memory planned statically for the graph, which is released with the graph.
+  void set_static_memory_arena(const std::shared_ptr<void> &arena) { static_memory_arena_ = arena; }
   const mindspore::HashMap<AnfNodePtr, AnfNodePtr> &front_backend_anf_map() const { return front_backend_anf_map_; }
 
   AnfWithOutIndex GetElementInTupleBackendFrontIndexMap(const AnfNodePtr &back_node) const {
@@ -549,6 +552,8 @@ class BACKEND_EXPORT KernelGraph : public FuncGraph {
   bool is_executing_sink_{false};
   // Indicate whether the kernel graph loop sink to the device executing.
   bool is_loop_count_sink_{false};
+  // The arena of the memory planned statically, the deleter frees it to the device memory pool.
+  std::shared_ptr<void> static_memory_arena_{nullptr};
 };
 }  // namespace session
 using KernelGraphPtr = std::shared_ptr<session::KernelGraph>;
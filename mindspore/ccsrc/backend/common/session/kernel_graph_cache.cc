@@ -0,0 +1,270 @@
+/**
+ * Copyright 2022 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "backend/common/session/kernel_graph_cache.h"
+#include <sstream>
+#include "backend/common/session/anf_runtime_algorithm.h"
+#include "include/common/utils/anfalgo.h"
+
+namespace mindspore {
+namespace session {
+namespace {
+// Increase it when the layout of the json or the meaning of the stored enums changes.
+constexpr int kFormatVersion = 1;
+constexpr auto kVersion = "version";
+constexpr auto kFormatVersionKey = "format_version";
+constexpr auto kKernelBuildInfos = "kernel_build_infos";
+constexpr auto kMemoryPlans = "memory_plans";
+constexpr auto kKernelType = "kernel_type";
+constexpr auto kOpPattern = "op_pattern";
+constexpr auto kFusionType = "fusion_type";
+constexpr auto kProcessor = "processor";
+constexpr auto kCoreType = "core_type";
+constexpr auto kOriginDataFormat = "origin_data_format";
+constexpr auto kInputsFormat = "inputs_format";
+constexpr auto kOutputsFormat = "outputs_format";
+constexpr auto kInputsDeviceType = "inputs_device_type";
+constexpr auto kOutputsDeviceType = "outputs_device_type";
+constexpr auto kInputsReshapeType = "inputs_reshape_type";
+constexpr auto kOutputsReshapeType = "outputs_reshape_type";
+constexpr auto kSizes = "sizes";
+constexpr auto kOffsets = "offsets";
+
+kernel::KernelBuildInfoPtr CopyKernelBuildInfo(const kernel::KernelBuildInfoPtr &build_info) {
+  MS_EXCEPTION_IF_NULL(build_info);
+  auto builder = kernel::KernelBuildInfo::KernelBuildInfoBuilder(build_info);
+  builder.SetOriginDataFormat(build_info->GetOriginDataFormat());
+  return builder.Build();
+}
+
+nlohmann::json KernelBuildInfoToJson(const kernel::KernelBuildInfoPtr &build_info) {
+  MS_EXCEPTION_IF_NULL(build_info);
+  nlohmann::json build_info_json;
+  build_info_json[kKernelType] = static_cast<int>(build_info->kernel_type());
+  build_info_json[kOpPattern] = static_cast<int>(build_info->op_pattern());
+  build_info_json[kFusionType] = static_cast<int>(build_info->fusion_type());
+  build_info_json[kProcessor] = static_cast<int>(build_info->processor());
+  build_info_json[kCoreType] = build_info->core_type();
+  build_info_json[kOriginDataFormat] = build_info->GetOriginDataFormat();
+  build_info_json[kInputsFormat] = build_info->GetAllInputFormats();
+  build_info_json[kOutputsFormat] = build_info->GetAllOutputFormats();
+  std::vector<int> inputs_device_type;
+  for (const auto &type : build_info->GetAllInputDeviceTypes()) {
+    (void)inputs_device_type.emplace_back(static_cast<int>(type));
+  }
+  std::vector<int> outputs_device_type;
+  for (const auto &type : build_info->GetAllOutputDeviceTypes()) {
+    (void)outputs_device_type.emplace_back(static_cast<int>(type));
+  }
+  build_info_json[kInputsDeviceType] = inputs_device_type;
+  build_info_json[kOutputsDeviceType] = outputs_device_type;
+  build_info_json[kInputsReshapeType] = build_info->GetAllInputReshapeType();
+  build_info_json[kOutputsReshapeType] = build_info->GetAllOutputReshapeType();
+  return build_info_json;
+}
+
+kernel::KernelBuildInfoPtr KernelBuildInfoFromJson(const nlohmann::json &build_info_json) {
+  kernel::KernelBuildInfo::KernelBuildInfoBuilder builder;
+  builder.SetKernelType(static_cast<KernelType>(build_info_json.at(kKernelType).get<int>()));
+  builder.SetOpPattern(static_cast<kernel::OpPattern>(build_info_json.at(kOpPattern).get<int>()));
+  builder.SetFusionType(static_cast<kernel::FusionType>(build_info_json.at(kFusionType).get<int>()));
+  builder.SetProcessor(static_cast<kernel::Processor>(build_info_json.at(kProcessor).get<int>()));
+  builder.SetCoreType(build_info_json.at(kCoreType).get<std::string>());
+  builder.SetOriginDataFormat(build_info_json.at(kOriginDataFormat).get<std::string>());
+  builder.SetInputsFormat(build_info_json.at(kInputsFormat).get<std::vector<std::string>>());
+  builder.SetOutputsFormat(build_info_json.at(kOutputsFormat).get<std::vector<std::string>>());
+  std::vector<TypeId> inputs_device_type;
+  for (auto type : build_info_json.at(kInputsDeviceType).get<std::vector<int>>()) {
+    (void)inputs_device_type.emplace_back(static_cast<TypeId>(type));
+  }
+  std::vector<TypeId> outputs_device_type;
+  for (auto type : build_info_json.at(kOutputsDeviceType).get<std::vector<int>>()) {
+    (void)outputs_device_type.emplace_back(static_cast<TypeId>(type));
+  }
+  builder.SetInputsDeviceType(inputs_device_type);
+  builder.SetOutputsDeviceType(outputs_device_type);
+  builder.SetInputsReshapeType(build_info_json.at(kInputsReshapeType).get<std::vector<std::string>>());
+  builder.SetOutputsReshapeType(build_info_json.at(kOutputsReshapeType).get<std::vector<std::string>>());
+  return builder.Build();
+}
+}  // namespace
+
+KernelGraphCache &KernelGraphCache::GetInstance() {
+  static KernelGraphCache instance;
+  return instance;
+}
+
+std::string KernelGraphCache::GetKernelSignature(const CNodePtr &kernel) {
+  MS_EXCEPTION_IF_NULL(kernel);
+  std::ostringstream signature;
+  signature << common::AnfAlgo::GetCNodeName(kernel) << "(";
+  // The kernel select uses the selected device types of the input kernels, and the inferred types of the others.
+  size_t input_num = common::AnfAlgo::GetInputTensorNum(kernel);
+  for (size_t i = 0; i < input_num; ++i) {
+    auto input_node = common::AnfAlgo::VisitKernel(kernel->input(i + 1), 0).first;
+    MS_EXCEPTION_IF_NULL(input_node);
+    if (input_node->isa<Parameter>() || input_node->isa<ValueNode>()) {
+      signature << "p" << static_cast<int>(common::AnfAlgo::GetPrevNodeOutputInferDataType(kernel, i)) << ",";
+    } else {
+      signature << "k" << static_cast<int>(AnfAlgo::GetPrevNodeOutputDeviceDataType(kernel, i)) << ",";
+    }
+  }
+  signature << ")->(";
+  size_t output_num = common::AnfAlgo::GetOutputTensorNum(kernel);
+  for (size_t i = 0; i < output_num; ++i) {
+    signature << static_cast<int>(common::AnfAlgo::GetOutputInferDataType(kernel, i)) << ",";
+  }
+  signature << ")";
+  return signature.str();
+}
+
+kernel::KernelBuildInfoPtr KernelGraphCache::FetchKernelBuildInfo(const std::string &signature) const {
+  std::lock_guard<std::mutex> lock(mutex_);
+  const auto &iter = kernel_build_infos_.find(signature);
+  if (iter == kernel_build_infos_.end()) {
+    return nullptr;
+  }
+  // The build info of kernel may be modified by the passes after the kernel select, so the copy is returned.
+  return CopyKernelBuildInfo(iter->second);
+}
+
+std::pair<std::string, ExceptionType> KernelGraphCache::SelectKernelWithCache(const CNodePtr &kernel,
+                                                                            const KernelSelectFunc &select) {
+  MS_EXCEPTION_IF_NULL(kernel);
+  MS_EXCEPTION_IF_NULL(select);
+  if (!enable()) {
+    return select(kernel);
+  }
+  const auto &signature = GetKernelSignature(kernel);
+  auto build_info = FetchKernelBuildInfo(signature);
+  if (build_info != nullptr) {
+    AnfAlgo::SetSelectKernelBuildInfo(build_info, kernel.get());
+    return {};
+  }
+  auto result = select(kernel);
+  if (result.first.empty()) {
+    RecordKernelBuildInfo(signature, AnfAlgo::GetSelectKernelBuildInfo(kernel));
+  }
+  return result;
+}
+
+void KernelGraphCache::RecordKernelBuildInfo(const std::string &signature,
+                                             const kernel::KernelBuildInfoPtr &build_info) {
+  MS_EXCEPTION_IF_NULL(build_info);
+  std::lock_guard<std::mutex> lock(mutex_);
+  kernel_build_infos_[signature] = CopyKernelBuildInfo(build_info);
+}
+
+bool KernelGraphCache::FetchMemoryPlan(const std::string &signature, const std::vector<size_t> &sizes,
+                                       std::vector<size_t> *offsets) const {
+  MS_EXCEPTION_IF_NULL(offsets);
+  std::lock_guard<std::mutex> lock(mutex_);
+  const auto &iter = memory_plans_.find(signature);
+  if (iter == memory_plans_.end()) {
+    return false;
+  }
+  if (iter->second.sizes != sizes) {
+    MS_LOG(WARNING) << "The memory block sizes of the cached memory plan " << signature << " mismatch.";
+    return false;
+  }
+  *offsets = iter->second.offsets;
+  return true;
+}
+
+void KernelGraphCache::RecordMemoryPlan(const std::string &signature, const std::vector<size_t> &sizes,
+                                        const std::vector<size_t> &offsets) {
+  if (sizes.size() != offsets.size()) {
+    MS_LOG(EXCEPTION) << "The size of memory block sizes " << sizes.size() << " is not equal to the size of offsets "
+                      << offsets.size();
+  }
+  std::lock_guard<std::mutex> lock(mutex_);
+  memory_plans_[signature] = {sizes, offsets};
+}
+
+nlohmann::json KernelGraphCache::ToJson() const {
+  std::lock_guard<std::mutex> lock(mutex_);
+  nlohmann::json build_infos_json = nlohmann::json::object();
+  for (const auto &build_info : kernel_build_infos_) {
+    build_infos_json[build_info.first] = KernelBuildInfoToJson(build_info.second);
+  }
+  nlohmann::json memory_plans_json = nlohmann::json::object();
+  for (const auto &memory_plan : memory_plans_) {
+    nlohmann::json memory_plan_json;
+    memory_plan_json[kSizes] = memory_plan.second.sizes;
+    memory_plan_json[kOffsets] = memory_plan.second.offsets;
+    memory_plans_json[memory_plan.first] = memory_plan_json;
+  }
+  nlohmann::json cache_json;
+  cache_json[kVersion] = MSVERSION;
+  cache_json[kFormatVersionKey] = kFormatVersion;
+  cache_json[kKernelBuildInfos] = build_infos_json;
+  cache_json[kMemoryPlans] = memory_plans_json;
+  return cache_json;
+}
+
+bool KernelGraphCache::FromJson(const nlohmann::json &cache_json) {
+  std::map<std::string, kernel::KernelBuildInfoPtr> build_infos;
+  std::map<std::string, MemoryPlan> memory_plans;
+  try {
+    const auto &version = cache_json.at(kVersion).get<std::string>();
+    auto format_version = cache_json.at(kFormatVersionKey).get<int>();
+    if (version != MSVERSION || format_version != kFormatVersion) {
+      MS_LOG(WARNING) << "The kernel graph cache is generated by MindSpore " << version << " of format version "
+                      << format_version << ", which mismatches the current " << MSVERSION << " of format version "
+                      << kFormatVersion;
+      return false;
+    }
+    for (const auto &item : cache_json.at(kKernelBuildInfos).items()) {
+      build_infos[item.key()] = KernelBuildInfoFromJson(item.value());
+    }
+    for (const auto &item : cache_json.at(kMemoryPlans).items()) {
+      MemoryPlan memory_plan;
+      memory_plan.sizes = item.value().at(kSizes).get<std::vector<size_t>>();
+      memory_plan.offsets = item.value().at(kOffsets).get<std::vector<size_t>>();
+      if (memory_plan.sizes.size() != memory_plan.offsets.size()) {
+        MS_LOG(WARNING) << "The cached memory plan " << item.key() << " is invalid.";
+        return false;
+      }
+      memory_plans[item.key()] = memory_plan;
+    }
+  } catch (const std::exception &e) {
+    MS_LOG(WARNING) << "Parse the kernel graph cache failed: " << e.what();
+    return false;
+  }
+
+  std::lock_guard<std::mutex> lock(mutex_);
+  kernel_build_infos_.insert(build_infos.begin(), build_infos.end());
+  memory_plans_.insert(memory_plans.begin(), memory_plans.end());
+  return true;
+}
+
+size_t KernelGraphCache::kernel_build_info_num() const {
+  std::lock_guard<std::mutex> lock(mutex_);
+  return kernel_build_infos_.size();
+}
+
+size_t KernelGraphCache::memory_plan_num() const {
+  std::lock_guard<std::mutex> lock(mutex_);
+  return memory_plans_.size();
+}
+
+void KernelGraphCache::Clear() {
+  std::lock_guard<std::mutex> lock(mutex_);
+  kernel_build_infos_.clear();
+  memory_plans_.clear();
+}
+}  // namespace session
+}  // namespace mindspore
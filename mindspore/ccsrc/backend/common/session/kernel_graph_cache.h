@@ -0,0 +1,92 @@
+/**
+ * Copyright 2022 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef MINDSPORE_CCSRC_BACKEND_SESSION_KERNEL_GRAPH_CACHE_H_
+#define MINDSPORE_CCSRC_BACKEND_SESSION_KERNEL_GRAPH_CACHE_H_
+
+#include <functional>
+#include <map>
+#include <mutex>
+#include <string>
+#include <utility>
+#include <vector>
+#include <nlohmann/json.hpp>
+#include "ir/anf.h"
+#include "kernel/kernel_build_info.h"
+#include "utils/ms_utils.h"
+#include "include/backend/visible.h"
+
+namespace mindspore {
+namespace session {
+// The cache of the cpu backend compile results which only depend on the graph structure: the kernel build info chosen
+// by the cpu kernel select and the static memory plan of the cpu graphs. The kernel graph itself isn't serialized,
+// since its front nodes and node ids are regenerated every time, so the results are keyed by the signatures of the
+// kernels and graphs instead. The other backend passes, the graph kernel fusion and building the actors are still run
+// on the warm start. The compile cache of the pipeline exports the records after compiling graph and imports them on
+// the warm start, it enables the cache only while compiling the graph.
+class BACKEND_EXPORT KernelGraphCache {
+ public:
+  static KernelGraphCache &GetInstance();
+
+  void set_enable(bool enable) { enable_ = enable; }
+  bool enable() const { return enable_; }
+
+  // The signature of kernel for the kernel select, which consists of the op name and the inferred types of the
+  // inputs and outputs.
+  static std::string GetKernelSignature(const CNodePtr &kernel);
+
+  // Set the kernel build info from the cache if the signature of kernel hits, otherwise select it by the select
+  // function and record the result. The select function returns the error message, which is empty on success.
+  using KernelSelectFunc = std::function<std::pair<std::string, ExceptionType>(const CNodePtr &)>;
+  std::pair<std::string, ExceptionType> SelectKernelWithCache(const CNodePtr &kernel, const KernelSelectFunc &select);
+
+  // Return a copy of the cached kernel build info, or nullptr if the signature misses.
+  kernel::KernelBuildInfoPtr FetchKernelBuildInfo(const std::string &signature) const;
+  void RecordKernelBuildInfo(const std::string &signature, const kernel::KernelBuildInfoPtr &build_info);
+
+  // Fetch the offsets of the memory plan, which fails if the sizes of the memory blocks are not the recorded ones.
+  bool FetchMemoryPlan(const std::string &signature, const std::vector<size_t> &sizes,
+                       std::vector<size_t> *offsets) const;
+  void RecordMemoryPlan(const std::string &signature, const std::vector<size_t> &sizes,
+                        const std::vector<size_t> &offsets);
+
+  // The json is tagged by the version of MindSpore and the format version, since the enums are stored as integers.
+  nlohmann::json ToJson() const;
+  // Merge the records of json into the cache, return false if the json is invalid or from another version.
+  bool FromJson(const nlohmann::json &cache_json);
+
+  size_t kernel_build_info_num() const;
+  size_t memory_plan_num() const;
+  void Clear();
+
+ private:
+  KernelGraphCache() = default;
+  ~KernelGraphCache() = default;
+  DISABLE_COPY_AND_ASSIGN(KernelGraphCache);
+
+  struct MemoryPlan {
+    std::vector<size_t> sizes;
+    std::vector<size_t> offsets;
+  };
+
+  bool enable_{false};
+  mutable std::mutex mutex_;
+  std::map<std::string, kernel::KernelBuildInfoPtr> kernel_build_infos_;
+  std::map<std::string, MemoryPlan> memory_plans_;
+};
+}  // namespace session
+}  // namespace mindspore
+#endif  // MINDSPORE_CCSRC_BACKEND_SESSION_KERNEL_GRAPH_CACHE_H_
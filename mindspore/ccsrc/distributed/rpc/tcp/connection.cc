@@ -154,7 +154,8 @@ Connection::Connection()
   send_kernel_msg.msg_flags = 0;
   send_kernel_msg.msg_name = nullptr;
   send_kernel_msg.msg_namelen = 0;
-  send_kernel_msg.msg_iov = send_io_vec;
+  send_io_vec.resize(SEND_MSG_IO_VEC_LEN);
+  send_kernel_msg.msg_iov = send_io_vec.data();
   send_kernel_msg.msg_iovlen = SEND_MSG_IO_VEC_LEN;
 }
 
@@ -322,12 +323,18 @@ std::string Connection::GenerateHttpMessage(MessageBase *msg) {
 
 void Connection::FillSendMessage(MessageBase *msg, const std::string &advertiseUrl, bool isHttpKmsg) {
   if (msg->type == MessageBase::Type::KMSG) {
-    int index = 0;
+    if (isHttpKmsg || msg->body_buffers.size() + SEND_MSG_IO_VEC_LEN > MAX_SEND_MSG_IO_VEC_LEN) {
+      msg->GatherBody();
+    }
+    size_t body_size = msg->BodySize();
+    size_t index = 0;
     if (!isHttpKmsg) {
       send_to = msg->to;
       send_from = msg->from;
       FillMessageHeader(*msg, &send_msg_header);
 
+      // The external buffers of the body are sent by the scatter-gather io without copying.
+      send_io_vec.resize(SEND_MSG_IO_VEC_LEN + msg->body_buffers.size());
       send_io_vec[index].iov_base = &send_msg_header;
       send_io_vec[index].iov_len = sizeof(send_msg_header);
       ++index;
@@ -343,14 +350,19 @@ void Connection::FillSendMessage(MessageBase *msg, const std::string &advertiseU
       send_io_vec[index].iov_base = const_cast<char *>(msg->body.data());
       send_io_vec[index].iov_len = msg->body.size();
       ++index;
-      send_kernel_msg.msg_iov = send_io_vec;
+      for (const auto &buffer : msg->body_buffers) {
+        send_io_vec[index].iov_base = buffer.data;
+        send_io_vec[index].iov_len = buffer.size;
+        ++index;
+      }
+      send_kernel_msg.msg_iov = send_io_vec.data();
       send_kernel_msg.msg_iovlen = index;
       total_send_len =
-        UlongToUint(sizeof(send_msg_header)) + msg->name.size() + send_to.size() + send_from.size() + msg->body.size();
+        UlongToUint(sizeof(send_msg_header)) + msg->name.size() + send_to.size() + send_from.size() + body_size;
       send_message = msg;
 
       // update metrics
-      send_metrics->UpdateMax(msg->body.size());
+      send_metrics->UpdateMax(body_size);
       send_metrics->last_send_msg_name = msg->name;
       return;
     } else {
@@ -368,7 +380,7 @@ void Connection::FillSendMessage(MessageBase *msg, const std::string &advertiseU
     send_io_vec[index].iov_base = const_cast<char *>(msg->body.data());
     send_io_vec[index].iov_len = msg->body.size();
     ++index;
-    send_kernel_msg.msg_iov = send_io_vec;
+    send_kernel_msg.msg_iov = send_io_vec.data();
     send_kernel_msg.msg_iovlen = index;
     total_send_len = UlongToUint(msg->body.size());
     send_message = msg;
@@ -437,8 +449,8 @@ int Connection::Flush() {
         // update metrics
         send_metrics->UpdateError(false);
 
-        output_buffer_size -= send_message->body.size();
-        total_send_bytes += send_message->body.size();
+        output_buffer_size -= send_message->BodySize();
+        total_send_bytes += send_message->BodySize();
         delete send_message;
         send_message = nullptr;
         break;
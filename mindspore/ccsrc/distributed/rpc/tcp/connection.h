@@ -21,6 +21,7 @@
 #include <string>
 #include <mutex>
 #include <memory>
+#include <vector>
 
 #include "actor/msg.h"
 #include "distributed/rpc/tcp/constants.h"
@@ -176,7 +177,8 @@ struct Connection {
   struct msghdr recv_kernel_msg;
 
   struct iovec recv_io_vec[RECV_MSG_IO_VEC_LEN];
-  struct iovec send_io_vec[SEND_MSG_IO_VEC_LEN];
+  // The header, name, to, from and body of the message, followed by the external buffers of the body.
+  std::vector<struct iovec> send_io_vec;
 
   ParseType recv_message_type{kTcpMsg};
 
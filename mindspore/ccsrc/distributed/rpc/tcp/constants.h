@@ -35,6 +35,9 @@ using DeleteCallBack = void (*)(const std::string &from, const std::string &to);
 using ConnectionCallBack = void (*)(void *conn);
 
 constexpr int SEND_MSG_IO_VEC_LEN = 5;
+// The max io vector number of a sendmsg call(IOV_MAX on linux), the message referencing more external buffers than it
+// is sent with its body gathered.
+constexpr size_t MAX_SEND_MSG_IO_VEC_LEN = 1024;
 constexpr int RECV_MSG_IO_VEC_LEN = 4;
 
 constexpr unsigned int BUSMAGIC_LEN = 4;
@@ -122,14 +125,14 @@ __attribute__((unused)) static void FillMessageHeader(const MessageBase &message
   header->name_len = htonl(static_cast<uint32_t>(message.name.size()));
   header->to_len = htonl(static_cast<uint32_t>(send_to.size()));
   header->from_len = htonl(static_cast<uint32_t>(send_from.size()));
-  header->body_len = htonl(static_cast<uint32_t>(message.body.size()));
+  header->body_len = htonl(static_cast<uint32_t>(message.BodySize()));
 }
 
 // Compute and return the byte size of the whole message.
 __attribute__((unused)) static size_t GetMessageSize(const MessageBase &message) {
   std::string send_to = message.to;
   std::string send_from = message.from;
-  size_t size = message.name.size() + send_to.size() + send_from.size() + message.body.size() + sizeof(MessageHeader);
+  size_t size = message.name.size() + send_to.size() + send_from.size() + message.BodySize() + sizeof(MessageHeader);
   return size;
 }
 
@@ -69,10 +69,23 @@ PYBIND_REGISTER(ConfigManager, 0, ([](const py::module *m) {
                     .def("get_enable_autotune", &ConfigManager::enable_autotune)
                     .def("set_autotune_interval", &ConfigManager::set_autotune_interval)
                     .def("get_autotune_interval", &ConfigManager::autotune_interval)
+                    .def("set_enable_autotune_model", &ConfigManager::set_enable_autotune_model)
+                    .def("get_enable_autotune_model", &ConfigManager::enable_autotune_model)
                     .def("set_enable_watchdog", &ConfigManager::set_enable_watchdog)
                     .def("get_enable_watchdog", &ConfigManager::enable_watchdog)
                     .def("set_multiprocessing_timeout_interval", &ConfigManager::set_multiprocessing_timeout_interval)
                     .def("get_multiprocessing_timeout_interval", &ConfigManager::multiprocessing_timeout_interval)
+                    .def("set_enable_tf_reader_mmap", &ConfigManager::set_enable_tf_reader_mmap)
+                    .def("get_enable_tf_reader_mmap", &ConfigManager::enable_tf_reader_mmap)
+                    .def("set_tf_reader_verify_crc", &ConfigManager::set_tf_reader_verify_crc)
+                    .def("get_tf_reader_verify_crc", &ConfigManager::tf_reader_verify_crc)
+                    .def("set_enable_lock_free_queue", &ConfigManager::set_enable_lock_free_queue)
+                    .def("get_enable_lock_free_queue", &ConfigManager::enable_lock_free_queue)
+                    .def("set_row_batch_size",
+                         [](ConfigManager &c, int32_t size) { THROW_IF_ERROR(c.set_row_batch_size(size)); })
+                    .def("get_row_batch_size", &ConfigManager::row_batch_size)
+                    .def("set_enable_mindrecord_index_snapshot", &ConfigManager::set_enable_mindrecord_index_snapshot)
+                    .def("get_enable_mindrecord_index_snapshot", &ConfigManager::enable_mindrecord_index_snapshot)
                     .def("load", [](ConfigManager &c, const std::string &s) { THROW_IF_ERROR(c.LoadFile(s)); });
                 }));
 
@@ -15,6 +15,9 @@
  */
 
 #include <optional>
+#include <string>
+#include <utility>
+#include <vector>
 #include "minddata/dataset/api/python/pybind_register.h"
 #include "minddata/dataset/engine/cache/cache_client.h"
 
@@ -25,7 +28,8 @@ PYBIND_REGISTER(CacheClient, 0, ([](const py::module *m) {
                   (void)py::class_<CacheClient, std::shared_ptr<CacheClient>>(*m, "CacheClient")
                     .def(py::init([](session_id_type id, uint64_t mem_sz, bool spill,
                                      std::optional<std::string> hostname, std::optional<int32_t> port,
-                                     std::optional<int32_t> num_connections, std::optional<int32_t> prefetch_sz) {
+                                     std::optional<int32_t> num_connections, std::optional<int32_t> prefetch_sz,
+                                     std::optional<std::vector<std::pair<std::string, int32_t>>> servers) {
                       std::shared_ptr<CacheClient> cc;
                       CacheClient::Builder builder;
                       builder.SetSessionId(id).SetCacheMemSz(mem_sz).SetSpill(spill);
@@ -33,6 +37,7 @@ PYBIND_REGISTER(CacheClient, 0, ([](const py::module *m) {
                       if (port) builder.SetPort(port.value());
                       if (num_connections) builder.SetNumConnections(num_connections.value());
                       if (prefetch_sz) builder.SetPrefetchSize(prefetch_sz.value());
+                      if (servers) builder.SetServers(servers.value());
                       THROW_IF_ERROR(builder.Build(&cc));
                       return cc;
                     }))
@@ -517,7 +517,11 @@ PYBIND_REGISTER(
         minddata->SetSampleBytes(&sample_bytes);
         THROW_IF_ERROR(minddata->ValidateParams());
         return minddata;
-      }));
+      }))
+      .def("set_io_mode", [](MindDataNode &self, int32_t io_mode, int32_t io_queue_depth) {
+        self.SetIoMode(static_cast<mindrecord::IoMode>(io_mode), io_queue_depth);
+        THROW_IF_ERROR(self.ValidateParams());
+      });
   }));
 
 PYBIND_REGISTER(MnistNode, 2, ([](const py::module *m) {
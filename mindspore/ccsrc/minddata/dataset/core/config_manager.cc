@@ -57,8 +57,14 @@ ConfigManager::ConfigManager()
       enable_autotune_(false),
       save_autoconfig_(false),
       autotune_interval_(kCfgAutoTuneInterval),
+      enable_autotune_model_(false),
       enable_watchdog_(true),
-      multiprocessing_timeout_interval_(kCfgMultiprocessingTimeoutInterval) {
+      multiprocessing_timeout_interval_(kCfgMultiprocessingTimeoutInterval),
+      enable_tf_reader_mmap_(false),
+      tf_reader_verify_crc_(false),
+      enable_lock_free_queue_(false),
+      enable_mindrecord_index_snapshot_(false),
+      row_batch_size_(0) {
   autotune_json_filepath_ = kEmptyString;
   num_cpu_threads_ = num_cpu_threads_ > 0 ? num_cpu_threads_ : std::numeric_limits<uint16_t>::max();
   num_parallel_workers_ = num_parallel_workers_ < num_cpu_threads_ ? num_parallel_workers_ : num_cpu_threads_;
@@ -138,6 +144,17 @@ Status ConfigManager::set_num_parallel_workers(int32_t num_parallel_workers) {
   return Status::OK();
 }
 
+// Setter function
+Status ConfigManager::set_row_batch_size(int32_t row_batch_size) {
+  if (row_batch_size < 0 || row_batch_size > kMaxRowBatchSize) {
+    std::string err_msg = "Invalid Parameter, row_batch_size exceeds the boundary between 0 and " +
+                          std::to_string(kMaxRowBatchSize) + ", as got " + std::to_string(row_batch_size) + ".";
+    LOG_AND_RETURN_STATUS_SYNTAX_ERROR(err_msg);
+  }
+  row_batch_size_ = row_batch_size;
+  return Status::OK();
+}
+
 // Setter function
 void ConfigManager::set_worker_connector_size(int32_t connector_size) { worker_connector_size_ = connector_size; }
 
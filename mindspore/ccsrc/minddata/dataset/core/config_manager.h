@@ -251,6 +251,15 @@ class ConfigManager {
   // @return - The final AutoTune configuration JSON filepath
   std::string get_autotune_json_filepath() { return autotune_json_filepath_; }
 
+  // setter function
+  // @param enable - To let AutoTune solve the workers and queue sizes of all ops from a throughput model instead of
+  //     adjusting one op at a time
+  void set_enable_autotune_model(bool enable) { enable_autotune_model_ = enable; }
+
+  // getter function
+  // @return - Flag to indicate whether AutoTune uses the throughput model
+  bool enable_autotune_model() const { return enable_autotune_model_; }
+
   // getter function
   // @return - autotune interval in steps
   int64_t autotune_interval() const { return autotune_interval_; }
@@ -275,6 +284,48 @@ class ConfigManager {
   // @param interval - multiprocessing timeout interval in seconds
   void set_multiprocessing_timeout_interval(uint32_t interval) { multiprocessing_timeout_interval_ = interval; }
 
+  // setter function
+  // @param enable - To let TFRecordDataset read the files through memory mapping instead of ifstream
+  void set_enable_tf_reader_mmap(bool enable) { enable_tf_reader_mmap_ = enable; }
+
+  // getter function
+  // @return - Flag to indicate whether TFRecordDataset reads the files through memory mapping
+  bool enable_tf_reader_mmap() const { return enable_tf_reader_mmap_; }
+
+  // setter function
+  // @param verify - To verify the masked crc of each record when TFRecordDataset reads through memory mapping
+  void set_tf_reader_verify_crc(bool verify) { tf_reader_verify_crc_ = verify; }
+
+  // getter function
+  // @return - Flag to indicate whether the crc of each tfrecord is verified by the memory mapped reader
+  bool tf_reader_verify_crc() const { return tf_reader_verify_crc_; }
+
+  // setter function
+  // @param enable - To back the connectors and worker queues with lock-free ring buffers
+  void set_enable_lock_free_queue(bool enable) { enable_lock_free_queue_ = enable; }
+
+  // getter function
+  // @return - Flag to indicate whether the connectors and worker queues are lock-free ring buffers
+  bool enable_lock_free_queue() const { return enable_lock_free_queue_; }
+
+  // setter function
+  // @param enable - To load the MindRecord index from the snapshot next to each file, and create it if missing
+  void set_enable_mindrecord_index_snapshot(bool enable) { enable_mindrecord_index_snapshot_ = enable; }
+
+  // getter function
+  // @return - Flag to indicate whether MindRecordOp loads the index from the snapshot next to each file
+  bool enable_mindrecord_index_snapshot() const { return enable_mindrecord_index_snapshot_; }
+
+  // setter function
+  // @param row_batch_size - Number of rows the ops opting in hand over to the next op at once, 0 or 1 to disable,
+  //     at most kMaxRowBatchSize
+  // @return Status error code
+  Status set_row_batch_size(int32_t row_batch_size);
+
+  // getter function
+  // @return - Number of rows the ops opting in hand over to the next op at once
+  int32_t row_batch_size() const { return row_batch_size_; }
+
  private:
   // Private helper function that takes a nlohmann json format and populates the settings
   // @param j - The json nlohmann json info
@@ -305,9 +356,15 @@ class ConfigManager {
   bool enable_autotune_;
   bool save_autoconfig_;  // True if should save AutoTune configuration
   int64_t autotune_interval_;
+  bool enable_autotune_model_;                 // AutoTune solves the configuration from a throughput model
   bool enable_watchdog_;                       // Watchdog python thread enabled flag
   uint32_t multiprocessing_timeout_interval_;  // Multiprocessing timeout interval in seconds
   std::string autotune_json_filepath_;         // Filepath name of the final AutoTune Configuration JSON file
+  bool enable_tf_reader_mmap_;                 // TFReaderOp reads files through mmap instead of ifstream
+  bool tf_reader_verify_crc_;                  // TFReaderOp verifies record crc in mmap mode
+  bool enable_lock_free_queue_;                // Connectors and worker queues use lock-free ring buffers
+  bool enable_mindrecord_index_snapshot_;      // MindRecordOp loads the index from a snapshot instead of sqlite
+  int32_t row_batch_size_;                     // Rows handed over at once between ops, 0 or 1 for one by one
 };
 }  // namespace dataset
 }  // namespace mindspore
@@ -27,9 +27,8 @@ const int kYuvDefaultChannels = 4;
 
 DeviceTensor::DeviceTensor(const TensorShape &shape, const DataType &type)
     : Tensor(shape, type), device_data_(nullptr), size_(0) {
-  // grab the mem pool from global context and create the allocator for char data area
-  std::shared_ptr<MemoryPool> global_pool = GlobalContext::Instance()->mem_pool();
-  data_allocator_ = std::make_unique<Allocator<unsigned char>>(global_pool);
+  // grab the mem pool from global context for the char data area
+  data_pool_ = GlobalContext::Instance()->mem_pool();
   device_data_type_ = type;
   host_data_tensor_ = nullptr;
 }
@@ -28,6 +28,7 @@
 #include "minddata/dataset/engine/perf/profiling.h"
 #endif
 #include "minddata/dataset/util/allocator.h"
+#include "minddata/dataset/util/size_class_pool.h"
 #include "minddata/dataset/util/system_pool.h"
 
 namespace mindspore {
@@ -56,8 +57,8 @@ GlobalContext *GlobalContext::Instance() {
 
 Status GlobalContext::Init() {
   config_manager_ = std::make_shared<ConfigManager>();
-  mem_pool_ = std::make_shared<SystemPool>();
-  // For testing we can use Dummy pool instead
+  // Tensor buffers are recycled through size classes instead of going to the system allocator every time
+  mem_pool_ = std::make_shared<SizeClassPool>(std::make_shared<SystemPool>());
 
   // Create some tensor allocators for the different types and hook them into the pool.
   tensor_allocator_ = std::make_unique<Allocator<Tensor>>(mem_pool_);
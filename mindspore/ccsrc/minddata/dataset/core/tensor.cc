@@ -64,9 +64,8 @@ namespace dataset {
   }
 
 Tensor::Tensor(const TensorShape &shape, const DataType &type) : shape_(shape), type_(type), data_(nullptr) {
-  // grab the mem pool from global context and create the allocator for char data area
-  std::shared_ptr<MemoryPool> global_pool = GlobalContext::Instance()->mem_pool();
-  data_allocator_ = std::make_unique<Allocator<unsigned char>>(global_pool);
+  // grab the mem pool from global context for the char data area
+  data_pool_ = GlobalContext::Instance()->mem_pool();
 }
 
 Tensor::Tensor(Tensor &&other) noexcept
@@ -74,7 +73,7 @@ Tensor::Tensor(Tensor &&other) noexcept
       type_(other.type()),
       data_(other.GetMutableBuffer()),
       data_end_(other.data_end_),
-      data_allocator_(std::move(other.data_allocator_)) {
+      data_pool_(std::move(other.data_pool_)) {
   other.Invalidate();
 }
 
@@ -84,7 +83,7 @@ Tensor &Tensor::operator=(Tensor &&other) noexcept {
     type_ = other.type();
     data_ = other.GetMutableBuffer();
     data_end_ = other.data_end_;
-    data_allocator_ = std::move(other.data_allocator_);
+    data_pool_ = std::move(other.data_pool_);
     yuv_shape_ = other.yuv_shape_;
     other.Invalidate();
   }
@@ -241,7 +240,7 @@ Status Tensor::CreateFromByteList(const dataengine::BytesList &bytes_list, const
   // strings will be null-terminated --> need 1 extra byte per element
   dsize_t num_bytes = (kOffsetSize) * (*out)->shape_.NumOfElements() + kOffsetSize + bytes_list.ByteSizeLong();
 
-  (*out)->data_ = (*out)->data_allocator_->allocate(num_bytes);
+  RETURN_IF_NOT_OK((*out)->AllocateBuffer(num_bytes));
 
   auto offset_arr = reinterpret_cast<offset_t *>((*out)->data_);
   uchar *buf = (*out)->GetStringsBuffer();
@@ -368,8 +367,8 @@ Status Tensor::CopyStridedArray(unsigned char *dst, unsigned char *src, std::vec
 // Description: Destructor
 Tensor::~Tensor() {
   if (data_ != nullptr) {
-    if (data_allocator_ != nullptr) {
-      data_allocator_->deallocate(data_);
+    if (data_pool_ != nullptr) {
+      data_pool_->Deallocate(data_);
       data_ = nullptr;
       data_end_ = nullptr;
     } else {
@@ -481,10 +480,12 @@ void Tensor::PrintData(std::ostream &out) const {
 }
 
 Status Tensor::AllocateBuffer(const dsize_t &length) {
-  RETURN_UNEXPECTED_IF_NULL(data_allocator_);
+  RETURN_UNEXPECTED_IF_NULL(data_pool_);
   if (data_ == nullptr) {
-    data_ = data_allocator_->allocate(length);
-    CHECK_FAIL_RETURN_UNEXPECTED(data_ != nullptr, "Failed to allocate memory for tensor.");
+    void *buf = nullptr;
+    RETURN_IF_NOT_OK(data_pool_->Allocate(static_cast<size_t>(length), &buf));
+    CHECK_FAIL_RETURN_UNEXPECTED(buf != nullptr, "Failed to allocate memory for tensor.");
+    data_ = static_cast<unsigned char *>(buf);
     data_end_ = data_ + length;
   }
   return Status::OK();
@@ -505,7 +506,7 @@ void Tensor::Invalidate() {
   type_ = DataType(DataType::DE_UNKNOWN);
   data_ = nullptr;
   data_end_ = nullptr;
-  data_allocator_ = nullptr;
+  data_pool_ = nullptr;
 }
 
 template <typename T>
@@ -843,7 +844,10 @@ Status Tensor::GetDataAsNumpyStrings(py::array *data) {
   // if all strings are empty, numpy stores a byte for each string |S1
   max_value = (max_value == 0 ? 1 : max_value);
   uint64_t total_size = shape_.NumOfElements() * max_value;
-  char *tmp_data = reinterpret_cast<char *>(data_allocator_->allocate(total_size));
+  RETURN_UNEXPECTED_IF_NULL(data_pool_);
+  void *tmp_buf = nullptr;
+  RETURN_IF_NOT_OK(data_pool_->Allocate(total_size, &tmp_buf));
+  char *tmp_data = static_cast<char *>(tmp_buf);
   if (tmp_data == nullptr) {
     RETURN_STATUS_UNEXPECTED("Cannot create temp array.");
   }
@@ -862,7 +866,7 @@ Status Tensor::GetDataAsNumpyStrings(py::array *data) {
   (void)std::transform(strides.begin(), strides.end(), strides.begin(),
                        [&max_value](const auto &s) { return s * max_value; });
   *data = py::array(py::dtype("S" + std::to_string(max_value)), shape_.AsVector(), strides, tmp_data);
-  data_allocator_->deallocate(reinterpret_cast<uchar *>(tmp_data));
+  data_pool_->Deallocate(tmp_data);
   return Status::OK();
 }
 #endif
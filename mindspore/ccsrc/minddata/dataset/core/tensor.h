@@ -54,10 +54,10 @@ namespace py = pybind11;
 namespace mindspore {
 namespace dataset {
 class Tensor;
+class MemoryPool;
 template <typename T>
 class Allocator;
 
-using CharAllocPtr = std::unique_ptr<Allocator<unsigned char>>;
 using TensorAllocPtr = std::shared_ptr<Allocator<Tensor>>;  // An allocator shared_ptr for Tensors
 using offset_t = uint32_t;                                  // type of offset values to store strings locations
 using TensorPtr = std::shared_ptr<Tensor>;
@@ -728,8 +728,8 @@ class Tensor {
   DataType type_;
   /// pointer to the start of the physical data
   unsigned char *data_;
-  /// An allocator for data_
-  CharAllocPtr data_allocator_;
+  /// The pool data_ is allocated from
+  std::shared_ptr<MemoryPool> data_pool_;
   /// pointer to the end of the physical data
   unsigned char *data_end_ = nullptr;
 
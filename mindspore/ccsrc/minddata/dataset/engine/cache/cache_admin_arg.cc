@@ -281,12 +281,6 @@ Status CacheAdminArgHandler::ParseArgStream(std::stringstream *arg_stream) {
     switch (arg_map_[tok]) {
       case ArgValue::kArgHost: {
         RETURN_IF_NOT_OK(AssignArg(tok, &hostname_, arg_stream));
-        // Temporary sanity check. We only support localhost for now
-        if (hostname_ != std::string(kCfgDefaultCacheHost)) {
-          std::string err_msg =
-            "Invalid host interface: " + hostname_ + ". Current limitation, only 127.0.0.1 can be used.";
-          return Status(StatusCode::kMDSyntaxError, err_msg);
-        }
         break;
       }
       case ArgValue::kArgPort: {
@@ -642,7 +636,7 @@ Status CacheAdminArgHandler::StartServer() {
     std::string daemonize_string = "true";
     std::string memory_cap_ratio_string = std::to_string(memory_cap_ratio_);
 
-    char *argv[9];
+    char *argv[10];
     argv[0] = cache_server_binary.data();
     argv[1] = spill_dir_.data();
     argv[2] = workers_string.data();
@@ -651,7 +645,8 @@ Status CacheAdminArgHandler::StartServer() {
     argv[5] = minloglevel_string.data();
     argv[6] = daemonize_string.data();
     argv[7] = memory_cap_ratio_string.data();
-    argv[8] = nullptr;
+    argv[8] = hostname_.data();
+    argv[9] = nullptr;
 
     // Now exec the binary
     execv(cache_server_binary.data(), argv);
@@ -667,6 +662,7 @@ void CacheAdminArgHandler::Help() {
   std::cerr << "Syntax:\n";
   std::cerr << "cache_admin [--start | --stop]\n";
   std::cerr << "                [[-h | --hostname] <hostname>]            Default is " << kCfgDefaultCacheHost << ".\n";
+  std::cerr << "                                                          No auth on a non-loopback interface.\n";
   std::cerr << "                [[-p | --port] <port number>]             Default is " << kCfgDefaultCachePort << ".\n";
   std::cerr << "                [[-w | --workers] <number of workers>]    Default is " << kDefaultNumWorkers << ".\n";
   std::cerr << "                [[-s | --spilldir] <spilling directory>]  Default is no spilling.\n";
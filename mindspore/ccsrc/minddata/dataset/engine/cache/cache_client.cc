@@ -14,6 +14,7 @@
  * limitations under the License.
  */
 
+#include <algorithm>
 #include <iomanip>
 #include "minddata/dataset/engine/cache/cache_client.h"
 #include "minddata/dataset/engine/cache/cache_request.h"
@@ -37,6 +38,15 @@ Status CacheClient::Builder::Build(std::shared_ptr<CacheClient> *out) {
   RETURN_IF_NOT_OK(SanityCheck());
   *out = std::make_shared<CacheClient>(session_id_, cache_mem_sz_, spill_, hostname_, port_, num_connections_,
                                        prefetch_size_);
+  if (!servers_.empty()) {
+    std::vector<std::shared_ptr<CacheClient>> shards;
+    shards.reserve(servers_.size());
+    for (const auto &server : servers_) {
+      shards.push_back(std::make_shared<CacheClient>(session_id_, cache_mem_sz_, spill_, server.first, server.second,
+                                                     num_connections_, prefetch_size_));
+    }
+    RETURN_IF_NOT_OK((*out)->SetShards(std::move(shards)));
+  }
   return Status::OK();
 }
 
@@ -48,8 +58,15 @@ Status CacheClient::Builder::SanityCheck() {
   CHECK_FAIL_RETURN_SYNTAX_ERROR(!hostname_.empty(), "hostname must not be empty.");
   CHECK_FAIL_RETURN_SYNTAX_ERROR(port_ >= kMinLegalPort, "Port must be in range (1025..65535).");
   CHECK_FAIL_RETURN_SYNTAX_ERROR(port_ <= kMaxLegalPort, "Port must be in range (1025..65535).");
-  CHECK_FAIL_RETURN_SYNTAX_ERROR(hostname_ == "127.0.0.1",
-                                 "now cache client has to be on the same host with cache server.");
+  std::set<std::pair<std::string, int32_t>> seen;
+  for (const auto &server : servers_) {
+    CHECK_FAIL_RETURN_SYNTAX_ERROR(!server.first.empty(), "hostname must not be empty.");
+    CHECK_FAIL_RETURN_SYNTAX_ERROR(server.second >= kMinLegalPort, "Port must be in range (1025..65535).");
+    CHECK_FAIL_RETURN_SYNTAX_ERROR(server.second <= kMaxLegalPort, "Port must be in range (1025..65535).");
+    CHECK_FAIL_RETURN_SYNTAX_ERROR(seen.insert(server).second,
+                                   "cache server " + server.first + ":" + std::to_string(server.second) +
+                                     " is listed more than once.");
+  }
   return Status::OK();
 }
 
@@ -63,7 +80,8 @@ CacheClient::CacheClient(session_id_type session_id, uint64_t cache_mem_sz, bool
       local_bypass_(false),
       num_connections_(num_connections),
       prefetch_size_(prefetch_size),
-      fetch_all_keys_(true) {
+      fetch_all_keys_(true),
+      owner_shard_(-1) {
   cinfo_.set_session_id(session_id);
   comm_ = std::make_shared<CacheClientGreeter>(hostname, port, num_connections_);
 }
@@ -100,13 +118,16 @@ void CacheClient::Print(std::ostream &out) const {
       << "\n  Server cache id: " << server_connection_id_ << "\n  Cache mem size: " << GetCacheMemSz()
       << "\n  Spilling: " << std::boolalpha << isSpill() << "\n  Number of rpc workers: " << GetNumConnections()
       << "\n  Prefetch size: " << GetPrefetchSize() << "\n  Local client support: " << std::boolalpha
-      << SupportLocalClient();
+      << SupportLocalClient() << "\n  Number of cache servers: " << GetNumServers();
 }
 
 std::string CacheClient::GetHostname() const { return comm_->GetHostname(); }
 int32_t CacheClient::GetPort() const { return comm_->GetPort(); }
 
 Status CacheClient::WriteRow(const TensorRow &row, row_id_type *row_id_from_server) const {
+  if (IsSharded()) {
+    return WriteShardedRow(row, row_id_from_server);
+  }
   auto rq = std::make_shared<CacheRowRequest>(this);
   RETURN_IF_NOT_OK(rq->SerializeCacheRowRequest(this, row));
   RETURN_IF_NOT_OK(PushRequest(rq));
@@ -118,6 +139,9 @@ Status CacheClient::WriteRow(const TensorRow &row, row_id_type *row_id_from_serv
 }
 
 Status CacheClient::AsyncWriteRow(const TensorRow &row) {
+  if (IsSharded()) {
+    return AsyncWriteShardedRow(row);
+  }
   if (async_buffer_stream_ == nullptr) {
     return Status(StatusCode::kMDNotImplementedYet);
   }
@@ -127,9 +151,16 @@ Status CacheClient::AsyncWriteRow(const TensorRow &row) {
 
 Status CacheClient::GetRows(const std::vector<row_id_type> &row_id, TensorTable *out) const {
   RETURN_UNEXPECTED_IF_NULL(out);
+  if (IsSharded()) {
+    return GetShardedRows(row_id, out);
+  }
   auto rq = std::make_shared<BatchFetchRequest>(this, row_id);
   RETURN_IF_NOT_OK(PushRequest(rq));
   RETURN_IF_NOT_OK(rq->Wait());
+  return RestoreRows(rq.get(), out);
+}
+
+Status CacheClient::RestoreRows(BatchFetchRequest *rq, TensorTable *out) const {
   int64_t mem_addr;
   Status rc = rq->RestoreRows(out, comm_->SharedMemoryBaseAddr(), &mem_addr);
   // Free the memory by sending a request back to the server.
@@ -145,6 +176,9 @@ Status CacheClient::GetRows(const std::vector<row_id_type> &row_id, TensorTable
 }
 
 Status CacheClient::CreateCache(uint32_t tree_crc, bool generate_id) {
+  if (IsSharded()) {
+    return CreateShardedCache(tree_crc, generate_id);
+  }
   UniqueLock lck(&mux_);
   // To create a cache, we identify ourself at the client by:
   // - the shared session id
@@ -224,6 +258,12 @@ Status CacheClient::CreateCache(uint32_t tree_crc, bool generate_id) {
 }
 
 Status CacheClient::DestroyCache() {
+  if (IsSharded()) {
+    for (auto shard : LiveShards()) {
+      RETURN_IF_NOT_OK(shards_[shard]->DestroyCache());
+    }
+    return Status::OK();
+  }
   UniqueLock lck(&mux_);
   auto rq = std::make_shared<DestroyCacheRequest>(server_connection_id_);
   RETURN_IF_NOT_OK(PushRequest(rq));
@@ -232,8 +272,11 @@ Status CacheClient::DestroyCache() {
 }
 
 Status CacheClient::GetStat(CacheServiceStat *stat) {
-  SharedLock lck(&mux_);
   RETURN_UNEXPECTED_IF_NULL(stat);
+  if (IsSharded()) {
+    return GetShardedStat(stat);
+  }
+  SharedLock lck(&mux_);
   // GetStat has an external interface, so we have to make sure we have a valid connection id first
   CHECK_FAIL_RETURN_UNEXPECTED(server_connection_id_ != 0, "GetStat called but the cache is not in use yet.");
 
@@ -245,8 +288,19 @@ Status CacheClient::GetStat(CacheServiceStat *stat) {
 }
 
 Status CacheClient::GetState(int8_t *out) {
-  SharedLock lck(&mux_);
   RETURN_UNEXPECTED_IF_NULL(out);
+  if (IsSharded()) {
+    // All the servers go through the same phases, ask the first one still around.
+    for (auto shard : LiveShards()) {
+      Status rc = shards_[shard]->GetState(out);
+      if (!IsServerLost(rc)) {
+        return rc;
+      }
+      RemoveShard(shard, rc);
+    }
+    return Status(StatusCode::kMDNetWorkError, __LINE__, __FILE__, "None of the cache servers is reachable.");
+  }
+  SharedLock lck(&mux_);
   CHECK_FAIL_RETURN_UNEXPECTED(server_connection_id_ != 0, "GetState called but the cache is not in use yet.");
   auto rq = std::make_shared<GetCacheStateRequest>(server_connection_id_);
   RETURN_IF_NOT_OK(PushRequest(rq));
@@ -256,6 +310,12 @@ Status CacheClient::GetState(int8_t *out) {
 }
 
 Status CacheClient::CacheSchema(const std::unordered_map<std::string, int32_t> &map) {
+  if (IsSharded()) {
+    for (auto shard : LiveShards()) {
+      RETURN_IF_NOT_OK(shards_[shard]->CacheSchema(map));
+    }
+    return Status::OK();
+  }
   SharedLock lck(&mux_);
   auto rq = std::make_shared<CacheSchemaRequest>(server_connection_id_);
   RETURN_IF_NOT_OK(rq->SerializeCacheSchemaRequest(map));
@@ -265,8 +325,18 @@ Status CacheClient::CacheSchema(const std::unordered_map<std::string, int32_t> &
 }
 
 Status CacheClient::FetchSchema(std::unordered_map<std::string, int32_t> *map) {
-  SharedLock lck(&mux_);
   RETURN_UNEXPECTED_IF_NULL(map);
+  if (IsSharded()) {
+    for (auto shard : LiveShards()) {
+      Status rc = shards_[shard]->FetchSchema(map);
+      if (!IsServerLost(rc)) {
+        return rc;
+      }
+      RemoveShard(shard, rc);
+    }
+    return Status(StatusCode::kMDNetWorkError, __LINE__, __FILE__, "None of the cache servers is reachable.");
+  }
+  SharedLock lck(&mux_);
   auto rq = std::make_shared<FetchSchemaRequest>(server_connection_id_);
   RETURN_IF_NOT_OK(PushRequest(rq));
   RETURN_IF_NOT_OK(rq->Wait());
@@ -275,6 +345,12 @@ Status CacheClient::FetchSchema(std::unordered_map<std::string, int32_t> *map) {
 }
 
 Status CacheClient::BuildPhaseDone() const {
+  if (IsSharded()) {
+    for (auto shard : LiveShards()) {
+      RETURN_IF_NOT_OK(shards_[shard]->BuildPhaseDone());
+    }
+    return Status::OK();
+  }
   SharedLock lck(&mux_);
   auto rq = std::make_shared<BuildPhaseDoneRequest>(server_connection_id_, cookie());
   RETURN_IF_NOT_OK(PushRequest(rq));
@@ -285,6 +361,13 @@ Status CacheClient::BuildPhaseDone() const {
 Status CacheClient::PushRequest(std::shared_ptr<BaseRequest> rq) const { return comm_->HandleRequest(std::move(rq)); }
 
 void CacheClient::ServerRunningOutOfResources() {
+  if (IsSharded()) {
+    // Each server reports the keys it misses, and KeyIsCacheMiss only asks the server owning the key.
+    for (auto shard : LiveShards()) {
+      shards_[shard]->ServerRunningOutOfResources();
+    }
+    return;
+  }
   bool expected = true;
   if (fetch_all_keys_.compare_exchange_strong(expected, false)) {
     Status rc;
@@ -326,6 +409,302 @@ void CacheClient::ServerRunningOutOfResources() {
   }
 }
 
+int32_t CacheClient::GetNumServers() const {
+  if (!IsSharded()) {
+    return 1;
+  }
+  SharedLock lck(&ring_mux_);
+  return static_cast<int32_t>(ring_->NumServers());
+}
+
+Status CacheClient::SetShards(std::vector<std::shared_ptr<CacheClient>> shards) {
+  CHECK_FAIL_RETURN_UNEXPECTED(!shards.empty(), "No cache server to spread the rows over.");
+  UniqueLock lck(&ring_mux_);
+  shards_ = std::move(shards);
+  ring_ = std::make_unique<CacheHashRing>();
+  for (size_t i = 0; i < shards_.size(); ++i) {
+    auto name = shards_[i]->GetHostname() + ":" + std::to_string(shards_[i]->GetPort());
+    ring_->AddServer(static_cast<int32_t>(i), name);
+  }
+  pending_writes_.resize(shards_.size());
+  return Status::OK();
+}
+
+int32_t CacheClient::LookupShard(row_id_type row_id) const {
+  if (owner_shard_ != -1) {
+    return ring_->HasServer(owner_shard_) ? owner_shard_ : -1;
+  }
+  return ring_->Lookup(static_cast<uint64_t>(row_id));
+}
+
+int32_t CacheClient::ShardOf(row_id_type row_id) const {
+  SharedLock lck(&ring_mux_);
+  return LookupShard(row_id);
+}
+
+std::vector<int32_t> CacheClient::LiveShards() const {
+  SharedLock lck(&ring_mux_);
+  std::vector<int32_t> v;
+  for (int32_t i = 0; i < static_cast<int32_t>(shards_.size()); ++i) {
+    if (ring_->HasServer(i) && (owner_shard_ == -1 || owner_shard_ == i)) {
+      v.push_back(i);
+    }
+  }
+  return v;
+}
+
+void CacheClient::RemoveShard(int32_t shard, const Status &rc) const {
+  UniqueLock lck(&ring_mux_);
+  if (ring_->HasServer(shard)) {
+    ring_->RemoveServer(shard);
+    MS_LOG(WARNING) << "Lost cache server " << shards_[shard]->GetHostname() << ":" << shards_[shard]->GetPort()
+                    << ", its rows will be treated as cache misses. Number of cache servers left: "
+                    << ring_->NumServers() << ". Error: " << rc.ToString();
+  }
+}
+
+Status CacheClient::CreateShardedCache(uint32_t tree_crc, bool generate_id) {
+  UniqueLock lck(&mux_);
+  if (server_connection_id_ && cinfo_.crc() != tree_crc) {
+    RETURN_STATUS_UNEXPECTED("Cannot re-use a cache for a different tree!");
+  }
+  cinfo_.set_crc(tree_crc);
+  std::shared_ptr<CacheClient> lead;
+  int32_t num_created = 0;
+  int32_t num_duplicate = 0;
+  do {
+    if (generate_id) {
+      // The server hands out the row ids of such a cache, so spreading it would make the ids clash. Keep it whole
+      // on one server, picked by the crc so that all the pipelines sharing the cache agree on it.
+      UniqueLock ring_lck(&ring_mux_);
+      owner_shard_ = ring_->Lookup(tree_crc);
+      if (owner_shard_ == -1) {
+        break;
+      }
+    }
+    for (auto shard : LiveShards()) {
+      Status rc = shards_[shard]->CreateCache(tree_crc, generate_id);
+      if (IsServerLost(rc)) {
+        RemoveShard(shard, rc);
+        continue;
+      }
+      if (rc.StatusCode() == StatusCode::kMDDuplicateKey) {
+        ++num_duplicate;
+      } else {
+        RETURN_IF_NOT_OK(rc);
+        ++num_created;
+      }
+      if (lead == nullptr) {
+        lead = shards_[shard];
+      }
+    }
+  } while (generate_id && lead == nullptr);
+  if (lead == nullptr) {
+    return Status(StatusCode::kMDNetWorkError, __LINE__, __FILE__, "None of the cache servers is reachable.");
+  }
+  server_connection_id_ = lead->server_connection_id_;
+  cookie_ = lead->cookie_;
+  // Only skip the build phase if every server has the cache, otherwise the new servers would stay empty.
+  if (num_created == 0 && num_duplicate > 0) {
+    return Status(StatusCode::kMDDuplicateKey, __LINE__, __FILE__,
+                  "Not an error and we should bypass the build phase");
+  }
+  return Status::OK();
+}
+
+Status CacheClient::WriteShardedRow(const TensorRow &row, row_id_type *row_id_from_server) const {
+  while (true) {
+    auto shard = ShardOf(row.getId());
+    if (shard == -1) {
+      return Status(StatusCode::kMDNetWorkError, __LINE__, __FILE__, "None of the cache servers is reachable.");
+    }
+    Status rc = shards_[shard]->WriteRow(row, row_id_from_server);
+    if (!IsServerLost(rc)) {
+      return rc;
+    }
+    // The ring now maps the row to the next server.
+    RemoveShard(shard, rc);
+  }
+}
+
+Status CacheClient::AsyncWriteShardedRow(const TensorRow &row) {
+  while (true) {
+    auto shard = ShardOf(row.getId());
+    if (shard == -1) {
+      return Status(StatusCode::kMDNetWorkError, __LINE__, __FILE__, "None of the cache servers is reachable.");
+    }
+    auto &cc = shards_[shard];
+    Status rc = cc->AsyncWriteRow(row);
+    if (rc.StatusCode() == StatusCode::kMDNotImplementedYet) {
+      // No shared memory with this server or the row is too big for the async buffer. Send it on its own but don't
+      // wait for the reply, so that the rows going to the different servers overlap.
+      auto rq = std::make_shared<CacheRowRequest>(cc.get());
+      rc = rq->SerializeCacheRowRequest(cc.get(), row);
+      if (rc.IsOk()) {
+        rc = cc->PushRequest(rq);
+      }
+      if (rc.IsOk()) {
+        std::shared_ptr<CacheRowRequest> oldest;
+        {
+          std::unique_lock<std::mutex> lock(pending_mux_);
+          auto &pending = pending_writes_[shard];
+          pending.push_back(rq);
+          if (pending.size() > kMaxPendingWrites) {
+            oldest = std::move(pending.front());
+            pending.pop_front();
+          }
+        }
+        if (oldest) {
+          rc = WaitPendingWrite(shard, oldest);
+        }
+        return rc;
+      }
+    }
+    if (!IsServerLost(rc)) {
+      return rc;
+    }
+    RemoveShard(shard, rc);
+  }
+}
+
+Status CacheClient::WaitPendingWrite(int32_t shard, const std::shared_ptr<CacheRowRequest> &rq) {
+  Status rc = rq->Wait();
+  if (IsServerLost(rc)) {
+    // The row is gone with the server, it will be a cache miss.
+    RemoveShard(shard, rc);
+    return Status::OK();
+  }
+  return rc;
+}
+
+Status CacheClient::FlushShards() {
+  Status rc;
+  for (int32_t shard = 0; shard < static_cast<int32_t>(shards_.size()); ++shard) {
+    std::deque<std::shared_ptr<CacheRowRequest>> pending;
+    {
+      std::unique_lock<std::mutex> lock(pending_mux_);
+      pending.swap(pending_writes_[shard]);
+    }
+    // Wait for all of them even after an error, the requests must not be dropped while in flight.
+    for (const auto &rq : pending) {
+      Status wait_rc = WaitPendingWrite(shard, rq);
+      if (rc.IsOk()) {
+        rc = wait_rc;
+      }
+    }
+  }
+  RETURN_IF_NOT_OK(rc);
+  for (auto shard : LiveShards()) {
+    rc = shards_[shard]->FlushAsyncWriteBuffer();
+    if (IsServerLost(rc)) {
+      RemoveShard(shard, rc);
+      continue;
+    }
+    RETURN_IF_NOT_OK(rc);
+  }
+  return Status::OK();
+}
+
+Status CacheClient::GetShardedRows(const std::vector<row_id_type> &row_id, TensorTable *out) const {
+  // Group the keys by server and send all the requests before waiting for any reply, so the servers work on them
+  // at the same time.
+  std::map<int32_t, std::vector<size_t>> pos_by_shard;
+  {
+    SharedLock lck(&ring_mux_);
+    for (size_t i = 0; i < row_id.size(); ++i) {
+      pos_by_shard[LookupShard(row_id[i])].push_back(i);
+    }
+  }
+  out->clear();
+  out->resize(row_id.size());
+  for (size_t i = 0; i < row_id.size(); ++i) {
+    (*out)[i].setId(row_id[i]);
+  }
+  // An error doesn't return before all the requests sent are waited for, the replies may hold shared memory to give
+  // back and the requests must not be released while the comm layer still owns them.
+  Status rc;
+  std::vector<std::pair<int32_t, std::shared_ptr<BatchFetchRequest>>> requests;
+  for (const auto &p : pos_by_shard) {
+    auto shard = p.first;
+    if (shard == -1) {
+      // No server left for these keys, leave the rows empty so they are fetched from the leaf.
+      continue;
+    }
+    std::vector<row_id_type> keys;
+    keys.reserve(p.second.size());
+    for (auto pos : p.second) {
+      keys.push_back(row_id[pos]);
+    }
+    auto rq = std::make_shared<BatchFetchRequest>(shards_[shard].get(), keys);
+    Status push_rc = shards_[shard]->PushRequest(rq);
+    if (IsServerLost(push_rc)) {
+      RemoveShard(shard, push_rc);
+      continue;
+    }
+    if (push_rc.IsError()) {
+      rc = push_rc;
+      break;
+    }
+    requests.emplace_back(shard, std::move(rq));
+  }
+  for (auto &r : requests) {
+    auto shard = r.first;
+    Status wait_rc = r.second->Wait();
+    if (IsServerLost(wait_rc)) {
+      RemoveShard(shard, wait_rc);
+      continue;
+    }
+    TensorTable tbl;
+    if (wait_rc.IsOk()) {
+      wait_rc = shards_[shard]->RestoreRows(r.second.get(), &tbl);
+    }
+    const auto &pos = pos_by_shard[shard];
+    if (wait_rc.IsOk() && tbl.size() != pos.size()) {
+      wait_rc = Status(StatusCode::kMDUnexpectedError, __LINE__, __FILE__,
+                       "[Internal ERROR] Row count mismatch from cache server.");
+    }
+    if (wait_rc.IsError() || rc.IsError()) {
+      if (rc.IsOk()) {
+        rc = wait_rc;
+      }
+      continue;
+    }
+    for (size_t i = 0; i < pos.size(); ++i) {
+      (*out)[pos[i]] = std::move(tbl[i]);
+    }
+  }
+  return rc;
+}
+
+Status CacheClient::GetShardedStat(CacheServiceStat *stat) {
+  bool first = true;
+  int64_t total_sz = 0;
+  for (auto shard : LiveShards()) {
+    CacheServiceStat shard_stat{};
+    Status rc = shards_[shard]->GetStat(&shard_stat);
+    if (IsServerLost(rc)) {
+      RemoveShard(shard, rc);
+      continue;
+    }
+    RETURN_IF_NOT_OK(rc);
+    total_sz += shard_stat.avg_cache_sz * (shard_stat.num_mem_cached + shard_stat.num_disk_cached);
+    if (first) {
+      *stat = shard_stat;
+      first = false;
+      continue;
+    }
+    stat->num_mem_cached += shard_stat.num_mem_cached;
+    stat->num_disk_cached += shard_stat.num_disk_cached;
+    stat->num_numa_hit += shard_stat.num_numa_hit;
+    stat->min_row_id = std::min(stat->min_row_id, shard_stat.min_row_id);
+    stat->max_row_id = std::max(stat->max_row_id, shard_stat.max_row_id);
+  }
+  CHECK_FAIL_RETURN_UNEXPECTED(!first, "GetStat called but none of the cache servers is reachable.");
+  auto num_cached = stat->num_mem_cached + stat->num_disk_cached;
+  stat->avg_cache_sz = num_cached > 0 ? total_sz / num_cached : 0;
+  return Status::OK();
+}
+
 CacheClient::CacheMissKeys::CacheMissKeys(const std::vector<row_id_type> &v) {
   auto it = v.begin();
   min_ = *it;
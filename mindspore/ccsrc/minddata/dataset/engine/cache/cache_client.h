@@ -17,6 +17,7 @@
 #define MINDSPORE_CCSRC_MINDDATA_DATASET_ENGINE_CACHE_CLIENT_H_
 
 #include <atomic>
+#include <deque>
 #include <iostream>
 #include <limits>
 #include <memory>
@@ -29,6 +30,7 @@
 #include <vector>
 
 #include "minddata/dataset/core/config_manager.h"
+#include "minddata/dataset/engine/cache/cache_hash_ring.h"
 #ifdef ENABLE_CACHE
 #include "minddata/dataset/engine/cache/cache_grpc_client.h"
 #else
@@ -43,6 +45,9 @@
 
 namespace mindspore {
 namespace dataset {
+class BatchFetchRequest;
+class CacheRowRequest;
+
 /// \brief A CacheClient is a bridge between a DatasetOp and a CacheServer. All communications are through
 /// a CacheClient. Typical tasks including like creating a cache service, cache a data buffer, restore a previously
 /// rows, etc.
@@ -117,6 +122,15 @@ class CacheClient {
       return *this;
     }
 
+    /// Setter function to shard the rows over several cache servers instead of the one given by the hostname and
+    /// the port. Every pipeline sharing the cache must list the same servers.
+    /// \param servers A list of hostname and port of the cache servers
+    /// \return Builder object itself
+    Builder &SetServers(std::vector<std::pair<std::string, int32_t>> servers) {
+      servers_ = std::move(servers);
+      return *this;
+    }
+
     /// Getter functions
     session_id_type GetSessionId() const { return session_id_; }
     uint64_t GetCacheMemSz() const { return cache_mem_sz_; }
@@ -125,6 +139,7 @@ class CacheClient {
     int32_t GetPort() const { return port_; }
     int32_t GetNumConnections() const { return num_connections_; }
     int32_t GetPrefetchSize() const { return prefetch_size_; }
+    const std::vector<std::pair<std::string, int32_t>> &GetServers() const { return servers_; }
 
     Status SanityCheck();
 
@@ -138,6 +153,7 @@ class CacheClient {
     int32_t port_;
     int32_t num_connections_;
     int32_t prefetch_size_;
+    std::vector<std::pair<std::string, int32_t>> servers_;
   };
 
   /// \brief Constructor
@@ -244,6 +260,10 @@ class CacheClient {
   /// \param key row id to be test
   /// \return true if not at the server
   bool KeyIsCacheMiss(row_id_type key) {
+    if (IsSharded()) {
+      auto shard = ShardOf(key);
+      return shard < 0 || shards_[shard]->KeyIsCacheMiss(key);
+    }
     if (cache_miss_keys_) {
       // Make sure it is fully built even though the pointer is not null
       Status rc = cache_miss_keys_wp_.Wait();
@@ -263,13 +283,64 @@ class CacheClient {
 
   /// Force a final flush to the cache server. Must be called when receiving eoe.
   Status FlushAsyncWriteBuffer() {
+    if (IsSharded()) {
+      return FlushShards();
+    }
     if (async_buffer_stream_) {
       return async_buffer_stream_->SyncFlush(AsyncBufferStream::AsyncFlushFlag::kFlushBlocking);
     }
     return Status::OK();
   }
 
+  /// \brief Check if the rows are sharded over several cache servers
+  bool IsSharded() const { return !shards_.empty(); }
+
+  /// \brief Number of cache servers still in use, 1 if the rows are not sharded
+  int32_t GetNumServers() const;
+
  private:
+  // The number of rows sent to a cache server without waiting for the replies
+  constexpr static size_t kMaxPendingWrites = 64;
+
+  /// \brief Turn this client into a router over one client per cache server
+  /// \param shards A client for each cache server
+  /// \return Status object
+  Status SetShards(std::vector<std::shared_ptr<CacheClient>> shards);
+
+  /// \brief Find the cache server owning a row
+  /// \param row_id The row id
+  /// \return Index of the server in shards_, -1 if none is left
+  int32_t ShardOf(row_id_type row_id) const;
+
+  /// \brief Same as ShardOf, the caller holds ring_mux_
+  int32_t LookupShard(row_id_type row_id) const;
+
+  /// \brief The cache servers still in use
+  std::vector<int32_t> LiveShards() const;
+
+  /// \brief Stop using a cache server after it failed, its rows become cache misses and new rows go to the next
+  /// servers on the ring
+  /// \param shard Index of the server in shards_
+  /// \param rc The error returned by the server
+  void RemoveShard(int32_t shard, const Status &rc) const;
+
+  /// \brief Check if an error means the cache server has left
+  static bool IsServerLost(const Status &rc) { return rc.StatusCode() == StatusCode::kMDNetWorkError; }
+
+  /// \brief Wait for a row sent to a cache server without shared memory. A lost server is dropped, not an error.
+  Status WaitPendingWrite(int32_t shard, const std::shared_ptr<CacheRowRequest> &rq);
+
+  /// \brief Restore the rows of a batch fetch request and release its shared memory
+  Status RestoreRows(BatchFetchRequest *rq, TensorTable *out) const;
+
+  /// Sharded versions of the public functions
+  Status CreateShardedCache(uint32_t tree_crc, bool generate_id);
+  Status WriteShardedRow(const TensorRow &row, row_id_type *row_id_from_server) const;
+  Status AsyncWriteShardedRow(const TensorRow &row);
+  Status GetShardedRows(const std::vector<row_id_type> &row_id, TensorTable *out) const;
+  Status GetShardedStat(CacheServiceStat *stat);
+  Status FlushShards();
+
   mutable RWLock mux_;
   uint64_t cache_mem_sz_;
   bool spill_;
@@ -354,6 +425,16 @@ class CacheClient {
     int32_t cur_;
   };
   std::shared_ptr<AsyncBufferStream> async_buffer_stream_;
+
+  // Sharded mode. Each cache server has its own client in shards_ and the rows are spread over them by a consistent
+  // hash of the row id. The caches which generate their row ids can't be spread, they live on owner_shard_.
+  std::vector<std::shared_ptr<CacheClient>> shards_;
+  std::unique_ptr<CacheHashRing> ring_;
+  mutable RWLock ring_mux_;
+  int32_t owner_shard_;
+  // Rows sent to the cache servers without a shared memory buffer, waited for when they pile up or on flush
+  std::mutex pending_mux_;
+  std::vector<std::deque<std::shared_ptr<CacheRowRequest>>> pending_writes_;
 };
 }  // namespace dataset
 }  // namespace mindspore
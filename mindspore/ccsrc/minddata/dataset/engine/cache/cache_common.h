@@ -99,6 +99,12 @@ inline std::string PortToUnixSocketPath(int port) {
   return DefaultUserDir() + std::string("/cache_server_p") + std::to_string(port);
 }
 
+/// \brief Check if the cache server is on the same host, only such a server can be reached by unix socket and shared
+/// memory. A remote server is reached by tcp/ip only.
+/// \param hostname
+/// \return true if the hostname is the loopback address
+inline bool IsLocalCacheHost(const std::string &hostname) { return hostname == "127.0.0.1" || hostname == "localhost"; }
+
 /// \brief Round up to the next 4k
 inline int64_t round_up_4K(int64_t sz) {
   // Since 4096 is a power of 2, a simple way to round up is add 4095 and mask off all the
@@ -29,7 +29,7 @@ CacheClientGreeter::CacheClientGreeter(const std::string &hostname, int32_t port
 #ifdef CACHE_LOCAL_CLIENT
   // Try connect locally to the unix_socket first as the first preference
   // Need to resolve hostname to ip address rather than to do a string compare
-  if (hostname == "127.0.0.1") {
+  if (IsLocalCacheHost(hostname_)) {
     std::string target = "unix://" + PortToUnixSocketPath(port);
     channel_ = grpc::CreateCustomChannel(target, grpc::InsecureChannelCredentials(), args);
   } else {
@@ -45,6 +45,10 @@ CacheClientGreeter::CacheClientGreeter(const std::string &hostname, int32_t port
 Status CacheClientGreeter::AttachToSharedMemory(bool *local_bypass) {
   *local_bypass = false;
 #ifdef CACHE_LOCAL_CLIENT
+  // The shared memory is created by the server on its own host.
+  if (!IsLocalCacheHost(hostname_)) {
+    return Status::OK();
+  }
   SharedMemory::shm_key_t shm_key;
   RETURN_IF_NOT_OK(PortToFtok(port_, &shm_key));
   // Attach to the shared memory
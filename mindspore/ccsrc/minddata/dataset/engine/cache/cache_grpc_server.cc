@@ -23,7 +23,8 @@
 
 namespace mindspore {
 namespace dataset {
-CacheServerGreeterImpl::CacheServerGreeterImpl(int32_t port) : port_(port) {
+CacheServerGreeterImpl::CacheServerGreeterImpl(const std::string &hostname, int32_t port)
+    : hostname_(hostname), port_(port) {
   // Setup a path for unix socket.
   unix_socket_ = PortToUnixSocketPath(port);
   // We can't generate the ftok key yet until the unix_socket_ is created
@@ -48,10 +49,14 @@ void CacheServerGreeterImpl::Shutdown() {
 CacheServerGreeterImpl::~CacheServerGreeterImpl() { Shutdown(); }
 
 Status CacheServerGreeterImpl::Run() {
-  // To listen on all interfaces, use 0.0.0.0
-  // Future, allow the user to choose listening interface.  For now, default to localhost
-  std::string host("127.0.0.1");
-  std::string server_address = host + ":" + std::to_string(port_);
+  // The tcp/ip port listens on the interface chosen by the user, 0.0.0.0 for all of them. Clients on the same host
+  // still prefer the unix socket below.
+  std::string server_address = hostname_ + ":" + std::to_string(port_);
+  if (!IsLocalCacheHost(hostname_)) {
+    MS_LOG(WARNING) << "The cache server listens on " << server_address << " without authentication or encryption. "
+                    << "Any host which can reach the port can read, modify and destroy the cached data, so only bind "
+                    << "it to an interface of a trusted network.";
+  }
   grpc::ServerBuilder builder;
   // Default message size for gRPC is 4MB. Increase it to 2g-1
   builder.SetMaxReceiveMessageSize(std::numeric_limits<int32_t>::max());
@@ -71,7 +71,7 @@ class CacheServerGreeterImpl final {
 
  public:
   constexpr static int32_t kMonitorIntervalInSec = 5;
-  explicit CacheServerGreeterImpl(int32_t port);
+  CacheServerGreeterImpl(const std::string &hostname, int32_t port);
   virtual ~CacheServerGreeterImpl();
   /// \brief Brings up gRPC server
   /// \return none
@@ -86,6 +86,7 @@ class CacheServerGreeterImpl final {
   void Shutdown();
 
  private:
+  std::string hostname_;
   int32_t port_;
   std::string unix_socket_;
   CacheServerGreeter::AsyncService svc_;
@@ -0,0 +1,81 @@
+/**
+ * Copyright 2022 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "minddata/dataset/engine/cache/cache_hash_ring.h"
+
+namespace mindspore {
+namespace dataset {
+CacheHashRing::CacheHashRing(int32_t num_virtual_nodes) : num_virtual_nodes_(num_virtual_nodes) {
+  if (num_virtual_nodes_ <= 0) {
+    num_virtual_nodes_ = 1;
+  }
+}
+
+void CacheHashRing::AddServer(int32_t server, const std::string &name) {
+  if (HasServer(server)) {
+    return;
+  }
+  uint64_t base = HashName(name);
+  for (int32_t i = 0; i < num_virtual_nodes_; ++i) {
+    uint64_t point = Mix(base + static_cast<uint64_t>(i));
+    // On the rare collision the server placed first keeps the point.
+    (void)ring_.emplace(point, server);
+  }
+  (void)servers_.insert(server);
+}
+
+void CacheHashRing::RemoveServer(int32_t server) {
+  if (servers_.erase(server) == 0) {
+    return;
+  }
+  for (auto it = ring_.begin(); it != ring_.end();) {
+    if (it->second == server) {
+      it = ring_.erase(it);
+    } else {
+      ++it;
+    }
+  }
+}
+
+int32_t CacheHashRing::Lookup(uint64_t key) const {
+  if (ring_.empty()) {
+    return -1;
+  }
+  auto it = ring_.lower_bound(Mix(key));
+  if (it == ring_.end()) {
+    it = ring_.begin();
+  }
+  return it->second;
+}
+
+uint64_t CacheHashRing::Mix(uint64_t x) {
+  // splitmix64 finalizer, consecutive row ids land far apart on the ring.
+  x += 0x9E3779B97F4A7C15ULL;
+  x = (x ^ (x >> 30)) * 0xBF58476D1CE4E5B9ULL;
+  x = (x ^ (x >> 27)) * 0x94D049BB133111EBULL;
+  return x ^ (x >> 31);
+}
+
+uint64_t CacheHashRing::HashName(const std::string &name) {
+  // FNV-1a, it must not depend on the process so that every host builds the same ring.
+  uint64_t h = 0xCBF29CE484222325ULL;
+  for (unsigned char c : name) {
+    h ^= c;
+    h *= 0x100000001B3ULL;
+  }
+  return h;
+}
+}  // namespace dataset
+}  // namespace mindspore
@@ -0,0 +1,72 @@
+/**
+ * Copyright 2022 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifndef MINDSPORE_CCSRC_MINDDATA_DATASET_ENGINE_CACHE_HASH_RING_H_
+#define MINDSPORE_CCSRC_MINDDATA_DATASET_ENGINE_CACHE_HASH_RING_H_
+
+#include <cstdint>
+#include <map>
+#include <set>
+#include <string>
+
+namespace mindspore {
+namespace dataset {
+/// \brief A consistent hash ring to spread the rows of a cache over several cache servers. Every server is placed
+/// on the ring as a number of virtual nodes, and a key belongs to the first node at or after its hash. When a server
+/// leaves, only its keys move, to the nodes following its own.
+/// \note Not thread safe, the owner serializes the access.
+class CacheHashRing {
+ public:
+  constexpr static int32_t kDefaultVirtualNodes = 128;
+
+  /// \brief Constructor
+  /// \param num_virtual_nodes Number of points each server takes on the ring
+  explicit CacheHashRing(int32_t num_virtual_nodes = kDefaultVirtualNodes);
+
+  ~CacheHashRing() = default;
+
+  /// \brief Place a server on the ring
+  /// \param server Index of the server
+  /// \param name A name unique to the server, for example host:port. It decides where the server is placed, so the
+  ///     same set of names gives the same ring on every host.
+  void AddServer(int32_t server, const std::string &name);
+
+  /// \brief Take a server off the ring
+  /// \param server Index of the server
+  void RemoveServer(int32_t server);
+
+  /// \brief Find the server owning a key
+  /// \param key The key, for example a row id
+  /// \return Index of the server, -1 if the ring is empty
+  int32_t Lookup(uint64_t key) const;
+
+  /// \brief Check if a server is on the ring
+  bool HasServer(int32_t server) const { return servers_.count(server) > 0; }
+
+  /// \brief Number of servers on the ring
+  size_t NumServers() const { return servers_.size(); }
+
+ private:
+  static uint64_t Mix(uint64_t x);
+
+  static uint64_t HashName(const std::string &name);
+
+  int32_t num_virtual_nodes_;
+  std::map<uint64_t, int32_t> ring_;
+  std::set<int32_t> servers_;
+};
+}  // namespace dataset
+}  // namespace mindspore
+#endif  // MINDSPORE_CCSRC_MINDDATA_DATASET_ENGINE_CACHE_HASH_RING_H_
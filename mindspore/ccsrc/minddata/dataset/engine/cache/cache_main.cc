@@ -28,7 +28,7 @@ namespace ms = mindspore;
 namespace ds = mindspore::dataset;
 
 namespace {
-const int32_t kTotalArgs = 8;
+const int32_t kTotalArgs = 9;
 enum ArgIndex : uint8_t {
   kProcessName = 0,
   kRootDir = 1,
@@ -37,7 +37,8 @@ enum ArgIndex : uint8_t {
   kSharedMemorySize = 4,
   kLogLevel = 5,
   kDemonize = 6,
-  kMemoryCapRatio = 7
+  kMemoryCapRatio = 7,
+  kHostname = 8
 };
 
 ms::Status BuildServer(ds::CacheServer::Builder *builder, ds::SharedMessage *msg, int32_t port, bool daemonize) {
@@ -134,6 +135,7 @@ ms::Status StartServer(int argc, char **argv) {
   int32_t port = static_cast<int32_t>(strtol(argv[ArgIndex::kPort], nullptr, ds::kDecimal));
   builder.SetRootDirectory(argv[ArgIndex::kRootDir])
     .SetNumWorkers(static_cast<int32_t>(strtol(argv[ArgIndex::kNumWorkers], nullptr, ds::kDecimal)))
+    .SetHostname(argv[ArgIndex::kHostname])
     .SetPort(port)
     .SetSharedMemorySizeInGB(static_cast<int32_t>(strtol(argv[ArgIndex::kSharedMemorySize], nullptr, ds::kDecimal)))
     .SetLogLevel(static_cast<int8_t>((strtol(argv[ArgIndex::kLogLevel], nullptr, ds::kDecimal))))
@@ -69,7 +69,7 @@ Status CacheServer::DoServiceStart() {
   RETURN_IF_NOT_OK(cache_q_->Register(&vg_));
   // Start the comm layer
   try {
-    comm_layer_ = std::make_shared<CacheServerGreeterImpl>(port_);
+    comm_layer_ = std::make_shared<CacheServerGreeterImpl>(hostname_, port_);
     RETURN_IF_NOT_OK(comm_layer_->Run());
   } catch (const std::exception &e) {
     RETURN_STATUS_UNEXPECTED(e.what());
@@ -992,12 +992,13 @@ session_id_type CacheServer::GetSessionID(connection_id_type connection_id) cons
   return static_cast<session_id_type>(connection_id >> 32u);
 }
 
-CacheServer::CacheServer(const std::string &spill_path, int32_t num_workers, int32_t port,
+CacheServer::CacheServer(const std::string &spill_path, int32_t num_workers, const std::string &hostname, int32_t port,
                          int32_t shared_meory_sz_in_gb, float memory_cap_ratio, int8_t log_level,
                          std::shared_ptr<CacheServerHW> hw_info)
     : top_(spill_path),
       num_workers_(num_workers),
       num_grpc_workers_(num_workers_),
+      hostname_(hostname),
       port_(port),
       shared_memory_sz_in_gb_(shared_meory_sz_in_gb),
       global_shutdown_(false),
@@ -1302,6 +1303,7 @@ int32_t CacheServer::Builder::AdjustNumWorkers(int32_t num_workers) {
 CacheServer::Builder::Builder()
     : top_(""),
       num_workers_(kDefaultNumWorkers),
+      hostname_(kCfgDefaultCacheHost),
       port_(kCfgDefaultCachePort),
       shared_memory_sz_in_gb_(kDefaultSharedMemorySize),
       memory_cap_ratio_(kDefaultMemoryCapRatio),
@@ -69,6 +69,7 @@ class CacheServer : public Service {
     /// \brief Getter functions
     const std::string &GetTop() const { return top_; }
     int32_t GetNumWorkers() const { return num_workers_; }
+    const std::string &GetHostname() const { return hostname_; }
     int32_t GetPort() const { return port_; }
     int32_t GetSharedMemorySzInGb() const { return shared_memory_sz_in_gb_; }
     float GetMemoryCapRatio() const { return memory_cap_ratio_; }
@@ -82,6 +83,10 @@ class CacheServer : public Service {
       num_workers_ = n;
       return *this;
     }
+    Builder &SetHostname(std::string hostname) {
+      hostname_ = std::move(hostname);
+      return *this;
+    }
     Builder &SetPort(int32_t p) {
       port_ = p;
       return *this;
@@ -105,6 +110,7 @@ class CacheServer : public Service {
       out << "Summary of the cache server configuration\n"
           << "Spill directory: " << (GetTop().empty() ? "None" : GetTop()) << "\n"
           << "Number of parallel workers: " << GetNumWorkers() << "\n"
+          << "Hostname: " << GetHostname() << "\n"
           << "Tcp/ip port: " << GetPort() << "\n"
           << "Shared memory size (in GB): " << GetSharedMemorySzInGb() << "\n"
           << "Memory cap ratio: " << GetMemoryCapRatio() << "\n"
@@ -142,7 +148,7 @@ class CacheServer : public Service {
       RETURN_IF_NOT_OK(SanityCheck());
       // We need to bring up the Task Manager by bringing up the Services singleton.
       RETURN_IF_NOT_OK(Services::CreateInstance());
-      RETURN_IF_NOT_OK(CacheServer::CreateInstance(top_, num_workers_, port_, shared_memory_sz_in_gb_,
+      RETURN_IF_NOT_OK(CacheServer::CreateInstance(top_, num_workers_, hostname_, port_, shared_memory_sz_in_gb_,
                                                    memory_cap_ratio_, log_level_, std::move(hw_info_)));
       return Status(StatusCode::kSuccess, warning_string);
     }
@@ -150,6 +156,7 @@ class CacheServer : public Service {
    private:
     std::string top_;
     int32_t num_workers_;
+    std::string hostname_;
     int32_t port_;
     int32_t shared_memory_sz_in_gb_;
     float memory_cap_ratio_;
@@ -172,13 +179,13 @@ class CacheServer : public Service {
   Status DoServiceStop() override;
   ~CacheServer() override { (void)ServiceStop(); }
 
-  static Status CreateInstance(const std::string &spill_path, int32_t num_workers, int32_t port,
-                               int32_t shared_memory_sz, float memory_cap_ratio, int8_t log_level,
+  static Status CreateInstance(const std::string &spill_path, int32_t num_workers, const std::string &hostname,
+                               int32_t port, int32_t shared_memory_sz, float memory_cap_ratio, int8_t log_level,
                                std::shared_ptr<CacheServerHW> hw_info) {
     std::call_once(init_instance_flag_, [&]() -> Status {
       auto &SvcManager = Services::GetInstance();
-      RETURN_IF_NOT_OK(SvcManager.AddHook(&instance_, spill_path, num_workers, port, shared_memory_sz, memory_cap_ratio,
-                                          log_level, hw_info));
+      RETURN_IF_NOT_OK(SvcManager.AddHook(&instance_, spill_path, num_workers, hostname, port, shared_memory_sz,
+                                          memory_cap_ratio, log_level, hw_info));
       return Status::OK();
     });
     return Status::OK();
@@ -288,6 +295,7 @@ class CacheServer : public Service {
   TaskGroup vg_;
   int32_t num_workers_;
   int32_t num_grpc_workers_;
+  std::string hostname_;
   int32_t port_;
   int32_t shared_memory_sz_in_gb_;
   int8_t log_level_;  // log_level is saved here for informational purpose only. It's not a functional field.
@@ -302,8 +310,10 @@ class CacheServer : public Service {
   /// \brief Constructor
   /// \param spill_path Top directory for spilling buffers to.
   /// \param num_workers Number of threads for handling requests.
-  explicit CacheServer(const std::string &spill_path, int32_t num_workers, int32_t port, int32_t share_memory_sz_in_gb,
-                       float memory_cap_ratio, int8_t log_level, std::shared_ptr<CacheServerHW> hw_info);
+  /// \param hostname The interface the server listens on for tcp/ip connections.
+  explicit CacheServer(const std::string &spill_path, int32_t num_workers, const std::string &hostname, int32_t port,
+                       int32_t share_memory_sz_in_gb, float memory_cap_ratio, int8_t log_level,
+                       std::shared_ptr<CacheServerHW> hw_info);
 
   /// \brief Locate a cache service from connection id.
   /// \return Pointer to cache service. Null if not found
@@ -20,6 +20,7 @@
 #include <string>
 #include <utility>
 #include <vector>
+#include "minddata/dataset/core/global_context.h"
 #include "minddata/dataset/util/task_manager.h"
 #include "minddata/dataset/util/queue.h"
 #include "minddata/dataset/util/services.h"
@@ -83,8 +84,11 @@ class Connector {
     pop_from_ = 0;
 
     // Initialize the queues_ to have num_producers_ number of queues.
-    // Each queue is a blocking queue and has the same queue_capacity.
-    queues_.Init(num_producers_, queue_capacity);
+    // Each queue is a blocking queue and has the same queue_capacity. Every queue has a single producer and
+    // the consumers are serialized by Pop(), so a lock-free queue can be the single producer/consumer flavor.
+    QueueType type = GlobalContext::config_manager()->enable_lock_free_queue() ? QueueType::kLockFreeSpsc
+                                                                               : QueueType::kBlocking;
+    queues_.Init(num_producers_, queue_capacity, type);
   }
 
   // Destructor of Connector
@@ -165,7 +165,12 @@ std::unordered_map<std::string, int32_t> DatasetIterator::GetColumnNameMap() con
 
 // Constructor of the ChildIterator
 ChildIterator::ChildIterator(DatasetOp *current_op, int32_t worker_id, int32_t child_idx)
-    : current_op_(current_op), child_idx_(child_idx), worker_id_(worker_id), end_epoch_(false), eof_handled_(false) {}
+    : current_op_(current_op),
+      child_idx_(child_idx),
+      worker_id_(worker_id),
+      end_epoch_(false),
+      eof_handled_(false),
+      next_row_(0) {}
 
 ChildIterator::~ChildIterator() { current_op_ = nullptr; }
 
@@ -183,7 +188,7 @@ Status ChildIterator::FetchNextTensorRow(TensorRow *out_row) {
     RETURN_STATUS_UNEXPECTED(err);
   }
 
-  RETURN_IF_NOT_OK(current_op_->child(child_idx_)->GetNextRow(out_row));
+  RETURN_IF_NOT_OK(PopRow(out_row));
   // If an eoe is picked up here, we simply return an empty vector and it's up to the
   // caller to decide what it wants to do next.TensorRow
   if (out_row->eoe()) {
@@ -220,7 +225,7 @@ Status ChildIterator::Drain() {
   TensorRow row;
   // else we drain until eoe or eof, eof here is for sanity check
   while (!row.eoe() && !row.eof()) {
-    RETURN_IF_NOT_OK(current_op_->child(child_idx_)->GetNextRow(&row));
+    RETURN_IF_NOT_OK(PopRow(&row));
   }
   if (row.eof()) {
     return Status(StatusCode::kMDUnexpectedError, __LINE__, __FILE__, "Child iterator picked up EOF in drain.");
@@ -228,6 +233,15 @@ Status ChildIterator::Drain() {
   return Status::OK();
 }
 
+Status ChildIterator::PopRow(TensorRow *row) {
+  if (next_row_ == rows_.size()) {
+    RETURN_IF_NOT_OK(current_op_->child(child_idx_)->GetNextRows(&rows_));
+    next_row_ = 0;
+  }
+  *row = std::move(rows_[next_row_++]);
+  return Status::OK();
+}
+
 // Getter
 std::unordered_map<std::string, int32_t> ChildIterator::GetColumnNameMap() const {
   return current_op_->child(child_idx_)->column_name_id_map();
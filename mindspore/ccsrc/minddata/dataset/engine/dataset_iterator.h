@@ -117,11 +117,18 @@ class ChildIterator {
   bool EofHandled() const { return eof_handled_; }
 
  private:
+  // Pops the next row, taking all the rows the child hands over at once when the previous ones are used up.
+  // @param row - The popped row
+  // @return Status The status code returned
+  Status PopRow(TensorRow *row);
+
   DatasetOp *current_op_;  // The parent operator. We consume from it's children.
   int32_t child_idx_;      // The specific child this iterator will fetch from.
   int32_t worker_id_;      // The worker id uses for fetching the child data.
   bool end_epoch_;         // the flag used when an empty row has been returned.
   bool eof_handled_;       // T/F if this op got an eof
+  TensorTable rows_;       // Rows fetched from the child and not returned yet, never past an eoe or eof
+  size_t next_row_;        // Index of the next row to return from rows_
 };
 }  // namespace dataset
 }  // namespace mindspore
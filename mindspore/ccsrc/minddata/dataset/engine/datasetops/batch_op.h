@@ -193,6 +193,8 @@ class BatchOp : public ParallelOp<std::pair<std::unique_ptr<TensorQTable>, CBatc
   // @return Name of the current Op
   std::string Name() const override { return kBatchOp; }
 
+  bool SupportsRowBatch() const override { return true; }
+
   // batch the rows in src table then put it to dest table
   // @param const std::unique_ptr<TensorQTable> *src - table that has the rows for batching
   // @param const std::unique_ptr<TensorQTable> *dest - dest_table to hold batched rows
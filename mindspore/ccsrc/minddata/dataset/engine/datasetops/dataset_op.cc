@@ -23,6 +23,7 @@
 #include <string>
 #include <algorithm>
 
+#include "minddata/dataset/core/global_context.h"
 #include "minddata/dataset/engine/datasetops/device_queue_op.h"
 #include "minddata/dataset/engine/datasetops/source/sampler/sampler.h"
 
@@ -217,7 +218,10 @@ std::vector<DatasetOp *> DatasetOp::parents() const { return parent_; }
 void DatasetOp::CreateConnector() {
   MS_LOG(DEBUG) << "Creating connector in tree operator: " << operator_id_ << ".";
   if (oc_queue_size_ > 0) {
-    out_connector_ = std::make_unique<OperatorConnector>(oc_queue_size_);
+    QueueType type = GlobalContext::config_manager()->enable_lock_free_queue() ? QueueType::kLockFreeMpmc
+                                                                               : QueueType::kBlocking;
+    int32_t row_batch_size = SupportsRowBatch() ? GlobalContext::config_manager()->row_batch_size() : 0;
+    out_connector_ = std::make_unique<OperatorConnector>(oc_queue_size_, type, row_batch_size);
   } else {
     // Some op's may choose not to have an output connector
     MS_LOG(DEBUG) << "Bypassed connector creation for tree operator: " << operator_id_ << ".";
@@ -269,6 +273,16 @@ Status DatasetOp::GetNextRow(TensorRow *row) {
   return Status::OK();
 }
 
+Status DatasetOp::GetNextRows(TensorTable *rows) {
+  RETURN_UNEXPECTED_IF_NULL(rows);
+  if (SupportsRowBatch() && out_connector_ != nullptr) {
+    return out_connector_->PopRows(rows);
+  }
+  // Anything else goes through GetNextRow, which the op may have overridden.
+  rows->resize(1);
+  return GetNextRow(&rows->front());
+}
+
 // Gets the number of classes
 Status DatasetOp::GetNumClasses(int64_t *num_classes) {
   RETURN_UNEXPECTED_IF_NULL(num_classes);
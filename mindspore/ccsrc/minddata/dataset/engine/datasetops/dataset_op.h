@@ -160,6 +160,12 @@ class DatasetOp : public std::enable_shared_from_this<DatasetOp> {
   /// \return Status The status code returned
   virtual Status GetNextRow(TensorRow *row);
 
+  /// \brief Gets the next rows from the given child, as many as it hands over at once (at least one). Only the last
+  ///     row can be a control row (eoe, eof).
+  /// \param rows[out] - Fetched TensorRows
+  /// \return Status The status code returned
+  virtual Status GetNextRows(TensorTable *rows);
+
   // \brief Gets the batch size
   // \return Status - The status code return
   virtual int64_t GetTreeBatchSize();
@@ -348,6 +354,11 @@ class DatasetOp : public std::enable_shared_from_this<DatasetOp> {
 
   virtual bool IsPython() const { return false; }
 
+  // \brief Whether the op can hand its output rows over in batches (see OperatorConnector). Ops opting in must only
+  //     push to their output connector from one thread and must not override GetNextRow. Map, Filter and Batch opt
+  //     in, since their rows leave through the collector thread only.
+  virtual bool SupportsRowBatch() const { return false; }
+
   virtual std::vector<int32_t> GetMPWorkerPIDs() const;
 
  protected:
@@ -69,6 +69,8 @@ class FilterOp : public ParallelOp<TensorRow, TensorRow> {
   // @return Name of the current Op
   std::string Name() const override { return kFilterOp; }
 
+  bool SupportsRowBatch() const override { return true; }
+
  private:
   // predicate_func python callable which returns a boolean value.
   std::shared_ptr<TensorOp> predicate_func_;
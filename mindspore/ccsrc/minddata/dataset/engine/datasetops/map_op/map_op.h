@@ -112,6 +112,8 @@ class MapOp : public ParallelOp<std::unique_ptr<MapWorkerJob>, TensorRow> {
   // @return Name of the current Op
   std::string Name() const override { return kMapOp; }
 
+  bool SupportsRowBatch() const override { return true; }
+
   // List of tensor ops getter/setter
   // @Return the vector of tensor ops by non-const reference
 
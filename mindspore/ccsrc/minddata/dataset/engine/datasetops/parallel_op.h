@@ -23,6 +23,7 @@
 #include <utility>
 #include <vector>
 #include "minddata/dataset/include/dataset/constants.h"
+#include "minddata/dataset/core/global_context.h"
 #include "minddata/dataset/engine/datasetops/dataset_op.h"
 #include "minddata/dataset/engine/execution_tree.h"
 #include "minddata/dataset/engine/datasetops/source/io_block.h"
@@ -89,8 +90,11 @@ class ParallelOp : public DatasetOp {
   /// \return Status The status code returned
   virtual Status RegisterAndLaunchThreads() {
     RETURN_UNEXPECTED_IF_NULL(tree_);
-    worker_in_queues_.Init(num_workers_, worker_connector_size_);
-    worker_out_queues_.Init(num_workers_, worker_connector_size_);
+    // Each worker queue is fed by one thread and drained by one thread.
+    QueueType type = GlobalContext::config_manager()->enable_lock_free_queue() ? QueueType::kLockFreeSpsc
+                                                                               : QueueType::kBlocking;
+    worker_in_queues_.Init(num_workers_, worker_connector_size_, type);
+    worker_out_queues_.Init(num_workers_, worker_connector_size_, type);
 
     // Registers QueueList and individual Queues for interrupt services
     RETURN_IF_NOT_OK(worker_in_queues_.Register(tree_->AllTasks()));
@@ -59,6 +59,20 @@ Status ProjectOp::GetNextRow(TensorRow *row) {
   return Status::OK();
 }
 
+Status ProjectOp::GetNextRows(TensorTable *rows) {
+  RETURN_UNEXPECTED_IF_NULL(rows);
+  RETURN_IF_NOT_OK(child_[0]->GetNextRows(rows));
+  for (auto &row : *rows) {
+    if (!row.eoe() && !row.eof()) {
+      row = Project(row);
+    }
+    if (row.eoe()) {
+      UpdateRepeatAndEpochCounter();
+    }
+  }
+  return Status::OK();
+}
+
 TensorRow ProjectOp::Project(const TensorRow &row) {
   TensorRow new_row;
   (void)std::transform(projected_column_indices_.begin(), projected_column_indices_.end(), std::back_inserter(new_row),
@@ -61,6 +61,10 @@ class ProjectOp : public PipelineOp {
   // @param worker_id - The worker id
   Status GetNextRow(TensorRow *row) override;
 
+  // Gets the rows the child hands over at once and projects them together.
+  // @param rows - output pointer to the projected rows.
+  Status GetNextRows(TensorTable *rows) override;
+
   // Base-class override for special eoe handler.
   // Inline operators must override this because there is no connector to push eoe onto.
   // @return Status The status code returned
@@ -62,6 +62,9 @@ MindRecordOp::MindRecordOp(int32_t num_mind_record_workers, std::vector<std::str
 
 // Private helper method to encapsulate some common construction/reset tasks
 Status MindRecordOp::Init() {
+  // Keep the scalar index fields columnar in the reader, LoadTensorRow reads them by row id without a json per row.
+  shard_reader_->SetColumnarLabel(true);
+  shard_reader_->SetIndexSnapshot(GlobalContext::config_manager()->enable_mindrecord_index_snapshot());
   RETURN_IF_NOT_OK(shard_reader_->Open(dataset_file_, load_dataset_, num_mind_record_workers_, columns_to_load_,
                                        operators_, num_padded_));
 
@@ -172,21 +175,66 @@ Status MindRecordOp::WorkerEntry(int32_t worker_id) {
       if (row_id % LOG_INTERVAL == 0) {
         MS_LOG(DEBUG) << "MindRecord operator consumed row " << row_id << " by worker " << worker_id << ".";
       }
-      RETURN_IF_NOT_OK(GetRowFromReader(&fetched_row, row_id, worker_id));
-      RETURN_IF_NOT_OK(worker_out_queues_[worker_id]->EmplaceBack(std::move(fetched_row)));
+      std::vector<int64_t> row_ids = {keys[0]};
+      std::unique_ptr<IOBlock> next_block;
+      RETURN_IF_NOT_OK(CollectQueuedRows(worker_id, &row_ids, &next_block));
+      if (row_ids.size() == 1) {
+        RETURN_IF_NOT_OK(GetRowFromReader(&fetched_row, row_id, worker_id));
+        RETURN_IF_NOT_OK(worker_out_queues_[worker_id]->EmplaceBack(std::move(fetched_row)));
+      } else {
+        std::vector<mindrecord::TASK_CONTENT> task_contents;
+        RETURN_IF_NOT_OK(shard_reader_->GetNextByIds(row_ids, worker_id, &task_contents));
+        CHECK_FAIL_RETURN_UNEXPECTED(task_contents.size() == row_ids.size(),
+                                     "[Internal ERROR] Failed to read " + std::to_string(row_ids.size()) +
+                                       " rows from mindrecord files, got: " + std::to_string(task_contents.size()));
+        for (size_t i = 0; i < row_ids.size(); ++i) {
+          RETURN_IF_NOT_OK(GetRowFromTaskContent(&fetched_row, row_ids[i], task_contents[i]));
+          RETURN_IF_NOT_OK(worker_out_queues_[worker_id]->EmplaceBack(std::move(fetched_row)));
+        }
+      }
+      if (next_block != nullptr) {
+        io_block = std::move(next_block);
+        continue;
+      }
     }
     RETURN_IF_NOT_OK(worker_in_queues_[worker_id]->PopFront(&io_block));
   }
   RETURN_STATUS_UNEXPECTED("[Internal ERROR] Unexpected nullptr received in worker.");
 }
 
+Status MindRecordOp::CollectQueuedRows(int32_t worker_id, std::vector<int64_t> *row_ids,
+                                       std::unique_ptr<IOBlock> *next_block) {
+  // Only the rows already queued for this worker are taken, so it never waits for more work than it has. A control
+  // block stops the collection and is handed back to be processed after the rows.
+  auto max_rows = static_cast<size_t>(shard_reader_->GetIoQueueDepth());
+  while (row_ids->size() < max_rows && !worker_in_queues_[worker_id]->empty()) {
+    std::unique_ptr<IOBlock> io_block;
+    RETURN_IF_NOT_OK(worker_in_queues_[worker_id]->PopFront(&io_block));
+    std::vector<int64_t> keys;
+    if (io_block != nullptr && !io_block->wait() && !io_block->eoe() && !io_block->eof()) {
+      RETURN_IF_NOT_OK(io_block->GetKeys(&keys));
+    }
+    if (keys.empty()) {
+      *next_block = std::move(io_block);
+      break;
+    }
+    row_ids->push_back(keys[0]);
+  }
+  return Status::OK();
+}
+
 Status MindRecordOp::GetRowFromReader(TensorRow *fetched_row, uint64_t row_id, int32_t worker_id) {
-  *fetched_row = {};
   auto rc = shard_reader_->GetNextById(row_id, worker_id);
-  auto task_type = rc.first;
-  auto tupled_buffer = rc.second;
+  return GetRowFromTaskContent(fetched_row, row_id, rc);
+}
+
+Status MindRecordOp::GetRowFromTaskContent(TensorRow *fetched_row, uint64_t row_id,
+                                           const mindrecord::TASK_CONTENT &task_content) {
+  *fetched_row = {};
+  auto task_type = task_content.first;
+  const auto &tupled_buffer = task_content.second;
   if (task_type == mindrecord::TaskType::kPaddedTask) {
-    RETURN_IF_NOT_OK(LoadTensorRow(fetched_row, {}, mindrecord::json(), task_type));
+    RETURN_IF_NOT_OK(LoadTensorRow(fetched_row, row_id, {}, mindrecord::json(), task_type));
     std::vector<std::string> file_path(fetched_row->size(), dataset_file_[0]);
     fetched_row->setPath(file_path);
     fetched_row->setId(row_id);
@@ -196,9 +244,9 @@ Status MindRecordOp::GetRowFromReader(TensorRow *fetched_row, uint64_t row_id, i
   }
   if (task_type == mindrecord::TaskType::kCommonTask) {
     for (const auto &tupled_row : tupled_buffer) {
-      std::vector<uint8_t> columns_blob = std::get<0>(tupled_row);
-      mindrecord::json columns_json = std::get<1>(tupled_row);
-      RETURN_IF_NOT_OK(LoadTensorRow(fetched_row, columns_blob, columns_json, task_type));
+      const std::vector<uint8_t> &columns_blob = std::get<0>(tupled_row);
+      const mindrecord::json &columns_json = std::get<1>(tupled_row);
+      RETURN_IF_NOT_OK(LoadTensorRow(fetched_row, row_id, columns_blob, columns_json, task_type));
       std::vector<std::string> file_path(fetched_row->size(), dataset_file_[0]);
       fetched_row->setPath(file_path);
       fetched_row->setId(row_id);
@@ -208,8 +256,9 @@ Status MindRecordOp::GetRowFromReader(TensorRow *fetched_row, uint64_t row_id, i
   return Status::OK();
 }
 
-Status MindRecordOp::LoadTensorRow(TensorRow *tensor_row, const std::vector<uint8_t> &columns_blob,
+Status MindRecordOp::LoadTensorRow(TensorRow *tensor_row, uint64_t row_id, const std::vector<uint8_t> &columns_blob,
                                    const mindrecord::json &columns_json, const mindrecord::TaskType task_type) {
+  auto label_store = shard_reader_->GetLabelStore();
   for (int32_t i_col = 0; i_col < columns_to_load_.size(); i_col++) {
     auto column_name = columns_to_load_[i_col];
 
@@ -244,6 +293,12 @@ Status MindRecordOp::LoadTensorRow(TensorRow *tensor_row, const std::vector<uint
       if (data == nullptr) {
         data = reinterpret_cast<const unsigned char *>(data_ptr.get());
       }
+    } else if (label_store != nullptr && label_store->HasColumn(column_name)) {
+      // The value points into the label store, Tensor::CreateFromMemory below takes a copy of it.
+      mindrecord::ColumnCategory category;
+      RETURN_IF_NOT_OK(shard_column->GetColumnTypeByName(column_name, &column_data_type, &column_data_type_size,
+                                                         &column_shape, &category));
+      RETURN_IF_NOT_OK(label_store->GetColumn(static_cast<int64_t>(row_id), column_name, &data, &n_bytes));
     } else {
       RETURN_IF_NOT_OK(shard_column->GetColumnValueByName(column_name, columns_blob, columns_json, &data, &data_ptr,
                                                           &n_bytes, &column_data_type, &column_data_type_size,
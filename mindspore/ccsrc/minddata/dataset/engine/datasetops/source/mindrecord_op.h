@@ -120,11 +120,25 @@ class MindRecordOp : public MappableLeafOp {
  private:
   Status GetRowFromReader(TensorRow *fetched_row, uint64_t row_id, int32_t worker_id);
 
+  /// Converts a row read by the shard reader into a TensorRow
+  /// @param fetched_row - the tensor row to fill
+  /// @param row_id - the task id of the row
+  /// @param task_content - the row received from the reader
+  Status GetRowFromTaskContent(TensorRow *fetched_row, uint64_t row_id, const mindrecord::TASK_CONTENT &task_content);
+
+  /// Pops the rows already queued for a worker, up to the io queue depth of the reader, so that their blobs are read
+  /// together
+  /// @param worker_id - the worker
+  /// @param row_ids - the row ids to read, holding the first one on input
+  /// @param next_block - set to the control block that stopped the collection, if any
+  Status CollectQueuedRows(int32_t worker_id, std::vector<int64_t> *row_ids, std::unique_ptr<IOBlock> *next_block);
+
   /// Parses a single cell and puts the data into a tensor
   /// @param tensor_row - the tensor row to put the parsed data in
+  /// @param row_id - the task id of the row, used to look up the fields kept in the reader's label store
   /// @param columns_blob - the blob data received from the reader
   /// @param columns_json - the data for fields received from the reader
-  Status LoadTensorRow(TensorRow *tensor_row, const std::vector<uint8_t> &columns_blob,
+  Status LoadTensorRow(TensorRow *tensor_row, uint64_t row_id, const std::vector<uint8_t> &columns_blob,
                        const mindrecord::json &columns_json, const mindrecord::TaskType task_type);
 
   Status LoadTensorRow(row_id_type row_id, TensorRow *row) override {
@@ -15,7 +15,15 @@
  */
 #include "minddata/dataset/engine/datasetops/source/tf_reader_op.h"
 
+#if !defined(_WIN32) && !defined(_WIN64)
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
 #include <algorithm>
+#include <cerrno>
+#include <cstring>
 #include <fstream>
 #include <future>
 #include <memory>
@@ -86,7 +94,9 @@ TFReaderOp::TFReaderOp(int32_t num_workers, int32_t worker_connector_size, int64
       dataset_files_list_(std::move(dataset_files_list)),
       columns_to_load_(std::move(columns_to_load)),
       data_schema_(std::move(data_schema)),
-      equal_rows_per_shard_(equal_rows_per_shard) {}
+      equal_rows_per_shard_(equal_rows_per_shard),
+      use_mmap_(GlobalContext::config_manager()->enable_tf_reader_mmap()),
+      verify_crc_(GlobalContext::config_manager()->tf_reader_verify_crc()) {}
 
 // A print method typically used for debugging
 void TFReaderOp::Print(std::ostream &out, bool show_all) const {
@@ -271,13 +281,22 @@ Status TFReaderOp::LoadFile(const std::string &filename, int64_t start_offset, i
     RETURN_STATUS_UNEXPECTED("Invalid file path, " + filename + " does not exist.");
   }
 
+#if !defined(_WIN32) && !defined(_WIN64)
+  if (use_mmap_) {
+    return LoadFileByMmap(filename, realpath.value(), start_offset, end_offset, worker_id);
+  }
+#endif
+  return LoadFileByStream(filename, realpath.value(), start_offset, end_offset, worker_id);
+}
+
+Status TFReaderOp::LoadFileByStream(const std::string &filename, const std::string &realpath, int64_t start_offset,
+                                    int64_t end_offset, int32_t worker_id) {
   std::ifstream reader;
-  reader.open(realpath.value());
+  reader.open(realpath);
   if (!reader) {
     RETURN_STATUS_UNEXPECTED("Invalid file, " + filename + " open failed: permission denied!");
   }
 
-  int64_t rows_read = 0;
   int64_t rows_total = 0;
 
   while (reader.peek() != EOF) {
@@ -298,22 +317,8 @@ Status TFReaderOp::LoadFile(const std::string &filename, int64_t start_offset, i
     serialized_example.resize(record_length);
     (void)reader.read(&serialized_example[0], static_cast<std::streamsize>(record_length));
 
-    int32_t num_columns = data_schema_->NumColumns();
-    TensorRow newRow(num_columns, nullptr);
-
     if (start_offset == kInvalidOffset || (rows_total >= start_offset && rows_total < end_offset)) {
-      dataengine::Example tf_file;
-      if (!tf_file.ParseFromString(serialized_example)) {
-        std::string errMsg = "Failed to parse tfrecord file: " + filename + ", make sure protobuf version is suitable.";
-        MS_LOG(DEBUG) << errMsg + ", details of string: " << serialized_example;
-        RETURN_STATUS_UNEXPECTED(errMsg);
-      }
-
-      std::vector<std::string> file_path(num_columns, filename);
-      newRow.setPath(file_path);
-      RETURN_IF_NOT_OK(LoadExample(&tf_file, &newRow));
-      rows_read++;
-      RETURN_IF_NOT_OK(jagged_rows_connector_->Add(worker_id, std::move(newRow)));
+      RETURN_IF_NOT_OK(ParseAndLoadRecord(filename, serialized_example.data(), record_length, worker_id));
     }
 
     // ignore crc footer
@@ -324,6 +329,155 @@ Status TFReaderOp::LoadFile(const std::string &filename, int64_t start_offset, i
   return Status::OK();
 }
 
+#if !defined(_WIN32) && !defined(_WIN64)
+namespace {
+// Mapped pages behind the read cursor are dropped in steps of this size, so that the resident
+// set of a worker does not grow up to the size of the whole file.
+constexpr int64_t kMmapReleaseStep = 64 * 1024 * 1024;
+
+// Owns a read-only mapping of a whole file, the mapping is released when going out of scope.
+class MappedFile {
+ public:
+  MappedFile() = default;
+
+  ~MappedFile() {
+    if (addr_ != nullptr) {
+      (void)munmap(addr_, static_cast<size_t>(size_));
+    }
+    if (fd_ >= 0) {
+      (void)close(fd_);
+    }
+  }
+
+  MappedFile(const MappedFile &) = delete;
+  MappedFile &operator=(const MappedFile &) = delete;
+
+  Status Open(const std::string &realpath) {
+    fd_ = open(realpath.c_str(), O_RDONLY);
+    if (fd_ < 0) {
+      RETURN_STATUS_UNEXPECTED("Invalid file, " + realpath + " open failed: " + std::string(strerror(errno)));
+    }
+    struct stat st {};
+    if (fstat(fd_, &st) != 0) {
+      RETURN_STATUS_UNEXPECTED("Invalid file, failed to get the size of " + realpath + ": " +
+                               std::string(strerror(errno)));
+    }
+    size_ = static_cast<int64_t>(st.st_size);
+    if (size_ == 0) {
+      return Status::OK();
+    }
+    void *addr = mmap(nullptr, static_cast<size_t>(size_), PROT_READ, MAP_PRIVATE, fd_, 0);
+    if (addr == MAP_FAILED) {
+      RETURN_STATUS_UNEXPECTED("Invalid file, failed to mmap " + realpath + ": " + std::string(strerror(errno)));
+    }
+    addr_ = static_cast<char *>(addr);
+    // Records are consumed front to back, ask the kernel for aggressive read-ahead.
+    (void)madvise(addr_, static_cast<size_t>(size_), MADV_SEQUENTIAL);
+    return Status::OK();
+  }
+
+  // Drops the pages of [0, offset) which have already been consumed.
+  void Release(int64_t offset) {
+    int64_t page_size = sysconf(_SC_PAGESIZE);
+    int64_t aligned = offset / page_size * page_size;
+    if (aligned > released_) {
+      (void)madvise(addr_ + released_, static_cast<size_t>(aligned - released_), MADV_DONTNEED);
+      released_ = aligned;
+    }
+  }
+
+  const char *data() const { return addr_; }
+
+  int64_t size() const { return size_; }
+
+ private:
+  int fd_ = -1;
+  char *addr_ = nullptr;
+  int64_t size_ = 0;
+  int64_t released_ = 0;
+};
+}  // namespace
+
+Status TFReaderOp::LoadFileByMmap(const std::string &filename, const std::string &realpath, int64_t start_offset,
+                                  int64_t end_offset, int32_t worker_id) {
+  MappedFile file;
+  RETURN_IF_NOT_OK(file.Open(realpath));
+
+  const int64_t header_size = static_cast<int64_t>(sizeof(int64_t) + sizeof(uint32_t));
+  const int64_t footer_size = static_cast<int64_t>(sizeof(uint32_t));
+  const char *base = file.data();
+  int64_t offset = 0;
+  int64_t last_release = 0;
+  int64_t rows_total = 0;
+
+  while (offset < file.size()) {
+    if (!load_jagged_connector_) {
+      break;
+    }
+    // The rows after end_offset belong to other shards, no need to walk through them.
+    if (start_offset != kInvalidOffset && rows_total >= end_offset) {
+      break;
+    }
+    RETURN_IF_INTERRUPTED();
+
+    CHECK_FAIL_RETURN_UNEXPECTED(file.size() - offset >= header_size,
+                                 "Invalid data, tfrecord file: " + filename + " is truncated at offset " +
+                                   std::to_string(offset) + ", check tfrecord file.");
+    // read length, the mapped address is not guaranteed to be aligned
+    int64_t record_length = 0;
+    (void)memcpy(&record_length, base + offset, sizeof(int64_t));
+    CHECK_FAIL_RETURN_UNEXPECTED(
+      record_length >= 0 && record_length <= file.size() - offset - header_size - footer_size,
+      "Invalid data, tfrecord file: " + filename + " has an invalid record length " + std::to_string(record_length) +
+        " at offset " + std::to_string(offset) + ", check tfrecord file.");
+    const char *record = base + offset + header_size;
+
+    bool in_range = start_offset == kInvalidOffset || (rows_total >= start_offset && rows_total < end_offset);
+    if (in_range) {
+      if (verify_crc_) {
+        uint32_t masked_crc = 0;
+        (void)memcpy(&masked_crc, base + offset + sizeof(int64_t), sizeof(uint32_t));
+        uint32_t data_crc = 0;
+        (void)memcpy(&data_crc, record + record_length, sizeof(uint32_t));
+        CHECK_FAIL_RETURN_UNEXPECTED(
+          masked_crc == system::Crc32c::GetMaskCrc32cValue(base + offset, sizeof(int64_t)) &&
+            data_crc == system::Crc32c::GetMaskCrc32cValue(record, static_cast<size_t>(record_length)),
+          "Invalid data, crc mismatch of the record at offset " + std::to_string(offset) +
+            " in tfrecord file: " + filename + ", check tfrecord file.");
+      }
+      RETURN_IF_NOT_OK(ParseAndLoadRecord(filename, record, record_length, worker_id));
+    }
+
+    offset += header_size + record_length + footer_size;
+    rows_total++;
+    if (offset - last_release >= kMmapReleaseStep) {
+      file.Release(offset);
+      last_release = offset;
+    }
+  }
+
+  return Status::OK();
+}
+#endif
+
+Status TFReaderOp::ParseAndLoadRecord(const std::string &filename, const char *data, int64_t length,
+                                      int32_t worker_id) {
+  dataengine::Example tf_file;
+  if (!tf_file.ParseFromArray(data, static_cast<int>(length))) {
+    std::string errMsg = "Failed to parse tfrecord file: " + filename + ", make sure protobuf version is suitable.";
+    MS_LOG(DEBUG) << errMsg + ", details of string: " << std::string(data, static_cast<size_t>(length));
+    RETURN_STATUS_UNEXPECTED(errMsg);
+  }
+
+  int32_t num_columns = data_schema_->NumColumns();
+  TensorRow newRow(num_columns, nullptr);
+  std::vector<std::string> file_path(num_columns, filename);
+  newRow.setPath(file_path);
+  RETURN_IF_NOT_OK(LoadExample(&tf_file, &newRow));
+  RETURN_IF_NOT_OK(jagged_rows_connector_->Add(worker_id, std::move(newRow)));
+  return Status::OK();
+}
+
 // Parses a single row and puts the data into a tensor table.
 Status TFReaderOp::LoadExample(const dataengine::Example *tf_file, TensorRow *out_row) {
   int32_t num_columns = data_schema_->NumColumns();
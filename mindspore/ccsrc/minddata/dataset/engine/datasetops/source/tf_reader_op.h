@@ -113,6 +113,34 @@ class TFReaderOp : public NonMappableLeafOp {
   // @return Status - the error code returned.
   Status LoadFile(const std::string &filename, int64_t start_offset, int64_t end_offset, int32_t worker_id) override;
 
+  // Reads a tf_file file through an ifstream, each record is copied into a string before parsing.
+  // @param filename - the tf_file file name given by the user, which is recorded as the path of the rows.
+  // @param realpath - the real path of the tf_file file to read.
+  // @param start_offset - the start offset of file.
+  // @param end_offset - the end offset of file.
+  // @param worker_id - the id of the worker that is executing this function.
+  // @return Status - the error code returned.
+  Status LoadFileByStream(const std::string &filename, const std::string &realpath, int64_t start_offset,
+                          int64_t end_offset, int32_t worker_id);
+
+  // Reads a tf_file file through mmap, each record is parsed directly from the mapped pages.
+  // @param filename - the tf_file file name given by the user, which is recorded as the path of the rows.
+  // @param realpath - the real path of the tf_file file to read.
+  // @param start_offset - the start offset of file.
+  // @param end_offset - the end offset of file.
+  // @param worker_id - the id of the worker that is executing this function.
+  // @return Status - the error code returned.
+  Status LoadFileByMmap(const std::string &filename, const std::string &realpath, int64_t start_offset,
+                        int64_t end_offset, int32_t worker_id);
+
+  // Parses a serialized Example and pushes the loaded row to the jagged connector.
+  // @param filename - the tf_file file the record comes from.
+  // @param data - pointer to the serialized Example.
+  // @param length - length of the serialized Example in bytes.
+  // @param worker_id - the id of the worker that is executing this function.
+  // @return Status - the error code returned.
+  Status ParseAndLoadRecord(const std::string &filename, const char *data, int64_t length, int32_t worker_id);
+
   // Parses a single row and puts the data into a tensor table.
   // @param tf_file - the row to be parsed.
   // @param tensor_table - the tensor table to put the parsed data in.
@@ -206,6 +234,8 @@ class TFReaderOp : public NonMappableLeafOp {
   std::unique_ptr<DataSchema> data_schema_;
 
   bool equal_rows_per_shard_;
+  bool use_mmap_;
+  bool verify_crc_;
 };
 }  // namespace dataset
 }  // namespace mindspore
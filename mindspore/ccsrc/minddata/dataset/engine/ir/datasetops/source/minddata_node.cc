@@ -42,7 +42,9 @@ MindDataNode::MindDataNode(const std::vector<std::string> &dataset_files, const
       padded_sample_(padded_sample),
       sample_bytes_({}),
       num_padded_(num_padded),
-      shuffle_mode_(shuffle_mode) {}
+      shuffle_mode_(shuffle_mode),
+      io_mode_(mindrecord::IoMode::kStream),
+      io_queue_depth_(mindrecord::kDefaultIoQueueDepth) {}
 
 MindDataNode::MindDataNode(const std::string &dataset_file, const std::vector<std::string> &columns_list,
                            const std::shared_ptr<SamplerObj> &sampler, nlohmann::json padded_sample, int64_t num_padded,
@@ -57,7 +59,9 @@ MindDataNode::MindDataNode(const std::string &dataset_file, const std::vector<st
       padded_sample_(padded_sample),
       sample_bytes_({}),
       num_padded_(num_padded),
-      shuffle_mode_(shuffle_mode) {}
+      shuffle_mode_(shuffle_mode),
+      io_mode_(mindrecord::IoMode::kStream),
+      io_queue_depth_(mindrecord::kDefaultIoQueueDepth) {}
 
 std::shared_ptr<DatasetNode> MindDataNode::Copy() {
   std::shared_ptr<MindDataNode> node;
@@ -70,6 +74,7 @@ std::shared_ptr<DatasetNode> MindDataNode::Copy() {
                                           shuffle_mode_, cache_);
   }
   node->SetSampleBytes(&sample_bytes_);
+  node->SetIoMode(io_mode_, io_queue_depth_);
   return node;
 }
 
@@ -125,6 +130,13 @@ Status MindDataNode::ValidateParams() {
     }
   }
 
+  if (io_queue_depth_ <= 0 || io_queue_depth_ > mindrecord::kMaxIoQueueDepth) {
+    std::string err_msg = "MindDataset: 'io_queue_depth' must be between 1 and " +
+                          std::to_string(mindrecord::kMaxIoQueueDepth) +
+                          ", but got: " + std::to_string(io_queue_depth_);
+    LOG_AND_RETURN_STATUS_SYNTAX_ERROR(err_msg);
+  }
+
   return Status::OK();
 }
 
@@ -171,6 +183,11 @@ Status MindDataNode::BuildMindDatasetSamplerChain(const std::shared_ptr<SamplerO
 // Helper function to set sample_bytes from py::byte type
 void MindDataNode::SetSampleBytes(std::map<std::string, std::string> *sample_bytes) { sample_bytes_ = *sample_bytes; }
 
+void MindDataNode::SetIoMode(mindrecord::IoMode io_mode, int32_t io_queue_depth) {
+  io_mode_ = io_mode;
+  io_queue_depth_ = io_queue_depth;
+}
+
 Status MindDataNode::Build(std::vector<std::shared_ptr<DatasetOp>> *const node_ops) {
   RETURN_IF_NOT_OK(BuildMindDatasetSamplerChain(input_sampler_, &operators_, num_padded_, shuffle_mode_));
 
@@ -199,6 +216,7 @@ Status MindDataNode::Build(std::vector<std::shared_ptr<DatasetOp>> *const node_o
                                  "Internal error. MindDataNode's sampler should be a MindRecordSamplerObj object");
     RETURN_IF_NOT_OK(mr_sampler->GetShardReader(&shard_reader));
   }
+  shard_reader->SetIoMode(io_mode_, io_queue_depth_);
 
   std::shared_ptr<MindRecordOp> mindrecord_op;
   // If pass a string to MindData(), it will be treated as a pattern to search for matched files,
@@ -77,6 +77,11 @@ class MindDataNode : public MappableSourceNode {
   /// \note Pybind will use this function to set sample_bytes into MindDataNode
   void SetSampleBytes(std::map<std::string, std::string> *sample_bytes);
 
+  /// \brief Set how the blobs of the dataset are read
+  /// \param[in] io_mode Read the blobs synchronously, or asynchronously through a thread pool or io_uring
+  /// \param[in] io_queue_depth Maximum number of blob reads in flight per worker in the asynchronous modes
+  void SetIoMode(mindrecord::IoMode io_mode, int32_t io_queue_depth);
+
   /// \brief Base-class override for GetDatasetSize
   /// \param[in] size_getter Shared pointer to DatasetSizeGetter
   /// \param[in] estimate This is only supported by some of the ops and it's used to speed up the process of getting
@@ -118,6 +123,8 @@ class MindDataNode : public MappableSourceNode {
   int64_t num_padded_;
   std::vector<std::shared_ptr<ShardOperator>> operators_;
   ShuffleMode shuffle_mode_;
+  mindrecord::IoMode io_mode_;
+  int32_t io_queue_depth_;
 };
 }  // namespace dataset
 }  // namespace mindspore
@@ -16,9 +16,16 @@
 #ifndef MINDSPORE_CCSRC_MINDDATA_DATASET_ENGINE_OPERATOR_CONNECTOR_H_
 #define MINDSPORE_CCSRC_MINDDATA_DATASET_ENGINE_OPERATOR_CONNECTOR_H_
 
+#include <algorithm>
+#include <atomic>
+#include <deque>
+#include <iterator>
+#include <limits>
 #include <memory>
+#include <mutex>
 #include <string>
 #include <utility>
+#include <vector>
 #include "minddata/dataset/core/tensor_row.h"
 #include "minddata/dataset/engine/connector.h"
 
@@ -27,22 +34,88 @@
 namespace mindspore {
 namespace dataset {
 
+// The connector between two operators. By default every TensorRow is a queue element of its own. In row batch mode
+// the rows are handed over in batches of up to row_batch_size rows instead, so that the locking and the wake ups are
+// paid once per batch rather than once per row, and the batch vectors are recycled rather than allocated.
+//
+// A batch is handed over when it is full, when a control row (eoe, eof, ...) is added, or as soon as the consumer
+// runs out of rows, in which case it takes the rows gathered so far. Rows are therefore never held back from a waiting
+// consumer, and a batch never spans an epoch boundary.
 class OperatorConnector : public Queue<TensorRow> {
  public:
   /// Constructor of OperatorConnector
   /// \param queue_capacity The number of element (TensorRows) for the queue.
-  explicit OperatorConnector(int32_t queue_capacity) : Queue<TensorRow>(queue_capacity) {
+  /// \param type The implementation of the underlying queue, not used in row batch mode.
+  /// \param row_batch_size The number of rows handed over at once, 0 or 1 hands them over one by one. It is capped at
+  ///     kMaxRowBatchSize.
+  explicit OperatorConnector(int32_t queue_capacity, QueueType type = QueueType::kBlocking, int32_t row_batch_size = 0)
+      : Queue<TensorRow>(row_batch_size > 1 ? 1 : queue_capacity, type, kMaxConnectorCapacity),
+        row_batch_size_(row_batch_size > 1 ? static_cast<size_t>(std::min(row_batch_size, kMaxRowBatchSize)) : 0),
+        num_batched_rows_(0),
+        consumer_waiting_(false),
+        drain_pos_(0) {
     my_name_ = Services::GetUniqueID();
     out_rows_count_ = 0;
+    SetBatchCapacity(queue_capacity);
   }
 
   /// Destructor of -OperatorConnector
   ~OperatorConnector() = default;
 
+  bool IsRowBatchMode() const { return row_batch_size_ > 0; }
+
+  Status Add(const TensorRow &row) noexcept {
+    if (!IsRowBatchMode()) {
+      return Queue::Add(row);
+    }
+    return AddToBatch(TensorRow(row));
+  }
+
+  Status Add(TensorRow &&row) noexcept {
+    if (!IsRowBatchMode()) {
+      return Queue::Add(std::move(row));
+    }
+    return AddToBatch(std::move(row));
+  }
+
   Status PopFront(TensorRow *row) {
     out_rows_count_++;
-    return Queue::PopFront(row);
+    if (!IsRowBatchMode()) {
+      return Queue::PopFront(row);
+    }
+    RETURN_UNEXPECTED_IF_NULL(row);
+    std::unique_lock<std::mutex> lock(drain_mux_);
+    if (drain_pos_ == drain_.size()) {
+      RETURN_IF_NOT_OK(TakeBatch(&drain_));
+      drain_pos_ = 0;
+    }
+    *row = std::move(drain_[drain_pos_++]);
+    return Status::OK();
+  }
+
+  /// Pop the rows handed over together, at least one. The rows come in order and the last one of a batch is the
+  /// only one which can be a control row. Without row batch mode this is the same as PopFront.
+  /// \param[out] rows The rows
+  /// \return Status code
+  Status PopRows(TensorTable *rows) {
+    RETURN_UNEXPECTED_IF_NULL(rows);
+    if (!IsRowBatchMode()) {
+      rows->resize(1);
+      return PopFront(&rows->front());
+    }
+    std::unique_lock<std::mutex> lock(drain_mux_);
+    if (drain_pos_ == drain_.size()) {
+      RETURN_IF_NOT_OK(TakeBatch(rows));
+    } else {
+      rows->clear();
+      (void)std::move(drain_.begin() + drain_pos_, drain_.end(), std::back_inserter(*rows));
+      drain_.clear();
+      drain_pos_ = 0;
+    }
+    out_rows_count_ += static_cast<int64_t>(rows->size());
+    return Status::OK();
   }
+
   Status SendEOE() noexcept {
     TensorRow eoe = TensorRow(TensorRow::kFlagEOE);
     return Add(std::move(eoe));
@@ -54,9 +127,143 @@ class OperatorConnector : public Queue<TensorRow> {
   }
   auto out_rows_count() const { return out_rows_count_; }
 
+  size_t size() const {
+    if (!IsRowBatchMode()) {
+      return Queue::size();
+    }
+    return num_batched_rows_.load();
+  }
+
+  size_t capacity() const {
+    if (!IsRowBatchMode()) {
+      return Queue::capacity();
+    }
+    return std::min(batch_capacity_ * row_batch_size_, static_cast<size_t>(std::numeric_limits<int32_t>::max()));
+  }
+
+  Status Register(TaskGroup *vg) {
+    if (!IsRowBatchMode()) {
+      return Queue::Register(vg);
+    }
+    RETURN_IF_NOT_OK(not_empty_cv_.Register(vg->GetIntrpService()));
+    return not_full_cv_.Register(vg->GetIntrpService());
+  }
+
+  Status Resize(int32_t new_capacity) {
+    if (!IsRowBatchMode()) {
+      return Queue::Resize(new_capacity);
+    }
+    CHECK_FAIL_RETURN_UNEXPECTED(new_capacity > 0,
+                                 "New capacity: " + std::to_string(new_capacity) + ", should be larger than 0");
+    std::unique_lock<std::mutex> lock(mux_);
+    SetBatchCapacity(new_capacity);
+    not_full_cv_.NotifyAll();
+    return Status::OK();
+  }
+
+  void Reset() {
+    if (!IsRowBatchMode()) {
+      Queue::Reset();
+      return;
+    }
+    std::unique_lock<std::mutex> drain_lock(drain_mux_);
+    std::unique_lock<std::mutex> lock(mux_);
+    batches_.clear();
+    staging_.clear();
+    drain_.clear();
+    drain_pos_ = 0;
+    num_batched_rows_ = 0;
+    not_empty_cv_.ResetIntrpState();
+    not_full_cv_.ResetIntrpState();
+  }
+
  private:
+  // Keep at least two batches in flight so that the producer can fill one while the consumer drains the other.
+  void SetBatchCapacity(int32_t queue_capacity) {
+    if (IsRowBatchMode()) {
+      auto num_batches = (static_cast<size_t>(queue_capacity) + row_batch_size_ - 1) / row_batch_size_;
+      batch_capacity_ = std::max<size_t>(2, num_batches);
+    }
+  }
+
+  // Caller holds mux_
+  TensorTable NewBatch() {
+    TensorTable batch;
+    if (!spare_batches_.empty()) {
+      batch = std::move(spare_batches_.back());
+      spare_batches_.pop_back();
+    } else {
+      batch.reserve(row_batch_size_);
+    }
+    return batch;
+  }
+
+  Status AddToBatch(TensorRow &&row) {
+    std::unique_lock<std::mutex> lock(mux_);
+    Status rc = not_full_cv_.Wait(&lock, [this]() { return batches_.size() < batch_capacity_; });
+    if (rc.IsError()) {
+      not_empty_cv_.Interrupt();
+      return rc;
+    }
+    bool hand_over = row.Flags() != TensorRow::TensorRowFlags::kFlagNone || consumer_waiting_;
+    staging_.push_back(std::move(row));
+    ++num_batched_rows_;
+    if (hand_over || staging_.size() >= row_batch_size_) {
+      batches_.push_back(std::move(staging_));
+      staging_ = NewBatch();
+      if (consumer_waiting_) {
+        not_empty_cv_.NotifyAll();
+      }
+    }
+    return Status::OK();
+  }
+
+  // Caller holds drain_mux_. The old content of batch is dropped and its vector is recycled.
+  Status TakeBatch(TensorTable *batch) {
+    std::unique_lock<std::mutex> lock(mux_);
+    if (batches_.empty() && staging_.empty()) {
+      consumer_waiting_ = true;
+      Status rc = not_empty_cv_.Wait(&lock, [this]() { return !batches_.empty() || !staging_.empty(); });
+      consumer_waiting_ = false;
+      if (rc.IsError()) {
+        not_full_cv_.Interrupt();
+        return rc;
+      }
+    }
+    batch->clear();
+    if (batch->capacity() >= row_batch_size_ && spare_batches_.size() < batch_capacity_) {
+      spare_batches_.push_back(std::move(*batch));
+    }
+    if (batches_.empty()) {
+      // Nothing is queued, take the rows gathered so far rather than wait for the batch to fill up.
+      *batch = std::move(staging_);
+      staging_ = NewBatch();
+    } else {
+      *batch = std::move(batches_.front());
+      batches_.pop_front();
+    }
+    num_batched_rows_ -= batch->size();
+    not_full_cv_.NotifyAll();
+    return Status::OK();
+  }
+
   std::string my_name_;
   int64_t out_rows_count_;
+
+  // Row batch mode
+  const size_t row_batch_size_;
+  size_t batch_capacity_;                   // Max number of full batches queued
+  std::atomic<size_t> num_batched_rows_;    // Rows queued or being gathered
+  std::mutex mux_;                          // Guards batches_, staging_ and spare_batches_
+  CondVar not_empty_cv_;
+  CondVar not_full_cv_;
+  bool consumer_waiting_;
+  std::deque<TensorTable> batches_;         // Full batches, oldest first
+  TensorTable staging_;                     // The batch being gathered, always newer than batches_
+  std::vector<TensorTable> spare_batches_;  // Drained batch vectors kept for reuse
+  std::mutex drain_mux_;                    // Guards drain_ and drain_pos_
+  TensorTable drain_;                       // The batch being popped row by row
+  size_t drain_pos_;                        // Next row of drain_ to pop
 };
 }  // namespace dataset
 }  // namespace mindspore
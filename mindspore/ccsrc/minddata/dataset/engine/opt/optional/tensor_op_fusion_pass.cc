@@ -24,7 +24,10 @@
 #include "minddata/dataset/kernels/image/random_crop_decode_resize_op.h"
 #include "minddata/dataset/kernels/ir/data/transforms_ir.h"
 #include "minddata/dataset/kernels/ir/vision/decode_ir.h"
+#include "minddata/dataset/kernels/ir/vision/hwc_to_chw_ir.h"
+#include "minddata/dataset/kernels/ir/vision/normalize_ir.h"
 #include "minddata/dataset/kernels/ir/vision/random_crop_decode_resize_ir.h"
+#include "minddata/dataset/kernels/ir/vision/random_crop_decode_resize_normalize_ir.h"
 #include "minddata/dataset/kernels/ir/vision/random_resized_crop_ir.h"
 
 namespace mindspore {
@@ -51,6 +54,29 @@ Status TensorOpFusionPass::Visit(std::shared_ptr<MapNode> node, bool *const modi
   }  // end of temporary code, needs to be deleted when tensorOperation's pybind completes
 
   // logic below is for non-prebuilt TensorOperation
+  // the longest pattern goes first, the whole decode-to-model-input chain becomes a single op
+  pattern = {vision::kDecodeOperation, vision::kRandomResizedCropOperation, vision::kNormalizeOperation,
+             vision::kHwcToChwOperation};
+  itr = std::search(ops.begin(), ops.end(), pattern.begin(), pattern.end(),
+                    [](auto op, const std::string &nm) { return op != nullptr ? op->Name() == nm : false; });
+  if (itr != ops.end()) {
+    const size_t crop_index = 1;
+    const size_t normalize_index = 2;
+    auto *crop_ir = dynamic_cast<vision::RandomResizedCropOperation *>((itr + crop_index)->get());
+    RETURN_UNEXPECTED_IF_NULL(crop_ir);
+    auto *normalize_ir = dynamic_cast<vision::NormalizeOperation *>((itr + normalize_index)->get());
+    RETURN_UNEXPECTED_IF_NULL(normalize_ir);
+    // a CHW Normalize expects its input to be transposed already, leave such a chain to the two-op fusion below
+    if (normalize_ir->is_hwc()) {
+      (*itr) = std::make_shared<vision::RandomCropDecodeResizeNormalizeOperation>(*crop_ir, normalize_ir->mean(),
+                                                                                   normalize_ir->std());
+      (void)ops.erase(itr + 1, itr + static_cast<int64_t>(pattern.size()));
+      node->setOperations(ops);
+      *modified = true;
+      return Status::OK();
+    }
+  }
+
   pattern = {vision::kDecodeOperation, vision::kRandomResizedCropOperation};
   itr = std::search(ops.begin(), ops.end(), pattern.begin(), pattern.end(),
                     [](auto op, const std::string &nm) { return op != nullptr ? op->Name() == nm : false; });
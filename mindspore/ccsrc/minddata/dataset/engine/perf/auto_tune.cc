@@ -17,7 +17,9 @@
 #include "minddata/dataset/engine/perf/auto_tune.h"
 
 #include <algorithm>
+#include <cmath>
 #include <functional>
+#include <limits>
 #include <memory>
 #include <utility>
 #include <vector>
@@ -45,12 +47,16 @@ AutoTune::AutoTune(TreeAdapter *tree_adap, ProfilingManager *profiling_mgr)
       AT_phase_(AutoTunePhase::kAutoTunePhaseTime),
       phase_1_best_time_(-1),
       phase_1_no_improve_count_(0),
-      AT_change_(false) {
+      AT_change_(false),
+      model_based_(false),
+      model_batch_time_(-1),
+      model_config_pending_(false) {
   tree_modifier_ = std::make_unique<TreeModifier>(tree_adapter_);
   max_workers_ = GlobalContext::config_manager()->num_cpu_threads();
   step_gap_ = GlobalContext::config_manager()->autotune_interval();
   save_autoconfig_ = GlobalContext::config_manager()->save_autoconfig();
   autotune_json_filepath_ = GlobalContext::config_manager()->get_autotune_json_filepath();
+  model_based_ = GlobalContext::config_manager()->enable_autotune_model();
 }
 
 Status AutoTune::Main() {
@@ -418,8 +424,8 @@ Status AutoTune::TrackPipelineTime() {
   avg_pipeline_times_.push_back(avg_time_pipeline);
   MS_LOG(INFO) << "Average Pipeline time is " << avg_time_pipeline << " ms. The avg pipeline time for all epochs is "
                << Mean(avg_pipeline_times_) << "ms";
-  // Time phase (phase 1) improvement tracking
-  if (AT_phase_ == AutoTunePhase::kAutoTunePhaseTime) {
+  // Time phase (phase 1) improvement tracking, the throughput model tracks its own plan instead
+  if (AT_phase_ == AutoTunePhase::kAutoTunePhaseTime && !model_based_) {
     if (phase_1_best_time_ < 0) {
       phase_1_best_time_ = avg_time_batch;  // set first value
     } else if (avg_time_batch < phase_1_best_time_) {
@@ -444,7 +450,11 @@ Status AutoTune::TrackPipelineTime() {
 
 Status AutoTune::RunIteration() {
   RETURN_IF_NOT_OK(TrackPipelineTime());
-  RETURN_IF_NOT_OK(AnalyseTime());
+  if (model_based_) {
+    RETURN_IF_NOT_OK(AnalyseModel());
+  } else {
+    RETURN_IF_NOT_OK(AnalyseTime());
+  }
   return Status::OK();
 }
 
@@ -560,16 +570,9 @@ Status AutoTune::AnalyseTime() {
   RETURN_IF_NOT_OK(GetOpsCpuUtil(&ops_cpu_util));
   // check parallel ops in loop
   for (const auto &op_id : parallel_ops_ids_) {
-    // Skip Generator op
-    if (ops_[op_id]->Name() == "GeneratorOp") {
-      continue;
-    }
-    //  NonMappableDataset is not supported in AutoTune
-#ifndef ENABLE_ANDROID
-    if (std::dynamic_pointer_cast<NonMappableLeafOp>(ops_[op_id]) != nullptr) {
+    if (!IsTunableOp(op_id)) {
       continue;
     }
-#endif
 
     // op specifics
     double output_queue_util = out_ops_queue_util[op_id];
@@ -613,5 +616,225 @@ Status AutoTune::AnalyseTime() {
   }
   return Status::OK();
 }
+
+bool AutoTune::IsTunableOp(int32_t op_id) {
+  // Skip Generator op
+  if (ops_[op_id]->Name() == "GeneratorOp") {
+    return false;
+  }
+  //  NonMappableDataset is not supported in AutoTune
+#ifndef ENABLE_ANDROID
+  if (std::dynamic_pointer_cast<NonMappableLeafOp>(ops_[op_id]) != nullptr) {
+    return false;
+  }
+#endif
+  return true;
+}
+
+Status AutoTune::GetBatchTimes(std::vector<int32_t> *batch_times) {
+  RETURN_UNEXPECTED_IF_NULL(batch_times);
+  if (mode_ == AutoTuneMode::kAutoTuneModeEpoch) {
+    RETURN_IF_NOT_OK(profiling_manager_->GetBatchTimeByEpoch(cur_epoch_running_ - 1, batch_times));
+  } else if (mode_ == AutoTuneMode::kAutoTuneModeStep) {
+    RETURN_IF_NOT_OK(profiling_manager_->GetBatchTimeByStep(last_step_autotuned_, cur_step_running_ - 1, batch_times));
+  }
+  return Status::OK();
+}
+
+Status AutoTune::BuildThroughputModel(const std::vector<int32_t> &batch_times,
+                                      const std::map<int32_t, double> &ops_cpu_util,
+                                      std::map<int32_t, double> *op_costs, double *batch_time) {
+  RETURN_UNEXPECTED_IF_NULL(op_costs);
+  RETURN_UNEXPECTED_IF_NULL(batch_time);
+  *batch_time = Mean(batch_times);
+  if (*batch_time <= 0) {
+    return Status::OK();
+  }
+  // The utilization is in percent of one core, so over a batch an op spends util * batch_time of CPU time. This cost
+  // does not depend on the number of workers, the ops with no measured cost are left as they are.
+  for (const auto &op_id : parallel_ops_ids_) {
+    auto util = ops_cpu_util.find(op_id);
+    if (!IsTunableOp(op_id) || util == ops_cpu_util.end() || util->second <= 0) {
+      continue;
+    }
+    (*op_costs)[op_id] = util->second / TO_PERCENT * (*batch_time);
+    MS_LOG(DEBUG) << "Op (" << ops_[op_id]->NameWithID() << ") costs " << (*op_costs)[op_id] << " ms of CPU per batch.";
+  }
+  return Status::OK();
+}
+
+Status AutoTune::GetQueueMemoryBudget(double *budget_mb, double *row_mb) {
+  RETURN_UNEXPECTED_IF_NULL(budget_mb);
+  RETURN_UNEXPECTED_IF_NULL(row_mb);
+  *budget_mb = 0;
+  *row_mb = 0;
+#ifndef ENABLE_ANDROID
+  std::vector<float> process_mem;
+  std::vector<float> available_mem;
+  if (mode_ == AutoTuneMode::kAutoTuneModeEpoch) {
+    RETURN_IF_NOT_OK(
+      profiling_manager_->GetMainProcessMemoryInfoByEpoch(ProcessMemoryMetric::kPSS, cur_epoch_running_, &process_mem));
+    RETURN_IF_NOT_OK(profiling_manager_->GetSystemMemoryInfoByEpoch(SystemMemoryMetric::kMemoryAvailable,
+                                                                    cur_epoch_running_, &available_mem));
+  } else if (mode_ == AutoTuneMode::kAutoTuneModeStep) {
+    RETURN_IF_NOT_OK(profiling_manager_->GetMainProcessMemoryInfoByStep(
+      ProcessMemoryMetric::kPSS, last_step_autotuned_, cur_step_running_ - 1, &process_mem));
+    RETURN_IF_NOT_OK(profiling_manager_->GetSystemMemoryInfoByStep(
+      SystemMemoryMetric::kMemoryAvailable, last_step_autotuned_, cur_step_running_ - 1, &available_mem));
+  }
+  std::map<int32_t, double> out_ops_queue_util;
+  std::map<int32_t, double> in_ops_queue_util;
+  RETURN_IF_NOT_OK(GetOpsQueueUtil(&out_ops_queue_util, &in_ops_queue_util));
+  double queued_rows = 0;
+  for (const auto &op : out_ops_queue_util) {
+    if (op.second > 0) {
+      queued_rows += op.second * ops_[op.first]->ConnectorCapacity();
+    }
+  }
+  // Charging the whole process to the queued rows overestimates a row, which keeps the queues on the safe side.
+  *row_mb = Mean(process_mem) / std::max(queued_rows, 1.0);
+  *budget_mb = MODEL_MEMORY_BUDGET_RATIO * Mean(available_mem);
+#endif
+  return Status::OK();
+}
+
+Status AutoTune::SolveAllocation(const std::map<int32_t, double> &op_costs, double budget_mb, double row_mb,
+                                 std::map<int32_t, int32_t> *workers, std::map<int32_t, int32_t> *capacities) {
+  RETURN_UNEXPECTED_IF_NULL(workers);
+  RETURN_UNEXPECTED_IF_NULL(capacities);
+  // The workers of the ops out of the model stay, the tunable ops share the rest of the CPU budget.
+  int32_t fixed_workers = 0;
+  for (const auto &op_id : parallel_ops_ids_) {
+    if (op_costs.find(op_id) == op_costs.end()) {
+      fixed_workers += ops_[op_id]->NumWorkers();
+    }
+  }
+  auto num_ops = static_cast<int32_t>(op_costs.size());
+  int32_t budget = std::max(max_workers_ - fixed_workers, num_ops * MIN_NUM_WORKERS);
+  int32_t used = 0;
+  for (const auto &op : op_costs) {
+    (*workers)[op.first] = MIN_NUM_WORKERS;
+    used += MIN_NUM_WORKERS;
+  }
+  // An op with w workers delivers w / cost batches per ms, and the pipeline runs at the pace of the slowest op. So
+  // every worker goes to the op with the lowest throughput, which maximizes the throughput of the pipeline.
+  while (used < budget) {
+    int32_t slowest_op = -1;
+    double slowest_rate = std::numeric_limits<double>::max();
+    for (const auto &op : op_costs) {
+      if ((*workers)[op.first] >= max_workers_) {
+        continue;
+      }
+      double rate = (*workers)[op.first] / op.second;
+      if (rate < slowest_rate) {
+        slowest_rate = rate;
+        slowest_op = op.first;
+      }
+    }
+    if (slowest_op == -1) {
+      break;
+    }
+    (*workers)[slowest_op]++;
+    used++;
+  }
+
+  // Every worker should find a few rows in the output queue, the growth of the queues is scaled down to fit in the
+  // memory budget.
+  double extra_rows = 0;
+  for (const auto &op : *workers) {
+    int32_t capacity = std::min(std::max(MODEL_QUEUE_PER_WORKER * op.second, MIN_QUEUE_SIZE), MAX_QUEUE_SIZE);
+    (*capacities)[op.first] = capacity;
+    extra_rows += std::max(capacity - ops_[op.first]->ConnectorCapacity(), 0);
+  }
+  if (row_mb > 0 && extra_rows * row_mb > budget_mb) {
+    double scale = budget_mb / (extra_rows * row_mb);
+    MS_LOG(INFO) << "Larger queues need " << (extra_rows * row_mb) << " MB, more than the budget of " << budget_mb
+                 << " MB, their growth is scaled by " << scale << ".";
+    for (auto &op : *capacities) {
+      int32_t old_capacity = ops_[op.first]->ConnectorCapacity();
+      if (op.second > old_capacity) {
+        op.second = old_capacity + static_cast<int32_t>((op.second - old_capacity) * scale);
+      }
+    }
+  }
+  return Status::OK();
+}
+
+bool AutoTune::IsModelDrifted(const std::map<int32_t, double> &op_costs, double batch_time) const {
+  if (model_batch_time_ > 0 && batch_time > model_batch_time_ * (1 + MODEL_DRIFT_THRESHOLD)) {
+    MS_LOG(INFO) << "Batch time " << batch_time << " ms drifted from " << model_batch_time_
+                 << " ms, the configuration will be solved again.";
+    return true;
+  }
+  for (const auto &op : op_costs) {
+    auto item = model_op_costs_.find(op.first);
+    if (item == model_op_costs_.end() || std::fabs(op.second - item->second) > MODEL_DRIFT_THRESHOLD * item->second) {
+      MS_LOG(INFO) << "Cost of Op (" << ops_.at(op.first)->NameWithID() << ") drifted to " << op.second
+                   << " ms per batch, the configuration will be solved again.";
+      return true;
+    }
+  }
+  return false;
+}
+
+Status AutoTune::AnalyseModel() {
+  std::vector<int32_t> batch_times;
+  RETURN_IF_NOT_OK(GetBatchTimes(&batch_times));
+  std::map<int32_t, double> ops_cpu_util;
+  RETURN_IF_NOT_OK(GetOpsCpuUtil(&ops_cpu_util));
+  std::map<int32_t, double> op_costs;
+  double batch_time = 0;
+  RETURN_IF_NOT_OK(BuildThroughputModel(batch_times, ops_cpu_util, &op_costs, &batch_time));
+  if (op_costs.empty()) {
+    return Status::OK();
+  }
+  if (model_config_pending_) {
+    // The change requests of the last plan have been applied, measure the plan as the reference for drift.
+    model_config_pending_ = false;
+    model_op_costs_ = op_costs;
+    model_batch_time_ = batch_time;
+#ifndef ENABLE_ANDROID
+    if (save_autoconfig_ && tree_adapter_->GetOffloadJson().empty() &&
+        SaveAutotuneConfig(autotune_json_filepath_).IsError()) {
+      MS_LOG(WARNING) << "Failed to write the solved autotune configuration to disk";
+    }
+#endif
+    return Status::OK();
+  }
+  if (!model_op_costs_.empty() && !IsModelDrifted(op_costs, batch_time)) {
+    return Status::OK();
+  }
+  bool isBottleneck = false;
+  RETURN_IF_NOT_OK(IsDSaBottleneck(&isBottleneck));
+  if (!isBottleneck) {
+    return Status::OK();
+  }
+
+  std::map<int32_t, int32_t> workers;
+  std::map<int32_t, int32_t> capacities;
+  double budget_mb = 0;
+  double row_mb = 0;
+  RETURN_IF_NOT_OK(GetQueueMemoryBudget(&budget_mb, &row_mb));
+  RETURN_IF_NOT_OK(SolveAllocation(op_costs, budget_mb, row_mb, &workers, &capacities));
+  // Only the ops whose configuration changed get a request, so a new plan adjusts the pipeline incrementally.
+  bool changed = false;
+  for (const auto &op : workers) {
+    int32_t num_workers = ops_[op.first]->NumWorkers();
+    int32_t requested_workers = op.second;
+    if (requested_workers != num_workers) {
+      RETURN_IF_NOT_OK(RequestNumWorkerChange(op.first, num_workers, &requested_workers));
+      changed = true;
+    }
+    int32_t queue_capacity = ops_[op.first]->ConnectorCapacity();
+    if (capacities[op.first] != queue_capacity) {
+      RETURN_IF_NOT_OK(RequestConnectorCapacityChange(op.first, queue_capacity, capacities[op.first]));
+      changed = true;
+    }
+  }
+  model_op_costs_ = op_costs;
+  model_batch_time_ = batch_time;
+  model_config_pending_ = changed;
+  return Status::OK();
+}
 }  // namespace dataset
 }  // namespace mindspore
@@ -117,7 +117,7 @@ class AutoTune {
   // system specifics
   int32_t max_workers_;
   const int32_t MIN_NUM_WORKERS = 1;
-  const int32_t MAX_QUEUE_SIZE = 128;
+  const int32_t MAX_QUEUE_SIZE = kMaxConnectorCapacity;
   const int32_t MIN_QUEUE_SIZE = 1;
   // Warmup specifics
   const int32_t EPOCH_WARMUP = 1;
@@ -139,6 +139,10 @@ class AutoTune {
   enum AutoTunePhase { kAutoTunePhaseTime, kAutoTuneEnd };
   // Early stop specifics
   const int32_t EARLY_STOP_TRIAL_THRESHOLD = 10;
+  // Throughput model specifics
+  const double MODEL_DRIFT_THRESHOLD = 0.3;
+  const double MODEL_MEMORY_BUDGET_RATIO = 0.5;
+  const int32_t MODEL_QUEUE_PER_WORKER = 2;
 
   /// Get the out connector capacity of the operator
   /// \param[in] op_id operator id
@@ -167,6 +171,53 @@ class AutoTune {
   /// \return Status code
   Status AnalyseTime();
 
+  /// Model-based AutoTune algorithm, solves the workers and queue sizes of all the tunable ops at once and solves
+  /// them again only when the measured costs drift away from the model
+  /// \return Status code
+  Status AnalyseModel();
+
+  /// Fetches the batch times of the current interval for steps or epoch based on mode
+  /// \param[out] batch_times the time (ms) between two batches
+  /// \return Status code
+  Status GetBatchTimes(std::vector<int32_t> *batch_times);
+
+  /// Build the throughput model of the tunable ops from the profiling data of the current interval
+  /// \param batch_times the time (ms) between two batches
+  /// \param ops_cpu_util map from op_id to cpu utilization
+  /// \param[out] op_costs map from op_id to the CPU time (ms) the op spends on one batch
+  /// \param[out] batch_time the average time (ms) between two batches
+  /// \return Status code
+  Status BuildThroughputModel(const std::vector<int32_t> &batch_times, const std::map<int32_t, double> &ops_cpu_util,
+                              std::map<int32_t, double> *op_costs, double *batch_time);
+
+  /// Solve the number of workers which maximizes the throughput of the slowest op under the CPU budget, then size
+  /// the queues after the workers under the memory budget
+  /// \param op_costs map from op_id to the CPU time (ms) the op spends on one batch
+  /// \param budget_mb the memory (MB) that may be spent on larger queues
+  /// \param row_mb the memory (MB) of a queued row
+  /// \param[out] workers map from op_id to the number of workers
+  /// \param[out] capacities map from op_id to the connector capacity
+  /// \return Status code
+  Status SolveAllocation(const std::map<int32_t, double> &op_costs, double budget_mb, double row_mb,
+                         std::map<int32_t, int32_t> *workers, std::map<int32_t, int32_t> *capacities);
+
+  /// Get the memory (MB) that may be spent on larger queues, and the estimated memory (MB) of a queued row
+  /// \param[out] budget_mb the memory budget
+  /// \param[out] row_mb the memory of a queued row
+  /// \return Status code
+  Status GetQueueMemoryBudget(double *budget_mb, double *row_mb);
+
+  /// Check whether the measured costs or the batch time moved away from the model the current plan was solved with
+  /// \param op_costs map from op_id to the CPU time (ms) the op spends on one batch
+  /// \param batch_time the average time (ms) between two batches
+  /// \return bool
+  bool IsModelDrifted(const std::map<int32_t, double> &op_costs, double batch_time) const;
+
+  /// Returns true if AutoTune may change the workers and queue size of the op
+  /// \param op_id operator ID
+  /// \return bool
+  bool IsTunableOp(int32_t op_id);
+
   /// Send a ChangeRequest to the operator to update the number of workers
   /// \param op_id operator ID
   /// \param old_workers Old number of workers for logging purposes
@@ -260,6 +311,15 @@ class AutoTune {
 
   /// Serialized json of the optimized ir tree that holds the updated configuration (workers and queue size)
   nlohmann::json autotune_config_json_;
+
+  /// True if the configuration is solved from the throughput model
+  bool model_based_;
+  /// Costs of the tunable ops the current plan was solved with, empty before the first plan
+  std::map<int32_t, double> model_op_costs_;
+  /// Batch time measured in the first interval after the current plan took effect, negative until then
+  double model_batch_time_;
+  /// True if a new plan was requested and its configuration has not been saved yet
+  bool model_config_pending_;
 };
 }  // namespace dataset
 }  // namespace mindspore
@@ -30,6 +30,7 @@
 #include "minddata/dataset/core/config_manager.h"
 #include "minddata/dataset/engine/execution_tree.h"
 #include "minddata/dataset/util/path.h"
+#include "minddata/dataset/util/size_class_pool.h"
 
 namespace mindspore {
 namespace dataset {
@@ -595,6 +596,16 @@ Status CpuSampler::SaveToFile(const std::string &dir_path, const std::string &ra
                                   {"available_sys_memory_mbytes", mem_avail},
                                   {"used_sys_memory_mbytes", mem_used}};
 
+  auto pool = std::dynamic_pointer_cast<SizeClassPool>(GlobalContext::Instance()->mem_pool());
+  if (pool != nullptr) {
+    SizeClassPool::Stats stats = pool->GetStats();
+    output["memory_pool_info"] = {{"hits", stats.hits},
+                                  {"misses", stats.misses},
+                                  {"large_allocs", stats.large_allocs},
+                                  {"releases", stats.releases},
+                                  {"cached_bytes", stats.cached_bytes}};
+  }
+
   // Discard the content of the file when opening.
   std::ofstream os(file_path, std::ios::trunc);
   os << output;
@@ -103,6 +103,7 @@
 #include "minddata/dataset/kernels/ir/vision/random_color_adjust_ir.h"
 #include "minddata/dataset/kernels/ir/vision/random_color_ir.h"
 #include "minddata/dataset/kernels/ir/vision/random_crop_decode_resize_ir.h"
+#include "minddata/dataset/kernels/ir/vision/random_crop_decode_resize_normalize_ir.h"
 #include "minddata/dataset/kernels/ir/vision/random_crop_ir.h"
 #include "minddata/dataset/kernels/ir/vision/random_crop_with_bbox_ir.h"
 #include "minddata/dataset/kernels/ir/vision/random_horizontal_flip_ir.h"
@@ -315,6 +315,7 @@ constexpr char kDftMetaColumnPrefix[] = "_meta-";
 constexpr int32_t kDecimal = 10;  // used in strtol() to convert a string value according to decimal numeral system
 constexpr int32_t kMinLegalPort = 1025;
 constexpr int32_t kMaxLegalPort = 65535;
+constexpr int32_t kMaxRowBatchSize = 4096;  // max number of rows handed over at once between ops
 
 // Invalid OpenCV type should not be from 0 to 7 (opencv4/opencv2/core/hal/interface.h)
 constexpr uint8_t kCVInvalidType = 255;
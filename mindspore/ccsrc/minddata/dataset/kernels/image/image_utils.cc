@@ -380,7 +380,7 @@ void JpegErrorExitCustom(j_common_ptr cinfo) {
 }
 
 Status JpegCropAndDecode(const std::shared_ptr<Tensor> &input, std::shared_ptr<Tensor> *output, int crop_x, int crop_y,
-                         int crop_w, int crop_h) {
+                         int crop_w, int crop_h, int scale_denom) {
   struct jpeg_decompress_struct cinfo;
   auto DestroyDecompressAndReturnError = [&cinfo](const std::string &err) {
     jpeg_destroy_decompress(&cinfo);
@@ -394,6 +394,9 @@ Status JpegCropAndDecode(const std::shared_ptr<Tensor> &input, std::shared_ptr<T
     JpegSetSource(&cinfo, input->GetBuffer(), input->SizeInBytes());
     (void)jpeg_read_header(&cinfo, TRUE);
     RETURN_IF_NOT_OK(JpegSetColorSpace(&cinfo));
+    // let libjpeg skip the high frequency DCT coefficients instead of decoding pixels that are resized away
+    cinfo.scale_num = 1;
+    cinfo.scale_denom = static_cast<unsigned int>(scale_denom);
     jpeg_calc_output_dimensions(&cinfo);
   } catch (std::runtime_error &e) {
     return DestroyDecompressAndReturnError(e.what());
@@ -945,6 +948,57 @@ Status Normalize(const std::shared_ptr<Tensor> &input, std::shared_ptr<Tensor> *
   return Status::OK();
 }
 
+Status NormalizeHwcToChw(const std::shared_ptr<Tensor> &input, std::shared_ptr<Tensor> *output,
+                         const std::vector<float> &scale, const std::vector<float> &shift) {
+  CHECK_FAIL_RETURN_UNEXPECTED(input->Rank() == DEFAULT_IMAGE_RANK,
+                               "NormalizeHwcToChw: image shape should be <H,W,C>, but got rank: " +
+                                 std::to_string(input->Rank()));
+  CHECK_FAIL_RETURN_UNEXPECTED(input->type() == DataType::DE_UINT8,
+                               "NormalizeHwcToChw: image type should be uint8, but got: " + input->type().ToString());
+  const int64_t height = input->shape()[kIndexZero];
+  const int64_t width = input->shape()[kIndexOne];
+  const int64_t num_channels = input->shape()[kIndexTwo];
+  const auto num_values = static_cast<int64_t>(scale.size());
+  CHECK_FAIL_RETURN_UNEXPECTED(scale.size() == shift.size() && (num_values == 1 || num_values == num_channels),
+                               "NormalizeHwcToChw: number of channels does not match the size of mean and std vectors, "
+                               "got channels: " +
+                                 std::to_string(num_channels) + ", size of mean: " + std::to_string(shift.size()));
+  RETURN_IF_NOT_OK(
+    Tensor::CreateEmpty(TensorShape({num_channels, height, width}), DataType(DataType::DE_FLOAT32), output));
+  const int64_t plane = height * width;
+  const uint8_t *src = input->GetBuffer();
+  auto *dst = reinterpret_cast<float *>((*output)->GetMutableBuffer());
+  if (num_channels == DEFAULT_IMAGE_CHANNELS) {
+    // Write the three planes in one sweep over the pixels. The loop has no aliasing and no branches, so the compiler
+    // can turn it into de-interleaving loads (ld3 on ARM, shuffles from SSE4.1 on) and packed multiply-subtract.
+    const float s0 = scale[0];
+    const float s1 = scale.size() == 1 ? scale[0] : scale[kIndexOne];
+    const float s2 = scale.size() == 1 ? scale[0] : scale[kIndexTwo];
+    const float m0 = shift[0];
+    const float m1 = shift.size() == 1 ? shift[0] : shift[kIndexOne];
+    const float m2 = shift.size() == 1 ? shift[0] : shift[kIndexTwo];
+    float *__restrict dst0 = dst;
+    float *__restrict dst1 = dst + plane;
+    float *__restrict dst2 = dst + plane * kIndexTwo;
+    const uint8_t *__restrict pixel = src;
+    for (int64_t i = 0; i < plane; ++i) {
+      dst0[i] = static_cast<float>(pixel[i * DEFAULT_IMAGE_CHANNELS]) * s0 - m0;
+      dst1[i] = static_cast<float>(pixel[i * DEFAULT_IMAGE_CHANNELS + kIndexOne]) * s1 - m1;
+      dst2[i] = static_cast<float>(pixel[i * DEFAULT_IMAGE_CHANNELS + kIndexTwo]) * s2 - m2;
+    }
+    return Status::OK();
+  }
+  for (int64_t c = 0; c < num_channels; ++c) {
+    const float s = scale.size() == 1 ? scale[0] : scale[c];
+    const float m = shift.size() == 1 ? shift[0] : shift[c];
+    float *plane_dst = dst + c * plane;
+    for (int64_t i = 0; i < plane; ++i) {
+      plane_dst[i] = static_cast<float>(src[i * num_channels + c]) * s - m;
+    }
+  }
+  return Status::OK();
+}
+
 Status NormalizePad(const std::shared_ptr<Tensor> &input, std::shared_ptr<Tensor> *output,
                     const std::shared_ptr<Tensor> &mean, const std::shared_ptr<Tensor> &std, const std::string &dtype,
                     bool is_hwc) {
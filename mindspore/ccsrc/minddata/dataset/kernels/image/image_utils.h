@@ -116,8 +116,13 @@ bool IsNonEmptyPNG(const std::shared_ptr<Tensor> &input);
 
 void JpegSetSource(j_decompress_ptr c_info, const void *data, int64_t data_size);
 
+/// \brief Decodes the given region of a JPEG image
+/// \param input: Tensor holding the encoded JPEG bytes.
+/// \param output: Decoded <h,w,3> RGB Tensor of type DE_UINT8.
+/// \param x, y, w, h: Crop box, in the coordinates of the image downscaled by scale_denom.
+/// \param scale_denom: libjpeg DCT scaling denominator (1, 2, 4 or 8), the image is decoded at 1/scale_denom size.
 Status JpegCropAndDecode(const std::shared_ptr<Tensor> &input, std::shared_ptr<Tensor> *output, int x = 0, int y = 0,
-                         int w = 0, int h = 0);
+                         int w = 0, int h = 0, int scale_denom = 1);
 
 /// \brief Returns Rescaled image
 /// \param input: Tensor of shape <H,W,C> or <H,W> and any OpenCv compatible type, see CVTensor.
@@ -219,6 +224,14 @@ Status NormalizePad(const std::shared_ptr<Tensor> &input, std::shared_ptr<Tensor
                     const std::shared_ptr<Tensor> &mean, const std::shared_ptr<Tensor> &std, const std::string &dtype,
                     bool is_hwc);
 
+/// \brief Normalizes an image and swaps it to CHW in a single pass, i.e. Normalize followed by HwcToChw
+/// \param input: Tensor of shape <H,W,C> and type DE_UINT8.
+/// \param output: Tensor of shape <C,H,W> and type DE_FLOAT32.
+/// \param scale: 1 / std of each channel, or a single value for all the channels.
+/// \param shift: mean / std of each channel, or a single value for all the channels.
+Status NormalizeHwcToChw(const std::shared_ptr<Tensor> &input, std::shared_ptr<Tensor> *output,
+                         const std::vector<float> &scale, const std::vector<float> &shift);
+
 /// \brief Returns image with adjusted brightness.
 /// \param input: Tensor of shape <H,W,3> in RGB order and any OpenCv compatible type, see CVTensor.
 /// \param alpha: Alpha value to adjust brightness by. Should be a positive number.
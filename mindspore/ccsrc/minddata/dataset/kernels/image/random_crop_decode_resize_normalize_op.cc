@@ -0,0 +1,118 @@
+/**
+ * Copyright 2022 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "minddata/dataset/kernels/image/random_crop_decode_resize_normalize_op.h"
+
+#include "minddata/dataset/kernels/image/decode_op.h"
+#include "minddata/dataset/kernels/image/image_utils.h"
+
+namespace mindspore {
+namespace dataset {
+namespace {
+// libjpeg can decode at 1/2, 1/4 and 1/8 of the original size by dropping DCT coefficients
+constexpr int32_t kMaxScaleDenom = 8;
+constexpr int32_t kScaleDenomStep = 2;
+}  // namespace
+
+RandomCropDecodeResizeNormalizeOp::RandomCropDecodeResizeNormalizeOp(int32_t target_height, int32_t target_width,
+                                                                     const std::vector<float> &mean,
+                                                                     const std::vector<float> &std, float scale_lb,
+                                                                     float scale_ub, float aspect_lb, float aspect_ub,
+                                                                     InterpolationMode interpolation,
+                                                                     int32_t max_attempts)
+    : RandomCropDecodeResizeNormalizeOp(RandomCropAndResizeOp(target_height, target_width, scale_lb, scale_ub,
+                                                              aspect_lb, aspect_ub, interpolation, max_attempts),
+                                        mean, std) {}
+
+RandomCropDecodeResizeNormalizeOp::RandomCropDecodeResizeNormalizeOp(const RandomCropAndResizeOp &rhs,
+                                                                     const std::vector<float> &mean,
+                                                                     const std::vector<float> &std)
+    : RandomCropAndResizeOp(rhs) {
+  // pre-calculate the coefficients so that each pixel costs a single multiply-subtract
+  for (size_t i = 0; i < mean.size() && i < std.size(); i++) {
+    scale_.push_back(1.0f / std[i]);
+    shift_.push_back(mean[i] / std[i]);
+  }
+}
+
+int32_t RandomCropDecodeResizeNormalizeOp::GetScaleDenom(int crop_height, int crop_width) const {
+  for (int32_t denom = kMaxScaleDenom; denom > 1; denom /= kScaleDenomStep) {
+    if (crop_height / denom >= target_height_ && crop_width / denom >= target_width_) {
+      return denom;
+    }
+  }
+  return 1;
+}
+
+Status RandomCropDecodeResizeNormalizeOp::Compute(const TensorRow &input, TensorRow *output) {
+  IO_CHECK_VECTOR(input, output);
+  output->resize(input.size());
+  int x = 0;
+  int y = 0;
+  int crop_height = 0;
+  int crop_width = 0;
+  for (size_t i = 0; i < input.size(); i++) {
+    if (input[i] == nullptr) {
+      RETURN_STATUS_UNEXPECTED("RandomCropDecodeResizeNormalize: input image is empty since got nullptr.");
+    }
+    std::shared_ptr<Tensor> resized;
+    if (!IsNonEmptyJPEG(input[i])) {
+      DecodeOp op(true);
+      std::shared_ptr<Tensor> decoded;
+      RETURN_IF_NOT_OK(op.Compute(input[i], &decoded));
+      CHECK_FAIL_RETURN_UNEXPECTED(decoded->Rank() == DEFAULT_IMAGE_RANK,
+                                   "RandomCropDecodeResizeNormalize: image shape should be <H,W,C>, but got rank: " +
+                                     std::to_string(decoded->Rank()));
+      if (i == 0) {
+        RETURN_IF_NOT_OK(GetCropBox(decoded->shape()[0], decoded->shape()[1], &x, &y, &crop_height, &crop_width));
+      }
+      RETURN_IF_NOT_OK(CropAndResize(decoded, &resized, x, y, crop_height, crop_width, target_height_, target_width_,
+                                     interpolation_));
+    } else {
+      int h_in = 0;
+      int w_in = 0;
+      RETURN_IF_NOT_OK(GetJpegImageInfo(input[i], &w_in, &h_in));
+      if (i == 0) {
+        RETURN_IF_NOT_OK(GetCropBox(h_in, w_in, &x, &y, &crop_height, &crop_width));
+      }
+      // the crop box is picked on the full image and mapped onto the downscaled one
+      const int32_t denom = GetScaleDenom(crop_height, crop_width);
+      std::shared_ptr<Tensor> decoded;
+      RETURN_IF_NOT_OK(JpegCropAndDecode(input[i], &decoded, x / denom, y / denom, crop_width / denom,
+                                         crop_height / denom, denom));
+      RETURN_IF_NOT_OK(Resize(decoded, &resized, target_height_, target_width_, 0.0, 0.0, interpolation_));
+    }
+    RETURN_IF_NOT_OK(NormalizeHwcToChw(resized, &(*output)[i], scale_, shift_));
+  }
+  return Status::OK();
+}
+
+Status RandomCropDecodeResizeNormalizeOp::OutputShape(const std::vector<TensorShape> &inputs,
+                                                      std::vector<TensorShape> &outputs) {
+  RETURN_IF_NOT_OK(TensorOp::OutputShape(inputs, outputs));
+  outputs.clear();
+  // decoded images are always RGB
+  (void)outputs.emplace_back(TensorShape{DEFAULT_IMAGE_CHANNELS, target_height_, target_width_});
+  return Status::OK();
+}
+
+Status RandomCropDecodeResizeNormalizeOp::OutputType(const std::vector<DataType> &inputs,
+                                                     std::vector<DataType> &outputs) {
+  RETURN_IF_NOT_OK(TensorOp::OutputType(inputs, outputs));
+  outputs[0] = DataType(DataType::DE_FLOAT32);
+  return Status::OK();
+}
+}  // namespace dataset
+}  // namespace mindspore
@@ -0,0 +1,69 @@
+/**
+ * Copyright 2022 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifndef MINDSPORE_CCSRC_MINDDATA_DATASET_KERNELS_IMAGE_RANDOM_CROP_DECODE_RESIZE_NORMALIZE_OP_H_
+#define MINDSPORE_CCSRC_MINDDATA_DATASET_KERNELS_IMAGE_RANDOM_CROP_DECODE_RESIZE_NORMALIZE_OP_H_
+
+#include <memory>
+#include <string>
+#include <vector>
+#include "minddata/dataset/core/tensor.h"
+#include "minddata/dataset/kernels/image/image_utils.h"
+#include "minddata/dataset/kernels/image/random_crop_and_resize_op.h"
+#include "minddata/dataset/kernels/tensor_op.h"
+#include "minddata/dataset/util/status.h"
+
+namespace mindspore {
+namespace dataset {
+// Fused Decode -> RandomResizedCrop -> Normalize -> HWC2CHW, created by the TensorOpFusionPass.
+// JPEG images are decoded with libjpeg DCT scaling when the crop is at least twice the target size, only the crop
+// window is decoded, and the resized image is normalized straight into the final CHW float32 tensor.
+class RandomCropDecodeResizeNormalizeOp : public RandomCropAndResizeOp {
+ public:
+  RandomCropDecodeResizeNormalizeOp(int32_t target_height, int32_t target_width, const std::vector<float> &mean,
+                                    const std::vector<float> &std, float scale_lb = kDefScaleLb,
+                                    float scale_ub = kDefScaleUb, float aspect_lb = kDefAspectLb,
+                                    float aspect_ub = kDefAspectUb, InterpolationMode interpolation = kDefInterpolation,
+                                    int32_t max_attempts = kDefMaxIter);
+
+  RandomCropDecodeResizeNormalizeOp(const RandomCropAndResizeOp &rhs, const std::vector<float> &mean,
+                                    const std::vector<float> &std);
+
+  ~RandomCropDecodeResizeNormalizeOp() override = default;
+
+  void Print(std::ostream &out) const override {
+    out << Name() << ": " << RandomCropAndResizeOp::target_height_ << " " << RandomCropAndResizeOp::target_width_;
+  }
+
+  Status Compute(const TensorRow &input, TensorRow *output) override;
+
+  Status OutputShape(const std::vector<TensorShape> &inputs, std::vector<TensorShape> &outputs) override;
+
+  Status OutputType(const std::vector<DataType> &inputs, std::vector<DataType> &outputs) override;
+
+  std::string Name() const override { return kRandomCropDecodeResizeNormalizeOp; }
+
+ private:
+  // Largest libjpeg scaling denominator that still decodes the crop at no less than the target size.
+  int32_t GetScaleDenom(int crop_height, int crop_width) const;
+
+  // normalization is applied as pixel * scale - shift, i.e. scale = 1 / std and shift = mean / std
+  std::vector<float> scale_;
+  std::vector<float> shift_;
+};
+}  // namespace dataset
+}  // namespace mindspore
+
+#endif  // MINDSPORE_CCSRC_MINDDATA_DATASET_KERNELS_IMAGE_RANDOM_CROP_DECODE_RESIZE_NORMALIZE_OP_H_
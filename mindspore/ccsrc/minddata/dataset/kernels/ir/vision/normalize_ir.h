@@ -51,6 +51,12 @@ class NormalizeOperation : public TensorOperation {
 
   static Status from_json(nlohmann::json op_params, std::shared_ptr<TensorOperation> *operation);
 
+  const std::vector<float> &mean() const { return mean_; }
+
+  const std::vector<float> &std() const { return std_; }
+
+  bool is_hwc() const { return is_hwc_; }
+
  private:
   std::vector<float> mean_;
   std::vector<float> std_;
@@ -0,0 +1,105 @@
+/**
+ * Copyright 2022 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "minddata/dataset/kernels/ir/vision/random_crop_decode_resize_normalize_ir.h"
+
+#ifndef ENABLE_ANDROID
+#include "minddata/dataset/kernels/image/random_crop_decode_resize_normalize_op.h"
+#endif
+
+#include "minddata/dataset/kernels/ir/validators.h"
+#include "minddata/dataset/util/validators.h"
+
+namespace mindspore {
+namespace dataset {
+namespace vision {
+#ifndef ENABLE_ANDROID
+// RandomCropDecodeResizeNormalizeOperation
+RandomCropDecodeResizeNormalizeOperation::RandomCropDecodeResizeNormalizeOperation(
+  const std::vector<int32_t> &size, const std::vector<float> &scale, const std::vector<float> &ratio,
+  InterpolationMode interpolation, int32_t max_attempts, const std::vector<float> &mean, const std::vector<float> &std)
+    : RandomResizedCropOperation(size, scale, ratio, interpolation, max_attempts), mean_(mean), std_(std) {}
+
+RandomCropDecodeResizeNormalizeOperation::RandomCropDecodeResizeNormalizeOperation(
+  const RandomResizedCropOperation &base, const std::vector<float> &mean, const std::vector<float> &std)
+    : RandomResizedCropOperation(base), mean_(mean), std_(std) {}
+
+RandomCropDecodeResizeNormalizeOperation::~RandomCropDecodeResizeNormalizeOperation() = default;
+
+std::string RandomCropDecodeResizeNormalizeOperation::Name() const { return kRandomCropDecodeResizeNormalizeOperation; }
+
+Status RandomCropDecodeResizeNormalizeOperation::ValidateParams() {
+  RETURN_IF_NOT_OK(RandomResizedCropOperation::ValidateParams());
+  RETURN_IF_NOT_OK(ValidateVectorMeanStd("RandomCropDecodeResizeNormalize", mean_, std_));
+  return Status::OK();
+}
+
+std::shared_ptr<TensorOp> RandomCropDecodeResizeNormalizeOperation::Build() {
+  constexpr size_t dimension_zero = 0;
+  constexpr size_t dimension_one = 1;
+  constexpr size_t size_two = 2;
+
+  int32_t crop_height = size_[dimension_zero];
+  int32_t crop_width = size_[dimension_zero];
+
+  // User has specified the crop_width value.
+  if (size_.size() == size_two) {
+    crop_width = size_[dimension_one];
+  }
+
+  auto tensor_op = std::make_shared<RandomCropDecodeResizeNormalizeOp>(
+    crop_height, crop_width, mean_, std_, scale_[dimension_zero], scale_[dimension_one], ratio_[dimension_zero],
+    ratio_[dimension_one], interpolation_, max_attempts_);
+  return tensor_op;
+}
+
+Status RandomCropDecodeResizeNormalizeOperation::to_json(nlohmann::json *out_json) {
+  nlohmann::json args;
+  args["size"] = size_;
+  args["scale"] = scale_;
+  args["ratio"] = ratio_;
+  args["interpolation"] = interpolation_;
+  args["max_attempts"] = max_attempts_;
+  args["mean"] = mean_;
+  args["std"] = std_;
+  *out_json = args;
+  return Status::OK();
+}
+
+Status RandomCropDecodeResizeNormalizeOperation::from_json(nlohmann::json op_params,
+                                                           std::shared_ptr<TensorOperation> *operation) {
+  RETURN_IF_NOT_OK(ValidateParamInJson(op_params, "size", kRandomCropDecodeResizeNormalizeOperation));
+  RETURN_IF_NOT_OK(ValidateParamInJson(op_params, "scale", kRandomCropDecodeResizeNormalizeOperation));
+  RETURN_IF_NOT_OK(ValidateParamInJson(op_params, "ratio", kRandomCropDecodeResizeNormalizeOperation));
+  RETURN_IF_NOT_OK(ValidateParamInJson(op_params, "interpolation", kRandomCropDecodeResizeNormalizeOperation));
+  RETURN_IF_NOT_OK(ValidateParamInJson(op_params, "max_attempts", kRandomCropDecodeResizeNormalizeOperation));
+  RETURN_IF_NOT_OK(ValidateParamInJson(op_params, "mean", kRandomCropDecodeResizeNormalizeOperation));
+  RETURN_IF_NOT_OK(ValidateParamInJson(op_params, "std", kRandomCropDecodeResizeNormalizeOperation));
+  std::vector<int32_t> size = op_params["size"];
+  std::vector<float> scale = op_params["scale"];
+  std::vector<float> ratio = op_params["ratio"];
+  InterpolationMode interpolation = static_cast<InterpolationMode>(op_params["interpolation"]);
+  int32_t max_attempts = op_params["max_attempts"];
+  std::vector<float> mean = op_params["mean"];
+  std::vector<float> std = op_params["std"];
+  *operation = std::make_shared<vision::RandomCropDecodeResizeNormalizeOperation>(size, scale, ratio, interpolation,
+                                                                                  max_attempts, mean, std);
+  return Status::OK();
+}
+
+#endif
+}  // namespace vision
+}  // namespace dataset
+}  // namespace mindspore
@@ -88,6 +88,7 @@ constexpr char kRandomColorOp[] = "RandomColorOp";
 constexpr char kRandomCropAndResizeOp[] = "RandomCropAndResizeOp";
 constexpr char kRandomCropAndResizeWithBBoxOp[] = "RandomCropAndResizeWithBBoxOp";
 constexpr char kRandomCropDecodeResizeOp[] = "RandomCropDecodeResizeOp";
+constexpr char kRandomCropDecodeResizeNormalizeOp[] = "RandomCropDecodeResizeNormalizeOp";
 constexpr char kRandomCropOp[] = "RandomCropOp";
 constexpr char kRandomCropWithBBoxOp[] = "RandomCropWithBBoxOp";
 constexpr char kRandomEqualizeOp[] = "RandomEqualizeOp";
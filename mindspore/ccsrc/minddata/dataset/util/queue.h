@@ -30,10 +30,21 @@
 #include "minddata/dataset/util/log_adapter.h"
 #include "minddata/dataset/util/services.h"
 #include "minddata/dataset/util/cond_var.h"
+#include "minddata/dataset/util/ring_queue.h"
 #include "minddata/dataset/util/task_manager.h"
 
 namespace mindspore {
 namespace dataset {
+// The implementation behind a Queue.
+// kBlocking - a mutex protected array, producers and consumers are woken up through condition variables.
+// kLockFreeSpsc - a lock-free ring buffer for at most one producer and one consumer at any time.
+// kLockFreeMpmc - a lock-free ring buffer for any number of producers and consumers.
+enum class QueueType { kBlocking, kLockFreeSpsc, kLockFreeMpmc };
+
+// The largest capacity AutoTune resizes a connector to. A lock-free connector preallocates its slots for it, since a
+// lock-free queue can't reallocate while it's in use.
+constexpr int32_t kMaxConnectorCapacity = 128;
+
 // A simple thread safe queue using a fixed size array
 template <typename T>
 class Queue {
@@ -44,8 +55,13 @@ class Queue {
   using reference = T &;
   using const_reference = const T &;
 
-  explicit Queue(int sz)
+  // max_sz is the largest capacity a lock-free queue may be resized to, the blocking queue reallocates on Resize.
+  explicit Queue(int sz, QueueType type = QueueType::kBlocking, int max_sz = 0)
       : sz_(sz), arr_(Services::GetAllocator<T>()), head_(0), tail_(0), my_name_(Services::GetUniqueID()) {
+    if (type != QueueType::kBlocking) {
+      ring_ = std::make_unique<RingQueue<T>>(sz, type == QueueType::kLockFreeSpsc, max_sz);
+      return;
+    }
     Status rc = arr_.allocate(sz);
     if (rc.IsError()) {
       MS_LOG(ERROR) << "Fail to create a queue.";
@@ -58,15 +74,22 @@ class Queue {
   virtual ~Queue() { ResetQue(); }
 
   size_t size() const {
+    if (ring_ != nullptr) {
+      return ring_->size();
+    }
     size_t v = tail_ - head_;
     return (v >= 0) ? v : 0;
   }
 
-  size_t capacity() const { return sz_; }
+  size_t capacity() const { return ring_ != nullptr ? ring_->capacity() : sz_; }
 
-  bool empty() const { return head_ == tail_; }
+  bool empty() const { return ring_ != nullptr ? ring_->empty() : head_ == tail_; }
 
   void Reset() {
+    if (ring_ != nullptr) {
+      ring_->Reset();
+      return;
+    }
     std::unique_lock<std::mutex> _lock(mux_);
     ResetQue();
     extra_arr_.clear();
@@ -74,6 +97,9 @@ class Queue {
 
   // Producer
   Status Add(const_reference ele) noexcept {
+    if (ring_ != nullptr) {
+      return ring_->Add(ele);
+    }
     std::unique_lock<std::mutex> _lock(mux_);
     // Block when full
     Status rc = full_cv_.Wait(&_lock, [this]() -> bool { return (size() != capacity()); });
@@ -88,6 +114,9 @@ class Queue {
   }
 
   Status Add(T &&ele) noexcept {
+    if (ring_ != nullptr) {
+      return ring_->Add(std::forward<T>(ele));
+    }
     std::unique_lock<std::mutex> _lock(mux_);
     // Block when full
     Status rc = full_cv_.Wait(&_lock, [this]() -> bool { return (size() != capacity()); });
@@ -103,6 +132,9 @@ class Queue {
 
   template <typename... Ts>
   Status EmplaceBack(Ts &&... args) noexcept {
+    if (ring_ != nullptr) {
+      return ring_->EmplaceBack(std::forward<Ts>(args)...);
+    }
     std::unique_lock<std::mutex> _lock(mux_);
     // Block when full
     Status rc = full_cv_.Wait(&_lock, [this]() -> bool { return (size() != capacity()); });
@@ -119,6 +151,9 @@ class Queue {
 
   // Consumer
   Status PopFront(pointer p) {
+    if (ring_ != nullptr) {
+      return ring_->PopFront(p);
+    }
     std::unique_lock<std::mutex> _lock(mux_);
     // Block when empty
     Status rc = empty_cv_.Wait(&_lock, [this]() -> bool { return !empty(); });
@@ -133,6 +168,9 @@ class Queue {
   }
 
   Status Register(TaskGroup *vg) {
+    if (ring_ != nullptr) {
+      return ring_->Register(vg);
+    }
     Status rc1 = empty_cv_.Register(vg->GetIntrpService());
     Status rc2 = full_cv_.Register(vg->GetIntrpService());
     if (rc1.IsOk()) {
@@ -143,6 +181,9 @@ class Queue {
   }
 
   Status Resize(int32_t new_capacity) {
+    if (ring_ != nullptr) {
+      return ring_->Resize(new_capacity);
+    }
     std::unique_lock<std::mutex> _lock(mux_);
     CHECK_FAIL_RETURN_UNEXPECTED(new_capacity > 0,
                                  "New capacity: " + std::to_string(new_capacity) + ", should be larger than 0");
@@ -195,6 +236,8 @@ class Queue {
   std::mutex mux_;
   CondVar empty_cv_;
   CondVar full_cv_;
+  // Set when the queue is backed by a lock-free ring buffer, all the public methods forward to it.
+  std::unique_ptr<RingQueue<T>> ring_;
 
   // Helper function for Add, must be called when holding a lock
   Status AddWhileHoldingLock(const_reference ele) {
@@ -241,10 +284,11 @@ class QueueList {
  public:
   QueueList() {}
 
-  void Init(int num_queues, int capacity) {
+  void Init(int num_queues, int capacity, QueueType type = QueueType::kBlocking) {
+    type_ = type;
     queue_list_.reserve(num_queues);
     for (int i = 0; i < num_queues; i++) {
-      queue_list_.emplace_back(std::make_unique<Queue<T>>(capacity));
+      queue_list_.emplace_back(std::make_unique<Queue<T>>(capacity, type_));
     }
   }
 
@@ -268,7 +312,7 @@ class QueueList {
   ~QueueList() = default;
 
   Status AddQueue(TaskGroup *vg) {
-    queue_list_.emplace_back(std::make_unique<Queue<T>>(queue_list_[0]->capacity()));
+    queue_list_.emplace_back(std::make_unique<Queue<T>>(queue_list_[0]->capacity(), type_));
     return queue_list_[queue_list_.size() - 1]->Register(vg);
   }
   Status RemoveLastQueue() {
@@ -282,6 +326,7 @@ class QueueList {
   // requirement that objects must have copy semantics.  To resolve this, we use a vector of unique
   // pointers.  This allows us to provide dynamic creation of queues in a container.
   std::vector<std::unique_ptr<Queue<T>>> queue_list_;
+  QueueType type_ = QueueType::kBlocking;
 };
 }  // namespace dataset
 }  // namespace mindspore
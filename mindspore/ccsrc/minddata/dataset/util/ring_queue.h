@@ -0,0 +1,307 @@
+/**
+ * Copyright 2022 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifndef MINDSPORE_CCSRC_MINDDATA_DATASET_UTIL_RING_QUEUE_H_
+#define MINDSPORE_CCSRC_MINDDATA_DATASET_UTIL_RING_QUEUE_H_
+
+#include <algorithm>
+#include <atomic>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <type_traits>
+#include <utility>
+
+#include "minddata/dataset/util/cond_var.h"
+#include "minddata/dataset/util/log_adapter.h"
+#include "minddata/dataset/util/services.h"
+#include "minddata/dataset/util/status.h"
+#include "minddata/dataset/util/task_manager.h"
+
+namespace mindspore {
+namespace dataset {
+// A bounded lock-free ring buffer. Every slot carries a sequence number telling whether it is ready to be written
+// (seq == pos) or to be read (seq == pos + 1), so producers and consumers never share a lock on the fast path.
+// When single_producer_consumer is true the cursors are advanced with plain stores instead of CAS, which is only
+// valid if at most one thread adds and at most one thread pops at any time (e.g. the per-worker queues of a
+// Connector, where the consumers are serialized by the Connector itself).
+//
+// A blocked caller first spins, then yields, and finally parks on a CondVar. Wake ups are only issued when
+// somebody is parked, so the common case does not touch the mutex at all.
+//
+// The number of slots is fixed at construction to the power of two above the larger of the initial capacity and the
+// max capacity, so a queue that is resized at runtime (e.g. a connector tuned by AutoTune) should be created with the
+// largest capacity it may grow to. Resize only moves the logical capacity within those slots, it never reallocates,
+// so it is safe to call while the queue is in use.
+template <typename T>
+class RingQueue {
+ public:
+  RingQueue(int32_t capacity, bool single_producer_consumer, int32_t max_capacity = 0)
+      : single_producer_consumer_(single_producer_consumer),
+        capacity_(static_cast<size_t>(std::max(capacity, 1))),
+        head_(0),
+        tail_(0),
+        producer_waiters_(0),
+        consumer_waiters_(0),
+        my_name_(Services::GetUniqueID()) {
+    size_t min_slots = std::max(capacity_.load(), static_cast<size_t>(std::max(max_capacity, 0)));
+    num_slots_ = 1;
+    while (num_slots_ < min_slots) {
+      num_slots_ <<= 1;
+    }
+    mask_ = num_slots_ - 1;
+    slots_ = std::make_unique<Slot[]>(num_slots_);
+    for (size_t i = 0; i < num_slots_; ++i) {
+      slots_[i].seq.store(i, std::memory_order_relaxed);
+    }
+    MS_LOG(DEBUG) << "Create lock-free Q with uuid " << my_name_ << " of size " << capacity_ << ".";
+  }
+
+  ~RingQueue() { Reset(); }
+
+  RingQueue(const RingQueue &) = delete;
+  RingQueue &operator=(const RingQueue &) = delete;
+
+  size_t size() const {
+    size_t head = head_.load(std::memory_order_acquire);
+    size_t tail = tail_.load(std::memory_order_acquire);
+    return tail > head ? tail - head : 0;
+  }
+
+  size_t capacity() const { return capacity_.load(std::memory_order_relaxed); }
+
+  bool empty() const { return size() == 0; }
+
+  // Producer
+  Status Add(const T &ele) noexcept {
+    return Produce([this, &ele]() { return TryEmplace(ele); });
+  }
+
+  Status Add(T &&ele) noexcept {
+    // The element is only moved from once a slot has been claimed, so retrying is safe.
+    return Produce([this, &ele]() { return TryEmplace(std::move(ele)); });
+  }
+
+  template <typename... Ts>
+  Status EmplaceBack(Ts &&... args) noexcept {
+    return Produce([this, &args...]() { return TryEmplace(std::forward<Ts>(args)...); });
+  }
+
+  // Consumer
+  Status PopFront(T *p) {
+    RETURN_UNEXPECTED_IF_NULL(p);
+    for (int32_t i = 0; i < kSpinCount; ++i) {
+      if (TryPop(p)) {
+        WakeUp(&producer_waiters_, &full_cv_);
+        return Status::OK();
+      }
+      Backoff(i);
+    }
+    while (true) {
+      if (TryPop(p)) {
+        WakeUp(&producer_waiters_, &full_cv_);
+        return Status::OK();
+      }
+      std::unique_lock<std::mutex> lock(mux_);
+      (void)consumer_waiters_.fetch_add(1);
+      std::atomic_thread_fence(std::memory_order_seq_cst);
+      Status rc = empty_cv_.Wait(&lock, [this]() -> bool { return Readable(); });
+      (void)consumer_waiters_.fetch_sub(1);
+      if (rc.IsError()) {
+        full_cv_.Interrupt();
+        return rc;
+      }
+    }
+  }
+
+  Status Register(TaskGroup *vg) {
+    Status rc1 = empty_cv_.Register(vg->GetIntrpService());
+    Status rc2 = full_cv_.Register(vg->GetIntrpService());
+    if (rc1.IsOk()) {
+      return rc2;
+    } else {
+      return rc1;
+    }
+  }
+
+  // Moves the logical capacity. Growing beyond the number of slots, which covers the max capacity given at
+  // construction, is clamped; shrinking below the current size keeps the elements and only blocks producers until the
+  // consumers have drained the excess.
+  Status Resize(int32_t new_capacity) {
+    CHECK_FAIL_RETURN_UNEXPECTED(new_capacity > 0,
+                                 "New capacity: " + std::to_string(new_capacity) + ", should be larger than 0");
+    size_t target = static_cast<size_t>(new_capacity);
+    if (target > num_slots_) {
+      MS_LOG(WARNING) << "Lock-free queue " << my_name_ << " has " << num_slots_ << " slots, the requested capacity "
+                      << new_capacity << " is clamped to it.";
+      target = num_slots_;
+    }
+    capacity_.store(target, std::memory_order_relaxed);
+    std::unique_lock<std::mutex> lock(mux_);
+    full_cv_.NotifyAll();
+    return Status::OK();
+  }
+
+  // Drops all the elements. Must not be called concurrently with Add or PopFront.
+  void Reset() noexcept {
+    T val;
+    while (TryPop(&val)) {
+    }
+    empty_cv_.ResetIntrpState();
+    full_cv_.ResetIntrpState();
+  }
+
+ private:
+  static constexpr int32_t kSpinCount = 256;
+  static constexpr int32_t kYieldAfter = 64;
+
+  struct Slot {
+    std::atomic<size_t> seq;
+    typename std::aligned_storage<sizeof(T), alignof(T)>::type storage;
+  };
+
+  static void Backoff(int32_t i) {
+    if (i >= kYieldAfter) {
+      std::this_thread::yield();
+    }
+  }
+
+  template <typename F>
+  Status Produce(const F &try_add) {
+    for (int32_t i = 0; i < kSpinCount; ++i) {
+      if (try_add()) {
+        WakeUp(&consumer_waiters_, &empty_cv_);
+        return Status::OK();
+      }
+      Backoff(i);
+    }
+    while (true) {
+      if (try_add()) {
+        WakeUp(&consumer_waiters_, &empty_cv_);
+        return Status::OK();
+      }
+      std::unique_lock<std::mutex> lock(mux_);
+      (void)producer_waiters_.fetch_add(1);
+      std::atomic_thread_fence(std::memory_order_seq_cst);
+      Status rc = full_cv_.Wait(&lock, [this]() -> bool { return Writable(); });
+      (void)producer_waiters_.fetch_sub(1);
+      if (rc.IsError()) {
+        empty_cv_.Interrupt();
+        return rc;
+      }
+    }
+  }
+
+  // Pairs with the fence taken by a parking thread, either the parked thread sees the new state when it checks
+  // its predicate under the lock, or we see it registered as a waiter here.
+  void WakeUp(std::atomic<int32_t> *waiters, CondVar *cv) {
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    if (waiters->load(std::memory_order_relaxed) > 0) {
+      std::unique_lock<std::mutex> lock(mux_);
+      cv->NotifyAll();
+    }
+  }
+
+  bool Writable() const {
+    size_t pos = tail_.load(std::memory_order_relaxed);
+    if (pos - head_.load(std::memory_order_acquire) >= capacity()) {
+      return false;
+    }
+    return slots_[pos & mask_].seq.load(std::memory_order_acquire) == pos;
+  }
+
+  bool Readable() const {
+    size_t pos = head_.load(std::memory_order_relaxed);
+    return slots_[pos & mask_].seq.load(std::memory_order_acquire) == pos + 1;
+  }
+
+  template <typename... Ts>
+  bool TryEmplace(Ts &&... args) {
+    size_t pos = tail_.load(std::memory_order_relaxed);
+    Slot *slot = nullptr;
+    while (true) {
+      // The logical capacity is a soft bound when several producers race for the last free slots.
+      if (pos - head_.load(std::memory_order_acquire) >= capacity()) {
+        return false;
+      }
+      slot = &slots_[pos & mask_];
+      size_t seq = slot->seq.load(std::memory_order_acquire);
+      auto diff = static_cast<int64_t>(seq) - static_cast<int64_t>(pos);
+      if (diff == 0) {
+        if (single_producer_consumer_) {
+          tail_.store(pos + 1, std::memory_order_relaxed);
+          break;
+        }
+        if (tail_.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) {
+          break;
+        }
+      } else if (diff < 0) {
+        return false;
+      } else {
+        pos = tail_.load(std::memory_order_relaxed);
+      }
+    }
+    new (&slot->storage) T(std::forward<Ts>(args)...);
+    slot->seq.store(pos + 1, std::memory_order_release);
+    return true;
+  }
+
+  bool TryPop(T *p) {
+    size_t pos = head_.load(std::memory_order_relaxed);
+    Slot *slot = nullptr;
+    while (true) {
+      slot = &slots_[pos & mask_];
+      size_t seq = slot->seq.load(std::memory_order_acquire);
+      auto diff = static_cast<int64_t>(seq) - static_cast<int64_t>(pos + 1);
+      if (diff == 0) {
+        if (single_producer_consumer_) {
+          head_.store(pos + 1, std::memory_order_relaxed);
+          break;
+        }
+        if (head_.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) {
+          break;
+        }
+      } else if (diff < 0) {
+        return false;
+      } else {
+        pos = head_.load(std::memory_order_relaxed);
+      }
+    }
+    T *elem = reinterpret_cast<T *>(&slot->storage);
+    *p = std::move(*elem);
+    elem->~T();
+    slot->seq.store(pos + num_slots_, std::memory_order_release);
+    return true;
+  }
+
+  const bool single_producer_consumer_;
+  std::atomic<size_t> capacity_;
+  size_t num_slots_;
+  size_t mask_;
+  std::unique_ptr<Slot[]> slots_;
+  // Keep the cursors on separate cache lines so that producers and consumers do not false share.
+  alignas(64) std::atomic<size_t> head_;
+  alignas(64) std::atomic<size_t> tail_;
+  alignas(64) std::atomic<int32_t> producer_waiters_;
+  std::atomic<int32_t> consumer_waiters_;
+  std::string my_name_;
+  std::mutex mux_;
+  CondVar empty_cv_;
+  CondVar full_cv_;
+};
+}  // namespace dataset
+}  // namespace mindspore
+#endif  // MINDSPORE_CCSRC_MINDDATA_DATASET_UTIL_RING_QUEUE_H_
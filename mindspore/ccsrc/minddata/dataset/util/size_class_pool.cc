@@ -0,0 +1,350 @@
+/**
+ * Copyright 2022 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "minddata/dataset/util/size_class_pool.h"
+
+#include <algorithm>
+#include <atomic>
+#include <string>
+#include <utility>
+#include "./securec.h"
+#include "minddata/dataset/util/log_adapter.h"
+
+namespace mindspore {
+namespace dataset {
+namespace {
+// Threads are numbered once, in the order they first touch any SizeClassPool.
+uint32_t ThreadSlot() {
+  static std::atomic<uint32_t> next_slot{0};
+  thread_local uint32_t slot = next_slot.fetch_add(1, std::memory_order_relaxed);
+  return slot;
+}
+}  // namespace
+
+SizeClassPool::SizeClassPool(std::shared_ptr<MemoryPool> upstream, uint64_t max_cached_bytes)
+    : upstream_(std::move(upstream)),
+      shards_(std::make_unique<Shard[]>(kNumShards)),
+      central_(std::make_unique<Central[]>(kNumClasses)),
+      max_cached_bytes_(max_cached_bytes),
+      last_trim_(std::chrono::steady_clock::now()) {}
+
+SizeClassPool::~SizeClassPool() { Trim(); }
+
+uint32_t SizeClassPool::SizeToClass(size_t n) {
+  if (n > (static_cast<size_t>(1) << kMaxClassLog)) {
+    return kLargeClass;
+  }
+  if (n <= (static_cast<size_t>(1) << kMinClassLog)) {
+    return 0;
+  }
+  // n - 1 lies in [2^k, 2^(k+1)), the two bits below the leading one pick the quarter of that range
+  size_t m = n - 1;
+  uint32_t k = kMinClassLog;
+  while ((m >> (k + 1)) != 0) {
+    ++k;
+  }
+  auto quarter = static_cast<uint32_t>(m >> (k - 2)) - kClassesPerDoubling;
+  return 1 + (k - kMinClassLog) * kClassesPerDoubling + quarter;
+}
+
+size_t SizeClassPool::ClassToSize(uint32_t size_class) {
+  if (size_class == 0) {
+    return static_cast<size_t>(1) << kMinClassLog;
+  }
+  uint32_t idx = size_class - 1;
+  uint32_t k = kMinClassLog + idx / kClassesPerDoubling;
+  uint32_t quarter = idx % kClassesPerDoubling;
+  return static_cast<size_t>(quarter + kClassesPerDoubling + 1) << (k - 2);
+}
+
+size_t SizeClassPool::RoundUp(size_t n) {
+  uint32_t size_class = SizeToClass(n);
+  return size_class == kLargeClass ? n : ClassToSize(size_class);
+}
+
+uint32_t SizeClassPool::ShardLimit(uint32_t size_class) {
+  return static_cast<uint32_t>(std::max<size_t>(1, kShardCacheBytes / ClassToSize(size_class)));
+}
+
+uint32_t SizeClassPool::CentralLimit(uint32_t size_class) {
+  return static_cast<uint32_t>(std::max<size_t>(kRefillBatch, kCentralCacheBytes / ClassToSize(size_class)));
+}
+
+SizeClassPool::Shard *SizeClassPool::MyShard() const { return &shards_[ThreadSlot() % kNumShards]; }
+
+Status SizeClassPool::Allocate(size_t n, void **p) {
+  RETURN_UNEXPECTED_IF_NULL(p);
+  uint32_t size_class = SizeToClass(n);
+  Shard *shard = MyShard();
+  BlockHeader *blk = nullptr;
+  if (size_class != kLargeClass) {
+    {
+      std::unique_lock<std::mutex> lock(shard->mux);
+      blk = shard->lists[size_class].Pop();
+      if (blk != nullptr) {
+        ++shard->hits;
+      }
+    }
+    if (blk == nullptr) {
+      blk = Refill(size_class, shard);
+    }
+    if (blk != nullptr) {
+      cached_bytes_.fetch_sub(ClassToSize(size_class), std::memory_order_relaxed);
+    }
+  }
+  if (blk == nullptr) {
+    size_t sz = size_class == kLargeClass ? n : ClassToSize(size_class);
+    void *raw = nullptr;
+    RETURN_IF_NOT_OK(upstream_->Allocate(sz + sizeof(BlockHeader), &raw));
+    blk = static_cast<BlockHeader *>(raw);
+    blk->next = nullptr;
+    blk->size_class = size_class;
+    blk->magic = kMagic;
+    std::unique_lock<std::mutex> lock(shard->mux);
+    if (size_class == kLargeClass) {
+      ++shard->large_allocs;
+    } else {
+      ++shard->misses;
+    }
+  }
+  *p = reinterpret_cast<char *>(blk) + sizeof(BlockHeader);
+  return Status::OK();
+}
+
+SizeClassPool::BlockHeader *SizeClassPool::Refill(uint32_t size_class, Shard *shard) {
+  FreeList batch;
+  {
+    Central &central = central_[size_class];
+    std::unique_lock<std::mutex> lock(central.mux);
+    while (batch.count < kRefillBatch && central.list.count > 0) {
+      batch.Push(central.list.Pop());
+    }
+  }
+  BlockHeader *blk = batch.Pop();
+  if (blk == nullptr) {
+    return nullptr;
+  }
+  std::unique_lock<std::mutex> lock(shard->mux);
+  ++shard->hits;
+  FreeList &list = shard->lists[size_class];
+  while (batch.count > 0) {
+    list.Push(batch.Pop());
+  }
+  return blk;
+}
+
+void SizeClassPool::Deallocate(void *p) {
+  if (p == nullptr) {
+    return;
+  }
+  auto *blk = reinterpret_cast<BlockHeader *>(static_cast<char *>(p) - sizeof(BlockHeader));
+  if (blk->magic != kMagic) {
+    MS_LOG(ERROR) << "Deallocate a block that was not allocated from this pool: " << p;
+    return;
+  }
+  uint32_t size_class = blk->size_class;
+  if (size_class == kLargeClass) {
+    upstream_->Deallocate(blk);
+    return;
+  }
+  Shard *shard = MyShard();
+  if ((frees_.fetch_add(1, std::memory_order_relaxed) + 1) % kTrimCheckPeriod == 0) {
+    MaybeTrimIdle();
+  }
+  size_t sz = ClassToSize(size_class);
+  if (cached_bytes_.fetch_add(sz, std::memory_order_relaxed) + sz > max_cached_bytes_) {
+    cached_bytes_.fetch_sub(sz, std::memory_order_relaxed);
+    blk->magic = 0;
+    upstream_->Deallocate(blk);
+    std::unique_lock<std::mutex> lock(shard->mux);
+    ++shard->releases;
+    return;
+  }
+  FreeList spill;
+  {
+    std::unique_lock<std::mutex> lock(shard->mux);
+    FreeList &list = shard->lists[size_class];
+    list.Push(blk);
+    uint32_t limit = ShardLimit(size_class);
+    if (list.count > limit) {
+      // keep half of the limit so that alternating frees and allocations do not spill every time
+      while (list.count > limit / 2) {
+        spill.Push(list.Pop());
+      }
+    }
+  }
+  if (spill.count > 0) {
+    Spill(size_class, &spill);
+  }
+}
+
+void SizeClassPool::Spill(uint32_t size_class, FreeList *spill) {
+  FreeList excess;
+  {
+    Central &central = central_[size_class];
+    std::unique_lock<std::mutex> lock(central.mux);
+    while (spill->count > 0) {
+      central.list.Push(spill->Pop());
+    }
+    uint32_t limit = CentralLimit(size_class);
+    while (central.list.count > limit) {
+      excess.Push(central.list.Pop());
+    }
+    central.releases += excess.count;
+  }
+  cached_bytes_.fetch_sub(excess.count * ClassToSize(size_class), std::memory_order_relaxed);
+  Release(&excess);
+}
+
+void SizeClassPool::Release(FreeList *list) {
+  while (list->count > 0) {
+    BlockHeader *blk = list->Pop();
+    blk->magic = 0;
+    upstream_->Deallocate(blk);
+  }
+}
+
+Status SizeClassPool::Reallocate(void **p, size_t old_sz, size_t new_sz) {
+  RETURN_UNEXPECTED_IF_NULL(p);
+  if (*p != nullptr) {
+    auto *blk = reinterpret_cast<BlockHeader *>(static_cast<char *>(*p) - sizeof(BlockHeader));
+    size_t capacity = blk->size_class == kLargeClass ? old_sz : ClassToSize(blk->size_class);
+    if (new_sz <= capacity) {
+      return Status::OK();
+    }
+  }
+  void *q = nullptr;
+  RETURN_IF_NOT_OK(Allocate(new_sz, &q));
+  if (*p != nullptr) {
+    errno_t err = memcpy_s(q, new_sz, *p, old_sz);
+    if (err != EOK) {
+      Deallocate(q);
+      RETURN_STATUS_UNEXPECTED("Failed to copy the block, error code: " + std::to_string(err));
+    }
+    Deallocate(*p);
+  }
+  *p = q;
+  return Status::OK();
+}
+
+void SizeClassPool::TakeOff(uint32_t size_class, FreeList *from, FreeList *to) {
+  cached_bytes_.fetch_sub(from->count * ClassToSize(size_class), std::memory_order_relaxed);
+  std::swap(*from, *to);
+}
+
+void SizeClassPool::Trim() {
+  for (size_t i = 0; i < kNumShards; ++i) {
+    Shard &shard = shards_[i];
+    for (uint32_t size_class = 0; size_class < kNumClasses; ++size_class) {
+      FreeList list;
+      {
+        std::unique_lock<std::mutex> lock(shard.mux);
+        TakeOff(size_class, &shard.lists[size_class], &list);
+      }
+      Release(&list);
+    }
+  }
+  for (uint32_t size_class = 0; size_class < kNumClasses; ++size_class) {
+    FreeList list;
+    {
+      std::unique_lock<std::mutex> lock(central_[size_class].mux);
+      TakeOff(size_class, &central_[size_class].list, &list);
+    }
+    Release(&list);
+  }
+}
+
+void SizeClassPool::TrimIdle() {
+  std::unique_lock<std::mutex> lock(trim_mux_);
+  TrimIdleLocked();
+}
+
+void SizeClassPool::TrimIdleLocked() {
+  last_trim_ = std::chrono::steady_clock::now();
+  for (size_t i = 0; i < kNumShards; ++i) {
+    Shard &shard = shards_[i];
+    std::array<FreeList, kNumClasses> idle;
+    uint64_t released = 0;
+    {
+      std::unique_lock<std::mutex> lock(shard.mux);
+      for (uint32_t size_class = 0; size_class < kNumClasses; ++size_class) {
+        FreeList &list = shard.lists[size_class];
+        if (!list.used) {
+          released += list.count;
+          TakeOff(size_class, &list, &idle[size_class]);
+        }
+        list.used = false;
+      }
+      shard.releases += released;
+    }
+    for (auto &list : idle) {
+      Release(&list);
+    }
+  }
+  for (uint32_t size_class = 0; size_class < kNumClasses; ++size_class) {
+    Central &central = central_[size_class];
+    FreeList idle;
+    {
+      std::unique_lock<std::mutex> lock(central.mux);
+      if (!central.list.used) {
+        central.releases += central.list.count;
+        TakeOff(size_class, &central.list, &idle);
+      }
+      central.list.used = false;
+    }
+    Release(&idle);
+  }
+}
+
+void SizeClassPool::MaybeTrimIdle() {
+  std::unique_lock<std::mutex> lock(trim_mux_, std::try_to_lock);
+  // another thread is trimming already
+  if (!lock.owns_lock() || std::chrono::steady_clock::now() - last_trim_ < kTrimInterval) {
+    return;
+  }
+  TrimIdleLocked();
+}
+
+SizeClassPool::Stats SizeClassPool::GetStats() const {
+  Stats stats;
+  for (size_t i = 0; i < kNumShards; ++i) {
+    Shard &shard = shards_[i];
+    std::unique_lock<std::mutex> lock(shard.mux);
+    stats.hits += shard.hits;
+    stats.misses += shard.misses;
+    stats.large_allocs += shard.large_allocs;
+    stats.releases += shard.releases;
+    for (uint32_t size_class = 0; size_class < kNumClasses; ++size_class) {
+      stats.cached_bytes += shard.lists[size_class].count * ClassToSize(size_class);
+    }
+  }
+  for (uint32_t size_class = 0; size_class < kNumClasses; ++size_class) {
+    Central &central = central_[size_class];
+    std::unique_lock<std::mutex> lock(central.mux);
+    stats.releases += central.releases;
+    stats.cached_bytes += central.list.count * ClassToSize(size_class);
+  }
+  return stats;
+}
+
+std::ostream &operator<<(std::ostream &os, const SizeClassPool &s) {
+  SizeClassPool::Stats stats = s.GetStats();
+  os << "Size class pool hits: " << stats.hits << ", misses: " << stats.misses
+     << ", large allocations: " << stats.large_allocs << ", releases: " << stats.releases
+     << ", cached bytes: " << stats.cached_bytes;
+  return os;
+}
+}  // namespace dataset
+}  // namespace mindspore
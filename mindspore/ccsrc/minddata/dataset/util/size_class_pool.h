@@ -0,0 +1,194 @@
+/**
+ * Copyright 2022 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifndef MINDSPORE_CCSRC_MINDDATA_DATASET_UTIL_SIZE_CLASS_POOL_H_
+#define MINDSPORE_CCSRC_MINDDATA_DATASET_UTIL_SIZE_CLASS_POOL_H_
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <ostream>
+#include "minddata/dataset/util/memory_pool.h"
+
+namespace mindspore {
+namespace dataset {
+/// \brief A caching memory pool for the short lived, similarly sized buffers of the tensors flowing through a pipeline.
+///
+/// Requests are rounded up to a size class (four classes per power of two, from 64 bytes up to 16MB). Freed blocks
+/// are not returned to the upstream pool but kept on the free list of their class, so the next tensor of a similar
+/// size reuses them. Bigger requests go straight to the upstream pool.
+///
+/// Free lists live in two tiers. Each thread is hashed onto one of kNumShards thread caches, so the worker threads
+/// of a pipeline normally never share a lock. A thread cache that grows beyond its limit hands half of a class over
+/// to the central list of that class, and a thread cache that runs dry refills a batch from it. Only when the
+/// central list is empty too, the block comes from the upstream pool, and only when it is full too, the block is
+/// given back. Blocks allocated by one thread and freed by another (the normal case between two dataset ops) thus
+/// travel through the central lists.
+///
+/// The bytes held on all the lists together never exceed the limit given at construction, a block freed beyond it
+/// goes back upstream at once. Besides, the freeing threads trim the pool every kTrimInterval: the lists of the
+/// thread caches and the central lists nobody touched since the previous trim are given back, so the blocks of a
+/// finished stage or of a shape no longer seen do not stay cached for the whole run.
+class SizeClassPool : public MemoryPool {
+ public:
+  /// \brief Counters of the pool since it was created.
+  struct Stats {
+    uint64_t hits = 0;          // allocations served from a thread cache or a central list
+    uint64_t misses = 0;        // allocations of a size class that went to the upstream pool
+    uint64_t large_allocs = 0;  // allocations above the biggest size class
+    uint64_t releases = 0;      // freed blocks given back to the upstream pool because the lists were full or idle
+    uint64_t cached_bytes = 0;  // bytes currently held on the free lists
+  };
+
+  /// \brief Constructor
+  /// \param upstream The pool the blocks are taken from and given back to.
+  /// \param max_cached_bytes The most bytes kept on the free lists of the pool.
+  explicit SizeClassPool(std::shared_ptr<MemoryPool> upstream, uint64_t max_cached_bytes = kDefaultMaxCachedBytes);
+
+  SizeClassPool(const SizeClassPool &) = delete;
+  SizeClassPool &operator=(const SizeClassPool &) = delete;
+
+  ~SizeClassPool() override;
+
+  Status Allocate(size_t n, void **p) override;
+
+  Status Reallocate(void **p, size_t old_sz, size_t new_sz) override;
+
+  void Deallocate(void *p) override;
+
+  uint64_t get_max_size() const override { return upstream_->get_max_size(); }
+
+  int PercentFree() const override { return upstream_->PercentFree(); }
+
+  /// \brief Gives all the cached blocks back to the upstream pool.
+  void Trim();
+
+  /// \brief Gives the blocks of the lists not used since the previous call back to the upstream pool.
+  void TrimIdle();
+
+  /// \return A snapshot of the counters.
+  Stats GetStats() const;
+
+  /// \return The size of the class a request of n bytes is rounded up to, or n for requests above the biggest class.
+  static size_t RoundUp(size_t n);
+
+  friend std::ostream &operator<<(std::ostream &os, const SizeClassPool &s);
+
+  static constexpr uint64_t kDefaultMaxCachedBytes = 512 * 1024 * 1024;
+
+ private:
+  static constexpr uint32_t kMinClassLog = 6;
+  static constexpr uint32_t kMaxClassLog = 24;
+  static constexpr uint32_t kClassesPerDoubling = 4;
+  static constexpr uint32_t kNumClasses = 1 + (kMaxClassLog - kMinClassLog) * kClassesPerDoubling;
+  static constexpr uint32_t kLargeClass = kNumClasses;
+  static constexpr size_t kNumShards = 32;
+  // a thread cache keeps up to this many bytes per class, a central list up to kCentralCacheBytes
+  static constexpr size_t kShardCacheBytes = 1024 * 1024;
+  static constexpr size_t kCentralCacheBytes = 64 * 1024 * 1024;
+  static constexpr uint32_t kRefillBatch = 8;
+  // the clock is read once per kTrimCheckPeriod frees to see whether kTrimInterval has passed
+  static constexpr uint32_t kTrimCheckPeriod = 1024;
+  static constexpr std::chrono::seconds kTrimInterval{10};
+  static constexpr uint32_t kMagic = 0x5c1a55e5;
+
+  // Sits in front of every block. The header is 16 bytes so the user memory keeps the alignment of the upstream pool.
+  struct alignas(16) BlockHeader {
+    BlockHeader *next;
+    uint32_t size_class;
+    uint32_t magic;
+  };
+
+  struct FreeList {
+    BlockHeader *head = nullptr;
+    uint32_t count = 0;
+    // pushed or popped since the previous TrimIdle
+    bool used = false;
+
+    void Push(BlockHeader *blk) {
+      blk->next = head;
+      head = blk;
+      ++count;
+      used = true;
+    }
+
+    BlockHeader *Pop() {
+      BlockHeader *blk = head;
+      if (blk != nullptr) {
+        head = blk->next;
+        --count;
+      }
+      used = true;
+      return blk;
+    }
+  };
+
+  struct alignas(64) Shard {
+    std::mutex mux;
+    std::array<FreeList, kNumClasses> lists;
+    uint64_t hits = 0;
+    uint64_t misses = 0;
+    uint64_t large_allocs = 0;
+    uint64_t releases = 0;
+  };
+
+  struct alignas(64) Central {
+    std::mutex mux;
+    FreeList list;
+    uint64_t releases = 0;
+  };
+
+  static uint32_t SizeToClass(size_t n);
+  static size_t ClassToSize(uint32_t size_class);
+  static uint32_t ShardLimit(uint32_t size_class);
+  static uint32_t CentralLimit(uint32_t size_class);
+
+  Shard *MyShard() const;
+
+  // Takes up to kRefillBatch blocks of the class from the central list, returns nullptr if it is empty.
+  BlockHeader *Refill(uint32_t size_class, Shard *shard);
+
+  // Moves blocks spilled from a thread cache to the central list and gives the excess of that one back upstream.
+  void Spill(uint32_t size_class, FreeList *spill);
+
+  // Gives the blocks of a list taken off the pool back upstream.
+  void Release(FreeList *list);
+
+  // Takes the blocks of a list off the pool, they are no longer counted in cached_bytes_.
+  void TakeOff(uint32_t size_class, FreeList *from, FreeList *to);
+
+  // Runs TrimIdle if kTrimInterval has passed since the previous trim.
+  void MaybeTrimIdle();
+
+  // The body of TrimIdle, trim_mux_ is held.
+  void TrimIdleLocked();
+
+  std::shared_ptr<MemoryPool> upstream_;
+  std::unique_ptr<Shard[]> shards_;
+  std::unique_ptr<Central[]> central_;
+  const uint64_t max_cached_bytes_;
+  std::atomic<uint64_t> cached_bytes_{0};
+  std::atomic<uint32_t> frees_{0};
+  std::mutex trim_mux_;
+  std::chrono::steady_clock::time_point last_trim_;
+};
+}  // namespace dataset
+}  // namespace mindspore
+
+#endif  // MINDSPORE_CCSRC_MINDDATA_DATASET_UTIL_SIZE_CLASS_POOL_H_
@@ -0,0 +1,116 @@
+/**
+ * Copyright 2022 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef MINDSPORE_CCSRC_MINDDATA_MINDRECORD_INCLUDE_SHARD_BLOB_READER_H_
+#define MINDSPORE_CCSRC_MINDDATA_MINDRECORD_INCLUDE_SHARD_BLOB_READER_H_
+
+#include <condition_variable>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+#include "minddata/mindrecord/include/common/shard_utils.h"
+
+namespace mindspore {
+namespace mindrecord {
+/// \brief how ShardReader reads the blob of a row in random access mode
+enum class IoMode {
+  kStream = 0,      // one blocking seekg/read per row on the file streams of the consumer
+  kThreadPool = 1,  // pread on a pool of io threads, many reads of a consumer in flight
+  kIoUring = 2      // io_uring ring per consumer, falls back to kThreadPool if the kernel does not support it
+};
+
+const int kDefaultIoQueueDepth = 32;
+const int kMaxIoQueueDepth = 1024;
+
+/// \brief one blob to read, dest must hold length bytes
+struct BlobRequest {
+  int shard_id;
+  uint64_t offset;
+  uint64_t length;
+  uint8_t *dest;
+};
+
+class IoUringContext;
+
+/// \brief Reads batches of blobs from the mindrecord files with several reads in flight at a time.
+/// The files are opened once and shared by all the consumers, ReadBatch can be called concurrently by different
+/// consumers but not by the same consumer.
+class __attribute__((visibility("default"))) ShardBlobReader {
+ public:
+  /// \brief create a blob reader
+  /// \param[in] io_mode kThreadPool or kIoUring
+  /// \param[in] file_paths the mindrecord files, indexed by shard id
+  /// \param[in] queue_depth the maximum number of reads in flight for one consumer
+  /// \param[out] blob_reader the blob reader
+  static Status Create(IoMode io_mode, const std::vector<std::string> &file_paths, int queue_depth,
+                       std::shared_ptr<ShardBlobReader> *blob_reader);
+
+  ~ShardBlobReader();
+
+  ShardBlobReader(const ShardBlobReader &) = delete;
+  ShardBlobReader &operator=(const ShardBlobReader &) = delete;
+
+  /// \brief read all the requests, each dest is filled as its read completes, returns when all are done
+  Status ReadBatch(int consumer_id, const std::vector<BlobRequest> &requests);
+
+  /// \brief get the io mode actually in use
+  IoMode GetIoMode() const { return io_mode_; }
+
+  /// \brief get the maximum number of reads in flight for one consumer
+  int GetQueueDepth() const { return queue_depth_; }
+
+ private:
+  struct BatchState;
+
+  struct ReadJob {
+    BatchState *batch;
+    size_t index;
+  };
+
+  ShardBlobReader(IoMode io_mode, int queue_depth);
+
+  Status OpenFiles(const std::vector<std::string> &file_paths);
+
+  void StartThreadPool();
+
+  void IoThread();
+
+  Status ReadBatchByThreadPool(const std::vector<BlobRequest> &requests);
+
+  Status GetIoUringContext(int consumer_id, IoUringContext **context);
+
+  IoMode io_mode_;
+  int queue_depth_;
+  std::vector<int> fds_;
+
+  // kThreadPool
+  std::vector<std::thread> io_threads_;
+  std::deque<ReadJob> jobs_;
+  std::mutex jobs_mutex_;
+  std::condition_variable jobs_cv_;
+  bool stop_ = false;
+
+  // kIoUring, one ring per consumer, created on first use
+  std::vector<std::unique_ptr<IoUringContext>> rings_;
+  std::mutex rings_mutex_;
+};
+}  // namespace mindrecord
+}  // namespace mindspore
+
+#endif  // MINDSPORE_CCSRC_MINDDATA_MINDRECORD_INCLUDE_SHARD_BLOB_READER_H_
@@ -0,0 +1,71 @@
+/**
+ * Copyright 2022 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef MINDSPORE_CCSRC_MINDDATA_MINDRECORD_INCLUDE_SHARD_INDEX_SNAPSHOT_H_
+#define MINDSPORE_CCSRC_MINDDATA_MINDRECORD_INCLUDE_SHARD_INDEX_SNAPSHOT_H_
+
+#include <memory>
+#include <string>
+#include <vector>
+#include "minddata/mindrecord/include/common/shard_utils.h"
+#include "minddata/mindrecord/include/shard_column.h"
+#include "minddata/mindrecord/include/shard_label_store.h"
+
+namespace mindspore {
+namespace mindrecord {
+const char kIndexSnapshotSuffix[] = ".idx";
+const char kIndexSnapshotMagic[] = "MRIDXSNP";
+const uint32_t kIndexSnapshotVersion = 2;
+
+/// \brief Binary snapshot of the rows of one shard as read from its index table, stored next to the .db file.
+/// It keeps the blob location of each row and the selected index fields in ShardLabelStore layout, so that a later
+/// ShardReader::Open can map it and read the fields in place instead of scanning the index table with sqlite.
+/// The snapshot is only valid for the same selected columns, and is dropped as soon as the size or the modification
+/// time (in nanoseconds) of the mindrecord file or its .db file changes.
+class __attribute__((visibility("default"))) ShardIndexSnapshot {
+ public:
+  /// \brief get the path of the snapshot of a mindrecord file
+  static std::string GetSnapshotPath(const std::string &file_path) { return file_path + kIndexSnapshotSuffix; }
+
+  /// \brief load the snapshot of a mindrecord file
+  /// \param[in] file_path the mindrecord file
+  /// \param[in] shard_id the shard id of the mindrecord file in the dataset
+  /// \param[in] columns the selected columns, in the order of the label store
+  /// \param[in] label_store an empty store with the selected columns, referencing the fields of the rows in the mapped
+  ///            snapshot afterwards
+  /// \param[out] offsets the shard id, row group id, blob start and blob end of every row
+  /// \return error if there is no usable snapshot, the caller falls back to the index table
+  static Status Load(const std::string &file_path, int shard_id, const std::vector<std::string> &columns,
+                     const std::shared_ptr<ShardLabelStore> &label_store, std::vector<std::vector<uint64_t>> *offsets);
+
+  /// \brief write the snapshot of a mindrecord file, an existing one is replaced atomically
+  /// \param[in] file_path the mindrecord file
+  /// \param[in] columns the selected columns, in the order of the label store
+  /// \param[in] label_store the fields of the rows
+  /// \param[in] offsets the shard id, row group id, blob start and blob end of every row
+  static Status Save(const std::string &file_path, const std::vector<std::string> &columns,
+                     const std::shared_ptr<ShardLabelStore> &label_store,
+                     const std::vector<std::vector<uint64_t>> &offsets);
+
+ private:
+  /// \brief build the header identifying the source files and the columns
+  static Status BuildHeader(const std::string &file_path, const std::vector<std::string> &columns,
+                            std::vector<uint8_t> *header);
+};
+}  // namespace mindrecord
+}  // namespace mindspore
+
+#endif  // MINDSPORE_CCSRC_MINDDATA_MINDRECORD_INCLUDE_SHARD_INDEX_SNAPSHOT_H_
@@ -0,0 +1,118 @@
+/**
+ * Copyright 2022 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef MINDSPORE_CCSRC_MINDDATA_MINDRECORD_INCLUDE_SHARD_LABEL_STORE_H_
+#define MINDSPORE_CCSRC_MINDDATA_MINDRECORD_INCLUDE_SHARD_LABEL_STORE_H_
+
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <vector>
+#include "minddata/mindrecord/include/common/shard_utils.h"
+#include "minddata/mindrecord/include/shard_column.h"
+
+namespace mindspore {
+namespace mindrecord {
+/// \brief In-memory columnar copy of the scalar fields of all rows, built from the index tables.
+/// int32/int64/float32/float64 columns are kept as packed fixed-width arrays, string columns as an offset array
+/// into one contiguous blob, so that a row costs a few bytes per column instead of a json object.
+class __attribute__((visibility("default"))) ShardLabelStore {
+ public:
+  /// \brief constructor
+  /// \param[in] columns names of the columns to store
+  /// \param[in] types data types of the columns to store, must have the same size as columns
+  ShardLabelStore(const std::vector<std::string> &columns, const std::vector<ColumnDataType> &types);
+
+  ~ShardLabelStore() = default;
+
+  /// \brief reserve memory for num_rows rows
+  void Reserve(int64_t num_rows);
+
+  /// \brief append one row given as the strings returned by sqlite
+  /// \param[in] fields the fields of the row
+  /// \param[in] first_field the index of the field holding the value of the first column
+  Status AppendRow(const std::vector<std::string> &fields, size_t first_field);
+
+  /// \brief append all the rows of another store with the same columns
+  Status Append(const ShardLabelStore &other);
+
+  /// \brief get the number of rows
+  int64_t Size() const { return num_rows_; }
+
+  /// \brief check whether the column is stored
+  bool HasColumn(const std::string &column_name) const { return column_id_.find(column_name) != column_id_.end(); }
+
+  /// \brief get the raw bytes of one cell, data points into the store and stays valid as long as the store
+  Status GetColumn(int64_t row_id, const std::string &column_name, const unsigned char **data,
+                   uint64_t *n_bytes) const;
+
+  /// \brief build the json of one row, in the same format as ShardReader produces for the index fields
+  Status GetRowAsJson(int64_t row_id, json *row) const;
+
+  /// \brief get the bytes used by the stored values
+  uint64_t MemoryUsage() const;
+
+  /// \brief append the stored values to buffer, in the layout read back by Deserialize
+  void Serialize(std::vector<uint8_t> *buffer) const;
+
+  /// \brief replace the stored values by the ones written by Serialize on a store with the same columns, the values
+  ///        are referenced in place instead of copied
+  /// \param[in] data the start of the serialized values
+  /// \param[in] size the number of readable bytes from data
+  /// \param[in] holder keeps data alive as long as the store references it
+  /// \param[out] used the number of bytes consumed
+  Status Deserialize(const uint8_t *data, uint64_t size, const std::shared_ptr<const void> &holder, uint64_t *used);
+
+ private:
+  struct Column {
+    std::string name;
+    ColumnDataType type;
+    uint64_t width;                // size of one value, 0 for variable length columns
+    std::vector<uint8_t> values;   // packed values, or the concatenated strings for variable length columns
+    std::vector<uint64_t> offset;  // start offset of each string, with a trailing end offset
+    // values and offset referenced in place, used instead of the vectors while holder_ is set
+    const uint8_t *mapped_values = nullptr;
+    uint64_t mapped_values_size = 0;
+    const uint8_t *mapped_offset = nullptr;  // not aligned, read by memcpy
+    uint64_t mapped_offset_count = 0;
+  };
+
+  const uint8_t *Values(const Column &column) const {
+    return holder_ != nullptr ? column.mapped_values : column.values.data();
+  }
+
+  uint64_t ValuesSize(const Column &column) const {
+    return holder_ != nullptr ? column.mapped_values_size : column.values.size();
+  }
+
+  uint64_t OffsetCount(const Column &column) const {
+    return holder_ != nullptr ? column.mapped_offset_count : column.offset.size();
+  }
+
+  uint64_t Offset(const Column &column, uint64_t i) const;
+
+  /// \brief copy the values referenced in place into the store, so that rows can be appended
+  void Materialize();
+
+  std::vector<Column> columns_;
+  std::shared_ptr<const void> holder_;  // keeps the values referenced in place alive
+  std::unordered_map<std::string, size_t> column_id_;
+  int64_t num_rows_;
+};
+}  // namespace mindrecord
+}  // namespace mindspore
+
+#endif  // MINDSPORE_CCSRC_MINDDATA_MINDRECORD_INCLUDE_SHARD_LABEL_STORE_H_
@@ -43,11 +43,14 @@
 #include <utility>
 #include <vector>
 #include "minddata/mindrecord/include/common/shard_utils.h"
+#include "minddata/mindrecord/include/shard_blob_reader.h"
 #include "minddata/mindrecord/include/shard_category.h"
 #include "minddata/mindrecord/include/shard_column.h"
 #include "minddata/mindrecord/include/shard_distributed_sample.h"
 #include "minddata/mindrecord/include/shard_error.h"
 #include "minddata/mindrecord/include/shard_index_generator.h"
+#include "minddata/mindrecord/include/shard_index_snapshot.h"
+#include "minddata/mindrecord/include/shard_label_store.h"
 #include "minddata/mindrecord/include/shard_operator.h"
 #include "minddata/mindrecord/include/shard_pk_sample.h"
 #include "minddata/mindrecord/include/shard_reader.h"
@@ -179,6 +182,15 @@ class API_PUBLIC ShardReader {
   /// \brief return a row by id
   /// \return a batch of images and image data
   TASK_CONTENT GetNextById(const int64_t &task_id, const int32_t &consumer_id);
+
+  /// \brief return several rows by id, their blobs are read together when an asynchronous io mode is in use
+  /// \param[in] task_ids the ids of the rows
+  /// \param[in] consumer_id the consumer reading the rows
+  /// \param[out] task_contents the rows, in the order of task_ids
+  /// \return Status the status, kMDInterrupted if the reader has been interrupted
+  Status GetNextByIds(const std::vector<int64_t> &task_ids, const int32_t &consumer_id,
+                      std::vector<TASK_CONTENT> *task_contents);
+
   /// \brief  get blob filed list
   /// \return blob field list
   std::pair<ShardType, std::vector<std::string>> GetBlobFields();
@@ -191,6 +203,34 @@ class API_PUBLIC ShardReader {
   /// \return null
   void SetAllInIndex(bool all_in_index) { all_in_index_ = all_in_index; }
 
+  /// \brief keep the index fields in a columnar label store instead of one json per task, must be called before Open.
+  ///        It only takes effect when all the selected columns are in the index and lazy load is off, in that case
+  ///        GetNextById returns an empty json and the fields are read through GetLabelStore with the task id.
+  /// \return null
+  void SetColumnarLabel(bool columnar_label) { columnar_label_ = columnar_label; }
+
+  /// \brief get the columnar label store, null if it is not in use
+  std::shared_ptr<ShardLabelStore> GetLabelStore() const { return label_store_; }
+
+  /// \brief load the rows of each file from the index snapshot next to it instead of the index table, and write the
+  ///        snapshot if it is missing or stale, must be called before Open. Only used when all the selected columns
+  ///        are in the index and lazy load is off.
+  /// \return null
+  void SetIndexSnapshot(bool index_snapshot) { index_snapshot_ = index_snapshot; }
+
+  /// \brief select how the blobs are read in random access mode, must be called before Open
+  /// \param[in] io_mode kStream reads one blob at a time, kThreadPool and kIoUring keep up to queue_depth reads of
+  ///            each consumer in flight
+  /// \param[in] queue_depth the maximum number of reads in flight for one consumer
+  /// \return null
+  void SetIoMode(IoMode io_mode, int queue_depth = kDefaultIoQueueDepth) {
+    io_mode_ = io_mode;
+    io_queue_depth_ = queue_depth;
+  }
+
+  /// \brief get the number of rows worth reading together by GetNextByIds, 1 if the blobs are read synchronously
+  int GetIoQueueDepth() const { return blob_reader_ != nullptr ? blob_reader_->GetQueueDepth() : 1; }
+
   /// \brief get all classes
   Status GetAllClasses(const std::string &category_field, std::shared_ptr<std::set<std::string>> category_ptr);
 
@@ -213,14 +253,16 @@ class API_PUBLIC ShardReader {
   Status ConvertLabelToJson(const std::vector<std::vector<std::string>> &labels, std::shared_ptr<std::fstream> fs,
                             std::shared_ptr<std::vector<std::vector<std::vector<uint64_t>>>> offset_ptr, int shard_id,
                             const std::vector<std::string> &columns,
-                            std::shared_ptr<std::vector<std::vector<json>>> col_val_ptr);
+                            std::shared_ptr<std::vector<std::vector<json>>> col_val_ptr,
+                            std::shared_ptr<std::vector<std::shared_ptr<ShardLabelStore>>> label_stores_ptr);
 
   /// \brief convert json format to expected type
   Status ConvertJsonValue(const std::vector<std::string> &label, const std::vector<std::string> &columns,
                           const json &schema, json *value);
 
   /// \brief read all rows for specified columns
-  Status ReadAllRowGroup(const std::vector<std::string> &columns, std::shared_ptr<ROW_GROUPS> *row_group_ptr);
+  Status ReadAllRowGroup(const std::vector<std::string> &columns, std::shared_ptr<ROW_GROUPS> *row_group_ptr,
+                         std::shared_ptr<ShardLabelStore> *label_store_ptr = nullptr);
 
   /// \brief read row meta by shard_id and sample_id
   Status ReadRowGroupByShardIDAndSampleID(const std::vector<std::string> &columns, const uint32_t &shard_id,
@@ -229,7 +271,15 @@ class API_PUBLIC ShardReader {
   /// \brief read all rows in one shard
   Status ReadAllRowsInShard(int shard_id, const std::string &sql, const std::vector<std::string> &columns,
                             std::shared_ptr<std::vector<std::vector<std::vector<uint64_t>>>> offset_ptr,
-                            std::shared_ptr<std::vector<std::vector<json>>> col_val_ptr);
+                            std::shared_ptr<std::vector<std::vector<json>>> col_val_ptr,
+                            std::shared_ptr<std::vector<std::shared_ptr<ShardLabelStore>>> label_stores_ptr);
+
+  /// \brief read all rows in one shard from its index snapshot, or from the index table and then save the snapshot
+  Status ReadAllRowsInShardWithSnapshot(
+    int shard_id, const std::string &sql, const std::vector<std::string> &columns,
+    std::shared_ptr<std::vector<std::vector<std::vector<uint64_t>>>> offset_ptr,
+    std::shared_ptr<std::vector<std::vector<json>>> col_val_ptr,
+    std::shared_ptr<std::vector<std::shared_ptr<ShardLabelStore>>> label_stores_ptr);
 
   /// \brief initialize reader
   Status Init(const std::vector<std::string> &file_paths, bool load_dataset);
@@ -286,6 +336,13 @@ class API_PUBLIC ShardReader {
   /// \brief read one row by one task
   Status ConsumerOneTask(int64_t task_id, uint32_t consumer_id, std::shared_ptr<TASK_CONTENT> *task_content_pt);
 
+  /// \brief read several rows, the blobs are read together by blob_reader_ if it is in use
+  Status ConsumerTasks(const std::vector<int64_t> &task_ids, uint32_t consumer_id,
+                       std::vector<std::shared_ptr<TASK_CONTENT>> *task_contents);
+
+  /// \brief get the type, the blob location and the scalar fields of one task
+  Status GetTaskBlobInfo(int64_t task_id, TaskType *task_type, BlobRequest *request, json *var_fields);
+
   /// \brief get labels from binary file
   Status GetLabelsFromBinaryFile(int shard_id, const std::vector<std::string> &columns,
                                  const std::vector<std::vector<std::string>> &label_offsets,
@@ -323,8 +380,16 @@ class API_PUBLIC ShardReader {
   std::mutex shard_locker_;                                // locker of shard
 
   // flags
-  bool all_in_index_ = true;  // if all columns are stored in index-table
-  bool interrupt_ = false;    // reader interrupted
+  bool all_in_index_ = true;     // if all columns are stored in index-table
+  bool interrupt_ = false;       // reader interrupted
+  bool columnar_label_ = false;  // keep index fields in label_store_ instead of the task list
+  bool index_snapshot_ = false;  // read and write the index snapshot next to each file
+
+  std::shared_ptr<ShardLabelStore> label_store_;  // index fields of all the tasks, indexed by task id
+
+  IoMode io_mode_ = IoMode::kStream;              // how the blobs are read in random access mode
+  int io_queue_depth_ = kDefaultIoQueueDepth;     // reads in flight for one consumer in asynchronous io modes
+  std::shared_ptr<ShardBlobReader> blob_reader_;  // null in kStream mode
 
   int64_t num_padded_;  // number of padding samples
 
@@ -0,0 +1,420 @@
+/**
+ * Copyright 2022 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "minddata/mindrecord/include/shard_blob_reader.h"
+
+#include <fcntl.h>
+#include <algorithm>
+#include <atomic>
+#include <cerrno>
+#include <chrono>
+#include <cstring>
+
+#if defined(__linux__) && defined(__has_include)
+#if __has_include(<linux/io_uring.h>)
+#include <linux/io_uring.h>
+#include <sys/mman.h>
+#include <sys/syscall.h>
+#include <sys/uio.h>
+#if defined(__NR_io_uring_setup) && defined(__NR_io_uring_enter)
+#define MINDRECORD_ENABLE_IO_URING
+#endif
+#endif
+#endif
+
+#include "utils/file_utils.h"
+#include "utils/ms_utils.h"
+
+namespace mindspore {
+namespace mindrecord {
+namespace {
+constexpr int kMaxIoThreads = 16;
+// The interval in microseconds to poll the io_uring completion queue once io_uring_enter fails.
+constexpr int kCompletionPollInterval = 100;
+}  // namespace
+
+#ifdef MINDRECORD_ENABLE_IO_URING
+// A minimal io_uring ring driven through the raw system calls, so that no liburing is needed.
+class IoUringContext {
+ public:
+  IoUringContext() = default;
+
+  ~IoUringContext() {
+    if (sqes_ != nullptr) {
+      (void)munmap(sqes_, sqes_size_);
+    }
+    if (cq_ptr_ != nullptr && cq_ptr_ != sq_ptr_) {
+      (void)munmap(cq_ptr_, cq_map_size_);
+    }
+    if (sq_ptr_ != nullptr) {
+      (void)munmap(sq_ptr_, sq_map_size_);
+    }
+    if (ring_fd_ >= 0) {
+      (void)close(ring_fd_);
+    }
+  }
+
+  IoUringContext(const IoUringContext &) = delete;
+  IoUringContext &operator=(const IoUringContext &) = delete;
+
+  Status Init(uint32_t entries) {
+    struct io_uring_params params;
+    (void)memset(&params, 0, sizeof(params));
+    ring_fd_ = static_cast<int>(syscall(__NR_io_uring_setup, entries, &params));
+    CHECK_FAIL_RETURN_UNEXPECTED(ring_fd_ >= 0, "Failed to set up io_uring, " + std::string(strerror(errno)));
+    entries_ = params.sq_entries;
+    sq_map_size_ = params.sq_off.array + params.sq_entries * sizeof(unsigned);
+    cq_map_size_ = params.cq_off.cqes + params.cq_entries * sizeof(struct io_uring_cqe);
+    bool single_mmap = false;
+#ifdef IORING_FEAT_SINGLE_MMAP
+    single_mmap = (params.features & IORING_FEAT_SINGLE_MMAP) != 0;
+#endif
+    if (single_mmap) {
+      sq_map_size_ = std::max(sq_map_size_, cq_map_size_);
+      cq_map_size_ = sq_map_size_;
+    }
+    sq_ptr_ = MapRing(sq_map_size_, IORING_OFF_SQ_RING);
+    CHECK_FAIL_RETURN_UNEXPECTED(sq_ptr_ != nullptr, "Failed to map io_uring submission queue.");
+    cq_ptr_ = single_mmap ? sq_ptr_ : MapRing(cq_map_size_, IORING_OFF_CQ_RING);
+    CHECK_FAIL_RETURN_UNEXPECTED(cq_ptr_ != nullptr, "Failed to map io_uring completion queue.");
+    sqes_size_ = params.sq_entries * sizeof(struct io_uring_sqe);
+    sqes_ = static_cast<struct io_uring_sqe *>(MapRing(sqes_size_, IORING_OFF_SQES));
+    CHECK_FAIL_RETURN_UNEXPECTED(sqes_ != nullptr, "Failed to map io_uring submission entries.");
+
+    auto sq = static_cast<uint8_t *>(sq_ptr_);
+    sq_head_ = reinterpret_cast<unsigned *>(sq + params.sq_off.head);
+    sq_tail_ = reinterpret_cast<unsigned *>(sq + params.sq_off.tail);
+    sq_mask_ = reinterpret_cast<unsigned *>(sq + params.sq_off.ring_mask);
+    sq_array_ = reinterpret_cast<unsigned *>(sq + params.sq_off.array);
+    auto cq = static_cast<uint8_t *>(cq_ptr_);
+    cq_head_ = reinterpret_cast<unsigned *>(cq + params.cq_off.head);
+    cq_tail_ = reinterpret_cast<unsigned *>(cq + params.cq_off.tail);
+    cq_mask_ = reinterpret_cast<unsigned *>(cq + params.cq_off.ring_mask);
+    cqes_ = reinterpret_cast<struct io_uring_cqe *>(cq + params.cq_off.cqes);
+    return Status::OK();
+  }
+
+  // Keeps up to entries_ reads in flight. A short read is submitted again for the remaining bytes. If a read or
+  // io_uring_enter fails, no new read is submitted but the ones in flight are still reaped before returning, since they
+  // write to dest.
+  Status ReadBatch(const std::vector<int> &fds, const std::vector<BlobRequest> &requests) {
+    size_t num_requests = requests.size();
+    std::vector<uint64_t> done(num_requests, 0);
+    std::vector<struct iovec> iovs(num_requests);
+    std::deque<size_t> pending;
+    for (size_t i = 0; i < num_requests; ++i) {
+      if (requests[i].length > 0) {
+        pending.push_back(i);
+      }
+    }
+    uint32_t in_flight = 0;
+    bool enter_failed = false;
+    Status rc = Status::OK();
+    while ((!pending.empty() && rc.IsOk()) || in_flight > 0) {
+      while (!pending.empty() && rc.IsOk() && in_flight < entries_) {
+        size_t i = pending.front();
+        pending.pop_front();
+        const auto &request = requests[i];
+        iovs[i].iov_base = request.dest + done[i];
+        iovs[i].iov_len = request.length - done[i];
+        unsigned tail = *sq_tail_;
+        unsigned index = tail & *sq_mask_;
+        struct io_uring_sqe *sqe = &sqes_[index];
+        (void)memset(sqe, 0, sizeof(*sqe));
+        sqe->opcode = IORING_OP_READV;
+        sqe->fd = fds[request.shard_id];
+        sqe->addr = reinterpret_cast<uint64_t>(&iovs[i]);
+        sqe->len = 1;
+        sqe->off = request.offset + done[i];
+        sqe->user_data = i;
+        sq_array_[index] = index;
+        __atomic_store_n(sq_tail_, tail + 1, __ATOMIC_RELEASE);
+        in_flight++;
+      }
+      if (in_flight == 0) {
+        break;
+      }
+      if (!enter_failed) {
+        unsigned to_submit = *sq_tail_ - __atomic_load_n(sq_head_, __ATOMIC_ACQUIRE);
+        int ret = static_cast<int>(syscall(__NR_io_uring_enter, ring_fd_, to_submit, 1, IORING_ENTER_GETEVENTS,
+                                           nullptr, 0));
+        if (ret < 0 && errno != EINTR && errno != EAGAIN && errno != EBUSY) {
+          rc = Status(StatusCode::kMDUnexpectedError, __LINE__, __FILE__,
+                      "[Internal ERROR] io_uring_enter failed, " + std::string(strerror(errno)));
+          // The entries not consumed by the kernel are taken back. The reads already consumed complete without
+          // io_uring_enter, so they are reaped by polling the completion queue.
+          unsigned sq_head = __atomic_load_n(sq_head_, __ATOMIC_ACQUIRE);
+          in_flight -= *sq_tail_ - sq_head;
+          __atomic_store_n(sq_tail_, sq_head, __ATOMIC_RELEASE);
+          enter_failed = true;
+        }
+      } else if (*cq_head_ == __atomic_load_n(cq_tail_, __ATOMIC_ACQUIRE)) {
+        std::this_thread::sleep_for(std::chrono::microseconds(kCompletionPollInterval));
+      }
+      unsigned head = *cq_head_;
+      while (head != __atomic_load_n(cq_tail_, __ATOMIC_ACQUIRE)) {
+        const struct io_uring_cqe *cqe = &cqes_[head & *cq_mask_];
+        auto i = static_cast<size_t>(cqe->user_data);
+        int res = cqe->res;
+        head++;
+        in_flight--;
+        if (res == -EINTR || res == -EAGAIN) {
+          pending.push_back(i);
+        } else if (res < 0) {
+          rc = Status(StatusCode::kMDUnexpectedError, __LINE__, __FILE__,
+                      "Failed to read mindrecord file, " + std::string(strerror(-res)));
+        } else if (res == 0) {
+          rc = Status(StatusCode::kMDUnexpectedError, __LINE__, __FILE__,
+                      "Failed to read mindrecord file, unexpected end of file.");
+        } else {
+          done[i] += static_cast<uint64_t>(res);
+          if (done[i] < requests[i].length) {
+            pending.push_back(i);
+          }
+        }
+      }
+      __atomic_store_n(cq_head_, head, __ATOMIC_RELEASE);
+    }
+    return rc;
+  }
+
+ private:
+  void *MapRing(size_t size, off_t offset) {
+    void *ptr = mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, ring_fd_, offset);
+    return ptr == MAP_FAILED ? nullptr : ptr;
+  }
+
+  int ring_fd_ = -1;
+  uint32_t entries_ = 0;
+  void *sq_ptr_ = nullptr;
+  void *cq_ptr_ = nullptr;
+  size_t sq_map_size_ = 0;
+  size_t cq_map_size_ = 0;
+  struct io_uring_sqe *sqes_ = nullptr;
+  size_t sqes_size_ = 0;
+  unsigned *sq_head_ = nullptr;
+  unsigned *sq_tail_ = nullptr;
+  unsigned *sq_mask_ = nullptr;
+  unsigned *sq_array_ = nullptr;
+  unsigned *cq_head_ = nullptr;
+  unsigned *cq_tail_ = nullptr;
+  unsigned *cq_mask_ = nullptr;
+  struct io_uring_cqe *cqes_ = nullptr;
+};
+#else
+class IoUringContext {
+ public:
+  Status Init(uint32_t entries) { RETURN_STATUS_UNEXPECTED("io_uring is not supported on this platform."); }
+
+  Status ReadBatch(const std::vector<int> &fds, const std::vector<BlobRequest> &requests) {
+    RETURN_STATUS_UNEXPECTED("io_uring is not supported on this platform.");
+  }
+};
+#endif
+
+struct ShardBlobReader::BatchState {
+  const std::vector<BlobRequest> *requests;
+  size_t remaining;
+  size_t target;  // the consumer is woken up once remaining drops to it
+  std::mutex mutex;
+  std::condition_variable cv;
+  Status rc;
+};
+
+ShardBlobReader::ShardBlobReader(IoMode io_mode, int queue_depth) : io_mode_(io_mode), queue_depth_(queue_depth) {}
+
+ShardBlobReader::~ShardBlobReader() {
+  {
+    std::lock_guard<std::mutex> lock(jobs_mutex_);
+    stop_ = true;
+  }
+  jobs_cv_.notify_all();
+  for (auto &io_thread : io_threads_) {
+    if (io_thread.joinable()) {
+      io_thread.join();
+    }
+  }
+  rings_.clear();
+  for (auto fd : fds_) {
+    if (fd >= 0) {
+      (void)close(fd);
+    }
+  }
+}
+
+Status ShardBlobReader::Create(IoMode io_mode, const std::vector<std::string> &file_paths, int queue_depth,
+                               std::shared_ptr<ShardBlobReader> *blob_reader) {
+  RETURN_UNEXPECTED_IF_NULL(blob_reader);
+#if defined(_WIN32) || defined(_WIN64)
+  RETURN_STATUS_UNEXPECTED("Asynchronous blob reading is not supported on Windows.");
+#else
+  CHECK_FAIL_RETURN_UNEXPECTED(io_mode == IoMode::kThreadPool || io_mode == IoMode::kIoUring,
+                               "[Internal ERROR] the io mode of blob reader should be thread pool or io_uring.");
+  CHECK_FAIL_RETURN_UNEXPECTED(queue_depth > 0 && queue_depth <= kMaxIoQueueDepth,
+                               "Invalid io queue depth: " + std::to_string(queue_depth) +
+                                 ", it should be in range [1, " + std::to_string(kMaxIoQueueDepth) + "].");
+  auto reader = std::shared_ptr<ShardBlobReader>(new ShardBlobReader(io_mode, queue_depth));
+  RETURN_IF_NOT_OK(reader->OpenFiles(file_paths));
+  if (io_mode == IoMode::kIoUring) {
+    // Probe the kernel once, io_uring may be missing or forbidden by seccomp in containers.
+    IoUringContext *context = nullptr;
+    Status rc = reader->GetIoUringContext(0, &context);
+    if (rc.IsError()) {
+      MS_LOG(WARNING) << "io_uring is not available, use the thread pool to read mindrecord files instead. "
+                      << rc.ToString();
+      reader->io_mode_ = IoMode::kThreadPool;
+    }
+  }
+  if (reader->io_mode_ == IoMode::kThreadPool) {
+    reader->StartThreadPool();
+  }
+  *blob_reader = reader;
+  return Status::OK();
+#endif
+}
+
+Status ShardBlobReader::OpenFiles(const std::vector<std::string> &file_paths) {
+  for (const auto &file : file_paths) {
+    auto realpath = FileUtils::GetRealPath(file.c_str());
+    CHECK_FAIL_RETURN_UNEXPECTED(
+      realpath.has_value(), "Invalid file, failed to get the realpath of mindrecord files. Please check file: " + file);
+    int fd = open(realpath.value().c_str(), O_RDONLY);
+    CHECK_FAIL_RETURN_UNEXPECTED(fd >= 0,
+                                 "Invalid file, failed to open files for reading mindrecord files. Please check file "
+                                 "path, permission and open files limit(ulimit -a): " +
+                                   file);
+    fds_.push_back(fd);
+  }
+  return Status::OK();
+}
+
+void ShardBlobReader::StartThreadPool() {
+  int num_threads = std::min(queue_depth_, kMaxIoThreads);
+  for (int i = 0; i < num_threads; ++i) {
+    io_threads_.emplace_back(&ShardBlobReader::IoThread, this);
+  }
+}
+
+void ShardBlobReader::IoThread() {
+  while (true) {
+    ReadJob job;
+    {
+      std::unique_lock<std::mutex> lock(jobs_mutex_);
+      jobs_cv_.wait(lock, [this] { return stop_ || !jobs_.empty(); });
+      if (jobs_.empty()) {
+        return;
+      }
+      job = jobs_.front();
+      jobs_.pop_front();
+    }
+    const auto &request = (*job.batch->requests)[job.index];
+    uint64_t done = 0;
+    Status rc = Status::OK();
+#if !defined(_WIN32) && !defined(_WIN64)
+    while (done < request.length) {
+      ssize_t ret = pread(fds_[request.shard_id], request.dest + done, request.length - done,
+                          static_cast<off_t>(request.offset + done));
+      if (ret < 0 && errno == EINTR) {
+        continue;
+      }
+      if (ret <= 0) {
+        rc = Status(StatusCode::kMDUnexpectedError, __LINE__, __FILE__,
+                    "Failed to read mindrecord file, " +
+                      std::string(ret < 0 ? strerror(errno) : "unexpected end of file."));
+        break;
+      }
+      done += static_cast<uint64_t>(ret);
+    }
+#endif
+    {
+      std::lock_guard<std::mutex> lock(job.batch->mutex);
+      if (rc.IsError() && job.batch->rc.IsOk()) {
+        job.batch->rc = rc;
+      }
+      if (--job.batch->remaining == job.batch->target) {
+        job.batch->cv.notify_one();
+      }
+    }
+  }
+}
+
+Status ShardBlobReader::ReadBatchByThreadPool(const std::vector<BlobRequest> &requests) {
+  BatchState batch;
+  batch.requests = &requests;
+  batch.remaining = requests.size();
+  batch.target = 0;
+  batch.rc = Status::OK();
+  // Submit by windows of queue_depth_ reads, so that one consumer does not monopolize the shared io threads.
+  size_t submitted = 0;
+  while (submitted < requests.size()) {
+    size_t window_end = std::min(submitted + static_cast<size_t>(queue_depth_), requests.size());
+    {
+      std::lock_guard<std::mutex> lock(batch.mutex);
+      batch.target = requests.size() - window_end;
+    }
+    {
+      std::lock_guard<std::mutex> lock(jobs_mutex_);
+      for (size_t i = submitted; i < window_end; ++i) {
+        jobs_.push_back({&batch, i});
+      }
+    }
+    jobs_cv_.notify_all();
+    std::unique_lock<std::mutex> lock(batch.mutex);
+    batch.cv.wait(lock, [&batch] { return batch.remaining == batch.target; });
+    submitted = window_end;
+    if (batch.rc.IsError()) {
+      break;
+    }
+  }
+  return batch.rc;
+}
+
+Status ShardBlobReader::GetIoUringContext(int consumer_id, IoUringContext **context) {
+  RETURN_UNEXPECTED_IF_NULL(context);
+  CHECK_FAIL_RETURN_UNEXPECTED(consumer_id >= 0,
+                               "[Internal ERROR] invalid consumer id: " + std::to_string(consumer_id));
+  std::lock_guard<std::mutex> lock(rings_mutex_);
+  if (rings_.size() <= static_cast<size_t>(consumer_id)) {
+    rings_.resize(consumer_id + 1);
+  }
+  if (rings_[consumer_id] == nullptr) {
+    auto ring = std::make_unique<IoUringContext>();
+    RETURN_IF_NOT_OK(ring->Init(static_cast<uint32_t>(queue_depth_)));
+    rings_[consumer_id] = std::move(ring);
+  }
+  *context = rings_[consumer_id].get();
+  return Status::OK();
+}
+
+Status ShardBlobReader::ReadBatch(int consumer_id, const std::vector<BlobRequest> &requests) {
+  for (const auto &request : requests) {
+    CHECK_FAIL_RETURN_UNEXPECTED(request.shard_id >= 0 && request.shard_id < static_cast<int>(fds_.size()),
+                                 "[Internal ERROR] invalid shard id: " + std::to_string(request.shard_id));
+    CHECK_FAIL_RETURN_UNEXPECTED(request.length == 0 || request.dest != nullptr,
+                                 "[Internal ERROR] the destination of blob is null.");
+  }
+  if (requests.empty()) {
+    return Status::OK();
+  }
+  if (io_mode_ == IoMode::kIoUring) {
+    IoUringContext *context = nullptr;
+    RETURN_IF_NOT_OK(GetIoUringContext(consumer_id, &context));
+    return context->ReadBatch(fds_, requests);
+  }
+  return ReadBatchByThreadPool(requests);
+}
+}  // namespace mindrecord
+}  // namespace mindspore
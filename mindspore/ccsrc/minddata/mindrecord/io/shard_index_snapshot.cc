@@ -0,0 +1,208 @@
+/**
+ * Copyright 2022 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "minddata/mindrecord/include/shard_index_snapshot.h"
+
+#include <sys/stat.h>
+#include <unistd.h>
+#if !defined(_WIN32) && !defined(_WIN64)
+#include <fcntl.h>
+#include <sys/mman.h>
+#endif
+#include <cstring>
+#include <fstream>
+
+#include "utils/ms_utils.h"
+
+namespace mindspore {
+namespace mindrecord {
+namespace {
+constexpr uint64_t kOffsetFieldNum = 3;  // row group id, blob start, blob end
+
+template <typename T>
+void AppendValue(const T &value, std::vector<uint8_t> *buffer) {
+  auto old_size = buffer->size();
+  buffer->resize(old_size + sizeof(T));
+  (void)memcpy(buffer->data() + old_size, &value, sizeof(T));
+}
+
+Status AppendFileStat(const std::string &path, std::vector<uint8_t> *buffer) {
+  struct stat file_stat;
+  CHECK_FAIL_RETURN_UNEXPECTED(stat(common::SafeCStr(path), &file_stat) == 0, "Failed to stat file: " + path);
+  // A file rewritten within the same second keeps st_mtime, so the nanoseconds are compared as well.
+  AppendValue(static_cast<uint64_t>(file_stat.st_size), buffer);
+#if defined(__APPLE__)
+  AppendValue(static_cast<int64_t>(file_stat.st_mtimespec.tv_sec), buffer);
+  AppendValue(static_cast<int64_t>(file_stat.st_mtimespec.tv_nsec), buffer);
+#elif defined(_WIN32) || defined(_WIN64)
+  AppendValue(static_cast<int64_t>(file_stat.st_mtime), buffer);
+  AppendValue(static_cast<int64_t>(0), buffer);
+#else
+  AppendValue(static_cast<int64_t>(file_stat.st_mtim.tv_sec), buffer);
+  AppendValue(static_cast<int64_t>(file_stat.st_mtim.tv_nsec), buffer);
+#endif
+  return Status::OK();
+}
+
+// Read only view of a whole file, mapped where mmap is available. The label store loaded from the snapshot references
+// the values in the view, so the view is shared with it.
+class SnapshotFile {
+ public:
+  SnapshotFile() = default;
+
+  ~SnapshotFile() {
+#if !defined(_WIN32) && !defined(_WIN64)
+    if (data_ != nullptr) {
+      (void)munmap(const_cast<uint8_t *>(data_), size_);
+    }
+#endif
+  }
+
+  SnapshotFile(const SnapshotFile &) = delete;
+  SnapshotFile &operator=(const SnapshotFile &) = delete;
+
+  Status Open(const std::string &path) {
+#if !defined(_WIN32) && !defined(_WIN64)
+    int fd = open(common::SafeCStr(path), O_RDONLY);
+    CHECK_FAIL_RETURN_UNEXPECTED(fd >= 0, "Failed to open index snapshot: " + path);
+    struct stat file_stat;
+    if (fstat(fd, &file_stat) != 0 || file_stat.st_size <= 0) {
+      (void)close(fd);
+      RETURN_STATUS_UNEXPECTED("Index snapshot is empty or can not be accessed: " + path);
+    }
+    size_ = static_cast<uint64_t>(file_stat.st_size);
+    void *addr = mmap(nullptr, size_, PROT_READ, MAP_PRIVATE, fd, 0);
+    (void)close(fd);
+    CHECK_FAIL_RETURN_UNEXPECTED(addr != MAP_FAILED, "Failed to map index snapshot: " + path);
+    (void)madvise(addr, size_, MADV_WILLNEED);
+    data_ = static_cast<const uint8_t *>(addr);
+#else
+    std::ifstream fs(path, std::ios::in | std::ios::binary);
+    CHECK_FAIL_RETURN_UNEXPECTED(fs.good(), "Failed to open index snapshot: " + path);
+    buffer_.assign(std::istreambuf_iterator<char>(fs), std::istreambuf_iterator<char>());
+    CHECK_FAIL_RETURN_UNEXPECTED(!buffer_.empty(), "Index snapshot is empty: " + path);
+    data_ = buffer_.data();
+    size_ = buffer_.size();
+#endif
+    return Status::OK();
+  }
+
+  const uint8_t *Data() const { return data_; }
+
+  uint64_t Size() const { return size_; }
+
+ private:
+  const uint8_t *data_ = nullptr;
+  uint64_t size_ = 0;
+#if defined(_WIN32) || defined(_WIN64)
+  std::vector<uint8_t> buffer_;
+#endif
+};
+}  // namespace
+
+Status ShardIndexSnapshot::BuildHeader(const std::string &file_path, const std::vector<std::string> &columns,
+                                       std::vector<uint8_t> *header) {
+  RETURN_UNEXPECTED_IF_NULL(header);
+  header->clear();
+  (void)header->insert(header->end(), kIndexSnapshotMagic, kIndexSnapshotMagic + strlen(kIndexSnapshotMagic));
+  AppendValue(kIndexSnapshotVersion, header);
+  RETURN_IF_NOT_OK(AppendFileStat(file_path, header));
+  RETURN_IF_NOT_OK(AppendFileStat(file_path + ".db", header));
+  AppendValue(static_cast<uint64_t>(columns.size()), header);
+  for (const auto &column : columns) {
+    AppendValue(static_cast<uint64_t>(column.size()), header);
+    (void)header->insert(header->end(), column.begin(), column.end());
+  }
+  return Status::OK();
+}
+
+Status ShardIndexSnapshot::Load(const std::string &file_path, int shard_id, const std::vector<std::string> &columns,
+                                const std::shared_ptr<ShardLabelStore> &label_store,
+                                std::vector<std::vector<uint64_t>> *offsets) {
+  RETURN_UNEXPECTED_IF_NULL(label_store);
+  RETURN_UNEXPECTED_IF_NULL(offsets);
+  std::vector<uint8_t> header;
+  RETURN_IF_NOT_OK(BuildHeader(file_path, columns, &header));
+  auto snapshot_path = GetSnapshotPath(file_path);
+  auto snapshot = std::make_shared<SnapshotFile>();
+  RETURN_IF_NOT_OK(snapshot->Open(snapshot_path));
+  const uint8_t *data = snapshot->Data();
+  uint64_t size = snapshot->Size();
+  CHECK_FAIL_RETURN_UNEXPECTED(size >= header.size() + sizeof(uint64_t) &&
+                                 memcmp(data, header.data(), header.size()) == 0,
+                               "Index snapshot is stale: " + snapshot_path);
+  uint64_t pos = header.size();
+  uint64_t num_rows = 0;
+  (void)memcpy(&num_rows, data + pos, sizeof(uint64_t));
+  pos += sizeof(uint64_t);
+  CHECK_FAIL_RETURN_UNEXPECTED(num_rows <= (size - pos) / (kOffsetFieldNum * sizeof(uint64_t)),
+                               "Index snapshot is truncated: " + snapshot_path);
+  std::vector<std::vector<uint64_t>> rows(num_rows);
+  for (uint64_t i = 0; i < num_rows; ++i) {
+    uint64_t fields[kOffsetFieldNum];
+    (void)memcpy(fields, data + pos, sizeof(fields));
+    pos += sizeof(fields);
+    rows[i] = {static_cast<uint64_t>(shard_id), fields[0], fields[1], fields[2]};
+  }
+  uint64_t used = 0;
+  RETURN_IF_NOT_OK(label_store->Deserialize(data + pos, size - pos, snapshot, &used));
+  CHECK_FAIL_RETURN_UNEXPECTED(label_store->Size() == static_cast<int64_t>(num_rows) && pos + used == size,
+                               "Index snapshot is corrupted: " + snapshot_path);
+  *offsets = std::move(rows);
+  return Status::OK();
+}
+
+Status ShardIndexSnapshot::Save(const std::string &file_path, const std::vector<std::string> &columns,
+                                const std::shared_ptr<ShardLabelStore> &label_store,
+                                const std::vector<std::vector<uint64_t>> &offsets) {
+  RETURN_UNEXPECTED_IF_NULL(label_store);
+  CHECK_FAIL_RETURN_UNEXPECTED(label_store->Size() == static_cast<int64_t>(offsets.size()),
+                               "[Internal ERROR] the number of rows in label store and offsets are different.");
+  std::vector<uint8_t> buffer;
+  RETURN_IF_NOT_OK(BuildHeader(file_path, columns, &buffer));
+  buffer.reserve(buffer.size() + sizeof(uint64_t) + offsets.size() * kOffsetFieldNum * sizeof(uint64_t) +
+                 label_store->MemoryUsage() + sizeof(uint64_t) * (columns.size() * 3 + 1));
+  AppendValue(static_cast<uint64_t>(offsets.size()), &buffer);
+  for (const auto &row : offsets) {
+    // the first field is the shard id, which depends on the order of the files given to the reader
+    CHECK_FAIL_RETURN_UNEXPECTED(row.size() == kOffsetFieldNum + 1, "[Internal ERROR] invalid row offsets.");
+    for (uint64_t i = 1; i <= kOffsetFieldNum; ++i) {
+      AppendValue(row[i], &buffer);
+    }
+  }
+  label_store->Serialize(&buffer);
+
+  // Write to a temporary file first, so that concurrent readers never map a partially written snapshot.
+  auto snapshot_path = GetSnapshotPath(file_path);
+  auto tmp_path = snapshot_path + ".tmp" + std::to_string(getpid());
+  {
+    std::ofstream fs(tmp_path, std::ios::out | std::ios::binary | std::ios::trunc);
+    CHECK_FAIL_RETURN_UNEXPECTED(fs.good(), "Failed to create index snapshot: " + tmp_path);
+    (void)fs.write(reinterpret_cast<const char *>(buffer.data()), static_cast<std::streamsize>(buffer.size()));
+    if (!fs.good()) {
+      fs.close();
+      (void)remove(common::SafeCStr(tmp_path));
+      RETURN_STATUS_UNEXPECTED("Failed to write index snapshot: " + tmp_path);
+    }
+  }
+  if (rename(common::SafeCStr(tmp_path), common::SafeCStr(snapshot_path)) != 0) {
+    (void)remove(common::SafeCStr(tmp_path));
+    RETURN_STATUS_UNEXPECTED("Failed to rename index snapshot to: " + snapshot_path);
+  }
+  return Status::OK();
+}
+}  // namespace mindrecord
+}  // namespace mindspore
@@ -340,6 +340,7 @@ void ShardReader::Close() {
   }
 
   FileStreamsOperator();
+  blob_reader_.reset();
 }
 
 std::shared_ptr<ShardHeader> ShardReader::GetShardHeader() const { return shard_header_; }
@@ -389,8 +390,14 @@ Status ShardReader::ConvertLabelToJson(const std::vector<std::vector<std::string
                                        std::shared_ptr<std::fstream> fs,
                                        std::shared_ptr<std::vector<std::vector<std::vector<uint64_t>>>> offset_ptr,
                                        int shard_id, const std::vector<std::string> &columns,
-                                       std::shared_ptr<std::vector<std::vector<json>>> col_val_ptr) {
+                                       std::shared_ptr<std::vector<std::vector<json>>> col_val_ptr,
+                                       std::shared_ptr<std::vector<std::shared_ptr<ShardLabelStore>>> label_stores_ptr) {
   auto schema = shard_header_->GetSchemas()[0]->GetSchema()["schema"];
+  std::shared_ptr<ShardLabelStore> label_store;
+  if (all_in_index_ && label_stores_ptr != nullptr) {
+    label_store = (*label_stores_ptr)[shard_id];
+    label_store->Reserve(static_cast<int64_t>(labels.size()));
+  }
   for (int i = 0; i < static_cast<int>(labels.size()); ++i) {
     try {
       uint64_t group_id = std::stoull(labels[i][0]);
@@ -426,6 +433,9 @@ Status ShardReader::ConvertLabelToJson(const std::vector<std::vector<std::string
           tmp = label_json;
         }
         (*col_val_ptr)[shard_id].emplace_back(tmp);
+      } else if (label_store != nullptr) {
+        RETURN_IF_NOT_OK(label_store->AppendRow(labels[i], 3));
+        (*col_val_ptr)[shard_id].emplace_back(json());
       } else {
         json construct_json;
         RETURN_IF_NOT_OK(ConvertJsonValue(labels[i], columns, schema, &construct_json));
@@ -468,7 +478,8 @@ Status ShardReader::ConvertJsonValue(const std::vector<std::string> &label, cons
 }
 Status ShardReader::ReadAllRowsInShard(int shard_id, const std::string &sql, const std::vector<std::string> &columns,
                                        std::shared_ptr<std::vector<std::vector<std::vector<uint64_t>>>> offset_ptr,
-                                       std::shared_ptr<std::vector<std::vector<json>>> col_val_ptr) {
+                                       std::shared_ptr<std::vector<std::vector<json>>> col_val_ptr,
+                                       std::shared_ptr<std::vector<std::shared_ptr<ShardLabelStore>>> label_stores_ptr) {
   auto db = database_paths_[shard_id];
   std::vector<std::vector<std::string>> labels;
   char *errmsg = nullptr;
@@ -505,7 +516,7 @@ Status ShardReader::ReadAllRowsInShard(int shard_id, const std::string &sql, con
     }
   }
   sqlite3_free(errmsg);
-  return ConvertLabelToJson(labels, fs, offset_ptr, shard_id, columns, col_val_ptr);
+  return ConvertLabelToJson(labels, fs, offset_ptr, shard_id, columns, col_val_ptr, label_stores_ptr);
 }
 
 Status ShardReader::GetAllClasses(const std::string &category_field,
@@ -559,13 +570,35 @@ void ShardReader::GetClassesInShard(sqlite3 *db, int shard_id, const std::string
 }
 
 Status ShardReader::ReadAllRowGroup(const std::vector<std::string> &columns,
-                                    std::shared_ptr<ROW_GROUPS> *row_group_ptr) {
+                                    std::shared_ptr<ROW_GROUPS> *row_group_ptr,
+                                    std::shared_ptr<ShardLabelStore> *label_store_ptr) {
   RETURN_UNEXPECTED_IF_NULL(row_group_ptr);
   std::string fields = "ROW_GROUP_ID, PAGE_OFFSET_BLOB, PAGE_OFFSET_BLOB_END";
   auto offset_ptr = std::make_shared<std::vector<std::vector<std::vector<uint64_t>>>>(
     shard_count_, std::vector<std::vector<uint64_t>>{});
   auto col_val_ptr = std::make_shared<std::vector<std::vector<json>>>(shard_count_, std::vector<json>{});
 
+  // Each shard fills its own label store, they are concatenated in shard order once all the threads are done.
+  // The index snapshot is kept in label store layout, so the stores are also needed when it is in use.
+  bool use_snapshot = index_snapshot_ && all_in_index_;
+  std::shared_ptr<std::vector<std::shared_ptr<ShardLabelStore>>> label_stores_ptr = nullptr;
+  if (all_in_index_ && (label_store_ptr != nullptr || use_snapshot)) {
+    std::vector<ColumnDataType> types;
+    for (const auto &column : columns) {
+      ColumnDataType column_data_type = ColumnNoDataType;
+      uint64_t column_data_type_size = 0;
+      std::vector<int64_t> column_shape;
+      ColumnCategory column_category = ColumnNotFound;
+      RETURN_IF_NOT_OK(shard_column_->GetColumnTypeByName(column, &column_data_type, &column_data_type_size,
+                                                          &column_shape, &column_category));
+      types.push_back(column_data_type);
+    }
+    label_stores_ptr = std::make_shared<std::vector<std::shared_ptr<ShardLabelStore>>>();
+    for (int x = 0; x < shard_count_; x++) {
+      label_stores_ptr->push_back(std::make_shared<ShardLabelStore>(columns, types));
+    }
+  }
+
   if (all_in_index_) {
     for (unsigned int i = 0; i < columns.size(); ++i) {
       fields += ',';
@@ -582,16 +615,68 @@ Status ShardReader::ReadAllRowGroup(const std::vector<std::string> &columns,
 
   std::vector<std::thread> thread_read_db = std::vector<std::thread>(shard_count_);
   for (int x = 0; x < shard_count_; x++) {
-    thread_read_db[x] = std::thread(&ShardReader::ReadAllRowsInShard, this, x, sql, columns, offset_ptr, col_val_ptr);
+    if (use_snapshot) {
+      thread_read_db[x] = std::thread(&ShardReader::ReadAllRowsInShardWithSnapshot, this, x, sql, columns, offset_ptr,
+                                      col_val_ptr, label_stores_ptr);
+    } else {
+      thread_read_db[x] = std::thread(&ShardReader::ReadAllRowsInShard, this, x, sql, columns, offset_ptr,
+                                      col_val_ptr, label_stores_ptr);
+    }
   }
 
   for (int x = 0; x < shard_count_; x++) {
     thread_read_db[x].join();
   }
+  if (label_stores_ptr != nullptr && label_store_ptr == nullptr) {
+    // The caller expects one json per row
+    for (int x = 0; x < shard_count_; x++) {
+      auto &col_val = (*col_val_ptr)[x];
+      for (size_t i = 0; i < col_val.size(); ++i) {
+        RETURN_IF_NOT_OK((*label_stores_ptr)[x]->GetRowAsJson(static_cast<int64_t>(i), &col_val[i]));
+      }
+    }
+  } else if (label_stores_ptr != nullptr) {
+    auto label_store = (*label_stores_ptr)[0];
+    for (int x = 1; x < shard_count_; x++) {
+      RETURN_IF_NOT_OK(label_store->Append(*(*label_stores_ptr)[x]));
+      (*label_stores_ptr)[x].reset();
+    }
+    MS_LOG(INFO) << "Succeed to load " << label_store->Size() << " rows into the columnar label store, memory usage: "
+                 << label_store->MemoryUsage() << " bytes.";
+    *label_store_ptr = label_store;
+  }
   *row_group_ptr = std::make_shared<ROW_GROUPS>(std::move(*offset_ptr), std::move(*col_val_ptr));
   return Status::OK();
 }
 
+Status ShardReader::ReadAllRowsInShardWithSnapshot(
+  int shard_id, const std::string &sql, const std::vector<std::string> &columns,
+  std::shared_ptr<std::vector<std::vector<std::vector<uint64_t>>>> offset_ptr,
+  std::shared_ptr<std::vector<std::vector<json>>> col_val_ptr,
+  std::shared_ptr<std::vector<std::shared_ptr<ShardLabelStore>>> label_stores_ptr) {
+  const std::string &file_name = file_paths_[shard_id];
+  auto label_store = (*label_stores_ptr)[shard_id];
+  std::vector<std::vector<uint64_t>> offsets;
+  Status rc = ShardIndexSnapshot::Load(file_name, shard_id, columns, label_store, &offsets);
+  if (rc.IsOk()) {
+    MS_LOG(INFO) << "Succeed to get " << offsets.size() << " records from shard " << std::to_string(shard_id)
+                 << " index snapshot.";
+    (*col_val_ptr)[shard_id].resize(offsets.size());
+    (*offset_ptr)[shard_id] = std::move(offsets);
+    return Status::OK();
+  }
+  MS_LOG(INFO) << "The index snapshot of shard " << std::to_string(shard_id)
+               << " can not be used, read the index table instead. " << rc.ToString();
+
+  RETURN_IF_NOT_OK(ReadAllRowsInShard(shard_id, sql, columns, offset_ptr, col_val_ptr, label_stores_ptr));
+  rc = ShardIndexSnapshot::Save(file_name, columns, label_store, (*offset_ptr)[shard_id]);
+  if (rc.IsError()) {
+    MS_LOG(WARNING) << "Failed to save the index snapshot of file: " << file_name << ", the index table will be read "
+                    << "again next time. " << rc.ToString();
+  }
+  return Status::OK();
+}
+
 Status ShardReader::ReadRowGroupByShardIDAndSampleID(const std::vector<std::string> &columns, const uint32_t &shard_id,
                                                      const uint32_t &sample_id,
                                                      std::shared_ptr<ROW_GROUPS> *row_group_ptr) {
@@ -614,7 +699,7 @@ Status ShardReader::ReadRowGroupByShardIDAndSampleID(const std::vector<std::stri
 
   std::string sql = "SELECT " + fields + " FROM INDEXES WHERE ROW_ID = " + std::to_string(sample_id);
 
-  RETURN_IF_NOT_OK(ReadAllRowsInShard(shard_id, sql, columns, offset_ptr, col_val_ptr));
+  RETURN_IF_NOT_OK(ReadAllRowsInShard(shard_id, sql, columns, offset_ptr, col_val_ptr, nullptr));
   *row_group_ptr = std::make_shared<ROW_GROUPS>(std::move(*offset_ptr), std::move(*col_val_ptr));
   return Status::OK();
 }
@@ -1094,6 +1179,16 @@ Status ShardReader::Open(const std::vector<std::string> &file_paths, bool load_d
 
   operators_ = operators;
   RETURN_IF_NOT_OK(Open(n_consumer));
+
+  blob_reader_.reset();
+  if (io_mode_ != IoMode::kStream) {
+    Status rc = ShardBlobReader::Create(io_mode_, file_paths_, io_queue_depth_, &blob_reader_);
+    if (rc.IsError()) {
+      MS_LOG(WARNING) << "Failed to create the asynchronous blob reader, read the blobs by file streams instead. "
+                      << rc.ToString();
+      blob_reader_.reset();
+    }
+  }
   return Status::OK();
 }
 
@@ -1196,7 +1291,8 @@ Status ShardReader::CreateTasksByRow(const std::vector<std::tuple<int, int, int,
                                      const std::vector<std::shared_ptr<ShardOperator>> &operators) {
   CheckIfColumnInIndex(selected_columns_);
   std::shared_ptr<ROW_GROUPS> row_group_ptr;
-  RETURN_IF_NOT_OK(ReadAllRowGroup(selected_columns_, &row_group_ptr));
+  label_store_.reset();
+  RETURN_IF_NOT_OK(ReadAllRowGroup(selected_columns_, &row_group_ptr, columnar_label_ ? &label_store_ : nullptr));
   auto &offsets = std::get<0>(*row_group_ptr);
   auto &local_columns = std::get<1>(*row_group_ptr);
   CHECK_FAIL_RETURN_UNEXPECTED(shard_count_ <= kMaxFileCount,
@@ -1322,9 +1418,11 @@ Status ShardReader::CreateTasks(const std::vector<std::tuple<int, int, int, uint
   return Status::OK();
 }
 
-Status ShardReader::ConsumerOneTask(int64_t task_id, uint32_t consumer_id,
-                                    std::shared_ptr<TASK_CONTENT> *task_content_ptr) {
-  RETURN_UNEXPECTED_IF_NULL(task_content_ptr);
+Status ShardReader::GetTaskBlobInfo(int64_t task_id, TaskType *task_type, BlobRequest *request,
+                                    json *var_fields) {
+  RETURN_UNEXPECTED_IF_NULL(task_type);
+  RETURN_UNEXPECTED_IF_NULL(request);
+  RETURN_UNEXPECTED_IF_NULL(var_fields);
   // All tasks are done
   CHECK_FAIL_RETURN_UNEXPECTED(task_id < tasks_.Size(), "[Internal ERROR] 'task_id': " + std::to_string(task_id) +
                                                           " is out of bound: " + std::to_string(tasks_.Size()));
@@ -1332,15 +1430,12 @@ Status ShardReader::ConsumerOneTask(int64_t task_id, uint32_t consumer_id,
   uint32_t group_id = 0;
   uint32_t blob_start = 0;
   uint32_t blob_end = 0;
-  json var_fields;
   // Pick up task from task list
   ShardTask task = tasks_.GetTaskByID(task_id);
 
   // check task type
-  auto task_type = std::get<0>(task);
-  if (task_type == TaskType::kPaddedTask) {
-    *task_content_ptr =
-      std::make_shared<TASK_CONTENT>(TaskType::kPaddedTask, std::vector<std::tuple<std::vector<uint8_t>, json>>());
+  *task_type = std::get<0>(task);
+  if (*task_type == TaskType::kPaddedTask) {
     return Status::OK();
   }
 
@@ -1350,7 +1445,7 @@ Status ShardReader::ConsumerOneTask(int64_t task_id, uint32_t consumer_id,
     group_id = std::get<1>(std::get<1>(task));  // group id
     blob_start = std::get<2>(task)[0];          // blob start
     blob_end = std::get<2>(task)[1];            // blob end
-    var_fields = std::get<3>(task);             // scalar variable field
+    *var_fields = std::get<3>(task);            // scalar variable field, empty if kept in label_store_
   } else {
     // get scalar variable fields by sample id
     uint32_t sample_id_in_shard = std::get<1>(std::get<1>(task));
@@ -1361,38 +1456,82 @@ Status ShardReader::ConsumerOneTask(int64_t task_id, uint32_t consumer_id,
     auto &offsets = std::get<0>(*row_group_ptr);
     auto &local_columns = std::get<1>(*row_group_ptr);
 
-    group_id = offsets[shard_id][0][1];       // group_id
-    blob_start = offsets[shard_id][0][2];     // blob start
-    blob_end = offsets[shard_id][0][3];       // blob end
-    var_fields = local_columns[shard_id][0];  // scalar variable field
+    group_id = offsets[shard_id][0][1];        // group_id
+    blob_start = offsets[shard_id][0][2];      // blob start
+    blob_end = offsets[shard_id][0][3];        // blob end
+    *var_fields = local_columns[shard_id][0];  // scalar variable field
   }
 
-  // read the blob from data file
+  // locate the blob in data file
   std::shared_ptr<Page> page_ptr;
   RETURN_IF_NOT_OK(shard_header_->GetPageByGroupId(group_id, shard_id, &page_ptr));
   MS_LOG(DEBUG) << "[Internal ERROR] Success to get page by group id: " << group_id;
 
-  // Pack image list
-  std::vector<uint8_t> images(blob_end - blob_start);
-  auto file_offset = header_size_ + page_size_ * (page_ptr->GetPageID()) + blob_start;
+  request->shard_id = static_cast<int>(shard_id);
+  request->offset = header_size_ + page_size_ * (page_ptr->GetPageID()) + blob_start;
+  request->length = blob_end - blob_start;
+  request->dest = nullptr;
+  return Status::OK();
+}
 
-  auto &io_seekg = file_streams_random_[consumer_id][shard_id]->seekg(file_offset, std::ios::beg);
-  if (!io_seekg.good() || io_seekg.fail() || io_seekg.bad()) {
-    file_streams_random_[consumer_id][shard_id]->close();
-    RETURN_STATUS_UNEXPECTED("[Internal ERROR] Failed to seekg file.");
+Status ShardReader::ConsumerOneTask(int64_t task_id, uint32_t consumer_id,
+                                    std::shared_ptr<TASK_CONTENT> *task_content_ptr) {
+  RETURN_UNEXPECTED_IF_NULL(task_content_ptr);
+  std::vector<std::shared_ptr<TASK_CONTENT>> task_contents;
+  RETURN_IF_NOT_OK(ConsumerTasks({task_id}, consumer_id, &task_contents));
+  *task_content_ptr = task_contents[0];
+  return Status::OK();
+}
+
+Status ShardReader::ConsumerTasks(const std::vector<int64_t> &task_ids, uint32_t consumer_id,
+                                  std::vector<std::shared_ptr<TASK_CONTENT>> *task_contents) {
+  RETURN_UNEXPECTED_IF_NULL(task_contents);
+  task_contents->clear();
+  std::vector<BlobRequest> requests;
+  std::vector<size_t> request_rows;
+  std::vector<std::vector<uint8_t>> images(task_ids.size());
+  std::vector<json> var_fields(task_ids.size());
+  for (size_t i = 0; i < task_ids.size(); ++i) {
+    TaskType task_type = TaskType::kCommonTask;
+    BlobRequest request = {0, 0, 0, nullptr};
+    RETURN_IF_NOT_OK(GetTaskBlobInfo(task_ids[i], &task_type, &request, &var_fields[i]));
+    if (task_type == TaskType::kPaddedTask) {
+      task_contents->push_back(std::make_shared<TASK_CONTENT>(TaskType::kPaddedTask,
+                                                              std::vector<std::tuple<std::vector<uint8_t>, json>>()));
+      continue;
+    }
+    task_contents->push_back(nullptr);
+    images[i].resize(request.length);
+    request.dest = images[i].data();
+    requests.push_back(request);
+    request_rows.push_back(i);
   }
-  auto &io_read =
-    file_streams_random_[consumer_id][shard_id]->read(reinterpret_cast<char *>(&images[0]), blob_end - blob_start);
-  if (!io_read.good() || io_read.fail() || io_read.bad()) {
-    file_streams_random_[consumer_id][shard_id]->close();
-    RETURN_STATUS_UNEXPECTED("[Internal ERROR] Failed to read file.");
+
+  // Pack image list
+  if (blob_reader_ != nullptr) {
+    RETURN_IF_NOT_OK(blob_reader_->ReadBatch(static_cast<int>(consumer_id), requests));
+  } else {
+    for (const auto &request : requests) {
+      auto &fs = file_streams_random_[consumer_id][request.shard_id];
+      auto &io_seekg = fs->seekg(request.offset, std::ios::beg);
+      if (!io_seekg.good() || io_seekg.fail() || io_seekg.bad()) {
+        fs->close();
+        RETURN_STATUS_UNEXPECTED("[Internal ERROR] Failed to seekg file.");
+      }
+      auto &io_read = fs->read(reinterpret_cast<char *>(request.dest), request.length);
+      if (!io_read.good() || io_read.fail() || io_read.bad()) {
+        fs->close();
+        RETURN_STATUS_UNEXPECTED("[Internal ERROR] Failed to read file.");
+      }
+    }
   }
 
   // Deliver batch data to output map
-  std::vector<std::tuple<std::vector<uint8_t>, json>> batch;
-  batch.emplace_back(std::move(images), std::move(var_fields));
-
-  *task_content_ptr = std::make_shared<TASK_CONTENT>(TaskType::kCommonTask, std::move(batch));
+  for (auto i : request_rows) {
+    std::vector<std::tuple<std::vector<uint8_t>, json>> batch;
+    batch.emplace_back(std::move(images[i]), std::move(var_fields[i]));
+    (*task_contents)[i] = std::make_shared<TASK_CONTENT>(TaskType::kCommonTask, std::move(batch));
+  }
   return Status::OK();
 }
 
@@ -1403,37 +1542,54 @@ void ShardReader::ConsumerByRow(int consumer_id) {
   prctl(PR_SET_NAME, common::SafeCStr(thread_id), 0, 0, 0);
 #endif
 
+  // With asynchronous io, a consumer takes several samples at once so that their blobs are read together.
+  int num_per_round = blob_reader_ != nullptr ? blob_reader_->GetQueueDepth() : 1;
+  int num_samples = static_cast<int>(tasks_.sample_ids_.size());
+
   // Loop forever
   for (;;) {
     int sample_id_pos = 0;
 
     // Get next task ID
-    sample_id_pos = sample_id_position_++;
+    sample_id_pos = sample_id_position_.fetch_add(num_per_round);
 
     // All tasks are done
-    if (sample_id_pos >= static_cast<int>(tasks_.sample_ids_.size())) {
+    if (sample_id_pos >= num_samples) {
       return;
     }
-    auto task_content_ptr =
-      std::make_shared<TASK_CONTENT>(TaskType::kCommonTask, std::vector<std::tuple<std::vector<uint8_t>, json>>());
-    if (ConsumerOneTask(tasks_.sample_ids_[sample_id_pos], consumer_id, &task_content_ptr).IsError()) {
-      MS_LOG(ERROR) << "[Internal ERROR] Error raised in ConsumerOneTask function.";
+    int sample_id_end = std::min(sample_id_pos + num_per_round, num_samples);
+    std::vector<int64_t> task_ids(tasks_.sample_ids_.begin() + sample_id_pos,
+                                  tasks_.sample_ids_.begin() + sample_id_end);
+    std::vector<std::shared_ptr<TASK_CONTENT>> task_contents;
+    if (ConsumerTasks(task_ids, consumer_id, &task_contents).IsError()) {
+      MS_LOG(ERROR) << "[Internal ERROR] Error raised in ConsumerTasks function.";
       return;
     }
-    const auto &batch = (*task_content_ptr).second;
-    // Hanging if maximum map size exceeded
-    //   otherwise, set batch data in map
-    {
-      std::unique_lock<std::mutex> lck(mtx_delivery_);
-      cv_delivery_.wait(lck,
-                        [sample_id_pos, this] { return interrupt_ || sample_id_pos <= deliver_id_ + kNumBatchInMap; });
-      if (interrupt_) {
-        return;
+    for (size_t i = 0; i < task_contents.size(); ++i) {
+      auto &batch = task_contents[i]->second;
+      if (label_store_ != nullptr && task_contents[i]->first == TaskType::kCommonTask) {
+        for (auto &row : batch) {
+          if (label_store_->GetRowAsJson(task_ids[i], &std::get<1>(row)).IsError()) {
+            MS_LOG(ERROR) << "[Internal ERROR] Error raised in GetRowAsJson function.";
+            return;
+          }
+        }
+      }
+      int delivery_pos = sample_id_pos + static_cast<int>(i);
+      // Hanging if maximum map size exceeded
+      //   otherwise, set batch data in map
+      {
+        std::unique_lock<std::mutex> lck(mtx_delivery_);
+        cv_delivery_.wait(
+          lck, [delivery_pos, this] { return interrupt_ || delivery_pos <= deliver_id_ + kNumBatchInMap; });
+        if (interrupt_) {
+          return;
+        }
+        delivery_map_[delivery_pos] =
+          std::make_shared<std::vector<std::tuple<std::vector<uint8_t>, json>>>(std::move(batch));
       }
-      delivery_map_[sample_id_pos] =
-        std::make_shared<std::vector<std::tuple<std::vector<uint8_t>, json>>>(std::move(batch));
+      cv_iterator_.notify_one();
     }
-    cv_iterator_.notify_one();
   }
 }
 
@@ -1471,6 +1627,22 @@ TASK_CONTENT ShardReader::GetNextById(const int64_t &task_id, const int32_t &con
   return std::move(*task_content_ptr);
 }
 
+Status ShardReader::GetNextByIds(const std::vector<int64_t> &task_ids, const int32_t &consumer_id,
+                                 std::vector<TASK_CONTENT> *task_contents) {
+  RETURN_UNEXPECTED_IF_NULL(task_contents);
+  task_contents->clear();
+  // Unlike GetNextById no empty rows are returned, the caller expects a row for every id.
+  if (interrupt_) {
+    return Status(StatusCode::kMDInterrupted, __LINE__, __FILE__, "ShardReader is interrupted.");
+  }
+  std::vector<std::shared_ptr<TASK_CONTENT>> task_content_ptrs;
+  RETURN_IF_NOT_OK(ConsumerTasks(task_ids, consumer_id, &task_content_ptrs));
+  for (auto &task_content_ptr : task_content_ptrs) {
+    task_contents->push_back(std::move(*task_content_ptr));
+  }
+  return Status::OK();
+}
+
 Status ShardReader::UnCompressBlob(const std::vector<uint8_t> &raw_blob_data,
                                    std::shared_ptr<std::vector<std::vector<uint8_t>>> *blob_data_ptr) {
   RETURN_UNEXPECTED_IF_NULL(blob_data_ptr);
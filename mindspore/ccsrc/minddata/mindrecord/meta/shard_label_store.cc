@@ -0,0 +1,310 @@
+/**
+ * Copyright 2022 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "minddata/mindrecord/include/shard_label_store.h"
+
+#include <cstdlib>
+#include <cstring>
+
+namespace mindspore {
+namespace mindrecord {
+namespace {
+template <typename T>
+void AppendValue(const T &value, std::vector<uint8_t> *values) {
+  auto old_size = values->size();
+  values->resize(old_size + sizeof(T));
+  (void)memcpy(values->data() + old_size, &value, sizeof(T));
+}
+
+template <typename T>
+bool ReadValue(const uint8_t *data, uint64_t size, uint64_t *pos, T *value) {
+  if (size < sizeof(T) || *pos > size - sizeof(T)) {
+    return false;
+  }
+  (void)memcpy(value, data + *pos, sizeof(T));
+  *pos += sizeof(T);
+  return true;
+}
+
+template <typename T>
+T LoadValue(const uint8_t *values, int64_t row_id) {
+  T value;
+  (void)memcpy(&value, values + row_id * sizeof(T), sizeof(T));
+  return value;
+}
+}  // namespace
+
+ShardLabelStore::ShardLabelStore(const std::vector<std::string> &columns, const std::vector<ColumnDataType> &types)
+    : num_rows_(0) {
+  for (size_t i = 0; i < columns.size() && i < types.size(); ++i) {
+    Column column;
+    column.name = columns[i];
+    column.type = types[i];
+    switch (types[i]) {
+      case ColumnInt32:
+      case ColumnInt64:
+      case ColumnFloat32:
+      case ColumnFloat64:
+        column.width = ColumnDataTypeSize[types[i]];
+        break;
+      default:
+        // Everything else is kept as the text stored in the index, the same as ShardReader does for json.
+        column.type = ColumnString;
+        column.width = 0;
+        column.offset.push_back(0);
+        break;
+    }
+    column_id_[column.name] = columns_.size();
+    columns_.push_back(std::move(column));
+  }
+}
+
+uint64_t ShardLabelStore::Offset(const Column &column, uint64_t i) const {
+  if (holder_ == nullptr) {
+    return column.offset[i];
+  }
+  uint64_t offset = 0;
+  (void)memcpy(&offset, column.mapped_offset + i * sizeof(uint64_t), sizeof(uint64_t));
+  return offset;
+}
+
+void ShardLabelStore::Materialize() {
+  if (holder_ == nullptr) {
+    return;
+  }
+  for (auto &column : columns_) {
+    column.values.assign(column.mapped_values, column.mapped_values + column.mapped_values_size);
+    column.offset.resize(column.mapped_offset_count);
+    if (column.mapped_offset_count > 0) {
+      (void)memcpy(column.offset.data(), column.mapped_offset, column.mapped_offset_count * sizeof(uint64_t));
+    }
+    column.mapped_values = nullptr;
+    column.mapped_values_size = 0;
+    column.mapped_offset = nullptr;
+    column.mapped_offset_count = 0;
+  }
+  holder_.reset();
+}
+
+void ShardLabelStore::Reserve(int64_t num_rows) {
+  if (num_rows <= 0) {
+    return;
+  }
+  Materialize();
+  for (auto &column : columns_) {
+    if (column.width > 0) {
+      column.values.reserve(static_cast<size_t>(num_rows) * column.width);
+    } else {
+      column.offset.reserve(static_cast<size_t>(num_rows) + 1);
+    }
+  }
+}
+
+Status ShardLabelStore::AppendRow(const std::vector<std::string> &fields, size_t first_field) {
+  CHECK_FAIL_RETURN_UNEXPECTED(fields.size() >= first_field + columns_.size(),
+                               "[Internal ERROR] the number of fields: " + std::to_string(fields.size()) +
+                                 " is less than the number of columns: " + std::to_string(columns_.size()) + ".");
+  Materialize();
+  for (size_t i = 0; i < columns_.size(); ++i) {
+    auto &column = columns_[i];
+    const char *str = fields[first_field + i].c_str();
+    switch (column.type) {
+      case ColumnInt32:
+        AppendValue(static_cast<int32_t>(strtol(str, nullptr, 10)), &column.values);
+        break;
+      case ColumnInt64:
+        AppendValue(static_cast<int64_t>(strtoll(str, nullptr, 10)), &column.values);
+        break;
+      case ColumnFloat32:
+        AppendValue(strtof(str, nullptr), &column.values);
+        break;
+      case ColumnFloat64:
+        AppendValue(strtod(str, nullptr), &column.values);
+        break;
+      default: {
+        const auto &value = fields[first_field + i];
+        (void)column.values.insert(column.values.end(), value.begin(), value.end());
+        column.offset.push_back(column.values.size());
+        break;
+      }
+    }
+  }
+  ++num_rows_;
+  return Status::OK();
+}
+
+Status ShardLabelStore::Append(const ShardLabelStore &other) {
+  CHECK_FAIL_RETURN_UNEXPECTED(other.columns_.size() == columns_.size(),
+                               "[Internal ERROR] the label stores to merge have different columns.");
+  for (size_t i = 0; i < columns_.size(); ++i) {
+    CHECK_FAIL_RETURN_UNEXPECTED(
+      columns_[i].name == other.columns_[i].name && columns_[i].type == other.columns_[i].type,
+      "[Internal ERROR] the label stores to merge have different columns.");
+  }
+  Materialize();
+  for (size_t i = 0; i < columns_.size(); ++i) {
+    auto &column = columns_[i];
+    const auto &other_column = other.columns_[i];
+    if (column.width == 0) {
+      uint64_t base = column.values.size();
+      uint64_t other_offset_count = other.OffsetCount(other_column);
+      column.offset.reserve(column.offset.size() + other_offset_count - 1);
+      for (uint64_t j = 1; j < other_offset_count; ++j) {
+        column.offset.push_back(base + other.Offset(other_column, j));
+      }
+    }
+    const uint8_t *other_values = other.Values(other_column);
+    (void)column.values.insert(column.values.end(), other_values, other_values + other.ValuesSize(other_column));
+  }
+  num_rows_ += other.num_rows_;
+  return Status::OK();
+}
+
+Status ShardLabelStore::GetColumn(int64_t row_id, const std::string &column_name, const unsigned char **data,
+                                  uint64_t *n_bytes) const {
+  RETURN_UNEXPECTED_IF_NULL(data);
+  RETURN_UNEXPECTED_IF_NULL(n_bytes);
+  CHECK_FAIL_RETURN_UNEXPECTED(row_id >= 0 && row_id < num_rows_,
+                               "[Internal ERROR] row id: " + std::to_string(row_id) + " is out of range [0, " +
+                                 std::to_string(num_rows_) + ").");
+  auto it = column_id_.find(column_name);
+  CHECK_FAIL_RETURN_UNEXPECTED(it != column_id_.end(),
+                               "[Internal ERROR] column: " + column_name + " is not in the label store.");
+  const auto &column = columns_[it->second];
+  if (column.width > 0) {
+    *data = Values(column) + row_id * column.width;
+    *n_bytes = column.width;
+  } else {
+    auto begin = Offset(column, static_cast<uint64_t>(row_id));
+    *data = Values(column) + begin;
+    *n_bytes = Offset(column, static_cast<uint64_t>(row_id) + 1) - begin;
+  }
+  return Status::OK();
+}
+
+Status ShardLabelStore::GetRowAsJson(int64_t row_id, json *row) const {
+  RETURN_UNEXPECTED_IF_NULL(row);
+  CHECK_FAIL_RETURN_UNEXPECTED(row_id >= 0 && row_id < num_rows_,
+                               "[Internal ERROR] row id: " + std::to_string(row_id) + " is out of range [0, " +
+                                 std::to_string(num_rows_) + ").");
+  for (const auto &column : columns_) {
+    const uint8_t *values = Values(column);
+    switch (column.type) {
+      case ColumnInt32:
+        (*row)[column.name] = LoadValue<int32_t>(values, row_id);
+        break;
+      case ColumnInt64:
+        (*row)[column.name] = LoadValue<int64_t>(values, row_id);
+        break;
+      case ColumnFloat32:
+        (*row)[column.name] = LoadValue<float>(values, row_id);
+        break;
+      case ColumnFloat64:
+        (*row)[column.name] = LoadValue<double>(values, row_id);
+        break;
+      default: {
+        auto begin = Offset(column, static_cast<uint64_t>(row_id));
+        auto end = Offset(column, static_cast<uint64_t>(row_id) + 1);
+        (*row)[column.name] = std::string(reinterpret_cast<const char *>(values) + begin, end - begin);
+        break;
+      }
+    }
+  }
+  return Status::OK();
+}
+
+uint64_t ShardLabelStore::MemoryUsage() const {
+  uint64_t usage = 0;
+  for (const auto &column : columns_) {
+    usage += ValuesSize(column) + OffsetCount(column) * sizeof(uint64_t);
+  }
+  return usage;
+}
+
+void ShardLabelStore::Serialize(std::vector<uint8_t> *buffer) const {
+  AppendValue(num_rows_, buffer);
+  for (const auto &column : columns_) {
+    AppendValue(static_cast<uint32_t>(column.type), buffer);
+    const uint8_t *values = Values(column);
+    AppendValue(ValuesSize(column), buffer);
+    (void)buffer->insert(buffer->end(), values, values + ValuesSize(column));
+    auto offset_count = OffsetCount(column);
+    AppendValue(offset_count, buffer);
+    for (uint64_t i = 0; i < offset_count; ++i) {
+      AppendValue(Offset(column, i), buffer);
+    }
+  }
+}
+
+Status ShardLabelStore::Deserialize(const uint8_t *data, uint64_t size, const std::shared_ptr<const void> &holder,
+                                    uint64_t *used) {
+  RETURN_UNEXPECTED_IF_NULL(data);
+  RETURN_UNEXPECTED_IF_NULL(holder);
+  RETURN_UNEXPECTED_IF_NULL(used);
+  uint64_t pos = 0;
+  int64_t num_rows = 0;
+  CHECK_FAIL_RETURN_UNEXPECTED(ReadValue(data, size, &pos, &num_rows) && num_rows >= 0,
+                               "[Internal ERROR] the serialized label store is truncated.");
+  std::vector<Column> columns = columns_;
+  for (auto &column : columns) {
+    uint32_t type = 0;
+    uint64_t values_size = 0;
+    uint64_t offset_count = 0;
+    CHECK_FAIL_RETURN_UNEXPECTED(ReadValue(data, size, &pos, &type) && type == static_cast<uint32_t>(column.type),
+                                 "[Internal ERROR] the type of column: " + column.name +
+                                   " in the serialized label store does not match.");
+    CHECK_FAIL_RETURN_UNEXPECTED(ReadValue(data, size, &pos, &values_size) && values_size <= size - pos,
+                                 "[Internal ERROR] the serialized label store is truncated.");
+    column.values.clear();
+    column.mapped_values = data + pos;
+    column.mapped_values_size = values_size;
+    pos += values_size;
+    CHECK_FAIL_RETURN_UNEXPECTED(
+      ReadValue(data, size, &pos, &offset_count) && offset_count <= (size - pos) / sizeof(uint64_t),
+      "[Internal ERROR] the serialized label store is truncated.");
+    column.offset.clear();
+    column.mapped_offset = data + pos;
+    column.mapped_offset_count = offset_count;
+    pos += offset_count * sizeof(uint64_t);
+    if (column.width > 0) {
+      CHECK_FAIL_RETURN_UNEXPECTED(values_size == static_cast<uint64_t>(num_rows) * column.width && offset_count == 0,
+                                   "[Internal ERROR] the size of column: " + column.name +
+                                     " in the serialized label store is invalid.");
+      continue;
+    }
+    CHECK_FAIL_RETURN_UNEXPECTED(offset_count == static_cast<uint64_t>(num_rows) + 1,
+                                 "[Internal ERROR] the size of column: " + column.name +
+                                   " in the serialized label store is invalid.");
+    // The offsets are checked once here, so that the reads of the rows don't need to.
+    uint64_t last = 0;
+    for (uint64_t i = 0; i < offset_count; ++i) {
+      uint64_t offset = 0;
+      (void)memcpy(&offset, column.mapped_offset + i * sizeof(uint64_t), sizeof(uint64_t));
+      CHECK_FAIL_RETURN_UNEXPECTED((i > 0 || offset == 0) && offset >= last && offset <= values_size &&
+                                     (i + 1 < offset_count || offset == values_size),
+                                   "[Internal ERROR] the offsets of column: " + column.name +
+                                     " in the serialized label store are invalid.");
+      last = offset;
+    }
+  }
+  columns_ = std::move(columns);
+  holder_ = holder;
+  num_rows_ = num_rows;
+  *used = pos;
+  return Status::OK();
+}
+}  // namespace mindrecord
+}  // namespace mindspore
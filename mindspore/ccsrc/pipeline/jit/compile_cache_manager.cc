@@ -28,6 +28,7 @@
 #include "utils/system/sha256.h"
 #include "include/common/utils/utils.h"
 #include "frontend/parallel/step_parallel.h"
+#include "backend/common/session/kernel_graph_cache.h"
 
 #if ((defined ENABLE_CPU) && (!defined _WIN32) && !defined(__APPLE__))
 #include "ps/ps_context.h"
@@ -41,6 +42,10 @@ namespace {
 constexpr char kCompileCacheSubDir[] = "graph_cache";
 constexpr char kCompileCacheFileName[] = "compile_cache";
 constexpr char kCompileCacheFileSuffix[] = ".mindir";
+constexpr char kBackendCompileCacheFileName[] = "backend_compile_cache";
+constexpr char kBackendCompileCacheFileSuffix[] = ".json";
+constexpr char kDepFilesHash[] = "dep_files_hash";
+constexpr char kKernelGraphCache[] = "kernel_graph_cache";
 constexpr char kDepFilesHashPath[] = "compile_dependency.hash";
 constexpr char kRoleServer[] = "server_";
 constexpr char kRolePServer[] = "pserver_";
@@ -98,6 +103,11 @@ std::string GetCompileCachePath(size_t idx) {
          kCompileCacheFileSuffix;
 }
 
+std::string GetBackendCompileCachePath(size_t idx) {
+  return GetCompileCacheDir() + "/" + GetRole() + kBackendCompileCacheFileName + "_" + std::to_string(idx) +
+         kBackendCompileCacheFileSuffix;
+}
+
 std::string GetDepFilesHashPath() {
   static const std::string dep_files_hash_path = GetCompileCacheDir() + "/" + GetRole() + kDepFilesHashPath;
   return dep_files_hash_path;
@@ -212,6 +222,58 @@ void CompileCacheManager::CacheFuncGraph(const FuncGraphPtr &fg, const FuncGraph
   }
 }
 
+void CompileCacheManager::LoadBackendCompileResult() const {
+  std::string backend_cache_path = GetBackendCompileCachePath(compile_cache_id_);
+  auto realpath = Common::CreatePrefixPath(backend_cache_path, true);
+  if (!realpath.has_value()) {
+    MS_LOG(ERROR) << "Get real path of file " << backend_cache_path << " failed.";
+    return;
+  }
+  std::ifstream input(realpath.value());
+  if (!input.is_open()) {
+    MS_LOG(WARNING) << "Open the backend compilation cache file " << realpath.value()
+                    << " failed. Execute all the backend compilation.";
+    return;
+  }
+  nlohmann::json cache_json;
+  try {
+    input >> cache_json;
+  } catch (const std::exception &e) {
+    MS_LOG(WARNING) << "Parse the backend compilation cache file " << realpath.value() << " failed: " << e.what();
+    return;
+  }
+  input.close();
+  // The backend compile results are reused only if they are generated from the same dependency files as the graph.
+  auto hash_iter = cache_json.find(kDepFilesHash);
+  if (hash_iter == cache_json.end() || !hash_iter->is_string() ||
+      hash_iter->get<std::string>() != compile_cache_dep_files_hash_) {
+    MS_LOG(WARNING) << "The backend compilation cache file " << realpath.value()
+                    << " is out of date. Execute all the backend compilation.";
+    return;
+  }
+  auto &kernel_graph_cache = session::KernelGraphCache::GetInstance();
+  if (!cache_json.contains(kKernelGraphCache) || !kernel_graph_cache.FromJson(cache_json[kKernelGraphCache])) {
+    MS_LOG(WARNING) << "Load the backend compilation cache file " << realpath.value() << " failed.";
+    return;
+  }
+  MS_LOG(INFO) << "Load the backend compilation cache: " << kernel_graph_cache.kernel_build_info_num()
+               << " kernel build infos and " << kernel_graph_cache.memory_plan_num() << " memory plans.";
+}
+
+void CompileCacheManager::CacheBackendCompileResult() const {
+  if (compile_cache_dep_files_hash_.empty()) {
+    MS_LOG(WARNING) << "The dependency files hash is empty, skip caching the backend compile results.";
+    return;
+  }
+  nlohmann::json cache_json;
+  cache_json[kDepFilesHash] = compile_cache_dep_files_hash_;
+  cache_json[kKernelGraphCache] = session::KernelGraphCache::GetInstance().ToJson();
+  std::string backend_cache_path = GetBackendCompileCachePath(compile_cache_id_);
+  if (!Common::SaveStringToFile(backend_cache_path, cache_json.dump())) {
+    MS_LOG(ERROR) << "Failed to cache the backend compile results to " << backend_cache_path;
+  }
+}
+
 void CompileCacheManager::InitCompileCacheHash(const py::list &compile_cache_dep_files) {
   compile_cache_dep_files_hash_ = GetCompileDepFilesHash(compile_cache_dep_files);
 }
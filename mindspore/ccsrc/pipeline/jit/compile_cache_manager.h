@@ -44,6 +44,10 @@ class CompileCacheManager {
                                   const std::string &queue_name);
   // Export the func_graph to mindir file.
   void CacheFuncGraph(const FuncGraphPtr &fg, const FuncGraphPtr &layout_fg) const;
+  // Load the cached backend compile results into the kernel graph cache, only for the loaded cached func_graph.
+  void LoadBackendCompileResult() const;
+  // Export the backend compile results in the kernel graph cache, together with the dependency files hash.
+  void CacheBackendCompileResult() const;
 
   const LayoutMap &layout_map() const { return layout_map_; }
 
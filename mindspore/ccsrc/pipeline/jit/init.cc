@@ -439,6 +439,14 @@ PYBIND11_MODULE(_c_expression, m) {
     .def("set_cache_enable", &PSContext::set_cache_enable, "Set ps mode cache enable or not.")
     .def("cache_enable", &PSContext::cache_enable, "Get ps mode cache enable or not.")
     .def("set_rank_id", &PSContext::set_rank_id, "Set rank id for worker on ps mode.")
+    .def("set_cache_eviction_policy", &PSContext::set_cache_eviction_policy,
+         "Set the eviction policy of the embedding cache.")
+    .def("cache_eviction_policy", &PSContext::cache_eviction_policy, "Get the eviction policy of the embedding cache.")
+    .def("set_cache_admission_threshold", &PSContext::set_cache_admission_threshold,
+         "Set the admission threshold of the embedding cache.")
+    .def("cache_admission_threshold", &PSContext::cache_admission_threshold,
+         "Get the admission threshold of the embedding cache.")
+    .def("cache_metrics", &PSContext::cache_metrics, "Get the hit rates and swap sizes of the embedding cache.")
     .def("set_server_mode", &PSContext::set_server_mode, "Set server mode.")
     .def("server_mode", &PSContext::server_mode, "Get server mode.")
     .def("set_ms_role", &PSContext::set_ms_role, "Set role for this process.")
@@ -964,6 +964,20 @@ void CacheValidateFuncGraph(const ResourcePtr &resource) {
 #endif
 }
 
+void CacheBackendCompileResult(const ResourcePtr &resource) {
+  if (!resource->EnableCompileCache()) {
+    return;
+  }
+#ifdef ENABLE_PROFILE
+  double t1 = GetTime();
+#endif
+  resource->CacheBackendCompileResult();
+#ifdef ENABLE_PROFILE
+  double t2 = GetTime();
+  MsProfile::StatTime("SaveCacheBackendCompileResult", t2 - t1);
+#endif
+}
+
 void CheckInterpretNodeLineInfos() {
   auto &line_infos = InterpretNodeRecorder::GetInstance().LineInfos();
   if (line_infos.empty()) {
@@ -1061,6 +1075,9 @@ void Pipeline::Run() {
       };
       if (action.first == "task_emit") {
         SetLoopCount(resource_);
+        if (result) {
+          CacheBackendCompileResult(resource_);
+        }
       } else if (action.first == "validate") {
         CheckInterpretNodeLineInfos();
         CacheValidateFuncGraph(resource_);
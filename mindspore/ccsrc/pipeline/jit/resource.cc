@@ -24,6 +24,7 @@
 #include "frontend/operator/ops.h"
 #include "frontend/optimizer/ad/dfunctor.h"
 #include "include/common/utils/parallel_context.h"
+#include "backend/common/session/kernel_graph_cache.h"
 
 namespace mindspore {
 // namespace to support opmap definition
@@ -363,12 +364,16 @@ void Resource::GetCompileCacheResource(const py::list &compile_cache_dep_files,
                                        bool *compile_cache_consistent) {
   compile_cache_manager_ = std::make_shared<CompileCacheManager>(compile_cache_id);
   compile_cache_manager_->InitParallelGroupCkptSaveFile();
+  // The backend compile results are recorded to be cached with the graph, or reused if the cache is loaded. It's
+  // disabled again when the resource is cleaned after compiling.
+  session::KernelGraphCache::GetInstance().set_enable(true);
+  // The hash is needed to cache the backend compile results even if the frontend cache is not consistent.
+  compile_cache_manager_->InitCompileCacheHash(compile_cache_dep_files);
   MS_EXCEPTION_IF_NULL(compile_cache_consistent);
   if (!*compile_cache_consistent) {
     MS_LOG(WARNING) << "Check the consistency of dependency files hash failed. Execute all the compilation actions.";
     return;
   }
-  compile_cache_manager_->InitCompileCacheHash(compile_cache_dep_files);
   *compile_cache_consistent = compile_cache_manager_->CheckDepFilesHashConsistency();
   if (!*compile_cache_consistent) {
     MS_LOG(WARNING) << "Check the consistency of dependency files hash failed. Execute all the compilation actions.";
@@ -376,6 +381,9 @@ void Resource::GetCompileCacheResource(const py::list &compile_cache_dep_files,
   }
   func_graph_ = compile_cache_manager_->GetCachedFuncGraph(manager_, weights, queue_name);
   layout_map_ = compile_cache_manager_->layout_map();
+  if (func_graph_ != nullptr) {
+    compile_cache_manager_->LoadBackendCompileResult();
+  }
 }
 
 void Resource::CacheFuncGraph() const {
@@ -388,6 +396,11 @@ void Resource::CacheFuncGraph() const {
   compile_cache_manager_->CacheFuncGraph(func_graph_, layout_fg);
 }
 
+void Resource::CacheBackendCompileResult() const {
+  MS_EXCEPTION_IF_NULL(compile_cache_manager_);
+  compile_cache_manager_->CacheBackendCompileResult();
+}
+
 void Resource::Clean() {
   // AbstractTensor->elements() will be saved in AbstractBasePtrList
   args_spec_.clear();
@@ -402,6 +415,12 @@ void Resource::Clean() {
   parse::data_converter::ClearObjectCache();
   parse::Parser::CleanParserResource();
   trace::ClearTraceStack();
+  // The backend compile results are only recorded and reused while compiling the graph with the compile cache.
+  if (compile_cache_manager_ != nullptr) {
+    auto &kernel_graph_cache = session::KernelGraphCache::GetInstance();
+    kernel_graph_cache.set_enable(false);
+    kernel_graph_cache.Clear();
+  }
   is_cleaned_ = true;
 }
 
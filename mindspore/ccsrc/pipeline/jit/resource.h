@@ -95,6 +95,7 @@ class Resource : public ResourceBase {
   void GetCompileCacheResource(const py::list &compile_cache_dep_files, const py::dict &weights,
                                const std::string &queue_name, size_t compile_cache_id, bool *compile_cache_consistent);
   void CacheFuncGraph() const;
+  void CacheBackendCompileResult() const;
   bool EnableCompileCache() const { return compile_cache_manager_ != nullptr; }
 
   // Reclaim resource and clear the cache.
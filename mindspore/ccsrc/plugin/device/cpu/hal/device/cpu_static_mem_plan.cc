@@ -0,0 +1,326 @@
+/**
+ * Copyright 2022 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "plugin/device/cpu/hal/device/cpu_static_mem_plan.h"
+#include <algorithm>
+#include <map>
+#include <set>
+#include <sstream>
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include "backend/common/session/anf_runtime_algorithm.h"
+#include "backend/common/session/kernel_graph_cache.h"
+#include "include/common/utils/anfalgo.h"
+#include "runtime/device/memory_manager.h"
+#include "utils/system/sha256.h"
+
+namespace mindspore {
+namespace device {
+namespace cpu {
+namespace {
+constexpr size_t kBitsPerWord = 64;
+
+void SetBit(std::vector<uint64_t> *bits, size_t index) {
+  MS_EXCEPTION_IF_NULL(bits);
+  (*bits)[index / kBitsPerWord] |= (1ULL << (index % kBitsPerWord));
+}
+
+void UnionBits(std::vector<uint64_t> *bits, const std::vector<uint64_t> &other) {
+  MS_EXCEPTION_IF_NULL(bits);
+  for (size_t i = 0; i < bits->size(); ++i) {
+    (*bits)[i] |= other[i];
+  }
+}
+
+void IntersectBits(std::vector<uint64_t> *bits, const std::vector<uint64_t> &other) {
+  MS_EXCEPTION_IF_NULL(bits);
+  for (size_t i = 0; i < bits->size(); ++i) {
+    (*bits)[i] &= other[i];
+  }
+}
+
+bool IsSubset(const std::vector<uint64_t> &bits, const std::vector<uint64_t> &other) {
+  for (size_t i = 0; i < bits.size(); ++i) {
+    if ((bits[i] & ~other[i]) != 0) {
+      return false;
+    }
+  }
+  return true;
+}
+
+size_t AlignMemorySize(size_t size) { return (size + kMemAlignSize - 1) / kMemAlignSize * kMemAlignSize; }
+
+void InsertOutputAddress(const AnfNodePtr &node, size_t index, std::set<DeviceAddress *> *addresses) {
+  MS_EXCEPTION_IF_NULL(node);
+  MS_EXCEPTION_IF_NULL(addresses);
+  if (AnfAlgo::OutputAddrExist(node, index, false)) {
+    (void)addresses->insert(AnfAlgo::GetMutableOutputAddr(node, index, false).get());
+  }
+}
+
+// The device addresses which are visible out of the kernel actors or shared by several kernels keep the dynamic
+// allocation: the graph outputs, the ref nodes, the summary nodes and everything used by the communication kernels
+// and the inplace kernels.
+std::set<DeviceAddress *> FetchUnplannableAddresses(const session::KernelGraph *graph) {
+  MS_EXCEPTION_IF_NULL(graph);
+  std::set<DeviceAddress *> addresses;
+  for (const auto &output_with_index : common::AnfAlgo::GetAllOutputWithIndex(graph->output())) {
+    InsertOutputAddress(output_with_index.first, output_with_index.second, &addresses);
+  }
+  for (const auto &ref_pair : graph->GetRefMap()) {
+    InsertOutputAddress(ref_pair.first.first, ref_pair.first.second, &addresses);
+    InsertOutputAddress(ref_pair.second.first, ref_pair.second.second, &addresses);
+  }
+  for (const auto &summary_node : graph->summary_nodes()) {
+    InsertOutputAddress(summary_node.second.first, IntToSize(summary_node.second.second), &addresses);
+  }
+
+  for (const auto &kernel : graph->execution_order()) {
+    MS_EXCEPTION_IF_NULL(kernel);
+    if (!common::AnfAlgo::IsCommunicationOp(kernel) && !common::AnfAlgo::IsInplaceNode(kernel, "inplace_algo") &&
+        !common::AnfAlgo::IsInplaceNode(kernel, "skip")) {
+      continue;
+    }
+    size_t input_num = common::AnfAlgo::GetInputTensorNum(kernel);
+    for (size_t i = 0; i < input_num; ++i) {
+      auto kernel_with_index = common::AnfAlgo::GetPrevNodeOutput(kernel, i, false);
+      InsertOutputAddress(kernel_with_index.first, kernel_with_index.second, &addresses);
+    }
+    auto kernel_info = dynamic_cast<KernelInfo *>(kernel->kernel_info());
+    MS_EXCEPTION_IF_NULL(kernel_info);
+    for (const auto &address : kernel_info->output_address_list()) {
+      (void)addresses.insert(address.get());
+    }
+    for (const auto &address : kernel_info->workspace_address_list()) {
+      (void)addresses.insert(address.get());
+    }
+  }
+  return addresses;
+}
+}  // namespace
+
+bool CPUStaticMemPlan::IsGraphSupported(const session::KernelGraph *graph) {
+  MS_EXCEPTION_IF_NULL(graph);
+  if (graph->is_dynamic_shape() || graph->execution_order().empty()) {
+    return false;
+  }
+  const auto &kernels = graph->execution_order();
+  return std::none_of(kernels.begin(), kernels.end(),
+                      [](const CNodePtr &kernel) { return common::AnfAlgo::IsDynamicShape(kernel); });
+}
+
+bool CPUStaticMemPlan::IsDisjointLifetime(const MemBlock &lhs, const MemBlock &rhs) {
+  return IsSubset(lhs.users, rhs.common_ancestors) || IsSubset(rhs.users, lhs.common_ancestors);
+}
+
+size_t CPUStaticMemPlan::MemPlan(const session::KernelGraph *graph) {
+  MS_EXCEPTION_IF_NULL(graph);
+  mem_blocks_.clear();
+  const auto &kernels = graph->execution_order();
+  const size_t kernel_num = kernels.size();
+  const size_t word_num = (kernel_num + kBitsPerWord - 1) / kBitsPerWord;
+  std::unordered_map<const AnfNode *, size_t> kernel_indexes;
+  for (size_t i = 0; i < kernel_num; ++i) {
+    kernel_indexes[kernels[i].get()] = i;
+  }
+  const auto &unplannable_addresses = FetchUnplannableAddresses(graph);
+
+  // Collect the blocks from the outputs and workspaces, the address written by several kernels is not planned.
+  std::map<DeviceAddress *, size_t> block_indexes;
+  std::set<DeviceAddress *> shared_addresses;
+  auto add_block = [&](const DeviceAddressPtr &address, size_t kernel_index) {
+    MS_EXCEPTION_IF_NULL(address);
+    if ((address->GetPtr() != nullptr) || (address->GetSize() == 0) || address->is_ptr_persisted() ||
+        (unplannable_addresses.count(address.get()) > 0)) {
+      return;
+    }
+    if (block_indexes.count(address.get()) > 0) {
+      (void)shared_addresses.insert(address.get());
+      return;
+    }
+    block_indexes[address.get()] = mem_blocks_.size();
+    MemBlock block;
+    block.address = address;
+    block.size = AlignMemorySize(address->GetSize());
+    block.users.resize(word_num, 0);
+    SetBit(&block.users, kernel_index);
+    (void)mem_blocks_.emplace_back(std::move(block));
+  };
+
+  std::vector<std::vector<size_t>> input_kernels(kernel_num);
+  for (size_t i = 0; i < kernel_num; ++i) {
+    const auto &kernel = kernels[i];
+    MS_EXCEPTION_IF_NULL(kernel);
+    size_t input_num = common::AnfAlgo::GetInputTensorNum(kernel);
+    for (size_t j = 0; j < input_num; ++j) {
+      auto kernel_with_index = common::AnfAlgo::GetPrevNodeOutput(kernel, j, false);
+      MS_EXCEPTION_IF_NULL(kernel_with_index.first);
+      auto iter = kernel_indexes.find(kernel_with_index.first.get());
+      if ((iter != kernel_indexes.end()) && (iter->second < i)) {
+        (void)input_kernels[i].emplace_back(iter->second);
+      }
+      if (!AnfAlgo::OutputAddrExist(kernel_with_index.first, kernel_with_index.second, false)) {
+        continue;
+      }
+      const auto &input_address =
+        AnfAlgo::GetMutableOutputAddr(kernel_with_index.first, kernel_with_index.second, false);
+      auto block_iter = block_indexes.find(input_address.get());
+      if (block_iter != block_indexes.end()) {
+        SetBit(&mem_blocks_[block_iter->second].users, i);
+      }
+    }
+
+    auto kernel_info = dynamic_cast<KernelInfo *>(kernel->kernel_info());
+    MS_EXCEPTION_IF_NULL(kernel_info);
+    for (const auto &address : kernel_info->output_address_list()) {
+      add_block(address, i);
+    }
+    for (const auto &address : kernel_info->workspace_address_list()) {
+      add_block(address, i);
+    }
+  }
+
+  if (!shared_addresses.empty()) {
+    (void)mem_blocks_.erase(std::remove_if(mem_blocks_.begin(), mem_blocks_.end(),
+                                           [&shared_addresses](const MemBlock &block) {
+                                             return shared_addresses.count(block.address.get()) > 0;
+                                           }),
+                            mem_blocks_.end());
+  }
+
+  // The plan only depends on the data dependency of kernels and the users and sizes of blocks, so it is reused from
+  // the kernel graph cache if a graph of the same structure was planned before.
+  auto &kernel_graph_cache = session::KernelGraphCache::GetInstance();
+  std::vector<size_t> block_sizes;
+  std::string signature;
+  std::vector<size_t> cached_offsets;
+  if (kernel_graph_cache.enable()) {
+    for (const auto &block : mem_blocks_) {
+      (void)block_sizes.emplace_back(block.size);
+    }
+    signature = GetPlanSignature(input_kernels);
+  }
+  if (kernel_graph_cache.enable() && kernel_graph_cache.FetchMemoryPlan(signature, block_sizes, &cached_offsets)) {
+    size_t total_size = 0;
+    for (size_t i = 0; i < mem_blocks_.size(); ++i) {
+      mem_blocks_[i].offset = cached_offsets[i];
+      total_size = std::max(total_size, cached_offsets[i] + mem_blocks_[i].size);
+    }
+    MS_LOG(INFO) << "The static memory plan of graph " << graph->graph_id() << " is reused from the cache, which binds "
+                 << mem_blocks_.size() << " device addresses to the arena of size " << total_size;
+    return total_size;
+  }
+
+  // The execution order is a topological order of the data dependency, so the ancestors of the input kernels are
+  // ready when visiting a kernel.
+  std::vector<KernelBitset> ancestors(kernel_num, KernelBitset(word_num, 0));
+  for (size_t i = 0; i < kernel_num; ++i) {
+    for (auto input_kernel : input_kernels[i]) {
+      UnionBits(&ancestors[i], ancestors[input_kernel]);
+      SetBit(&ancestors[i], input_kernel);
+    }
+  }
+  for (auto &block : mem_blocks_) {
+    block.common_ancestors.assign(word_num, ~0ULL);
+    for (size_t i = 0; i < kernel_num; ++i) {
+      if ((block.users[i / kBitsPerWord] & (1ULL << (i % kBitsPerWord))) != 0) {
+        IntersectBits(&block.common_ancestors, ancestors[i]);
+      }
+    }
+  }
+
+  // Place the bigger blocks first, each at the lowest offset not overlapping the placed blocks it lives together with.
+  std::vector<size_t> place_order(mem_blocks_.size());
+  for (size_t i = 0; i < place_order.size(); ++i) {
+    place_order[i] = i;
+  }
+  std::stable_sort(place_order.begin(), place_order.end(),
+                   [this](size_t lhs, size_t rhs) { return mem_blocks_[lhs].size > mem_blocks_[rhs].size; });
+  std::vector<size_t> placed_blocks;
+  size_t total_size = 0;
+  size_t unreused_size = 0;
+  for (auto block_index : place_order) {
+    auto &block = mem_blocks_[block_index];
+    std::vector<std::pair<size_t, size_t>> conflict_ranges;
+    for (auto placed_index : placed_blocks) {
+      const auto &placed_block = mem_blocks_[placed_index];
+      if (!IsDisjointLifetime(block, placed_block)) {
+        (void)conflict_ranges.emplace_back(placed_block.offset, placed_block.offset + placed_block.size);
+      }
+    }
+    std::sort(conflict_ranges.begin(), conflict_ranges.end());
+    size_t offset = 0;
+    for (const auto &range : conflict_ranges) {
+      if (offset + block.size <= range.first) {
+        break;
+      }
+      offset = std::max(offset, range.second);
+    }
+    block.offset = offset;
+    total_size = std::max(total_size, offset + block.size);
+    unreused_size += block.size;
+    (void)placed_blocks.emplace_back(block_index);
+  }
+
+  MS_LOG(INFO) << "The static memory plan of graph " << graph->graph_id() << " binds " << mem_blocks_.size()
+               << " device addresses to the arena of size " << total_size << ", the size without reuse is "
+               << unreused_size;
+  if (kernel_graph_cache.enable()) {
+    std::vector<size_t> offsets;
+    for (const auto &block : mem_blocks_) {
+      (void)offsets.emplace_back(block.offset);
+    }
+    kernel_graph_cache.RecordMemoryPlan(signature, block_sizes, offsets);
+  }
+  return total_size;
+}
+
+std::string CPUStaticMemPlan::GetPlanSignature(const std::vector<std::vector<size_t>> &input_kernels) const {
+  std::ostringstream buffer;
+  for (const auto &inputs : input_kernels) {
+    for (auto input_kernel : inputs) {
+      buffer << input_kernel << ",";
+    }
+    buffer << ";";
+  }
+  for (const auto &block : mem_blocks_) {
+    buffer << block.size << ":";
+    for (auto word : block.users) {
+      buffer << word << ",";
+    }
+    buffer << ";";
+  }
+  // The signature is persisted by the compile cache, so it uses the hash which is stable across the builds.
+  return "cpu_" + std::to_string(input_kernels.size()) + "_" + system::sha256::GetHashFromString(buffer.str());
+}
+
+void CPUStaticMemPlan::MemAssign(uint8_t *base_ptr) const {
+  MS_EXCEPTION_IF_NULL(base_ptr);
+  for (const auto &block : mem_blocks_) {
+    const auto &address = block.address;
+    MS_EXCEPTION_IF_NULL(address);
+    address->set_ptr(base_ptr + block.offset);
+    address->set_from_mem_pool(false);
+    // The planned memory can't be freed or replaced by the actors, and the max reference count makes the memory
+    // free request of the address a no-op.
+    address->set_is_ptr_persisted(true);
+    address->set_original_ref_count(SIZE_MAX);
+    address->ResetRefCount();
+  }
+}
+}  // namespace cpu
+}  // namespace device
+}  // namespace mindspore
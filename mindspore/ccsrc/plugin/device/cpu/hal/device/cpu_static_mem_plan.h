@@ -0,0 +1,71 @@
+/**
+ * Copyright 2022 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef MINDSPORE_CCSRC_RUNTIME_DEVICE_CPU_CPU_STATIC_MEM_PLAN_H_
+#define MINDSPORE_CCSRC_RUNTIME_DEVICE_CPU_CPU_STATIC_MEM_PLAN_H_
+
+#include <string>
+#include <vector>
+#include "backend/common/session/kernel_graph.h"
+#include "runtime/device/device_address.h"
+
+namespace mindspore {
+namespace device {
+namespace cpu {
+// The ahead of time memory plan of the static shape graph in the actor runtime. The outputs and workspaces of kernels
+// are bound to the offsets of one contiguous arena when compiling graph, so running the graph needs no memory
+// allocation. The kernel actors may launch concurrently, so two device addresses share memory only when all the
+// kernels using one of them are the ancestors of all the kernels using the other in the data dependency of graph,
+// instead of the lifetime in the execution order which the memory reuse of the graph sink uses.
+class CPUStaticMemPlan {
+ public:
+  CPUStaticMemPlan() = default;
+  ~CPUStaticMemPlan() = default;
+
+  // Whether the memory of graph can be planned, the graph of dynamic shape is not supported.
+  static bool IsGraphSupported(const session::KernelGraph *graph);
+
+  // Compute the offsets of the device addresses in the arena and return the size of the arena.
+  size_t MemPlan(const session::KernelGraph *graph);
+  // Bind the planned device addresses to the arena, which keep the memory until the graph is destroyed.
+  void MemAssign(uint8_t *base_ptr) const;
+
+  size_t planned_address_num() const { return mem_blocks_.size(); }
+
+ private:
+  using KernelBitset = std::vector<uint64_t>;
+  struct MemBlock {
+    DeviceAddressPtr address{nullptr};
+    size_t size{0};
+    size_t offset{0};
+    // The indexes in the execution order of the kernels using the address.
+    KernelBitset users;
+    // The indexes of the kernels which are the ancestors of all the users.
+    KernelBitset common_ancestors;
+  };
+
+  // Whether the memory of two blocks can overlap, which needs all the users of one block happen before the other.
+  static bool IsDisjointLifetime(const MemBlock &lhs, const MemBlock &rhs);
+  // The key of the plan in the kernel graph cache, computed from the input kernels of every kernel and the blocks.
+  std::string GetPlanSignature(const std::vector<std::vector<size_t>> &input_kernels) const;
+
+  std::vector<MemBlock> mem_blocks_;
+};
+}  // namespace cpu
+}  // namespace device
+}  // namespace mindspore
+
+#endif  // MINDSPORE_CCSRC_RUNTIME_DEVICE_CPU_CPU_STATIC_MEM_PLAN_H_
@@ -16,15 +16,21 @@
 
 #include "plugin/device/cpu/hal/hardware/allreduce_impl.h"
 
+#include <algorithm>
 #include <vector>
 #include <functional>
 #include <memory>
+#include "abstract/utils.h"
+#include "plugin/device/cpu/hal/hardware/collective_reduce_impl.h"
 
 namespace mindspore {
 namespace device {
 namespace cpu {
 namespace {
 constexpr size_t kWaitTimeout = 30;
+// The size in bytes of the sub-chunks of the ring. The smaller sub-chunk makes the pipeline fill faster, but each
+// message has the fixed cost of the network.
+constexpr size_t kRingSubChunkSize = 256 * 1024;
 }  // namespace
 
 AllReduceLauncher::AllReduceLauncher() {
@@ -39,151 +45,206 @@ AllReduceLauncher::AllReduceLauncher() {
   MS_EXCEPTION_IF_NULL(cluster_ctx);
   node_role_ = cluster_ctx->node_role();
   rank_size_ = IntToSize(cluster_ctx->node_num(cluster_ctx->node_role()));
+  for (size_t i = 0; i < rank_size_; i++) {
+    all_ranks_.push_back(SizeToUint(i));
+  }
+}
+
+bool AllReduceLauncher::Execute(const void *input_data, void *const output_data, size_t data_size,
+                                TypeId data_type) const {
+  return Execute(input_data, output_data, data_size, data_type, all_ranks_);
 }
 
-bool AllReduceLauncher::Execute(const void *input_data, void *const output_data, size_t data_size) const {
+bool AllReduceLauncher::Execute(const void *input_data, void *const output_data, size_t data_size, TypeId data_type,
+                                const std::vector<uint32_t> &ranks) const {
   MS_EXCEPTION_IF_NULL(input_data);
   MS_EXCEPTION_IF_NULL(output_data);
   // If node is scheduler, don't need to participate in the reduction.
   if (node_role_ == distributed::kEnvRoleOfScheduler) {
     return true;
   }
-  size_t data_num = data_size / sizeof(float);
-  if (data_num < rank_size_) {
+  if (GetSumIntoFunc(data_type) == nullptr) {
+    MS_LOG(ERROR) << "AllReduceLauncher doesn't support the data type " << TypeIdLabel(data_type);
+    return false;
+  }
+  if (std::find(ranks.begin(), ranks.end(), rank_id_) == ranks.end()) {
+    MS_LOG(ERROR) << "The rank " << rank_id_ << " is not in the ranks of AllReduce: " << ranks;
+    return false;
+  }
+  if (ranks.size() == 1) {
+    return output_data == input_data || memcpy_s(output_data, data_size, input_data, data_size) == EOK;
+  }
+  size_t data_num = data_size / abstract::TypeIdSize(data_type);
+  if (data_num < ranks.size()) {
     MS_LOG(DEBUG) << "AllReduceLauncher executes ReduceBroadcastAllReduce algorithm on the rank " << rank_id_;
-    return ReduceBroadcastAllReduce(input_data, output_data, data_size);
+    return ReduceBroadcastAllReduce(input_data, output_data, data_size, data_type, ranks);
   }
   // If the data number is not less than the node number, the RingAllReduce algorithm is used.
   MS_LOG(DEBUG) << "AllReduceLauncher executes RingAllReduce algorithm on the rank " << rank_id_;
-  return RingAllReduce(input_data, output_data, data_size);
+  return RingAllReduce(input_data, output_data, data_size, data_type, ranks);
 }
 
-bool AllReduceLauncher::RingAllReduce(const void *input_data, void *const output_data, size_t data_size) const {
-  int memcpy_ret = memcpy_s(output_data, data_size, input_data, data_size);
-  if (memcpy_ret != EOK) {
-    MS_LOG(ERROR) << "RingAllReduce memcpy_s input_data error, errorno(" << memcpy_ret << ")";
-    return false;
+bool AllReduceLauncher::RingAllReduce(const void *input_data, void *const output_data, size_t data_size,
+                                      TypeId data_type, const std::vector<uint32_t> &ranks) const {
+  int memcpy_ret = EOK;
+  if (output_data != input_data) {
+    memcpy_ret = memcpy_s(output_data, data_size, input_data, data_size);
+    if (memcpy_ret != EOK) {
+      MS_LOG(ERROR) << "RingAllReduce memcpy_s input_data error, errorno(" << memcpy_ret << ")";
+      return false;
+    }
   }
-  size_t data_num = data_size / sizeof(float);
-  size_t chunk_size = data_num / rank_size_;
-  size_t remainder_size = data_num % rank_size_;
-  std::vector<size_t> chunk_sizes(rank_size_, chunk_size);
+  // With a single rank the output is the input, and the chunk sent to itself would never be received, which is left in
+  // the received data of the node.
+  size_t rank_size = ranks.size();
+  if (rank_size <= 1) {
+    return true;
+  }
+  // The position of this rank in the ring.
+  size_t rank_index = LongToSize(std::find(ranks.begin(), ranks.end(), rank_id_) - ranks.begin());
+  const auto &sum_into = GetSumIntoFunc(data_type);
+  MS_EXCEPTION_IF_NULL(sum_into);
+  size_t type_size = abstract::TypeIdSize(data_type);
+  size_t data_num = data_size / type_size;
+  size_t chunk_size = data_num / rank_size;
+  size_t remainder_size = data_num % rank_size;
+  std::vector<size_t> chunk_sizes(rank_size, chunk_size);
   // The rest of the data should be assigned to each chunk.
   for (size_t i = 0; i < remainder_size; i++) {
     chunk_sizes[i]++;
   }
   // Store offsets to get every data chunk's address.
-  std::vector<size_t> chunk_offset;
-  for (size_t i = 0; i < rank_size_; i++) {
-    size_t ofs =
-      std::accumulate(chunk_sizes.begin(), chunk_sizes.begin() + SizeToLong(i), size_t(0), std::plus<size_t>());
-    chunk_offset.push_back(ofs);
+  std::vector<size_t> chunk_offset(rank_size, 0);
+  for (size_t i = 1; i < rank_size; i++) {
+    chunk_offset[i] = chunk_offset[i - 1] + chunk_sizes[i - 1];
   }
+  size_t sub_chunk_size = std::max(kRingSubChunkSize / type_size, size_t(1));
 
-  auto *output_buff = reinterpret_cast<float *>(output_data);
-  uint32_t send_to_rank = SizeToUint((rank_id_ + 1) % rank_size_);
-  uint32_t rec_from_rank = SizeToUint((rank_id_ - 1 + rank_size_) % rank_size_);
-  MS_LOG(DEBUG) << "AllReduce data_num:" << data_num << ", rank_size_:" << rank_size_ << ", rank_id_:" << rank_id_
+  auto *output_buff = static_cast<uint8_t *>(output_data);
+  uint32_t send_to_rank = ranks[(rank_index + 1) % rank_size];
+  uint32_t rec_from_rank = ranks[(rank_index - 1 + rank_size) % rank_size];
+  MS_LOG(DEBUG) << "AllReduce data_num:" << data_num << ", rank_size:" << rank_size << ", rank_index:" << rank_index
                 << ", chunk_size:" << chunk_size << ", remainder_size:" << remainder_size
-                << ", chunk_sizes:" << chunk_sizes << ", send_to_rank:" << send_to_rank
+                << ", sub_chunk_size:" << sub_chunk_size << ", send_to_rank:" << send_to_rank
                 << ", rec_from_rank:" << rec_from_rank;
 
-  // Ring ReduceScatter.
-  MS_LOG(DEBUG) << "Start Ring ReduceScatter.";
-  for (size_t i = 0; i < rank_size_ - 1; i++) {
-    // Step 1: Async send data to next rank.
-    size_t send_chunk_index = (rank_id_ - i + rank_size_) % rank_size_;
-    float *send_chunk = output_buff + chunk_offset[send_chunk_index];
-    auto send_req_id = abs_node_->CollectiveSendAsync(ps::core::NodeRole::WORKER, send_to_rank, send_chunk,
-                                                      chunk_sizes[send_chunk_index] * sizeof(float));
-    // Step 2: Async receive data to next rank and wait until it's done.
-    size_t rec_chunk_index = (rank_id_ - i - 1 + rank_size_) % rank_size_;
-    float *rec_chunk = output_buff + chunk_offset[rec_chunk_index];
-    MS_LOG(DEBUG) << "Ring ReduceScatter send_to_rank:" << send_to_rank << ", rec_from_rank:" << rec_from_rank
-                  << ", send data_num:" << chunk_sizes[send_chunk_index]
-                  << ", rec data_num:" << chunk_sizes[rec_chunk_index] << ", iteration:" << i;
-
-    std::shared_ptr<std::vector<unsigned char>> rec_ptr = nullptr;
-    auto rec_req_id = abs_node_->CollectiveReceiveAsync(ps::core::NodeRole::WORKER, rec_from_rank, &rec_ptr);
-    if (!abs_node_->CollectiveWait(rec_req_id, kWaitTimeout)) {
-      MS_LOG(ERROR) << "Ring ReduceScatter wait receiving" << rec_req_id << " failed.";
-      return false;
-    }
-    // Step 3: Reduce the data, so we can overlap the time cost of send.
-    const auto *tmp_data = reinterpret_cast<float *>(rec_ptr->data());
-    for (size_t j = 0; j < chunk_sizes[rec_chunk_index]; j++) {
-      rec_chunk[j] += tmp_data[j];
-    }
-    // Step 4: Wait until send is done.
-    if (!abs_node_->Wait(send_req_id, kWaitTimeout)) {
-      MS_LOG(ERROR) << "Ring ReduceScatter wait sending " << send_req_id << " failed.";
-      return false;
+  // The data is copied into the send buffer of the connection once the send returns. The sends of a step are waited
+  // at the beginning of the next step, so the sends of at most one step are in flight.
+  std::vector<uint64_t> send_req_ids;
+  auto send_sub_chunk = [&](size_t chunk_index, size_t begin, size_t num) {
+    auto send_data = output_buff + (chunk_offset[chunk_index] + begin) * type_size;
+    (void)send_req_ids.emplace_back(
+      abs_node_->CollectiveSendAsync(ps::core::NodeRole::WORKER, send_to_rank, send_data, num * type_size));
+  };
+  auto wait_sends = [&]() {
+    for (auto send_req_id : send_req_ids) {
+      if (!abs_node_->Wait(send_req_id, kWaitTimeout)) {
+        MS_LOG(ERROR) << "RingAllReduce wait sending " << send_req_id << " failed.";
+        return false;
+      }
     }
-  }
-  MS_LOG(DEBUG) << "End Ring ReduceScatter.";
+    send_req_ids.clear();
+    return true;
+  };
 
-  // Ring AllGather.
-  MS_LOG(DEBUG) << "Start Ring AllGather.";
-  for (size_t i = 0; i < rank_size_ - 1; i++) {
-    size_t send_chunk_index = (rank_id_ - i + 1 + rank_size_) % rank_size_;
-    float *send_chunk = output_buff + chunk_offset[send_chunk_index];
-    auto send_req_id = abs_node_->CollectiveSendAsync(ps::core::NodeRole::WORKER, send_to_rank, send_chunk,
-                                                      chunk_sizes[send_chunk_index] * sizeof(float));
-    size_t rec_chunk_index = (rank_id_ - i + rank_size_) % rank_size_;
-    float *rec_chunk = output_buff + chunk_offset[rec_chunk_index];
-    MS_LOG(DEBUG) << "Ring AllGather send_to_rank:" << send_to_rank << ", rec_from_rank:" << rec_from_rank
-                  << ", send data_num:" << chunk_sizes[send_chunk_index]
-                  << ", rec data_num:" << chunk_sizes[rec_chunk_index] << ", iteration:" << i;
+  // The first rank_size - 1 steps are the ReduceScatter, and the rest are the AllGather. Each step receives one chunk
+  // from the previous rank sub-chunk by sub-chunk, and every received sub-chunk is sent to the next rank right after it
+  // is reduced or copied, except in the last step.
+  size_t step_num = 2 * (rank_size - 1);
+  for (size_t begin = 0; begin < chunk_sizes[rank_index]; begin += sub_chunk_size) {
+    send_sub_chunk(rank_index, begin, std::min(sub_chunk_size, chunk_sizes[rank_index] - begin));
+  }
+  MS_LOG(DEBUG) << "Start Ring ReduceScatter.";
+  for (size_t step = 0; step < step_num; step++) {
+    bool reduce = step < rank_size - 1;
+    if (step == rank_size - 1) {
+      MS_LOG(DEBUG) << "End Ring ReduceScatter, start Ring AllGather.";
+    }
+    size_t rec_chunk_index = (rank_index + 2 * rank_size - step - 1) % rank_size;
+    size_t rec_num = chunk_sizes[rec_chunk_index];
+    size_t sub_chunk_num = (rec_num + sub_chunk_size - 1) / sub_chunk_size;
+    MS_LOG(DEBUG) << "Ring " << (reduce ? "ReduceScatter" : "AllGather") << " rec data_num:" << rec_num
+                  << ", sub_chunk_num:" << sub_chunk_num << ", step:" << step;
 
-    std::shared_ptr<std::vector<unsigned char>> rec_ptr = nullptr;
-    auto rec_req_id = abs_node_->CollectiveReceiveAsync(ps::core::NodeRole::WORKER, rec_from_rank, &rec_ptr);
-    if (!abs_node_->CollectiveWait(rec_req_id, kWaitTimeout)) {
-      MS_LOG(ERROR) << "Ring AllGather wait receiving " << rec_req_id << " failed.";
-      return false;
+    // Post all the receives of the step, they are matched to the messages of the previous rank in order.
+    std::vector<std::shared_ptr<std::vector<unsigned char>>> rec_ptrs(sub_chunk_num, nullptr);
+    std::vector<std::pair<uint32_t, uint64_t>> rec_req_ids;
+    for (size_t k = 0; k < sub_chunk_num; k++) {
+      (void)rec_req_ids.emplace_back(
+        abs_node_->CollectiveReceiveAsync(ps::core::NodeRole::WORKER, rec_from_rank, &rec_ptrs[k]));
     }
-    memcpy_ret = memcpy_s(rec_chunk, chunk_sizes[rec_chunk_index] * sizeof(float), rec_ptr->data(), rec_ptr->size());
-    if (memcpy_ret != 0) {
-      MS_LOG(ERROR) << "Ring AllGather memcpy_s received data error, errorno(" << memcpy_ret << ")";
+    if (!wait_sends()) {
       return false;
     }
-    if (!abs_node_->Wait(send_req_id, kWaitTimeout)) {
-      MS_LOG(ERROR) << "RingAllReduce wait sending " << send_req_id << " failed.";
-      return false;
+    for (size_t k = 0; k < sub_chunk_num; k++) {
+      if (!abs_node_->CollectiveWait(rec_req_ids[k], kWaitTimeout)) {
+        MS_LOG(ERROR) << "Ring AllReduce wait receiving " << rec_req_ids[k] << " failed.";
+        return false;
+      }
+      size_t begin = k * sub_chunk_size;
+      size_t num = std::min(sub_chunk_size, rec_num - begin);
+      MS_EXCEPTION_IF_NULL(rec_ptrs[k]);
+      if (rec_ptrs[k]->size() != num * type_size) {
+        MS_LOG(ERROR) << "Ring AllReduce received " << rec_ptrs[k]->size() << " bytes, but " << num * type_size
+                      << " bytes are expected.";
+        return false;
+      }
+      auto rec_data = output_buff + (chunk_offset[rec_chunk_index] + begin) * type_size;
+      if (reduce) {
+        sum_into(rec_data, rec_ptrs[k]->data(), num);
+      } else {
+        memcpy_ret = memcpy_s(rec_data, num * type_size, rec_ptrs[k]->data(), rec_ptrs[k]->size());
+        if (memcpy_ret != EOK) {
+          MS_LOG(ERROR) << "Ring AllGather memcpy_s received data error, errorno(" << memcpy_ret << ")";
+          return false;
+        }
+      }
+      rec_ptrs[k] = nullptr;
+      if (step + 1 < step_num) {
+        send_sub_chunk(rec_chunk_index, begin, num);
+      }
     }
   }
   MS_LOG(DEBUG) << "End Ring AllGather.";
-  return true;
+  return wait_sends();
 }
 
-bool AllReduceLauncher::ReduceBroadcastAllReduce(const void *input_data, void *const output_data,
-                                                 size_t data_size) const {
-  int memcpy_ret = memcpy_s(output_data, data_size, input_data, data_size);
-  if (memcpy_ret != EOK) {
-    MS_LOG(ERROR) << "ReduceBroadcastAllReduce memcpy_s input_data error, errorno(" << memcpy_ret << ")";
-    return false;
+bool AllReduceLauncher::ReduceBroadcastAllReduce(const void *input_data, void *const output_data, size_t data_size,
+                                                 TypeId data_type, const std::vector<uint32_t> &ranks) const {
+  int memcpy_ret = EOK;
+  if (output_data != input_data) {
+    memcpy_ret = memcpy_s(output_data, data_size, input_data, data_size);
+    if (memcpy_ret != EOK) {
+      MS_LOG(ERROR) << "ReduceBroadcastAllReduce memcpy_s input_data error, errorno(" << memcpy_ret << ")";
+      return false;
+    }
   }
-  size_t data_num = data_size / sizeof(float);
-  float *output_buff = reinterpret_cast<float *>(output_data);
-  // Reduce data to rank 0 process.
-  MS_LOG(DEBUG) << "Start Reduce to rank 0 process.";
-  if (rank_id_ == 0) {
-    for (uint32_t i = 1; i < rank_size_; i++) {
+  const auto &sum_into = GetSumIntoFunc(data_type);
+  MS_EXCEPTION_IF_NULL(sum_into);
+  size_t data_num = data_size / abstract::TypeIdSize(data_type);
+  void *output_buff = output_data;
+  // Reduce data to the first rank process.
+  uint32_t root_rank = ranks[0];
+  MS_LOG(DEBUG) << "Start Reduce to rank " << root_rank << " process.";
+  if (rank_id_ == root_rank) {
+    for (size_t j = 1; j < ranks.size(); j++) {
+      uint32_t i = ranks[j];
       std::shared_ptr<std::vector<unsigned char>> rec_ptr = nullptr;
-      MS_LOG(DEBUG) << "Reduce rank 0 receive from rank " << i;
+      MS_LOG(DEBUG) << "Reduce rank " << root_rank << " receive from rank " << i;
       auto rec_req_id = abs_node_->CollectiveReceiveAsync(ps::core::NodeRole::WORKER, i, &rec_ptr);
       if (!abs_node_->CollectiveWait(rec_req_id, kWaitTimeout)) {
         MS_LOG(ERROR) << "Reduce wait receiving " << rec_req_id << " failed.";
         return false;
       }
-      const auto *tmp_data = reinterpret_cast<float *>(rec_ptr->data());
-      for (size_t j = 0; j < data_num; j++) {
-        output_buff[j] += tmp_data[j];
+      if (rec_ptr == nullptr || rec_ptr->size() != data_size) {
+        MS_LOG(ERROR) << "Reduce received data of unexpected size from rank " << i;
+        return false;
       }
+      sum_into(output_buff, rec_ptr->data(), data_num);
     }
   } else {
-    MS_LOG(DEBUG) << "Reduce send data to rank 0 process.";
-    auto send_req_id =
-      abs_node_->CollectiveSendAsync(ps::core::NodeRole::WORKER, 0, input_data, data_num * sizeof(float));
+    MS_LOG(DEBUG) << "Reduce send data to rank " << root_rank << " process.";
+    auto send_req_id = abs_node_->CollectiveSendAsync(ps::core::NodeRole::WORKER, root_rank, input_data, data_size);
     if (!abs_node_->Wait(send_req_id, kWaitTimeout)) {
       MS_LOG(ERROR) << "Reduce wait sending " << send_req_id << " failed.";
       return false;
@@ -191,27 +252,27 @@ bool AllReduceLauncher::ReduceBroadcastAllReduce(const void *input_data, void *c
   }
   MS_LOG(DEBUG) << "End Reduce.";
 
-  // Broadcast data to not rank 0 process.
-  MS_LOG(DEBUG) << "Start broadcast from rank 0 to other processes.";
-  if (rank_id_ == 0) {
-    for (uint32_t i = 1; i < rank_size_; i++) {
+  // Broadcast data to the other processes.
+  MS_LOG(DEBUG) << "Start broadcast from rank " << root_rank << " to other processes.";
+  if (rank_id_ == root_rank) {
+    for (size_t j = 1; j < ranks.size(); j++) {
+      uint32_t i = ranks[j];
       MS_LOG(DEBUG) << "Broadcast data to process " << i;
-      auto send_req_id =
-        abs_node_->CollectiveSendAsync(ps::core::NodeRole::WORKER, i, output_buff, data_num * sizeof(float));
+      auto send_req_id = abs_node_->CollectiveSendAsync(ps::core::NodeRole::WORKER, i, output_buff, data_size);
       if (!abs_node_->Wait(send_req_id, kWaitTimeout)) {
         MS_LOG(ERROR) << "Broadcast wait sending " << send_req_id << " failed.";
         return false;
       }
     }
   } else {
-    MS_LOG(DEBUG) << "Broadcast receive from rank 0.";
+    MS_LOG(DEBUG) << "Broadcast receive from rank " << root_rank;
     std::shared_ptr<std::vector<unsigned char>> rec_ptr = nullptr;
-    auto rec_req_id = abs_node_->CollectiveReceiveAsync(ps::core::NodeRole::WORKER, 0, &rec_ptr);
+    auto rec_req_id = abs_node_->CollectiveReceiveAsync(ps::core::NodeRole::WORKER, root_rank, &rec_ptr);
     if (!abs_node_->CollectiveWait(rec_req_id, kWaitTimeout)) {
       MS_LOG(ERROR) << "Broadcast wait receiving " << rec_req_id << " failed.";
       return false;
     }
-    memcpy_ret = memcpy_s(output_buff, data_num * sizeof(float), rec_ptr->data(), rec_ptr->size());
+    memcpy_ret = memcpy_s(output_buff, data_size, rec_ptr->data(), rec_ptr->size());
     if (memcpy_ret != 0) {
       MS_LOG(ERROR) << "Broadcast memcpy_s received data error, errorno(" << memcpy_ret << ")";
       return false;
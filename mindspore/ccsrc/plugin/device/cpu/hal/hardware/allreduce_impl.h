@@ -18,6 +18,8 @@
 #define MINDSPORE_CCSRC_RUNTIME_HARDWARE_CPU_ALLREDUCE_IMPL_H_
 
 #include <string>
+#include <vector>
+#include "mindapi/base/type_id.h"
 #include "distributed/cluster/cluster_context.h"
 
 namespace mindspore {
@@ -33,18 +35,27 @@ class AllReduceLauncher {
     static AllReduceLauncher instance;
     return instance;
   }
-  bool Execute(const void *input_data, void *const output_data, size_t data_size) const;
+  // Sum the data_size bytes of input_data of all the workers into output_data, the element type is data_type.
+  bool Execute(const void *input_data, void *const output_data, size_t data_size, TypeId data_type) const;
+  // Sum among the workers of the global ranks only, which must contain this rank. The input and output can be the same.
+  bool Execute(const void *input_data, void *const output_data, size_t data_size, TypeId data_type,
+               const std::vector<uint32_t> &ranks) const;
 
  private:
   size_t rank_id_{0};
   size_t rank_size_{0};
   std::string node_role_{distributed::kEnvRoleOfWorker};
+  std::vector<uint32_t> all_ranks_;
   ps::core::AbstractNodePtr abs_node_{nullptr};
 
   AllReduceLauncher();
 
-  bool RingAllReduce(const void *input_data, void *const output_data, size_t data_size) const;
-  bool ReduceBroadcastAllReduce(const void *input_data, void *const output_data, size_t data_size) const;
+  // The ring runs ReduceScatter then AllGather, each chunk of the ring is split into sub-chunks which are forwarded
+  // to the next rank as soon as they are reduced, so the sending of the sub-chunks overlaps with the reduction.
+  bool RingAllReduce(const void *input_data, void *const output_data, size_t data_size, TypeId data_type,
+                     const std::vector<uint32_t> &ranks) const;
+  bool ReduceBroadcastAllReduce(const void *input_data, void *const output_data, size_t data_size, TypeId data_type,
+                                const std::vector<uint32_t> &ranks) const;
 };
 }  // namespace cpu
 }  // namespace device
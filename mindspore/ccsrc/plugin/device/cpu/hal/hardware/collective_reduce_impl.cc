@@ -0,0 +1,94 @@
+/**
+ * Copyright 2022 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "plugin/device/cpu/hal/hardware/collective_reduce_impl.h"
+
+#include <algorithm>
+#include <vector>
+#include "base/float16.h"
+#include "utils/convert_utils_base.h"
+#include "include/common/thread_pool.h"
+#include "plugin/device/cpu/kernel/nnacl/fp32/add_fp32.h"
+
+namespace mindspore {
+namespace device {
+namespace cpu {
+namespace {
+// The minimum number of the elements reduced by one thread.
+constexpr size_t kParallelReduceMinNum = 32 * 1024;
+
+// The scalar loop is left for float16, int8 and int64. The nnacl of the cpu backend has no add kernel of int64, its
+// fp16 kernels are built for arm only, and its int8 add is the same loop. Off arm, float16 is a software type converted
+// to float per element, so these types are only sped up by the threads of ParallelSumInto.
+template <typename T>
+void SumInto(T *output, const T *input, size_t num) {
+  for (size_t i = 0; i < num; i++) {
+    output[i] += input[i];
+  }
+}
+
+template <>
+void SumInto<float>(float *output, const float *input, size_t num) {
+  (void)ElementAdd(output, input, output, SizeToInt(num));
+}
+
+template <>
+void SumInto<int32_t>(int32_t *output, const int32_t *input, size_t num) {
+  (void)ElementAddInt(output, input, output, SizeToInt(num));
+}
+
+// Add the input to the output, the large data is split to the threads of the common thread pool.
+template <typename T>
+void ParallelSumInto(void *output, const void *input, size_t num) {
+  auto output_data = static_cast<T *>(output);
+  auto input_data = static_cast<const T *>(input);
+  size_t thread_num = std::min(common::ThreadPool::GetInstance().GetSyncRunThreadNum(), num / kParallelReduceMinNum);
+  if (thread_num <= 1) {
+    SumInto<T>(output_data, input_data, num);
+    return;
+  }
+  size_t task_size = (num + thread_num - 1) / thread_num;
+  std::vector<common::Task> tasks;
+  for (size_t start = 0; start < num; start += task_size) {
+    size_t end = std::min(start + task_size, num);
+    (void)tasks.emplace_back([output_data, input_data, start, end]() {
+      SumInto<T>(output_data + start, input_data + start, end - start);
+      return common::SUCCESS;
+    });
+  }
+  (void)common::ThreadPool::GetInstance().SyncRun(tasks);
+}
+}  // namespace
+
+SumIntoFunc GetSumIntoFunc(TypeId data_type) {
+  switch (data_type) {
+    case TypeId::kNumberTypeFloat32:
+      return ParallelSumInto<float>;
+    case TypeId::kNumberTypeFloat16:
+      return ParallelSumInto<float16>;
+    case TypeId::kNumberTypeInt8:
+      return ParallelSumInto<int8_t>;
+    case TypeId::kNumberTypeInt32:
+      return ParallelSumInto<int32_t>;
+    case TypeId::kNumberTypeInt64:
+      return ParallelSumInto<int64_t>;
+    default:
+      return nullptr;
+  }
+}
+}  // namespace cpu
+}  // namespace device
+}  // namespace mindspore
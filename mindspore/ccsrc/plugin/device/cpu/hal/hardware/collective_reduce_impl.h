@@ -0,0 +1,36 @@
+/**
+ * Copyright 2022 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef MINDSPORE_CCSRC_RUNTIME_HARDWARE_CPU_COLLECTIVE_REDUCE_IMPL_H_
+#define MINDSPORE_CCSRC_RUNTIME_HARDWARE_CPU_COLLECTIVE_REDUCE_IMPL_H_
+
+#include <functional>
+#include "mindapi/base/type_id.h"
+
+namespace mindspore {
+namespace device {
+namespace cpu {
+// Add num elements of the input to the output in place.
+using SumIntoFunc = std::function<void(void *output, const void *input, size_t num)>;
+
+// Get the sum function of the data type for the collective reduction, which runs the simd kernels of nnacl for float32
+// and int32 and a scalar loop for float16, int8 and int64, and splits the large data to the threads of the common
+// thread pool. Return nullptr if the data type is not supported.
+SumIntoFunc GetSumIntoFunc(TypeId data_type);
+}  // namespace cpu
+}  // namespace device
+}  // namespace mindspore
+#endif  // MINDSPORE_CCSRC_RUNTIME_HARDWARE_CPU_COLLECTIVE_REDUCE_IMPL_H_
@@ -18,6 +18,9 @@
 #include <string>
 #include "plugin/device/cpu/hal/device/cpu_device_address.h"
 #include "plugin/device/cpu/hal/device/cpu_memory_manager.h"
+#include "plugin/device/cpu/hal/device/cpu_static_mem_plan.h"
+#include "plugin/device/cpu/hal/hardware/cpu_memory_pool.h"
+#include "backend/common/session/kernel_graph_cache.h"
 #include "plugin/device/cpu/kernel/akg/akg_cpu_kernel_build.h"
 #include "plugin/factory/ms_factory.h"
 #include "plugin/device/cpu/kernel/cpu_kernel.h"
@@ -40,6 +43,7 @@
 #include "backend/common/session/anf_runtime_algorithm.h"
 #include "include/common/utils/anfalgo.h"
 #include "profiler/device/cpu/cpu_profiling.h"
+#include "utils/ms_utils.h"
 #if ((defined ENABLE_CPU) && (!defined _WIN32) && !defined(__APPLE__))
 #include "plugin/device/cpu/hal/hardware/ms_collective_comm_lib.h"
 #endif
@@ -226,6 +230,15 @@ void SetControlOpInfo(const CNodePtr &kernel_node) {
 
   AnfAlgo::SetSelectKernelBuildInfo(builder->Build(), kernel_node.get());
 }
+
+// Reuse the kernel select result of the kernel with the same signature from the kernel graph cache. The Custom
+// kernels are always selected, since the selection registers their kernel mods.
+std::pair<std::string, ExceptionType> SetKernelInfoWithCache(const CNodePtr &node) {
+  if (IsPrimitiveCNode(node, prim::kPrimCustom)) {
+    return SetKernelInfoWithMsg(node);
+  }
+  return session::KernelGraphCache::GetInstance().SelectKernelWithCache(node, SetKernelInfoWithMsg);
+}
 }  // namespace
 
 void CPUDeviceContext::SetOperatorInfo(const KernelGraphPtr &graph) const {
@@ -235,7 +248,7 @@ void CPUDeviceContext::SetOperatorInfo(const KernelGraphPtr &graph) const {
   auto &node_list = graph->execution_order();
   for (auto &node : node_list) {
     if (!common::AnfAlgo::IsControlOpExecInBackend(node)) {
-      auto [msg, etype] = SetKernelInfoWithMsg(node);
+      auto [msg, etype] = SetKernelInfoWithCache(node);
       if (msg.empty()) {
         continue;
       }
@@ -362,6 +375,34 @@ void CPUDeviceContext::PreprocessBeforeRunGraph(const KernelGraphPtr &graph) con
   }
 }
 
+void CPUDeviceContext::PlanStaticMemory(const KernelGraphPtr &graph) const {
+  MS_EXCEPTION_IF_NULL(graph);
+  MS_EXCEPTION_IF_NULL(mem_manager_);
+  static const bool enable_static_mem_plan = (common::GetEnv("MS_DEV_CPU_STATIC_MEM_PLAN") == "1");
+  if (!enable_static_mem_plan || !CPUStaticMemPlan::IsGraphSupported(graph.get())) {
+    return;
+  }
+
+  CPUStaticMemPlan mem_plan;
+  size_t arena_size = mem_plan.MemPlan(graph.get());
+  if (arena_size == 0) {
+    return;
+  }
+  // The addresses which are not bound keep allocating memory when running graph if the arena can't be allocated.
+  auto arena = AllocateMemory(arena_size);
+  if (arena == nullptr) {
+    MS_LOG(WARNING) << "Allocate the static memory arena of size " << arena_size << " failed for graph "
+                    << graph->graph_id() << ", fall back to the dynamic memory allocation.";
+    return;
+  }
+  mem_plan.MemAssign(static_cast<uint8_t *>(arena));
+
+  // The graph owns the arena, so it's freed when the graph is released or planned again. Freeing it after the memory
+  // pool has been released by Destroy is ignored by the pool.
+  graph->set_static_memory_arena(
+    std::shared_ptr<void>(arena, [](void *ptr) { CPUMemoryPool::GetInstance().FreeTensorMem(ptr); }));
+}
+
 bool CPUDeviceContext::LaunchCustomFunc(const AnfNodePtr &kernel) const {
   MS_EXCEPTION_IF_NULL(kernel);
   auto custom_func = AnfUtils::GetCustomFunc(kernel);
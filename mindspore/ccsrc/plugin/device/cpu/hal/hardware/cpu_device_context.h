@@ -20,6 +20,7 @@
 #include <memory>
 #include <string>
 #include <mutex>
+#include <map>
 #include "runtime/hardware/device_context.h"
 #include "runtime/hardware/device_context_manager.h"
 #include "runtime/device/memory_manager.h"
@@ -57,6 +58,7 @@ class CPUDeviceContext : public DeviceContext {
   void UpdateDynamicShape(const CNodePtr &kernel) const override;
 
   void PreprocessBeforeRunGraph(const KernelGraphPtr &graph) const override;
+  void PlanStaticMemory(const KernelGraphPtr &graph) const override;
 
   bool LaunchKernel(const CNodePtr &kernel, const std::vector<AddressPtr> &inputs,
                     const std::vector<AddressPtr> &workspace, const std::vector<AddressPtr> &outputs,
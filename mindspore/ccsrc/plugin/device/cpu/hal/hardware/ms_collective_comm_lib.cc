@@ -16,12 +16,23 @@
 
 #include "plugin/device/cpu/hal/hardware/ms_collective_comm_lib.h"
 
+#include <unistd.h>
+#include <map>
+#include <algorithm>
+#include "abstract/utils.h"
 #include "runtime/collective/collective_communication_lib.h"
 #include "plugin/device/cpu/hal/hardware/allreduce_impl.h"
 
 namespace mindspore {
 namespace device {
 namespace cpu {
+namespace {
+constexpr uint32_t kHierarchicalWaitTimeout = 30;
+// The local ranks wait in the shared memory channel while the host leader runs the collectives between the hosts, every
+// step of which waits for the messages of the other hosts, so the wait timeout grows with the host number.
+constexpr uint32_t kShmWaitTimeoutPerHost = 600;
+}  // namespace
+
 MsCollectiveCommLib::MsCollectiveCommLib() {
   node_ = std::dynamic_pointer_cast<ps::core::AbstractNode>(ClusterContext::instance()->node());
   // Generate the global group name with node role.
@@ -74,6 +85,8 @@ bool MsCollectiveCommLib::AllGatherHostHashName(size_t host_hash_name, std::vect
     std::this_thread::sleep_for(std::chrono::seconds(kWaitDuration));
   }
 
+  // Record the hosts of the ranks for the hierarchical collectives.
+  host_hash_names_ = *host_hash_names;
   return true;
 }
 
@@ -224,21 +237,48 @@ bool MsCollectiveCommLib::AllReduce(const void *send_buff, void *recv_buff, size
   CHECK_IF_NULL(send_buff);
   CHECK_IF_NULL(recv_buff);
   CHECK_IF_NULL(node_);
-  if (data_type != TypeId::kNumberTypeFloat32) {
-    MS_LOG(EXCEPTION) << "AllReduce only support float32.";
+  if (data_type != TypeId::kNumberTypeFloat32 && data_type != TypeId::kNumberTypeFloat16 &&
+      data_type != TypeId::kNumberTypeInt8 && data_type != TypeId::kNumberTypeInt32 &&
+      data_type != TypeId::kNumberTypeInt64) {
+    MS_LOG(EXCEPTION) << "AllReduce only support float32, float16, int8, int32 and int64.";
   }
   if (reduce_op != CollectiveOpReduceType::Reduce_Sum) {
     MS_LOG(EXCEPTION) << "AllReduce only support reduce sum.";
   }
-  bool ret = AllReduceLauncher::GetInstance().Execute(send_buff, recv_buff, send_count);
+  if (InitHierarchicalCollective()) {
+    return HierarchicalAllReduce(send_buff, recv_buff, send_count, data_type);
+  }
+  bool ret = AllReduceLauncher::GetInstance().Execute(send_buff, recv_buff, send_count, data_type);
   return ret;
 }
 
+bool MsCollectiveCommLib::ReduceScatter(const void *send_buff, void *recv_buff, size_t recv_count, TypeId data_type,
+                                        CollectiveOpReduceType reduce_op, const std::string &group_name, void *) {
+  CHECK_IF_NULL(send_buff);
+  CHECK_IF_NULL(recv_buff);
+  // The data of all the ranks is reduced by AllReduce, and each rank takes its own part.
+  size_t recv_size = recv_count * abstract::TypeIdSize(data_type);
+  std::vector<uint8_t> reduced_data(recv_size * global_rank_size_);
+  if (!AllReduce(send_buff, reduced_data.data(), reduced_data.size(), data_type, reduce_op, group_name)) {
+    MS_LOG(ERROR) << "AllReduce for ReduceScatter failed.";
+    return false;
+  }
+  auto ret = memcpy_s(recv_buff, recv_size, reduced_data.data() + recv_size * global_rank_id_, recv_size);
+  if (ret != EOK) {
+    MS_LOG(ERROR) << "The memcpy_s error, errorno(" << ret << ")";
+    return false;
+  }
+  return true;
+}
+
 bool MsCollectiveCommLib::AllGather(const void *send_buff, void *recv_buff, size_t send_count, TypeId data_type,
                                     const std::string &, void *) {
   CHECK_IF_NULL(send_buff);
   CHECK_IF_NULL(recv_buff);
   CHECK_IF_NULL(node_);
+  if (InitHierarchicalCollective()) {
+    return HierarchicalAllGather(send_buff, recv_buff, send_count * abstract::TypeIdSize(data_type));
+  }
 
   switch (data_type) {
     case TypeId::kNumberTypeInt8:
@@ -269,6 +309,10 @@ bool MsCollectiveCommLib::Broadcast(const void *send_buff, void *recv_buff, size
   }
 
   auto group = groups_[group_name];
+  if (group->group_size() == global_rank_size_ && InitHierarchicalCollective()) {
+    return HierarchicalBroadcast(send_buff, recv_buff, send_count * abstract::TypeIdSize(data_type),
+                                 group->GetGlobalRank(root_rank));
+  }
   CommunicationGroupInfo group_info = {};
   group_info.size = group->group_size();
   group_info.global_rank = global_rank_id_;
@@ -296,6 +340,217 @@ bool MsCollectiveCommLib::Broadcast(const void *send_buff, void *recv_buff, size
   }
   return true;
 }
+
+bool MsCollectiveCommLib::InitHierarchicalCollective() {
+  if (hierarchical_inited_) {
+    return hierarchical_enabled_;
+  }
+  hierarchical_inited_ = true;
+  if (host_hash_names_.size() != global_rank_size_ || global_rank_id_ >= global_rank_size_) {
+    MS_LOG(INFO) << "The host names of the ranks are unknown, the hierarchical collectives are not used.";
+    return false;
+  }
+
+  // Group the ranks by the host, every rank gets the same topology.
+  std::map<size_t, size_t> host_indices;
+  rank_host_index_.resize(global_rank_size_);
+  rank_local_index_.resize(global_rank_size_);
+  for (uint32_t rank = 0; rank < global_rank_size_; rank++) {
+    auto iter = host_indices.find(host_hash_names_[rank]);
+    if (iter == host_indices.end()) {
+      iter = host_indices.emplace(host_hash_names_[rank], host_ranks_.size()).first;
+      (void)host_ranks_.emplace_back();
+      leader_ranks_.push_back(rank);
+    }
+    rank_host_index_[rank] = iter->second;
+    rank_local_index_[rank] = host_ranks_[iter->second].size();
+    host_ranks_[iter->second].push_back(rank);
+  }
+  host_index_ = rank_host_index_[global_rank_id_];
+  size_t max_local_rank_size = 0;
+  for (const auto &ranks : host_ranks_) {
+    max_local_rank_size = std::max(max_local_rank_size, ranks.size());
+  }
+  if (max_local_rank_size <= 1 || max_local_rank_size > kMaxShmLocalRankNum) {
+    MS_LOG(INFO) << "The max number of the ranks on one host is " << max_local_rank_size
+                 << ", the hierarchical collectives are not used.";
+    return false;
+  }
+
+  // The leader creates the shared memory and sends its name to the other ranks on the host. Once the topology enables
+  // the hierarchical collectives, the failure of the shared memory is fatal since the other hosts are using them.
+  const auto &local_ranks = host_ranks_[host_index_];
+  if (local_ranks.size() > 1) {
+    std::string shm_name;
+    if (IsHostLeader()) {
+      shm_name = "/mindspore_mccl_" + std::to_string(getpid()) + "_" + std::to_string(global_rank_id_);
+      for (size_t i = 1; i < local_ranks.size(); i++) {
+        auto send_req_id =
+          node_->CollectiveSendAsync(ps::core::NodeRole::WORKER, local_ranks[i], shm_name.data(), shm_name.size());
+        if (!node_->Wait(send_req_id, kHierarchicalWaitTimeout)) {
+          MS_LOG(EXCEPTION) << "Send the shared memory name to rank " << local_ranks[i] << " failed.";
+        }
+      }
+    } else {
+      std::shared_ptr<std::vector<unsigned char>> rec_ptr = nullptr;
+      auto rec_req_id = node_->CollectiveReceiveAsync(ps::core::NodeRole::WORKER, local_ranks.front(), &rec_ptr);
+      if (!node_->CollectiveWait(rec_req_id, kHierarchicalWaitTimeout) || rec_ptr == nullptr) {
+        MS_LOG(EXCEPTION) << "Receive the shared memory name from rank " << local_ranks.front() << " failed.";
+      }
+      shm_name.assign(rec_ptr->begin(), rec_ptr->end());
+    }
+    shm_channel_ =
+      std::make_unique<SharedMemoryChannel>(shm_name, rank_local_index_[global_rank_id_], local_ranks.size());
+    if (!shm_channel_->Initialize(kHierarchicalWaitTimeout, kShmWaitTimeoutPerHost * host_ranks_.size())) {
+      MS_LOG(EXCEPTION) << "Initialize the shared memory channel " << shm_name << " failed.";
+    }
+  }
+  hierarchical_enabled_ = true;
+  MS_LOG(INFO) << "The hierarchical collectives are used, host number: " << host_ranks_.size()
+               << ", rank number on this host: " << local_ranks.size();
+  return true;
+}
+
+bool MsCollectiveCommLib::HierarchicalAllReduce(const void *send_buff, void *recv_buff, size_t data_size,
+                                                TypeId data_type) {
+  if (shm_channel_ == nullptr) {
+    return AllReduceLauncher::GetInstance().Execute(send_buff, recv_buff, data_size, data_type, leader_ranks_);
+  }
+  if (host_ranks_.size() == 1) {
+    return shm_channel_->AllReduce(send_buff, recv_buff, data_size, data_type);
+  }
+  // Reduce to the leader within the host, then the leaders reduce across the hosts and broadcast within the host.
+  if (!shm_channel_->Reduce(send_buff, recv_buff, data_size, data_type)) {
+    MS_LOG(ERROR) << "Reduce through the shared memory failed.";
+    return false;
+  }
+  if (IsHostLeader() &&
+      !AllReduceLauncher::GetInstance().Execute(recv_buff, recv_buff, data_size, data_type, leader_ranks_)) {
+    MS_LOG(ERROR) << "AllReduce between the hosts failed.";
+    return false;
+  }
+  return shm_channel_->Broadcast(recv_buff, data_size, 0);
+}
+
+bool MsCollectiveCommLib::HierarchicalAllGather(const void *send_buff, void *recv_buff, size_t data_size) {
+  if (host_ranks_.size() == 1) {
+    MS_EXCEPTION_IF_NULL(shm_channel_);
+    // The local rank is the global rank if all the ranks are on this host.
+    return shm_channel_->AllGather(send_buff, recv_buff, data_size);
+  }
+  auto output = static_cast<uint8_t *>(recv_buff);
+  size_t output_size = data_size * global_rank_size_;
+  // Place the data of the ranks of one host in the order of the global rank.
+  auto scatter_host_data = [this, output, output_size, data_size](size_t host_index, const uint8_t *host_data) {
+    const auto &ranks = host_ranks_[host_index];
+    for (size_t i = 0; i < ranks.size(); i++) {
+      auto ret = memcpy_s(output + ranks[i] * data_size, output_size - ranks[i] * data_size,
+                          host_data + i * data_size, data_size);
+      if (ret != EOK) {
+        MS_LOG(ERROR) << "The memcpy_s error, errorno(" << ret << ")";
+        return false;
+      }
+    }
+    return true;
+  };
+
+  if (IsHostLeader()) {
+    std::vector<uint8_t> host_data(host_ranks_[host_index_].size() * data_size);
+    if (shm_channel_ == nullptr) {
+      auto ret = memcpy_s(host_data.data(), host_data.size(), send_buff, data_size);
+      if (ret != EOK) {
+        MS_LOG(ERROR) << "The memcpy_s error, errorno(" << ret << ")";
+        return false;
+      }
+    } else if (!shm_channel_->Gather(send_buff, host_data.data(), data_size, 0)) {
+      MS_LOG(ERROR) << "Gather through the shared memory failed.";
+      return false;
+    }
+    // Exchange the data of the hosts between the leaders.
+    std::vector<uint64_t> send_req_ids;
+    for (size_t h = 0; h < host_ranks_.size(); h++) {
+      if (h != host_index_) {
+        (void)send_req_ids.emplace_back(node_->CollectiveSendAsync(ps::core::NodeRole::WORKER, leader_ranks_[h],
+                                                                   host_data.data(), host_data.size()));
+      }
+    }
+    if (!scatter_host_data(host_index_, host_data.data())) {
+      return false;
+    }
+    for (size_t h = 0; h < host_ranks_.size(); h++) {
+      if (h == host_index_) {
+        continue;
+      }
+      std::shared_ptr<std::vector<unsigned char>> rec_ptr = nullptr;
+      auto rec_req_id = node_->CollectiveReceiveAsync(ps::core::NodeRole::WORKER, leader_ranks_[h], &rec_ptr);
+      if (!node_->CollectiveWait(rec_req_id, kHierarchicalWaitTimeout) || rec_ptr == nullptr ||
+          rec_ptr->size() != host_ranks_[h].size() * data_size) {
+        MS_LOG(ERROR) << "Receive the data of the host from rank " << leader_ranks_[h] << " failed.";
+        return false;
+      }
+      if (!scatter_host_data(h, rec_ptr->data())) {
+        return false;
+      }
+    }
+    for (auto send_req_id : send_req_ids) {
+      if (!node_->Wait(send_req_id, kHierarchicalWaitTimeout)) {
+        MS_LOG(ERROR) << "Send the data of the host failed.";
+        return false;
+      }
+    }
+  } else if (!shm_channel_->Gather(send_buff, nullptr, data_size, 0)) {
+    MS_LOG(ERROR) << "Gather through the shared memory failed.";
+    return false;
+  }
+  return shm_channel_ == nullptr || shm_channel_->Broadcast(recv_buff, output_size, 0);
+}
+
+bool MsCollectiveCommLib::HierarchicalBroadcast(const void *send_buff, void *recv_buff, size_t data_size,
+                                                uint32_t root_rank) {
+  if (root_rank >= global_rank_size_) {
+    MS_LOG(ERROR) << "Invalid root rank " << root_rank << " of the rank size " << global_rank_size_;
+    return false;
+  }
+  size_t root_host_index = rank_host_index_[root_rank];
+  if (global_rank_id_ == root_rank) {
+    if (recv_buff != send_buff) {
+      auto ret = memcpy_s(recv_buff, data_size, send_buff, data_size);
+      if (ret != EOK) {
+        MS_LOG(ERROR) << "The memcpy_s error, errorno(" << ret << ")";
+        return false;
+      }
+    }
+    // The root sends the data to the leaders of the other hosts.
+    for (size_t h = 0; h < host_ranks_.size(); h++) {
+      if (h == root_host_index) {
+        continue;
+      }
+      auto send_req_id = node_->CollectiveSendAsync(ps::core::NodeRole::WORKER, leader_ranks_[h], send_buff, data_size);
+      if (!node_->Wait(send_req_id, kHierarchicalWaitTimeout)) {
+        MS_LOG(ERROR) << "Broadcast wait sending to rank " << leader_ranks_[h] << " failed.";
+        return false;
+      }
+    }
+  } else if (host_index_ != root_host_index && IsHostLeader()) {
+    std::shared_ptr<std::vector<unsigned char>> rec_ptr = nullptr;
+    auto rec_req_id = node_->CollectiveReceiveAsync(ps::core::NodeRole::WORKER, root_rank, &rec_ptr);
+    if (!node_->CollectiveWait(rec_req_id, kHierarchicalWaitTimeout) || rec_ptr == nullptr) {
+      MS_LOG(ERROR) << "Broadcast wait receiving from rank " << root_rank << " failed.";
+      return false;
+    }
+    auto ret = memcpy_s(recv_buff, data_size, rec_ptr->data(), rec_ptr->size());
+    if (ret != EOK) {
+      MS_LOG(ERROR) << "The memcpy_s error, errorno(" << ret << ")";
+      return false;
+    }
+  }
+  if (shm_channel_ == nullptr) {
+    return true;
+  }
+  // Within the host, the data is broadcast from the root or the leader which has received it.
+  size_t local_root = (host_index_ == root_host_index) ? rank_local_index_[root_rank] : 0;
+  return shm_channel_->Broadcast(recv_buff, data_size, local_root);
+}
 }  // namespace cpu
 }  // namespace device
 }  // namespace mindspore
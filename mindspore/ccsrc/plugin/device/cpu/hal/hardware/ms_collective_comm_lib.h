@@ -22,6 +22,7 @@
 #include <string>
 #include "runtime/collective/collective_communication_lib.h"
 #include "plugin/device/cpu/hal/hardware/ms_communication_group.h"
+#include "plugin/device/cpu/hal/hardware/ms_collective_shm.h"
 #include "distributed/cluster/cluster_context.h"
 #include "fl/server/collective_ops_impl.h"
 
@@ -63,9 +64,7 @@ class MsCollectiveCommLib : public CollectiveCommunicationLib {
                  const std::string &group_name, void *stream = nullptr) override;
 
   bool ReduceScatter(const void *send_buff, void *recv_buff, size_t recv_count, TypeId data_type,
-                     CollectiveOpReduceType reduce_op, const std::string &group_name, void *stream = nullptr) override {
-    return true;
-  }
+                     CollectiveOpReduceType reduce_op, const std::string &group_name, void *stream = nullptr) override;
 
  private:
   MsCollectiveCommLib();
@@ -83,7 +82,31 @@ class MsCollectiveCommLib : public CollectiveCommunicationLib {
   // Query unique id from scheduler.
   bool QueryUniqueID(const std::string &group_name, size_t root_info_size, void *root_info) const;
 
+  // The collectives become hierarchical if some ranks are on the same host: the ranks on the same host communicate
+  // through the shared memory, and only the first rank of each host, which is called the leader, communicates with the
+  // other hosts. Return whether the hierarchical collectives are used, the shared memory channel is initialized at the
+  // first call, so it must be called by all the ranks in the same order as the collectives.
+  bool InitHierarchicalCollective();
+  bool HierarchicalAllReduce(const void *send_buff, void *recv_buff, size_t data_size, TypeId data_type);
+  bool HierarchicalAllGather(const void *send_buff, void *recv_buff, size_t data_size);
+  bool HierarchicalBroadcast(const void *send_buff, void *recv_buff, size_t data_size, uint32_t root_rank);
+  bool IsHostLeader() const { return host_ranks_[host_index_].front() == global_rank_id_; }
+
   ps::core::AbstractNodePtr node_;
+
+  // The host hash names of all the ranks, which are gathered while assigning the local rank.
+  mutable std::vector<size_t> host_hash_names_;
+  bool hierarchical_inited_{false};
+  bool hierarchical_enabled_{false};
+  // The global ranks of each host, the hosts are in the order of their first ranks.
+  std::vector<std::vector<uint32_t>> host_ranks_;
+  // The host index and the local rank of each global rank.
+  std::vector<size_t> rank_host_index_;
+  std::vector<size_t> rank_local_index_;
+  size_t host_index_{0};
+  std::vector<uint32_t> leader_ranks_;
+  // The channel of the ranks on this host, it's nullptr if this rank is the only one on the host.
+  std::unique_ptr<SharedMemoryChannel> shm_channel_;
 };
 }  // namespace cpu
 }  // namespace device
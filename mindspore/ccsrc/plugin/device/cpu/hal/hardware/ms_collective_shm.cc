@@ -0,0 +1,372 @@
+/**
+ * Copyright 2022 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "plugin/device/cpu/hal/hardware/ms_collective_shm.h"
+
+#include <fcntl.h>
+#include <linux/futex.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#include <algorithm>
+#include <cerrno>
+#include <chrono>
+#include <climits>
+#include <ctime>
+#include <new>
+#include <thread>
+#include "abstract/utils.h"
+#include "utils/log_adapter.h"
+#include "plugin/device/cpu/hal/hardware/collective_reduce_impl.h"
+
+namespace mindspore {
+namespace device {
+namespace cpu {
+namespace {
+constexpr uint32_t kShmMagic = 0x4D53484D;
+// Spin this many times before sleeping on the futex while waiting for the other local ranks.
+constexpr size_t kSpinCount = 1024;
+constexpr size_t kAttachRetryIntervalMs = 1;
+constexpr int64_t kNanosecondsPerSecond = 1000000000;
+static_assert(sizeof(std::atomic<uint32_t>) == sizeof(uint32_t), "The futex word must be 32 bits.");
+
+// The futex isn't private since the word is in the memory shared between the processes.
+void FutexWake(std::atomic<uint32_t> *word) {
+  (void)syscall(SYS_futex, reinterpret_cast<uint32_t *>(word), FUTEX_WAKE, INT_MAX, nullptr, nullptr, 0);
+}
+
+// Wait until the value of the word meets the condition. It spins for a short while, which is enough if the other local
+// ranks are running the same collective, and then sleeps on the futex until the word is changed.
+template <typename Cond>
+bool WaitFlag(std::atomic<uint32_t> *word, const Cond &cond, size_t timeout_in_sec) {
+  for (size_t i = 0; i < kSpinCount; i++) {
+    if (cond(word->load(std::memory_order_acquire))) {
+      return true;
+    }
+  }
+  auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(timeout_in_sec);
+  while (true) {
+    uint32_t value = word->load(std::memory_order_acquire);
+    if (cond(value)) {
+      return true;
+    }
+    auto remaining = deadline - std::chrono::steady_clock::now();
+    if (remaining <= std::chrono::steady_clock::duration::zero()) {
+      return false;
+    }
+    auto remaining_ns = std::chrono::duration_cast<std::chrono::nanoseconds>(remaining).count();
+    struct timespec timeout = {};
+    timeout.tv_sec = static_cast<decltype(timeout.tv_sec)>(remaining_ns / kNanosecondsPerSecond);
+    timeout.tv_nsec = static_cast<decltype(timeout.tv_nsec)>(remaining_ns % kNanosecondsPerSecond);
+    // It returns at once if the word has been changed, the wake-up, interruption and timeout are all checked above.
+    (void)syscall(SYS_futex, reinterpret_cast<uint32_t *>(word), FUTEX_WAIT, value, &timeout, nullptr, 0);
+  }
+}
+}  // namespace
+
+bool SharedMemoryChannel::Initialize(size_t timeout_in_sec, size_t wait_timeout_in_sec) {
+  if (header_ != nullptr) {
+    return true;
+  }
+  if (local_rank_size_ == 0 || local_rank_size_ > kMaxShmLocalRankNum || local_rank_ >= local_rank_size_) {
+    MS_LOG(ERROR) << "Invalid local rank " << local_rank_ << " of the local rank size " << local_rank_size_
+                  << " for the shared memory channel, the max local rank size is " << kMaxShmLocalRankNum;
+    return false;
+  }
+  wait_timeout_in_sec_ = wait_timeout_in_sec;
+  bool ret = (local_rank_ == 0) ? CreateShm(timeout_in_sec) : AttachShm(timeout_in_sec);
+  if (!ret) {
+    Finalize();
+    return false;
+  }
+  MS_LOG(INFO) << "The shared memory channel " << name_ << " is initialized, local rank: " << local_rank_
+               << ", local rank size: " << local_rank_size_ << ", slot size: " << slot_size_;
+  return true;
+}
+
+void SharedMemoryChannel::Finalize() {
+  if (shm_addr_ != nullptr) {
+    (void)munmap(shm_addr_, ShmSize());
+    shm_addr_ = nullptr;
+  }
+  if (fd_ >= 0) {
+    (void)close(fd_);
+    fd_ = -1;
+  }
+  header_ = nullptr;
+  barrier_seq_ = 0;
+}
+
+bool SharedMemoryChannel::CreateShm(size_t timeout_in_sec) {
+  // Remove the memory left by the process exited abnormally before attaching.
+  (void)shm_unlink(name_.c_str());
+  fd_ = shm_open(name_.c_str(), O_CREAT | O_EXCL | O_RDWR, S_IRUSR | S_IWUSR);
+  if (fd_ < 0) {
+    MS_LOG(ERROR) << "Create the shared memory " << name_ << " failed, errno: " << errno;
+    return false;
+  }
+  if (ftruncate(fd_, static_cast<off_t>(ShmSize())) != 0) {
+    MS_LOG(ERROR) << "Resize the shared memory " << name_ << " to " << ShmSize() << " failed, errno: " << errno;
+    (void)shm_unlink(name_.c_str());
+    return false;
+  }
+  shm_addr_ = mmap(nullptr, ShmSize(), PROT_READ | PROT_WRITE, MAP_SHARED, fd_, 0);
+  if (shm_addr_ == MAP_FAILED) {
+    shm_addr_ = nullptr;
+    MS_LOG(ERROR) << "Map the shared memory " << name_ << " failed, errno: " << errno;
+    (void)shm_unlink(name_.c_str());
+    return false;
+  }
+  header_ = new (shm_addr_) ShmHeader();
+  header_->attached_num.value.store(1, std::memory_order_relaxed);
+  header_->arrived_num.value.store(0, std::memory_order_relaxed);
+  header_->released_seq.value.store(0, std::memory_order_relaxed);
+  header_->magic.value.store(kShmMagic, std::memory_order_release);
+  FutexWake(&header_->magic.value);
+
+  auto &attached_num = header_->attached_num.value;
+  bool ret = WaitFlag(&attached_num, [this](uint32_t value) { return value == local_rank_size_; }, timeout_in_sec);
+  (void)shm_unlink(name_.c_str());
+  if (!ret) {
+    MS_LOG(ERROR) << "Wait for the local ranks to attach the shared memory " << name_ << " timeout, attached number: "
+                  << attached_num.load() << ", local rank size: " << local_rank_size_;
+    return false;
+  }
+  return true;
+}
+
+bool SharedMemoryChannel::AttachShm(size_t timeout_in_sec) {
+  auto start = std::chrono::steady_clock::now();
+  // The shared memory is ready once it's resized by the local rank 0.
+  while (true) {
+    fd_ = shm_open(name_.c_str(), O_RDWR, S_IRUSR | S_IWUSR);
+    if (fd_ >= 0) {
+      struct stat shm_stat = {};
+      if (fstat(fd_, &shm_stat) == 0 && static_cast<size_t>(shm_stat.st_size) >= ShmSize()) {
+        break;
+      }
+      (void)close(fd_);
+      fd_ = -1;
+    }
+    if (std::chrono::steady_clock::now() - start > std::chrono::seconds(timeout_in_sec)) {
+      MS_LOG(ERROR) << "Open the shared memory " << name_ << " timeout, errno: " << errno;
+      return false;
+    }
+    std::this_thread::sleep_for(std::chrono::milliseconds(kAttachRetryIntervalMs));
+  }
+  shm_addr_ = mmap(nullptr, ShmSize(), PROT_READ | PROT_WRITE, MAP_SHARED, fd_, 0);
+  if (shm_addr_ == MAP_FAILED) {
+    shm_addr_ = nullptr;
+    MS_LOG(ERROR) << "Map the shared memory " << name_ << " failed, errno: " << errno;
+    return false;
+  }
+  header_ = static_cast<ShmHeader *>(shm_addr_);
+  if (!WaitFlag(&header_->magic.value, [](uint32_t value) { return value == kShmMagic; }, timeout_in_sec)) {
+    MS_LOG(ERROR) << "Wait for the shared memory " << name_ << " to be initialized timeout.";
+    return false;
+  }
+  (void)header_->attached_num.value.fetch_add(1);
+  FutexWake(&header_->attached_num.value);
+  return true;
+}
+
+bool SharedMemoryChannel::Barrier() {
+  if (!CheckInitialized()) {
+    return false;
+  }
+  ++barrier_seq_;
+  // No local rank arrives at the next barrier before all the local ranks have arrived at this one, so the last one
+  // arriving at this barrier brings the arrived number to the multiple of the local rank size and releases the others.
+  auto &released_seq = header_->released_seq.value;
+  auto seq = static_cast<uint32_t>(barrier_seq_);
+  auto arrived_num = header_->arrived_num.value.fetch_add(1, std::memory_order_acq_rel) + 1;
+  if (arrived_num == barrier_seq_ * local_rank_size_) {
+    released_seq.store(seq, std::memory_order_release);
+    FutexWake(&released_seq);
+    return true;
+  }
+  if (!WaitFlag(&released_seq, [seq](uint32_t value) { return value == seq; }, wait_timeout_in_sec_)) {
+    MS_LOG(ERROR) << "Wait for the local ranks at the barrier " << barrier_seq_ << " timeout, arrived number: "
+                  << (header_->arrived_num.value.load() - (barrier_seq_ - 1) * local_rank_size_)
+                  << ", local rank size: " << local_rank_size_;
+    return false;
+  }
+  return true;
+}
+
+bool SharedMemoryChannel::AllReduce(const void *input, void *output, size_t data_size, TypeId data_type) {
+  return ReduceImpl(input, output, data_size, data_type, true);
+}
+
+bool SharedMemoryChannel::Reduce(const void *input, void *output, size_t data_size, TypeId data_type) {
+  return ReduceImpl(input, output, data_size, data_type, false);
+}
+
+bool SharedMemoryChannel::ReduceImpl(const void *input, void *output, size_t data_size, TypeId data_type,
+                                     bool all_ranks) {
+  MS_EXCEPTION_IF_NULL(input);
+  MS_EXCEPTION_IF_NULL(output);
+  if (!CheckInitialized()) {
+    return false;
+  }
+  const auto &sum_into = GetSumIntoFunc(data_type);
+  if (sum_into == nullptr) {
+    MS_LOG(ERROR) << "The shared memory channel doesn't support reducing the data type " << TypeIdLabel(data_type);
+    return false;
+  }
+  size_t type_size = abstract::TypeIdSize(data_type);
+  size_t piece_size = slot_size_ / type_size * type_size;
+  auto input_data = static_cast<const uint8_t *>(input);
+  auto output_data = static_cast<uint8_t *>(output);
+  for (size_t offset = 0; offset < data_size; offset += piece_size) {
+    size_t len = std::min(piece_size, data_size - offset);
+    auto ret = memcpy_s(Slot(local_rank_), slot_size_, input_data + offset, len);
+    if (ret != EOK) {
+      MS_LOG(ERROR) << "Copy the data to the shared memory failed, errorno(" << ret << ")";
+      return false;
+    }
+    if (!Barrier()) {
+      return false;
+    }
+    // Each local rank sums one segment of the piece into the slot of the local rank 0.
+    size_t num = len / type_size;
+    size_t segment = (num + local_rank_size_ - 1) / local_rank_size_;
+    size_t begin = std::min(local_rank_ * segment, num);
+    size_t end = std::min(begin + segment, num);
+    for (size_t i = 1; end > begin && i < local_rank_size_; i++) {
+      sum_into(Slot(0) + begin * type_size, Slot(i) + begin * type_size, end - begin);
+    }
+    if (!Barrier()) {
+      return false;
+    }
+    if (all_ranks || local_rank_ == 0) {
+      ret = memcpy_s(output_data + offset, data_size - offset, Slot(0), len);
+      if (ret != EOK) {
+        MS_LOG(ERROR) << "Copy the data from the shared memory failed, errorno(" << ret << ")";
+        return false;
+      }
+    }
+    // The slots are overwritten by the next piece.
+    if (!Barrier()) {
+      return false;
+    }
+  }
+  return true;
+}
+
+bool SharedMemoryChannel::Broadcast(void *data, size_t data_size, size_t root) {
+  MS_EXCEPTION_IF_NULL(data);
+  if (!CheckInitialized()) {
+    return false;
+  }
+  if (root >= local_rank_size_) {
+    MS_LOG(ERROR) << "Invalid root local rank " << root << " of the local rank size " << local_rank_size_;
+    return false;
+  }
+  auto buff = static_cast<uint8_t *>(data);
+  for (size_t offset = 0; offset < data_size; offset += slot_size_) {
+    size_t len = std::min(slot_size_, data_size - offset);
+    if (local_rank_ == root) {
+      auto ret = memcpy_s(Slot(root), slot_size_, buff + offset, len);
+      if (ret != EOK) {
+        MS_LOG(ERROR) << "Copy the data to the shared memory failed, errorno(" << ret << ")";
+        return false;
+      }
+    }
+    if (!Barrier()) {
+      return false;
+    }
+    if (local_rank_ != root) {
+      auto ret = memcpy_s(buff + offset, data_size - offset, Slot(root), len);
+      if (ret != EOK) {
+        MS_LOG(ERROR) << "Copy the data from the shared memory failed, errorno(" << ret << ")";
+        return false;
+      }
+    }
+    if (!Barrier()) {
+      return false;
+    }
+  }
+  return true;
+}
+
+bool SharedMemoryChannel::Gather(const void *input, void *output, size_t data_size, size_t root) {
+  if (root >= local_rank_size_) {
+    MS_LOG(ERROR) << "Invalid root local rank " << root << " of the local rank size " << local_rank_size_;
+    return false;
+  }
+  return GatherImpl(input, output, data_size, root, false);
+}
+
+bool SharedMemoryChannel::AllGather(const void *input, void *output, size_t data_size) {
+  return GatherImpl(input, output, data_size, 0, true);
+}
+
+bool SharedMemoryChannel::GatherImpl(const void *input, void *output, size_t data_size, size_t root,
+                                     bool all_ranks) {
+  MS_EXCEPTION_IF_NULL(input);
+  if (!CheckInitialized()) {
+    return false;
+  }
+  auto input_data = static_cast<const uint8_t *>(input);
+  auto output_data = static_cast<uint8_t *>(output);
+  bool receive = all_ranks || local_rank_ == root;
+  if (receive) {
+    MS_EXCEPTION_IF_NULL(output);
+  }
+  size_t output_size = data_size * local_rank_size_;
+  for (size_t offset = 0; offset < data_size; offset += slot_size_) {
+    size_t len = std::min(slot_size_, data_size - offset);
+    auto ret = memcpy_s(Slot(local_rank_), slot_size_, input_data + offset, len);
+    if (ret != EOK) {
+      MS_LOG(ERROR) << "Copy the data to the shared memory failed, errorno(" << ret << ")";
+      return false;
+    }
+    if (!Barrier()) {
+      return false;
+    }
+    for (size_t i = 0; receive && i < local_rank_size_; i++) {
+      size_t dst_offset = i * data_size + offset;
+      ret = memcpy_s(output_data + dst_offset, output_size - dst_offset, Slot(i), len);
+      if (ret != EOK) {
+        MS_LOG(ERROR) << "Copy the data from the shared memory failed, errorno(" << ret << ")";
+        return false;
+      }
+    }
+    if (!Barrier()) {
+      return false;
+    }
+  }
+  return true;
+}
+
+bool SharedMemoryChannel::CheckInitialized() const {
+  if (header_ == nullptr) {
+    MS_LOG(ERROR) << "The shared memory channel " << name_ << " is not initialized.";
+    return false;
+  }
+  return true;
+}
+
+uint8_t *SharedMemoryChannel::Slot(size_t local_rank) const {
+  return static_cast<uint8_t *>(shm_addr_) + sizeof(ShmHeader) + local_rank * slot_size_;
+}
+
+size_t SharedMemoryChannel::ShmSize() const { return sizeof(ShmHeader) + slot_size_ * local_rank_size_; }
+}  // namespace cpu
+}  // namespace device
+}  // namespace mindspore
@@ -0,0 +1,108 @@
+/**
+ * Copyright 2022 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef MINDSPORE_CCSRC_RUNTIME_HARDWARE_CPU_MS_COLLECTIVE_SHM_H_
+#define MINDSPORE_CCSRC_RUNTIME_HARDWARE_CPU_MS_COLLECTIVE_SHM_H_
+
+#include <atomic>
+#include <string>
+#include "mindapi/base/type_id.h"
+
+namespace mindspore {
+namespace device {
+namespace cpu {
+// The max number of the local ranks on one host which share the memory channel.
+constexpr size_t kMaxShmLocalRankNum = 64;
+// The default size in bytes of the slot of each local rank in the shared memory.
+constexpr size_t kDefaultShmSlotSize = 1024 * 1024;
+
+// The transport of the collective communication between the ranks on the same host through the POSIX shared memory.
+// Every local rank owns one slot of the shared memory, and the data larger than the slot is transferred piece by piece.
+// All the local ranks must call the collective operations in the same order, and each operation returns on all the
+// local ranks after it's done. The local rank 0 creates the shared memory and unlinks it once all the local ranks have
+// attached, so the memory is released by the system even if the processes exit abnormally.
+class SharedMemoryChannel {
+ public:
+  SharedMemoryChannel(const std::string &name, size_t local_rank, size_t local_rank_size,
+                      size_t slot_size = kDefaultShmSlotSize)
+      : name_(name), local_rank_(local_rank), local_rank_size_(local_rank_size), slot_size_(slot_size) {}
+  ~SharedMemoryChannel() { Finalize(); }
+
+  // Create or attach the shared memory, it returns after all the local ranks have attached. The wait timeout bounds
+  // each wait for the other local ranks in the collective operations, which must cover the time the local rank 0 spends
+  // on the collectives between the hosts.
+  bool Initialize(size_t timeout_in_sec = kDefaultTimeout, size_t wait_timeout_in_sec = kDefaultWaitTimeout);
+  void Finalize();
+
+  // Wait until all the local ranks arrive.
+  bool Barrier();
+
+  // Sum the data of all the local ranks into the output of all the local ranks. The input and output can be the same.
+  bool AllReduce(const void *input, void *output, size_t data_size, TypeId data_type);
+  // Sum the data of all the local ranks into the output of the local rank 0, the output of others is not touched.
+  bool Reduce(const void *input, void *output, size_t data_size, TypeId data_type);
+  // Copy the data of the local rank root to the data of the others.
+  bool Broadcast(void *data, size_t data_size, size_t root);
+  // Gather the data of all the local ranks in the order of the local rank into the output of the local rank root.
+  bool Gather(const void *input, void *output, size_t data_size, size_t root);
+  // Gather the data of all the local ranks in the order of the local rank into the output of all the local ranks.
+  bool AllGather(const void *input, void *output, size_t data_size);
+
+  size_t local_rank() const { return local_rank_; }
+  size_t local_rank_size() const { return local_rank_size_; }
+
+ private:
+  static constexpr size_t kDefaultTimeout = 30;
+  static constexpr size_t kDefaultWaitTimeout = 600;
+
+  // The header at the beginning of the shared memory, each flag is in its own cache line. The 32-bit flags are also
+  // the futex words which the local ranks sleep on.
+  template <typename T>
+  struct alignas(64) ShmFlag {
+    std::atomic<T> value;
+  };
+  struct ShmHeader {
+    ShmFlag<uint32_t> magic;
+    ShmFlag<uint32_t> attached_num;
+    // The total number of the arrivals at all the barriers.
+    ShmFlag<uint64_t> arrived_num;
+    // The low 32 bits of the sequence of the last barrier which all the local ranks have arrived at.
+    ShmFlag<uint32_t> released_seq;
+  };
+
+  bool ReduceImpl(const void *input, void *output, size_t data_size, TypeId data_type, bool all_ranks);
+  bool GatherImpl(const void *input, void *output, size_t data_size, size_t root, bool all_ranks);
+  bool CheckInitialized() const;
+  uint8_t *Slot(size_t local_rank) const;
+  size_t ShmSize() const;
+  bool CreateShm(size_t timeout_in_sec);
+  bool AttachShm(size_t timeout_in_sec);
+
+  std::string name_;
+  size_t local_rank_;
+  size_t local_rank_size_;
+  size_t slot_size_;
+
+  int fd_{-1};
+  void *shm_addr_{nullptr};
+  ShmHeader *header_{nullptr};
+  uint64_t barrier_seq_{0};
+  size_t wait_timeout_in_sec_{kDefaultWaitTimeout};
+};
+}  // namespace cpu
+}  // namespace device
+}  // namespace mindspore
+#endif  // MINDSPORE_CCSRC_RUNTIME_HARDWARE_CPU_MS_COLLECTIVE_SHM_H_
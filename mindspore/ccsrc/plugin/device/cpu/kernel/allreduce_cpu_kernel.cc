@@ -45,6 +45,7 @@ void AllReduceCPUKernelMod::InitKernel(const CNodePtr &kernel_node) {
   if (!is_match) {
     MS_LOG(EXCEPTION) << kernel_name_ << " does not support this kernel data type: " << kernel_attr;
   }
+  data_type_ = AnfAlgo::GetInputDeviceDataType(kernel_node, 0);
   auto group = common::AnfAlgo::GetNodeAttr<std::string>(kernel_node, GROUP);
   if (group != kMCCLGlobalGroupName) {
     MS_LOG(EXCEPTION) << kernel_name_ << " only support " << kMCCLGlobalGroupName << " on CPU, but got " << group;
@@ -60,7 +61,11 @@ void AllReduceCPUKernelMod::InitKernel(const CNodePtr &kernel_node) {
 
 std::vector<KernelAttr> AllReduceCPUKernelMod::GetOpSupport() {
   static std::vector<KernelAttr> support_list = {
-    KernelAttr().AddAllSameAttr(true).AddInputAttr(kNumberTypeFloat32).AddOutputAttr(kNumberTypeFloat32)};
+    KernelAttr().AddAllSameAttr(true).AddInputAttr(kNumberTypeFloat32).AddOutputAttr(kNumberTypeFloat32),
+    KernelAttr().AddAllSameAttr(true).AddInputAttr(kNumberTypeFloat16).AddOutputAttr(kNumberTypeFloat16),
+    KernelAttr().AddAllSameAttr(true).AddInputAttr(kNumberTypeInt8).AddOutputAttr(kNumberTypeInt8),
+    KernelAttr().AddAllSameAttr(true).AddInputAttr(kNumberTypeInt32).AddOutputAttr(kNumberTypeInt32),
+    KernelAttr().AddAllSameAttr(true).AddInputAttr(kNumberTypeInt64).AddOutputAttr(kNumberTypeInt64)};
   return support_list;
 }
 
@@ -75,8 +80,8 @@ bool AllReduceCPUKernelMod::Launch(const std::vector<kernel::AddressPtr> &inputs
   for (size_t i = 0; i < inputs.size(); ++i) {
     data_size += inputs[i]->size;
   }
-  bool ret = MsCollectiveCommLib::GetInstance().AllReduce(inputs[0]->addr, outputs[0]->addr, data_size,
-                                                          kNumberTypeFloat32, Reduce_Sum, kMCCLGlobalGroupName);
+  bool ret = MsCollectiveCommLib::GetInstance().AllReduce(inputs[0]->addr, outputs[0]->addr, data_size, data_type_,
+                                                          Reduce_Sum, kMCCLGlobalGroupName);
   if (!ret) {
     MS_LOG(ERROR) << "AllReduceCPUKernelMod launch failed.";
   }
@@ -37,6 +37,9 @@ class AllReduceCPUKernelMod : public DeprecatedNativeCpuKernelMod {
 
  protected:
   std::vector<KernelAttr> GetOpSupport() override;
+
+ private:
+  TypeId data_type_{kNumberTypeFloat32};
 };
 }  // namespace kernel
 }  // namespace mindspore
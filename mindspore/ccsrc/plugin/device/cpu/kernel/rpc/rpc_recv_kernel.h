@@ -38,10 +38,17 @@ class RpcRecvKernelMod : public RpcKernelMod {
     }
 
     MS_EXCEPTION_IF_NULL(remote_input_);
+    // Only the send side is zero-copy. The inputs may be weights or value nodes whose memory is persisted, and the
+    // memory manager allocates the others only after the body has been read from the socket, so the body is copied.
+    const std::string &body = remote_input_->Body();
+    size_t body_size = body.size();
     size_t offset = 0;
     for (size_t i = 0; i < inputs.size(); i++) {
       MS_EXCEPTION_IF_NULL(inputs[i]->addr);
-      int ret = memcpy_s(inputs[i]->addr, inputs[i]->size, remote_input_->Body().data() + offset, inputs[i]->size);
+      if (offset + inputs[i]->size > body_size) {
+        MS_LOG(EXCEPTION) << "The size of the received data " << body_size << " is less than the size of the inputs.";
+      }
+      int ret = memcpy_s(inputs[i]->addr, inputs[i]->size, body.data() + offset, inputs[i]->size);
       if (ret != 0) {
         MS_LOG(EXCEPTION) << "memcpy_s for recv output failed, ret code: " << ret;
       }
@@ -18,6 +18,7 @@
 #include <algorithm>
 #include <thread>
 #include <set>
+#include <shared_mutex>
 
 #include "utils/file_utils.h"
 
@@ -385,9 +386,28 @@ void ParameterServer::InitEmbeddingTable(
     is_embedding_[key] = true;
 
     grads_accum_counter_[key] = 0;
+    InitStripedEmbeddingTable(key);
   }
 }
 
+void ParameterServer::InitStripedEmbeddingTable(const Key &key) {
+  WeightPtr table_ptr = weights_[key];
+  MS_EXCEPTION_IF_NULL(table_ptr);
+  std::shared_ptr<PServerKernel> lookup_op = embedding_lookup_ops_[key];
+  MS_EXCEPTION_IF_NULL(lookup_op);
+  const std::vector<size_t> &input_shapes = lookup_op->input_sizes();
+  if (input_shapes.empty() || input_shapes[0] == 0) {
+    MS_LOG(EXCEPTION) << "The shape of the embedding table of key " << key << " is empty.";
+  }
+  size_t row_num = input_shapes[0];
+  size_t row_size = table_ptr->size() / row_num;
+  auto striped_table =
+    std::make_shared<StripedEmbeddingTable>(table_ptr->data(), row_num, row_size, lookup_op->offset());
+
+  std::unique_lock<std::shared_mutex> lock(striped_tables_mutex_);
+  striped_tables_[key] = striped_table;
+}
+
 bool ParameterServer::HasWeight(const Key &key) { return (weights_.count(key) > 0 && !is_embedding_.count(key)); }
 
 void ParameterServer::Finalize() {
@@ -407,6 +427,8 @@ void ParameterServer::UpdateWeights() {
     if (!running_) {
       break;
     }
+    // The optimizers update the embedding tables in place, which is exclusive with the lookups.
+    std::unique_lock<std::shared_mutex> tables_lock(striped_tables_mutex_);
 
     for (auto iter = weights_.begin(); iter != weights_.end(); iter++) {
       Key key = iter->first;
@@ -420,6 +442,12 @@ void ParameterServer::UpdateWeights() {
 
       std::shared_ptr<OptimizerInfo> optim_info = optim_infos_[key];
       if (optim_info != nullptr) {
+        // The gradients of the key may still be accumulated by AccumGrad, which holds only the mutex of the key.
+        std::unique_lock<std::mutex> accum_lock;
+        auto accum_mutex_iter = accum_grad_mutexes_.find(key);
+        if (accum_mutex_iter != accum_grad_mutexes_.end() && accum_mutex_iter->second != nullptr) {
+          accum_lock = std::unique_lock<std::mutex>(*accum_mutex_iter->second);
+        }
         const std::vector<kernel::AddressPtr> &inputs = optim_info->inputs();
         const std::vector<kernel::AddressPtr> &workspaces = optim_info->workspaces();
         const std::vector<kernel::AddressPtr> &outputs = optim_info->outputs();
@@ -450,30 +478,44 @@ void ParameterServer::UpdateWeights() {
 }
 
 void ParameterServer::AccumGrad(const Keys &keys, const Values &values, const Lengths &lengths) {
-  std::unique_lock<std::mutex> lock(mutex_);
   const Key &key = keys[0];
   bool no_sparse_grad = values.size() == 1 && values[0] == kGradValue;
   if (!no_sparse_grad) {
-    std::shared_ptr<OptimizerInfo> optim_info = optim_infos_[key];
-
-    // Create or update the optimizer info
-    if (optim_info == nullptr) {
-      const std::shared_ptr<OptimizerInfoBuilder> &builder = optim_info_builders_[weight_key_to_optims_[key]];
-      std::shared_ptr<kernel::ps::PServerKernel> pserver_kernel = optimizers_[key];
-      if (pserver_kernel == nullptr) {
-        MS_LOG(EXCEPTION) << "no optimizer found for key " << key << " optim name " << weight_key_to_optims_[key];
+    std::shared_ptr<OptimizerInfo> optim_info = nullptr;
+    std::shared_ptr<std::mutex> accum_mutex = nullptr;
+    {
+      std::unique_lock<std::mutex> lock(mutex_);
+      optim_info = optim_infos_[key];
+      // Create the optimizer info by the first gradients, or get the mutex to accumulate the gradients of this key.
+      if (optim_info == nullptr) {
+        const std::shared_ptr<OptimizerInfoBuilder> &builder = optim_info_builders_[weight_key_to_optims_[key]];
+        std::shared_ptr<kernel::ps::PServerKernel> pserver_kernel = optimizers_[key];
+        if (pserver_kernel == nullptr) {
+          MS_LOG(EXCEPTION) << "no optimizer found for key " << key << " optim name " << weight_key_to_optims_[key];
+        }
+        MS_EXCEPTION_IF_NULL(pserver_kernel);
+        OptimizerInfo *optim = builder->Build(pserver_kernel, weights_[key], keys, values, lengths,
+                                              optim_inputs_shape_[key], worker_num_, is_embedding_[key]);
+        optim_info.reset(optim);
+        optim_infos_[key] = optim_info;
+      } else {
+        auto &key_mutex = accum_grad_mutexes_[key];
+        if (key_mutex == nullptr) {
+          key_mutex = std::make_shared<std::mutex>();
+        }
+        accum_mutex = key_mutex;
       }
-      MS_EXCEPTION_IF_NULL(pserver_kernel);
-      OptimizerInfo *optim = builder->Build(pserver_kernel, weights_[key], keys, values, lengths,
-                                            optim_inputs_shape_[key], worker_num_, is_embedding_[key]);
-      optim_info.reset(optim);
-      optim_infos_[key] = optim_info;
-    } else {
+    }
+
+    // The counter of the key is increased after the accumulation, so the weights are never updated in the middle.
+    if (accum_mutex != nullptr) {
+      std::unique_lock<std::mutex> accum_lock(*accum_mutex);
       optim_info->Update(values, lengths);
       optim_info->Accumulate(values, lengths);
     }
   }
 
+  std::unique_lock<std::mutex> lock(mutex_);
   grads_accum_counter_[key] += 1;
   if (grads_accum_counter_[key] == worker_num_) {
     grad_accum_count_++;
@@ -501,60 +543,22 @@ void ParameterServer::DoEmbeddingLookup(Key key, const LookupIds &lookup_ids, KV
     }
   }
 
-  std::unique_lock<std::mutex> lock(mutex_);
   MS_EXCEPTION_IF_NULL(res);
-  if (weights_.count(key) == 0) {
+  std::shared_lock<std::shared_mutex> lock(striped_tables_mutex_);
+  auto iter = striped_tables_.find(key);
+  if (iter == striped_tables_.end()) {
     MS_LOG(ERROR) << "Invalid embedding table key " << key;
     return;
   }
-  if (embedding_lookup_ops_.count(key) == 0) {
-    MS_LOG(ERROR) << "Invalid embedding lookup op key " << key;
-    return;
+  const StripedEmbeddingTablePtr &table = iter->second;
+  MS_EXCEPTION_IF_NULL(table);
+
+  // Look up the rows into the response directly.
+  size_t values_size = lookup_ids.size() * table->row_size();
+  res->mutable_values()->Resize(SizeToInt(values_size), 0);
+  if (!table->Lookup(lookup_ids, res->mutable_values()->mutable_data(), values_size)) {
+    MS_LOG(EXCEPTION) << "Look up the embedding table of key " << key << " failed.";
   }
-  WeightPtr table_ptr = weights_[key];
-  MS_EXCEPTION_IF_NULL(table_ptr);
-  std::shared_ptr<PServerKernel> table_lookup_op = embedding_lookup_ops_[key];
-  MS_EXCEPTION_IF_NULL(table_lookup_op);
-
-  // Update shapes of lookup operator
-  std::vector<std::vector<size_t>> shapes = {};
-  std::vector<size_t> indices_shape = {};
-  indices_shape.emplace_back(lookup_ids.size());
-  shapes.push_back(indices_shape);
-  table_lookup_op->ReInit(shapes);
-
-  const std::vector<size_t> output_shapes = table_lookup_op->output_sizes();
-  std::vector<kernel::AddressPtr> inputs;
-  AddressPtr embedding_table = std::make_shared<kernel::Address>();
-  MS_EXCEPTION_IF_NULL(embedding_table);
-  AddressPtr indices = std::make_shared<kernel::Address>();
-  MS_EXCEPTION_IF_NULL(indices);
-  inputs.push_back(embedding_table);
-  inputs.push_back(indices);
-  embedding_table->addr = table_ptr->data();
-  embedding_table->size = table_ptr->size() * sizeof(float);
-
-  std::unique_ptr<int[]> tmp_ids = std::make_unique<int[]>(lookup_ids.size());
-  MS_EXCEPTION_IF_NULL(tmp_ids);
-  for (size_t i = 0; i < lookup_ids.size(); i++) {
-    tmp_ids[i] = static_cast<int>(lookup_ids[i]);
-  }
-  indices->addr = tmp_ids.get();
-  indices->size = lookup_ids.size() * sizeof(int);
-
-  std::vector<kernel::AddressPtr> workspaces;
-  std::vector<kernel::AddressPtr> outputs;
-  AddressPtr output = std::make_shared<kernel::Address>();
-  MS_EXCEPTION_IF_NULL(output);
-  std::shared_ptr<Values> addr = std::make_shared<Values>(output_shapes[0] / sizeof(float), 0);
-  MS_EXCEPTION_IF_NULL(addr);
-
-  output->addr = addr->data();
-  output->size = output_shapes[0];
-  outputs.push_back(output);
-
-  table_lookup_op->Execute(inputs, workspaces, outputs);
-  *res->mutable_values() = {addr->begin(), addr->end()};
   res->add_len(res->values_size());
 }
 
@@ -565,23 +569,24 @@ void ParameterServer::UpdateEmbeddings(const Key &key, const LookupIds &lookup_i
     }
   }
 
-  std::unique_lock<std::mutex> locker(access_weight_mutex_);
-
-  if (weights_.count(key) == 0) {
+  // The persistence reads the whole tables and the dirty info, so it's exclusive with the updates.
+  std::unique_lock<std::mutex> locker(access_weight_mutex_, std::defer_lock);
+  if (EnableRecovery()) {
+    locker.lock();
+  }
+  std::shared_lock<std::shared_mutex> lock(striped_tables_mutex_);
+  auto iter = striped_tables_.find(key);
+  if (iter == striped_tables_.end()) {
     MS_LOG(ERROR) << "Invalid embedding table key " << key;
     return;
   }
-  if (embedding_lookup_ops_.count(key) == 0) {
-    MS_LOG(ERROR) << "Invalid embedding lookup op key " << key;
-    return;
+  const StripedEmbeddingTablePtr &table = iter->second;
+  MS_EXCEPTION_IF_NULL(table);
+  if (!table->Update(lookup_ids, vals.data(), vals.size())) {
+    MS_LOG(EXCEPTION) << "UpdateEmbeddings of key " << key << " failed.";
   }
-  WeightPtr table_ptr = weights_[key];
-  MS_EXCEPTION_IF_NULL(table_ptr);
-  std::shared_ptr<PServerKernel> lookup_op = embedding_lookup_ops_[key];
-  MS_EXCEPTION_IF_NULL(lookup_op);
-  lookup_op->UpdateEmbeddings(table_ptr->data(), lookup_ids.data(), vals.data(), lookup_ids.size());
 
-  UpdateDirtyInfo(key, lookup_ids, lookup_op->offset());
+  UpdateDirtyInfo(key, lookup_ids, table->offset());
 }
 
 void ParameterServer::UpdateDirtyInfo(const Key &key, const LookupIds &lookup_ids, int64_t offset) {
@@ -773,6 +778,7 @@ void ParameterServer::RecoverParameters(const std::vector<Key> &keys) {
       embedding->Restore();
       weights_[key] = embedding;
       (void)weights_dirty_info_.emplace(key, distributed::storage::DirtyInfo());
+      InitStripedEmbeddingTable(key);
     }
   }
 }
@@ -1122,7 +1128,6 @@ void ParameterServer::ServerHandler::HandleEmbeddingLookup(const void *data, siz
 }
 
 void ParameterServer::ServerHandler::HandleUpdateEmbeddings(const void *data, size_t size, const VectorPtr &res) {
-  std::unique_lock<std::mutex> lock(ps_->mutex());
   MS_EXCEPTION_IF_NULL(data);
   MS_EXCEPTION_IF_NULL(res);
   KVMessage input;
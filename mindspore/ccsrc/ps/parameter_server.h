@@ -23,6 +23,7 @@
 #include <memory>
 #include <vector>
 #include <mutex>
+#include <shared_mutex>
 #include <condition_variable>
 #include <thread>
 #include <cmath>
@@ -58,6 +59,7 @@
 #include "ps/constants.h"
 #include "ps/util.h"
 #include "ps/embedding_table_shard_metadata.h"
+#include "ps/striped_embedding_table.h"
 #include "utils/log_adapter.h"
 #include "proto/comm.pb.h"
 #include "proto/ps.pb.h"
@@ -151,6 +153,9 @@ class BACKEND_EXPORT ParameterServer {
   void InitEmbeddingTable(const Key &key,
                           const std::shared_ptr<std::vector<std::shared_ptr<std::vector<size_t>>>> &shapes,
                           const ParamInitInfo &param_init_info);
+  // Create the striped view of the embedding table for the lookups and updates, which must be called after the table
+  // and its lookup kernel are created.
+  void InitStripedEmbeddingTable(const Key &key);
   bool HasWeight(const Key &key);
   void Finalize();
   void UpdateWeights();
@@ -228,10 +233,17 @@ class BACKEND_EXPORT ParameterServer {
   mindspore::HashMap<Key, size_t> grads_accum_counter_;
   mindspore::HashMap<Key, std::shared_ptr<PServerKernel>> embedding_lookup_ops_;
   mindspore::HashMap<Key, uint64_t> tokens_;
+  // The mutex of each key to accumulate its gradients, so the gradients of different keys are accumulated concurrently.
+  mindspore::HashMap<Key, std::shared_ptr<std::mutex>> accum_grad_mutexes_;
 
   std::mutex mutex_;
   std::condition_variable apply_grads_cv_;
 
+  // The lookups and updates of the embedding tables hold the shared lock of striped_tables_mutex_ and then lock the
+  // stripes of the rows they touch, while creating the tables and applying the optimizers hold the exclusive lock.
+  mindspore::HashMap<Key, StripedEmbeddingTablePtr> striped_tables_;
+  std::shared_mutex striped_tables_mutex_;
+
   std::mutex access_weight_mutex_;
   std::unique_ptr<std::thread> thread_;
   std::unique_ptr<std::thread> persist_thread_;
@@ -0,0 +1,229 @@
+/**
+ * Copyright 2022 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "ps/ps_cache/embedding_cache_policy.h"
+#include <algorithm>
+#include "utils/convert_utils_base.h"
+#include "utils/log_adapter.h"
+
+namespace mindspore {
+namespace ps {
+namespace {
+constexpr size_t kSketchDepth = 4;
+constexpr size_t kMinSketchWidth = 16;
+constexpr uint8_t kMaxSketchCounter = UINT8_MAX;
+constexpr uint64_t kSketchSeeds[kSketchDepth] = {0x9e3779b97f4a7c15ULL, 0xbf58476d1ce4e5b9ULL, 0x94d049bb133111ebULL,
+                                                 0x2545f4914f6cdd1dULL};
+// The frequencies of LFU are halved after the accesses of this times of the capacity.
+constexpr size_t kLFUDecayFactor = 10;
+}  // namespace
+
+CountMinSketch::CountMinSketch(size_t width, size_t sample_size) : sample_size_(std::max<size_t>(sample_size, 1)) {
+  size_t round_width = kMinSketchWidth;
+  while (round_width < width) {
+    round_width <<= 1;
+  }
+  width_mask_ = round_width - 1;
+  counters_.resize(kSketchDepth * round_width, 0);
+}
+
+size_t CountMinSketch::Position(int id, size_t row) const {
+  uint64_t hash = static_cast<uint64_t>(static_cast<uint32_t>(id)) + kSketchSeeds[row];
+  hash = (hash ^ (hash >> 33)) * 0xff51afd7ed558ccdULL;
+  hash = (hash ^ (hash >> 33)) * 0xc4ceb9fe1a85ec53ULL;
+  hash ^= hash >> 33;
+  return row * (width_mask_ + 1) + static_cast<size_t>(hash & width_mask_);
+}
+
+void CountMinSketch::Add(int id) {
+  // Conservative update: only the counters equal to the estimation are increased, which reduces the overestimation
+  // caused by the collisions.
+  auto estimate = Estimate(id);
+  if (estimate < kMaxSketchCounter) {
+    for (size_t row = 0; row < kSketchDepth; ++row) {
+      auto &counter = counters_[Position(id, row)];
+      if (counter == estimate) {
+        ++counter;
+      }
+    }
+  }
+  if (++added_num_ >= sample_size_) {
+    Halve();
+  }
+}
+
+uint32_t CountMinSketch::Estimate(int id) const {
+  uint32_t estimate = kMaxSketchCounter;
+  for (size_t row = 0; row < kSketchDepth; ++row) {
+    estimate = std::min<uint32_t>(estimate, counters_[Position(id, row)]);
+  }
+  return estimate;
+}
+
+void CountMinSketch::Halve() {
+  for (auto &counter : counters_) {
+    counter >>= 1;
+  }
+  added_num_ >>= 1;
+}
+
+LFUCachePolicy::LFUCachePolicy(size_t capacity, size_t decay_period)
+    : nodes_(capacity), buckets_(kMaxCacheFrequency + 1), decay_period_(std::max<size_t>(decay_period, 1)) {}
+
+void LFUCachePolicy::Insert(int index, int, size_t step) {
+  auto &node = nodes_[IntToSize(index)];
+  node.step = step;
+  node.freq = 1;
+  node.pos = buckets_[node.freq].insert(buckets_[node.freq].end(), index);
+}
+
+void LFUCachePolicy::Access(int index, size_t step) {
+  auto &node = nodes_[IntToSize(index)];
+  node.step = step;
+  auto &bucket = buckets_[node.freq];
+  if (node.freq < kMaxCacheFrequency) {
+    ++node.freq;
+  }
+  auto &new_bucket = buckets_[node.freq];
+  new_bucket.splice(new_bucket.end(), bucket, node.pos);
+  if (++access_num_ >= decay_period_) {
+    Decay();
+    access_num_ = 0;
+  }
+}
+
+void LFUCachePolicy::Refresh(int index, size_t step) {
+  auto &node = nodes_[IntToSize(index)];
+  node.step = step;
+  auto &bucket = buckets_[node.freq];
+  bucket.splice(bucket.end(), bucket, node.pos);
+}
+
+void LFUCachePolicy::Erase(int index) {
+  auto &node = nodes_[IntToSize(index)];
+  (void)buckets_[node.freq].erase(node.pos);
+  node.freq = 0;
+}
+
+bool LFUCachePolicy::Victim(int, size_t graph_running_step, bool wait_graph, int *index) {
+  MS_EXCEPTION_IF_NULL(index);
+  for (size_t freq = 1; freq <= kMaxCacheFrequency; ++freq) {
+    const auto &bucket = buckets_[freq];
+    if (!bucket.empty() && Evictable(nodes_[IntToSize(bucket.front())].step, graph_running_step, wait_graph)) {
+      *index = bucket.front();
+      return true;
+    }
+  }
+  return false;
+}
+
+void LFUCachePolicy::Decay() {
+  // The bucket of the half frequency has been moved out before it's merged into, and the merge keeps the elements in
+  // the order of the step.
+  auto step_less = [this](int lhs, int rhs) { return nodes_[IntToSize(lhs)].step < nodes_[IntToSize(rhs)].step; };
+  for (size_t freq = 2; freq <= kMaxCacheFrequency; ++freq) {
+    auto &bucket = buckets_[freq];
+    for (auto index : bucket) {
+      nodes_[IntToSize(index)].freq = freq / 2;
+    }
+    buckets_[freq / 2].merge(bucket, step_less);
+  }
+}
+
+ARCCachePolicy::ARCCachePolicy(size_t capacity) : capacity_(capacity), nodes_(capacity) {}
+
+void ARCCachePolicy::Insert(int index, int id, size_t step) {
+  auto &node = nodes_[IntToSize(index)];
+  node.step = step;
+  node.id = id;
+  node.frequent = false;
+  auto iter = ghosts_.find(id);
+  if (iter != ghosts_.end()) {
+    // The id evicted from the recent list is accessed again, which means the recent list should be larger, and vice
+    // versa.
+    if (!iter->second.first) {
+      auto delta = std::max<size_t>(frequent_ghosts_.size() / recent_ghosts_.size(), 1);
+      target_recent_size_ = std::min(capacity_, target_recent_size_ + delta);
+      (void)recent_ghosts_.erase(iter->second.second);
+    } else {
+      auto delta = std::max<size_t>(recent_ghosts_.size() / frequent_ghosts_.size(), 1);
+      target_recent_size_ = target_recent_size_ > delta ? target_recent_size_ - delta : 0;
+      (void)frequent_ghosts_.erase(iter->second.second);
+    }
+    (void)ghosts_.erase(iter);
+    node.frequent = true;
+  }
+  auto &list = node.frequent ? frequent_ : recent_;
+  node.pos = list.insert(list.end(), index);
+}
+
+void ARCCachePolicy::Access(int index, size_t step) {
+  auto &node = nodes_[IntToSize(index)];
+  node.step = step;
+  frequent_.splice(frequent_.end(), node.frequent ? frequent_ : recent_, node.pos);
+  node.frequent = true;
+}
+
+void ARCCachePolicy::Refresh(int index, size_t step) {
+  auto &node = nodes_[IntToSize(index)];
+  node.step = step;
+  auto &list = node.frequent ? frequent_ : recent_;
+  list.splice(list.end(), list, node.pos);
+}
+
+void ARCCachePolicy::Erase(int index) {
+  auto &node = nodes_[IntToSize(index)];
+  (void)(node.frequent ? frequent_ : recent_).erase(node.pos);
+  AddGhost(node.id, node.frequent);
+}
+
+void ARCCachePolicy::AddGhost(int id, bool frequent) {
+  auto &ghost_list = frequent ? frequent_ghosts_ : recent_ghosts_;
+  ghosts_[id] = std::make_pair(frequent, ghost_list.insert(ghost_list.end(), id));
+  while (ghost_list.size() > capacity_) {
+    (void)ghosts_.erase(ghost_list.front());
+    ghost_list.pop_front();
+  }
+}
+
+bool ARCCachePolicy::Victim(int id, size_t graph_running_step, bool wait_graph, int *index) {
+  MS_EXCEPTION_IF_NULL(index);
+  bool recent_first = !recent_.empty() && (frequent_.empty() || recent_.size() > target_recent_size_);
+  if (!recent_first && !recent_.empty() && recent_.size() == target_recent_size_) {
+    auto iter = ghosts_.find(id);
+    recent_first = iter != ghosts_.end() && iter->second.first;
+  }
+  const std::list<int> *lists[] = {recent_first ? &recent_ : &frequent_, recent_first ? &frequent_ : &recent_};
+  for (const auto list : lists) {
+    if (!list->empty() && Evictable(nodes_[IntToSize(list->front())].step, graph_running_step, wait_graph)) {
+      *index = list->front();
+      return true;
+    }
+  }
+  return false;
+}
+
+std::unique_ptr<EmbeddingCachePolicy> CreateEmbeddingCachePolicy(const std::string &name, size_t capacity) {
+  if (name == kLFUCachePolicy) {
+    return std::make_unique<LFUCachePolicy>(capacity, kLFUDecayFactor * capacity);
+  }
+  if (name == kARCCachePolicy) {
+    return std::make_unique<ARCCachePolicy>(capacity);
+  }
+  return nullptr;
+}
+}  // namespace ps
+}  // namespace mindspore
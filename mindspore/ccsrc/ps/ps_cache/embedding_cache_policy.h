@@ -0,0 +1,150 @@
+/**
+ * Copyright 2022 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef MINDSPORE_CCSRC_PS_PS_CACHE_EMBEDDING_CACHE_POLICY_H_
+#define MINDSPORE_CCSRC_PS_PS_CACHE_EMBEDDING_CACHE_POLICY_H_
+
+#include <list>
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+#include "utils/hash_map.h"
+
+namespace mindspore {
+namespace ps {
+// The names of the eviction policies of the embedding cache. The step policy evicts the element whose step is expired
+// by scanning the hash map circularly, which is the default.
+constexpr char kStepCachePolicy[] = "step";
+constexpr char kLFUCachePolicy[] = "lfu";
+constexpr char kARCCachePolicy[] = "arc";
+// The frequency of LFU saturates at this value.
+constexpr size_t kMaxCacheFrequency = 255;
+
+// The count-min sketch estimates the access frequency of the ids with fixed memory. All the counters are halved after
+// every sample_size additions, so the estimation follows the recent accesses rather than the whole history.
+class CountMinSketch {
+ public:
+  CountMinSketch(size_t width, size_t sample_size);
+  ~CountMinSketch() = default;
+
+  void Add(int id);
+  uint32_t Estimate(int id) const;
+
+ private:
+  size_t Position(int id, size_t row) const;
+  void Halve();
+
+  size_t width_mask_;
+  size_t sample_size_;
+  size_t added_num_{0};
+  std::vector<uint8_t> counters_;
+};
+
+// The policy chooses the element evicted from the embedding hash map, the elements are identified by their indices in
+// the hash map. The step of an element is the last data step using it: the element whose step is less than the graph
+// running step can be evicted at once, and the one whose step equals the graph running step can be evicted after the
+// graph finishes running. Every policy keeps its elements in lists ordered by the last access, so the steps are
+// nondecreasing along each list and only the front of a list needs to be checked to find the victim.
+class EmbeddingCachePolicy {
+ public:
+  virtual ~EmbeddingCachePolicy() = default;
+
+  virtual void Insert(int index, int id, size_t step) = 0;
+  // The step is nondecreasing for all the calls of Insert, Access and Refresh.
+  virtual void Access(int index, size_t step) = 0;
+  // Update the step of the element which is kept by the data step without being used by it, e.g. the row swapped out
+  // of the device cache. The element moves to the back of its list, but it isn't counted as an access.
+  virtual void Refresh(int index, size_t step) = 0;
+  virtual void Erase(int index) = 0;
+  // Find the element to evict for the incoming id. The element expired before the graph running step is returned, and
+  // the one used by the graph running step is returned only if wait_graph is set.
+  virtual bool Victim(int id, size_t graph_running_step, bool wait_graph, int *index) = 0;
+
+ protected:
+  static bool Evictable(size_t step, size_t graph_running_step, bool wait_graph) {
+    return step < graph_running_step || (wait_graph && step == graph_running_step);
+  }
+};
+
+// Evict the least frequently used element, the ties are broken by the least recently used. The frequencies are halved
+// periodically, so the rows which were hot long ago don't stay in the cache forever.
+class LFUCachePolicy : public EmbeddingCachePolicy {
+ public:
+  LFUCachePolicy(size_t capacity, size_t decay_period);
+  ~LFUCachePolicy() override = default;
+
+  void Insert(int index, int id, size_t step) override;
+  void Access(int index, size_t step) override;
+  void Refresh(int index, size_t step) override;
+  void Erase(int index) override;
+  bool Victim(int id, size_t graph_running_step, bool wait_graph, int *index) override;
+
+ private:
+  struct Node {
+    size_t step{0};
+    size_t freq{0};
+    std::list<int>::iterator pos;
+  };
+  void Decay();
+
+  std::vector<Node> nodes_;
+  // The elements of each frequency in the order of the last access.
+  std::vector<std::list<int>> buckets_;
+  size_t decay_period_;
+  size_t access_num_{0};
+};
+
+// The adaptive replacement cache: the elements accessed once and the ones accessed more than once are kept in two
+// lists, and the ids evicted recently from each list are remembered as the ghosts. The hit on a ghost tells which list
+// should be larger, and the target size of the recent list is adjusted by it.
+class ARCCachePolicy : public EmbeddingCachePolicy {
+ public:
+  explicit ARCCachePolicy(size_t capacity);
+  ~ARCCachePolicy() override = default;
+
+  void Insert(int index, int id, size_t step) override;
+  void Access(int index, size_t step) override;
+  void Refresh(int index, size_t step) override;
+  void Erase(int index) override;
+  bool Victim(int id, size_t graph_running_step, bool wait_graph, int *index) override;
+
+ private:
+  struct Node {
+    size_t step{0};
+    int id{0};
+    bool frequent{false};
+    std::list<int>::iterator pos;
+  };
+  void AddGhost(int id, bool frequent);
+
+  size_t capacity_;
+  size_t target_recent_size_{0};
+  std::vector<Node> nodes_;
+  std::list<int> recent_;
+  std::list<int> frequent_;
+  std::list<int> recent_ghosts_;
+  std::list<int> frequent_ghosts_;
+  // The ghost id to whether it's evicted from the frequent list and its position in the ghost list.
+  mindspore::HashMap<int, std::pair<bool, std::list<int>::iterator>> ghosts_;
+};
+
+// Create the policy by name for the hash map of the capacity, nullptr is returned for the step policy and the unknown
+// names.
+std::unique_ptr<EmbeddingCachePolicy> CreateEmbeddingCachePolicy(const std::string &name, size_t capacity);
+}  // namespace ps
+}  // namespace mindspore
+#endif  // MINDSPORE_CCSRC_PS_PS_CACHE_EMBEDDING_CACHE_POLICY_H_
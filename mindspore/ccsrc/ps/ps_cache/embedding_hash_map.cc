@@ -20,10 +20,14 @@ namespace mindspore {
 namespace ps {
 int EmbeddingHashMap::ParseData(const int id, int *const swap_out_index, int *const swap_out_ids,
                                 const size_t data_step, const size_t graph_running_step, size_t *const swap_out_size,
-                                bool *const need_wait_graph) {
+                                bool *const need_wait_graph, const bool record_access) {
   MS_EXCEPTION_IF_NULL(swap_out_index);
   MS_EXCEPTION_IF_NULL(swap_out_ids);
   MS_EXCEPTION_IF_NULL(swap_out_size);
+  if (policy_ != nullptr) {
+    return ParseDataByPolicy(id, swap_out_index, swap_out_ids, data_step, graph_running_step, swap_out_size,
+                             need_wait_graph, record_access);
+  }
   bool need_swap = false;
   auto hash_index = FindInsertionPos(data_step, graph_running_step, &need_swap, need_wait_graph);
   if (hash_index == INVALID_INDEX_VALUE) {
@@ -82,6 +86,147 @@ int EmbeddingHashMap::FindInsertionPos(const size_t, const size_t graph_running_
   return INVALID_INDEX_VALUE;
 }
 
+void EmbeddingHashMap::InitPolicy(const std::string &policy, uint32_t admission_threshold) {
+  if (policy == kStepCachePolicy) {
+    return;
+  }
+  policy_ = CreateEmbeddingCachePolicy(policy, hash_capacity_);
+  if (policy_ == nullptr) {
+    MS_LOG(EXCEPTION) << "Invalid embedding cache eviction policy: " << policy << ", it should be one of "
+                      << kStepCachePolicy << ", " << kLFUCachePolicy << " and " << kARCCachePolicy << ".";
+  }
+  // The front and back positions are reserved, see the constructor.
+  const size_t kReservedPosNum = 2;
+  for (size_t i = hash_capacity_; i > kReservedPosNum; --i) {
+    free_indices_.push_back(SizeToInt(i - kReservedPosNum));
+  }
+  if (admission_threshold > 0) {
+    // The sketch samples ten times of the capacity before aging, which is enough to tell the hot ids from the others.
+    const size_t kSketchSampleFactor = 10;
+    admission_threshold_ = admission_threshold;
+    sketch_ = std::make_unique<CountMinSketch>(hash_capacity_, kSketchSampleFactor * hash_capacity_);
+    probation_pos_.resize(hash_capacity_);
+    in_probation_.resize(hash_capacity_, false);
+  }
+  MS_LOG(INFO) << "Embedding cache eviction policy: " << policy << ", admission threshold: " << admission_threshold;
+}
+
+void EmbeddingHashMap::RecordAccess(const int hash_index, const size_t step) {
+  auto &element = hash_map_elements_[IntToSize(hash_index)];
+  element.set_step(step);
+  if (policy_ == nullptr || element.access_step_ == step) {
+    return;
+  }
+  element.access_step_ = step;
+  if (sketch_ == nullptr) {
+    policy_->Access(hash_index, step);
+    return;
+  }
+  sketch_->Add(element.id_);
+  if (!in_probation_[IntToSize(hash_index)]) {
+    policy_->Access(hash_index, step);
+    return;
+  }
+  auto &pos = probation_pos_[IntToSize(hash_index)];
+  if (sketch_->Estimate(element.id_) < admission_threshold_) {
+    probation_.splice(probation_.end(), probation_, pos);
+    return;
+  }
+  (void)probation_.erase(pos);
+  in_probation_[IntToSize(hash_index)] = false;
+  policy_->Insert(hash_index, element.id_, step);
+  policy_statistics_.promoted_count_++;
+}
+
+void EmbeddingHashMap::RefreshStep(const int hash_index, const size_t step) {
+  auto &element = hash_map_elements_[IntToSize(hash_index)];
+  element.set_step(step);
+  if (policy_ == nullptr) {
+    return;
+  }
+  if (sketch_ != nullptr && in_probation_[IntToSize(hash_index)]) {
+    probation_.splice(probation_.end(), probation_, probation_pos_[IntToSize(hash_index)]);
+    return;
+  }
+  policy_->Refresh(hash_index, step);
+}
+
+int EmbeddingHashMap::ParseDataByPolicy(const int id, int *const swap_out_index, int *const swap_out_ids,
+                                        const size_t data_step, const size_t graph_running_step,
+                                        size_t *const swap_out_size, bool *const need_wait_graph,
+                                        const bool record_access) {
+  int hash_index = INVALID_INDEX_VALUE;
+  if (!free_indices_.empty()) {
+    hash_index = free_indices_.back();
+    free_indices_.pop_back();
+    hash_count_++;
+  } else {
+    hash_index = FindVictim(id, graph_running_step, need_wait_graph);
+    if (hash_index == INVALID_INDEX_VALUE) {
+      return hash_index;
+    }
+    auto &victim = hash_map_elements_[IntToSize(hash_index)];
+    swap_out_index[*swap_out_size] = hash_index;
+    swap_out_ids[*swap_out_size] = victim.id_;
+    (*swap_out_size)++;
+    EraseFromPolicy(hash_index);
+    (void)hash_id_to_index_.erase(victim.id_);
+    policy_statistics_.evicted_count_++;
+  }
+  (void)hash_id_to_index_.emplace(id, hash_index);
+  auto &element = hash_map_elements_[IntToSize(hash_index)];
+  element.set_id(id);
+  element.set_step(data_step);
+  element.access_step_ = data_step;
+  InsertToPolicy(hash_index, id, data_step, record_access);
+  return hash_index;
+}
+
+int EmbeddingHashMap::FindVictim(const int id, const size_t graph_running_step, bool *const need_wait_graph) {
+  MS_EXCEPTION_IF_NULL(need_wait_graph);
+  // The elements of the probation list are evicted first, and the elements used by the graph running step are evicted
+  // only if no element is expired.
+  for (bool wait_graph : {false, true}) {
+    if (!probation_.empty()) {
+      auto step = hash_map_elements_[IntToSize(probation_.front())].step_;
+      if (step < graph_running_step || (wait_graph && step == graph_running_step)) {
+        *need_wait_graph = *need_wait_graph || wait_graph;
+        return probation_.front();
+      }
+    }
+    int hash_index = INVALID_INDEX_VALUE;
+    if (policy_->Victim(id, graph_running_step, wait_graph, &hash_index)) {
+      *need_wait_graph = *need_wait_graph || wait_graph;
+      return hash_index;
+    }
+  }
+  return INVALID_INDEX_VALUE;
+}
+
+void EmbeddingHashMap::InsertToPolicy(const int hash_index, const int id, const size_t step, const bool record_access) {
+  if (sketch_ != nullptr) {
+    if (record_access) {
+      sketch_->Add(id);
+    }
+    if (sketch_->Estimate(id) < admission_threshold_) {
+      probation_pos_[IntToSize(hash_index)] = probation_.insert(probation_.end(), hash_index);
+      in_probation_[IntToSize(hash_index)] = true;
+      policy_statistics_.probation_count_++;
+      return;
+    }
+  }
+  policy_->Insert(hash_index, id, step);
+}
+
+void EmbeddingHashMap::EraseFromPolicy(const int hash_index) {
+  if (sketch_ != nullptr && in_probation_[IntToSize(hash_index)]) {
+    (void)probation_.erase(probation_pos_[IntToSize(hash_index)]);
+    in_probation_[IntToSize(hash_index)] = false;
+    return;
+  }
+  policy_->Erase(hash_index);
+}
+
 void EmbeddingHashMap::DumpHashMap() {
   MS_LOG(INFO) << "Dump hash map info begin, hash_capacity: " << hash_capacity_ << " hash_count: " << hash_count_;
   MS_LOG(INFO) << "Dump hash_id_to_index: ";
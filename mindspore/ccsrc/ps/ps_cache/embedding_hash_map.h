@@ -18,11 +18,14 @@
 #define MINDSPORE_CCSRC_PS_PS_CACHE_EMBEDDING_HASH_MAP_H_
 
 #include <math.h>
+#include <list>
+#include <string>
 #include <utility>
 #include <memory>
 #include <vector>
 #include "utils/hash_map.h"
 #include "utils/convert_utils_base.h"
+#include "ps/ps_cache/embedding_cache_policy.h"
 
 namespace mindspore {
 namespace ps {
@@ -32,6 +35,8 @@ static const int INVALID_INDEX_VALUE = -1;
 struct HashMapElement {
   int id_{INVALID_INDEX_VALUE};
   size_t step_{INVALID_STEP_VALUE};
+  // The last step recorded by the eviction policy.
+  size_t access_step_{INVALID_STEP_VALUE};
   bool IsEmpty() const { return step_ == INVALID_STEP_VALUE; }
   bool IsExpired(size_t graph_running_step) const { return graph_running_step > step_; }
   bool IsStep(size_t step) const { return step_ == step; }
@@ -39,10 +44,21 @@ struct HashMapElement {
   void set_step(size_t step) { step_ = step; }
 };
 
+// The statistics of the eviction policy since the hash map is created.
+struct EmbeddingCachePolicyStatistics {
+  size_t evicted_count_{0};
+  // The number of the elements inserted into the probation list for their low estimated frequency.
+  size_t probation_count_{0};
+  size_t promoted_count_{0};
+};
+
 // Hash table is held in device, HashMap is used to manage hash table in host.
 class EmbeddingHashMap {
  public:
-  EmbeddingHashMap(size_t hash_count, size_t hash_capacity)
+  // The policy is one of the names in embedding_cache_policy.h. When the admission threshold is positive, the element
+  // whose estimated frequency is less than it is inserted into the probation list, which is evicted before the others.
+  EmbeddingHashMap(size_t hash_count, size_t hash_capacity, const std::string &policy = kStepCachePolicy,
+                   uint32_t admission_threshold = 0)
       : hash_count_(hash_count),
         hash_capacity_(hash_capacity),
         current_pos_(0),
@@ -57,14 +73,26 @@ class EmbeddingHashMap {
     hash_map_elements_.front().set_step(SIZE_MAX);
     hash_map_elements_.back().set_step(SIZE_MAX);
     graph_running_index_ = std::make_unique<int[]>(hash_capacity);
+    InitPolicy(policy, admission_threshold);
   }
   virtual ~EmbeddingHashMap() = default;
+  // Insert the id at the data step, record_access is false for the id kept by the data step without being used by it,
+  // e.g. the row swapped out of the device cache, which isn't counted as an access by the admission.
   int ParseData(const int id, int *const swap_out_index, int *const swap_out_ids, const size_t data_step,
-                const size_t graph_running_step, size_t *const swap_out_size, bool *const need_wait_graph);
+                const size_t graph_running_step, size_t *const swap_out_size, bool *const need_wait_graph,
+                const bool record_access = true);
   size_t hash_step(const int hash_index) const { return hash_map_elements_[IntToSize(hash_index)].step_; }
   void set_hash_step(const int hash_index, const size_t step) {
     hash_map_elements_[IntToSize(hash_index)].set_step(step);
   }
+  // Set the step of the element hit by the data step and record the access for the eviction policy. Unlike
+  // set_hash_step, it must be called serially in the order of the data steps.
+  void RecordAccess(const int hash_index, const size_t step);
+  // Set the step of the element kept by the data step without being used by it, which refreshes its position for the
+  // eviction policy but isn't counted as an access. It must be called serially like RecordAccess.
+  void RefreshStep(const int hash_index, const size_t step);
+  bool policy_enabled() const { return policy_ != nullptr; }
+  const EmbeddingCachePolicyStatistics &policy_statistics() const { return policy_statistics_; }
   const mindspore::HashMap<int, int> &hash_id_to_index() const { return hash_id_to_index_; }
   size_t hash_capacity() const { return hash_capacity_; }
   void DumpHashMap();
@@ -73,6 +101,13 @@ class EmbeddingHashMap {
  private:
   int FindInsertionPos(const size_t data_step, const size_t graph_running_step, bool *const need_swap,
                        bool *const need_wait_graph);
+  void InitPolicy(const std::string &policy, uint32_t admission_threshold);
+  int ParseDataByPolicy(const int id, int *const swap_out_index, int *const swap_out_ids, const size_t data_step,
+                        const size_t graph_running_step, size_t *const swap_out_size, bool *const need_wait_graph,
+                        const bool record_access);
+  int FindVictim(const int id, const size_t graph_running_step, bool *const need_wait_graph);
+  void InsertToPolicy(const int hash_index, const int id, const size_t step, const bool record_access);
+  void EraseFromPolicy(const int hash_index);
   size_t hash_count_;
   size_t hash_capacity_;
   std::vector<HashMapElement> hash_map_elements_;
@@ -83,6 +118,18 @@ class EmbeddingHashMap {
   size_t graph_running_index_pos_;
   std::unique_ptr<int[]> graph_running_index_;
   bool expired_element_full_;
+
+  // The eviction policy, the circular scan by FindInsertionPos is used if it's null.
+  std::unique_ptr<EmbeddingCachePolicy> policy_;
+  // The empty positions, which are used before evicting any element.
+  std::vector<int> free_indices_;
+  std::unique_ptr<CountMinSketch> sketch_;
+  uint32_t admission_threshold_{0};
+  // The elements not admitted to the policy yet in the order of the last access.
+  std::list<int> probation_;
+  std::vector<std::list<int>::iterator> probation_pos_;
+  std::vector<bool> in_probation_;
+  EmbeddingCachePolicyStatistics policy_statistics_;
 };
 }  // namespace ps
 }  // namespace mindspore
@@ -154,9 +154,13 @@ void PsCacheManager::Initialize() {
   if (!Worker::GetInstance().running()) {
     Worker::GetInstance().Run();
   }
-  embedding_device_cache_ = std::make_shared<EmbeddingDeviceCache>(batch_elements_, vocab_cache_size_);
+  const auto &cache_policy = PSContext::instance()->cache_eviction_policy();
+  auto admission_threshold = PSContext::instance()->cache_admission_threshold();
+  embedding_device_cache_ =
+    std::make_shared<EmbeddingDeviceCache>(batch_elements_, vocab_cache_size_, cache_policy, admission_threshold);
   MS_ERROR_IF_NULL_WO_RET_VAL(embedding_device_cache_);
-  embedding_host_cache_ = std::make_shared<EmbeddingHostCache>(batch_elements_, host_vocab_cache_size_);
+  embedding_host_cache_ =
+    std::make_shared<EmbeddingHostCache>(batch_elements_, host_vocab_cache_size_, cache_policy, admission_threshold);
   MS_ERROR_IF_NULL_WO_RET_VAL(embedding_host_cache_);
   AddEmbeddingTable();
   AllocMemForHashTable();
@@ -413,6 +417,7 @@ bool PsCacheManager::ProcessData() {
   }
   // Get hash swap in/out index and ids.
   RETURN_IF_FALSE_WITH_LOG(ParseData(batch_ids, batch_ids_len, hash_index.get()), "Parse data failed.");
+  UpdateMetrics();
   DumpStatisticsInfo();
   if ((device_need_wait_graph_ || host_need_wait_graph_) && (!WaitGraphRun())) {
     MS_LOG(ERROR) << "Ps cache wait graph finish failed.";
@@ -531,6 +536,24 @@ bool PsCacheManager::ResetEmbeddingHashMap() {
   return true;
 }
 
+bool PsCacheManager::RecordDeviceCacheHit(const size_t batch_ids_len, const int *hash_index, const bool *in_device) {
+  MS_ERROR_IF_NULL(hash_index);
+  MS_ERROR_IF_NULL(in_device);
+  MS_ERROR_IF_NULL(embedding_device_cache_);
+  const auto &device_hash_map = embedding_device_cache_->device_hash_map_;
+  MS_ERROR_IF_NULL(device_hash_map);
+  // The hits are checked by multiple threads, and the eviction policy records them here in the order of the ids.
+  if (!device_hash_map->policy_enabled()) {
+    return true;
+  }
+  for (size_t i = 0; i < batch_ids_len; ++i) {
+    if (in_device[i]) {
+      device_hash_map->RecordAccess(hash_index[i] - cache_indices_bounds_.first, data_step_);
+    }
+  }
+  return true;
+}
+
 bool PsCacheManager::ParseData(const int *batch_ids, const size_t batch_ids_len, int *hash_index) {
   MS_ERROR_IF_NULL(batch_ids);
   MS_ERROR_IF_NULL(hash_index);
@@ -544,6 +567,7 @@ bool PsCacheManager::ParseData(const int *batch_ids, const size_t batch_ids_len,
     MS_LOG(EXCEPTION) << "Initialize out_range array failed.";
   }
   RETURN_IF_FALSE(CheckCacheHitOrOutRange(batch_ids, batch_ids_len, hash_index, in_device.get(), out_range.get()));
+  RETURN_IF_FALSE(RecordDeviceCacheHit(batch_ids_len, hash_index, in_device.get()));
   RETURN_IF_FALSE(ResetEmbeddingHashMap());
   for (size_t i = 0; i < batch_ids_len; i++) {
     if (in_device[i] || out_range[i]) {
@@ -596,7 +620,7 @@ bool PsCacheManager::ParseDeviceData(size_t id, bool *need_swap_device_to_host,
     index = iter->second;
     if (device_hash_map->hash_step(index) != data_step_) {
       statistics_info_.hash_hit_count_++;
-      device_hash_map->set_hash_step(index, data_step_);
+      device_hash_map->RecordAccess(index, data_step_);
     }
   } else {
     int *device_to_host_index = embedding_device_cache_->device_to_host_index.get();
@@ -637,9 +661,7 @@ bool PsCacheManager::ParseHostDataHostToDevice(size_t id) {
   const auto &iter = hash_id_to_index.find(id);
   if (iter != hash_id_to_index.end()) {
     auto index = iter->second;
-    if (host_hash_map->hash_step(index) != data_step_) {
-      host_hash_map->set_hash_step(index, data_step_);
-    }
+    host_hash_map->RecordAccess(index, data_step_);
     host_to_device_index[statistics_info_.host_to_device_size_ - 1] = index;
   } else {
     int *host_to_server_index = embedding_host_cache_->host_to_server_index.get();
@@ -680,9 +702,9 @@ bool PsCacheManager::ParseHostDataDeviceToHost() {
   const auto &iter = hash_id_to_index.find(swap_device_to_host_id);
   if (iter != hash_id_to_index.end()) {
     auto index = iter->second;
-    if (host_hash_map->hash_step(index) != data_step_) {
-      host_hash_map->set_hash_step(index, data_step_);
-    }
+    // The row swapped out of the device isn't used by the data step, only its step is refreshed to keep it on the host
+    // until the swap finishes.
+    host_hash_map->RefreshStep(index, data_step_);
     device_to_host_index[statistics_info_.device_to_host_size_ - 1] = index;
   } else {
     int *host_to_server_index = embedding_host_cache_->host_to_server_index.get();
@@ -690,7 +712,8 @@ bool PsCacheManager::ParseHostDataDeviceToHost() {
     while (true) {
       auto index =
         host_hash_map->ParseData(swap_device_to_host_id, host_to_server_index, host_to_server_ids, data_step_,
-                                 graph_running_step_, &statistics_info_.host_to_server_size_, &host_need_wait_graph_);
+                                 graph_running_step_, &statistics_info_.host_to_server_size_, &host_need_wait_graph_,
+                                 false);
       if (index == INVALID_INDEX_VALUE) {
         RETURN_IF_FALSE(WaitGraphRun());
         continue;
@@ -1089,16 +1112,45 @@ void PsCacheManager::DumpHashTables(bool dump_device_tables) const {
   }
 }
 
+PsCacheMetrics PsCacheManager::metrics() const {
+  std::lock_guard<std::mutex> locker(metrics_mutex_);
+  return metrics_;
+}
+
+void PsCacheManager::UpdateMetrics() {
+  size_t row_size = 0;
+  for (const auto &item : hash_tables_) {
+    row_size += item.second.embedding_size * sizeof(float);
+  }
+  statistics_info_.batch_id_unique_count_ = statistics_info_.hash_hit_count_ + statistics_info_.host_to_device_size_;
+  auto unique_count = statistics_info_.batch_id_unique_count_;
+  auto host_hit_count = unique_count - statistics_info_.server_to_host_size_;
+
+  std::lock_guard<std::mutex> locker(metrics_mutex_);
+  metrics_.data_step_ = data_step_;
+  metrics_.device_hit_rate_ = unique_count == 0 ? 0 : SizeToFloat(statistics_info_.hash_hit_count_) / unique_count;
+  metrics_.host_hit_rate_ = unique_count == 0 ? 0 : SizeToFloat(host_hit_count) / unique_count;
+  metrics_.device_to_host_bytes_ = statistics_info_.device_to_host_size_ * row_size;
+  metrics_.host_to_device_bytes_ = statistics_info_.host_to_device_size_ * row_size;
+  metrics_.host_to_server_bytes_ = statistics_info_.host_to_server_size_ * row_size;
+  metrics_.server_to_host_bytes_ = statistics_info_.server_to_host_size_ * row_size;
+  metrics_.total_unique_id_count_ += unique_count;
+  metrics_.total_device_hit_count_ += statistics_info_.hash_hit_count_;
+  metrics_.total_host_hit_count_ += host_hit_count;
+  metrics_.total_swap_bytes_ += metrics_.device_to_host_bytes_ + metrics_.host_to_device_bytes_ +
+                                metrics_.host_to_server_bytes_ + metrics_.server_to_host_bytes_;
+}
+
 void PsCacheManager::DumpStatisticsInfo(size_t each_print_step) {
   // Default each 1000 step prints ps cache hit rate.
   const size_t kFloatToPercentSign = 100;
   if (data_step_ % each_print_step == 0) {
-    statistics_info_.batch_id_unique_count_ = statistics_info_.hash_hit_count_ + statistics_info_.host_to_device_size_;
     auto repeat_rate = SizeToFloat(statistics_info_.batch_id_count_ - statistics_info_.batch_id_unique_count_) /
                        statistics_info_.batch_id_count_;
-    auto device_hit_rate = SizeToFloat(statistics_info_.hash_hit_count_) / statistics_info_.batch_id_unique_count_;
-    auto host_hit_rate = SizeToFloat(statistics_info_.batch_id_unique_count_ - statistics_info_.server_to_host_size_) /
-                         statistics_info_.batch_id_unique_count_;
+    auto metrics = this->metrics();
+    auto total_unique_count = metrics.total_unique_id_count_ == 0 ? 1 : metrics.total_unique_id_count_;
+    auto total_device_hit_rate = SizeToFloat(metrics.total_device_hit_count_) / total_unique_count;
+    auto total_host_hit_rate = SizeToFloat(metrics.total_host_hit_count_) / total_unique_count;
     MS_LOG(INFO) << "PS embedding cache data statistics info(total id num:" << statistics_info_.batch_id_count_
                  << ", unique id num:" << statistics_info_.batch_id_unique_count_
                  << ", host swap to device num:" << statistics_info_.host_to_device_size_
@@ -1106,8 +1158,23 @@ void PsCacheManager::DumpStatisticsInfo(size_t each_print_step) {
                  << ", host swap to server num:" << statistics_info_.host_to_server_size_
                  << ", server swap to host num:" << statistics_info_.server_to_host_size_
                  << ", data repeat rate:" << (repeat_rate * kFloatToPercentSign)
-                 << "%, device cache hit rate:" << (device_hit_rate * kFloatToPercentSign)
-                 << "%, host cache hit rate:" << (host_hit_rate * kFloatToPercentSign) << ").";
+                 << "%, device cache hit rate:" << (metrics.device_hit_rate_ * kFloatToPercentSign)
+                 << "%, host cache hit rate:" << (metrics.host_hit_rate_ * kFloatToPercentSign)
+                 << "%, total device cache hit rate:" << (total_device_hit_rate * kFloatToPercentSign)
+                 << "%, total host cache hit rate:" << (total_host_hit_rate * kFloatToPercentSign)
+                 << "%, total swap bytes:" << metrics.total_swap_bytes_ << ").";
+    const auto &device_hash_map = embedding_device_cache_->device_hash_map_;
+    const auto &host_hash_map = embedding_host_cache_->host_hash_map_;
+    if (device_hash_map->policy_enabled()) {
+      const auto &device_policy = device_hash_map->policy_statistics();
+      const auto &host_policy = host_hash_map->policy_statistics();
+      MS_LOG(INFO) << "PS embedding cache eviction info(device evicted num:" << device_policy.evicted_count_
+                   << ", device probation num:" << device_policy.probation_count_
+                   << ", device promoted num:" << device_policy.promoted_count_
+                   << ", host evicted num:" << host_policy.evicted_count_
+                   << ", host probation num:" << host_policy.probation_count_
+                   << ", host promoted num:" << host_policy.promoted_count_ << ").";
+    }
   }
 }
 }  // namespace ps
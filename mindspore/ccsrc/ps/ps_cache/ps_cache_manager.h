@@ -25,6 +25,7 @@
 #include <utility>
 #include <memory>
 #include <condition_variable>
+#include <mutex>
 #include "utils/ms_context.h"
 #include "kernel/kernel.h"
 #include "utils/shape_utils.h"
@@ -55,13 +56,14 @@ struct HashTableInfo {
 };
 
 struct EmbeddingDeviceCache {
-  EmbeddingDeviceCache(size_t batch_elements, size_t cache_vocab_size)
+  EmbeddingDeviceCache(size_t batch_elements, size_t cache_vocab_size, const std::string &cache_policy,
+                       uint32_t admission_threshold)
       : hash_swap_index_addr_(nullptr), hash_swap_value_addr_(nullptr) {
     device_to_host_index = std::make_unique<int[]>(batch_elements);
     device_to_host_ids = std::make_unique<int[]>(batch_elements);
     host_to_device_index = std::make_unique<int[]>(batch_elements);
     host_to_device_ids = std::make_unique<int[]>(batch_elements);
-    device_hash_map_ = std::make_shared<EmbeddingHashMap>(0, cache_vocab_size);
+    device_hash_map_ = std::make_shared<EmbeddingHashMap>(0, cache_vocab_size, cache_policy, admission_threshold);
     auto context_ptr = MsContext::GetInstance();
     MS_EXCEPTION_IF_NULL(context_ptr);
     auto devcie_target = context_ptr->get_param<std::string>(MS_CTX_DEVICE_TARGET);
@@ -78,14 +80,16 @@ struct EmbeddingDeviceCache {
 };
 
 struct EmbeddingHostCache {
-  EmbeddingHostCache(size_t batch_elements, size_t host_cache_vocab_size) {
+  EmbeddingHostCache(size_t batch_elements, size_t host_cache_vocab_size, const std::string &cache_policy,
+                     uint32_t admission_threshold) {
     host_to_server_index = std::make_unique<int[]>(batch_elements);
     host_to_server_ids = std::make_unique<int[]>(batch_elements);
     server_to_host_index = std::make_unique<int[]>(batch_elements);
     server_to_host_ids = std::make_unique<int[]>(batch_elements);
     host_to_device_index = std::make_unique<int[]>(batch_elements);
     device_to_host_index = std::make_unique<int[]>(batch_elements);
-    host_hash_map_ = std::make_shared<EmbeddingHashMap>(0, host_cache_vocab_size);
+    host_hash_map_ =
+      std::make_shared<EmbeddingHashMap>(0, host_cache_vocab_size, cache_policy, admission_threshold);
   }
   std::unique_ptr<int[]> host_to_server_index;
   std::unique_ptr<int[]> host_to_server_ids;
@@ -109,6 +113,23 @@ struct PsCacheStatisticsInfo {
   size_t mem_cache_hit_count_{0};
 };
 
+// The metrics of the embedding cache, which are updated after the ids of each data step are parsed.
+struct PsCacheMetrics {
+  size_t data_step_{0};
+  // The hit rates and the swap sizes in bytes of the last data step.
+  float device_hit_rate_{0};
+  float host_hit_rate_{0};
+  size_t device_to_host_bytes_{0};
+  size_t host_to_device_bytes_{0};
+  size_t host_to_server_bytes_{0};
+  size_t server_to_host_bytes_{0};
+  // The accumulations since the cache is initialized.
+  size_t total_unique_id_count_{0};
+  size_t total_device_hit_count_{0};
+  size_t total_host_hit_count_{0};
+  size_t total_swap_bytes_{0};
+};
+
 class BACKEND_EXPORT PsCacheManager {
  public:
   static PsCacheManager &GetInstance();
@@ -133,6 +154,7 @@ class BACKEND_EXPORT PsCacheManager {
   void SyncEmbeddingTable();
   void Finalize();
   void DumpHashTables(bool dump_device_tables = false) const;
+  PsCacheMetrics metrics() const;
 
  private:
   PsCacheManager() = default;
@@ -169,6 +191,7 @@ class BACKEND_EXPORT PsCacheManager {
                        const int *indices_addr, float *output_addr);
   bool CheckFinishInsertInitInfo() const;
   void AddEmbeddingTable() const;
+  void UpdateMetrics();
   void DumpStatisticsInfo(size_t each_print_step = 1000);
   bool SyncHostEmbeddingTable();
   bool SyncDeviceEmbeddingTable();
@@ -177,6 +200,7 @@ class BACKEND_EXPORT PsCacheManager {
   bool CheckCacheHitOrOutRange(const int *batch_ids, const size_t batch_ids_len, int *hash_index, bool *in_device,
                                bool *out_range);
   bool ResetEmbeddingHashMap();
+  bool RecordDeviceCacheHit(const size_t batch_ids_len, const int *hash_index, const bool *in_device);
 
   bool initialized_ps_cache_{false};
   std::string channel_name_;
@@ -198,6 +222,8 @@ class BACKEND_EXPORT PsCacheManager {
   size_t host_vocab_cache_size_{0};
   size_t batch_elements_{0};
   PsCacheStatisticsInfo statistics_info_;
+  PsCacheMetrics metrics_;
+  mutable std::mutex metrics_mutex_;
   std::pair<int, int> emb_table_slice_bounds_;
   std::pair<int, int> cache_indices_bounds_;
   int vocab_cache_size_diff_{0};
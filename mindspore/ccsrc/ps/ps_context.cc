@@ -19,6 +19,7 @@
 #include "kernel/kernel.h"
 #include "utils/log_adapter.h"
 #include "utils/ms_utils.h"
+#include "ps/ps_cache/embedding_cache_policy.h"
 #if ((defined ENABLE_CPU) && (!defined _WIN32) && !defined(__APPLE__))
 #include "distributed/cluster/cluster_context.h"
 #include "ps/ps_cache/ps_cache_manager.h"
@@ -209,6 +210,48 @@ void PSContext::set_rank_id(uint32_t rank_id) const {
 #endif
 }
 
+void PSContext::set_cache_eviction_policy(const std::string &cache_eviction_policy) {
+  if (cache_eviction_policy != "step" && cache_eviction_policy != "lfu" && cache_eviction_policy != "arc") {
+    MS_LOG(EXCEPTION) << cache_eviction_policy << " is invalid. Cache eviction policy must be step, lfu or arc.";
+  }
+  cache_eviction_policy_ = cache_eviction_policy;
+}
+
+const std::string &PSContext::cache_eviction_policy() const { return cache_eviction_policy_; }
+
+void PSContext::set_cache_admission_threshold(uint32_t cache_admission_threshold) {
+  // The estimated frequencies saturate at kMaxCacheFrequency, so any larger threshold would reject every id.
+  if (cache_admission_threshold > kMaxCacheFrequency) {
+    MS_LOG(EXCEPTION) << cache_admission_threshold << " is invalid. Cache admission threshold must be in [0, "
+                      << kMaxCacheFrequency << "].";
+  }
+  cache_admission_threshold_ = cache_admission_threshold;
+}
+
+uint32_t PSContext::cache_admission_threshold() const { return cache_admission_threshold_; }
+
+std::map<std::string, double> PSContext::cache_metrics() const {
+  std::map<std::string, double> cache_metrics;
+#if ((defined ENABLE_CPU) && (!defined _WIN32) && !defined(__APPLE__))
+  if (!ps_cache_instance.initialized_ps_cache()) {
+    return cache_metrics;
+  }
+  auto metrics = ps_cache_instance.metrics();
+  cache_metrics["data_step"] = static_cast<double>(metrics.data_step_);
+  cache_metrics["device_hit_rate"] = static_cast<double>(metrics.device_hit_rate_);
+  cache_metrics["host_hit_rate"] = static_cast<double>(metrics.host_hit_rate_);
+  cache_metrics["device_to_host_bytes"] = static_cast<double>(metrics.device_to_host_bytes_);
+  cache_metrics["host_to_device_bytes"] = static_cast<double>(metrics.host_to_device_bytes_);
+  cache_metrics["host_to_server_bytes"] = static_cast<double>(metrics.host_to_server_bytes_);
+  cache_metrics["server_to_host_bytes"] = static_cast<double>(metrics.server_to_host_bytes_);
+  cache_metrics["total_unique_id_count"] = static_cast<double>(metrics.total_unique_id_count_);
+  cache_metrics["total_device_hit_count"] = static_cast<double>(metrics.total_device_hit_count_);
+  cache_metrics["total_host_hit_count"] = static_cast<double>(metrics.total_host_hit_count_);
+  cache_metrics["total_swap_bytes"] = static_cast<double>(metrics.total_swap_bytes_);
+#endif
+  return cache_metrics;
+}
+
 void PSContext::set_server_mode(const std::string &server_mode) {
   if (server_mode != kServerModePS && server_mode != kServerModeFL && server_mode != kServerModeHybrid) {
     MS_LOG(EXCEPTION) << server_mode << " is invalid. Server mode must be " << kServerModePS << " or " << kServerModeFL
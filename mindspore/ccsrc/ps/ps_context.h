@@ -85,6 +85,13 @@ class BACKEND_EXPORT PSContext {
   void set_cache_enable(bool cache_enable) const;
   bool cache_enable() const;
   void set_rank_id(uint32_t rank_id) const;
+  // The eviction policy and admission threshold of the embedding cache hash maps, see ps_cache/embedding_hash_map.h.
+  void set_cache_eviction_policy(const std::string &cache_eviction_policy);
+  const std::string &cache_eviction_policy() const;
+  void set_cache_admission_threshold(uint32_t cache_admission_threshold);
+  uint32_t cache_admission_threshold() const;
+  // The hit rates and swap sizes of the embedding cache, which is empty before the cache is initialized.
+  std::map<std::string, double> cache_metrics() const;
 
   // In new server framework, process role, worker number, server number, scheduler ip and scheduler port should be set
   // by ps_context.
@@ -312,7 +319,9 @@ class BACKEND_EXPORT PSContext {
         checkpoint_dir_(""),
         instance_name_(""),
         participation_time_level_("5,15"),
-        continuous_failure_times_(10) {}
+        continuous_failure_times_(10),
+        cache_eviction_policy_("step"),
+        cache_admission_threshold_(0) {}
   bool ps_enabled_;
   bool is_worker_;
   bool is_pserver_;
@@ -463,6 +472,12 @@ class BACKEND_EXPORT PSContext {
 
   // The times of iteration continuous failure
   uint32_t continuous_failure_times_;
+
+  // The eviction policy of the embedding cache: step, lfu or arc.
+  std::string cache_eviction_policy_;
+
+  // The ids whose estimated frequency is less than the threshold are evicted first, 0 disables the admission.
+  uint32_t cache_admission_threshold_;
 };
 }  // namespace ps
 }  // namespace mindspore
@@ -0,0 +1,148 @@
+/**
+ * Copyright 2022 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "ps/striped_embedding_table.h"
+#include <algorithm>
+#include <mutex>
+#include "utils/log_adapter.h"
+#include "./securec.h"
+
+namespace mindspore {
+namespace ps {
+StripedEmbeddingTable::StripedEmbeddingTable(float *data, size_t row_num, size_t row_size, int64_t offset,
+                                             size_t stripe_num)
+    : data_(data),
+      row_num_(row_num),
+      row_size_(row_size),
+      offset_(offset),
+      stripe_rows_(1),
+      stripes_(std::max(std::min(stripe_num, row_num), static_cast<size_t>(1))) {
+  MS_EXCEPTION_IF_NULL(data_);
+  if (row_size_ == 0) {
+    MS_LOG(EXCEPTION) << "The row size of the embedding table must be positive.";
+  }
+  stripe_rows_ = std::max((row_num_ + stripes_.size() - 1) / stripes_.size(), static_cast<size_t>(1));
+}
+
+bool StripedEmbeddingTable::GetRowIndex(size_t id, size_t *row_index) const {
+  int64_t index = static_cast<int64_t>(id) - offset_;
+  if (index < 0 || static_cast<size_t>(index) >= row_num_) {
+    return false;
+  }
+  *row_index = static_cast<size_t>(index);
+  return true;
+}
+
+void StripedEmbeddingTable::GroupByStripe(const std::vector<size_t> &ids, std::vector<size_t> *stripe_begins,
+                                          std::vector<size_t> *positions, std::vector<size_t> *row_indices) const {
+  // Counting sort of the positions by the stripe, which is stable.
+  size_t stripe_num = stripes_.size();
+  row_indices->resize(ids.size());
+  stripe_begins->assign(stripe_num + 1, 0);
+  for (size_t i = 0; i < ids.size(); ++i) {
+    size_t row_index = 0;
+    if (GetRowIndex(ids[i], &row_index)) {
+      (*row_indices)[i] = row_index;
+      (*stripe_begins)[row_index / stripe_rows_ + 1]++;
+    } else {
+      (*row_indices)[i] = row_num_;
+    }
+  }
+  for (size_t s = 0; s < stripe_num; ++s) {
+    (*stripe_begins)[s + 1] += (*stripe_begins)[s];
+  }
+  positions->resize(stripe_begins->back());
+  std::vector<size_t> cursors(stripe_begins->begin(), stripe_begins->end() - 1);
+  for (size_t i = 0; i < ids.size(); ++i) {
+    if ((*row_indices)[i] < row_num_) {
+      (*positions)[cursors[(*row_indices)[i] / stripe_rows_]++] = i;
+    }
+  }
+}
+
+bool StripedEmbeddingTable::Lookup(const std::vector<size_t> &ids, float *output, size_t output_size) {
+  MS_EXCEPTION_IF_NULL(output);
+  if (output_size < ids.size() * row_size_) {
+    MS_LOG(ERROR) << "The output size " << output_size << " is less than the lookup size " << ids.size() * row_size_;
+    return false;
+  }
+  std::vector<size_t> stripe_begins;
+  std::vector<size_t> positions;
+  std::vector<size_t> row_indices;
+  GroupByStripe(ids, &stripe_begins, &positions, &row_indices);
+
+  size_t row_bytes = row_size_ * sizeof(float);
+  for (size_t i = 0; i < ids.size(); ++i) {
+    if (row_indices[i] == row_num_) {
+      auto ret = memset_s(output + i * row_size_, row_bytes, 0, row_bytes);
+      if (ret != EOK) {
+        MS_LOG(ERROR) << "The memset_s error, errorno(" << ret << ")";
+        return false;
+      }
+    }
+  }
+  for (size_t s = 0; s < stripes_.size(); ++s) {
+    if (stripe_begins[s] == stripe_begins[s + 1]) {
+      continue;
+    }
+    std::shared_lock<std::shared_mutex> lock(stripes_[s]);
+    for (size_t p = stripe_begins[s]; p < stripe_begins[s + 1]; ++p) {
+      size_t i = positions[p];
+      auto ret = memcpy_s(output + i * row_size_, row_bytes, data_ + row_indices[i] * row_size_, row_bytes);
+      if (ret != EOK) {
+        MS_LOG(ERROR) << "The memcpy_s error, errorno(" << ret << ")";
+        return false;
+      }
+    }
+  }
+  return true;
+}
+
+bool StripedEmbeddingTable::Update(const std::vector<size_t> &ids, const float *values, size_t values_size) {
+  MS_EXCEPTION_IF_NULL(values);
+  if (values_size < ids.size() * row_size_) {
+    MS_LOG(ERROR) << "The values size " << values_size << " is less than the update size " << ids.size() * row_size_;
+    return false;
+  }
+  std::vector<size_t> stripe_begins;
+  std::vector<size_t> positions;
+  std::vector<size_t> row_indices;
+  GroupByStripe(ids, &stripe_begins, &positions, &row_indices);
+  if (positions.size() != ids.size()) {
+    MS_LOG(ERROR) << "Some ids to update are not in the embedding table shard, offset: " << offset_
+                  << ", row number: " << row_num_;
+    return false;
+  }
+
+  size_t row_bytes = row_size_ * sizeof(float);
+  for (size_t s = 0; s < stripes_.size(); ++s) {
+    if (stripe_begins[s] == stripe_begins[s + 1]) {
+      continue;
+    }
+    std::unique_lock<std::shared_mutex> lock(stripes_[s]);
+    for (size_t p = stripe_begins[s]; p < stripe_begins[s + 1]; ++p) {
+      size_t i = positions[p];
+      auto ret = memcpy_s(data_ + row_indices[i] * row_size_, row_bytes, values + i * row_size_, row_bytes);
+      if (ret != EOK) {
+        MS_LOG(ERROR) << "The memcpy_s error, errorno(" << ret << ")";
+        return false;
+      }
+    }
+  }
+  return true;
+}
+}  // namespace ps
+}  // namespace mindspore
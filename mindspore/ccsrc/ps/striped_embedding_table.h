@@ -0,0 +1,70 @@
+/**
+ * Copyright 2022 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef MINDSPORE_CCSRC_PS_STRIPED_EMBEDDING_TABLE_H_
+#define MINDSPORE_CCSRC_PS_STRIPED_EMBEDDING_TABLE_H_
+
+#include <memory>
+#include <shared_mutex>
+#include <vector>
+#include <cstdint>
+
+namespace mindspore {
+namespace ps {
+// The max number of the stripes of one embedding table.
+constexpr size_t kMaxEmbeddingStripeNum = 64;
+
+// The view of the embedding table shard on the parameter server, whose rows are split into contiguous ranges called
+// stripes, and each stripe has its own reader-writer lock. The lookups take the shared locks and the updates take the
+// exclusive locks of the stripes, so the requests of different workers run concurrently unless they update the same
+// stripe. The ids of one request are grouped by stripe, so each stripe is locked once per request instead of per row.
+class StripedEmbeddingTable {
+ public:
+  // The table has row_num rows of row_size floats, and the first row is of the id offset.
+  StripedEmbeddingTable(float *data, size_t row_num, size_t row_size, int64_t offset,
+                        size_t stripe_num = kMaxEmbeddingStripeNum);
+  ~StripedEmbeddingTable() = default;
+
+  // Copy the rows of the ids in order to the output, the rows of the ids not in this shard are filled with zeros.
+  bool Lookup(const std::vector<size_t> &ids, float *output, size_t output_size);
+  // Overwrite the rows of the ids with the values in order, a later id wins if the ids are duplicated. Return false if
+  // any id is not in this shard, and nothing is updated in this case.
+  bool Update(const std::vector<size_t> &ids, const float *values, size_t values_size);
+
+  size_t row_num() const { return row_num_; }
+  size_t row_size() const { return row_size_; }
+  int64_t offset() const { return offset_; }
+  size_t stripe_num() const { return stripes_.size(); }
+
+ private:
+  // Return whether the id is in this shard, and the row index of the id if it is.
+  bool GetRowIndex(size_t id, size_t *row_index) const;
+  // Group the positions of the ids in the request by the stripe, the positions in one stripe keep the request order.
+  // The ids not in this shard are not in any group.
+  void GroupByStripe(const std::vector<size_t> &ids, std::vector<size_t> *stripe_begins, std::vector<size_t> *positions,
+                     std::vector<size_t> *row_indices) const;
+
+  float *data_;
+  size_t row_num_;
+  size_t row_size_;
+  int64_t offset_;
+  size_t stripe_rows_;
+  std::vector<std::shared_mutex> stripes_;
+};
+using StripedEmbeddingTablePtr = std::shared_ptr<StripedEmbeddingTable>;
+}  // namespace ps
+}  // namespace mindspore
+#endif  // MINDSPORE_CCSRC_PS_STRIPED_EMBEDDING_TABLE_H_
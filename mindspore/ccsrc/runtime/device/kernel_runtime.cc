@@ -69,6 +69,31 @@ std::vector<AnfNodePtr> GetGraphInputs(const session::KernelGraph &graph) {
   }
   return result;
 }
+
+// The memory swapped out of device is offloaded to the file in the directory of env MS_DEV_MEM_OFFLOAD_PATH when it
+// needs more host memory than the env MS_DEV_MEM_OFFLOAD_HOST_SIZE in MB.
+void EnableFileOffloadIfNeeded(const std::shared_ptr<MemScheduler> &mem_scheduler) {
+  MS_EXCEPTION_IF_NULL(mem_scheduler);
+  static const std::string offload_path = common::GetEnv("MS_DEV_MEM_OFFLOAD_PATH");
+  if (offload_path.empty()) {
+    return;
+  }
+  static const std::string host_size_env = common::GetEnv("MS_DEV_MEM_OFFLOAD_HOST_SIZE");
+  constexpr size_t kMBToByte = 1024 * 1024;
+  size_t host_mem_size = 0;
+  try {
+    host_mem_size = host_size_env.empty() ? 0 : std::stoull(host_size_env) * kMBToByte;
+  } catch (const std::exception &e) {
+    MS_LOG(EXCEPTION) << "The env MS_DEV_MEM_OFFLOAD_HOST_SIZE should be an integer, but got " << host_size_env;
+  }
+  if (host_mem_size == 0) {
+    MS_LOG(WARNING) << "The env MS_DEV_MEM_OFFLOAD_HOST_SIZE is not set, the memory is not offloaded to file.";
+    return;
+  }
+  if (!mem_scheduler->EnableFileOffload(offload_path, host_mem_size)) {
+    MS_LOG(WARNING) << "Enable the memory offload to file in " << offload_path << " failed.";
+  }
+}
 }  // namespace
 constexpr size_t kMinInputSize = 2;
 KernelRuntime::~KernelRuntime() {
@@ -1741,6 +1766,7 @@ void KernelRuntime::UseMemSchedulerIfNeeded(const session::KernelGraph &graph) {
   }
   mem_scheduler->SetMemHandler(mem_manager_);
   mem_scheduler->SetTotalStep(graph.execution_order().size());
+  EnableFileOffloadIfNeeded(mem_scheduler);
 
   if (mem_scheduler->need_record_event()) {
     (void)LaunchKernelMod(graph, true);
@@ -14,16 +14,22 @@
  * limitations under the License.
  */
 #include "runtime/device/memory_offload_strategy.h"
+#include <algorithm>
 #include <vector>
 #include <map>
 #include <memory>
 #include <utility>
 #include "utils/log_adapter.h"
+#include "utils/convert_utils_base.h"
 
 namespace mindspore {
 namespace device {
 constexpr size_t kFirstGetMemEventIndex = 1;
 constexpr size_t kInitOrMallocMemEventIndex = 0;
+// The prefetch distance from file when the compute time of steps is unknown.
+constexpr size_t kDefaultFilePrefetchStep = 2;
+// The conservative bandwidth of reading the offload file, which is 1GB/s.
+constexpr double kFileReadBytesPerUs = 1000.0;
 
 std::vector<std::shared_ptr<MemEvent>> &MemOffloadStrategy::GetPreComputeEvents(size_t step) {
   if (pre_compute_events_.size() <= step) {
@@ -48,6 +54,9 @@ void MemOffloadStrategy::Execute() {
     GenSwapEventSet();
   }
   GenComputeMemEvents();
+  if (need_swap_ && host_mem_size_ > 0) {
+    GenFileSwapEvents();
+  }
 }
 
 void MemOffloadStrategy::CountMemUsage() {
@@ -246,6 +255,108 @@ void MemOffloadStrategy::GenComputeMemEvents() {
   }
 }
 
+void MemOffloadStrategy::GenFileSwapEvents() {
+  std::map<const void *, std::vector<size_t>> swap_in_steps;
+  for (size_t step = 0; step < total_step_; ++step) {
+    for (const auto &event : pre_compute_events_[step]) {
+      if (event->type == kSwapIn) {
+        (void)swap_in_steps[event->key].emplace_back(step);
+      }
+    }
+  }
+
+  // The swapped out memory occupies the host memory until it is swapped in, except the memory initialized from host
+  // which is swapped out to its own host memory.
+  std::vector<size_t> host_mem_used(total_step_, 0);
+  std::vector<std::pair<std::shared_ptr<MemEvent>, size_t>> candidates;
+  for (size_t step = 0; step < total_step_; ++step) {
+    for (const auto &event : post_compute_events_[step]) {
+      if (event->type != kSwapOut) {
+        continue;
+      }
+      const auto &mem_events_iter = mem_events_.find(event->key);
+      if (mem_events_iter == mem_events_.end() || mem_events_iter->second.empty() ||
+          mem_events_iter->second[kInitOrMallocMemEventIndex]->type == kInit) {
+        continue;
+      }
+      const auto &steps_iter = swap_in_steps.find(event->key);
+      if (steps_iter == swap_in_steps.end()) {
+        continue;
+      }
+      const auto &steps = steps_iter->second;
+      auto upper_iter = std::upper_bound(steps.begin(), steps.end(), step);
+      const size_t swap_in_step = upper_iter == steps.end() ? steps.front() : *upper_iter;
+      const size_t span = GetSpanBetweenMemEvents(step, swap_in_step);
+      for (size_t i = 1; i <= span; ++i) {
+        host_mem_used[(step + i) % total_step_] += event->mem_size;
+      }
+      // Only the memory swapped in within the same step loop can be moved to file.
+      if (swap_in_step > step) {
+        (void)candidates.emplace_back(event, swap_in_step);
+      }
+    }
+  }
+  const size_t max_host_mem_used = *std::max_element(host_mem_used.begin(), host_mem_used.end());
+  if (max_host_mem_used <= host_mem_size_) {
+    return;
+  }
+
+  // Move the memory kept longest in host to file first, until the host memory is enough at every step.
+  auto host_mem_cost = [](const std::pair<std::shared_ptr<MemEvent>, size_t> &candidate) {
+    return (candidate.second - candidate.first->index) * candidate.first->mem_size;
+  };
+  std::stable_sort(candidates.begin(), candidates.end(), [&host_mem_cost](const auto &lhs, const auto &rhs) {
+    return host_mem_cost(lhs) > host_mem_cost(rhs);
+  });
+  size_t file_swap_num = 0;
+  size_t file_swap_size = 0;
+  for (const auto &candidate : candidates) {
+    const auto &swap_out_event = candidate.first;
+    const size_t swap_out_step = swap_out_event->index;
+    const size_t swap_in_step = candidate.second;
+    const auto begin_iter = host_mem_used.begin() + SizeToLong(swap_out_step + 1);
+    const auto end_iter = host_mem_used.begin() + SizeToLong(swap_in_step + 1);
+    if (*std::max_element(begin_iter, end_iter) <= host_mem_size_) {
+      continue;
+    }
+    const size_t prefetch_step = GetPrefetchStep(swap_out_step, swap_in_step, swap_out_event->mem_size);
+    if (prefetch_step <= swap_out_step + 1) {
+      continue;
+    }
+    swap_out_event->type = kSwapOutToFile;
+    auto prefetch_event = std::make_shared<MemEvent>(kPrefetch, prefetch_step);
+    prefetch_event->key = swap_out_event->key;
+    prefetch_event->mem_size = swap_out_event->mem_size;
+    auto &prefetch_step_events = pre_compute_events_[prefetch_step];
+    (void)prefetch_step_events.insert(prefetch_step_events.begin(), prefetch_event);
+    for (size_t step = swap_out_step + 1; step < prefetch_step; ++step) {
+      host_mem_used[step] -= swap_out_event->mem_size;
+    }
+    ++file_swap_num;
+    file_swap_size += swap_out_event->mem_size;
+  }
+  MS_LOG(INFO) << "Available host mem size: " << host_mem_size_ << ", swapped out mem needs host mem size "
+               << max_host_mem_used << ", " << file_swap_num << " swap events of total size " << file_swap_size
+               << " are moved to file and the host mem size needed is "
+               << *std::max_element(host_mem_used.begin(), host_mem_used.end());
+}
+
+size_t MemOffloadStrategy::GetPrefetchStep(size_t swap_out_step, size_t swap_in_step, size_t mem_size) const {
+  if (compute_time_.size() != total_step_) {
+    return swap_in_step > swap_out_step + kDefaultFilePrefetchStep ? swap_in_step - kDefaultFilePrefetchStep
+                                                                    : swap_out_step + 1;
+  }
+  // Start reading the file early enough so that the kernels running in the meantime hide the reading time.
+  const double read_time = mem_size / kFileReadBytesPerUs;
+  double hidden_time = 0;
+  size_t prefetch_step = swap_in_step;
+  while (prefetch_step > swap_out_step + 1 && hidden_time < read_time) {
+    --prefetch_step;
+    hidden_time += compute_time_[prefetch_step];
+  }
+  return prefetch_step;
+}
+
 void MemOffloadStrategy::GenFreeEvent(const std::shared_ptr<MemEvent> &last_event) {
   MS_EXCEPTION_IF_NULL(last_event);
   auto free_event = std::make_shared<MemEvent>(kFree, last_event->index);
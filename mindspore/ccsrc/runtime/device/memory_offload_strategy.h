@@ -26,7 +26,7 @@ namespace mindspore {
 namespace device {
 enum MemPriority { kMemPriorityLow, kMemPriorityHigh };
 
-enum MemEventType { kInit, kMalloc, kGet, kFree, kSwapIn, kSwapOut };
+enum MemEventType { kInit, kMalloc, kGet, kFree, kSwapIn, kSwapOut, kSwapOutToFile, kPrefetch };
 
 struct MemEvent {
   MemEvent(const MemEventType &in_type, size_t in_index) : type(in_type), index(in_index) {}
@@ -61,6 +61,9 @@ class MemOffloadStrategy {
 
   void set_mem_size(size_t mem_size) { mem_size_ = mem_size; }
 
+  // The host memory size for the swapped out memory, the memory beyond it is swapped out to file. Zero means no limit.
+  void set_host_mem_size(size_t host_mem_size) { host_mem_size_ = host_mem_size; }
+
   bool need_swap() const { return need_swap_; }
 
  private:
@@ -76,6 +79,10 @@ class MemOffloadStrategy {
 
   void GenComputeMemEvents();
 
+  void GenFileSwapEvents();
+
+  size_t GetPrefetchStep(size_t swap_out_step, size_t swap_in_step, size_t mem_size) const;
+
   void GenFreeEvent(const std::shared_ptr<MemEvent> &last_event);
   std::set<size_t> GetSwapOutEventIndex(const void *key, const std::vector<std::shared_ptr<MemEvent>> &mem_events);
 
@@ -92,6 +99,7 @@ class MemOffloadStrategy {
   std::vector<std::vector<std::shared_ptr<MemEvent>>> post_compute_events_;
 
   size_t mem_size_{0};
+  size_t host_mem_size_{0};
   std::vector<double> compute_time_;
   bool need_swap_{false};
   std::multimap<size_t, std::pair<std::shared_ptr<MemEvent>, size_t>> event_span_;
@@ -72,6 +72,21 @@ void MemScheduler::ClearAllocatedMem() {
     }
   }
   swap_host_ptr_.clear();
+  if (file_store_ != nullptr) {
+    file_store_->Clear();
+  }
+}
+
+bool MemScheduler::EnableFileOffload(const std::string &dir, size_t host_mem_size) {
+  if (file_store_ == nullptr) {
+    auto file_store = std::make_shared<OffloadFileStore>();
+    if (!file_store->Initialize(dir)) {
+      return false;
+    }
+    file_store_ = file_store;
+  }
+  host_mem_size_ = host_mem_size;
+  return true;
 }
 
 void MemScheduler::Record(const void *key, const MemEventType &event_type, size_t mem_size) {
@@ -158,20 +173,14 @@ bool MemScheduler::PreComputeMalloc(const std::shared_ptr<MemEvent> &event, void
 }
 
 bool MemScheduler::PreComputeSwapIn(const std::shared_ptr<MemEvent> &event, void *stream) {
-  bool from_init = true;
-  void *host_ptr = nullptr;
-  GetHostPtr(event->key, &host_ptr, &from_init);
   auto device_ptr = MallocDevice(event->mem_size, stream);
   if (device_ptr == nullptr) {
     return false;
   }
-  MS_EXCEPTION_IF_NULL(host_ptr);
-  mem_handler_->SwapIn(host_ptr, device_ptr, event->mem_size, stream);
-  mem_result_[event->key] = device_ptr;
-  if (!from_init) {
-    mem_handler_->FreeHost(host_ptr);
-    (void)swap_host_ptr_.erase(event->key);
+  if (!SwapIn(event->key, device_ptr, event->mem_size, stream)) {
+    MS_LOG(EXCEPTION) << "Swap in the memory of key " << event->key << " failed.";
   }
+  mem_result_[event->key] = device_ptr;
   return true;
 }
 
@@ -190,14 +199,12 @@ bool MemScheduler::PreComputeGet(const std::shared_ptr<MemEvent> &event, void *s
   void *host_ptr = nullptr;
   bool from_init = false;
   GetHostPtr(key, &host_ptr, &from_init);
-  if (host_ptr == nullptr) {
+  if (host_ptr == nullptr && (file_store_ == nullptr || !file_store_->Contains(key))) {
     return false;
   }
   auto device_ptr = MallocDevice(mem_size, stream);
-  mem_handler_->SwapIn(host_ptr, device_ptr, mem_size, stream);
-  if (!from_init) {
-    (void)swap_host_ptr_.erase(host_ptr);
-    mem_handler_->FreeHost(host_ptr);
+  if (!SwapIn(key, device_ptr, mem_size, stream)) {
+    return false;
   }
   mem_result_[key] = device_ptr;
   return true;
@@ -221,6 +228,9 @@ bool MemScheduler::PreCompute(void *stream) {
       ret = PreComputeSwapIn(event, stream);
     } else if (event->type == kGet) {
       ret = PreComputeGet(event, stream);
+    } else if (event->type == kPrefetch && !mock_ && file_store_ != nullptr) {
+      // Start reading the memory from file, which runs with the kernels before the swap in.
+      (void)file_store_->Prefetch(event->key);
     }
     if (!ret) {
       return false;
@@ -259,6 +269,12 @@ bool MemScheduler::PostCompute(void *stream) {
         return false;
       }
       SwapOutAndFreeDevice(event->key, device_ptr, event->mem_size, stream);
+    } else if (event->type == kSwapOutToFile) {
+      auto device_ptr = mem_result_[event->key];
+      if (device_ptr == nullptr) {
+        return false;
+      }
+      SwapOutToFileAndFreeDevice(event->key, device_ptr, event->mem_size, stream);
     }
   }
   ++current_step_;
@@ -281,6 +297,7 @@ void MemScheduler::OptMemUsage(float mem_used_factor) {
   auto available_mem_size = mem_handler_->GetAvailableMemSize();
   available_mem_size = FloatToSize(available_mem_size * mem_used_factor);
   strategy_->set_mem_size(available_mem_size);
+  strategy_->set_host_mem_size(file_store_ == nullptr ? 0 : host_mem_size_);
   strategy_->Execute();
 }
 
@@ -291,7 +308,9 @@ bool MemScheduler::Optimize() {
     bool ret = true;
     OptMemUsage(mem_used_factor);
     for (size_t mock_time = 0; mock_time < kMockTimes; ++mock_time) {
+      mock_ = true;
       ret = Mock();
+      mock_ = false;
       if (!ret) {
         break;
       }
@@ -395,6 +414,51 @@ void MemScheduler::SwapOutAndFreeDevice(const void *key, void *device_ptr, size_
   (void)mem_result_.erase(key);
 }
 
+void MemScheduler::SwapOutToFileAndFreeDevice(const void *key, void *device_ptr, size_t mem_size, void *stream) {
+  void *host_ptr = nullptr;
+  bool from_init = false;
+  GetHostPtr(key, &host_ptr, &from_init);
+  // The file io is skipped when mocking, and the memory initialized from host is swapped out to its own host memory.
+  if (mock_ || file_store_ == nullptr || from_init) {
+    SwapOutAndFreeDevice(key, device_ptr, mem_size, stream);
+    return;
+  }
+  host_ptr = GetOrMallocHostPtr(key, mem_size);
+  MS_EXCEPTION_IF_NULL(host_ptr);
+  mem_handler_->SwapOut(device_ptr, host_ptr, mem_size, stream);
+  mem_handler_->FreeDevice(device_ptr);
+  (void)mem_result_.erase(key);
+  // The memory stays in host if writing the file fails.
+  if (file_store_->Store(key, host_ptr, mem_size)) {
+    mem_handler_->FreeHost(host_ptr);
+    (void)swap_host_ptr_.erase(key);
+  }
+}
+
+bool MemScheduler::SwapIn(const void *key, void *device_ptr, size_t mem_size, void *stream) {
+  void *host_ptr = nullptr;
+  bool from_init = false;
+  GetHostPtr(key, &host_ptr, &from_init);
+  if (host_ptr != nullptr) {
+    mem_handler_->SwapIn(host_ptr, device_ptr, mem_size, stream);
+    if (!from_init) {
+      mem_handler_->FreeHost(host_ptr);
+      (void)swap_host_ptr_.erase(key);
+    }
+    return true;
+  }
+  if (file_store_ == nullptr || !file_store_->Contains(key)) {
+    return false;
+  }
+  auto file_data = file_store_->Fetch(key);
+  if (file_data == nullptr) {
+    return false;
+  }
+  mem_handler_->SwapIn(file_data, device_ptr, mem_size, stream);
+  file_store_->Release(key);
+  return true;
+}
+
 size_t MemScheduler::GetMemSize(const void *key) {
   const auto &iter = mem_events_.find(key);
   if (iter == mem_events_.end() || iter->second.empty()) {
@@ -20,8 +20,10 @@
 #include <map>
 #include <set>
 #include <memory>
+#include <string>
 #include <utility>
 #include "runtime/device/memory_offload_strategy.h"
+#include "runtime/device/offload_file_store.h"
 
 namespace mindspore {
 namespace device {
@@ -88,6 +90,9 @@ class MemScheduler {
 
   void ClearMemNeedInit() { high_priority_mem_need_init_.clear(); }
 
+  // Offload the swapped out memory beyond the host memory size to the file in the directory.
+  bool EnableFileOffload(const std::string &dir, size_t host_mem_size);
+
  private:
   void Record(const void *key, const MemEventType &event_type, size_t mem_size = 0);
 
@@ -101,6 +106,11 @@ class MemScheduler {
 
   void SwapOutAndFreeDevice(const void *key, void *device_ptr, size_t mem_size, void *stream);
 
+  void SwapOutToFileAndFreeDevice(const void *key, void *device_ptr, size_t mem_size, void *stream);
+
+  // Swap in the memory from the host, or from the offload file if the memory is there.
+  bool SwapIn(const void *key, void *device_ptr, size_t mem_size, void *stream);
+
   size_t GetMemSize(const void *key);
 
   void *GetOrMallocHostPtr(const void *key, size_t mem_size);
@@ -134,6 +144,9 @@ class MemScheduler {
   bool updated_{false};
   std::shared_ptr<MemHandler> mem_handler_{nullptr};
   std::shared_ptr<MemOffloadStrategy> strategy_{nullptr};
+  std::shared_ptr<OffloadFileStore> file_store_{nullptr};
+  size_t host_mem_size_{0};
+  bool mock_{false};
 };
 
 class MemSchedulerManager {
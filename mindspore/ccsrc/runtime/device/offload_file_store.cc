@@ -0,0 +1,297 @@
+/**
+ * Copyright 2022 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "runtime/device/offload_file_store.h"
+#include <atomic>
+#include <cerrno>
+#include <cstdlib>
+#include <cstring>
+#include <utility>
+#ifndef _WIN32
+#include <fcntl.h>
+#include <unistd.h>
+#endif
+#include "utils/log_adapter.h"
+
+namespace mindspore {
+namespace device {
+namespace {
+// The alignment of the buffers, offsets and sizes of the direct io.
+constexpr size_t kDirectIoAlignSize = 4096;
+
+size_t AlignIoSize(size_t size) { return (size + kDirectIoAlignSize - 1) / kDirectIoAlignSize * kDirectIoAlignSize; }
+
+std::string GenerateFileName(const std::string &dir) {
+  static std::atomic<size_t> file_index{0};
+#ifndef _WIN32
+  auto pid = getpid();
+#else
+  int pid = 0;
+#endif
+  return dir + "/mindspore_mem_offload_" + std::to_string(pid) + "_" + std::to_string(file_index++) + ".swap";
+}
+}  // namespace
+
+bool OffloadFileStore::Initialize(const std::string &dir) {
+  if (fd_ >= 0) {
+    return true;
+  }
+#ifndef _WIN32
+  const auto &file_name = GenerateFileName(dir);
+  const int flags = O_RDWR | O_CREAT | O_EXCL;
+#ifdef O_DIRECT
+  fd_ = open(file_name.c_str(), flags | O_DIRECT, S_IRUSR | S_IWUSR);
+  direct_io_ = fd_ >= 0;
+#endif
+  if (fd_ < 0) {
+    // Some file systems such as tmpfs don't support the direct io.
+    fd_ = open(file_name.c_str(), flags, S_IRUSR | S_IWUSR);
+  }
+  if (fd_ < 0) {
+    MS_LOG(WARNING) << "Create the memory offload file " << file_name << " failed, errno: " << errno;
+    return false;
+  }
+  // The file is removed once it is closed, even if the process exits abnormally.
+  (void)unlink(file_name.c_str());
+  stop_ = false;
+  io_thread_ = std::thread(&OffloadFileStore::IoLoop, this);
+  MS_LOG(INFO) << "Create the memory offload file " << file_name << ", direct io: " << direct_io_;
+  return true;
+#else
+  MS_LOG(WARNING) << "The memory offload to file is not supported on windows, dir: " << dir;
+  return false;
+#endif
+}
+
+void OffloadFileStore::Finalize() {
+  if (fd_ < 0) {
+    return;
+  }
+  Clear();
+  {
+    std::lock_guard<std::mutex> lock(io_mutex_);
+    stop_ = true;
+  }
+  io_cond_.notify_all();
+  if (io_thread_.joinable()) {
+    io_thread_.join();
+  }
+#ifndef _WIN32
+  (void)close(fd_);
+#endif
+  fd_ = -1;
+  file_size_ = 0;
+}
+
+bool OffloadFileStore::Store(const void *key, const void *host_ptr, size_t mem_size) {
+  if (fd_ < 0 || host_ptr == nullptr || mem_size == 0) {
+    return false;
+  }
+  std::lock_guard<std::mutex> lock(slot_mutex_);
+  auto &slot = slots_[key];
+  if (slot.pending_io.valid()) {
+    (void)slot.pending_io.get();
+  }
+  FreeStaging(slot.staging);
+  slot.staging = nullptr;
+  const auto io_size = AlignIoSize(mem_size);
+  if (io_size > slot.capacity) {
+    slot.offset = file_size_;
+    slot.capacity = io_size;
+    file_size_ += io_size;
+  }
+  auto buf = MallocStaging(io_size);
+  if (buf == nullptr) {
+    slot.stored = false;
+    return false;
+  }
+  (void)memcpy(buf, host_ptr, mem_size);
+  const auto offset = slot.offset;
+  slot.mem_size = mem_size;
+  slot.stored = true;
+  slot.pending_io = PushIo(std::packaged_task<bool()>([this, buf, io_size, offset]() {
+    auto ret = WriteFile(buf, io_size, offset);
+    FreeStaging(buf);
+    return ret;
+  }));
+  return true;
+}
+
+bool OffloadFileStore::Prefetch(const void *key) {
+  std::lock_guard<std::mutex> lock(slot_mutex_);
+  auto iter = slots_.find(key);
+  if (iter == slots_.end() || !iter->second.stored) {
+    return false;
+  }
+  auto &slot = iter->second;
+  if (slot.staging != nullptr) {
+    return true;
+  }
+  slot.staging = MallocStaging(slot.capacity);
+  if (slot.staging == nullptr) {
+    return false;
+  }
+  auto buf = slot.staging;
+  const auto io_size = slot.capacity;
+  const auto offset = slot.offset;
+  slot.pending_io = PushIo(std::packaged_task<bool()>([this, buf, io_size, offset]() {
+    return ReadFile(buf, io_size, offset);
+  }));
+  return true;
+}
+
+const void *OffloadFileStore::Fetch(const void *key) {
+  if (!Prefetch(key)) {
+    MS_LOG(ERROR) << "Read the memory of key " << key << " from the offload file failed.";
+    return nullptr;
+  }
+  std::shared_future<bool> pending_io;
+  void *staging = nullptr;
+  {
+    std::lock_guard<std::mutex> lock(slot_mutex_);
+    auto &slot = slots_[key];
+    pending_io = slot.pending_io;
+    staging = slot.staging;
+  }
+  if (pending_io.valid() && !pending_io.get()) {
+    MS_LOG(ERROR) << "Read the memory of key " << key << " from the offload file failed.";
+    return nullptr;
+  }
+  return staging;
+}
+
+void OffloadFileStore::Release(const void *key) {
+  std::lock_guard<std::mutex> lock(slot_mutex_);
+  auto iter = slots_.find(key);
+  if (iter == slots_.end()) {
+    return;
+  }
+  auto &slot = iter->second;
+  if (slot.pending_io.valid()) {
+    (void)slot.pending_io.get();
+  }
+  FreeStaging(slot.staging);
+  slot.staging = nullptr;
+  slot.stored = false;
+}
+
+bool OffloadFileStore::Contains(const void *key) const {
+  std::lock_guard<std::mutex> lock(slot_mutex_);
+  auto iter = slots_.find(key);
+  return iter != slots_.end() && iter->second.stored;
+}
+
+void OffloadFileStore::Clear() {
+  std::lock_guard<std::mutex> lock(slot_mutex_);
+  for (auto &item : slots_) {
+    auto &slot = item.second;
+    if (slot.pending_io.valid()) {
+      (void)slot.pending_io.get();
+    }
+    FreeStaging(slot.staging);
+  }
+  slots_.clear();
+  file_size_ = 0;
+}
+
+void OffloadFileStore::IoLoop() {
+  while (true) {
+    std::packaged_task<bool()> io;
+    {
+      std::unique_lock<std::mutex> lock(io_mutex_);
+      io_cond_.wait(lock, [this]() { return stop_ || !io_queue_.empty(); });
+      if (io_queue_.empty()) {
+        return;
+      }
+      io = std::move(io_queue_.front());
+      io_queue_.pop_front();
+    }
+    io();
+  }
+}
+
+std::shared_future<bool> OffloadFileStore::PushIo(std::packaged_task<bool()> &&io) {
+  auto future = io.get_future().share();
+  {
+    std::lock_guard<std::mutex> lock(io_mutex_);
+    io_queue_.emplace_back(std::move(io));
+  }
+  io_cond_.notify_one();
+  return future;
+}
+
+bool OffloadFileStore::WriteFile(const void *buf, size_t size, size_t offset) const {
+#ifndef _WIN32
+  size_t written = 0;
+  while (written < size) {
+    auto ret = pwrite(fd_, static_cast<const uint8_t *>(buf) + written, size - written,
+                      static_cast<off_t>(offset + written));
+    if (ret < 0 && errno == EINTR) {
+      continue;
+    }
+    if (ret <= 0) {
+      MS_LOG(ERROR) << "Write the memory offload file failed, errno: " << errno;
+      return false;
+    }
+    written += static_cast<size_t>(ret);
+  }
+  return true;
+#else
+  return false;
+#endif
+}
+
+bool OffloadFileStore::ReadFile(void *buf, size_t size, size_t offset) const {
+#ifndef _WIN32
+  size_t read_size = 0;
+  while (read_size < size) {
+    auto ret = pread(fd_, static_cast<uint8_t *>(buf) + read_size, size - read_size,
+                     static_cast<off_t>(offset + read_size));
+    if (ret < 0 && errno == EINTR) {
+      continue;
+    }
+    if (ret <= 0) {
+      MS_LOG(ERROR) << "Read the memory offload file failed, errno: " << errno;
+      return false;
+    }
+    read_size += static_cast<size_t>(ret);
+  }
+  return true;
+#else
+  return false;
+#endif
+}
+
+void *OffloadFileStore::MallocStaging(size_t size) {
+#ifndef _WIN32
+  void *ptr = nullptr;
+  if (posix_memalign(&ptr, kDirectIoAlignSize, size) != 0) {
+    MS_LOG(ERROR) << "Malloc the staging buffer of size " << size << " for the memory offload file failed.";
+    return nullptr;
+  }
+  return ptr;
+#else
+  return nullptr;
+#endif
+}
+
+void OffloadFileStore::FreeStaging(void *ptr) {
+  if (ptr != nullptr) {
+    free(ptr);
+  }
+}
+}  // namespace device
+}  // namespace mindspore
@@ -0,0 +1,89 @@
+/**
+ * Copyright 2022 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef MINDSPORE_CCSRC_RUNTIME_DEVICE_OFFLOAD_FILE_STORE_H_
+#define MINDSPORE_CCSRC_RUNTIME_DEVICE_OFFLOAD_FILE_STORE_H_
+#include <condition_variable>
+#include <deque>
+#include <future>
+#include <map>
+#include <mutex>
+#include <string>
+#include <thread>
+
+namespace mindspore {
+namespace device {
+// The disk tier of the memory offload, which keeps the memory swapped out of the device in a file on the local disk
+// when the host memory is not enough either. The file is opened with direct io if the file system supports, so the
+// offloaded data doesn't occupy the page cache. The reads and writes run on a background io thread: Store returns
+// once the data is copied into a staging buffer, and Prefetch starts reading the data back ahead of its use.
+class OffloadFileStore {
+ public:
+  OffloadFileStore() = default;
+  ~OffloadFileStore() { Finalize(); }
+
+  // Create the offload file in the directory and start the io thread.
+  bool Initialize(const std::string &dir);
+  void Finalize();
+
+  // Write the memory of key to the file asynchronously, the memory can be released when it returns.
+  bool Store(const void *key, const void *host_ptr, size_t mem_size);
+  // Start reading the memory of key from the file into the staging buffer asynchronously.
+  bool Prefetch(const void *key);
+  // Wait for the reading of key and return the staging buffer holding the data, the data is read synchronously if it
+  // is not prefetched. Return nullptr if the io fails.
+  const void *Fetch(const void *key);
+  // Release the staging buffer of key after the data is used, the data in the file is invalid afterwards.
+  void Release(const void *key);
+
+  // Whether the valid data of key is in the file.
+  bool Contains(const void *key) const;
+  // Wait for all the io and drop all the data.
+  void Clear();
+
+ private:
+  struct Slot {
+    size_t offset{0};
+    size_t capacity{0};
+    size_t mem_size{0};
+    bool stored{false};
+    void *staging{nullptr};
+    // The last io of the slot, the io thread runs the io in order so later io of the slot doesn't wait for it.
+    std::shared_future<bool> pending_io;
+  };
+
+  void IoLoop();
+  std::shared_future<bool> PushIo(std::packaged_task<bool()> &&io);
+  bool WriteFile(const void *buf, size_t size, size_t offset) const;
+  bool ReadFile(void *buf, size_t size, size_t offset) const;
+  static void *MallocStaging(size_t size);
+  static void FreeStaging(void *ptr);
+
+  int fd_{-1};
+  bool direct_io_{false};
+  size_t file_size_{0};
+  mutable std::mutex slot_mutex_;
+  std::map<const void *, Slot> slots_;
+
+  std::mutex io_mutex_;
+  std::condition_variable io_cond_;
+  std::deque<std::packaged_task<bool()>> io_queue_;
+  bool stop_{false};
+  std::thread io_thread_;
+};
+}  // namespace device
+}  // namespace mindspore
+#endif  // MINDSPORE_CCSRC_RUNTIME_DEVICE_OFFLOAD_FILE_STORE_H_
@@ -15,6 +15,7 @@
  */
 
 #include "runtime/graph_scheduler/actor/kernel_actor.h"
+#include <algorithm>
 #include "runtime/graph_scheduler/actor/memory_manager_actor.h"
 #include "runtime/graph_scheduler/actor/output_actor.h"
 #include "runtime/graph_scheduler/actor/recorder_actor.h"
@@ -30,6 +31,24 @@ namespace runtime {
 using distributed::collective::CollectiveManager;
 using distributed::recovery::RecoveryContext;
 
+namespace {
+// The device tensors bound by the static memory plan keep the memory all the time, so the memory manager is skipped
+// when all the device tensors of the actor are planned.
+bool IsMemoryAllocPlanned(const std::vector<DeviceTensor *> &alloc_list) {
+  return std::all_of(alloc_list.begin(), alloc_list.end(), [](const DeviceTensor *device_tensor) {
+    return (device_tensor != nullptr) && device_tensor->is_ptr_persisted() && (device_tensor->GetPtr() != nullptr);
+  });
+}
+
+// The free request does nothing for the device tensors of the max reference count.
+bool IsMemoryFreeSkipped(const std::vector<DeviceTensor *> &free_list) {
+  return std::all_of(free_list.begin(), free_list.end(), [](const DeviceTensor *device_tensor) {
+    return (device_tensor != nullptr) && (device_tensor->original_ref_count() == SIZE_MAX) &&
+           (device_tensor->dynamic_ref_count() == INT32_MAX);
+  });
+}
+}  // namespace
+
 void KernelActor::Init() {
   // Check device contexts number.
   if (device_contexts_.size() != device::kDeviceContextsNumOne) {
@@ -105,7 +124,7 @@ void KernelActor::Run(OpContext<DeviceTensor> *const context) {
     FetchWorkspaceDeviceTensor();
   }
 
-  if (memory_alloc_list_.size() > 0) {
+  if ((memory_alloc_list_.size() > 0) && !IsMemoryAllocPlanned(memory_alloc_list_)) {
     SendMemoryAllocReq(context);
   } else {
     OnMemoryAllocFinish(context);
@@ -219,11 +238,13 @@ void KernelActor::SendMemoryAllocReq(OpContext<DeviceTensor> *const context) {
 
 void KernelActor::SendMemoryFreeReq(OpContext<DeviceTensor> *const context) {
   MS_EXCEPTION_IF_NULL(device_contexts_[0]);
-  if (strategy_ == GraphExecutionStrategy::kPipeline) {
-    ActorDispatcher::Send(memory_manager_aid_, &MemoryManagerActor::FreeMemory, &memory_free_list_, device_contexts_[0],
-                          context, GetAID());
-  } else {
-    FreeMemory(memory_free_list_, device_contexts_[0]);
+  if (!IsMemoryFreeSkipped(memory_free_list_)) {
+    if (strategy_ == GraphExecutionStrategy::kPipeline) {
+      ActorDispatcher::Send(memory_manager_aid_, &MemoryManagerActor::FreeMemory, &memory_free_list_,
+                            device_contexts_[0], context, GetAID());
+    } else {
+      FreeMemory(memory_free_list_, device_contexts_[0]);
+    }
   }
 
   // Free the address that is the temp store for kernel input copy.
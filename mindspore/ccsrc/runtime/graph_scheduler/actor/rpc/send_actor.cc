@@ -20,6 +20,12 @@
 
 namespace mindspore {
 namespace runtime {
+namespace {
+// The inputs not smaller than this are sent without copying, for the smaller ones the copy is cheaper than waiting for
+// the network.
+constexpr size_t kZeroCopySendThreshold = 1024 * 1024;
+}  // namespace
+
 void SendActor::SetRouteInfo(uint32_t, const std::string &, const std::string &send_src_node_name,
                              const std::string &send_dst_node_name) {
   auto peer_actor_id = inter_process_edge_name_;
@@ -48,38 +54,88 @@ bool SendActor::ConnectServer() {
   return true;
 }
 
+void SendActor::SendMemoryFreeReq(OpContext<DeviceTensor> *const context) {
+  if (IsZeroCopyDeferred()) {
+    return;
+  }
+  KernelActor::SendMemoryFreeReq(context);
+}
+
 void SendActor::SendOutput(OpContext<DeviceTensor> *const context) {
   MS_ERROR_IF_NULL_WO_RET_VAL(context);
   MS_ERROR_IF_NULL_WO_RET_VAL(client_);
-  // Step 1: Send data and control outputs.
-  AbstractActor::SendOutput(context);
+  // Step 1: Send input data(inter-process data is the input of the Send kernel) to peers.
+  auto send_output = launch_info_.inputs_;
+  bool zero_copy = IsZeroCopyDeferred();
+  if (send_output.empty()) {
+    MS_LOG(ERROR) << "Send kernel has no output tensor.";
+  } else {
+    for (const auto &peer : peer_actor_urls_) {
+      std::string peer_server_url = peer.second;
+      auto message = BuildRpcMessage(send_output, peer_server_url, zero_copy ? context : nullptr);
+      if (message == nullptr) {
+        MS_LOG(ERROR) << "Build rpc message failed for inter-process edge: " << peer.first;
+        continue;
+      }
+      MS_LOG(INFO) << "Rpc actor send message for inter-process edge: " << peer.first;
+      client_->SendAsync(std::move(message));
+    }
+  }
 
-  // Step 2: Erase inter-process inputs for this sequential number.
-  if (input_op_inter_process_.count(context->sequential_num_) != 0) {
-    input_op_inter_process_.erase(context->sequential_num_);
+  // Step 2: The inputs referenced by the messages are freed once the messages are sent out, the rest steps are done by
+  // OnZeroCopyMessageSent then, so the actor thread isn't blocked by the network.
+  if (zero_copy_msg_num_ > 0) {
+    return;
   }
+  FinishSendOutput(context, zero_copy);
+}
 
-  // Step 3: Send input data(inter-process data is the input of the Send kernel) to peers.
-  if (launch_info_.inputs_.empty()) {
-    MS_LOG(ERROR) << "Send kernel has no output tensor.";
+void SendActor::OnZeroCopyMessageSent(OpContext<DeviceTensor> *const context) {
+  if (zero_copy_msg_num_ == 0) {
+    MS_LOG(ERROR) << "No message is in flight for the send actor: " << GetAID().Name();
     return;
   }
-  auto send_output = launch_info_.inputs_;
-  for (const auto &peer : peer_actor_urls_) {
-    std::string peer_server_url = peer.second;
-    auto message = BuildRpcMessage(send_output, peer_server_url);
-    MS_ERROR_IF_NULL_WO_RET_VAL(message);
-    MS_LOG(INFO) << "Rpc actor send message for inter-process edge: " << peer.first;
-    client_->SendAsync(std::move(message));
+  if (--zero_copy_msg_num_ == 0) {
+    FinishSendOutput(context, true);
+  }
+}
+
+void SendActor::FinishSendOutput(OpContext<DeviceTensor> *const context, bool free_inputs) {
+  MS_ERROR_IF_NULL_WO_RET_VAL(context);
+  // The input memory deferred by SendMemoryFreeReq must be freed in front of sending the outputs, see
+  // KernelActor::PostLaunchKernel.
+  if (free_inputs && memory_free_list_.size() > 0) {
+    KernelActor::SendMemoryFreeReq(context);
+  }
+
+  // Step 3: Send data and control outputs.
+  AbstractActor::SendOutput(context);
+
+  // Step 4: Erase inter-process inputs for this sequential number.
+  if (input_op_inter_process_.count(context->sequential_num_) != 0) {
+    input_op_inter_process_.erase(context->sequential_num_);
   }
 }
 
 std::unique_ptr<MessageBase> SendActor::BuildRpcMessage(const kernel::AddressPtrList &data_list,
-                                                        const std::string &server_url) {
+                                                        const std::string &server_url,
+                                                        OpContext<DeviceTensor> *const zero_copy_context) {
   std::unique_ptr<MessageBase> message = std::make_unique<MessageBase>();
   MS_ERROR_IF_NULL_W_RET_VAL(message, nullptr);
   message->to = AID("", server_url);
 
+  if (zero_copy_context != nullptr) {
+    for (const auto &data : data_list) {
+      message->AppendBodyBuffer(data->addr, data->size);
+    }
+    ++zero_copy_msg_num_;
+    // The releaser is called by the tcp thread, so the actor is notified through its mailbox.
+    auto aid = GetAID();
+    message->SetBodyReleaser(
+      [aid, zero_copy_context]() { Async(aid, &SendActor::OnZeroCopyMessageSent, zero_copy_context); });
+    return message;
+  }
+
   size_t total_size = 0;
   total_size =
     std::accumulate(data_list.begin(), data_list.end(), total_size,
@@ -90,5 +146,20 @@ std::unique_ptr<MessageBase> SendActor::BuildRpcMessage(const kernel::AddressPtr
   }
   return message;
 }
+
+bool SendActor::IsZeroCopyDeferred() const {
+  // The freeing of the inputs can be deferred only if the outputs are sent by the actor itself.
+  if (strategy_ != GraphExecutionStrategy::kPipeline) {
+    return false;
+  }
+  size_t total_size = 0;
+  for (const auto &data : launch_info_.inputs_) {
+    if (data == nullptr || data->addr == nullptr) {
+      return false;
+    }
+    total_size += data->size;
+  }
+  return total_size >= kZeroCopySendThreshold;
+}
 }  // namespace runtime
 }  // namespace mindspore
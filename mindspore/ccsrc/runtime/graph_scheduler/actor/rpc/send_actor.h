@@ -43,13 +43,29 @@ class SendActor : public RpcActor {
   // Lookup peer actors' route and create connection to them.
   bool ConnectServer();
 
+  // The memory of the large inputs is referenced by the messages sent without copying, so it's freed after the messages
+  // are sent out in OnZeroCopyMessageSent.
+  void SendMemoryFreeReq(OpContext<DeviceTensor> *const context) override;
+
+  // Called through the mailbox of the actor when a message referencing the inputs is sent out or dropped. The inputs
+  // are freed and the outputs are sent after all the messages of the step are released.
+  void OnZeroCopyMessageSent(OpContext<DeviceTensor> *const context);
+
  protected:
   // After rpc send kernel is launched, inter-process data should be sent.
   void SendOutput(OpContext<DeviceTensor> *const context) override;
 
  private:
-  // Client only supports to send MessageBase, so build MessageBase with data and url.
-  std::unique_ptr<MessageBase> BuildRpcMessage(const kernel::AddressPtrList &data_list, const std::string &server_url);
+  // Client only supports to send MessageBase, so build MessageBase with data and url. The data is referenced by the
+  // message rather than copied if zero_copy_context is not nullptr, which is notified when the message is released.
+  std::unique_ptr<MessageBase> BuildRpcMessage(const kernel::AddressPtrList &data_list, const std::string &server_url,
+                                               OpContext<DeviceTensor> *const zero_copy_context);
+
+  // Whether the inputs are large enough to be sent without copying, whose freeing is deferred until they are sent.
+  bool IsZeroCopyDeferred() const;
+
+  // Free the inputs deferred by SendMemoryFreeReq if free_inputs is true, and send the outputs of the step.
+  void FinishSendOutput(OpContext<DeviceTensor> *const context, bool free_inputs);
 
   friend class GraphScheduler;
 
@@ -58,6 +74,9 @@ class SendActor : public RpcActor {
   mindspore::HashMap<std::string, std::string> peer_actor_urls_;
 
   std::unique_ptr<TCPClient> client_;
+
+  // The number of the messages in flight which reference the inputs, it's only accessed by the actor thread.
+  size_t zero_copy_msg_num_{0};
 };
 
 using SendActorPtr = std::shared_ptr<SendActor>;
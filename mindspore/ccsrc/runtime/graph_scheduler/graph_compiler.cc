@@ -550,6 +550,9 @@ GraphId GraphCompiler::CompileGraphImpl(const KernelGraphPtr &graph, const Devic
   MS_EXCEPTION_IF_NULL(session_);
   session_->InitAllBucket(graph, device_context);
   SetSummaryNodesRefCount(graph.get());
+
+  // Bind the memory of the static graph ahead of time if the device supports.
+  device_context->PlanStaticMemory(graph);
 #ifdef ENABLE_DUMP_IR
   // Dump .pb graph after graph optimization.
   if (save_graphs) {
@@ -110,6 +110,9 @@ class DeviceContext {
   virtual void PreprocessBeforeRunGraph(const KernelGraphPtr &graph) const {}
   // Adjust single op kernel graph before run graph, used in PyNative Mode.
   virtual void PreprocessBeforeRunSingleOpGraph(const KernelGraphPtr &graph) const {}
+  // Plan the memory of kernel graph ahead of time after the device addresses are created, used in Graph Mode. The
+  // default behavior is allocating the memory dynamically when running graph.
+  virtual void PlanStaticMemory(const KernelGraphPtr &graph) const {}
 
   // Infer kernel shape and update abstract info for dynamic shape kernel.
   virtual void UpdateDynamicShape(const CNodePtr &kernel) const { AnfAlgo::InferShape(kernel); }
@@ -19,6 +19,8 @@
 
 #include <utility>
 #include <string>
+#include <vector>
+#include <functional>
 
 #include "actor/aid.h"
 
@@ -50,7 +52,17 @@ class MessageBase {
                        Type eType = Type::KMSG)
       : from(aFrom), to(aTo), name(sName), body(std::move(sBody)), type(eType) {}
 
-  virtual ~MessageBase() {}
+  virtual ~MessageBase() {
+    if (body_releaser) {
+      body_releaser();
+    }
+  }
+
+  // The external buffer referenced by the message body.
+  struct BodyBuffer {
+    void *data{nullptr};
+    size_t size{0};
+  };
 
   inline std::string &Name() { return name; }
 
@@ -60,6 +72,37 @@ class MessageBase {
 
   inline std::string &Body() { return body; }
 
+  // Reference the external buffer as a part of the body without copying. The body of the message is the `body` string
+  // followed by the buffers in order, which are gathered by the tcp layer when sending. The buffer must be valid until
+  // the releaser is called, which happens when the message is deleted, i.e. it is sent out or dropped.
+  inline void AppendBodyBuffer(void *data, size_t size) { body_buffers.push_back({data, size}); }
+
+  inline void SetBodyReleaser(std::function<void()> &&releaser) { body_releaser = std::move(releaser); }
+
+  inline size_t BodySize() const {
+    size_t size = body.size();
+    for (const auto &buffer : body_buffers) {
+      size += buffer.size;
+    }
+    return size;
+  }
+
+  // Copy the external buffers into the `body` string, for the paths which don't support the scatter-gather body.
+  void GatherBody() {
+    if (body_buffers.empty()) {
+      return;
+    }
+    body.reserve(BodySize());
+    for (const auto &buffer : body_buffers) {
+      (void)body.append(static_cast<const char *>(buffer.data), buffer.size);
+    }
+    body_buffers.clear();
+    if (body_releaser) {
+      body_releaser();
+      body_releaser = nullptr;
+    }
+  }
+
   inline void SetFrom(const AID &aFrom) { from = aFrom; }
 
   inline AID &To() { return to; }
@@ -78,6 +121,8 @@ class MessageBase {
   AID to;
   std::string name;
   std::string body;
+  std::vector<BodyBuffer> body_buffers;
+  std::function<void()> body_releaser;
   Type type;
 };
 }  // namespace mindspore
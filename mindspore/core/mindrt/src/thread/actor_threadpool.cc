@@ -21,10 +21,27 @@
 #include "thread/core_affinity.h"
 
 namespace mindspore {
+namespace {
+// the actor worker running on the current thread, nullptr on other threads
+thread_local ActorWorker *current_actor_worker = nullptr;
+}  // namespace
+
 void ActorWorker::CreateThread() { thread_ = std::thread(&ActorWorker::RunWithSpin, this); }
 
+void ActorWorker::Stop() {
+  {
+    std::lock_guard<std::mutex> _l(mutex_);
+    alive_ = false;
+  }
+  cond_var_.notify_one();
+  if (thread_.joinable()) {
+    thread_.join();
+  }
+}
+
 void ActorWorker::RunWithSpin() {
   SetAffinity();
+  current_actor_worker = this;
 #if !defined(__APPLE__) && !defined(SUPPORT_MSVC)
   static std::atomic_int index = {0};
   (void)pthread_setname_np(pthread_self(), ("ActorThread_" + std::to_string(index++)).c_str());
@@ -52,7 +69,7 @@ bool ActorWorker::RunQueueActorTask() {
   if (pool_ == nullptr) {
     return false;
   }
-  auto actor = reinterpret_cast<ActorThreadPool *>(pool_)->PopActorFromQueue();
+  auto actor = NextActor(reinterpret_cast<ActorThreadPool *>(pool_));
   if (actor == nullptr) {
     return false;
   }
@@ -69,6 +86,62 @@ bool ActorWorker::RunQueueActorTask() {
   return ret;
 }
 
+ActorBase *ActorWorker::NextActor(ActorThreadPool *pool) {
+  ActorBase *actor = nullptr;
+  if (++run_count_ % kSharedQueueInterval == 0) {
+    actor = pool->PopActorFromQueue();
+  }
+  if (actor == nullptr) {
+    actor = PopLocalActor();
+  }
+  if (actor == nullptr) {
+    actor = pool->PopActorFromQueue();
+  }
+  if (actor == nullptr && pool->work_stealing()) {
+    actor = pool->StealActor(worker_id_);
+  }
+  return actor;
+}
+
+bool ActorWorker::PushLocalActor(ActorBase *actor) {
+  std::lock_guard<std::mutex> _l(local_mutex_);
+  size_t num = local_actor_num_;
+  if (num == MAX_LOCAL_ACTOR_NR) {
+    return false;
+  }
+  local_actors_[(local_head_ + num) % MAX_LOCAL_ACTOR_NR] = actor;
+  local_actor_num_ = num + 1;
+  return true;
+}
+
+ActorBase *ActorWorker::PopLocalActor() {
+  if (local_actor_num_ == 0) {
+    return nullptr;
+  }
+  std::lock_guard<std::mutex> _l(local_mutex_);
+  size_t num = local_actor_num_;
+  if (num == 0) {
+    return nullptr;
+  }
+  local_actor_num_ = num - 1;
+  return local_actors_[(local_head_ + num - 1) % MAX_LOCAL_ACTOR_NR];
+}
+
+ActorBase *ActorWorker::StealLocalActor() {
+  if (local_actor_num_ == 0) {
+    return nullptr;
+  }
+  std::lock_guard<std::mutex> _l(local_mutex_);
+  size_t num = local_actor_num_;
+  if (num == 0) {
+    return nullptr;
+  }
+  auto actor = local_actors_[local_head_];
+  local_head_ = (local_head_ + 1) % MAX_LOCAL_ACTOR_NR;
+  local_actor_num_ = num - 1;
+  return actor;
+}
+
 bool ActorWorker::ActorActive() {
   if (status_ != kThreadIdle) {
     return false;
@@ -95,6 +168,9 @@ ActorThreadPool::~ActorThreadPool() {
       terminate = actor_queue_.empty();
 #endif
     }
+    for (size_t i = 0; i < stealable_worker_num_; ++i) {
+      terminate = terminate && actor_workers_[i]->local_actor_num() == 0;
+    }
     if (!terminate) {
       for (auto &worker : workers_) {
         worker->Active();
@@ -102,6 +178,12 @@ ActorThreadPool::~ActorThreadPool() {
       std::this_thread::yield();
     }
   } while (!terminate && count++ < kMaxCount);
+  // all the actor threads have to exit before any worker is freed, they may be stealing from each other
+  stealable_worker_num_ = 0;
+  for (auto worker : actor_workers_) {
+    worker->Stop();
+  }
+  actor_workers_.clear();
   for (auto &worker : workers_) {
     delete worker;
     worker = nullptr;
@@ -126,10 +208,39 @@ ActorBase *ActorThreadPool::PopActorFromQueue() {
 #endif
 }
 
+ActorBase *ActorThreadPool::StealActor(size_t worker_id) {
+  size_t num = stealable_worker_num_;
+  for (size_t i = 1; i < num; ++i) {
+    auto actor = actor_workers_[(worker_id + i) % num]->StealLocalActor();
+    if (actor != nullptr) {
+      return actor;
+    }
+  }
+  return nullptr;
+}
+
+void ActorThreadPool::ActiveIdleActorWorker() {
+  size_t num = stealable_worker_num_;
+  for (size_t i = 0; i < num; ++i) {
+    if (actor_workers_[i]->ActorActive()) {
+      break;
+    }
+  }
+}
+
 void ActorThreadPool::PushActorToQueue(ActorBase *actor) {
   if (!actor) {
     return;
   }
+  auto worker = current_actor_worker;
+  if (work_stealing_ && worker != nullptr && worker->pool() == this && worker->PushLocalActor(actor)) {
+    THREAD_DEBUG("actor[%s] enqueue to local queue success", actor->GetAID().Name().c_str());
+    // the current worker runs the actor itself when it is done, others only need waking for the surplus
+    if (worker->local_actor_num() > 1) {
+      ActiveIdleActorWorker();
+    }
+    return;
+  }
   {
 #ifdef USE_HQUEUE
     while (!actor_queue_.Enqueue(actor)) {
@@ -141,12 +252,7 @@ void ActorThreadPool::PushActorToQueue(ActorBase *actor) {
   }
   THREAD_DEBUG("actor[%s] enqueue success", actor->GetAID().Name().c_str());
   // active one idle actor thread if exist
-  for (size_t i = 0; i < actor_thread_num_; ++i) {
-    auto worker = reinterpret_cast<ActorWorker *>(workers_[i]);
-    if (worker->ActorActive()) {
-      break;
-    }
-  }
+  ActiveIdleActorWorker();
 }
 
 int ActorThreadPool::ActorQueueInit() {
@@ -174,9 +280,15 @@ int ActorThreadPool::CreateThreads(size_t actor_thread_num, size_t all_thread_nu
   THREAD_INFO("ThreadInfo, Actor: [%zu], All: [%zu], CoreNum: [%zu]", actor_thread_num, all_thread_num, core_num);
   actor_thread_num_ = actor_thread_num < core_num ? actor_thread_num : core_num;
   core_num -= actor_thread_num_;
+  // the workers start stealing as soon as they are created, so the vector must never reallocate
+  actor_workers_.reserve(actor_thread_num_);
   if (ThreadPool::CreateThreads<ActorWorker>(actor_thread_num_, core_list) != THREAD_OK) {
     return THREAD_ERROR;
   }
+  for (size_t i = 0; i < workers_.size() && i < actor_thread_num_; ++i) {
+    actor_workers_.push_back(static_cast<ActorWorker *>(workers_[i]));
+  }
+  stealable_worker_num_ = actor_workers_.size();
 
   size_t kernel_thread_num =
     (all_thread_num - actor_thread_num_) < core_num ? (all_thread_num - actor_thread_num_) : core_num;
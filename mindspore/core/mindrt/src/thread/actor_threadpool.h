@@ -31,17 +31,37 @@
 #endif
 namespace mindspore {
 constexpr size_t MAX_READY_ACTOR_NR = 8192;
+constexpr size_t MAX_LOCAL_ACTOR_NR = 256;
+// a worker looks at the shared queue first once every this many actors, so that it is not starved by local actors
+constexpr size_t kSharedQueueInterval = 61;
 class ActorThreadPool;
 class ActorWorker : public Worker {
  public:
   explicit ActorWorker(ThreadPool *pool, size_t index) : Worker(pool, index) {}
   void CreateThread() override;
   bool ActorActive();
+  // stop the thread and wait until it exits, the worker can no longer be stolen from afterwards
+  void Stop();
   ~ActorWorker() override{};
 
+  // The actors made ready while this worker runs an actor are kept in a local queue. The worker itself takes the
+  // latest one, so a consumer runs right after its producer on the same core, while idle workers steal the oldest.
+  bool PushLocalActor(ActorBase *actor);
+  ActorBase *PopLocalActor();
+  ActorBase *StealLocalActor();
+  size_t local_actor_num() const { return local_actor_num_; }
+  const ThreadPool *pool() const { return pool_; }
+
  private:
   void RunWithSpin();
   bool RunQueueActorTask();
+  ActorBase *NextActor(ActorThreadPool *pool);
+
+  std::mutex local_mutex_;
+  ActorBase *local_actors_[MAX_LOCAL_ACTOR_NR]{nullptr};
+  size_t local_head_{0};
+  std::atomic_size_t local_actor_num_{0};
+  size_t run_count_{0};
 };
 
 class ActorThreadPool : public ThreadPool {
@@ -61,9 +81,17 @@ class ActorThreadPool : public ThreadPool {
   virtual int ActorQueueInit();
   virtual void PushActorToQueue(ActorBase *actor);
   virtual ActorBase *PopActorFromQueue();
+  // take an actor from the local queue of another actor worker, starting with the one after worker_id
+  ActorBase *StealActor(size_t worker_id);
+
+  // An actor made ready by an actor worker runs on that worker unless another one steals it, which is the default.
+  // When disabled, every ready actor goes through the shared queue.
+  void SetWorkStealing(bool enable) { work_stealing_ = enable; }
+  bool work_stealing() const { return work_stealing_; }
 
  protected:
   ActorThreadPool() = default;
+  void ActiveIdleActorWorker();
 
   std::mutex actor_mutex_;
   std::condition_variable actor_cond_;
@@ -72,6 +100,10 @@ class ActorThreadPool : public ThreadPool {
 #else
   std::queue<ActorBase *> actor_queue_;
 #endif
+  std::vector<ActorWorker *> actor_workers_;
+  // number of entries of actor_workers_ that are ready to be stolen from
+  std::atomic_size_t stealable_worker_num_{0};
+  std::atomic_bool work_stealing_{true};
 
  private:
   int CreateThreads(size_t actor_thread_num, size_t all_thread_num, const std::vector<int> &core_list);
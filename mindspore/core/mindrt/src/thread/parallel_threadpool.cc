@@ -21,8 +21,6 @@
 #include "thread/core_affinity.h"
 
 namespace mindspore {
-constexpr int kActorParallelThreshold = 5;
-
 void ParallelWorker::CreateThread() { thread_ = std::thread(&ParallelWorker::Run, this); }
 
 void ParallelWorker::Run() {
@@ -71,80 +69,38 @@ bool ParallelWorker::RunQueueActorTask() {
   return false;
 }
 
-inline bool ParallelThreadPool::RunTaskOnce(int start, int end) {
-  bool find = false;
-  ParallelTask *p_task;
-  for (int i = start; i < end; i++) {
-    if (tasks_[i].valid) {
-      if (i != start) {
-        tasks_start_ = i;
-      }
-      int finish = 0;
-      p_task = &tasks_[i];
-      int expected_index = p_task->started;
-      while (expected_index < p_task->task_num) {
-        if (p_task->started.compare_exchange_strong(expected_index, expected_index + 1)) {
-          p_task->status |= p_task->func(p_task->content, expected_index, 0, 0);
-          find = true;
-          expected_index = p_task->started;
-          finish++;
-        }
-      }
-      if (find) {
-        p_task->valid = false;
-        p_task->finished += finish;
-        break;
-      }
+ParallelTask *ParallelThreadPool::PickTask() {
+  // Lend the thread to the task with the most subtasks left, which is usually the kernel of the heaviest branch, so
+  // the threads freed by the finished branches speed up the still-running ones.
+  ParallelTask *picked = nullptr;
+  int max_left = 0;
+  for (size_t i = 0; i < tasks_size_; i++) {
+    ParallelTask *p_task = &tasks_[i];
+    if (!p_task->valid) {
+      continue;
+    }
+    int left = p_task->task_num - p_task->started;
+    if (left > max_left) {
+      max_left = left;
+      picked = p_task;
     }
   }
-  return find;
+  return picked;
 }
 
 bool ParallelThreadPool::RunParallel() {
   bool ret = false;
-  bool find;
-  int max_num = tasks_size_;
-  if (max_num < kActorParallelThreshold) {
-    ParallelTask *p_task;
-    do {
-      find = false;
-      for (int i = 0; i < max_num; i++) {
-        if (tasks_[i].valid) {
-          int finish = 0;
-          p_task = &tasks_[i];
-          int expected_index = p_task->started;
-          while (expected_index < p_task->task_num) {
-            if (p_task->started.compare_exchange_strong(expected_index, expected_index + 1)) {
-              p_task->status |= p_task->func(p_task->content, expected_index, 0, 0);
-              find = true;
-              expected_index = p_task->started;
-              finish++;
-            }
-          }
-          if (find) {
-            p_task->valid = false;
-            p_task->finished += finish;
-            break;
-          }
-        }
-      }
-      ret = ret || find;
-    } while (find);
-  } else {
-    do {
-      int start = tasks_start_;
-      int end = tasks_end_;
-      find = false;
-      if (start < end) {
-        find = RunTaskOnce(start, end);
-      } else if (start != end) {
-        find = RunTaskOnce(start, max_num);
-        if (find == false) {
-          find = RunTaskOnce(0, end);
-        }
-      }
-      ret = ret || find;
-    } while (find);
+  ParallelTask *p_task = PickTask();
+  while (p_task != nullptr) {
+    int expected_index = p_task->started;
+    if (expected_index < p_task->task_num &&
+        p_task->started.compare_exchange_strong(expected_index, expected_index + 1)) {
+      p_task->status |= p_task->func(p_task->content, expected_index, 0, 0);
+      (void)++p_task->finished;
+      ret = true;
+    }
+    // pick again after every subtask, the other tasks may have more subtasks left now
+    p_task = PickTask();
   }
   return ret;
 }
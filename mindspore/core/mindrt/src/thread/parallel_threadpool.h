@@ -113,8 +113,6 @@ class ParallelThreadPool : public ActorThreadPool {
     }
   }
 
-  inline bool RunTaskOnce(int start, int end);
-
   bool RunParallel();
 
   size_t tasks_size() { return tasks_size_; }
@@ -122,8 +120,8 @@ class ParallelThreadPool : public ActorThreadPool {
  private:
   ParallelThreadPool() {}
   int CreateParallelThreads(size_t actor_thread_num, size_t all_thread_num, const std::vector<int> &core_list);
+  ParallelTask *PickTask();
 
-  std::atomic_int tasks_start_ = 0;
   std::atomic_int tasks_end_ = 0;
   ParallelTask *tasks_;
   size_t tasks_size_ = 0;
@@ -65,6 +65,16 @@ static const char *const kMSCacheModelPath = "cache_model_path";
 static const char *const kMSCacheVocabSize = "vocab_size";
 static const char *const kMSCacheDeviceSize = "device_cache_size";
 static const char *const kMSCacheSerializePath = "serialize_path";
+// model load
+static const char *const kModelLoadSection = "model_load";
+static const char *const kEnableMmapKey = "enable_mmap";
+// thread cost model
+static const char *const kThreadCostModelSection = "thread_cost_model";
+static const char *const kCalibrateKey = "calibrate";
+static const char *const kProfilePathKey = "profile_path";
+// shared packed weight
+static const char *const kSharedWeightSection = "shared_weight";
+static const char *const kSharedWeightPathKey = "path";
 }  // namespace lite
 }  // namespace mindspore
 
@@ -0,0 +1,86 @@
+/**
+ * Copyright 2022 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "src/common/mmap_utils.h"
+#if !defined(_WIN32) && !defined(_WIN64)
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+#include "src/common/file_utils.h"
+#include "src/common/log_adapter.h"
+
+namespace mindspore {
+namespace lite {
+bool IsMmapSupported() {
+#if !defined(_WIN32) && !defined(_WIN64)
+  return true;
+#else
+  return false;
+#endif
+}
+
+void *ReadFileByMmap(const std::string &file, size_t *size) {
+#if !defined(_WIN32) && !defined(_WIN64)
+  if (size == nullptr) {
+    MS_LOG(ERROR) << "input size is nullptr.";
+    return nullptr;
+  }
+  auto real_path = RealPath(file.c_str());
+  if (real_path.empty()) {
+    MS_LOG(ERROR) << "file path is invalid: " << file;
+    return nullptr;
+  }
+  auto fd = open(real_path.c_str(), O_RDONLY);
+  if (fd < 0) {
+    MS_LOG(ERROR) << "open file failed: " << real_path;
+    return nullptr;
+  }
+  struct stat fd_stat;
+  if (fstat(fd, &fd_stat) != 0 || fd_stat.st_size <= 0) {
+    MS_LOG(ERROR) << "get the size of file failed: " << real_path;
+    (void)close(fd);
+    return nullptr;
+  }
+  auto file_size = static_cast<size_t>(fd_stat.st_size);
+  // the mapping holds a reference of the file, so the fd can be closed once mapped.
+  auto mmap_buffer = mmap(nullptr, file_size, PROT_READ | PROT_WRITE, MAP_PRIVATE, fd, 0);
+  (void)close(fd);
+  if (mmap_buffer == MAP_FAILED) {
+    MS_LOG(ERROR) << "mmap file failed: " << real_path;
+    return nullptr;
+  }
+  *size = file_size;
+  return mmap_buffer;
+#else
+  MS_LOG(ERROR) << "mmap is unsupported on windows.";
+  return nullptr;
+#endif
+}
+
+void UnmapMmapBuffer(void *buffer, size_t size) {
+#if !defined(_WIN32) && !defined(_WIN64)
+  if (buffer == nullptr) {
+    return;
+  }
+  if (munmap(buffer, size) != 0) {
+    MS_LOG(ERROR) << "munmap failed.";
+  }
+#endif
+}
+}  // namespace lite
+}  // namespace mindspore
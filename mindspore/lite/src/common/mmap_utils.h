@@ -0,0 +1,34 @@
+/**
+ * Copyright 2022 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef MINDSPORE_LITE_SRC_COMMON_MMAP_UTILS_H_
+#define MINDSPORE_LITE_SRC_COMMON_MMAP_UTILS_H_
+
+#include <string>
+
+namespace mindspore {
+namespace lite {
+bool IsMmapSupported();
+
+// Map the file into memory privately, the pages are read from the file on the first access and the writes to the
+// buffer are not written back to the file. Return nullptr if failed.
+void *ReadFileByMmap(const std::string &file, size_t *size);
+
+void UnmapMmapBuffer(void *buffer, size_t size);
+}  // namespace lite
+}  // namespace mindspore
+
+#endif  // MINDSPORE_LITE_SRC_COMMON_MMAP_UTILS_H_
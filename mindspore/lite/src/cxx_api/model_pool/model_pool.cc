@@ -16,6 +16,7 @@
 #include "src/cxx_api/model_pool/model_pool.h"
 #include <unistd.h>
 #include <future>
+#include <chrono>
 #include "src/common/log_adapter.h"
 #include "include/lite_types.h"
 #include "src/common/config_file.h"
@@ -24,6 +25,8 @@
 #include "src/pack_weight_manager.h"
 #include "src/runtime/numa_adapter.h"
 #include "src/common/common.h"
+#include "src/thread_cost_model.h"
+#include "thread/threadpool.h"
 
 namespace mindspore {
 namespace {
@@ -354,6 +357,23 @@ Status ModelPool::Init(const std::string &model_path, const std::shared_ptr<Runn
   } else {
     predict_task_queue_->SetTaskQueueNum(1);
   }
+  if (runner_config != nullptr && runner_config->max_batch_size > 1) {
+    if (runner_config->max_batch_delay_us < 0) {
+      MS_LOG(ERROR) << "max batch delay " << runner_config->max_batch_delay_us << "us is invalid.";
+      return kLiteParamInvalid;
+    }
+    predict_task_queue_->SetDynamicBatch(runner_config->max_batch_size, runner_config->max_batch_delay_us);
+    MS_LOG(INFO) << "enable dynamic batch, max batch size: " << runner_config->max_batch_size
+                 << ", max batch delay: " << runner_config->max_batch_delay_us << "us";
+  }
+  // the thread cost model is shared by all the workers, so it is calibrated before they start running.
+  if (runner_config != nullptr && !runner_config->config_info.empty()) {
+    auto thread_num = model_pool_context.front()->context->GetThreadNum();
+    std::unique_ptr<ThreadPool> pool(ThreadPool::CreateThreadPool(static_cast<size_t>(thread_num)));
+    if (pool != nullptr) {
+      lite::InitThreadCostModel(&runner_config->config_info, pool.get());
+    }
+  }
   // read model by path and init packed weight by buffer
   size_t size = 0;
   auto graph_buf = lite::ReadFile(model_path.c_str(), &size);
@@ -634,8 +654,36 @@ Status ModelPool::PredictBySplitBatch(const std::vector<MSTensor> &inputs, std::
   return kSuccess;
 }
 
+bool ModelPool::IsBatchableTask(const std::vector<MSTensor> &inputs, const std::vector<MSTensor> &outputs,
+                                const MSKernelCallBack &before, const MSKernelCallBack &after) const {
+  // the callbacks and the outputs set by user are bound to one request, which can't be shared by the batch.
+  if (!predict_task_queue_->IsDynamicBatchEnable() || before != nullptr || after != nullptr || !outputs.empty() ||
+      inputs.empty()) {
+    return false;
+  }
+  for (auto &input : inputs) {
+    if (input.Shape().empty() || input.Shape().front() != inputs.front().Shape().front()) {
+      return false;
+    }
+  }
+  return true;
+}
+
 Status ModelPool::Predict(const std::vector<MSTensor> &inputs, std::vector<MSTensor> *outputs,
                           const MSKernelCallBack &before, const MSKernelCallBack &after) {
+  if (predict_task_queue_->IsDynamicBatchEnable()) {
+    auto start = std::chrono::steady_clock::now();
+    auto status = PredictInner(inputs, outputs, before, after);
+    auto latency =
+      std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - start).count();
+    latency_statistics_.Record(latency);
+    return status;
+  }
+  return PredictInner(inputs, outputs, before, after);
+}
+
+Status ModelPool::PredictInner(const std::vector<MSTensor> &inputs, std::vector<MSTensor> *outputs,
+                               const MSKernelCallBack &before, const MSKernelCallBack &after) {
   predict_task_mutex_.lock();
   int max_wait_worker_node_id = 0;
   int max_wait_worker_num = 0;
@@ -674,6 +722,7 @@ Status ModelPool::Predict(const std::vector<MSTensor> &inputs, std::vector<MSTen
       predict_task_mutex_.unlock();
       return kLiteNullptr;
     }
+    predict_task->batchable = IsBatchableTask(inputs, *outputs, before, after);
     predict_task_queue_->PushPredictTask(predict_task, max_wait_worker_node_id);
     predict_task_mutex_.unlock();
     predict_task_queue_->WaitUntilPredictActive(predict_task);
@@ -684,6 +733,9 @@ Status ModelPool::Predict(const std::vector<MSTensor> &inputs, std::vector<MSTen
 
 ModelPool::~ModelPool() {
   if (predict_task_queue_ != nullptr) {
+    if (predict_task_queue_->IsDynamicBatchEnable()) {
+      latency_statistics_.Report();
+    }
     predict_task_queue_->SetPredictTaskDone();
   }
   for (auto &th : model_worker_vec_) {
@@ -75,6 +75,12 @@ class ModelPool {
                          std::vector<std::vector<MSTensor>> *new_outputs);
   std::shared_ptr<ModelWorker> GetMaxWaitWorkerNum(int *max_wait_worker_node_id, int *max_wait_worker_num);
 
+  bool IsBatchableTask(const std::vector<MSTensor> &inputs, const std::vector<MSTensor> &outputs,
+                       const MSKernelCallBack &before, const MSKernelCallBack &after) const;
+
+  Status PredictInner(const std::vector<MSTensor> &inputs, std::vector<MSTensor> *outputs,
+                      const MSKernelCallBack &before, const MSKernelCallBack &after);
+
   Status PredictBySplitBatch(const std::vector<MSTensor> &inputs, std::vector<MSTensor> *outputs,
                              const MSKernelCallBack &before, const MSKernelCallBack &after,
                              int max_wait_worker_node_id);
@@ -93,6 +99,7 @@ class ModelPool {
   bool use_split_batch_ = false;
   std::vector<std::shared_ptr<ModelWorker>> all_model_worker_;
   bool create_worker_success_ = true;
+  PredictLatencyStatistics latency_statistics_;
 };
 }  // namespace mindspore
 #endif  // MINDSPORE_LITE_SRC_CXX_API_MODEL_POOL_MODEL_POOL_H_
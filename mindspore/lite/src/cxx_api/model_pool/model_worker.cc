@@ -14,6 +14,7 @@
  * limitations under the License.
  */
 #include "src/cxx_api/model_pool/model_worker.h"
+#include <cstring>
 #include "src/common/log_adapter.h"
 #include "src/runtime/numa_adapter.h"
 #include "src/common/common.h"
@@ -54,11 +55,23 @@ void ModelWorker::Run(int node_id, const std::shared_ptr<PredictTaskQueue> &pred
   create_work_done_ = true;
   create_work_done_condition_.notify_one();
   while (!predict_task_queue->IsPredictTaskDone()) {
-    auto task = predict_task_queue->GetPredictTask(node_id, this);
-    if (task == nullptr) {
+    auto tasks = predict_task_queue->GetPredictTasks(node_id, this);
+    if (tasks.empty()) {
       break;
     }
     available_ = false;
+    if (tasks.size() > 1) {
+      auto status = PredictBatch(tasks);
+      if (status != kSuccess) {
+        MS_LOG(ERROR) << "model predict batch of " << tasks.size() << " tasks failed.";
+      }
+      for (auto &batch_task : tasks) {
+        batch_task->ready = true;
+        predict_task_queue->ActiveTask(batch_task);
+      }
+      continue;
+    }
+    auto task = tasks.front();
     auto inputs = task->inputs;
     auto *outputs = task->outputs;
     auto before = task->before;
@@ -75,6 +88,102 @@ void ModelWorker::Run(int node_id, const std::shared_ptr<PredictTaskQueue> &pred
   }
 }
 
+Status ModelWorker::ConcatBatchInputs(const std::vector<std::shared_ptr<PredictTask>> &tasks,
+                                      std::vector<MSTensor> *inputs) {
+  auto &first_inputs = *(tasks.front()->inputs);
+  for (size_t i = 0; i < first_inputs.size(); i++) {
+    auto shape = first_inputs[i].Shape();
+    shape[0] = 0;
+    for (auto &task : tasks) {
+      shape[0] += task->inputs->at(i).Shape().front();
+    }
+    auto batch_tensor = MSTensor::CreateTensor(first_inputs[i].Name(), first_inputs[i].DataType(), shape, nullptr, 0);
+    if (batch_tensor == nullptr) {
+      MS_LOG(ERROR) << "create batch input tensor failed.";
+      return kLiteError;
+    }
+    inputs->push_back(*batch_tensor);
+    delete batch_tensor;
+    auto batch_data = static_cast<uint8_t *>(inputs->back().MutableData());
+    MS_CHECK_TRUE_MSG(batch_data != nullptr, kLiteError, "malloc batch input data failed.");
+    size_t offset = 0;
+    for (auto &task : tasks) {
+      auto &input = const_cast<MSTensor &>(task->inputs->at(i));
+      auto data = input.MutableData();
+      MS_CHECK_TRUE_MSG(data != nullptr, kLiteError, "input data is nullptr.");
+      MS_CHECK_TRUE_MSG(offset + input.DataSize() <= inputs->back().DataSize(), kLiteError,
+                        "input data size is wrong.");
+      (void)memcpy(batch_data + offset, data, input.DataSize());
+      offset += input.DataSize();
+    }
+  }
+  return kSuccess;
+}
+
+Status ModelWorker::ScatterBatchOutputs(const std::vector<MSTensor> &outputs,
+                                        const std::vector<std::shared_ptr<PredictTask>> &tasks) {
+  int64_t batch_size = 0;
+  for (auto &task : tasks) {
+    batch_size += task->inputs->front().Shape().front();
+  }
+  for (auto &task : tasks) {
+    task->outputs->clear();
+  }
+  for (auto &output : outputs) {
+    auto shape = output.Shape();
+    // the outputs without the batch dim can't be split to the tasks.
+    if (shape.empty() || shape.front() != batch_size) {
+      MS_LOG(ERROR) << "the batch dim of output " << output.Name() << " is not " << batch_size;
+      return kLiteError;
+    }
+    auto row_size = output.DataSize() / static_cast<size_t>(batch_size);
+    auto output_data = static_cast<const uint8_t *>(const_cast<MSTensor &>(output).MutableData());
+    MS_CHECK_TRUE_MSG(output_data != nullptr, kLiteError, "output data is nullptr.");
+    size_t offset = 0;
+    for (auto &task : tasks) {
+      shape[0] = task->inputs->front().Shape().front();
+      auto data_size = row_size * static_cast<size_t>(shape[0]);
+      auto task_output =
+        MSTensor::CreateTensor(output.Name(), output.DataType(), shape, output_data + offset, data_size);
+      if (task_output == nullptr) {
+        MS_LOG(ERROR) << "create output tensor of task failed.";
+        return kLiteError;
+      }
+      task->outputs->push_back(*task_output);
+      delete task_output;
+      offset += data_size;
+    }
+  }
+  return kSuccess;
+}
+
+Status ModelWorker::PredictBatch(const std::vector<std::shared_ptr<PredictTask>> &tasks) {
+  std::vector<MSTensor> batch_inputs;
+  auto status = ConcatBatchInputs(tasks, &batch_inputs);
+  std::vector<MSTensor> batch_outputs;
+  if (status == kSuccess) {
+    status = Predict(batch_inputs, &batch_outputs);
+  }
+  if (status == kSuccess && !batch_outputs.empty()) {
+    status = ScatterBatchOutputs(batch_outputs, tasks);
+    if (status == kSuccess) {
+      return kSuccess;
+    }
+  }
+  // the model may not support the batch, fall back to running the tasks one by one.
+  MS_LOG(WARNING) << "predict " << tasks.size() << " tasks in one batch failed, predict them one by one.";
+  status = kSuccess;
+  for (auto &task : tasks) {
+    task->outputs->clear();
+    auto ret = Predict(*(task->inputs), task->outputs);
+    if (ret != kSuccess) {
+      MS_LOG(ERROR) << "model predict failed.";
+      status = ret;
+    }
+  }
+  return status;
+}
+
 Status ModelWorker::ResizeInit() {
   auto inputs = model_->GetInputs();
   std::vector<std::vector<int64_t>> new_input_shape;
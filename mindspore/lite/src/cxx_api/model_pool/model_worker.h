@@ -27,6 +27,7 @@
 #include "src/cxx_api/model_pool/predict_task_queue.h"
 namespace mindspore {
 class PredictTaskQueue;
+struct PredictTask;
 class ModelWorker {
  public:
   ModelWorker() = default;
@@ -53,6 +54,12 @@ class ModelWorker {
  private:
   void Run(int node_id, const std::shared_ptr<PredictTaskQueue> &predict_task_queue);
 
+  // Run the tasks coalesced by the dynamic batching in one inference.
+  Status PredictBatch(const std::vector<std::shared_ptr<PredictTask>> &tasks);
+  Status ConcatBatchInputs(const std::vector<std::shared_ptr<PredictTask>> &tasks, std::vector<MSTensor> *inputs);
+  Status ScatterBatchOutputs(const std::vector<MSTensor> &outputs,
+                             const std::vector<std::shared_ptr<PredictTask>> &tasks);
+
   std::pair<std::vector<std::vector<int64_t>>, bool> GetModelResize(const std::vector<MSTensor> &model_inputs,
                                                                     const std::vector<MSTensor> &inputs);
   Status ResizeInit();
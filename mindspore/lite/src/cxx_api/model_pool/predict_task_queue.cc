@@ -15,7 +15,103 @@
  */
 
 #include "src/cxx_api/model_pool/predict_task_queue.h"
+#include <algorithm>
+#include "src/common/log_adapter.h"
 namespace mindspore {
+namespace {
+constexpr size_t kMaxLatencySampleNum = 10000;
+constexpr size_t kLatencyReportInterval = 10000;
+constexpr float kLatencyPercentiles[] = {50.0f, 90.0f, 99.0f};
+constexpr float kMaxPercentile = 100.0f;
+}  // namespace
+
+void PredictLatencyStatistics::Record(int64_t latency_us) {
+  bool need_report = false;
+  {
+    std::unique_lock<std::mutex> latency_lock(mtx_latency_);
+    if (latencies_.size() < kMaxLatencySampleNum) {
+      latencies_.push_back(latency_us);
+    } else {
+      latencies_[next_index_] = latency_us;
+      next_index_ = (next_index_ + 1) % kMaxLatencySampleNum;
+    }
+    request_num_++;
+    need_report = request_num_ % kLatencyReportInterval == 0;
+  }
+  if (need_report) {
+    Report();
+  }
+}
+
+int64_t PredictLatencyStatistics::GetPercentile(float percentile) {
+  std::vector<int64_t> latencies;
+  {
+    std::unique_lock<std::mutex> latency_lock(mtx_latency_);
+    latencies = latencies_;
+  }
+  if (latencies.empty()) {
+    return 0;
+  }
+  percentile = std::min(std::max(percentile, 0.0f), kMaxPercentile);
+  auto index = static_cast<size_t>(percentile / kMaxPercentile * (latencies.size() - 1));
+  std::nth_element(latencies.begin(), latencies.begin() + index, latencies.end());
+  return latencies[index];
+}
+
+void PredictLatencyStatistics::Report() {
+  size_t request_num;
+  {
+    std::unique_lock<std::mutex> latency_lock(mtx_latency_);
+    request_num = request_num_;
+  }
+  if (request_num == 0) {
+    return;
+  }
+  std::string report = "model pool predict " + std::to_string(request_num) + " requests, latency of recent requests:";
+  for (auto percentile : kLatencyPercentiles) {
+    report += " p" + std::to_string(static_cast<int>(percentile)) + " " + std::to_string(GetPercentile(percentile)) +
+              " us";
+  }
+  MS_LOG(INFO) << report;
+}
+
+void PredictTaskQueue::SetDynamicBatch(int max_batch_size, int max_batch_delay_us) {
+  max_batch_size_ = max_batch_size;
+  max_batch_delay_ = std::chrono::microseconds(max_batch_delay_us);
+}
+
+bool PredictTaskQueue::CanBatch(const PredictTask &first, const PredictTask &other) {
+  if (!first.batchable || !other.batchable || first.inputs->size() != other.inputs->size()) {
+    return false;
+  }
+  for (size_t i = 0; i < first.inputs->size(); i++) {
+    const auto &first_input = first.inputs->at(i);
+    const auto &other_input = other.inputs->at(i);
+    if (first_input.DataType() != other_input.DataType()) {
+      return false;
+    }
+    const auto &first_shape = first_input.Shape();
+    const auto &other_shape = other_input.Shape();
+    // only the batch dim, which is the first dim, can differ.
+    if (first_shape.size() != other_shape.size() || !std::equal(first_shape.begin() + 1, first_shape.end(),
+                                                                other_shape.begin() + 1)) {
+      return false;
+    }
+  }
+  return true;
+}
+
+int64_t PredictTaskQueue::GetBatchableSize(int node_id) {
+  auto &task_queue = predict_task_.at(node_id);
+  int64_t batch_size = 0;
+  for (auto &task : task_queue) {
+    if (!CanBatch(*task_queue.front(), *task)) {
+      break;
+    }
+    batch_size += task->inputs->front().Shape().front();
+  }
+  return batch_size;
+}
 void PredictTaskQueue::SetPredictTaskDone() {
   predict_task_done_ = true;
   task_push_cond_.notify_all();
@@ -38,7 +134,8 @@ void PredictTaskQueue::ActiveTask(const std::shared_ptr<PredictTask> &task) { ta
 
 void PredictTaskQueue::PushPredictTask(std::shared_ptr<PredictTask> task, int node_id) {
   std::unique_lock<std::mutex> task_lock(mtx_predict_task_);
-  predict_task_.at(node_id).push(task);
+  task->push_time = std::chrono::steady_clock::now();
+  predict_task_.at(node_id).push_back(task);
   task_push_cond_.notify_all();
 }
 
@@ -51,10 +148,57 @@ std::shared_ptr<PredictTask> PredictTaskQueue::GetPredictTask(int node_id, Model
     return nullptr;
   }
   auto predict_task = predict_task_.at(node_id).front();
-  predict_task_.at(node_id).pop();
+  predict_task_.at(node_id).pop_front();
   return predict_task;
 }
 
+std::vector<std::shared_ptr<PredictTask>> PredictTaskQueue::GetPredictTasks(int node_id, ModelWorker *worker) {
+  if (!IsDynamicBatchEnable()) {
+    auto predict_task = GetPredictTask(node_id, worker);
+    if (predict_task == nullptr) {
+      return {};
+    }
+    return {predict_task};
+  }
+  std::unique_lock<std::mutex> task_lock(mtx_predict_task_);
+  auto &task_queue = predict_task_.at(node_id);
+  while ((task_queue.empty() && !predict_task_done_) || (!worker->IsAvailable())) {
+    task_push_cond_.wait(task_lock);
+  }
+  // the worker is taken, wait for more tasks to batch. The tasks may be taken by the other workers meanwhile.
+  while (!predict_task_done_) {
+    if (task_queue.empty()) {
+      task_push_cond_.wait(task_lock);
+      continue;
+    }
+    if (!task_queue.front()->batchable || GetBatchableSize(node_id) >= max_batch_size_) {
+      break;
+    }
+    auto deadline = task_queue.front()->push_time + max_batch_delay_;
+    if (std::chrono::steady_clock::now() >= deadline) {
+      break;
+    }
+    (void)task_push_cond_.wait_until(task_lock, deadline);
+  }
+  if (predict_task_done_) {
+    return {};
+  }
+  auto first_task = task_queue.front();
+  task_queue.pop_front();
+  std::vector<std::shared_ptr<PredictTask>> predict_tasks = {first_task};
+  int64_t batch_size = first_task->batchable ? first_task->inputs->front().Shape().front() : max_batch_size_;
+  while (!task_queue.empty() && CanBatch(*first_task, *task_queue.front())) {
+    auto task_batch_size = task_queue.front()->inputs->front().Shape().front();
+    if (batch_size + task_batch_size > max_batch_size_) {
+      break;
+    }
+    batch_size += task_batch_size;
+    predict_tasks.push_back(task_queue.front());
+    task_queue.pop_front();
+  }
+  return predict_tasks;
+}
+
 int PredictTaskQueue::GetTaskNum(int node_id) {
   std::unique_lock<std::mutex> task_lock(mtx_predict_task_);
   return predict_task_.at(node_id).size();
@@ -16,10 +16,11 @@
 #ifndef MINDSPORE_LITE_SRC_CXX_API_MODEL_POOL_PREDICT_TASK_QUEUE_H_
 #define MINDSPORE_LITE_SRC_CXX_API_MODEL_POOL_PREDICT_TASK_QUEUE_H_
 
-#include <queue>
+#include <deque>
 #include <mutex>
 #include <memory>
 #include <vector>
+#include <chrono>
 #include <condition_variable>
 #include "include/api/types.h"
 #include "include/api/status.h"
@@ -37,6 +38,27 @@ struct PredictTask {
   bool ready;
   std::condition_variable task_done_condition;
   std::mutex task_done_mutex;
+  // whether the task can be coalesced with the other tasks into one inference by the dynamic batching.
+  bool batchable = false;
+  std::chrono::steady_clock::time_point push_time;
+};
+
+// Keeps the latencies of the recent requests to report the percentiles.
+class PredictLatencyStatistics {
+ public:
+  PredictLatencyStatistics() = default;
+  ~PredictLatencyStatistics() = default;
+
+  void Record(int64_t latency_us);
+  // percentile in [0, 100], return 0 if there is no request recorded.
+  int64_t GetPercentile(float percentile);
+  void Report();
+
+ private:
+  std::mutex mtx_latency_;
+  std::vector<int64_t> latencies_;
+  size_t next_index_ = 0;
+  size_t request_num_ = 0;
 };
 
 class PredictTaskQueue {
@@ -47,6 +69,11 @@ class PredictTaskQueue {
   void PushPredictTask(std::shared_ptr<PredictTask> task, int node_id);
   void WaitUntilPredictActive(const std::shared_ptr<PredictTask> &task);
   std::shared_ptr<PredictTask> GetPredictTask(int node_id, ModelWorker *worker);
+  // Get the tasks to run in one inference. With the dynamic batching, the batchable tasks at the front of queue are
+  // coalesced until the batch reaches max_batch_size or the oldest task has waited for max_batch_delay_us.
+  std::vector<std::shared_ptr<PredictTask>> GetPredictTasks(int node_id, ModelWorker *worker);
+  void SetDynamicBatch(int max_batch_size, int max_batch_delay_us);
+  bool IsDynamicBatchEnable() const { return max_batch_size_ > 1; }
   void ActiveTask(const std::shared_ptr<PredictTask> &task);
   void ActiveTaskQueue() { task_push_cond_.notify_all(); }
   int GetTaskNum(int node_id);
@@ -59,12 +86,17 @@ class PredictTaskQueue {
   void IncreaseWaitModelNum(int num, int node_id) { waite_worker_num_.at(node_id) += num; }
 
  private:
-  std::vector<std::queue<std::shared_ptr<PredictTask>>> predict_task_;
+  static bool CanBatch(const PredictTask &first, const PredictTask &other);
+  int64_t GetBatchableSize(int node_id);
+
+  std::vector<std::deque<std::shared_ptr<PredictTask>>> predict_task_;
   std::vector<int> waite_worker_num_;
   std::mutex mtx_predict_task_;
   std::condition_variable task_pop_cond_;
   std::condition_variable task_push_cond_;
   bool predict_task_done_ = false;
+  int64_t max_batch_size_ = 0;
+  std::chrono::microseconds max_batch_delay_{0};
 };
 }  // namespace mindspore
 #endif  // MINDSPORE_LITE_SRC_CXX_API_MODEL_POOL_PREDICT_TASK_QUEUE_H_
@@ -27,6 +27,7 @@
 #include "src/common/prim_util.h"
 #include "src/common/graph_util.h"
 #include "src/common/file_utils.h"
+#include "src/common/mmap_utils.h"
 #include "src/tensor.h"
 #include "model_loader/model_loader.h"
 
@@ -37,7 +38,11 @@ constexpr size_t kMaxModelBufferSize = static_cast<size_t>(1024) * 1024 * 1024 *
 
 void LiteModel::Free() {
   if (this->buf != nullptr) {
-    delete[](this->buf);
+    if (this->model_buf_by_mmap_) {
+      UnmapMmapBuffer(static_cast<void *>(this->buf), this->buf_size_);
+    } else {
+      delete[](this->buf);
+    }
     this->buf = nullptr;
   }
   auto nodes_size = this->all_nodes_.size();
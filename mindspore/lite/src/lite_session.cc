@@ -33,6 +33,8 @@
 #include "src/common/graph_util.h"
 #include "src/common/tensor_util.h"
 #include "src/common/file_utils.h"
+#include "src/common/mmap_utils.h"
+#include "src/thread_cost_model.h"
 #include "src/lite_model.h"
 #include "src/weight_decoder.h"
 #include "src/runtime/runtime_allocator.h"
@@ -532,6 +534,7 @@ int LiteSession::CompileGraph(Model *model) {
     MS_LOG(ERROR) << "StoreOriginTensorData failed.";
     return RET_ERROR;
   }
+  InitSharedWeight(model);
   InitGraphInputTensors(model);
   InitGraphOutputTensors(model);
 
@@ -543,6 +546,7 @@ int LiteSession::CompileGraph(Model *model) {
   ret = scheduler.Schedule(&kernels_);
   if (ret != RET_OK) {
     MS_LOG(ERROR) << "Schedule kernels failed: " << ret;
+    (void)lite::PackWeightManager::GetInstance()->FinishSharedWeight(model, false);
     is_running_.store(false);
     return ret;
   }
@@ -551,6 +555,9 @@ int LiteSession::CompileGraph(Model *model) {
   non_tail_call_kernels_ = scheduler.NonTailCallNodes();
 
   ret = PrepareKernels(model);
+  if (lite::PackWeightManager::GetInstance()->FinishSharedWeight(model, ret == RET_OK) != RET_OK) {
+    MS_LOG(WARNING) << "Write the shared packed weight failed.";
+  }
   if (ret != RET_OK) {
     MS_LOG(ERROR) << "Prepare kernels failed: " << ret;
     is_running_.store(false);
@@ -753,9 +760,41 @@ int LiteSession::ContextInit(InnerContext *context) {
   context_->thread_pool()->SetMaxSpinCount(kDefaulLiteIosSpinCount);
   context_->thread_pool()->SetMinSpinCount(kDefaulLiteIosSpinCount);
 #endif
+  lite::InitThreadCostModel(config_info_, context_->thread_pool());
   return RET_OK;
 }
 
+void LiteSession::InitSharedWeight(Model *model) {
+  if (config_info_ == nullptr || is_train_session_) {
+    return;
+  }
+  auto section_iter = config_info_->find(kSharedWeightSection);
+  if (section_iter == config_info_->end()) {
+    return;
+  }
+  auto path_iter = section_iter->second.find(kSharedWeightPathKey);
+  if (path_iter == section_iter->second.end() || path_iter->second.empty()) {
+    return;
+  }
+  // the kernels and their packed layouts may differ with the thread num.
+  auto layout_key = "thread" + std::to_string(context_->thread_num_);
+  if (lite::PackWeightManager::GetInstance()->InitSharedWeight(model, path_iter->second, layout_key) != RET_OK) {
+    MS_LOG(WARNING) << "Init the shared packed weight in " << path_iter->second << " failed.";
+  }
+}
+
+bool LiteSession::IsMmapEnable() const {
+  if (config_info_ == nullptr) {
+    return false;
+  }
+  auto section_iter = config_info_->find(kModelLoadSection);
+  if (section_iter == config_info_->end()) {
+    return false;
+  }
+  auto mmap_iter = section_iter->second.find(kEnableMmapKey);
+  return mmap_iter != section_iter->second.end() && mmap_iter->second == "true";
+}
+
 int LiteSession::CreateTensorRTDelegate() {
 #if GPU_TENSORRT
   std::string cache_model_path;
@@ -1648,9 +1687,18 @@ const char *lite::LiteSession::LoadModelByPath(const std::string &file, mindspor
 }
 
 const char *lite::LiteSession::LoadModelByPath(const std::string &file, mindspore::ModelType model_type, size_t *size,
-                                               const std::shared_ptr<mindspore::Context> &ms_context) {
+                                               const std::shared_ptr<mindspore::Context> &ms_context, bool *use_mmap) {
   size_t buf_size;
-  auto model_buf = lite::ReadFile(file.c_str(), &buf_size);
+  char *model_buf = nullptr;
+  bool model_buf_by_mmap = use_mmap != nullptr && *use_mmap && lite::IsMmapSupported();
+  if (model_buf_by_mmap) {
+    model_buf = static_cast<char *>(lite::ReadFileByMmap(file, &buf_size));
+  } else {
+    model_buf = lite::ReadFile(file.c_str(), &buf_size);
+  }
+  if (use_mmap != nullptr) {
+    *use_mmap = model_buf_by_mmap;
+  }
   if (model_buf == nullptr) {
     MS_LOG(ERROR) << "The model path is invalid";
     return model_buf;
@@ -1659,8 +1707,16 @@ const char *lite::LiteSession::LoadModelByPath(const std::string &file, mindspor
   char *lite_buf = nullptr;
   auto buf_model_type = LoadModelByBuff(model_buf, buf_size, &lite_buf, size, model_type, ms_context);
   if (buf_model_type == mindspore::ModelType::kUnknownType || lite_buf == nullptr) {
+    if (model_buf_by_mmap) {
+      lite::UnmapMmapBuffer(model_buf, buf_size);
+    }
     return nullptr;
   }
+  if (model_buf_by_mmap && lite_buf != model_buf) {
+    // the mindir model is converted into a new buffer, the mapped file is not used any more.
+    lite::UnmapMmapBuffer(model_buf, buf_size);
+    *use_mmap = false;
+  }
 
   return lite_buf;
 }
@@ -1763,23 +1819,34 @@ int lite::LiteSession::LoadModelAndCompileByPath(const std::string &model_path,
 int lite::LiteSession::LoadModelAndCompileByPath(const std::string &model_path, mindspore::ModelType model_type,
                                                  const std::shared_ptr<mindspore::Context> &ms_context) {
   size_t model_size;
-  auto model_buf = LoadModelByPath(model_path, model_type, &model_size, ms_context);
+  bool use_mmap = IsMmapEnable();
+  auto model_buf = LoadModelByPath(model_path, model_type, &model_size, ms_context, &use_mmap);
   if (model_buf == nullptr) {
     MS_LOG(ERROR) << "Read model file failed";
     return RET_ERROR;
   }
+  auto free_model_buf = [model_buf, model_size, use_mmap]() {
+    if (use_mmap) {
+      lite::UnmapMmapBuffer(const_cast<char *>(model_buf), model_size);
+    } else {
+      delete[] model_buf;
+    }
+  };
   auto *model = lite::ImportFromBuffer(model_buf, model_size, true, model_type);
   if (model == nullptr) {
     MS_LOG(ERROR) << "Import model failed";
-    delete[] model_buf;
+    free_model_buf();
     return RET_ERROR;
   }
 
+  // the weights which are not packed by kernels are used in the model buffer without copy, so the mapped pages of the
+  // model file are only read when they are used.
   (reinterpret_cast<lite::LiteModel *>(model))->set_keep_model_buf(true);
+  (reinterpret_cast<lite::LiteModel *>(model))->set_model_buf_by_mmap(use_mmap);
   auto ret = CompileGraph(model);
   if (ret != lite::RET_OK) {
     MS_LOG(ERROR) << "Compile model failed";
-    delete[] model_buf;
+    free_model_buf();
     model->buf = nullptr;
     delete model;
     return RET_ERROR;
@@ -59,8 +59,9 @@ class LiteSession : public session::LiteSession {
                                               size_t *size, mindspore::ModelType model_type,
                                               const std::shared_ptr<mindspore::Context> &ms_context);
   static const char *LoadModelByPath(const std::string &file, mindspore::ModelType model_type, size_t *size);
+  // use_mmap: whether to map the model file instead of reading it, and whether the returned buffer is mapped.
   static const char *LoadModelByPath(const std::string &file, mindspore::ModelType model_type, size_t *size,
-                                     const std::shared_ptr<mindspore::Context> &ms_context);
+                                     const std::shared_ptr<mindspore::Context> &ms_context, bool *use_mmap = nullptr);
   virtual int Init(InnerContext *context);
   void BindThread(bool if_bind) override;
   int CompileGraph(Model *model) override;
@@ -98,6 +99,8 @@ class LiteSession : public session::LiteSession {
   void InitGraphOutputNodeMap(const lite::Model *model);
   void InitGraphOutputTensorMap(const lite::Model *model);
   int UpdateInputShapeMap();
+  bool IsMmapEnable() const;
+  void InitSharedWeight(Model *model);
   int ResizeInputs(const std::vector<mindspore::tensor::MSTensor *> &inputs, const std::vector<std::vector<int>> &dims);
   int SetAllocatorForDelegateKernels(const kernel::KernelExec *kernel);
   int PrepareKernels(const Model *model);
@@ -14,6 +14,9 @@
  * limitations under the License.
  */
 #include "src/pack_weight_manager.h"
+#include <map>
+#include <utility>
+#include "src/lite_model.h"
 namespace mindspore::lite {
 namespace {
 #ifndef __ANDROID__
@@ -101,7 +104,49 @@ void *PackWeightManager::MallocData(size_t size) {
   return data;
 }
 
-void *PackWeightManager::GetPackData(const void *tensor_data, const size_t size, bool *is_packed) {
+STATUS PackWeightManager::InitSharedWeight(Model *model, const std::string &dir, const std::string &layout_key) {
+  MS_CHECK_TRUE_MSG(model != nullptr, RET_ERROR, "model is nullptr in pack weight manager.");
+  if (model->buf == nullptr || model->buf_size_ == 0) {
+    MS_LOG(WARNING) << "model buf is released, can not share the packed weight.";
+    return RET_NOT_SUPPORT;
+  }
+  auto lite_model = reinterpret_cast<LiteModel *>(model);
+  std::map<const void *, size_t> origin_index;
+  for (auto node : model->all_nodes_) {
+    for (auto tensor_index : node->input_indices_) {
+      auto src_tensor = lite_model->GetSchemaTensor(tensor_index);
+      if (src_tensor == nullptr || src_tensor->handler() == nullptr || src_tensor->data() == nullptr ||
+          src_tensor->length() == 0) {
+        continue;
+      }
+      origin_index[src_tensor->data()] = tensor_index;
+    }
+  }
+  auto file_path = SharedPackWeight::GetFilePath(dir, model->buf, model->buf_size_, layout_key);
+  return shared_pack_weight_.Init(model, file_path, std::move(origin_index));
+}
+
+STATUS PackWeightManager::FinishSharedWeight(Model *model, bool publish) {
+  return shared_pack_weight_.Finish(model, publish);
+}
+
+void *PackWeightManager::GetPackData(const void *tensor_data, const size_t size, const std::string &kernel_name,
+                                     bool *is_packed) {
+  auto shared_data = shared_pack_weight_.GetPackData(tensor_data, size, kernel_name);
+  if (shared_data != nullptr) {
+    *is_packed = true;
+    return shared_data;
+  }
+  auto data = GetPackDataInner(tensor_data, size, is_packed);
+  if (data != nullptr && !*is_packed) {
+    shared_pack_weight_.RecordPackData(tensor_data, size, kernel_name, data);
+  }
+  return data;
+}
+
+void PackWeightManager::SetPacked(const void *pack_data) { shared_pack_weight_.SetPacked(pack_data); }
+
+void *PackWeightManager::GetPackDataInner(const void *tensor_data, const size_t size, bool *is_packed) {
 #ifdef SHARING_MODEL_WEIGHT
   if (pack_weight_ == nullptr) {
     void *data = MallocData(size);
@@ -127,6 +172,10 @@ void PackWeightManager::FreeData(void *tensor_data) {
 }
 
 void PackWeightManager::Free(void *tensor_data) {
+  if (shared_pack_weight_.IsSharedData(tensor_data)) {
+    return;
+  }
+  shared_pack_weight_.EraseRecord(tensor_data);
 #ifdef SHARING_MODEL_WEIGHT
   if (pack_weight_ == nullptr) {
     FreeData(tensor_data);
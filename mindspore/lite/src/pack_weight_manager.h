@@ -17,9 +17,11 @@
 #ifndef MINDSPORE_LITE_SRC_PACK_WEIGHT_MANAGER_H_
 #define MINDSPORE_LITE_SRC_PACK_WEIGHT_MANAGER_H_
 #include <memory>
+#include <string>
 #include "include/model.h"
 #include "include/errorcode.h"
 #include "src/tensor.h"
+#include "src/shared_pack_weight.h"
 #ifdef SHARING_MODEL_WEIGHT
 #include "src/pack_weight.h"
 #endif
@@ -31,13 +33,21 @@ class PackWeightManager {
   STATUS InitByBuf(const char *model_buf, size_t model_size, int numa_id = -1);
   char *GetNumaModelBuf(const char *model_buf, int numa_id);
   STATUS StoreOriginTensorData(Model *model);
-  void *GetPackData(const void *tensor_data, const size_t size, bool *is_packed);
+  // kernel_name identifies the layout of the packed weight, since the kernels sharing a tensor may pack it differently.
+  void *GetPackData(const void *tensor_data, const size_t size, const std::string &kernel_name, bool *is_packed);
+  // Called by the kernel once it has packed the weight into the data returned by GetPackData with is_packed unset.
+  void SetPacked(const void *pack_data);
   void Free(void *tensor_data);
+  // Use the packed weights of model in the shared directory during the compile, see SharedPackWeight.
+  STATUS InitSharedWeight(Model *model, const std::string &dir, const std::string &layout_key);
+  STATUS FinishSharedWeight(Model *model, bool publish = true);
 
  private:
+  void *GetPackDataInner(const void *tensor_data, const size_t size, bool *is_packed);
   void *MallocData(size_t size);
   void FreeData(void *tensor_data);
   PackWeightManager() = default;
+  SharedPackWeight shared_pack_weight_;
 #ifdef SHARING_MODEL_WEIGHT
   std::shared_ptr<PackWeight> pack_weight_ = nullptr;
 #endif
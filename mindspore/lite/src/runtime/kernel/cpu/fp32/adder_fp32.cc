@@ -82,12 +82,16 @@ int AdderCPUKernel::InitWeightBias() {
   CHECK_NULL_RETURN(origin_weight);
   CHECK_LESS_RETURN(MAX_MALLOC_SIZE, pack_weight_size * sizeof(float));
   packed_weight_ = lite::PackWeightManager::GetInstance()->GetPackData(
-    in_tensors_[1]->data(), pack_weight_size * sizeof(float), &weight_is_packed_);
+    in_tensors_[1]->data(), pack_weight_size * sizeof(float), this->name(), &weight_is_packed_);
   if (packed_weight_ == nullptr) {
     MS_LOG(ERROR) << "malloc packed weight failed.";
     return RET_ERROR;
   }
-  RowMajor2Col4Major(origin_weight, reinterpret_cast<float *>(packed_weight_), out_channel, in_channel * kernel_plane);
+  if (!weight_is_packed_) {
+    RowMajor2Col4Major(origin_weight, reinterpret_cast<float *>(packed_weight_), out_channel,
+                       in_channel * kernel_plane);
+    lite::PackWeightManager::GetInstance()->SetPacked(packed_weight_);
+  }
   CHECK_LESS_RETURN(MAX_MALLOC_SIZE, oc_block_num * oc_block * sizeof(float));
   bias_data_ = reinterpret_cast<float *>(malloc(oc_block_num * oc_block * sizeof(float)));
   if (bias_data_ == nullptr) {
@@ -0,0 +1,415 @@
+/**
+ * Copyright 2022 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "src/runtime/kernel/cpu/fp32/elementwise_chain_fp32.h"
+#include <algorithm>
+#include <iterator>
+#include <cstdlib>
+#include <cstring>
+#include <memory>
+#include <set>
+#include <string>
+#include "schema/model_generated.h"
+#include "include/errorcode.h"
+#include "src/common/log_adapter.h"
+#include "src/runtime/infer_manager.h"
+#include "nnacl/fp32/arithmetic_fp32.h"
+#include "nnacl/fp32/activation_fp32.h"
+
+using mindspore::lite::RET_ERROR;
+using mindspore::lite::RET_INFER_ERR;
+using mindspore::lite::RET_INFER_INVALID;
+using mindspore::lite::RET_OK;
+
+namespace mindspore::kernel {
+namespace {
+// 2 tiles of 512 floats are used by a task, which stay in the L1 cache.
+constexpr int kChainTileSize = 512;
+constexpr int kChainTileNum = 2;
+
+typedef struct {
+  int primitive_type_;
+  int activation_type_;
+  int (*func_)(const float *in0, const float *in1, float *out, int size);
+  int (*opt_func_)(const float *in0, const float *in1, float *out, int size, const ArithmeticParameter *param);
+} CHAIN_ARITHMETIC_FUNC_INFO;
+
+const CHAIN_ARITHMETIC_FUNC_INFO kChainArithmeticFuncs[] = {
+  {schema::PrimitiveType_AddFusion, schema::ActivationType_NO_ACTIVATION, ElementAdd, ElementOptAdd},
+  {schema::PrimitiveType_AddFusion, schema::ActivationType_RELU, ElementAddRelu, ElementOptAddRelu},
+  {schema::PrimitiveType_AddFusion, schema::ActivationType_RELU6, ElementAddRelu6, ElementOptAddRelu6},
+  {schema::PrimitiveType_SubFusion, schema::ActivationType_NO_ACTIVATION, ElementSub, ElementOptSub},
+  {schema::PrimitiveType_SubFusion, schema::ActivationType_RELU, ElementSubRelu, ElementOptSubRelu},
+  {schema::PrimitiveType_SubFusion, schema::ActivationType_RELU6, ElementSubRelu6, ElementOptSubRelu6},
+  {schema::PrimitiveType_MulFusion, schema::ActivationType_NO_ACTIVATION, ElementMul, ElementOptMul},
+  {schema::PrimitiveType_MulFusion, schema::ActivationType_RELU, ElementMulRelu, ElementOptMulRelu},
+  {schema::PrimitiveType_MulFusion, schema::ActivationType_RELU6, ElementMulRelu6, ElementOptMulRelu6},
+  {schema::PrimitiveType_DivFusion, schema::ActivationType_NO_ACTIVATION, ElementDiv, ElementOptDiv},
+  {schema::PrimitiveType_DivFusion, schema::ActivationType_RELU, ElementDivRelu, ElementOptDivRelu},
+  {schema::PrimitiveType_DivFusion, schema::ActivationType_RELU6, ElementDivRelu6, ElementOptDivRelu6},
+  {schema::PrimitiveType_RealDiv, schema::ActivationType_NO_ACTIVATION, ElementDiv, ElementOptDiv},
+  {schema::PrimitiveType_Maximum, schema::ActivationType_NO_ACTIVATION, ElementMaximum, ElementOptMaximum},
+  {schema::PrimitiveType_Minimum, schema::ActivationType_NO_ACTIVATION, ElementMinimum, ElementOptMinimum}};
+
+const std::set<int> kChainActivationTypes = {
+  schema::ActivationType_RELU,   schema::ActivationType_RELU6,    schema::ActivationType_LEAKY_RELU,
+  schema::ActivationType_SIGMOID, schema::ActivationType_TANH,    schema::ActivationType_SWISH,
+  schema::ActivationType_HSWISH, schema::ActivationType_HSIGMOID, schema::ActivationType_HARD_TANH,
+  schema::ActivationType_GELU,   schema::ActivationType_SOFTPLUS, schema::ActivationType_ELU};
+
+const CHAIN_ARITHMETIC_FUNC_INFO *GetArithmeticFunc(int primitive_type, int activation_type) {
+  for (const auto &info : kChainArithmeticFuncs) {
+    if (info.primitive_type_ == primitive_type && info.activation_type_ == activation_type) {
+      return &info;
+    }
+  }
+  return nullptr;
+}
+
+bool IsFp32Tensor(const lite::Tensor *tensor) {
+  return tensor != nullptr && tensor->data_type() == kNumberTypeFloat32 && tensor->format() != NC4HW4 &&
+         tensor->format() != NC8HW8;
+}
+
+int RunActivation(const ElementwiseChainStep &step, const float *src, float *dst, int count) {
+  switch (step.act_type_) {
+    case schema::ActivationType_RELU:
+      return Fp32Relu(src, count, dst);
+    case schema::ActivationType_RELU6:
+      return Fp32Relu6(src, count, dst);
+    case schema::ActivationType_LEAKY_RELU:
+      return LRelu(src, count, dst, step.alpha_);
+    case schema::ActivationType_SIGMOID:
+      return Sigmoid(src, count, dst);
+    case schema::ActivationType_TANH:
+      return Tanh(src, count, dst);
+    case schema::ActivationType_SWISH:
+      return Swish(src, count, dst);
+    case schema::ActivationType_HSWISH:
+      return HSwish(src, count, dst);
+    case schema::ActivationType_HSIGMOID:
+      return HSigmoid(src, count, dst);
+    case schema::ActivationType_HARD_TANH:
+      return HardTanh(src, count, dst, step.min_val_, step.max_val_);
+    case schema::ActivationType_GELU:
+      return Gelu(src, count, dst, true);
+    case schema::ActivationType_SOFTPLUS:
+      return Softplus(src, count, dst);
+    case schema::ActivationType_ELU:
+      return Elu(src, count, dst, step.alpha_);
+    default:
+      MS_LOG(ERROR) << "Unsupported activation type " << step.act_type_ << " in the elementwise chain.";
+      return RET_ERROR;
+  }
+}
+
+int ElementwiseChainRun(void *cdata, int task_id, float lhs_scale, float rhs_scale) {
+  CHECK_NULL_RETURN(cdata);
+  auto kernel = reinterpret_cast<ElementwiseChainCPUKernel *>(cdata);
+  auto ret = kernel->DoFusedRun(task_id);
+  if (ret != RET_OK) {
+    MS_LOG(ERROR) << "ElementwiseChainRun error task_id[" << task_id << "] error_code[" << ret << "]";
+    return RET_ERROR;
+  }
+  return RET_OK;
+}
+}  // namespace
+
+ElementwiseChainCPUKernel::~ElementwiseChainCPUKernel() {
+  for (auto *kernel : chain_) {
+    delete kernel;
+  }
+  chain_.clear();
+}
+
+bool ElementwiseChainCPUKernel::IsSupported(const KernelExec *kernel) {
+  if (kernel == nullptr || kernel->subgraph_type() != kNotSubGraph || kernel->desc().provider != kBuiltin ||
+      kernel->desc().arch != kCPU || kernel->desc().data_type != kNumberTypeFloat32) {
+    return false;
+  }
+  auto type = kernel->type();
+  bool is_arithmetic = std::any_of(std::begin(kChainArithmeticFuncs), std::end(kChainArithmeticFuncs),
+                                   [type](const auto &info) { return info.primitive_type_ == type; });
+  if (type != schema::PrimitiveType_Activation && !is_arithmetic) {
+    return false;
+  }
+  auto param = kernel->op_parameter();
+  if (param == nullptr || param->quant_type_ != schema::QuantType_QUANT_NONE || param->is_train_session_) {
+    return false;
+  }
+  const auto &inputs = kernel->in_tensors();
+  const auto &outputs = kernel->out_tensors();
+  if (outputs.size() != 1 || !IsFp32Tensor(outputs.front()) || !kernel->InferShapeDone() ||
+      std::any_of(inputs.begin(), inputs.end(), [](const lite::Tensor *input) { return !IsFp32Tensor(input); })) {
+    return false;
+  }
+  if (type == schema::PrimitiveType_Activation) {
+    return inputs.size() == 1 &&
+           kChainActivationTypes.find(reinterpret_cast<ActivationParameter *>(param)->type_) !=
+             kChainActivationTypes.end();
+  }
+  if (inputs.size() != kInputSize1 ||
+      GetArithmeticFunc(type, reinterpret_cast<ArithmeticParameter *>(param)->activation_type_) == nullptr) {
+    return false;
+  }
+  // One of the inputs has the output shape, and the other one is a scalar or has the output shape too.
+  const auto &shape = outputs.front()->shape();
+  auto is_tile_input = [&shape](const lite::Tensor *input) {
+    return input->shape() == shape || input->ElementsNum() == 1;
+  };
+  return (inputs[0]->shape() == shape || inputs[1]->shape() == shape) && is_tile_input(inputs[0]) &&
+         is_tile_input(inputs[1]);
+}
+
+KernelExec *ElementwiseChainCPUKernel::Create(const std::vector<KernelExec *> &chain, const lite::InnerContext *ctx) {
+  if (chain.empty()) {
+    return nullptr;
+  }
+  std::vector<lite::Tensor *> inputs;
+  std::vector<ElementwiseChainStep> steps;
+  std::string name;
+  lite::Tensor *chain_data = nullptr;
+  for (auto *kernel : chain) {
+    MS_CHECK_TRUE_RET(IsSupported(kernel), nullptr);
+    ElementwiseChainStep step;
+    step.type_ = kernel->type();
+    const auto &kernel_inputs = kernel->in_tensors();
+    if (kernel->type() == schema::PrimitiveType_Activation) {
+      auto act_param = reinterpret_cast<ActivationParameter *>(kernel->op_parameter());
+      step.act_type_ = act_param->type_;
+      step.alpha_ = act_param->alpha_;
+      step.min_val_ = act_param->min_val_;
+      step.max_val_ = act_param->max_val_;
+      if (chain_data == nullptr) {
+        inputs.push_back(kernel_inputs.front());
+      }
+    } else {
+      step.act_type_ = reinterpret_cast<ArithmeticParameter *>(kernel->op_parameter())->activation_type_;
+      auto func_info = GetArithmeticFunc(step.type_, step.act_type_);
+      MS_CHECK_TRUE_RET(func_info != nullptr, nullptr);
+      step.func_ = func_info->func_;
+      step.opt_func_ = func_info->opt_func_;
+      size_t data_index = 0;
+      if (chain_data == nullptr) {
+        // The chain starts from the input which has the output shape.
+        data_index = kernel_inputs[0]->shape() == kernel->out_tensors().front()->shape() ? 0 : 1;
+        inputs.push_back(kernel_inputs[data_index]);
+      } else {
+        MS_CHECK_TRUE_RET(kernel_inputs[0] == chain_data || kernel_inputs[1] == chain_data, nullptr);
+        data_index = kernel_inputs[0] == chain_data ? 0 : 1;
+      }
+      step.operand_first_ = data_index == 1;
+      step.operand_index_ = static_cast<int>(inputs.size());
+      inputs.push_back(kernel_inputs[1 - data_index]);
+    }
+    chain_data = kernel->out_tensors().front();
+    steps.push_back(step);
+    name += name.empty() ? kernel->name() : "+" + kernel->name();
+  }
+
+  auto *param = reinterpret_cast<OpParameter *>(malloc(sizeof(OpParameter)));
+  if (param == nullptr) {
+    MS_LOG(ERROR) << "malloc OpParameter failed.";
+    return nullptr;
+  }
+  memset(param, 0, sizeof(OpParameter));
+  param->type_ = PrimType::PrimType_Inner_ElementwiseChain;
+  param->thread_num_ = chain.front()->op_parameter()->thread_num_;
+  auto *lite_kernel = new (std::nothrow) ElementwiseChainCPUKernel(param, inputs, {chain_data}, ctx, chain, steps);
+  if (lite_kernel == nullptr) {
+    MS_LOG(ERROR) << "new ElementwiseChainCPUKernel failed.";
+    free(param);
+    return nullptr;
+  }
+  std::shared_ptr<kernel::Kernel> shared_kernel(lite_kernel);
+  auto *kernel_exec = new (std::nothrow) KernelExec(shared_kernel);
+  if (kernel_exec == nullptr) {
+    MS_LOG(ERROR) << "new KernelExec failed.";
+    // The chain kernels are still owned by the caller.
+    lite_kernel->chain_.clear();
+    return nullptr;
+  }
+  auto desc = chain.front()->desc();
+  desc.type = PrimType::PrimType_Inner_ElementwiseChain;
+  kernel_exec->set_desc(desc);
+  kernel_exec->set_context(ctx);
+  kernel_exec->set_name("ElementwiseChain: " + name);
+  return kernel_exec;
+}
+
+int ElementwiseChainCPUKernel::Prepare() {
+  for (auto *kernel : chain_) {
+    auto ret = kernel->Prepare();
+    if (ret != RET_OK) {
+      MS_LOG(ERROR) << "Prepare kernel " << kernel->name() << " of the elementwise chain failed.";
+      return ret;
+    }
+  }
+  if (!InferShapeDone()) {
+    return RET_OK;
+  }
+  return ReSize();
+}
+
+int ElementwiseChainCPUKernel::PreProcess() {
+  // The shapes of the chain are inferred by the chain kernels, since the fused kernel has no infer function.
+  if (!InferShapeDone()) {
+    auto ret = ReSize();
+    if (ret != RET_OK) {
+      MS_LOG(ERROR) << "ReSize fail!ret: " << ret;
+      return ret;
+    }
+    if (!InferShapeDone()) {
+      MS_LOG(ERROR) << "InferShape fail!";
+      return RET_INFER_ERR;
+    }
+  }
+  return LiteKernel::PreProcess();
+}
+
+int ElementwiseChainCPUKernel::ReSize() {
+  for (auto *kernel : chain_) {
+    auto ret = lite::KernelInferShape(kernel->in_tensors(), kernel->out_tensors(), kernel->op_parameter(),
+                                      ms_context_->allocator);
+    if (ret == RET_INFER_INVALID) {
+      MS_LOG(INFO) << "InferShape shouldn't be done before runtime, kernel: " << kernel->name();
+      return RET_OK;
+    }
+    if (ret != RET_OK) {
+      MS_LOG(ERROR) << "InferShape of kernel " << kernel->name() << " in the elementwise chain failed.";
+      return RET_INFER_ERR;
+    }
+    ret = kernel->ReSize();
+    if (ret != RET_OK) {
+      MS_LOG(ERROR) << "ReSize kernel " << kernel->name() << " of the elementwise chain failed.";
+      return ret;
+    }
+  }
+  fuse_by_tile_ = InitTileSteps();
+  if (!fuse_by_tile_) {
+    MS_LOG(INFO) << name() << " runs the kernels one by one, since the shapes can't be evaluated by tile.";
+  }
+  element_num_ = out_tensors_.front()->ElementsNum();
+  const auto &last_step = steps_.back();
+  return UpdateThreadNumPass(TC_TYPE(last_step.type_, last_step.act_type_), static_cast<int64_t>(in_tensors_.size()),
+                             1, element_num_);
+}
+
+bool ElementwiseChainCPUKernel::InitTileSteps() {
+  for (size_t i = 0; i < chain_.size(); ++i) {
+    auto &step = steps_[i];
+    const auto &kernel_inputs = chain_[i]->in_tensors();
+    const auto &shape = chain_[i]->out_tensors().front()->shape();
+    auto data = kernel_inputs.at(step.operand_first_ ? 1 : 0);
+    if (data->shape() != shape) {
+      return false;
+    }
+    if (step.operand_index_ < 0) {
+      continue;
+    }
+    auto operand = in_tensors_.at(step.operand_index_);
+    auto data_num = static_cast<int>(data->ElementsNum());
+    step.operand_scalar_ = operand->ElementsNum() == 1;
+    if (!step.operand_scalar_ && operand->shape() != shape) {
+      return false;
+    }
+    // The opt functions of nnacl take the first input as the scalar if its elements num is 1.
+    step.opt_param_.in_elements_num0_ = step.operand_first_ ? 1 : data_num;
+    step.opt_param_.in_elements_num1_ = step.operand_first_ ? data_num : 1;
+  }
+  return true;
+}
+
+int ElementwiseChainCPUKernel::RunStep(const ElementwiseChainStep &step, const float *src, float *dst,
+                                       int64_t offset, int count) const {
+  if (step.operand_index_ < 0) {
+    return RunActivation(step, src, dst, count);
+  }
+  auto operand = reinterpret_cast<const float *>(in_tensors_.at(step.operand_index_)->data());
+  CHECK_NULL_RETURN(operand);
+  if (step.operand_scalar_) {
+    return step.operand_first_ ? step.opt_func_(operand, src, dst, count, &step.opt_param_)
+                               : step.opt_func_(src, operand, dst, count, &step.opt_param_);
+  }
+  operand += offset;
+  return step.operand_first_ ? step.func_(operand, src, dst, count) : step.func_(src, operand, dst, count);
+}
+
+int ElementwiseChainCPUKernel::DoFusedRun(int task_id) {
+  auto src = reinterpret_cast<const float *>(in_tensors_.front()->data());
+  auto dst = reinterpret_cast<float *>(out_tensors_.front()->data());
+  CHECK_NULL_RETURN(src);
+  CHECK_NULL_RETURN(dst);
+  MS_CHECK_TRUE_RET(thread_num_ > 0, RET_ERROR);
+  // The tasks are aligned to the cache line to avoid the false sharing of the output.
+  int64_t stride = UP_ROUND(UP_DIV(element_num_, thread_num_), C16NUM);
+  int64_t start = stride * task_id;
+  int64_t end = MSMIN(start + stride, element_num_);
+  // The steps write the tiles in turn, since some nnacl functions can't compute in place.
+  float tiles[kChainTileNum][kChainTileSize];
+  for (int64_t offset = start; offset < end; offset += kChainTileSize) {
+    auto count = static_cast<int>(MSMIN(kChainTileSize, end - offset));
+    const float *step_src = src + offset;
+    for (size_t i = 0; i < steps_.size(); ++i) {
+      float *step_dst = i + 1 == steps_.size() ? dst + offset : tiles[i % kChainTileNum];
+      auto ret = RunStep(steps_[i], step_src, step_dst, offset, count);
+      if (ret != RET_OK) {
+        MS_LOG(ERROR) << "Run step " << i << " of " << name() << " failed, ret: " << ret;
+        return RET_ERROR;
+      }
+      step_src = step_dst;
+    }
+  }
+  return RET_OK;
+}
+
+int ElementwiseChainCPUKernel::RunOneByOne() {
+  for (size_t i = 0; i < chain_.size(); ++i) {
+    auto kernel = static_cast<LiteKernel *>(chain_[i]->kernel());
+    // The intermediate tensors are only alive between the producer and the consumer.
+    auto output = kernel->out_tensors().front();
+    bool is_intermediate = i + 1 < chain_.size();
+    if (is_intermediate && output->MallocData(ms_context_->allocator) != RET_OK) {
+      MS_LOG(ERROR) << "Malloc the output of kernel " << kernel->name() << " failed.";
+      return RET_ERROR;
+    }
+    auto ret = kernel->Run();
+    if (i > 0) {
+      chain_[i - 1]->out_tensors().front()->FreeData();
+    }
+    if (ret != RET_OK) {
+      MS_LOG(ERROR) << "Run kernel " << kernel->name() << " of the elementwise chain failed.";
+      if (is_intermediate) {
+        output->FreeData();
+      }
+      return ret;
+    }
+  }
+  return RET_OK;
+}
+
+int ElementwiseChainCPUKernel::Run() {
+  if (!fuse_by_tile_) {
+    return RunOneByOne();
+  }
+  auto ret = ParallelLaunch(this->ms_context_, ElementwiseChainRun, this, thread_num_);
+  if (ret != RET_OK) {
+    MS_LOG(ERROR) << "ElementwiseChain function error error_code[" << ret << "]";
+    return RET_ERROR;
+  }
+  return RET_OK;
+}
+}  // namespace mindspore::kernel
@@ -0,0 +1,81 @@
+/**
+ * Copyright 2022 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef MINDSPORE_LITE_SRC_RUNTIME_KERNEL_CPU_FP32_ELEMENTWISE_CHAIN_FP32_H_
+#define MINDSPORE_LITE_SRC_RUNTIME_KERNEL_CPU_FP32_ELEMENTWISE_CHAIN_FP32_H_
+
+#include <utility>
+#include <vector>
+#include "src/lite_kernel.h"
+#include "src/kernel_exec.h"
+#include "nnacl/arithmetic.h"
+
+namespace mindspore::kernel {
+// One kernel of the chain. The arithmetic takes the chain data and the operand, which is a scalar or has the shape of
+// the chain data, and the activation takes the chain data only.
+struct ElementwiseChainStep {
+  int type_ = 0;
+  int act_type_ = 0;
+  float alpha_ = 0.0f;
+  float min_val_ = 0.0f;
+  float max_val_ = 0.0f;
+  // The index of the operand in the inputs of the chain kernel, -1 for the activation.
+  int operand_index_ = -1;
+  // Whether the operand is the first input of the arithmetic, which matters for the sub and div.
+  bool operand_first_ = false;
+  bool operand_scalar_ = false;
+  int (*func_)(const float *in0, const float *in1, float *out, int size) = nullptr;
+  int (*opt_func_)(const float *in0, const float *in1, float *out, int size,
+                   const ArithmeticParameter *param) = nullptr;
+  ArithmeticParameter opt_param_ = {};
+};
+
+// The chain of the fp32 elementwise kernels fused at schedule time. The chain is evaluated tile by tile: every kernel
+// of the chain runs on a tile small enough to stay in the L1 cache with the nnacl simd functions, so the intermediate
+// tensors of the chain are never written to the memory. The original kernels are kept to run one by one when the
+// shapes after resize can't be evaluated by tile, e.g. the operand of an arithmetic needs broadcast.
+class ElementwiseChainCPUKernel : public LiteKernel {
+ public:
+  ElementwiseChainCPUKernel(OpParameter *param, const std::vector<lite::Tensor *> &inputs,
+                            const std::vector<lite::Tensor *> &outputs, const lite::InnerContext *ctx,
+                            std::vector<KernelExec *> chain, std::vector<ElementwiseChainStep> steps)
+      : LiteKernel(param, inputs, outputs, ctx), chain_(std::move(chain)), steps_(std::move(steps)) {}
+  ~ElementwiseChainCPUKernel() override;
+
+  int Prepare() override;
+  int PreProcess() override;
+  int ReSize() override;
+  int Run() override;
+  int DoFusedRun(int task_id);
+
+  // Create the kernel fused by the chain of kernels, each of which is the only consumer of the previous one's output.
+  // The chain kernels are owned by the fused kernel afterwards.
+  static KernelExec *Create(const std::vector<KernelExec *> &chain, const lite::InnerContext *ctx);
+  static bool IsSupported(const KernelExec *kernel);
+
+ private:
+  bool InitTileSteps();
+  int RunStep(const ElementwiseChainStep &step, const float *src, float *dst, int64_t offset, int count) const;
+  int RunOneByOne();
+
+  std::vector<KernelExec *> chain_;
+  std::vector<ElementwiseChainStep> steps_;
+  bool fuse_by_tile_ = false;
+  int64_t element_num_ = 0;
+};
+}  // namespace mindspore::kernel
+
+#endif  // MINDSPORE_LITE_SRC_RUNTIME_KERNEL_CPU_FP32_ELEMENTWISE_CHAIN_FP32_H_
@@ -86,7 +86,8 @@ int MatmulFp32BaseCPUKernel::PackMatrixA() {
   } else {
     bool is_packed = false;
     void *data = lite::PackWeightManager::GetInstance()->GetPackData(
-      in_tensors()[FIRST_INPUT]->data(), static_cast<size_t>(matrix_a_.pack_size) * sizeof(float), &is_packed);
+      in_tensors()[FIRST_INPUT]->data(), static_cast<size_t>(matrix_a_.pack_size) * sizeof(float), this->name(),
+      &is_packed);
     matrix_a_.pack_ptr = reinterpret_cast<float *>(data);
     if (matrix_a_.pack_ptr == nullptr) {
       MS_LOG(ERROR) << "matrix a pack ptr is nullptr.";
@@ -96,10 +97,16 @@ int MatmulFp32BaseCPUKernel::PackMatrixA() {
       return RET_OK;
     }
   }
+  auto ret = RET_OK;
   if (pack_opt_) {
-    return PackMatrixAImplOpt();  // currently, only arm64 support.
+    ret = PackMatrixAImplOpt();  // currently, only arm64 support.
+  } else {
+    ret = PackMatrixAImpl();
+  }
+  if (ret == RET_OK && params_->a_const_) {
+    lite::PackWeightManager::GetInstance()->SetPacked(matrix_a_.pack_ptr);
   }
-  return PackMatrixAImpl();
+  return ret;
 }
 
 int MatmulFp32BaseCPUKernel::PackMatrixAImpl() {
@@ -142,7 +149,8 @@ int MatmulFp32BaseCPUKernel::PackMatrixB() {
   } else {
     bool is_packed = false;
     void *data = lite::PackWeightManager::GetInstance()->GetPackData(
-      in_tensors()[SECOND_INPUT]->data(), static_cast<size_t>(matrix_b_.pack_size) * sizeof(float), &is_packed);
+      in_tensors()[SECOND_INPUT]->data(), static_cast<size_t>(matrix_b_.pack_size) * sizeof(float), this->name(),
+      &is_packed);
     matrix_b_.pack_ptr = reinterpret_cast<float *>(data);
     if (matrix_b_.pack_ptr == nullptr) {
       MS_LOG(ERROR) << "matrix b pack ptr is nullptr.";
@@ -152,7 +160,11 @@ int MatmulFp32BaseCPUKernel::PackMatrixB() {
       return RET_OK;
     }
   }
-  return PackMatrixBImpl();
+  auto ret = PackMatrixBImpl();
+  if (ret == RET_OK && params_->b_const_) {
+    lite::PackWeightManager::GetInstance()->SetPacked(matrix_b_.pack_ptr);
+  }
+  return ret;
 }
 
 int MatmulFp32BaseCPUKernel::PackMatrixBImpl() {
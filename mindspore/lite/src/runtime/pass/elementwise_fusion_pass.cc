@@ -0,0 +1,137 @@
+/**
+ * Copyright 2022 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "src/runtime/pass/elementwise_fusion_pass.h"
+#ifndef RUNTIME_PASS_CLIP
+#include <algorithm>
+#include <set>
+#include "src/common/utils.h"
+#include "src/runtime/kernel/cpu/fp32/elementwise_chain_fp32.h"
+#endif
+
+namespace mindspore::lite::pass {
+#ifndef RUNTIME_PASS_CLIP
+namespace {
+constexpr size_t kMinChainSize = 2;
+
+// The output of kernel is only used by next in the chain, so it needn't be written to the memory.
+bool CanLinkTo(kernel::SubGraphKernel *subgraph, kernel::KernelExec *kernel, kernel::KernelExec *next) {
+  auto output = kernel->out_tensors().front();
+  if (output->IsGraphOutput() || IsContain(subgraph->out_tensors(), output)) {
+    return false;
+  }
+  if (kernel->out_kernels().size() != 1 || kernel->out_kernels().front() != next ||
+      !IsContain(subgraph->nodes(), next) || !kernel::ElementwiseChainCPUKernel::IsSupported(next)) {
+    return false;
+  }
+  size_t use_num = 0;
+  for (auto *node : subgraph->nodes()) {
+    use_num += std::count(node->in_tensors().begin(), node->in_tensors().end(), output);
+  }
+  // The output is the chain data of next, which has the shape of the output of next.
+  return use_num == 1 && output->shape() == next->out_tensors().front()->shape();
+}
+
+void ReplaceKernels(std::vector<kernel::KernelExec *> *kernels, const std::vector<kernel::KernelExec *> &chain,
+                    kernel::KernelExec *fused) {
+  std::vector<kernel::KernelExec *> replaced;
+  for (auto *kernel : *kernels) {
+    auto *item = IsContain(chain, kernel) ? fused : kernel;
+    if (!IsContain(replaced, item)) {
+      replaced.push_back(item);
+    }
+  }
+  *kernels = replaced;
+}
+
+void ReplaceChain(kernel::SubGraphKernel *subgraph, const std::vector<kernel::KernelExec *> &chain) {
+  auto fused = kernel::ElementwiseChainCPUKernel::Create(chain, chain.front()->Context());
+  if (fused == nullptr) {
+    MS_LOG(WARNING) << "Create the elementwise chain kernel of " << chain.front()->name() << " failed.";
+    return;
+  }
+  std::vector<kernel::KernelExec *> in_kernels;
+  for (auto *kernel : chain) {
+    for (auto *in_kernel : kernel->in_kernels()) {
+      if (!IsContain(chain, in_kernel) && !IsContain(in_kernels, in_kernel)) {
+        in_kernels.push_back(in_kernel);
+      }
+    }
+  }
+  fused->set_in_kernels(in_kernels);
+  fused->set_out_kernels(chain.back()->out_kernels());
+  for (auto *in_kernel : in_kernels) {
+    auto out_kernels = in_kernel->out_kernels();
+    ReplaceKernels(&out_kernels, chain, fused);
+    in_kernel->set_out_kernels(out_kernels);
+  }
+  for (auto *out_kernel : chain.back()->out_kernels()) {
+    auto out_in_kernels = out_kernel->in_kernels();
+    ReplaceKernels(&out_in_kernels, chain, fused);
+    out_kernel->set_in_kernels(out_in_kernels);
+  }
+
+  // The fused kernel takes the place of the chain tail, after which the operands of the chain are all ready.
+  auto &nodes = subgraph->nodes();
+  std::replace(nodes.begin(), nodes.end(), chain.back(), fused);
+  for (size_t i = 0; i + 1 < chain.size(); ++i) {
+    VectorErase(&nodes, chain[i]);
+  }
+  auto in_nodes = subgraph->in_nodes();
+  ReplaceKernels(&in_nodes, chain, fused);
+  subgraph->SetInNodes(in_nodes);
+  auto out_nodes = subgraph->out_nodes();
+  ReplaceKernels(&out_nodes, chain, fused);
+  subgraph->SetOutNodes(out_nodes);
+  MS_LOG(INFO) << "Fuse " << chain.size() << " elementwise kernels into " << fused->name();
+}
+
+void FuseElementwiseChains(kernel::SubGraphKernel *subgraph) {
+  std::set<kernel::KernelExec *> visited;
+  std::vector<std::vector<kernel::KernelExec *>> chains;
+  for (auto *kernel : subgraph->nodes()) {
+    if (visited.find(kernel) != visited.end() || !kernel::ElementwiseChainCPUKernel::IsSupported(kernel)) {
+      continue;
+    }
+    std::vector<kernel::KernelExec *> chain = {kernel};
+    while (chain.back()->out_kernels().size() == 1 &&
+           CanLinkTo(subgraph, chain.back(), chain.back()->out_kernels().front())) {
+      chain.push_back(chain.back()->out_kernels().front());
+    }
+    visited.insert(chain.begin(), chain.end());
+    if (chain.size() >= kMinChainSize) {
+      chains.push_back(chain);
+    }
+  }
+  for (const auto &chain : chains) {
+    ReplaceChain(subgraph, chain);
+  }
+}
+}  // namespace
+#endif
+
+int ElementwiseFusionPass(std::vector<kernel::KernelExec *> *subgraphs) {
+#ifndef RUNTIME_PASS_CLIP
+  for (auto *subgraph : *subgraphs) {
+    if (subgraph->desc().arch != kernel::kCPU || subgraph->subgraph_type() != kernel::kCpuFP32SubGraph) {
+      continue;
+    }
+    FuseElementwiseChains(reinterpret_cast<kernel::SubGraphKernel *>(subgraph));
+  }
+#endif
+  return RET_OK;
+}
+}  // namespace mindspore::lite::pass
@@ -40,6 +40,7 @@
 #include "src/runtime/infer_manager.h"
 #include "src/runtime/runtime_pass.h"
 #include "src/runtime/pass/runtime_ncx_pass.h"
+#include "src/runtime/pass/elementwise_fusion_pass.h"
 #ifndef AUTO_PARALLEL_CLIP
 #include "src/sub_graph_split.h"
 #endif
@@ -484,6 +485,14 @@ int Scheduler::Schedule(std::vector<kernel::KernelExec *> *dst_kernels) {
       return RET_ERROR;
     }
   }
+  // The intermediate tensors of the fused chains are needed by the training.
+  if (!is_train_session_ && !*is_control_flow_) {
+    status = pass::ElementwiseFusionPass(dst_kernels);
+    if (status != RET_OK) {
+      MS_LOG(ERROR) << "elementwise fusion pass failed.";
+      return RET_ERROR;
+    }
+  }
 
   ret = InitKernels(std::move(*dst_kernels));
   if (ret != RET_OK) {
@@ -0,0 +1,291 @@
+/**
+ * Copyright 2022 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "src/shared_pack_weight.h"
+#include <cstring>
+#include <functional>
+#include <sstream>
+#include <string_view>
+#include <vector>
+#if !defined(_WIN32) && !defined(_WIN64)
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+#include "src/common/log_adapter.h"
+#ifdef ENABLE_AVX512
+#include "nnacl/intrinsics/ms_simd_cpu_info.h"
+#endif
+
+namespace mindspore::lite {
+namespace {
+constexpr uint64_t kSharedWeightMagic = 0x4d534c5057454947;  // "MSLPWEIG"
+// Increase the version once the packed layout of any kernel changes.
+constexpr uint32_t kSharedWeightVersion = 2;
+constexpr size_t kPackDataAlignSize = 64;
+// The size of file is aligned to the huge page, which is required by hugetlbfs.
+constexpr size_t kFileAlignSize = 2 * 1024 * 1024;
+
+struct SharedWeightHeader {
+  uint64_t magic;
+  uint32_t version;
+  uint32_t entry_num;
+};
+
+struct SharedWeightEntry {
+  uint64_t tensor_index;
+  uint64_t pack_size;
+  uint64_t kernel_hash;
+  uint64_t offset;
+};
+
+size_t AlignSize(size_t size, size_t align) { return (size + align - 1) / align * align; }
+
+std::string GetIsaName() {
+#if defined(ENABLE_AVX512)
+  return X86_Avx512_Support() ? "avx512" : "avx";
+#elif defined(ENABLE_AVX)
+  return "avx";
+#elif defined(ENABLE_SSE)
+  return "sse";
+#elif defined(ENABLE_ARM64)
+  return "arm64";
+#elif defined(ENABLE_ARM32)
+  return "arm32";
+#else
+  return "generic";
+#endif
+}
+}  // namespace
+
+std::string SharedPackWeight::GetFilePath(const std::string &dir, const char *model_buf, size_t model_size,
+                                          const std::string &layout_key) {
+  auto model_hash = std::hash<std::string_view>()(std::string_view(model_buf, model_size));
+  auto layout_hash =
+    std::hash<std::string>()(GetIsaName() + "_" + layout_key + "_" + std::to_string(kSharedWeightVersion));
+  std::ostringstream file_path;
+  file_path << dir << "/mslite_packed_weight_" << std::hex << model_hash << "_" << GetIsaName() << "_" << layout_hash
+            << ".bin";
+  return file_path.str();
+}
+
+STATUS SharedPackWeight::Init(const void *model, const std::string &file_path,
+                              std::map<const void *, size_t> origin_index) {
+#if !defined(_WIN32) && !defined(_WIN64)
+  std::lock_guard<std::mutex> lock(mtx_shared_);
+  auto &model_record = model_records_[model];
+  model_record.file_path = file_path;
+  model_record.origin_index = std::move(origin_index);
+  model_record.pending_records.clear();
+  model_record.records.clear();
+  auto iter = mapped_files_.find(file_path);
+  if (iter != mapped_files_.end()) {
+    model_record.mapped_file = iter->second;
+    return RET_OK;
+  }
+  model_record.mapped_file = MapFile(file_path);
+  if (model_record.mapped_file != nullptr) {
+    mapped_files_[file_path] = model_record.mapped_file;
+    MS_LOG(INFO) << "Use the shared packed weight file " << file_path;
+  }
+  return RET_OK;
+#else
+  MS_LOG(WARNING) << "The shared packed weight is not supported on windows.";
+  return RET_NOT_SUPPORT;
+#endif
+}
+
+STATUS SharedPackWeight::Finish(const void *model, bool publish) {
+  std::lock_guard<std::mutex> lock(mtx_shared_);
+  auto iter = model_records_.find(model);
+  if (iter == model_records_.end()) {
+    return RET_OK;
+  }
+  auto ret = RET_OK;
+  if (publish && iter->second.mapped_file == nullptr && !iter->second.records.empty()) {
+    ret = WriteFile(iter->second);
+  }
+  // the origin tensor data is invalid after the compile, the mapped file is kept for the later sessions.
+  model_records_.erase(iter);
+  return ret;
+}
+
+void *SharedPackWeight::GetPackData(const void *tensor_data, size_t size, const std::string &kernel_name) {
+  std::lock_guard<std::mutex> lock(mtx_shared_);
+  for (auto &item : model_records_) {
+    auto &model_record = item.second;
+    auto index_iter = model_record.origin_index.find(tensor_data);
+    if (model_record.mapped_file == nullptr || index_iter == model_record.origin_index.end()) {
+      continue;
+    }
+    auto &mapped_file = model_record.mapped_file;
+    auto entry_iter =
+      mapped_file->entries.find(std::make_tuple(index_iter->second, size, std::hash<std::string>()(kernel_name)));
+    if (entry_iter != mapped_file->entries.end()) {
+      return static_cast<uint8_t *>(mapped_file->addr) + entry_iter->second;
+    }
+  }
+  return nullptr;
+}
+
+void SharedPackWeight::RecordPackData(const void *tensor_data, size_t size, const std::string &kernel_name,
+                                      void *pack_data) {
+  std::lock_guard<std::mutex> lock(mtx_shared_);
+  for (auto &item : model_records_) {
+    auto &model_record = item.second;
+    auto index_iter = model_record.origin_index.find(tensor_data);
+    if (model_record.mapped_file == nullptr && index_iter != model_record.origin_index.end()) {
+      model_record.pending_records[pack_data] =
+        std::make_tuple(index_iter->second, size, std::hash<std::string>()(kernel_name));
+      return;
+    }
+  }
+}
+
+void SharedPackWeight::SetPacked(const void *pack_data) {
+  std::lock_guard<std::mutex> lock(mtx_shared_);
+  for (auto &item : model_records_) {
+    auto &model_record = item.second;
+    auto iter = model_record.pending_records.find(pack_data);
+    if (iter != model_record.pending_records.end()) {
+      model_record.records[pack_data] = iter->second;
+      (void)model_record.pending_records.erase(iter);
+      return;
+    }
+  }
+}
+
+void SharedPackWeight::EraseRecord(const void *pack_data) {
+  std::lock_guard<std::mutex> lock(mtx_shared_);
+  for (auto &item : model_records_) {
+    (void)item.second.pending_records.erase(pack_data);
+    (void)item.second.records.erase(pack_data);
+  }
+}
+
+bool SharedPackWeight::IsSharedData(const void *data) {
+  std::lock_guard<std::mutex> lock(mtx_shared_);
+  for (auto &item : mapped_files_) {
+    auto begin = static_cast<const uint8_t *>(item.second->addr);
+    auto ptr = static_cast<const uint8_t *>(data);
+    if (ptr >= begin && ptr < begin + item.second->size) {
+      return true;
+    }
+  }
+  return false;
+}
+
+std::shared_ptr<SharedPackWeight::MappedFile> SharedPackWeight::MapFile(const std::string &file_path) {
+#if !defined(_WIN32) && !defined(_WIN64)
+  auto fd = open(file_path.c_str(), O_RDONLY);
+  if (fd < 0) {
+    MS_LOG(INFO) << "The shared packed weight file " << file_path << " doesn't exist, create it after compile.";
+    return nullptr;
+  }
+  struct stat fd_stat;
+  if (fstat(fd, &fd_stat) != 0 || static_cast<size_t>(fd_stat.st_size) < sizeof(SharedWeightHeader)) {
+    MS_LOG(WARNING) << "The shared packed weight file " << file_path << " is invalid.";
+    (void)close(fd);
+    return nullptr;
+  }
+  auto file_size = static_cast<size_t>(fd_stat.st_size);
+  auto addr = mmap(nullptr, file_size, PROT_READ, MAP_SHARED, fd, 0);
+  (void)close(fd);
+  if (addr == MAP_FAILED) {
+    MS_LOG(WARNING) << "mmap the shared packed weight file " << file_path << " failed.";
+    return nullptr;
+  }
+  auto mapped_file = std::make_shared<MappedFile>();
+  mapped_file->addr = addr;
+  mapped_file->size = file_size;
+  auto header = static_cast<const SharedWeightHeader *>(addr);
+  auto entries_end = sizeof(SharedWeightHeader) + static_cast<size_t>(header->entry_num) * sizeof(SharedWeightEntry);
+  if (header->magic != kSharedWeightMagic || header->version != kSharedWeightVersion || entries_end > file_size) {
+    MS_LOG(WARNING) << "The shared packed weight file " << file_path << " is invalid.";
+    (void)munmap(addr, file_size);
+    return nullptr;
+  }
+  auto entries = reinterpret_cast<const SharedWeightEntry *>(header + 1);
+  for (uint32_t i = 0; i < header->entry_num; i++) {
+    if (entries[i].offset < entries_end || entries[i].offset + entries[i].pack_size > file_size) {
+      MS_LOG(WARNING) << "The shared packed weight file " << file_path << " is invalid.";
+      (void)munmap(addr, file_size);
+      return nullptr;
+    }
+    mapped_file->entries[std::make_tuple(entries[i].tensor_index, entries[i].pack_size, entries[i].kernel_hash)] =
+      entries[i].offset;
+  }
+  return mapped_file;
+#else
+  return nullptr;
+#endif
+}
+
+STATUS SharedPackWeight::WriteFile(const ModelRecord &model_record) {
+#if !defined(_WIN32) && !defined(_WIN64)
+  std::vector<SharedWeightEntry> entries;
+  std::vector<const void *> pack_data;
+  auto offset = AlignSize(sizeof(SharedWeightHeader) + model_record.records.size() * sizeof(SharedWeightEntry),
+                          kPackDataAlignSize);
+  for (auto &record : model_record.records) {
+    auto pack_size = std::get<1>(record.second);
+    entries.push_back({std::get<0>(record.second), pack_size, std::get<2>(record.second), offset});
+    pack_data.push_back(record.first);
+    offset = AlignSize(offset + pack_size, kPackDataAlignSize);
+  }
+  auto file_size = AlignSize(offset, kFileAlignSize);
+  // write to a temporary file and rename it, so the other processes never map a partial file.
+  auto tmp_path = model_record.file_path + ".tmp." + std::to_string(getpid());
+  auto fd = open(tmp_path.c_str(), O_RDWR | O_CREAT | O_TRUNC, S_IRUSR | S_IWUSR | S_IRGRP | S_IROTH);
+  if (fd < 0) {
+    MS_LOG(WARNING) << "Create the shared packed weight file " << tmp_path << " failed.";
+    return RET_ERROR;
+  }
+  if (ftruncate(fd, static_cast<off_t>(file_size)) != 0) {
+    MS_LOG(WARNING) << "Resize the shared packed weight file " << tmp_path << " failed.";
+    (void)close(fd);
+    (void)unlink(tmp_path.c_str());
+    return RET_ERROR;
+  }
+  // hugetlbfs only supports writing by mmap.
+  auto addr = mmap(nullptr, file_size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+  (void)close(fd);
+  if (addr == MAP_FAILED) {
+    MS_LOG(WARNING) << "mmap the shared packed weight file " << tmp_path << " failed.";
+    (void)unlink(tmp_path.c_str());
+    return RET_ERROR;
+  }
+  auto header = static_cast<SharedWeightHeader *>(addr);
+  header->magic = kSharedWeightMagic;
+  header->version = kSharedWeightVersion;
+  header->entry_num = static_cast<uint32_t>(entries.size());
+  (void)memcpy(header + 1, entries.data(), entries.size() * sizeof(SharedWeightEntry));
+  for (size_t i = 0; i < entries.size(); i++) {
+    (void)memcpy(static_cast<uint8_t *>(addr) + entries[i].offset, pack_data[i], entries[i].pack_size);
+  }
+  (void)munmap(addr, file_size);
+  if (rename(tmp_path.c_str(), model_record.file_path.c_str()) != 0) {
+    MS_LOG(WARNING) << "Rename the shared packed weight file " << tmp_path << " failed.";
+    (void)unlink(tmp_path.c_str());
+    return RET_ERROR;
+  }
+  MS_LOG(INFO) << "Write " << entries.size() << " packed weights to the shared file " << model_record.file_path;
+  return RET_OK;
+#else
+  return RET_NOT_SUPPORT;
+#endif
+}
+}  // namespace mindspore::lite
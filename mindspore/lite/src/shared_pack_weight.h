@@ -0,0 +1,84 @@
+/**
+ * Copyright 2022 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef MINDSPORE_LITE_SRC_SHARED_PACK_WEIGHT_H_
+#define MINDSPORE_LITE_SRC_SHARED_PACK_WEIGHT_H_
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <tuple>
+#include <utility>
+#include "include/errorcode.h"
+
+namespace mindspore::lite {
+// Shares the packed weights of the same model across the sessions and the processes on the host. The first session
+// compiling the model records the weights packed by the kernels and writes them to a file in the shared directory,
+// which is usually a tmpfs like /dev/shm or a hugetlbfs mount. The later sessions and processes map the file
+// read-only and use the packed weights in place instead of packing them again. The file is keyed by the hash of
+// model, the isa and the layout key of the session, and the packed weights in it are keyed by the index of the origin
+// tensor, the packed size and the kernel packing it, since the kernels sharing a tensor may pack it differently.
+class SharedPackWeight {
+ public:
+  SharedPackWeight() = default;
+  // The mapped files are kept until the process exits, since the kernels may still hold the packed weights in them.
+  ~SharedPackWeight() = default;
+
+  static std::string GetFilePath(const std::string &dir, const char *model_buf, size_t model_size,
+                                 const std::string &layout_key);
+
+  // Begin the compile of model, origin_index maps the data of the const tensors to their indexes in model.
+  STATUS Init(const void *model, const std::string &file_path, std::map<const void *, size_t> origin_index);
+  // Write the recorded packed weights of model to the file if it doesn't exist and publish is set, and end the
+  // compile of model.
+  STATUS Finish(const void *model, bool publish);
+
+  // Return the packed weight of the origin tensor data packed by the kernel in the shared file, or nullptr if missed.
+  void *GetPackData(const void *tensor_data, size_t size, const std::string &kernel_name);
+  // The buffer is recorded as pending when it's allocated, and only written to the file after SetPacked tells the
+  // kernel has packed the weight into it.
+  void RecordPackData(const void *tensor_data, size_t size, const std::string &kernel_name, void *pack_data);
+  void SetPacked(const void *pack_data);
+  void EraseRecord(const void *pack_data);
+  bool IsSharedData(const void *data);
+
+ private:
+  // (tensor index, packed size, hash of kernel name)
+  using PackKey = std::tuple<size_t, size_t, size_t>;
+  struct MappedFile {
+    void *addr = nullptr;
+    size_t size = 0;
+    // pack key <-> offset of the packed weight in file
+    std::map<PackKey, size_t> entries;
+  };
+  struct ModelRecord {
+    std::string file_path;
+    std::map<const void *, size_t> origin_index;
+    std::shared_ptr<MappedFile> mapped_file = nullptr;
+    // packed weight <-> pack key, which is recorded if the file doesn't exist.
+    std::map<const void *, PackKey> pending_records;
+    std::map<const void *, PackKey> records;
+  };
+
+  std::shared_ptr<MappedFile> MapFile(const std::string &file_path);
+  STATUS WriteFile(const ModelRecord &model_record);
+
+  std::mutex mtx_shared_;
+  std::map<const void *, ModelRecord> model_records_;
+  std::map<std::string, std::shared_ptr<MappedFile>> mapped_files_;
+};
+}  // namespace mindspore::lite
+#endif  // MINDSPORE_LITE_SRC_SHARED_PACK_WEIGHT_H_
@@ -103,7 +103,8 @@ int SubGraphKernel::ReSize() {
         return RET_ERROR;
       }
       // replace with custom op in the future.
-      if (parameter->type_ == static_cast<int>(PrimType::PrimType_Inner_Identity)) {
+      if (parameter->type_ == static_cast<int>(PrimType::PrimType_Inner_Identity) ||
+          parameter->type_ == static_cast<int>(PrimType::PrimType_Inner_ElementwiseChain)) {
         ret = kernel->ReSize();
         if (ret != RET_OK) {
           MS_LOG(ERROR) << "kernel " << kernel->name() << " resize fail!ret = " << ret;
@@ -15,6 +15,7 @@
  */
 
 #include "src/sub_graph_split.h"
+#include <cmath>
 #include <cstdlib>
 #include <utility>
 #include <algorithm>
@@ -30,10 +31,26 @@
 #include "nnacl/pooling_parameter.h"
 #include "include/model.h"
 #include "nnacl/base/conv_common_base.h"
+#ifdef DYNAMIC_THREAD_DISTRIBUTE
+#include "src/thread_cost_model.h"
+#endif
 
 namespace {
 constexpr const int kMaxDepth = 2048;
 constexpr int kOperatorMaxThreadNum = 16;
+
+/* The node costs are counted in the multiplications of the element-wise Mul, one multiply-accumulate of conv and
+ * matmul counts as one of them, and the other ops are scaled by their compute costs relative to Mul. */
+float RelativeComputeCost(int type) {
+#ifdef DYNAMIC_THREAD_DISTRIBUTE
+  auto reference_cost = mindspore::lite::GetKernelComputeCost(
+    TC_TYPE(mindspore::schema::PrimitiveType_MulFusion, mindspore::schema::ActivationType_NO_ACTIVATION));
+  return reference_cost > 0 ? mindspore::lite::GetKernelComputeCost(TC_TYPE(type, 0)) / reference_cost : 1.0f;
+#else
+  (void)type;
+  return 1.0f;
+#endif
+}
 }  // namespace
 
 namespace mindspore::lite {
@@ -1146,7 +1163,6 @@ void SearchSubGraph::SubGraphSplitByOperator() {
     Subgraph subgraph;
     subgraph.ends_.push_back(out);
     subgraph.device_ = DT_CPU;
-    subgraph.thread_ = context_->thread_num_ > kOperatorMaxThreadNum ? kOperatorMaxThreadNum : context_->thread_num_;
 
     InsertNodeBegin(static_cast<uint32_t>(out), &subgraph, &outputs_vec);
     for (auto new_out : outputs_vec) {
@@ -1157,6 +1173,65 @@ void SearchSubGraph::SubGraphSplitByOperator() {
       sub_graphs_.push_back(std::move(subgraph));
     }
   }
+  BalanceSubGraphThread(&sub_graphs_);
   ConvertSubGraphToModel(&sub_graphs_);
 }
+
+size_t SearchSubGraph::CalculateNodeCost(uint32_t node_index) {
+  const Model::Node *node = model_->all_nodes_.at(node_index);
+  if (node->output_indices_.empty()) {
+    return 0;
+  }
+  auto output_index = node->output_indices_.front();
+  auto output = src_tensors_->at(output_index);
+  size_t element_num = output->ElementsNum() > 0 ? static_cast<size_t>(output->ElementsNum()) : 1;
+  auto type = GetPrimitiveType(node->primitive_, SCHEMA_VERSION::SCHEMA_CUR);
+
+  if (type == schema::PrimitiveType_Conv2DFusion && node->input_indices_.size() > 1 &&
+      op_parameters_->find(static_cast<int>(output_index)) != op_parameters_->end() &&
+      src_tensors_->at(node->input_indices_[1])->shape().size() == DIMENSION_4D &&
+      output->shape().size() == DIMENSION_4D) {
+    auto conv_cost = CalculateConv2DFusion(node).mul_cost_;
+    if (conv_cost > 0) {
+      return conv_cost;
+    }
+  }
+  if ((type == schema::PrimitiveType_MatMulFusion || type == schema::PrimitiveType_FullConnection) &&
+      !node->input_indices_.empty()) {
+    /* approximately the depth of the matmul */
+    auto input_shape = src_tensors_->at(node->input_indices_.front())->shape();
+    if (!input_shape.empty() && input_shape.back() > 0) {
+      return element_num * static_cast<size_t>(input_shape.back());
+    }
+  }
+  return static_cast<size_t>(element_num * RelativeComputeCost(type)) + 1;
+}
+
+void SearchSubGraph::BalanceSubGraphThread(std::vector<Subgraph> *sub_graphs) {
+  /* The subgraphs split by operator run in parallel and share the threads of the parallel thread pool, the idle
+   * threads run the tasks of the kernels with the most tasks left. The heaviest subgraph is split into the most tasks,
+   * and the lighter ones get the threads in proportion to their costs, so that they don't flood the pool with tiny
+   * tasks while the heaviest one is running. */
+  size_t max_thread = context_->thread_num_ > kOperatorMaxThreadNum ? kOperatorMaxThreadNum : context_->thread_num_;
+  max_thread = max_thread > 0 ? max_thread : 1;
+  size_t max_cost = 0;
+  for (Subgraph &subgraph : *sub_graphs) {
+    subgraph.cost_.empty();
+    for (uint32_t node_index : subgraph.nodes_) {
+      subgraph.cost_.mul_cost_ += CalculateNodeCost(node_index);
+    }
+    max_cost = subgraph.cost_.mul_cost_ > max_cost ? subgraph.cost_.mul_cost_ : max_cost;
+  }
+  for (Subgraph &subgraph : *sub_graphs) {
+    if (max_cost == 0) {
+      subgraph.thread_ = max_thread;
+      continue;
+    }
+    auto thread = std::ceil(static_cast<double>(max_thread) * subgraph.cost_.mul_cost_ / max_cost);
+    subgraph.thread_ = thread > 1 ? static_cast<size_t>(thread) : 1;
+    subgraph.thread_ = subgraph.thread_ < max_thread ? subgraph.thread_ : max_thread;
+    MS_LOG(INFO) << "Subgraph split by operator, node num: " << subgraph.nodes_.size()
+                 << ", cost: " << subgraph.cost_.mul_cost_ << ", thread num: " << subgraph.thread_;
+  }
+}
 }  // namespace mindspore::lite
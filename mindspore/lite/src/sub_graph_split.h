@@ -39,6 +39,7 @@ constexpr int kMaxSubGraphCount = 10;
 constexpr int kMinSubgraphCost = 50;
 constexpr double kDefaultGpu = 0.5;
 class SearchSubGraph {
+ private:
   enum TensorType { NORMAL, CONST, INPUT };
 
   struct Tensor {
@@ -91,6 +92,11 @@ class SearchSubGraph {
   void SubGraphSplitByOperator();
   void InsertNodeBegin(uint32_t index, Subgraph *subgraph, std::vector<size_t> *outputs);
 
+ private: /* split by operator */
+  /* the cost is counted in the multiplications of the element-wise Mul */
+  size_t CalculateNodeCost(uint32_t node_index);
+  void BalanceSubGraphThread(std::vector<Subgraph> *sub_graphs);
+
  private: /* split by output */
   void SubGraphSplitByOutput();
   void InitSearchSubGraphByOutput();
@@ -15,13 +15,26 @@
  */
 
 #include "src/thread_cost_model.h"
+#include <algorithm>
+#include <chrono>
+#include <cstring>
+#include <fstream>
+#include <functional>
 #include <map>
+#include <mutex>
+#include <vector>
+#include "src/common/common.h"
 #include "src/common/log_util.h"
 #include "src/inner_context.h"
 #include "thread/threadpool.h"
+#include "nnacl/fp32/activation_fp32.h"
+#include "nnacl/fp32/add_fp32.h"
+#include "nnacl/fp32/arithmetic_self_fp32.h"
+#include "nnacl/fp32/div_fp32.h"
+#include "nnacl/fp32/mul_fp32.h"
 
 namespace mindspore::lite {
-const std::map<int32_t, float> kernel_compute_cost_map_ = {
+std::map<int32_t, float> ThreadCostModel::kernel_compute_cost_map_ = {
   {TC_TYPE(schema::PrimitiveType_Activation, schema::ActivationType_RELU), 1.806f},        // dataNum about 100k
   {TC_TYPE(schema::PrimitiveType_Activation, schema::ActivationType_RELU6), 1.806f},       // dataNum about 100k
   {TC_TYPE(schema::PrimitiveType_Activation, schema::ActivationType_LEAKY_RELU), 1.806f},  // dataNum about 100k
@@ -72,6 +85,228 @@ int64_t ThreadCostModel::per_unit_compute_num_ = 1;           // 1 : per unit co
 float ThreadCostModel::thread_startup_cost_ = 100000.0f;  // 100000 : thread startup inherent cost
 float ThreadCostModel::single_thread_cost_ = 100000.0f;   // 100000 : Minimum cost of single-threaded
 float ThreadCostModel::parallel_thread_cost_ = 40000.0f;  // 40000 : Minimum cost of per thread in parallel-thread
+std::atomic_bool ThreadCostModel::calibrated_{false};
+
+namespace {
+constexpr int kProbeDataNum = 16384;  // 64KB of float, which fits in the L2 cache like the data of the default costs
+constexpr int kProbeLoopNum = 20;
+constexpr int kLaunchProbeLoopNum = 200;
+// The work of a thread in parallel should be several times of its launch overhead, the ratios between the thread
+// costs follow the default ones.
+constexpr float kParallelLaunchRatio = 4.0f;
+constexpr float kStartupLaunchRatio = 10.0f;
+constexpr float kMinComputeCost = 0.01f;
+constexpr float kDefaultComputeCost = 1.0f;  // the cost of the kernel not in the map
+constexpr auto kProfileLoadCost = "per_unit_load_cost";
+constexpr auto kProfileStoreCost = "per_unit_store_cost";
+constexpr auto kProfileStartupCost = "thread_startup_cost";
+constexpr auto kProfileSingleCost = "single_thread_cost";
+constexpr auto kProfileParallelCost = "parallel_thread_cost";
+constexpr auto kProfileKernelCost = "kernel_compute_cost";
+
+std::mutex calibrate_mutex;
+
+struct CostProbe {
+  int64_t load_num;
+  int64_t store_num;
+  std::function<void(const float *, const float *, float *, int)> run;
+  // The first kernel type is timed by the probe, the costs of the others in the same kernel family scale with it.
+  std::vector<int32_t> kernel_types;
+};
+
+std::vector<CostProbe> GetCostProbes() {
+  using schema::ActivationType_NO_ACTIVATION;
+  using schema::ActivationType_RELU;
+  using schema::ActivationType_RELU6;
+  return {
+    {1, 1, [](const float *in0, const float *, float *out, int size) { (void)Fp32Relu(in0, size, out); },
+     {TC_TYPE(schema::PrimitiveType_Activation, ActivationType_RELU),
+      TC_TYPE(schema::PrimitiveType_Activation, ActivationType_RELU6),
+      TC_TYPE(schema::PrimitiveType_Activation, schema::ActivationType_LEAKY_RELU)}},
+    {1, 1, [](const float *in0, const float *, float *out, int size) { (void)Tanh(in0, size, out); },
+     {TC_TYPE(schema::PrimitiveType_Activation, schema::ActivationType_TANH)}},
+    {1, 1, [](const float *in0, const float *, float *out, int size) { (void)ElementSqrt(in0, out, size); },
+     {TC_TYPE(schema::PrimitiveType_Sqrt, 0)}},
+    {2, 1, [](const float *in0, const float *in1, float *out, int size) { (void)ElementAdd(in0, in1, out, size); },
+     {TC_TYPE(schema::PrimitiveType_AddFusion, ActivationType_NO_ACTIVATION),
+      TC_TYPE(schema::PrimitiveType_AddFusion, ActivationType_RELU),
+      TC_TYPE(schema::PrimitiveType_AddFusion, ActivationType_RELU6),
+      TC_TYPE(schema::PrimitiveType_SubFusion, ActivationType_NO_ACTIVATION),
+      TC_TYPE(schema::PrimitiveType_SubFusion, ActivationType_RELU),
+      TC_TYPE(schema::PrimitiveType_SubFusion, ActivationType_RELU6), TC_TYPE(schema::PrimitiveType_BiasAdd, 0)}},
+    {2, 1, [](const float *in0, const float *in1, float *out, int size) { (void)ElementMul(in0, in1, out, size); },
+     {TC_TYPE(schema::PrimitiveType_MulFusion, ActivationType_NO_ACTIVATION),
+      TC_TYPE(schema::PrimitiveType_MulFusion, ActivationType_RELU),
+      TC_TYPE(schema::PrimitiveType_MulFusion, ActivationType_RELU6)}},
+    {2, 1, [](const float *in0, const float *in1, float *out, int size) { (void)ElementDiv(in0, in1, out, size); },
+     {TC_TYPE(schema::PrimitiveType_RealDiv, ActivationType_NO_ACTIVATION),
+      TC_TYPE(schema::PrimitiveType_RealDiv, ActivationType_RELU),
+      TC_TYPE(schema::PrimitiveType_RealDiv, ActivationType_RELU6),
+      TC_TYPE(schema::PrimitiveType_DivFusion, ActivationType_NO_ACTIVATION),
+      TC_TYPE(schema::PrimitiveType_DivFusion, ActivationType_RELU),
+      TC_TYPE(schema::PrimitiveType_DivFusion, ActivationType_RELU6)}},
+  };
+}
+
+// Return the minimum time in nanoseconds of the runs, the minimum filters out the noise of the other processes.
+template <typename Func>
+double MinTimeNs(const Func &func, int loop_num) {
+  double min_time = -1.0;
+  for (int i = 0; i < loop_num; i++) {
+    auto start = std::chrono::steady_clock::now();
+    func();
+    auto end = std::chrono::steady_clock::now();
+    auto time = std::chrono::duration<double, std::nano>(end - start).count();
+    if (min_time < 0 || time < min_time) {
+      min_time = time;
+    }
+  }
+  return min_time;
+}
+
+// The costs are fitted in nanoseconds, which only changes the unit of costs since the thread num depends on their
+// ratios. The kernel costs without probe scale with the median ratio of the probed ones.
+std::map<int32_t, float> FitKernelComputeCost(float unit_memory_cost, const std::vector<float> &in0,
+                                              const std::vector<float> &in1, std::vector<float> *out) {
+  std::vector<float> ratios;
+  std::map<int32_t, float> fitted_costs;
+  for (auto &probe : GetCostProbes()) {
+    probe.run(in0.data(), in1.data(), out->data(), kProbeDataNum);  // warm up
+    auto unit_time =
+      MinTimeNs([&]() { probe.run(in0.data(), in1.data(), out->data(), kProbeDataNum); }, kProbeLoopNum) /
+      kProbeDataNum;
+    auto memory_cost = unit_memory_cost * (probe.load_num + probe.store_num);
+    auto compute_cost = std::max(static_cast<float>(unit_time) - memory_cost, kMinComputeCost) /
+                        ThreadCostModel::per_unit_compute_num_;
+    auto ratio = compute_cost / ThreadCostModel::kernel_compute_cost_map_.at(probe.kernel_types.front());
+    ratios.push_back(ratio);
+    for (auto kernel_type : probe.kernel_types) {
+      fitted_costs[kernel_type] = ThreadCostModel::kernel_compute_cost_map_.at(kernel_type) * ratio;
+    }
+  }
+  std::nth_element(ratios.begin(), ratios.begin() + ratios.size() / 2, ratios.end());
+  auto median_ratio = ratios[ratios.size() / 2];
+  for (auto &kernel_cost : ThreadCostModel::kernel_compute_cost_map_) {
+    if (fitted_costs.find(kernel_cost.first) == fitted_costs.end()) {
+      fitted_costs[kernel_cost.first] = kernel_cost.second * median_ratio;
+    }
+  }
+  return fitted_costs;
+}
+
+// Only the values of the map are written, its structure is never changed after the static initialization.
+void SetKernelComputeCost(const std::map<int32_t, float> &kernel_costs) {
+  for (auto &kernel_cost : ThreadCostModel::kernel_compute_cost_map_) {
+    auto iter = kernel_costs.find(kernel_cost.first);
+    if (iter != kernel_costs.end()) {
+      kernel_cost.second = iter->second;
+    }
+  }
+}
+}  // namespace
+
+int ThreadCostModel::Calibrate(ThreadPool *pool) {
+  CHECK_NULL_RETURN(pool);
+  std::lock_guard<std::mutex> lock(calibrate_mutex);
+  if (IsCalibrated()) {
+    return RET_OK;
+  }
+  auto thread_num = static_cast<int>(pool->thread_num());
+  if (thread_num <= 1) {
+    MS_LOG(INFO) << "The parallel launch can't be timed by the thread pool of " << thread_num << " thread.";
+    return RET_NOT_SUPPORT;
+  }
+  std::vector<float> in0(kProbeDataNum, 1.0f);
+  std::vector<float> in1(kProbeDataNum, 2.0f);
+  std::vector<float> out(kProbeDataNum, 0.0f);
+  // the memory costs, a unit of copy loads a float and stores a float.
+  (void)memcpy(out.data(), in0.data(), kProbeDataNum * sizeof(float));
+  auto copy_time =
+    MinTimeNs([&]() { (void)memcpy(out.data(), in0.data(), kProbeDataNum * sizeof(float)); }, kProbeLoopNum);
+  auto unit_memory_cost = static_cast<float>(copy_time / kProbeDataNum / 2);
+  auto kernel_costs = FitKernelComputeCost(unit_memory_cost, in0, in1, &out);
+  // the thread costs, which are timed by launching the empty tasks on all threads.
+  auto empty_task = [](void *, int, float, float) { return RET_OK; };
+  (void)pool->ParallelLaunch(empty_task, nullptr, thread_num);
+  auto launch_time = MinTimeNs([&]() { (void)pool->ParallelLaunch(empty_task, nullptr, thread_num); },
+                               kLaunchProbeLoopNum);
+  // the costs are published all together once the probes are done.
+  per_unit_load_cost_ = unit_memory_cost;
+  per_unit_store_cost_ = unit_memory_cost;
+  SetKernelComputeCost(kernel_costs);
+  parallel_thread_cost_ = static_cast<float>(launch_time) * kParallelLaunchRatio;
+  thread_startup_cost_ = static_cast<float>(launch_time) * kStartupLaunchRatio;
+  single_thread_cost_ = thread_startup_cost_;
+  calibrated_.store(true, std::memory_order_release);
+  MS_LOG(INFO) << "Calibrate thread cost model, load cost: " << per_unit_load_cost_
+               << "ns, launch time: " << launch_time << "ns";
+  return RET_OK;
+}
+
+int ThreadCostModel::LoadProfile(const std::string &profile_path) {
+  std::lock_guard<std::mutex> lock(calibrate_mutex);
+  std::ifstream ifs(profile_path);
+  if (!ifs.is_open()) {
+    MS_LOG(WARNING) << "Open thread cost profile " << profile_path << " failed.";
+    return RET_ERROR;
+  }
+  std::map<std::string, float> costs;
+  std::map<int32_t, float> kernel_costs;
+  std::string key;
+  while (ifs >> key) {
+    int32_t kernel_type = 0;
+    float cost = 0.0f;
+    if (key == kProfileKernelCost) {
+      ifs >> kernel_type;
+    }
+    if (!(ifs >> cost) || cost <= 0.0f) {
+      MS_LOG(ERROR) << "Thread cost profile " << profile_path << " is invalid at " << key;
+      return RET_ERROR;
+    }
+    if (key == kProfileKernelCost) {
+      kernel_costs[kernel_type] = cost;
+    } else {
+      costs[key] = cost;
+    }
+  }
+  for (auto cost_key : {kProfileLoadCost, kProfileStoreCost, kProfileStartupCost, kProfileSingleCost,
+                        kProfileParallelCost}) {
+    if (costs.find(cost_key) == costs.end()) {
+      MS_LOG(ERROR) << "Thread cost profile " << profile_path << " misses " << cost_key;
+      return RET_ERROR;
+    }
+  }
+  if (IsCalibrated()) {
+    MS_LOG(INFO) << "The thread cost model is calibrated already, skip the profile " << profile_path;
+    return RET_OK;
+  }
+  per_unit_load_cost_ = costs[kProfileLoadCost];
+  per_unit_store_cost_ = costs[kProfileStoreCost];
+  thread_startup_cost_ = costs[kProfileStartupCost];
+  single_thread_cost_ = costs[kProfileSingleCost];
+  parallel_thread_cost_ = costs[kProfileParallelCost];
+  SetKernelComputeCost(kernel_costs);
+  calibrated_.store(true, std::memory_order_release);
+  return RET_OK;
+}
+
+int ThreadCostModel::SaveProfile(const std::string &profile_path) {
+  std::lock_guard<std::mutex> lock(calibrate_mutex);
+  std::ofstream ofs(profile_path, std::ios::out | std::ios::trunc);
+  if (!ofs.is_open()) {
+    MS_LOG(WARNING) << "Open thread cost profile " << profile_path << " failed.";
+    return RET_ERROR;
+  }
+  ofs << kProfileLoadCost << " " << per_unit_load_cost_ << "\n";
+  ofs << kProfileStoreCost << " " << per_unit_store_cost_ << "\n";
+  ofs << kProfileStartupCost << " " << thread_startup_cost_ << "\n";
+  ofs << kProfileSingleCost << " " << single_thread_cost_ << "\n";
+  ofs << kProfileParallelCost << " " << parallel_thread_cost_ << "\n";
+  for (auto &kernel_cost : kernel_compute_cost_map_) {
+    ofs << kProfileKernelCost << " " << kernel_cost.first << " " << kernel_cost.second << "\n";
+  }
+  return ofs.good() ? RET_OK : RET_ERROR;
+}
 
 int ThreadCostModel::GetOptimalThreadNum(const ThreadCostContext *thread_cost_context, const int thread_num) {
   const int64_t max_oversharding_factor = 4;
@@ -103,6 +338,52 @@ int ThreadCostModel::GetOptimalThreadNum(const ThreadCostContext *thread_cost_co
   return block_count;
 }
 
+float GetKernelComputeCost(int32_t kernel_type) {
+  auto iter = ThreadCostModel::kernel_compute_cost_map_.find(kernel_type);
+  if (iter != ThreadCostModel::kernel_compute_cost_map_.end()) {
+    return iter->second;
+  }
+  // the kernel with another activation type costs about the same
+  iter = ThreadCostModel::kernel_compute_cost_map_.lower_bound(TC_PTYPE(kernel_type >> 16));
+  if (iter != ThreadCostModel::kernel_compute_cost_map_.end() && (iter->first >> 16) == (kernel_type >> 16)) {
+    return iter->second;
+  }
+  return kDefaultComputeCost;
+}
+
+void InitThreadCostModel(const std::map<std::string, std::map<std::string, std::string>> *config_info,
+                         ThreadPool *pool) {
+  if (config_info == nullptr || ThreadCostModel::IsCalibrated()) {
+    return;
+  }
+  auto section_iter = config_info->find(kThreadCostModelSection);
+  if (section_iter == config_info->end()) {
+    return;
+  }
+  auto &section = section_iter->second;
+  std::string profile_path;
+  auto profile_iter = section.find(kProfilePathKey);
+  if (profile_iter != section.end()) {
+    profile_path = profile_iter->second;
+  }
+  // load the saved profile first, the probes run only if there is no valid profile.
+  if (!profile_path.empty() && ThreadCostModel::LoadProfile(profile_path) == RET_OK) {
+    MS_LOG(INFO) << "Load thread cost profile " << profile_path;
+    return;
+  }
+  auto calibrate_iter = section.find(kCalibrateKey);
+  if (calibrate_iter == section.end() || calibrate_iter->second != "true") {
+    return;
+  }
+  if (ThreadCostModel::Calibrate(pool) != RET_OK) {
+    MS_LOG(WARNING) << "Calibrate thread cost model failed, use the default costs.";
+    return;
+  }
+  if (!profile_path.empty() && ThreadCostModel::SaveProfile(profile_path) != RET_OK) {
+    MS_LOG(WARNING) << "Save thread cost profile " << profile_path << " failed.";
+  }
+}
+
 int ThreadNumUpdateStrategy(const Context *context, const ThreadCostContext *thread_cost_context, int task_num) {
   if (task_num <= 1) {
     return task_num;
@@ -126,9 +407,9 @@ int ThreadNumUpdateStrategy(const Context *context, const ThreadCostContext *thr
 
 int UpdateThreadNum(const Context *context, int32_t kernel_type, int64_t per_unit_load_num, int64_t per_unit_store_num,
                     int64_t unit_num, int thread_num) {
-  if (kernel_compute_cost_map_.count(kernel_type) > 0) {
+  if (ThreadCostModel::kernel_compute_cost_map_.count(kernel_type) > 0) {
     lite::ThreadCostContext thread_cost_context;
-    thread_cost_context.per_unit_compute_cost_ = kernel_compute_cost_map_.at(kernel_type);
+    thread_cost_context.per_unit_compute_cost_ = ThreadCostModel::kernel_compute_cost_map_.at(kernel_type);
     thread_cost_context.per_unit_load_num_ = per_unit_load_num;
     thread_cost_context.per_unit_store_num_ = per_unit_store_num;
     thread_cost_context.total_unit_num_ = unit_num;
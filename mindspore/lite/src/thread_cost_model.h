@@ -18,10 +18,17 @@
 #define MINDSPORE_LITE_SRC_THREAD_COST_MODEL_H
 
 #include <stdint.h>
+#include <atomic>
+#include <map>
+#include <string>
 #include "nnacl/op_base.h"
 #include "include/api/context.h"
 #include "schema/ops_generated.h"
 
+namespace mindspore {
+class ThreadPool;
+}  // namespace mindspore
+
 namespace mindspore::lite {
 typedef struct ThreadCostContext {
   int64_t total_unit_num_;
@@ -61,6 +68,16 @@ struct ThreadCostModel {
   }
   static int GetOptimalThreadNum(const ThreadCostContext *thread_cost_context, const int thread_num);
 
+  // The default costs are tuned on the arm cpus. Calibrate fits the costs to the host by timing the memory copy, some
+  // representative kernels and the parallel launch of the thread pool, which happens once in the process. The fitted
+  // costs can be saved to a profile and loaded by the later processes to skip the probes.
+  // The costs are read by the kernels without lock, so they are only written by the first successful Calibrate or
+  // LoadProfile, which must run before any inference, and stay immutable after calibrated_ is set.
+  static int Calibrate(ThreadPool *pool);
+  static int LoadProfile(const std::string &profile_path);
+  static int SaveProfile(const std::string &profile_path);
+  static bool IsCalibrated() { return calibrated_.load(std::memory_order_acquire); }
+
   static float per_unit_load_cost_;      // per unit load cost
   static float per_unit_store_cost_;     // per unit store cost
   static int64_t per_unit_compute_num_;  // per unit compute num
@@ -68,9 +85,17 @@ struct ThreadCostModel {
   static float thread_startup_cost_;   // thread startup inherent cost
   static float single_thread_cost_;    // Minimum cost of single-threaded
   static float parallel_thread_cost_;  // Minimum cost of per thread in parallel-thread
+
+  // per unit compute cost of the kernels, fitted by Calibrate
+  static std::map<int32_t, float> kernel_compute_cost_map_;
+
+  static std::atomic_bool calibrated_;
 };
 
 float GetKernelComputeCost(int32_t kernel_type);
+// Load the profile or calibrate the costs by the thread_cost_model section of the config, before the first inference.
+void InitThreadCostModel(const std::map<std::string, std::map<std::string, std::string>> *config_info,
+                         ThreadPool *pool);
 int ThreadNumUpdateStrategy(const Context *context, const ThreadCostContext *thread_cost_context, int task_num);
 
 #ifdef DYNAMIC_THREAD_DISTRIBUTE
@@ -84,4 +109,4 @@ inline int UpdateThreadNum(const Context *context, int32_t kernel_type, int64_t
 #endif
 }  // namespace mindspore::lite
 
-#endif  // MINDSPORE_LITE_SRC_INNER_CONTEXT_H
+#endif  // MINDSPORE_LITE_SRC_THREAD_COST_MODEL_H
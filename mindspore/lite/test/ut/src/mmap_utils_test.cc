@@ -0,0 +1,54 @@
+/**
+ * Copyright 2022 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <cstdio>
+#include <fstream>
+#include <string>
+#include "common/common_test.h"
+#include "src/common/mmap_utils.h"
+
+namespace mindspore {
+class MmapUtilsTest : public mindspore::CommonTest {
+ public:
+  MmapUtilsTest() {}
+};
+
+TEST_F(MmapUtilsTest, TestReadFileByMmap) {
+  if (!lite::IsMmapSupported()) {
+    return;
+  }
+  const std::string file_path = "./mmap_utils_test.bin";
+  const std::string content = "mindspore lite mmap model";
+  std::ofstream out_file(file_path, std::ios::binary);
+  out_file.write(content.data(), content.size());
+  out_file.close();
+
+  size_t size = 0;
+  auto buffer = static_cast<char *>(lite::ReadFileByMmap(file_path, &size));
+  ASSERT_NE(buffer, nullptr);
+  ASSERT_EQ(size, content.size());
+  ASSERT_EQ(std::string(buffer, size), content);
+  // the writes to the mapped buffer are private and not written back to the file.
+  buffer[0] = 'M';
+  lite::UnmapMmapBuffer(buffer, size);
+  std::ifstream in_file(file_path, std::ios::binary);
+  std::string file_content((std::istreambuf_iterator<char>(in_file)), std::istreambuf_iterator<char>());
+  ASSERT_EQ(file_content, content);
+  (void)remove(file_path.c_str());
+
+  ASSERT_EQ(lite::ReadFileByMmap("./mmap_utils_test_not_exist.bin", &size), nullptr);
+}
+}  // namespace mindspore
@@ -0,0 +1,90 @@
+/**
+ * Copyright 2022 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include <vector>
+#include "common/common_test.h"
+#define private public
+#include "thread/parallel_threadpool.h"
+#undef private
+
+namespace mindspore {
+class ParallelThreadPoolTest : public mindspore::CommonTest {
+ public:
+  ParallelThreadPoolTest() {}
+
+  // the pool without any worker, so the tasks are only picked and run by the test thread.
+  void SetUp() override {
+    pool_ = new ParallelThreadPool();
+    ASSERT_EQ(pool_->ActorQueueInit(), THREAD_OK);
+    pool_->tasks_ = new ParallelTask[kTaskSize]();
+    pool_->tasks_size_ = kTaskSize;
+  }
+
+  void TearDown() override {
+    delete pool_;
+    pool_ = nullptr;
+  }
+
+  void SetTask(size_t index, int task_num, int started, bool valid, const Func &func = nullptr,
+               Content content = nullptr) {
+    auto task = &pool_->tasks_[index];
+    task->func = func;
+    task->content = content;
+    task->task_num = task_num;
+    task->started = started;
+    task->finished = started;
+    task->valid = valid;
+  }
+
+ protected:
+  static constexpr size_t kTaskSize = 3;
+  ParallelThreadPool *pool_ = nullptr;
+};
+
+TEST_F(ParallelThreadPoolTest, TestPickTaskWithMostLeft) {
+  SetTask(0, 4, 4, true);
+  SetTask(1, 8, 2, true);
+  SetTask(2, 10, 1, false);
+  // the invalid task isn't picked though it has the most subtasks left.
+  ASSERT_EQ(pool_->PickTask(), &pool_->tasks_[1]);
+
+  pool_->tasks_[1].started = 8;
+  ASSERT_EQ(pool_->PickTask(), nullptr);
+
+  pool_->tasks_[2].valid = true;
+  ASSERT_EQ(pool_->PickTask(), &pool_->tasks_[2]);
+}
+
+TEST_F(ParallelThreadPoolTest, TestRunParallelLendToHeaviestTask) {
+  int light_tag = 0;
+  int heavy_tag = 1;
+  std::vector<int> ran_tags;
+  auto func = [&ran_tags](void *content, int, float, float) {
+    ran_tags.push_back(*static_cast<int *>(content));
+    return static_cast<int>(THREAD_OK);
+  };
+  SetTask(0, 3, 1, true, func, &light_tag);
+  SetTask(1, 5, 1, true, func, &heavy_tag);
+  SetTask(2, 0, 0, false);
+
+  ASSERT_TRUE(pool_->RunParallel());
+  // the task with the most subtasks left is picked after every subtask, the earlier one wins the tie.
+  ASSERT_EQ(ran_tags, std::vector<int>({heavy_tag, heavy_tag, light_tag, heavy_tag, light_tag, heavy_tag}));
+  ASSERT_EQ(pool_->tasks_[0].finished, 3);
+  ASSERT_EQ(pool_->tasks_[1].finished, 5);
+  ASSERT_EQ(pool_->PickTask(), nullptr);
+  ASSERT_FALSE(pool_->RunParallel());
+}
+}  // namespace mindspore
@@ -0,0 +1,149 @@
+/**
+ * Copyright 2022 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <memory>
+#include <vector>
+#include "common/common_test.h"
+#include "include/api/types.h"
+#include "src/cxx_api/model_pool/model_worker.h"
+#include "src/cxx_api/model_pool/predict_task_queue.h"
+
+namespace mindspore {
+namespace {
+constexpr int kMaxBatchSize = 4;
+constexpr int kMaxBatchDelayUs = 1000;
+}  // namespace
+
+class PredictTaskQueueTest : public mindspore::CommonTest {
+ public:
+  PredictTaskQueueTest() {}
+
+  void SetUp() override {
+    task_queue_.SetTaskQueueNum(1);
+    task_queue_.SetDynamicBatch(kMaxBatchSize, kMaxBatchDelayUs);
+  }
+
+  // push a task of one float input in the shape of {batch_size, width}.
+  std::shared_ptr<PredictTask> PushTask(int64_t batch_size, int64_t width, bool batchable = true) {
+    auto tensor = MSTensor::CreateTensor("input", DataType::kNumberTypeFloat32, {batch_size, width}, nullptr, 0);
+    EXPECT_NE(tensor, nullptr);
+    inputs_.push_back(std::make_unique<std::vector<MSTensor>>(std::vector<MSTensor>{*tensor}));
+    MSTensor::DestroyTensorPtr(tensor);
+    outputs_.push_back(std::make_unique<std::vector<MSTensor>>());
+    auto task = std::make_shared<PredictTask>(inputs_.back().get(), outputs_.back().get(), nullptr, nullptr);
+    task->batchable = batchable;
+    task_queue_.PushPredictTask(task, 0);
+    return task;
+  }
+
+  // a worker taking the tasks is busy until it finishes them, so every call takes the tasks with an idle worker.
+  std::vector<std::shared_ptr<PredictTask>> GetTasks() {
+    ModelWorker worker;
+    return task_queue_.GetPredictTasks(0, &worker);
+  }
+
+ protected:
+  PredictTaskQueue task_queue_;
+  std::vector<std::unique_ptr<std::vector<MSTensor>>> inputs_;
+  std::vector<std::unique_ptr<std::vector<MSTensor>>> outputs_;
+};
+
+TEST_F(PredictTaskQueueTest, TestCoalesceCompatibleTasks) {
+  auto task1 = PushTask(1, 8);
+  auto task2 = PushTask(1, 8);
+  auto task3 = PushTask(1, 16);
+  // the first two tasks have the same shape except the batch dim, the third one can't join them.
+  auto tasks = GetTasks();
+  ASSERT_EQ(tasks.size(), 2);
+  ASSERT_EQ(tasks[0], task1);
+  ASSERT_EQ(tasks[1], task2);
+  tasks = GetTasks();
+  ASSERT_EQ(tasks.size(), 1);
+  ASSERT_EQ(tasks[0], task3);
+  ASSERT_EQ(task_queue_.GetTaskNum(0), 0);
+}
+
+TEST_F(PredictTaskQueueTest, TestCoalesceUpToMaxBatchSize) {
+  auto task1 = PushTask(2, 8);
+  auto task2 = PushTask(1, 8);
+  auto task3 = PushTask(2, 8);
+  auto task4 = PushTask(1, 8);
+  // the batch of 2 + 1 can't take the next 2, the rest is taken by the next call.
+  auto tasks = GetTasks();
+  ASSERT_EQ(tasks.size(), 2);
+  ASSERT_EQ(tasks[0], task1);
+  ASSERT_EQ(tasks[1], task2);
+  tasks = GetTasks();
+  ASSERT_EQ(tasks.size(), 2);
+  ASSERT_EQ(tasks[0], task3);
+  ASSERT_EQ(tasks[1], task4);
+}
+
+TEST_F(PredictTaskQueueTest, TestNotCoalesceUnbatchableTasks) {
+  auto task1 = PushTask(1, 8, false);
+  auto task2 = PushTask(1, 8);
+  auto task3 = PushTask(1, 8, false);
+  auto tasks = GetTasks();
+  ASSERT_EQ(tasks.size(), 1);
+  ASSERT_EQ(tasks[0], task1);
+  tasks = GetTasks();
+  ASSERT_EQ(tasks.size(), 1);
+  ASSERT_EQ(tasks[0], task2);
+  tasks = GetTasks();
+  ASSERT_EQ(tasks.size(), 1);
+  ASSERT_EQ(tasks[0], task3);
+}
+
+TEST_F(PredictTaskQueueTest, TestNoBatchWithoutDynamicBatch) {
+  task_queue_.SetDynamicBatch(1, kMaxBatchDelayUs);
+  auto task1 = PushTask(1, 8);
+  (void)PushTask(1, 8);
+  auto tasks = GetTasks();
+  ASSERT_EQ(tasks.size(), 1);
+  ASSERT_EQ(tasks[0], task1);
+  ASSERT_EQ(task_queue_.GetTaskNum(0), 1);
+}
+
+TEST_F(PredictTaskQueueTest, TestLatencyPercentile) {
+  PredictLatencyStatistics statistics;
+  ASSERT_EQ(statistics.GetPercentile(50.0f), 0);
+  const int64_t request_num = 100;
+  for (int64_t latency = request_num; latency > 0; latency--) {
+    statistics.Record(latency);
+  }
+  ASSERT_EQ(statistics.GetPercentile(0.0f), 1);
+  ASSERT_EQ(statistics.GetPercentile(50.0f), 50);
+  ASSERT_EQ(statistics.GetPercentile(90.0f), 90);
+  ASSERT_EQ(statistics.GetPercentile(99.0f), 99);
+  ASSERT_EQ(statistics.GetPercentile(100.0f), request_num);
+  // the percentile out of range is clamped.
+  ASSERT_EQ(statistics.GetPercentile(-1.0f), 1);
+  ASSERT_EQ(statistics.GetPercentile(200.0f), request_num);
+}
+
+TEST_F(PredictTaskQueueTest, TestLatencyPercentileOfRecentRequests) {
+  PredictLatencyStatistics statistics;
+  // only the recent 10000 latencies are kept, so the old slow requests are forgotten.
+  const int64_t sample_num = 10000;
+  for (int64_t i = 0; i < sample_num; i++) {
+    statistics.Record(1000);
+  }
+  for (int64_t i = 0; i < sample_num; i++) {
+    statistics.Record(10);
+  }
+  ASSERT_EQ(statistics.GetPercentile(100.0f), 10);
+}
+}  // namespace mindspore
@@ -0,0 +1,153 @@
+/**
+ * Copyright 2022 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include <algorithm>
+#include "common/common_test.h"
+#include "src/kernel_exec.h"
+#include "src/kernel_registry.h"
+#include "src/lite_kernel.h"
+#include "src/sub_graph_kernel.h"
+#include "src/runtime/pass/elementwise_fusion_pass.h"
+#include "src/runtime/kernel/cpu/fp32/elementwise_chain_fp32.h"
+#include "nnacl/arithmetic.h"
+#include "nnacl/activation_parameter.h"
+
+namespace mindspore {
+class ElementwiseFusionPass : public mindspore::CommonTest {
+ public:
+  ElementwiseFusionPass() = default;
+};
+
+namespace {
+constexpr int kDataNum = 1000;
+
+kernel::KernelExec *CreateArithmetic(schema::PrimitiveType type, lite::Tensor *in0, lite::Tensor *in1,
+                                     lite::Tensor *out, lite::InnerContext *ctx) {
+  auto param = reinterpret_cast<ArithmeticParameter *>(malloc(sizeof(ArithmeticParameter)));
+  (void)memset(param, 0, sizeof(ArithmeticParameter));
+  param->op_parameter_.type_ = type;
+  param->op_parameter_.thread_num_ = ctx->thread_num_;
+  param->activation_type_ = ActType_No;
+  kernel::KernelKey desc{kernel::kCPU, kNumberTypeFloat32, NHWC, type};
+  kernel::KernelExec *kernel = nullptr;
+  (void)lite::KernelRegistry::GetInstance()->GetKernelExec({in0, in1}, {out}, ctx, nullptr, desc,
+                                                           reinterpret_cast<OpParameter *>(param), &kernel, nullptr);
+  return kernel;
+}
+
+kernel::KernelExec *CreateRelu6(lite::Tensor *in, lite::Tensor *out, lite::InnerContext *ctx) {
+  auto param = reinterpret_cast<ActivationParameter *>(malloc(sizeof(ActivationParameter)));
+  (void)memset(param, 0, sizeof(ActivationParameter));
+  param->op_parameter_.type_ = schema::PrimitiveType_Activation;
+  param->op_parameter_.thread_num_ = ctx->thread_num_;
+  param->type_ = schema::ActivationType_RELU6;
+  param->min_val_ = 0.0f;
+  param->max_val_ = 6.0f;
+  kernel::KernelKey desc{kernel::kCPU, kNumberTypeFloat32, NHWC, schema::PrimitiveType_Activation};
+  kernel::KernelExec *kernel = nullptr;
+  (void)lite::KernelRegistry::GetInstance()->GetKernelExec({in}, {out}, ctx, nullptr, desc,
+                                                           reinterpret_cast<OpParameter *>(param), &kernel, nullptr);
+  return kernel;
+}
+
+void Link(kernel::KernelExec *from, kernel::KernelExec *to) {
+  from->AddOutKernel(to);
+  to->AddInKernel(from);
+}
+}  // namespace
+
+// y = relu6(bias - x * scale), the three kernels are fused into one and evaluated by tile.
+TEST_F(ElementwiseFusionPass, FuseMulSubRelu6) {
+  lite::InnerContext ctx;
+  ctx.thread_num_ = 2;
+  ASSERT_EQ(lite::RET_OK, ctx.Init());
+
+  std::vector<int> shape = {1, 10, 10, 10};
+  lite::Tensor x(kNumberTypeFloat32, shape, NHWC);
+  lite::Tensor scale(kNumberTypeFloat32, {1}, NHWC, lite::Category::CONST_SCALAR);
+  lite::Tensor bias(kNumberTypeFloat32, shape, NHWC, lite::Category::CONST_TENSOR);
+  lite::Tensor mul_out(kNumberTypeFloat32, shape, NHWC);
+  lite::Tensor sub_out(kNumberTypeFloat32, shape, NHWC);
+  lite::Tensor y(kNumberTypeFloat32, shape, NHWC);
+  ASSERT_EQ(lite::RET_OK, x.MallocData());
+  ASSERT_EQ(lite::RET_OK, scale.MallocData());
+  ASSERT_EQ(lite::RET_OK, bias.MallocData());
+  auto x_data = reinterpret_cast<float *>(x.data());
+  auto bias_data = reinterpret_cast<float *>(bias.data());
+  reinterpret_cast<float *>(scale.data())[0] = 0.5f;
+  for (int i = 0; i < kDataNum; ++i) {
+    x_data[i] = static_cast<float>(i % 37) - 18.0f;
+    bias_data[i] = static_cast<float>(i % 11) * 0.5f;
+  }
+
+  auto mul = CreateArithmetic(schema::PrimitiveType_MulFusion, &x, &scale, &mul_out, &ctx);
+  auto sub = CreateArithmetic(schema::PrimitiveType_SubFusion, &bias, &mul_out, &sub_out, &ctx);
+  auto relu6 = CreateRelu6(&sub_out, &y, &ctx);
+  ASSERT_NE(mul, nullptr);
+  ASSERT_NE(sub, nullptr);
+  ASSERT_NE(relu6, nullptr);
+  Link(mul, sub);
+  Link(sub, relu6);
+
+  std::vector<kernel::KernelExec *> nodes = {mul, sub, relu6};
+  auto lite_kernel = new kernel::LiteKernel(nullptr, {&x}, {&y}, &ctx);
+  auto subgraph = new kernel::CpuFp32SubGraph({mul}, {relu6}, nodes, lite_kernel);
+  std::vector<kernel::KernelExec *> subgraphs = {subgraph};
+  ASSERT_EQ(lite::RET_OK, lite::pass::ElementwiseFusionPass(&subgraphs));
+  ASSERT_EQ(subgraph->nodes().size(), 1);
+  auto fused = subgraph->nodes().front();
+  ASSERT_EQ(fused->type(), static_cast<schema::PrimitiveType>(PrimType_Inner_ElementwiseChain));
+
+  ASSERT_EQ(lite::RET_OK, fused->Prepare());
+  ASSERT_EQ(lite::RET_OK, y.MallocData());
+  ASSERT_EQ(lite::RET_OK, fused->Execute());
+  auto y_data = reinterpret_cast<float *>(y.data());
+  for (int i = 0; i < kDataNum; ++i) {
+    auto expect = std::min(std::max(bias_data[i] - x_data[i] * 0.5f, 0.0f), 6.0f);
+    ASSERT_NEAR(y_data[i], expect, 1e-5);
+  }
+  // The intermediate tensors of the chain are never allocated.
+  ASSERT_EQ(mul_out.data(), nullptr);
+  ASSERT_EQ(sub_out.data(), nullptr);
+  delete subgraph;
+}
+
+// The operand needing broadcast breaks the chain.
+TEST_F(ElementwiseFusionPass, BroadcastNotFused) {
+  lite::InnerContext ctx;
+  ctx.thread_num_ = 1;
+  ASSERT_EQ(lite::RET_OK, ctx.Init());
+
+  lite::Tensor x(kNumberTypeFloat32, {1, 4, 4, 8}, NHWC);
+  lite::Tensor channel(kNumberTypeFloat32, {8}, NHWC, lite::Category::CONST_TENSOR);
+  lite::Tensor add_out(kNumberTypeFloat32, {1, 4, 4, 8}, NHWC);
+  lite::Tensor y(kNumberTypeFloat32, {1, 4, 4, 8}, NHWC);
+  auto add = CreateArithmetic(schema::PrimitiveType_AddFusion, &x, &channel, &add_out, &ctx);
+  auto relu6 = CreateRelu6(&add_out, &y, &ctx);
+  ASSERT_NE(add, nullptr);
+  ASSERT_NE(relu6, nullptr);
+  ASSERT_FALSE(kernel::ElementwiseChainCPUKernel::IsSupported(add));
+  ASSERT_TRUE(kernel::ElementwiseChainCPUKernel::IsSupported(relu6));
+  Link(add, relu6);
+
+  std::vector<kernel::KernelExec *> nodes = {add, relu6};
+  auto lite_kernel = new kernel::LiteKernel(nullptr, {&x}, {&y}, &ctx);
+  auto subgraph = new kernel::CpuFp32SubGraph({add}, {relu6}, nodes, lite_kernel);
+  std::vector<kernel::KernelExec *> subgraphs = {subgraph};
+  ASSERT_EQ(lite::RET_OK, lite::pass::ElementwiseFusionPass(&subgraphs));
+  ASSERT_EQ(subgraph->nodes().size(), 2);
+  delete subgraph;
+}
+}  // namespace mindspore
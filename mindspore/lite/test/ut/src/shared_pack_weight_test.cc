@@ -0,0 +1,96 @@
+/**
+ * Copyright 2022 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <cstdio>
+#include <map>
+#include <string>
+#include <vector>
+#include "common/common_test.h"
+#include "src/shared_pack_weight.h"
+
+namespace mindspore {
+class SharedPackWeightTest : public mindspore::CommonTest {
+ public:
+  SharedPackWeightTest() {}
+};
+
+TEST_F(SharedPackWeightTest, TestShareAcrossSessions) {
+  const std::string model_buf = "shared pack weight model";
+  auto file_path = lite::SharedPackWeight::GetFilePath(".", model_buf.data(), model_buf.size(), "thread2");
+  (void)remove(file_path.c_str());
+  const size_t tensor_index = 3;
+  const size_t pack_size = 16 * sizeof(float);
+  std::vector<float> origin_data(8, 1.0f);
+  std::vector<float> pack_data(16, 2.0f);
+
+  // the first session packs the weight itself and writes it to the file.
+  lite::SharedPackWeight writer;
+  int first_model = 0;
+  ASSERT_EQ(writer.Init(&first_model, file_path, {{origin_data.data(), tensor_index}}), lite::RET_OK);
+  ASSERT_EQ(writer.GetPackData(origin_data.data(), pack_size, "conv1"), nullptr);
+  writer.RecordPackData(origin_data.data(), pack_size, "conv1", pack_data.data());
+  writer.SetPacked(pack_data.data());
+  ASSERT_EQ(writer.Finish(&first_model, true), lite::RET_OK);
+
+  // the later session, which may be in the other process, maps the packed weight of the same tensor index.
+  lite::SharedPackWeight reader;
+  int second_model = 0;
+  std::vector<float> other_origin_data(8, 1.0f);
+  ASSERT_EQ(reader.Init(&second_model, file_path, {{other_origin_data.data(), tensor_index}}), lite::RET_OK);
+  auto shared_data = static_cast<float *>(reader.GetPackData(other_origin_data.data(), pack_size, "conv1"));
+  ASSERT_NE(shared_data, nullptr);
+  ASSERT_TRUE(reader.IsSharedData(shared_data));
+  ASSERT_EQ(std::vector<float>(shared_data, shared_data + pack_data.size()), pack_data);
+  // the packed weight of different size is packed by the other kernel layout.
+  ASSERT_EQ(reader.GetPackData(other_origin_data.data(), pack_size * 2, "conv1"), nullptr);
+  // the other kernel consuming the same tensor with the same packed size may pack it in the other layout.
+  ASSERT_EQ(reader.GetPackData(other_origin_data.data(), pack_size, "matmul1"), nullptr);
+  ASSERT_EQ(reader.Finish(&second_model, true), lite::RET_OK);
+  ASSERT_EQ(reader.GetPackData(other_origin_data.data(), pack_size, "conv1"), nullptr);
+  ASSERT_FALSE(reader.IsSharedData(pack_data.data()));
+  (void)remove(file_path.c_str());
+}
+
+TEST_F(SharedPackWeightTest, TestSkipUnpackedRecord) {
+  const std::string model_buf = "unpacked weight model";
+  auto file_path = lite::SharedPackWeight::GetFilePath(".", model_buf.data(), model_buf.size(), "thread2");
+  (void)remove(file_path.c_str());
+  const size_t tensor_index = 1;
+  const size_t pack_size = 16 * sizeof(float);
+  std::vector<float> origin_data(8, 1.0f);
+  std::vector<float> packed_data(16, 2.0f);
+  std::vector<float> unpacked_data(16, 0.0f);
+
+  // the weight packed lazily at runtime is recorded when it's allocated, but never packed before the session ends.
+  lite::SharedPackWeight writer;
+  int first_model = 0;
+  ASSERT_EQ(writer.Init(&first_model, file_path, {{origin_data.data(), tensor_index}}), lite::RET_OK);
+  writer.RecordPackData(origin_data.data(), pack_size, "conv1", packed_data.data());
+  writer.SetPacked(packed_data.data());
+  writer.RecordPackData(origin_data.data(), pack_size, "conv2", unpacked_data.data());
+  ASSERT_EQ(writer.Finish(&first_model, true), lite::RET_OK);
+
+  lite::SharedPackWeight reader;
+  int second_model = 0;
+  ASSERT_EQ(reader.Init(&second_model, file_path, {{origin_data.data(), tensor_index}}), lite::RET_OK);
+  auto shared_data = static_cast<float *>(reader.GetPackData(origin_data.data(), pack_size, "conv1"));
+  ASSERT_NE(shared_data, nullptr);
+  ASSERT_EQ(std::vector<float>(shared_data, shared_data + packed_data.size()), packed_data);
+  ASSERT_EQ(reader.GetPackData(origin_data.data(), pack_size, "conv2"), nullptr);
+  ASSERT_EQ(reader.Finish(&second_model, true), lite::RET_OK);
+  (void)remove(file_path.c_str());
+}
+}  // namespace mindspore
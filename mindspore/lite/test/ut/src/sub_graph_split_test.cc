@@ -0,0 +1,135 @@
+/**
+ * Copyright 2022 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include <map>
+#include <memory>
+#include <vector>
+#include "common/common_test.h"
+#include "schema/inner/model_generated.h"
+#include "ir/dtype/type_id.h"
+#include "include/version.h"
+#include "src/inner_context.h"
+#include "src/tensor.h"
+#define private public
+#include "src/sub_graph_split.h"
+#undef private
+
+namespace mindspore {
+namespace {
+constexpr int kRowNum = 64;
+constexpr int kDepth = 256;
+constexpr int kColNum = 64;
+
+std::unique_ptr<schema::TensorT> CreateTensorT(const std::vector<int> &dims) {
+  auto tensor = std::make_unique<schema::TensorT>();
+  tensor->nodeType = lite::NodeType_Parameter;
+  tensor->format = schema::Format_NHWC;
+  tensor->dataType = TypeId::kNumberTypeFloat32;
+  tensor->dims = dims;
+  tensor->offset = -1;
+  return tensor;
+}
+}  // namespace
+
+class SubGraphSplitTest : public mindspore::CommonTest {
+ public:
+  SubGraphSplitTest() {}
+
+  // two branches on the same input: a heavy matmul and a light element-wise mul.
+  void SetUp() override {
+    auto meta_graph = std::make_shared<schema::MetaGraphT>();
+    meta_graph->name = "graph";
+    meta_graph->version = lite::Version();
+
+    auto matmul = std::make_unique<schema::CNodeT>();
+    matmul->inputIndex = {0, 1};
+    matmul->outputIndex = {2};
+    matmul->primitive = std::make_unique<schema::PrimitiveT>();
+    matmul->primitive->value.type = schema::PrimitiveType_MatMulFusion;
+    matmul->primitive->value.value = new schema::MatMulFusionT;
+    matmul->name = "matmul";
+
+    auto mul = std::make_unique<schema::CNodeT>();
+    mul->inputIndex = {0, 3};
+    mul->outputIndex = {4};
+    mul->primitive = std::make_unique<schema::PrimitiveT>();
+    mul->primitive->value.type = schema::PrimitiveType_MulFusion;
+    mul->primitive->value.value = new schema::MulFusionT;
+    mul->name = "mul";
+
+    std::vector<std::vector<int>> shapes = {
+      {kRowNum, kDepth}, {kDepth, kColNum}, {kRowNum, kColNum}, {kRowNum, kDepth}, {kRowNum, kDepth}};
+    for (auto &shape : shapes) {
+      meta_graph->allTensors.emplace_back(CreateTensorT(shape));
+      tensors_.push_back(new lite::Tensor(TypeId::kNumberTypeFloat32, shape));
+    }
+    meta_graph->nodes.emplace_back(std::move(matmul));
+    meta_graph->nodes.emplace_back(std::move(mul));
+    meta_graph->inputIndex = {0};
+    meta_graph->outputIndex = {2, 4};
+
+    flatbuffers::FlatBufferBuilder builder(1024);
+    auto offset = schema::MetaGraph::Pack(builder, meta_graph.get());
+    builder.Finish(offset);
+    schema::FinishMetaGraphBuffer(builder, offset);
+    model_ = lite::Model::Import(reinterpret_cast<char *>(builder.GetBufferPointer()), builder.GetSize());
+    ASSERT_NE(model_, nullptr);
+    context_.thread_num_ = kThreadNum;
+    output_nodes_ = {0, 1};
+  }
+
+  void TearDown() override {
+    for (auto tensor : tensors_) {
+      delete tensor;
+    }
+    tensors_.clear();
+    delete model_;
+    model_ = nullptr;
+  }
+
+ protected:
+  static constexpr int kThreadNum = 4;
+  lite::InnerContext context_;
+  lite::Model *model_ = nullptr;
+  std::vector<lite::Tensor *> tensors_;
+  std::map<int, OpParameter *> op_parameters_;
+  std::vector<size_t> output_nodes_;
+};
+
+TEST_F(SubGraphSplitTest, TestNodeCostInSameUnit) {
+  lite::SearchSubGraph search_sub_graph(&context_, model_, &tensors_, &op_parameters_, &output_nodes_);
+  // one multiply-accumulate of matmul counts as one multiplication of the element-wise mul.
+  ASSERT_EQ(search_sub_graph.CalculateNodeCost(0), static_cast<size_t>(kRowNum * kColNum * kDepth));
+  ASSERT_EQ(search_sub_graph.CalculateNodeCost(1), static_cast<size_t>(kRowNum * kDepth) + 1);
+}
+
+TEST_F(SubGraphSplitTest, TestBalanceSubGraphThread) {
+  lite::SearchSubGraph search_sub_graph(&context_, model_, &tensors_, &op_parameters_, &output_nodes_);
+  std::vector<lite::SearchSubGraph::Subgraph> sub_graphs(2);
+  sub_graphs[0].nodes_ = {1};
+  sub_graphs[1].nodes_ = {0};
+  search_sub_graph.BalanceSubGraphThread(&sub_graphs);
+  // the heaviest subgraph gets all the threads, and the light one gets at least one.
+  ASSERT_EQ(sub_graphs[1].thread_, static_cast<size_t>(kThreadNum));
+  ASSERT_EQ(sub_graphs[0].thread_, static_cast<size_t>(1));
+  ASSERT_GT(sub_graphs[1].cost_.mul_cost_, sub_graphs[0].cost_.mul_cost_);
+
+  // the subgraphs of the same cost share the threads equally.
+  sub_graphs[0].nodes_ = {0};
+  search_sub_graph.BalanceSubGraphThread(&sub_graphs);
+  ASSERT_EQ(sub_graphs[0].thread_, static_cast<size_t>(kThreadNum));
+  ASSERT_EQ(sub_graphs[1].thread_, static_cast<size_t>(kThreadNum));
+}
+}  // namespace mindspore
@@ -0,0 +1,114 @@
+/**
+ * Copyright 2022 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <cstdio>
+#include <fstream>
+#include <map>
+#include <memory>
+#include <string>
+#include "common/common_test.h"
+#include "include/errorcode.h"
+#include "src/thread_cost_model.h"
+#include "thread/threadpool.h"
+
+namespace mindspore {
+class ThreadCostModelTest : public mindspore::CommonTest {
+ public:
+  ThreadCostModelTest() {}
+
+  // the costs are set only once in the process, every test starts with the uncalibrated costs.
+  void SetUp() override {
+    load_cost_ = lite::ThreadCostModel::per_unit_load_cost_;
+    store_cost_ = lite::ThreadCostModel::per_unit_store_cost_;
+    startup_cost_ = lite::ThreadCostModel::thread_startup_cost_;
+    single_cost_ = lite::ThreadCostModel::single_thread_cost_;
+    parallel_cost_ = lite::ThreadCostModel::parallel_thread_cost_;
+    kernel_costs_ = lite::ThreadCostModel::kernel_compute_cost_map_;
+    lite::ThreadCostModel::calibrated_ = false;
+  }
+
+  void TearDown() override {
+    lite::ThreadCostModel::per_unit_load_cost_ = load_cost_;
+    lite::ThreadCostModel::per_unit_store_cost_ = store_cost_;
+    lite::ThreadCostModel::thread_startup_cost_ = startup_cost_;
+    lite::ThreadCostModel::single_thread_cost_ = single_cost_;
+    lite::ThreadCostModel::parallel_thread_cost_ = parallel_cost_;
+    lite::ThreadCostModel::kernel_compute_cost_map_ = kernel_costs_;
+    lite::ThreadCostModel::calibrated_ = false;
+  }
+
+ private:
+  float load_cost_ = 0.0f;
+  float store_cost_ = 0.0f;
+  float startup_cost_ = 0.0f;
+  float single_cost_ = 0.0f;
+  float parallel_cost_ = 0.0f;
+  std::map<int32_t, float> kernel_costs_;
+};
+
+TEST_F(ThreadCostModelTest, TestSaveAndLoadProfile) {
+  const std::string profile_path = "./thread_cost_model_test.profile";
+  auto load_cost = lite::ThreadCostModel::per_unit_load_cost_;
+  auto parallel_cost = lite::ThreadCostModel::parallel_thread_cost_;
+  ASSERT_EQ(lite::ThreadCostModel::SaveProfile(profile_path), lite::RET_OK);
+  lite::ThreadCostModel::per_unit_load_cost_ = load_cost * 2;
+  lite::ThreadCostModel::parallel_thread_cost_ = parallel_cost * 2;
+  ASSERT_EQ(lite::ThreadCostModel::LoadProfile(profile_path), lite::RET_OK);
+  ASSERT_FLOAT_EQ(lite::ThreadCostModel::per_unit_load_cost_, load_cost);
+  ASSERT_FLOAT_EQ(lite::ThreadCostModel::parallel_thread_cost_, parallel_cost);
+  ASSERT_TRUE(lite::ThreadCostModel::IsCalibrated());
+
+  // the profile with the invalid cost is rejected and the costs keep unchanged.
+  std::ofstream invalid_profile(profile_path, std::ios::out | std::ios::trunc);
+  invalid_profile << "per_unit_load_cost -1\n";
+  invalid_profile.close();
+  ASSERT_NE(lite::ThreadCostModel::LoadProfile(profile_path), lite::RET_OK);
+  ASSERT_FLOAT_EQ(lite::ThreadCostModel::per_unit_load_cost_, load_cost);
+  (void)remove(profile_path.c_str());
+  ASSERT_NE(lite::ThreadCostModel::LoadProfile("./thread_cost_model_test_not_exist.profile"), lite::RET_OK);
+}
+
+TEST_F(ThreadCostModelTest, TestCalibrateChangesOptimalThreadNum) {
+  // a parallel cost far above any host makes the whole task one block before the calibration.
+  lite::ThreadCostModel::parallel_thread_cost_ = 1.0e12f;
+  lite::ThreadCostContext thread_cost_context = {100000000, 1, 1, 100.0f};
+  const int thread_num = 4;
+  ASSERT_EQ(lite::ThreadCostModel::GetOptimalThreadNum(&thread_cost_context, thread_num), 1);
+
+  std::unique_ptr<ThreadPool> pool(ThreadPool::CreateThreadPool(thread_num));
+  ASSERT_NE(pool, nullptr);
+  // the thread pool has no more threads than the cores, the parallel launch can't be timed on a single core.
+  if (pool->thread_num() <= 1) {
+    return;
+  }
+  ASSERT_EQ(lite::ThreadCostModel::Calibrate(pool.get()), lite::RET_OK);
+  ASSERT_TRUE(lite::ThreadCostModel::IsCalibrated());
+  ASSERT_LT(lite::ThreadCostModel::parallel_thread_cost_, 1.0e12f);
+  ASSERT_GT(lite::ThreadCostModel::GetOptimalThreadNum(&thread_cost_context, thread_num), 1);
+
+  // the calibrated costs are immutable, neither the second calibration nor a profile changes them.
+  auto parallel_cost = lite::ThreadCostModel::parallel_thread_cost_;
+  ASSERT_EQ(lite::ThreadCostModel::Calibrate(pool.get()), lite::RET_OK);
+  ASSERT_FLOAT_EQ(lite::ThreadCostModel::parallel_thread_cost_, parallel_cost);
+  const std::string profile_path = "./thread_cost_model_calibrate_test.profile";
+  lite::ThreadCostModel::parallel_thread_cost_ = parallel_cost * 2;
+  ASSERT_EQ(lite::ThreadCostModel::SaveProfile(profile_path), lite::RET_OK);
+  lite::ThreadCostModel::parallel_thread_cost_ = parallel_cost;
+  ASSERT_EQ(lite::ThreadCostModel::LoadProfile(profile_path), lite::RET_OK);
+  ASSERT_FLOAT_EQ(lite::ThreadCostModel::parallel_thread_cost_, parallel_cost);
+  (void)remove(profile_path.c_str());
+}
+}  // namespace mindspore
@@ -401,6 +401,7 @@ int BenchmarkBase::Init() {
   MS_LOG(INFO) << "EnableParallel = " << this->flags_->enable_parallel_;
   MS_LOG(INFO) << "calibDataPath = " << this->flags_->benchmark_data_file_;
   MS_LOG(INFO) << "EnableGLTexture = " << this->flags_->enable_gl_texture_;
+  MS_LOG(INFO) << "EnableMmap = " << this->flags_->enable_mmap_;
 
   std::cout << "ModelPath = " << this->flags_->model_file_ << std::endl;
   std::cout << "ModelType = " << this->flags_->model_type_ << std::endl;
@@ -418,6 +419,7 @@ int BenchmarkBase::Init() {
   std::cout << "EnableParallel = " << this->flags_->enable_parallel_ << std::endl;
   std::cout << "calibDataPath = " << this->flags_->benchmark_data_file_ << std::endl;
   std::cout << "EnableGLTexture = " << this->flags_->enable_gl_texture_ << std::endl;
+  std::cout << "EnableMmap = " << this->flags_->enable_mmap_ << std::endl;
   if (this->flags_->loop_count_ < 1) {
     MS_LOG(ERROR) << "LoopCount:" << this->flags_->loop_count_ << " must be greater than 0";
     std::cerr << "LoopCount:" << this->flags_->loop_count_ << " must be greater than 0" << std::endl;
@@ -562,6 +564,36 @@ int BenchmarkBase::PrintResult(const std::vector<std::string> &title,
   return RET_OK;
 }
 
+void BenchmarkBase::PrintMemoryUsage(const std::string &stage) {
+#if defined(__linux__) || defined(__ANDROID__)
+  std::ifstream status_file("/proc/self/status");
+  if (!status_file.is_open()) {
+    MS_LOG(WARNING) << "Open /proc/self/status failed.";
+    return;
+  }
+  std::string rss = "unknown";
+  std::string peak_rss = "unknown";
+  std::string line;
+  while (std::getline(status_file, line)) {
+    // the lines are like "VmRSS:     1024 kB"
+    auto pos = line.find(':');
+    auto value_pos = line.find_first_not_of(" \t", pos + 1);
+    if (pos == std::string::npos || value_pos == std::string::npos) {
+      continue;
+    }
+    auto key = line.substr(0, pos);
+    auto value = line.substr(value_pos);
+    if (key == "VmRSS") {
+      rss = value;
+    } else if (key == "VmHWM") {
+      peak_rss = value;
+    }
+  }
+  MS_LOG(INFO) << stage << " RSS = " << rss << ", PeakRSS = " << peak_rss;
+  std::cout << stage << " RSS = " << rss << ", PeakRSS = " << peak_rss << std::endl;
+#endif
+}
+
 #ifdef ENABLE_ARM64
 int BenchmarkBase::PrintPerfResult(const std::vector<std::string> &title,
                                    const std::map<std::string, std::pair<int, struct PerfCount>> &result) {
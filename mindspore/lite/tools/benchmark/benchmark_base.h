@@ -150,9 +150,14 @@ class MS_API BenchmarkFlags : public virtual FlagParser {
     AddFlag(&BenchmarkFlags::parallel_num_, "parallelNum", "parallel num of parallel predict", 2);
     AddFlag(&BenchmarkFlags::parallel_task_num_, "parallelTaskNum", "parallel task num of parallel predict", 2);
     AddFlag(&BenchmarkFlags::workers_num_, "workersNum", "works num of parallel predict", 2);
+    AddFlag(&BenchmarkFlags::max_batch_size_, "maxBatchSize",
+            "max batch size of the dynamic batching in parallel predict, disabled if not greater than 1", 0);
+    AddFlag(&BenchmarkFlags::max_batch_delay_us_, "maxBatchDelayUs",
+            "max delay in microseconds of the dynamic batching in parallel predict", 1000);
     AddFlag(&BenchmarkFlags::inter_op_parallel_num_, "interOpParallelNum", "parallel number of operators in predict",
             1);
     AddFlag(&BenchmarkFlags::enable_gl_texture_, "enableGLTexture", "Enable GlTexture2D", false);
+    AddFlag(&BenchmarkFlags::enable_mmap_, "enableMmap", "Load the model file by mmap : true | false", false);
   }
 
   ~BenchmarkFlags() override = default;
@@ -168,6 +173,8 @@ class MS_API BenchmarkFlags : public virtual FlagParser {
   int parallel_task_num_ = 2;
   int inter_op_parallel_num_ = 1;
   int workers_num_ = 2;
+  int max_batch_size_ = 0;
+  int max_batch_delay_us_ = 1000;
   std::string model_file_;
   std::string in_data_file_;
   std::string config_file_;
@@ -181,6 +188,7 @@ class MS_API BenchmarkFlags : public virtual FlagParser {
   int num_threads_ = 2;
   bool enable_fp16_ = false;
   bool enable_gl_texture_ = false;
+  bool enable_mmap_ = false;
   bool enable_parallel_ = false;
   int warm_up_loop_count_ = 3;
   // MarkAccuracy
@@ -246,6 +254,9 @@ class MS_API BenchmarkBase {
 
   int PrintResult(const std::vector<std::string> &title, const std::map<std::string, std::pair<int, float>> &result);
 
+  // print the resident memory of the process after the stage, only supported on linux.
+  void PrintMemoryUsage(const std::string &stage);
+
 #ifdef ENABLE_ARM64
   int PrintPerfResult(const std::vector<std::string> &title,
                       const std::map<std::string, std::pair<int, struct PerfCount>> &result);
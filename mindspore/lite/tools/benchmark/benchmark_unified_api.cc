@@ -280,6 +280,9 @@ void BenchmarkUnifiedApi::UpdateConfigInfo() {
 #define WIPE_DEEP_CONFIG_VOCAB_SIZE "100"
 #define WIPE_DEEP_CONFIG_DEVICE_CACHE_SIZE "40"
 
+  if (flags_->enable_mmap_) {
+    ms_model_.UpdateConfig(kModelLoadSection, std::make_pair(kEnableMmapKey, "true"));
+  }
   auto env = std::getenv("BENCHMARK_UPDATE_CONFIG_ENV");
   if (env == nullptr) {
     return;
@@ -964,6 +967,8 @@ int BenchmarkUnifiedApi::ParallelInference(std::shared_ptr<mindspore::Context> c
   auto runner_config = std::make_shared<RunnerConfig>();
   runner_config->context = context;
   runner_config->workers_num = flags_->workers_num_;
+  runner_config->max_batch_size = flags_->max_batch_size_;
+  runner_config->max_batch_delay_us = flags_->max_batch_delay_us_;
   auto model_init_start = GetTimeUs();
   auto ret = model_runner_.Init(flags_->model_file_, runner_config);
   MS_CHECK_FALSE_MSG(ret != kSuccess, RET_ERROR, "model pool init failed.");
@@ -1097,11 +1102,16 @@ int BenchmarkUnifiedApi::RunBenchmark() {
   }
 #endif
 
+  auto start_build_time = GetTimeUs();
   status = CompileGraph(model_type, context, model_name);
   if (status != RET_OK) {
     MS_LOG(ERROR) << "Compile graph failed.";
     return status;
   }
+  auto end_build_time = GetTimeUs();
+  MS_LOG(INFO) << "ModelBuildTime = " << ((end_build_time - start_build_time) / kFloatMSEC) << " ms";
+  std::cout << "ModelBuildTime = " << ((end_build_time - start_build_time) / kFloatMSEC) << " ms" << std::endl;
+  PrintMemoryUsage("ModelBuild");
   if (!flags_->resize_dims_.empty()) {
     std::vector<std::vector<int64_t>> resize_dims;
     (void)std::transform(flags_->resize_dims_.begin(), flags_->resize_dims_.end(), std::back_inserter(resize_dims),
@@ -1143,6 +1153,7 @@ int BenchmarkUnifiedApi::RunBenchmark() {
       return status;
     }
   }
+  PrintMemoryUsage("ModelRun");
   if (flags_->dump_tensor_data_) {
     std::cout << "Dumped file is saved to : " + dump_file_output_dir_ << std::endl;
   }
@@ -42,12 +42,19 @@ __all__ = ['set_sending_batches', 'load', '_init_device_info',
            'set_enable_shared_mem', 'get_enable_shared_mem',
            'set_enable_autotune', 'get_enable_autotune',
            'set_autotune_interval', 'get_autotune_interval',
+           'set_enable_autotune_model', 'get_enable_autotune_model',
            'set_auto_offload', 'get_auto_offload',
            'set_enable_watchdog', 'get_enable_watchdog',
-           'set_multiprocessing_timeout_interval', 'get_multiprocessing_timeout_interval']
+           'set_multiprocessing_timeout_interval', 'get_multiprocessing_timeout_interval',
+           'set_enable_tf_reader_mmap', 'get_enable_tf_reader_mmap',
+           'set_tf_reader_verify_crc', 'get_tf_reader_verify_crc',
+           'set_enable_lock_free_queue', 'get_enable_lock_free_queue',
+           'set_enable_mindrecord_index_snapshot', 'get_enable_mindrecord_index_snapshot',
+           'set_row_batch_size', 'get_row_batch_size']
 
 INT32_MAX = 2147483647
 UINT32_MAX = 4294967295
+MAX_ROW_BATCH_SIZE = 4096
 
 _config = cde.GlobalContext.config_manager()
 
@@ -602,6 +609,43 @@ def get_autotune_interval():
     return _config.get_autotune_interval()
 
 
+def set_enable_autotune_model(enable):
+    """
+    Set whether AutoTune uses a throughput model. If enabled, AutoTune estimates the CPU time each operation spends
+    on a batch from the profiling data, and solves the number of workers and the prefetch size of all the operations
+    at once under the CPU and memory budget of the machine, instead of adjusting one operation per interval.
+    The configuration is solved again when the measured costs drift away from the model.
+
+    Args:
+        enable (bool): Whether to use the AutoTune throughput model. System default: False.
+
+    Raises:
+        TypeError: If `enable` is not a boolean data type.
+
+    Examples:
+        >>> # Let AutoTune solve the configuration from the throughput model.
+        >>> ds.config.set_enable_autotune(True)
+        >>> ds.config.set_enable_autotune_model(True)
+    """
+    if not isinstance(enable, bool):
+        raise TypeError("enable must be of type bool.")
+    _config.set_enable_autotune_model(enable)
+
+
+def get_enable_autotune_model():
+    """
+    Get whether AutoTune uses a throughput model.
+
+    Returns:
+        bool, whether AutoTune solves the configuration from the throughput model.
+
+    Examples:
+        >>> # Get the flag of the AutoTune throughput model.
+        >>> autotune_model_flag = ds.config.get_enable_autotune_model()
+    """
+    return _config.get_enable_autotune_model()
+
+
 def get_enable_shared_mem():
     """
     Get the default state of shared mem enabled variable.
@@ -783,3 +827,187 @@ def get_multiprocessing_timeout_interval():
         >>> multiprocessing_timeout_interval = ds.config.get_multiprocessing_timeout_interval()
     """
     return _config.get_multiprocessing_timeout_interval()
+
+
+def set_enable_tf_reader_mmap(enable):
+    """
+    Set the default state of TFRecordDataset memory mapped reading. If enabled, each TFRecord file is mapped into
+    memory and records are parsed directly from the mapped pages instead of being copied out of a file stream.
+
+    Note:
+        `set_enable_tf_reader_mmap` is not supported on Windows platform yet.
+
+    Args:
+        enable (bool): Whether to read TFRecord files through memory mapping. System default: False.
+
+    Raises:
+        TypeError: If `enable` is not a boolean data type.
+
+    Examples:
+        >>> # Read TFRecord files through memory mapping to reduce the copy and allocation cost of each record.
+        >>> ds.config.set_enable_tf_reader_mmap(True)
+    """
+    if not isinstance(enable, bool):
+        raise TypeError("enable must be of type bool.")
+    _config.set_enable_tf_reader_mmap(enable)
+
+
+def get_enable_tf_reader_mmap():
+    """
+    Get the default state of TFRecordDataset memory mapped reading.
+
+    Returns:
+        bool, the state of TFRecordDataset memory mapped reading.
+
+    Examples:
+        >>> # Get the flag of TFRecordDataset memory mapped reading.
+        >>> tf_reader_mmap_flag = ds.config.get_enable_tf_reader_mmap()
+    """
+    return _config.get_enable_tf_reader_mmap()
+
+
+def set_tf_reader_verify_crc(verify):
+    """
+    Set whether TFRecordDataset verifies the masked crc of every record when it reads through memory mapping.
+    It only takes effect when `set_enable_tf_reader_mmap` is True, skipping the check saves a pass over the data.
+
+    Args:
+        verify (bool): Whether to verify the crc of each record. System default: False.
+
+    Raises:
+        TypeError: If `verify` is not a boolean data type.
+
+    Examples:
+        >>> # Verify the crc of each record read by the memory mapped TFRecord reader.
+        >>> ds.config.set_tf_reader_verify_crc(True)
+    """
+    if not isinstance(verify, bool):
+        raise TypeError("verify must be of type bool.")
+    _config.set_tf_reader_verify_crc(verify)
+
+
+def get_tf_reader_verify_crc():
+    """
+    Get whether TFRecordDataset verifies the crc of every record when it reads through memory mapping.
+
+    Returns:
+        bool, whether the crc of each record is verified.
+
+    Examples:
+        >>> # Get the flag of TFRecordDataset crc verification.
+        >>> tf_reader_verify_crc = ds.config.get_tf_reader_verify_crc()
+    """
+    return _config.get_tf_reader_verify_crc()
+
+
+def set_enable_lock_free_queue(enable):
+    """
+    Set the default state of lock-free queues. If enabled, the connectors between dataset operations and the queues
+    between an operation and its workers are lock-free ring buffers, which reduces the locking and wake up overhead
+    of pipelines passing many small rows. It takes effect on the pipelines created afterwards.
+
+    Args:
+        enable (bool): Whether to use lock-free queues in the data pipeline. System default: False.
+
+    Raises:
+        TypeError: If `enable` is not a boolean data type.
+
+    Examples:
+        >>> # Use lock-free queues between the dataset operations.
+        >>> ds.config.set_enable_lock_free_queue(True)
+    """
+    if not isinstance(enable, bool):
+        raise TypeError("enable must be of type bool.")
+    _config.set_enable_lock_free_queue(enable)
+
+
+def get_enable_lock_free_queue():
+    """
+    Get the default state of lock-free queues.
+
+    Returns:
+        bool, whether the data pipeline uses lock-free queues.
+
+    Examples:
+        >>> # Get the flag of lock-free queues.
+        >>> lock_free_queue_flag = ds.config.get_enable_lock_free_queue()
+    """
+    return _config.get_enable_lock_free_queue()
+
+
+def set_enable_mindrecord_index_snapshot(enable):
+    """
+    Set the default state of MindRecord index snapshots. If enabled, MindDataset saves the index of each MindRecord
+    file into a snapshot file with the suffix `.idx` next to it the first time the file is read, and later pipelines
+    load the snapshot instead of querying the `.db` file, which shortens the start up of datasets with many files.
+    A snapshot is rebuilt when the size or the modification time of the MindRecord file or its `.db` file changes,
+    or when other columns are selected. Snapshots are only used when all the selected columns are index fields.
+
+    Args:
+        enable (bool): Whether to use MindRecord index snapshots. System default: False.
+
+    Raises:
+        TypeError: If `enable` is not a boolean data type.
+
+    Examples:
+        >>> # Save and reuse the index snapshot of the MindRecord files.
+        >>> ds.config.set_enable_mindrecord_index_snapshot(True)
+    """
+    if not isinstance(enable, bool):
+        raise TypeError("enable must be of type bool.")
+    _config.set_enable_mindrecord_index_snapshot(enable)
+
+
+def get_enable_mindrecord_index_snapshot():
+    """
+    Get the default state of MindRecord index snapshots.
+
+    Returns:
+        bool, whether MindDataset uses index snapshots.
+
+    Examples:
+        >>> # Get the flag of MindRecord index snapshots.
+        >>> index_snapshot_flag = ds.config.get_enable_mindrecord_index_snapshot()
+    """
+    return _config.get_enable_mindrecord_index_snapshot()
+
+
+def set_row_batch_size(size):
+    """
+    Set the number of rows handed over at once between dataset operations. Map, Filter and Batch operations then
+    pass their output rows to the next operation in batches of up to `size` rows instead of one by one, which cuts
+    the queue and locking overhead of pipelines with many small rows, such as text or tabular data. A batch is handed
+    over early when the next operation runs out of rows, so it never delays the pipeline. It takes effect on the
+    pipelines created afterwards.
+
+    Args:
+        size (int): The number of rows handed over at once, 0 or 1 hands them over one by one, at most 4096.
+            System default: 0.
+
+    Raises:
+        TypeError: If `size` is not of type int.
+        ValueError: If `size` < 0 or `size` > 4096.
+
+    Examples:
+        >>> # Hand over the rows of map operations 64 at a time.
+        >>> ds.config.set_row_batch_size(64)
+    """
+    if not isinstance(size, int) or isinstance(size, bool):
+        raise TypeError("size isn't of type int.")
+    if size < 0 or size > MAX_ROW_BATCH_SIZE:
+        raise ValueError("size is not within the required range [0, {}].".format(MAX_ROW_BATCH_SIZE))
+    _config.set_row_batch_size(size)
+
+
+def get_row_batch_size():
+    """
+    Get the number of rows handed over at once between dataset operations.
+
+    Returns:
+        int, the number of rows handed over at once, 0 or 1 if they are handed over one by one.
+
+    Examples:
+        >>> # Get the number of rows handed over at once.
+        >>> row_batch_size = ds.config.get_row_batch_size()
+    """
+    return _config.get_row_batch_size()
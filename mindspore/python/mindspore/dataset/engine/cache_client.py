@@ -34,11 +34,19 @@ class DatasetCache:
         size (int, optional): Size of the memory set aside for the row caching (default=0, which means unlimited,
             note that it might bring in the risk of running out of memory on the machine).
         spilling (bool, optional): Whether or not spilling to disk if out of memory (default=False).
-        hostname (str, optional): Host name (default=None, use default hostname '127.0.0.1').
+        hostname (str, optional): Host name (default=None, use default hostname '127.0.0.1'). A server on another
+            host is reached by tcp/ip only, the shared memory is used for the server on '127.0.0.1' only. The tcp/ip
+            connection is neither authenticated nor encrypted, so a cache server listening on an interface other than
+            the loopback should only be reachable from a trusted network.
         port (int, optional): Port to connect to server (default=None, use default port 50052).
         num_connections (int, optional): Number of tcp/ip connections (default=None, use default value 12).
         prefetch_size (int, optional): The size of the cache queue between operations
             (default=None, use default value 20).
+        servers (list[str], optional): Spread the cached rows over several cache servers, each given as
+            "host:port" (default=None, use the single server given by hostname and port). The rows are placed by a
+            consistent hash of the row id, so every pipeline sharing the cache must list the same servers. A server
+            which can no longer be reached is dropped and its rows are treated as cache misses. A cache over a
+            non-mappable dataset is kept whole on one of the servers.
 
     Examples:
             >>> import mindspore.dataset as ds
@@ -52,7 +60,7 @@ class DatasetCache:
     """
 
     def __init__(self, session_id, size=0, spilling=False, hostname=None, port=None, num_connections=None,
-                 prefetch_size=None):
+                 prefetch_size=None, servers=None):
         check_pos_uint32(session_id, "session_id")
         type_check(size, (int,), "size")
         if size != 0:
@@ -68,6 +76,19 @@ class DatasetCache:
             check_pos_int32(num_connections, "num_connections")
         if prefetch_size is not None:
             check_pos_int32(prefetch_size, "prefetch_size")
+        server_list = None
+        if servers is not None:
+            type_check(servers, (list,), "servers")
+            if not servers:
+                raise ValueError("servers should not be empty.")
+            server_list = []
+            for server in servers:
+                type_check(server, (str,), "server")
+                host, sep, server_port = server.rpartition(":")
+                if not sep or not host or not server_port.isdigit():
+                    raise ValueError("Server {} should be in the form of host:port.".format(server))
+                check_value(int(server_port), (1025, 65535), "port")
+                server_list.append((host, int(server_port)))
 
         self.session_id = session_id
         self.size = size
@@ -76,7 +97,9 @@ class DatasetCache:
         self.port = port
         self.prefetch_size = prefetch_size
         self.num_connections = num_connections
-        self.cache_client = CacheClient(session_id, size, spilling, hostname, port, num_connections, prefetch_size)
+        self.servers = servers
+        self.cache_client = CacheClient(session_id, size, spilling, hostname, port, num_connections, prefetch_size,
+                                        server_list)
 
     def get_stat(self):
         """Get the statistics from a cache."""
@@ -95,5 +118,6 @@ class DatasetCache:
         new_cache.port = copy.deepcopy(self.port, memodict)
         new_cache.prefetch_size = copy.deepcopy(self.prefetch_size, memodict)
         new_cache.num_connections = copy.deepcopy(self.num_connections, memodict)
+        new_cache.servers = copy.deepcopy(self.servers, memodict)
         new_cache.cache_client = self.cache_client
         return new_cache
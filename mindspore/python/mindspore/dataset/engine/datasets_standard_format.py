@@ -145,10 +145,17 @@ class MindDataset(MappableDataset, UnionBaseDataset):
             (default=None, all samples).
         cache (DatasetCache, optional): Use tensor caching service to speed up dataset processing.
             (default=None, which means no cache is used).
+        io_mode (str, optional): How the blobs are read when the dataset is accessed randomly, 'stream',
+            'thread_pool' or 'io_uring' (default=None, which means 'stream'). With 'thread_pool' and 'io_uring'
+            every worker keeps several reads in flight, which helps on devices with a high latency. 'io_uring'
+            falls back to 'thread_pool' if the kernel does not support it.
+        io_queue_depth (int, optional): Maximum number of blob reads in flight per worker when `io_mode` is
+            'thread_pool' or 'io_uring' (default=None, which means 32).
 
     Raises:
         ValueError: If dataset_files are not valid or do not exist.
         ValueError: If `num_parallel_workers` exceeds the max thread numbers.
+        ValueError: If `io_mode` is not one of 'stream', 'thread_pool' and 'io_uring'.
         RuntimeError: If `num_shards` is specified but `shard_id` is None.
         RuntimeError: If `shard_id` is specified but `num_shards` is None.
         ValueError: If `shard_id` is invalid (< 0 or >= `num_shards`).
@@ -189,12 +196,15 @@ class MindDataset(MappableDataset, UnionBaseDataset):
     """
 
     def parse(self, children=None):
-        return cde.MindDataNode(self.dataset_files, self.columns_list, self.sampler, self.new_padded_sample,
+        node = cde.MindDataNode(self.dataset_files, self.columns_list, self.sampler, self.new_padded_sample,
                                 self.num_padded, shuffle_to_shuffle_mode(self.shuffle_option))
+        node.set_io_mode(self.io_mode, self.io_queue_depth)
+        return node
 
     @check_minddataset
     def __init__(self, dataset_files, columns_list=None, num_parallel_workers=None, shuffle=None, num_shards=None,
-                 shard_id=None, sampler=None, padded_sample=None, num_padded=None, num_samples=None, cache=None):
+                 shard_id=None, sampler=None, padded_sample=None, num_padded=None, num_samples=None, cache=None,
+                 io_mode=None, io_queue_depth=None):
         super().__init__(num_parallel_workers=num_parallel_workers, sampler=sampler, num_samples=num_samples,
                          shuffle=shuffle_to_bool(shuffle), num_shards=num_shards, shard_id=shard_id, cache=cache)
         if num_samples and shuffle in (Shuffle.FILES, Shuffle.INFILE):
@@ -236,6 +246,10 @@ class MindDataset(MappableDataset, UnionBaseDataset):
                 else:
                     self.new_padded_sample[k] = v
 
+        io_modes = {'stream': 0, 'thread_pool': 1, 'io_uring': 2}
+        self.io_mode = io_modes[replace_none(io_mode, 'stream')]
+        self.io_queue_depth = replace_none(io_queue_depth, 32)
+
 
 class TFRecordDataset(SourceDataset, UnionBaseDataset):
     """
@@ -980,9 +980,11 @@ def check_minddataset(method):
     def new_method(self, *args, **kwargs):
         _, param_dict = parse_user_args(method, *args, **kwargs)
 
-        nreq_param_int = ['num_samples', 'num_parallel_workers', 'seed', 'num_shards', 'shard_id', 'num_padded']
+        nreq_param_int = ['num_samples', 'num_parallel_workers', 'seed', 'num_shards', 'shard_id', 'num_padded',
+                          'io_queue_depth']
         nreq_param_list = ['columns_list']
         nreq_param_dict = ['padded_sample']
+        nreq_param_str = ['io_mode']
 
         dataset_file = param_dict.get('dataset_files')
         if isinstance(dataset_file, list):
@@ -996,6 +998,14 @@ def check_minddataset(method):
         validate_dataset_param_value(nreq_param_int, param_dict, int)
         validate_dataset_param_value(nreq_param_list, param_dict, list)
         validate_dataset_param_value(nreq_param_dict, param_dict, dict)
+        validate_dataset_param_value(nreq_param_str, param_dict, str)
+
+        io_mode = param_dict.get('io_mode')
+        if io_mode is not None:
+            check_valid_str(io_mode, ['stream', 'thread_pool', 'io_uring'], "io_mode")
+        io_queue_depth = param_dict.get('io_queue_depth')
+        if io_queue_depth is not None:
+            check_value(io_queue_depth, [1, 1024], "io_queue_depth")
 
         check_sampler_shuffle_shard_options(param_dict)
 
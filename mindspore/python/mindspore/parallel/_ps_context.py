@@ -86,6 +86,8 @@ _set_ps_context_func_map = {
     "instance_name": ps_context().set_instance_name,
     "participation_time_level": ps_context().set_participation_time_level,
     "continuous_failure_times": ps_context().set_continuous_failure_times,
+    "cache_eviction_policy": ps_context().set_cache_eviction_policy,
+    "cache_admission_threshold": ps_context().set_cache_admission_threshold,
 }
 
 _get_ps_context_func_map = {
@@ -140,6 +142,8 @@ _get_ps_context_func_map = {
     "instance_name": ps_context().instance_name,
     "participation_time_level": ps_context().participation_time_level,
     "continuous_failure_times": ps_context().continuous_failure_times,
+    "cache_eviction_policy": ps_context().cache_eviction_policy,
+    "cache_admission_threshold": ps_context().cache_admission_threshold,
 }
 
 _check_positive_int_keys = ["server_num", "scheduler_port", "fl_server_port",
@@ -156,12 +160,18 @@ _check_port_keys = ["scheduler_port", "fl_server_port"]
 _check_string_keys = {
     "upload_compress_type": ["NO_COMPRESS", "DIFF_SPARSE_QUANT"],
     "download_compress_type": ["NO_COMPRESS", "QUANT"],
+    "cache_eviction_policy": ["step", "lfu", "arc"],
 }
 
 _check_float_range_keys = {
     "upload_sparse_rate": {"lower_limit": 0.0, "upper_limit": 1.0, "rel": Rel.INC_RIGHT},
 }
 
+# The estimated access frequencies of the embedding cache saturate at 255.
+_check_int_range_keys = {
+    "cache_admission_threshold": {"lower_limit": 0, "upper_limit": 255, "rel": Rel.INC_BOTH},
+}
+
 def _get_ps_mode_rank():
     ps_rank = ps_context().ps_rank_id()
     if ps_rank == -1:
@@ -198,6 +208,13 @@ def _set_ps_context(**kwargs):
         enable_ssl (bool): Set PS SSL mode enabled or disabled. Default: False.
         client_password (str): Password to decrypt the secret key stored in the client certificate. Default: ''.
         server_password (str): Password to decrypt the secret key stored in the server certificate. Default: ''.
+        cache_eviction_policy (str): The eviction policy of the embedding cache, one of 'step', 'lfu' and 'arc'.
+                                     'step' evicts the rows unused for the most steps, 'lfu' evicts the least
+                                     frequently used rows and 'arc' adapts between recency and frequency.
+                                     Default: 'step'.
+        cache_admission_threshold (int): When it's positive and the eviction policy is 'lfu' or 'arc', the rows whose
+                                         estimated access frequency is less than it are evicted before the others.
+                                         The range is [0, 255]. Default: 0.
 
     Raises:
         ValueError: If input key is not the attribute in parameter server training mode context.
@@ -290,6 +307,14 @@ def _cache_enable():
     return ps_context().cache_enable()
 
 
+def _cache_metrics():
+    """
+    Get the metrics of the embedding cache: the hit rates and swap sizes in bytes of the last data step, and the
+    accumulated id, hit and swap counts. It's empty before the cache is initialized.
+    """
+    return ps_context().cache_metrics()
+
+
 def _set_rank_id(rank_id):
     ps_context().set_rank_id(rank_id)
 
@@ -323,6 +348,10 @@ def _check_value(key, value):
         range_keys = _check_float_range_keys[key]
         Validator.check_float_range(value, **range_keys)
 
+    if key in _check_int_range_keys:
+        range_keys = _check_int_range_keys[key]
+        Validator.check_int_range(value, arg_name=key, **range_keys)
+
     if key in _check_port_keys:
         if value < 1 or value > 65535:
             raise ValueError("The range of %s must be 1 to 65535, but got %d." % (key, value))
@@ -0,0 +1,68 @@
+# Copyright 2022 Huawei Technologies Co., Ltd
+#
+# Licensed under the Apache License, Version 2.0 (the "License");
+# you may not use this file except in compliance with the License.
+# You may obtain a copy of the License at
+#
+# http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing, software
+# distributed under the License is distributed on an "AS IS" BASIS,
+# WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+# See the License for the specific language governing permissions and
+# limitations under the License.
+# ============================================================================
+
+"""benchmark AllReduce of the data types and sizes on CPU over the loopback"""
+
+import time
+
+import numpy as np
+
+from mindspore import Tensor
+from mindspore import context
+from mindspore import nn
+from mindspore.ops import operations as P
+from mindspore.communication.management import init, get_group_size, get_rank
+
+context.set_context(mode=context.GRAPH_MODE, device_target='CPU')
+context.set_ps_context(enable_ssl=False)
+init()
+
+DATA_TYPES = (np.float32, np.float16, np.int32)
+DATA_SIZES = (1024, 256 * 1024, 4 * 1024 * 1024, 16 * 1024 * 1024)
+REPEAT_TIMES = 5
+
+
+class Net(nn.Cell):
+    def __init__(self):
+        super(Net, self).__init__()
+        self.all_reduce = P.AllReduce()
+
+    def construct(self, x):
+        return self.all_reduce(x)
+
+
+def run_all_reduce_benchmark():
+    """ Run all reduce benchmark"""
+    all_reduce = Net()
+    rank_size = get_group_size()
+    for data_type in DATA_TYPES:
+        for data_size in DATA_SIZES:
+            data_num = data_size // np.dtype(data_type).itemsize
+            x_np = (np.arange(data_num) % 7).astype(data_type)
+            x_input = Tensor(x_np)
+            # The first run includes the graph compiling.
+            output = all_reduce(x_input)
+            assert np.array_equal(output.asnumpy(), x_np * rank_size)
+            start = time.time()
+            for _ in range(REPEAT_TIMES):
+                output = all_reduce(x_input)
+            cost = (time.time() - start) / REPEAT_TIMES
+            # The bus bandwidth of the ring, each rank sends 2 * (n - 1) / n of the data.
+            bus_bandwidth = data_size * 2 * (rank_size - 1) / rank_size / cost / 1024 / 1024
+            print("rank {}, data type {}, data size {} bytes, time {:.3f} ms, bus bandwidth {:.1f} MB/s".format(
+                get_rank(), np.dtype(data_type).name, data_size, cost * 1000, bus_bandwidth), flush=True)
+
+
+run_all_reduce_benchmark()
@@ -49,3 +49,18 @@ def test_allreduce_small_scale_data():
         return
     return_code = os.system("bash build_allreduce_net_cluster.sh run_allreduce_small_scale_data.py 8081")
     assert return_code == 0
+
+
+@pytest.mark.level1
+@pytest.mark.platform_x86_cpu
+@pytest.mark.env_onecard
+def test_allreduce_benchmark():
+    """
+    Feature: CPU data parallel.
+    Description: Benchmark AllReduce op of float32, float16 and int32 data on CPU over the loopback.
+    Expectation: Each node obtains all node reduced result, and the time cost is printed in worker logs.
+    """
+    if sys.platform != 'linux':
+        return
+    return_code = os.system("bash build_allreduce_net_cluster.sh run_allreduce_benchmark.py 8129")
+    assert return_code == 0
@@ -0,0 +1,98 @@
+# Copyright 2022 Huawei Technologies Co., Ltd
+#
+# Licensed under the Apache License, Version 2.0 (the "License");
+# you may not use this file except in compliance with the License.
+# You may obtain a copy of the License at
+#
+# http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing, software
+# distributed under the License is distributed on an "AS IS" BASIS,
+# WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+# See the License for the specific language governing permissions and
+# limitations under the License.
+# ============================================================================
+
+"""
+The load benchmark of the embedding table in the parameter server. Each worker looks up a batch of skewed ids from the
+same table and pushes the sparse gradients in every step, and prints its throughput.
+"""
+
+import sys
+import time
+import argparse
+import numpy as np
+
+import mindspore.context as context
+import mindspore.nn as nn
+from mindspore import Tensor
+from mindspore.common import dtype as mstype
+from mindspore.nn import TrainOneStepCell, WithLossCell
+from mindspore.nn.optim import Adam
+from mindspore.common import set_seed
+from mindspore.ops import operations as P
+from mindspore.parallel._ps_context import _is_role_pserver
+
+parser = argparse.ArgumentParser(description="test_embedding_benchmark")
+parser.add_argument("--device_target", type=str, default="CPU")
+parser.add_argument("--steps", type=int, default=100)
+parser.add_argument("--vocab_size", type=int, default=100000)
+parser.add_argument("--embedding_size", type=int, default=64)
+parser.add_argument("--batch_size", type=int, default=256)
+parser.add_argument("--field_size", type=int, default=32)
+args, _ = parser.parse_known_args()
+context.set_context(mode=context.GRAPH_MODE, device_target=args.device_target, enable_sparse=True)
+context.set_ps_context(enable_ps=True)
+
+
+class EmbeddingNet(nn.Cell):
+    def __init__(self, vocab_size, embedding_size, field_size, num_class=2):
+        super(EmbeddingNet, self).__init__()
+        self.cast = P.Cast()
+        self.flatten = nn.Flatten()
+        self.embedding = nn.EmbeddingLookup(vocab_size, embedding_size)
+        self.fc = nn.Dense(field_size * embedding_size, num_class)
+
+    def construct(self, x):
+        x = self.cast(x, mstype.int32)
+        x = self.embedding(x)
+        x = self.flatten(x)
+        x = self.fc(x)
+        return x
+
+
+def skewed_ids(shape, vocab_size):
+    """The ids follow the zipf distribution, so the workers hit the same hot rows like the real click data."""
+    ids = np.random.zipf(1.2, shape) - 1
+    return np.mod(ids, vocab_size).astype(np.int32)
+
+
+def run_benchmark():
+    net = EmbeddingNet(args.vocab_size, args.embedding_size, args.field_size)
+    net.embedding.embedding_table.set_param_ps()
+    optimizer = Adam(filter(lambda x: x.requires_grad, net.get_parameters()))
+    optimizer.target = 'CPU'
+    criterion = nn.SoftmaxCrossEntropyWithLogits(sparse=True, reduction="mean")
+    train_network = TrainOneStepCell(WithLossCell(net, criterion), optimizer)
+    train_network.set_train()
+
+    data = Tensor(skewed_ids((args.batch_size, args.field_size), args.vocab_size))
+    label = Tensor(np.random.randint(0, 2, (args.batch_size), np.int32))
+    if _is_role_pserver():
+        train_network(data, label)
+        sys.exit()
+
+    # The first step compiles the graph and initializes the embedding table on the server.
+    train_network(data, label)
+    start = time.time()
+    for _ in range(args.steps):
+        data = Tensor(skewed_ids((args.batch_size, args.field_size), args.vocab_size))
+        train_network(data, label)
+    cost = time.time() - start
+    print("[Benchmark] steps: {}, step time: {:.3f} ms, lookup ids per second: {:.0f}".format(
+        args.steps, cost * 1000 / args.steps, args.steps * args.batch_size * args.field_size / cost), flush=True)
+
+
+if __name__ == "__main__":
+    set_seed(0)
+    run_benchmark()
@@ -0,0 +1,29 @@
+# Copyright 2022 Huawei Technologies Co., Ltd
+#
+# Licensed under the Apache License, Version 2.0 (the "License");
+# you may not use this file except in compliance with the License.
+# You may obtain a copy of the License at
+#
+# http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing, software
+# distributed under the License is distributed on an "AS IS" BASIS,
+# WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+# See the License for the specific language governing permissions and
+# limitations under the License.
+# ============================================================================
+import os
+import pytest
+
+
+@pytest.mark.level1
+@pytest.mark.platform_x86_cpu
+@pytest.mark.env_onecard
+def test_embedding_benchmark():
+    """
+    Feature: Embedding lookup and update in the parameter server.
+    Description: Several local workers look up and push the gradients of the same embedding table concurrently.
+    Expectation: All the workers finish, and the throughput of each worker is printed.
+    """
+    return_code = os.system("bash shell_run_test.sh CPU 4 1 127.0.0.1 8086 100")
+    assert return_code == 0
@@ -0,0 +1,166 @@
+/**
+ * Copyright 2022 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include <algorithm>
+#include <any>
+#include <map>
+#include <memory>
+#include <sstream>
+#include <string>
+#include <vector>
+#define private public
+#define protected public
+#include "common/common.h"
+#include "minddata/dataset/engine/tree_adapter.h"
+#include "minddata/dataset/engine/perf/auto_tune.h"
+#undef protected
+#undef private
+#include "minddata/dataset/engine/datasetops/map_op/map_op.h"
+#include "minddata/dataset/kernels/data/no_op.h"
+
+using namespace mindspore::dataset;
+
+namespace mindspore {
+namespace dataset {
+namespace test {
+class MindDataTestAutoTune : public UT::DatasetOpTesting {
+ protected:
+  void SetUp() override {
+    DatasetOpTesting::SetUp();
+    // A chain of three Map ops with one worker each, the ids are 0 (leaf) to 2 (root).
+    tree_adapter_.tree_ = std::make_unique<ExecutionTree>();
+    auto tree = tree_adapter_.tree_.get();
+    std::shared_ptr<DatasetOp> child = nullptr;
+    for (int32_t i = 0; i < kNumOps; i++) {
+      std::vector<std::shared_ptr<TensorOp>> op_list = {std::make_shared<NoOp>()};
+      auto map_op = std::make_shared<MapOp>(std::vector<std::string>{"col"}, std::vector<std::string>{"col"},
+                                            std::move(op_list), 1, kConnectorSize);
+      ASSERT_OK(tree->AssociateNode(map_op));
+      map_op->CreateConnector();
+      if (child != nullptr) {
+        ASSERT_OK(map_op->AddChild(child));
+      }
+      child = map_op;
+      ops_.push_back(map_op);
+    }
+    ASSERT_OK(tree->AssignRoot(child));
+
+    auto_tune_ = std::make_unique<AutoTune>(&tree_adapter_, nullptr);
+    for (const auto &op : ops_) {
+      auto_tune_->ops_[op->id()] = op;
+      auto_tune_->parallel_ops_ids_.push_back(op->id());
+    }
+    auto_tune_->max_workers_ = kMaxWorkers;
+  }
+
+  const int32_t kNumOps = 3;
+  const int32_t kConnectorSize = 4;
+  const int32_t kMaxWorkers = 8;
+  TreeAdapter tree_adapter_;
+  std::vector<std::shared_ptr<DatasetOp>> ops_;
+  std::unique_ptr<AutoTune> auto_tune_;
+};
+
+/// Feature: AutoTune throughput model
+/// Description: Build the model from synthetic batch times and CPU utilization of the ops
+/// Expectation: The cost of an op is its share of the batch time, the ops without a measured cost are left out
+TEST_F(MindDataTestAutoTune, TestBuildThroughputModel) {
+  std::map<int32_t, double> op_costs;
+  double batch_time = 0;
+  ASSERT_OK(auto_tune_->BuildThroughputModel({8, 12, 10, 10}, {{0, 50}, {1, 200}, {2, 0}}, &op_costs, &batch_time));
+  EXPECT_DOUBLE_EQ(batch_time, 10);
+  ASSERT_EQ(op_costs.size(), 2);
+  EXPECT_DOUBLE_EQ(op_costs[0], 5);
+  EXPECT_DOUBLE_EQ(op_costs[1], 20);
+
+  // Without any batch there is nothing to model.
+  op_costs.clear();
+  ASSERT_OK(auto_tune_->BuildThroughputModel({}, {{0, 50}, {1, 200}}, &op_costs, &batch_time));
+  EXPECT_DOUBLE_EQ(batch_time, 0);
+  EXPECT_TRUE(op_costs.empty());
+}
+
+/// Feature: AutoTune throughput model
+/// Description: Solve the workers of two ops whose costs differ by four times, with a third op out of the model
+/// Expectation: The bottleneck op gets the most workers, the workers of all the ops fit in the budget and the
+///     throughputs of the ops end up balanced
+TEST_F(MindDataTestAutoTune, TestSolveAllocationFavorsBottleneck) {
+  std::map<int32_t, double> op_costs = {{0, 5}, {1, 20}};
+  std::map<int32_t, int32_t> workers;
+  std::map<int32_t, int32_t> capacities;
+  ASSERT_OK(auto_tune_->SolveAllocation(op_costs, 1024, 1, &workers, &capacities));
+  ASSERT_EQ(workers.size(), 2);
+  EXPECT_EQ(workers.count(2), 0);
+  EXPECT_GT(workers[1], workers[0]);
+  // Op 2 keeps its worker, the two others share the rest of the budget.
+  EXPECT_EQ(workers[0] + workers[1] + ops_[2]->NumWorkers(), kMaxWorkers);
+  // No worker moved to the other op would raise the throughput of the slowest op.
+  double slowest_rate = std::min(workers[0] / op_costs[0], workers[1] / op_costs[1]);
+  EXPECT_LE(std::min((workers[0] - 1) / op_costs[0], (workers[1] + 1) / op_costs[1]), slowest_rate);
+  EXPECT_LE(std::min((workers[0] + 1) / op_costs[0], (workers[1] - 1) / op_costs[1]), slowest_rate);
+  // The queues grow after the workers when the memory allows.
+  EXPECT_EQ(capacities[0], auto_tune_->MODEL_QUEUE_PER_WORKER * workers[0]);
+  EXPECT_EQ(capacities[1], auto_tune_->MODEL_QUEUE_PER_WORKER * workers[1]);
+}
+
+/// Feature: AutoTune throughput model
+/// Description: Solve the allocation with fewer workers than tunable ops and with a tight memory budget
+/// Expectation: Every op keeps the minimum of one worker, and the growth of the queues fits in the memory budget
+TEST_F(MindDataTestAutoTune, TestSolveAllocationRespectsBudget) {
+  std::map<int32_t, double> op_costs = {{0, 5}, {1, 20}, {2, 10}};
+  std::map<int32_t, int32_t> workers;
+  std::map<int32_t, int32_t> capacities;
+  auto_tune_->max_workers_ = 2;
+  ASSERT_OK(auto_tune_->SolveAllocation(op_costs, 1024, 1, &workers, &capacities));
+  for (const auto &op : workers) {
+    EXPECT_EQ(op.second, 1);
+  }
+
+  auto_tune_->max_workers_ = kMaxWorkers;
+  workers.clear();
+  capacities.clear();
+  const double budget_mb = 3;
+  const double row_mb = 1;
+  ASSERT_OK(auto_tune_->SolveAllocation(op_costs, budget_mb, row_mb, &workers, &capacities));
+  int32_t total_workers = 0;
+  double extra_mb = 0;
+  for (const auto &op : workers) {
+    EXPECT_LE(op.second, kMaxWorkers);
+    total_workers += op.second;
+    extra_mb += std::max(capacities[op.first] - ops_[op.first]->ConnectorCapacity(), 0) * row_mb;
+  }
+  EXPECT_EQ(total_workers, kMaxWorkers);
+  EXPECT_LE(extra_mb, budget_mb);
+}
+
+/// Feature: AutoTune throughput model
+/// Description: Compare the costs and batch times of later intervals with the model the plan was solved with
+/// Expectation: Small changes and faster batches keep the plan, a large change of any cost, a new op or slower
+///     batches solve it again
+TEST_F(MindDataTestAutoTune, TestIsModelDrifted) {
+  auto_tune_->model_op_costs_ = {{0, 5}, {1, 20}};
+  auto_tune_->model_batch_time_ = 10;
+  EXPECT_FALSE(auto_tune_->IsModelDrifted({{0, 5}, {1, 20}}, 10));
+  EXPECT_FALSE(auto_tune_->IsModelDrifted({{0, 6}, {1, 17}}, 12));
+  EXPECT_FALSE(auto_tune_->IsModelDrifted({{0, 5}, {1, 20}}, 5));
+
+  EXPECT_TRUE(auto_tune_->IsModelDrifted({{0, 5}, {1, 30}}, 10));
+  EXPECT_TRUE(auto_tune_->IsModelDrifted({{0, 2}, {1, 20}}, 10));
+  EXPECT_TRUE(auto_tune_->IsModelDrifted({{0, 5}, {1, 20}, {2, 1}}, 10));
+  EXPECT_TRUE(auto_tune_->IsModelDrifted({{0, 5}, {1, 20}}, 14));
+}
+}  // namespace test
+}  // namespace dataset
+}  // namespace mindspore
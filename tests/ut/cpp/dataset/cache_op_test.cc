@@ -14,8 +14,10 @@
  * limitations under the License.
  */
 #include <string>
+#include <vector>
 #include "minddata/dataset/core/client.h"
 #include "minddata/dataset/engine/cache/cache_client.h"
+#include "minddata/dataset/engine/cache/cache_hash_ring.h"
 #include "minddata/dataset/engine/execution_tree.h"
 #include "minddata/dataset/engine/datasetops/cache_op.h"
 #include "minddata/dataset/engine/datasetops/cache_lookup_op.h"
@@ -312,3 +314,46 @@ TEST_F(MindDataTestCacheOp, DISABLED_TestImageFolderCacheMerge) {
   rc = myClient->DestroyCache();
   ASSERT_TRUE(rc.IsOk());
 }
+
+TEST_F(MindDataTestCacheOp, TestCacheHashRing) {
+  const int32_t num_servers = 4;
+  const int64_t num_keys = 10000;
+  CacheHashRing ring;
+  EXPECT_EQ(ring.Lookup(0), -1);
+  for (auto i = 0; i < num_servers; ++i) {
+    ring.AddServer(i, "127.0.0.1:" + std::to_string(50052 + i));
+  }
+  EXPECT_EQ(ring.NumServers(), static_cast<size_t>(num_servers));
+  std::vector<int32_t> owner(num_keys);
+  std::vector<int64_t> count(num_servers, 0);
+  for (int64_t k = 0; k < num_keys; ++k) {
+    owner[k] = ring.Lookup(k);
+    ASSERT_TRUE(owner[k] >= 0 && owner[k] < num_servers);
+    ++count[owner[k]];
+  }
+  // Every server takes a fair share of the rows.
+  for (auto c : count) {
+    EXPECT_GT(c, num_keys / num_servers / 2);
+    EXPECT_LT(c, num_keys / num_servers * 2);
+  }
+  // Only the rows of the removed server move.
+  ring.RemoveServer(1);
+  EXPECT_FALSE(ring.HasServer(1));
+  for (int64_t k = 0; k < num_keys; ++k) {
+    auto server = ring.Lookup(k);
+    EXPECT_NE(server, 1);
+    if (owner[k] != 1) {
+      EXPECT_EQ(server, owner[k]);
+    }
+  }
+}
+
+TEST_F(MindDataTestCacheOp, TestCacheClientServers) {
+  CacheClient::Builder builder;
+  builder.SetSessionId(1).SetServers({{"127.0.0.1", 50052}, {"127.0.0.1", 50053}});
+  EXPECT_TRUE(builder.SanityCheck().IsOk());
+  builder.SetServers({{"127.0.0.1", 50052}, {"127.0.0.1", 50052}});
+  EXPECT_TRUE(builder.SanityCheck().IsError());
+  builder.SetServers({{"127.0.0.1", 80}});
+  EXPECT_TRUE(builder.SanityCheck().IsError());
+}
@@ -16,6 +16,7 @@
 
 #include <fcntl.h>
 #include <iostream>
+#include <limits>
 #include <memory>
 #include <vector>
 #include <chrono>
@@ -23,7 +24,10 @@
 
 
 #include "common/common.h"
+#include "minddata/dataset/core/config_manager.h"
+#include "minddata/dataset/core/global_context.h"
 #include "minddata/dataset/engine/connector.h"
+#include "minddata/dataset/engine/operator_connector.h"
 #include "minddata/dataset/util/task_manager.h"
 #include "utils/log_adapter.h"
 
@@ -50,8 +54,10 @@ public:
 
   void SetSleepMilliSec(uint32_t ms) { sleep_ms_ = ms; }
 
-private:
+protected:
   std::unique_ptr<TaskGroup> tg_;
+
+private:
   uint32_t last_input_;
   uint32_t sleep_ms_ = 0;
   std::vector<uint32_t> input_;
@@ -122,7 +128,90 @@ TEST_F(MindDataTestConnector, Test2) {
   ASSERT_TRUE(rc.IsOk());
 }
 
+// TestRowBatch: an OperatorConnector in row batch mode hands the rows over in order, in batches no larger than the
+// row batch size and closed by the control rows.
+TEST_F(MindDataTestConnector, TestRowBatch) {
+  MS_LOG(INFO) << "MindDataTestConnector TestRowBatch.";
+  constexpr int32_t kNumRows = 1000;
+  constexpr int32_t kRowBatchSize = 8;
+  OperatorConnector connector(16, QueueType::kBlocking, kRowBatchSize);
+  ASSERT_TRUE(connector.IsRowBatchMode());
+  ASSERT_TRUE(connector.Register(tg_.get()).IsOk());
+  Status rc = tg_->CreateAsyncTask("Row Batch Push", [&connector]() -> Status {
+    TaskManager::FindMe()->Post();
+    for (int32_t i = 0; i < kNumRows; ++i) {
+      TensorRow row;
+      row.setId(i);
+      RETURN_IF_NOT_OK(connector.Add(std::move(row)));
+    }
+    return connector.SendEOE();
+  });
+  ASSERT_TRUE(rc.IsOk());
+  int64_t expected_id = 0;
+  bool eoe = false;
+  bool pop_rows = false;
+  while (!eoe) {
+    TensorTable rows;
+    if (pop_rows) {
+      ASSERT_TRUE(connector.PopRows(&rows).IsOk());
+      ASSERT_FALSE(rows.empty());
+      ASSERT_LE(rows.size(), kRowBatchSize);
+    } else {
+      rows.resize(1);
+      ASSERT_TRUE(connector.PopFront(&rows.front()).IsOk());
+    }
+    pop_rows = !pop_rows;
+    for (size_t i = 0; i < rows.size(); ++i) {
+      if (rows[i].eoe()) {
+        EXPECT_EQ(i, rows.size() - 1);
+        eoe = true;
+        break;
+      }
+      EXPECT_EQ(rows[i].getId(), expected_id++);
+    }
+  }
+  ASSERT_TRUE(tg_->join_all(Task::WaitFlag::kBlocking).IsOk());
+  ASSERT_TRUE(tg_->GetTaskErrorIfAny().IsOk());
+  EXPECT_EQ(expected_id, kNumRows);
+  EXPECT_EQ(connector.size(), 0);
+
+  // A consumer running out of rows takes the rows gathered so far instead of waiting for the batch to fill up.
+  for (int32_t i = 0; i < kRowBatchSize / 2; ++i) {
+    TensorRow row;
+    row.setId(i);
+    ASSERT_TRUE(connector.Add(std::move(row)).IsOk());
+  }
+  TensorTable rows;
+  ASSERT_TRUE(connector.PopRows(&rows).IsOk());
+  EXPECT_EQ(rows.size(), kRowBatchSize / 2);
+}
 
+// TestRowBatchSizeLimit: the row batch size beyond kMaxRowBatchSize is rejected by the config and capped by the
+// connector, and the capacity in rows does not overflow.
+TEST_F(MindDataTestConnector, TestRowBatchSizeLimit) {
+  MS_LOG(INFO) << "MindDataTestConnector TestRowBatchSizeLimit.";
+  auto config_manager = GlobalContext::config_manager();
+  int32_t original_size = config_manager->row_batch_size();
+  EXPECT_TRUE(config_manager->set_row_batch_size(-1).IsError());
+  EXPECT_TRUE(config_manager->set_row_batch_size(kMaxRowBatchSize + 1).IsError());
+  EXPECT_TRUE(config_manager->set_row_batch_size(std::numeric_limits<int32_t>::max()).IsError());
+  EXPECT_EQ(config_manager->row_batch_size(), original_size);
+  ASSERT_TRUE(config_manager->set_row_batch_size(kMaxRowBatchSize).IsOk());
+  EXPECT_EQ(config_manager->row_batch_size(), kMaxRowBatchSize);
+  ASSERT_TRUE(config_manager->set_row_batch_size(original_size).IsOk());
+
+  OperatorConnector connector(std::numeric_limits<int32_t>::max(), QueueType::kBlocking,
+                              std::numeric_limits<int32_t>::max());
+  ASSERT_TRUE(connector.IsRowBatchMode());
+  EXPECT_EQ(connector.capacity(), std::numeric_limits<int32_t>::max());
+  TensorRow row;
+  row.setId(1);
+  ASSERT_TRUE(connector.Add(std::move(row)).IsOk());
+  TensorTable rows;
+  ASSERT_TRUE(connector.PopRows(&rows).IsOk());
+  ASSERT_EQ(rows.size(), 1);
+  EXPECT_EQ(rows[0].getId(), 1);
+}
 
 // Implementation of MindDataTestConnector class and the helper functions.
 MindDataTestConnector::MindDataTestConnector() : tg_(new TaskGroup()) {
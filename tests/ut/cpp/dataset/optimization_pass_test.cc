@@ -27,9 +27,13 @@
 #include "minddata/dataset/include/dataset/transforms.h"
 #include "minddata/dataset/include/dataset/vision.h"
 #include "minddata/dataset/include/dataset/vision_lite.h"
+#include "minddata/dataset/kernels/tensor_op.h"
 #include "minddata/dataset/kernels/ir/data/transforms_ir.h"
 #include "minddata/dataset/kernels/ir/vision/decode_ir.h"
+#include "minddata/dataset/kernels/ir/vision/hwc_to_chw_ir.h"
+#include "minddata/dataset/kernels/ir/vision/normalize_ir.h"
 #include "minddata/dataset/kernels/ir/vision/random_crop_decode_resize_ir.h"
+#include "minddata/dataset/kernels/ir/vision/random_crop_decode_resize_normalize_ir.h"
 #include "minddata/dataset/kernels/ir/vision/random_resized_crop_ir.h"
 
 using namespace mindspore::dataset;
@@ -111,3 +115,59 @@ TEST_F(MindDataTestOptimizationPass, MindDataTestTensorFusionPassPreBuiltTensorO
   ASSERT_EQ(fused_ops.size(), 1);
   ASSERT_EQ(fused_ops[0]->Name(), kRandomCropDecodeResizeOp);
 }
+
+/// Feature: TensorOpFusionPass
+/// Description: Map Decode, RandomResizedCrop, Normalize and HWC2CHW in a row
+/// Expectation: The four ops are fused into a single RandomCropDecodeResizeNormalize op
+TEST_F(MindDataTestOptimizationPass, MindDataTestTensorFusionPassNormalize) {
+  MS_LOG(INFO) << "Doing MindDataTestOptimizationPass-MindDataTestTensorFusionPassNormalize.";
+  std::string folder_path = datasets_root_path_ + "/testPK/data/";
+  auto decode_op = vision::Decode();
+  auto random_resized_crop_op = vision::RandomResizedCrop({100});
+  auto normalize_op = vision::Normalize({121.0, 115.0, 100.0}, {70.0, 68.0, 71.0});
+  auto hwc2chw_op = vision::HWC2CHW();
+  std::shared_ptr<Dataset> root = ImageFolder(folder_path, false)
+                                    ->Map({decode_op, random_resized_crop_op, normalize_op, hwc2chw_op}, {"image"});
+
+  TensorOpFusionPass fusion_pass;
+  bool modified = false;
+  std::shared_ptr<MapNode> map_node = std::dynamic_pointer_cast<MapNode>(root->IRNode());
+  // no deepcopy is performed because this doesn't go through tree_adapter
+  fusion_pass.Run(root->IRNode(), &modified);
+  EXPECT_EQ(modified, true);
+  ASSERT_NE(map_node, nullptr);
+  auto fused_ops = map_node->operations();
+  ASSERT_EQ(fused_ops.size(), 1);
+  ASSERT_EQ(fused_ops[0]->Name(), vision::kRandomCropDecodeResizeNormalizeOperation);
+  ASSERT_OK(fused_ops[0]->ValidateParams());
+  ASSERT_EQ(fused_ops[0]->Build()->Name(), kRandomCropDecodeResizeNormalizeOp);
+}
+
+/// Feature: TensorOpFusionPass
+/// Description: Map Decode, RandomResizedCrop, a CHW Normalize and HWC2CHW in a row
+/// Expectation: Only Decode and RandomResizedCrop are fused, the Normalize is left untouched
+TEST_F(MindDataTestOptimizationPass, MindDataTestTensorFusionPassNormalizeCHW) {
+  MS_LOG(INFO) << "Doing MindDataTestOptimizationPass-MindDataTestTensorFusionPassNormalizeCHW.";
+  std::string folder_path = datasets_root_path_ + "/testPK/data/";
+  auto decode = std::make_shared<vision::DecodeOperation>(true);
+  auto crop = std::make_shared<vision::RandomResizedCropOperation>(
+    std::vector<int32_t>{100, 100}, std::vector<float>{0.5, 1.0}, std::vector<float>{0.75, 1.333},
+    InterpolationMode::kLinear, 10);
+  auto normalize = std::make_shared<vision::NormalizeOperation>(std::vector<float>{121.0, 115.0, 100.0},
+                                                                std::vector<float>{70.0, 68.0, 71.0}, false);
+  auto hwc2chw = std::make_shared<vision::HwcToChwOperation>();
+  std::vector<std::shared_ptr<TensorOperation>> op_list = {decode, crop, normalize, hwc2chw};
+  std::vector<std::string> op_name = {"image"};
+  std::shared_ptr<DatasetNode> root = ImageFolder(folder_path, false)->IRNode();
+  std::shared_ptr<MapNode> map_node = std::make_shared<MapNode>(root, op_list, op_name);
+
+  TensorOpFusionPass fusion_pass;
+  bool modified = false;
+  fusion_pass.Run(map_node, &modified);
+  EXPECT_EQ(modified, true);
+  auto fused_ops = map_node->operations();
+  ASSERT_EQ(fused_ops.size(), 3);
+  ASSERT_EQ(fused_ops[0]->Name(), vision::kRandomCropDecodeResizeOperation);
+  ASSERT_EQ(fused_ops[1]->Name(), vision::kNormalizeOperation);
+  ASSERT_EQ(fused_ops[2]->Name(), vision::kHwcToChwOperation);
+}
@@ -18,9 +18,11 @@
 #include "gtest/gtest.h"
 #include "minddata/dataset/util/task_manager.h"
 #include "minddata/dataset/util/queue.h"
+#include "minddata/dataset/engine/operator_connector.h"
 #include <atomic>
 #include <chrono>
 #include <random>
+#include <vector>
 #include "utils/log_adapter.h"
 
 using namespace mindspore::dataset;
@@ -263,4 +265,133 @@ TEST_F(MindDataTestQueue, TestResize2) {
   ASSERT_EQ(1, queue.size());
   queue.Reset();
   ASSERT_EQ(0, queue.size());
-}
\ No newline at end of file
+}
+// Feature: Lock-free queue.
+// Description: Pass shared pointers, unique pointers and emplaced elements through both lock-free flavors.
+// Expectation: The elements are popped in order and no copy is left behind in the queue.
+TEST_F(MindDataTestQueue, TestLockFreeBasic) {
+  for (auto type : {QueueType::kLockFreeSpsc, QueueType::kLockFreeMpmc}) {
+    Queue<std::shared_ptr<int>> que(3, type);
+    std::shared_ptr<int> a = std::make_shared<int>(20);
+    EXPECT_OK(que.Add(a));
+    ASSERT_EQ(a.use_count(), 2);
+    std::shared_ptr<int> b;
+    EXPECT_OK(que.PopFront(&b));
+    ASSERT_EQ(*b, 20);
+    ASSERT_EQ(a.use_count(), 2);
+
+    Queue<std::unique_ptr<int>> uque(3, type);
+    EXPECT_OK(uque.EmplaceBack(new int(40)));
+    EXPECT_OK(uque.Add(std::make_unique<int>(41)));
+    ASSERT_EQ(uque.size(), 2);
+    std::unique_ptr<int> c;
+    EXPECT_OK(uque.PopFront(&c));
+    ASSERT_EQ(*c, 40);
+    EXPECT_OK(uque.PopFront(&c));
+    ASSERT_EQ(*c, 41);
+    ASSERT_TRUE(uque.empty());
+  }
+}
+
+// Feature: Lock-free queue.
+// Description: Shrink and grow a lock-free queue holding elements.
+// Expectation: The elements are kept, growing is clamped to the number of slots of the ring buffer.
+TEST_F(MindDataTestQueue, TestLockFreeResize) {
+  Queue<int> queue(6, QueueType::kLockFreeMpmc);
+  for (int i = 0; i < 3; ++i) {
+    EXPECT_OK(queue.Add(i));
+  }
+  EXPECT_ERROR(queue.Resize(0));
+  EXPECT_OK(queue.Resize(1));
+  ASSERT_EQ(1, queue.capacity());
+  ASSERT_EQ(3, queue.size());
+  int v = -1;
+  EXPECT_OK(queue.PopFront(&v));
+  ASSERT_EQ(0, v);
+  // 6 is rounded up to 8 slots
+  EXPECT_OK(queue.Resize(12));
+  ASSERT_EQ(8, queue.capacity());
+  EXPECT_OK(queue.Add(3));
+  ASSERT_EQ(3, queue.size());
+  queue.Reset();
+  ASSERT_EQ(0, queue.size());
+}
+
+// Feature: Lock-free queue.
+// Description: Grow a lock-free queue created with a max capacity while it holds elements.
+// Expectation: The queue grows up to the max capacity and keeps the elements in order.
+TEST_F(MindDataTestQueue, TestLockFreeGrowToMaxCapacity) {
+  Queue<int> queue(4, QueueType::kLockFreeMpmc, kMaxConnectorCapacity);
+  for (int i = 0; i < 4; ++i) {
+    EXPECT_OK(queue.Add(i));
+  }
+  EXPECT_OK(queue.Resize(kMaxConnectorCapacity));
+  ASSERT_EQ(kMaxConnectorCapacity, queue.capacity());
+  for (int i = 4; i < kMaxConnectorCapacity; ++i) {
+    EXPECT_OK(queue.Add(i));
+  }
+  ASSERT_EQ(kMaxConnectorCapacity, queue.size());
+  for (int i = 0; i < kMaxConnectorCapacity; ++i) {
+    int v = -1;
+    EXPECT_OK(queue.PopFront(&v));
+    ASSERT_EQ(i, v);
+  }
+
+  // The lock-free connector between ops can be grown by AutoTune up to its largest capacity.
+  OperatorConnector connector(4, QueueType::kLockFreeMpmc);
+  EXPECT_OK(connector.Resize(kMaxConnectorCapacity));
+  ASSERT_EQ(kMaxConnectorCapacity, connector.capacity());
+}
+
+// Push num_elements through a queue with the given number of producers and consumers, and return the rate.
+static double RunQueueThroughput(QueueType type, int32_t num_producers, int32_t num_consumers,
+                                 int64_t num_elements) {
+  Queue<TensorRow> que(16, type);
+  std::atomic<int64_t> popped(0);
+  // The threads must be tasks, a blocked caller checks the interrupt flag of its task.
+  TaskGroup vg;
+  auto start = std::chrono::steady_clock::now();
+  for (int32_t i = 0; i < num_producers; ++i) {
+    Status rc = vg.CreateAsyncTask("Producer", [&que, num_producers, num_elements]() -> Status {
+      TaskManager::FindMe()->Post();
+      for (int64_t j = 0; j < num_elements / num_producers; ++j) {
+        TensorRow row;
+        row.setId(j);
+        RETURN_IF_NOT_OK(que.Add(std::move(row)));
+      }
+      return Status::OK();
+    });
+    EXPECT_TRUE(rc.IsOk());
+  }
+  for (int32_t i = 0; i < num_consumers; ++i) {
+    Status rc = vg.CreateAsyncTask("Consumer", [&que, &popped, num_consumers, num_elements]() -> Status {
+      TaskManager::FindMe()->Post();
+      for (int64_t j = 0; j < num_elements / num_consumers; ++j) {
+        TensorRow row;
+        RETURN_IF_NOT_OK(que.PopFront(&row));
+        popped++;
+      }
+      return Status::OK();
+    });
+    EXPECT_TRUE(rc.IsOk());
+  }
+  EXPECT_TRUE(vg.join_all().IsOk());
+  EXPECT_TRUE(vg.GetTaskErrorIfAny().IsOk());
+  auto elapsed = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+  EXPECT_EQ(popped.load(), num_elements);
+  return num_elements / elapsed;
+}
+
+// Feature: Lock-free queue.
+// Description: Microbenchmark of the blocking queue against the lock-free queues with small rows.
+// Expectation: Every row pushed is popped, rates are logged for comparison.
+TEST_F(MindDataTestQueue, TestQueueThroughput) {
+  const int64_t num_elements = 200000;
+  MS_LOG(INFO) << "1 producer 1 consumer, blocking: " << RunQueueThroughput(QueueType::kBlocking, 1, 1, num_elements)
+               << " rows/s, lock-free spsc: " << RunQueueThroughput(QueueType::kLockFreeSpsc, 1, 1, num_elements)
+               << " rows/s.";
+  MS_LOG(INFO) << "4 producers 4 consumers, blocking: "
+               << RunQueueThroughput(QueueType::kBlocking, 4, 4, num_elements)
+               << " rows/s, lock-free mpmc: " << RunQueueThroughput(QueueType::kLockFreeMpmc, 4, 4, num_elements)
+               << " rows/s.";
+}
@@ -0,0 +1,116 @@
+/**
+ * Copyright 2022 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include <cmath>
+#include "common/common.h"
+#include "common/cvop_common.h"
+#include "minddata/dataset/core/config_manager.h"
+#include "minddata/dataset/kernels/image/hwc_to_chw_op.h"
+#include "minddata/dataset/kernels/image/normalize_op.h"
+#include "minddata/dataset/kernels/image/random_crop_decode_resize_normalize_op.h"
+#include "minddata/dataset/kernels/image/random_crop_decode_resize_op.h"
+#include "utils/log_adapter.h"
+
+using namespace mindspore::dataset;
+using mindspore::LogStream;
+using mindspore::ExceptionType::NoExceptionType;
+using mindspore::MsLogLevel::INFO;
+
+class MindDataTestRandomCropDecodeResizeNormalizeOp : public UT::CVOP::CVOpCommon {
+ public:
+  MindDataTestRandomCropDecodeResizeNormalizeOp() : CVOpCommon() {}
+
+ protected:
+  // Runs the fused op and the unfused RandomCropDecodeResize -> Normalize -> HWC2CHW chain with the same seed,
+  // returns the mean absolute difference between the two outputs.
+  double CompareWithUnfused(int32_t target_height, int32_t target_width, InterpolationMode interpolation) {
+    const std::vector<float> mean = {121.0, 115.0, 100.0};
+    const std::vector<float> std = {70.0, 68.0, 71.0};
+    GlobalContext::config_manager()->set_seed(42);
+    RandomCropDecodeResizeNormalizeOp fused(target_height, target_width, mean, std, 0.08, 1.0, 0.75, 1.333333,
+                                            interpolation, 10);
+    RandomCropDecodeResizeOp crop_decode_resize(target_height, target_width, 0.08, 1.0, 0.75, 1.333333,
+                                                interpolation, 10);
+    NormalizeOp normalize(mean, std, true);
+    HwcToChwOp hwc_to_chw;
+
+    double diff_sum = 0;
+    int64_t count = 0;
+    for (int k = 0; k < 10; k++) {
+      TensorRow input;
+      input.push_back(raw_input_tensor_);
+      TensorRow fused_output;
+      TensorRow resized;
+      EXPECT_OK(fused.Compute(input, &fused_output));
+      EXPECT_OK(crop_decode_resize.Compute(input, &resized));
+      std::shared_ptr<Tensor> normalized;
+      std::shared_ptr<Tensor> expected;
+      EXPECT_OK(normalize.Compute(resized[0], &normalized));
+      EXPECT_OK(hwc_to_chw.Compute(normalized, &expected));
+
+      EXPECT_EQ(fused_output[0]->type(), DataType(DataType::DE_FLOAT32));
+      EXPECT_EQ(fused_output[0]->shape(), TensorShape({3, target_height, target_width}));
+      EXPECT_EQ(fused_output[0]->shape(), expected->shape());
+      auto itr = fused_output[0]->begin<float>();
+      for (auto exp_itr = expected->begin<float>(); exp_itr != expected->end<float>(); ++exp_itr, ++itr) {
+        diff_sum += std::fabs(*itr - *exp_itr);
+        count++;
+      }
+    }
+    return count > 0 ? diff_sum / count : 0;
+  }
+};
+
+/// Feature: RandomCropDecodeResizeNormalize op
+/// Description: Target height above half of the image height, so the JPEG is decoded at full resolution
+/// Expectation: Output matches RandomCropDecodeResize followed by Normalize and HWC2CHW
+TEST_F(MindDataTestRandomCropDecodeResizeNormalizeOp, TestOpFullScale) {
+  MS_LOG(INFO) << "Doing MindDataTestRandomCropDecodeResizeNormalizeOp-TestOpFullScale.";
+  // apple.jpg is 4032x2268, no crop is twice as high as 1200 rows
+  double diff = CompareWithUnfused(1200, 1200, InterpolationMode::kLinear);
+  MS_LOG(INFO) << "mean absolute difference: " << diff;
+  EXPECT_LT(diff, 1e-4);
+}
+
+/// Feature: RandomCropDecodeResizeNormalize op
+/// Description: Target size much smaller than the crop, so the JPEG is decoded with DCT scaling
+/// Expectation: Output is close to RandomCropDecodeResize followed by Normalize and HWC2CHW
+TEST_F(MindDataTestRandomCropDecodeResizeNormalizeOp, TestOpDctScaled) {
+  MS_LOG(INFO) << "Doing MindDataTestRandomCropDecodeResizeNormalizeOp-TestOpDctScaled.";
+  // area interpolation averages like the DCT scaling does, so only rounding differences are left
+  double diff = CompareWithUnfused(32, 32, InterpolationMode::kArea);
+  MS_LOG(INFO) << "mean absolute difference: " << diff;
+  EXPECT_LT(diff, 0.1);
+}
+
+/// Feature: RandomCropDecodeResizeNormalize op
+/// Description: Input that is not a JPEG image
+/// Expectation: Falls back to a full decode and still outputs a normalized CHW image
+TEST_F(MindDataTestRandomCropDecodeResizeNormalizeOp, TestOpNotJpeg) {
+  MS_LOG(INFO) << "Doing MindDataTestRandomCropDecodeResizeNormalizeOp-TestOpNotJpeg.";
+  std::shared_ptr<Tensor> png;
+  std::string filename = "data/dataset/testKITTI/data_object_image_2/training/image_2/000000.png";
+  ASSERT_OK(Tensor::CreateFromFile(filename, &png));
+  RandomCropDecodeResizeNormalizeOp fused(64, 48, {0.0}, {255.0});
+  TensorRow input;
+  input.push_back(png);
+  TensorRow output;
+  ASSERT_OK(fused.Compute(input, &output));
+  EXPECT_EQ(output[0]->shape(), TensorShape({3, 64, 48}));
+  for (auto itr = output[0]->begin<float>(); itr != output[0]->end<float>(); ++itr) {
+    EXPECT_GE(*itr, 0.0);
+    EXPECT_LE(*itr, 1.0 + 1e-6);
+  }
+}
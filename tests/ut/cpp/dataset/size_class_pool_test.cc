@@ -0,0 +1,180 @@
+/**
+ * Copyright 2022 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include <thread>
+#include <vector>
+#include "minddata/dataset/util/size_class_pool.h"
+#include "minddata/dataset/util/system_pool.h"
+#include "common/common.h"
+#include "gtest/gtest.h"
+
+using namespace mindspore::dataset;
+
+class MindDataTestSizeClassPool : public UT::Common {
+ public:
+  std::shared_ptr<SizeClassPool> mp_;
+  MindDataTestSizeClassPool() {}
+
+  void SetUp() { mp_ = std::make_shared<SizeClassPool>(std::make_shared<SystemPool>()); }
+};
+
+TEST_F(MindDataTestSizeClassPool, TestRoundUp) {
+  EXPECT_EQ(SizeClassPool::RoundUp(1), 64);
+  EXPECT_EQ(SizeClassPool::RoundUp(64), 64);
+  EXPECT_EQ(SizeClassPool::RoundUp(65), 80);
+  EXPECT_EQ(SizeClassPool::RoundUp(80), 80);
+  EXPECT_EQ(SizeClassPool::RoundUp(81), 96);
+  EXPECT_EQ(SizeClassPool::RoundUp(128), 128);
+  EXPECT_EQ(SizeClassPool::RoundUp(129), 160);
+  EXPECT_EQ(SizeClassPool::RoundUp(224 * 224 * 3), 163840);
+  EXPECT_EQ(SizeClassPool::RoundUp(16 * 1024 * 1024), 16 * 1024 * 1024);
+  EXPECT_EQ(SizeClassPool::RoundUp(16 * 1024 * 1024 + 1), 16 * 1024 * 1024 + 1);
+  // every class wastes less than a quarter of the request
+  for (size_t n = 65; n < 1024 * 1024; n += 37) {
+    size_t sz = SizeClassPool::RoundUp(n);
+    ASSERT_GE(sz, n);
+    ASSERT_LT(sz - n, n / 4 + 1);
+  }
+}
+
+TEST_F(MindDataTestSizeClassPool, TestReuse) {
+  void *p = nullptr;
+  ASSERT_OK(mp_->Allocate(1000, &p));
+  ASSERT_NE(p, nullptr);
+  mp_->Deallocate(p);
+  void *q = nullptr;
+  // same size class as 1000
+  ASSERT_OK(mp_->Allocate(1010, &q));
+  EXPECT_EQ(p, q);
+  SizeClassPool::Stats stats = mp_->GetStats();
+  EXPECT_EQ(stats.misses, 1);
+  EXPECT_EQ(stats.hits, 1);
+  EXPECT_EQ(stats.cached_bytes, 0);
+  mp_->Deallocate(q);
+  EXPECT_EQ(mp_->GetStats().cached_bytes, SizeClassPool::RoundUp(1000));
+  mp_->Trim();
+  EXPECT_EQ(mp_->GetStats().cached_bytes, 0);
+  MS_LOG(DEBUG) << *mp_ << std::endl;
+}
+
+TEST_F(MindDataTestSizeClassPool, TestLarge) {
+  size_t sz = 32 * 1024 * 1024;
+  void *p = nullptr;
+  ASSERT_OK(mp_->Allocate(sz, &p));
+  auto *buf = static_cast<uint8_t *>(p);
+  buf[0] = 1;
+  buf[sz - 1] = 2;
+  mp_->Deallocate(p);
+  SizeClassPool::Stats stats = mp_->GetStats();
+  EXPECT_EQ(stats.large_allocs, 1);
+  EXPECT_EQ(stats.cached_bytes, 0);
+}
+
+TEST_F(MindDataTestSizeClassPool, TestReallocate) {
+  void *p = nullptr;
+  ASSERT_OK(mp_->Allocate(100, &p));
+  auto *buf = static_cast<uint8_t *>(p);
+  for (int i = 0; i < 100; i++) {
+    buf[i] = static_cast<uint8_t>(i);
+  }
+  // still fits the 112 bytes class
+  ASSERT_OK(mp_->Reallocate(&p, 100, 110));
+  EXPECT_EQ(static_cast<uint8_t *>(p), buf);
+  ASSERT_OK(mp_->Reallocate(&p, 110, 5000));
+  buf = static_cast<uint8_t *>(p);
+  for (int i = 0; i < 100; i++) {
+    ASSERT_EQ(buf[i], i);
+  }
+  mp_->Deallocate(p);
+}
+
+TEST_F(MindDataTestSizeClassPool, TestCrossThread) {
+  const int kNumThreads = 4;
+  const int kNumBlocks = 200;
+  // blocks are allocated by one thread and freed by another, like tensors handed from one op to the next
+  std::vector<std::vector<void *>> blocks(kNumThreads, std::vector<void *>(kNumBlocks, nullptr));
+  std::vector<std::thread> producers;
+  for (int t = 0; t < kNumThreads; t++) {
+    producers.emplace_back([this, &blocks, t]() {
+      for (int i = 0; i < kNumBlocks; i++) {
+        size_t sz = 200 * 1024 + (i % 4) * 1024;
+        if (mp_->Allocate(sz, &blocks[t][i]).IsOk()) {
+          *static_cast<int *>(blocks[t][i]) = i;
+        }
+      }
+    });
+  }
+  for (auto &th : producers) {
+    th.join();
+  }
+  std::vector<std::thread> consumers;
+  for (int t = 0; t < kNumThreads; t++) {
+    consumers.emplace_back([this, &blocks, t]() {
+      for (int i = 0; i < kNumBlocks; i++) {
+        mp_->Deallocate(blocks[(t + 1) % kNumThreads][i]);
+      }
+    });
+  }
+  for (auto &th : consumers) {
+    th.join();
+  }
+  for (int t = 0; t < kNumThreads; t++) {
+    for (int i = 0; i < kNumBlocks; i++) {
+      ASSERT_NE(blocks[t][i], nullptr);
+    }
+  }
+  SizeClassPool::Stats stats = mp_->GetStats();
+  EXPECT_EQ(stats.hits + stats.misses, kNumThreads * kNumBlocks);
+  // the freeing threads spilled their excess to the central lists, so this thread is served from there
+  void *p = nullptr;
+  ASSERT_OK(mp_->Allocate(200 * 1024, &p));
+  EXPECT_EQ(mp_->GetStats().hits, stats.hits + 1);
+  mp_->Deallocate(p);
+}
+
+TEST_F(MindDataTestSizeClassPool, TestMaxCachedBytes) {
+  const size_t kBlockSize = 64 * 1024;
+  // room for two blocks only
+  auto pool = std::make_shared<SizeClassPool>(std::make_shared<SystemPool>(), 2 * kBlockSize);
+  std::vector<void *> blocks(4, nullptr);
+  for (auto &p : blocks) {
+    ASSERT_OK(pool->Allocate(kBlockSize, &p));
+  }
+  for (auto p : blocks) {
+    pool->Deallocate(p);
+  }
+  SizeClassPool::Stats stats = pool->GetStats();
+  EXPECT_EQ(stats.cached_bytes, 2 * kBlockSize);
+  EXPECT_EQ(stats.releases, 2);
+}
+
+TEST_F(MindDataTestSizeClassPool, TestTrimIdle) {
+  void *p = nullptr;
+  void *q = nullptr;
+  ASSERT_OK(mp_->Allocate(1000, &p));
+  ASSERT_OK(mp_->Allocate(100000, &q));
+  mp_->Deallocate(p);
+  mp_->Deallocate(q);
+  // both classes were used since the pool was created
+  mp_->TrimIdle();
+  EXPECT_EQ(mp_->GetStats().cached_bytes, SizeClassPool::RoundUp(1000) + SizeClassPool::RoundUp(100000));
+  // only the class of 1000 is used again, the other one is idle on the next trim
+  ASSERT_OK(mp_->Allocate(1000, &p));
+  mp_->Deallocate(p);
+  mp_->TrimIdle();
+  EXPECT_EQ(mp_->GetStats().cached_bytes, SizeClassPool::RoundUp(1000));
+  mp_->TrimIdle();
+  EXPECT_EQ(mp_->GetStats().cached_bytes, 0);
+}
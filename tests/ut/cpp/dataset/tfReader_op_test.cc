@@ -323,6 +323,68 @@ TEST_F(MindDataTestTFReaderOp, TestTFReaderTake1Buffer) {
   ASSERT_EQ(row_count, 5);
 }
 
+namespace {
+// Read all the rows of testTFTestAllTypes with one worker, so the rows are in the order of the file.
+void ReadAllTypesRows(const std::string &datasets_root_path, bool use_mmap, bool verify_crc,
+                      std::vector<TensorRow> *rows) {
+  auto my_tree = std::make_shared<ExecutionTree>();
+  std::string dataset_path = datasets_root_path + "/testTFTestAllTypes/test.data";
+
+  std::shared_ptr<ConfigManager> config_manager = GlobalContext::config_manager();
+  bool original_mmap = config_manager->enable_tf_reader_mmap();
+  bool original_verify_crc = config_manager->tf_reader_verify_crc();
+  config_manager->set_enable_tf_reader_mmap(use_mmap);
+  config_manager->set_tf_reader_verify_crc(verify_crc);
+  int32_t op_connector_size = config_manager->op_connector_size();
+  int32_t num_workers = 1;
+  int32_t worker_connector_size = config_manager->worker_connector_size();
+  std::vector<std::string> files = {dataset_path};
+  std::vector<std::string> columns_to_load = {};
+
+  std::unique_ptr<DataSchema> schema = std::make_unique<DataSchema>();
+  schema->LoadSchemaFile(datasets_root_path + "/testTFTestAllTypes/datasetSchema.json", {});
+  std::shared_ptr<TFReaderOp> my_tfreader_op =
+    std::make_shared<TFReaderOp>(num_workers, worker_connector_size, 0, files, std::move(schema), op_connector_size,
+                                 columns_to_load, false, 1, 0, false);
+  config_manager->set_enable_tf_reader_mmap(original_mmap);
+  config_manager->set_tf_reader_verify_crc(original_verify_crc);
+  ASSERT_OK(my_tfreader_op->Init());
+  ASSERT_OK(my_tree->AssociateNode(my_tfreader_op));
+  ASSERT_OK(my_tree->AssignRoot(my_tfreader_op));
+  ASSERT_OK(my_tree->Prepare());
+  ASSERT_OK(my_tree->Launch());
+
+  DatasetIterator di(my_tree);
+  TensorRow tensor_list;
+  ASSERT_OK(di.FetchNextTensorRow(&tensor_list));
+  while (!tensor_list.empty()) {
+    rows->push_back(tensor_list);
+    ASSERT_OK(di.FetchNextTensorRow(&tensor_list));
+  }
+}
+}  // namespace
+
+/// Feature: TFReaderOp
+/// Description: Test TFReaderOp reading through mmap with crc verification enabled
+/// Expectation: The same rows as the ifstream reader are returned, with the file name given by the user as the path
+TEST_F(MindDataTestTFReaderOp, TestTFReaderMmapVerifyCrc) {
+  std::vector<TensorRow> stream_rows;
+  std::vector<TensorRow> mmap_rows;
+  ReadAllTypesRows(datasets_root_path_, false, false, &stream_rows);
+  ReadAllTypesRows(datasets_root_path_, true, true, &mmap_rows);
+
+  ASSERT_EQ(stream_rows.size(), 12);
+  ASSERT_EQ(mmap_rows.size(), stream_rows.size());
+  std::string dataset_path = datasets_root_path_ + "/testTFTestAllTypes/test.data";
+  for (size_t i = 0; i < stream_rows.size(); i++) {
+    ASSERT_EQ(mmap_rows[i].size(), stream_rows[i].size());
+    for (size_t j = 0; j < stream_rows[i].size(); j++) {
+      EXPECT_TRUE(*mmap_rows[i][j] == *stream_rows[i][j]) << "row " << i << " column " << j << " differs.";
+    }
+    EXPECT_EQ(stream_rows[i].getPath(), std::vector<std::string>(stream_rows[i].size(), dataset_path));
+    EXPECT_EQ(mmap_rows[i].getPath(), stream_rows[i].getPath());
+  }
+}
 
 TEST_F(MindDataTestTFReaderOp, TestTotalRowsBasic) {
   std::string tf_file = datasets_root_path_ + "/testTFTestAllTypes/test.data";
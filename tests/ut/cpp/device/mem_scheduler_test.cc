@@ -16,11 +16,13 @@
 
 #include <vector>
 #include <map>
+#include <memory>
 #include "common/common_test.h"
 #include "runtime/device/memory_scheduler.h"
 namespace mindspore::device {
 constexpr size_t kDeviceMemSize = 5;
 constexpr size_t kMaxVirtualCount = 1024;
+constexpr size_t kFileOffloadDeviceMemSize = 3;
 class MemHandlerImpl : public MemHandler {
  public:
   MemHandlerImpl() {
@@ -75,6 +77,54 @@ class MemHandlerImpl : public MemHandler {
   std::map<void *, size_t> host_mem_size_;
 };
 
+// The mem handler which really copies the memory, to check the data swapped out and in.
+class CopyMemHandlerImpl : public MemHandler {
+ public:
+  explicit CopyMemHandlerImpl(size_t device_mem_num) : device_mem_num_(device_mem_num) {}
+
+  size_t GetAvailableMemSize() override { return device_mem_num_; }
+
+  void *MallocDevice(size_t mem_size) override {
+    if (device_mem_.size() >= device_mem_num_) {
+      return nullptr;
+    }
+    auto mem = std::make_unique<uint8_t[]>(mem_size);
+    auto ret = mem.get();
+    device_mem_.emplace(ret, std::move(mem));
+    return ret;
+  }
+
+  void FreeDevice(void *ptr) override { device_mem_.erase(ptr); }
+
+  void *MallocHost(size_t mem_size) override {
+    auto mem = std::make_unique<uint8_t[]>(mem_size);
+    auto ret = mem.get();
+    host_mem_.emplace(ret, std::move(mem));
+    max_host_mem_num_ = std::max(max_host_mem_num_, host_mem_.size());
+    return ret;
+  }
+
+  void FreeHost(void *ptr) override { host_mem_.erase(ptr); }
+
+  void SwapIn(const void *host_ptr, void *device_ptr, size_t mem_size, void *stream) override {
+    (void)memcpy(device_ptr, host_ptr, mem_size);
+  }
+
+  void SwapOut(const void *device_ptr, void *host_ptr, size_t mem_size, void *stream) override {
+    (void)memcpy(host_ptr, device_ptr, mem_size);
+  }
+
+  size_t max_host_mem_num() const { return max_host_mem_num_; }
+
+  void ResetMaxHostMemNum() { max_host_mem_num_ = host_mem_.size(); }
+
+ private:
+  size_t device_mem_num_;
+  std::map<void *, std::unique_ptr<uint8_t[]>> device_mem_;
+  std::map<void *, std::unique_ptr<uint8_t[]>> host_mem_;
+  size_t max_host_mem_num_{0};
+};
+
 class TestMemScheduler : public UT::Common {
  public:
   TestMemScheduler() {}
@@ -119,6 +169,33 @@ class TestMemScheduler : public UT::Common {
       scheduler->PostCompute(stream);
     }
   }
+
+  // Run and check the data of tensors, in which the tensor i holds the value i + 1 since its first use.
+  void RunAndCheckData(const std::shared_ptr<MemScheduler> &scheduler) {
+    void *stream = nullptr;
+    scheduler->Reset();
+    scheduler->Update();
+    for (auto index : init_tensors_) {
+      scheduler->Init(tensor_keys_.data() + index, tensor_datas_.data() + index, 1, kMemPriorityHigh);
+    }
+    std::vector<bool> produced(used_tensor_num_, false);
+    for (auto index : init_tensors_) {
+      produced[index] = true;
+    }
+    for (size_t i = 0; i < total_step_; ++i) {
+      ASSERT_TRUE(scheduler->PreCompute(stream));
+      for (auto j : step_used_tensors_[i]) {
+        auto addr = static_cast<uint8_t *>(scheduler->GetOrMalloc(tensor_keys_.data() + j, 1));
+        ASSERT_NE(addr, nullptr);
+        if (!produced[j]) {
+          *addr = static_cast<uint8_t>(j + 1);
+          produced[j] = true;
+        }
+        ASSERT_EQ(*addr, j + 1);
+      }
+      ASSERT_TRUE(scheduler->PostCompute(stream));
+    }
+  }
 };
 
 /// Feature: MemSchedulerManager
@@ -232,4 +309,39 @@ TEST_F(TestMemScheduler, test_manual_mem_scheduler) {
   // run
   Run(scheduler);
 }
-}  // namespace mindspore::device
\ No newline at end of file
+
+/// Feature: MemScheduler
+/// Description: Test MemScheduler offloading memory to file when the host memory is limited
+/// Expectation: the data swapped out to file is the same after swapped in, and the host memory used is limited
+TEST_F(TestMemScheduler, test_file_offload_mem_scheduler) {
+  MemSchedulerManager mem_scheduler_manager;
+  auto scheduler = mem_scheduler_manager.GetOrCreateMemScheduler(0);
+  ASSERT_NE(scheduler, nullptr);
+  auto mem_handler = std::make_shared<CopyMemHandlerImpl>(kFileOffloadDeviceMemSize);
+  scheduler->SetMemHandler(mem_handler);
+  ASSERT_TRUE(scheduler->EnableFileOffload(".", 1));
+
+  // input data
+  used_tensor_num_ = 10;
+  total_step_ = 8;
+  std::vector<uint8_t> tensor_keys(used_tensor_num_, 0);
+  std::vector<uint8_t> tensor_datas(used_tensor_num_, 0);
+  std::vector<size_t> init_tensors = {};
+  // The same tensor usage as above, and only 3 tensors can be kept in device at the same time.
+  std::vector<std::vector<size_t>> step_used_tensors = {{0, 1},    {1, 2, 3}, {3, 4, 5}, {5, 6},
+                                                        {4, 6, 7}, {3, 7, 8}, {2, 8, 9}, {1, 9}};
+  tensor_keys_.swap(tensor_keys);
+  tensor_datas_.swap(tensor_datas);
+  init_tensors_.swap(init_tensors);
+  step_used_tensors_.swap(step_used_tensors);
+  scheduler->SetTotalStep(total_step_);
+
+  Record(scheduler);
+  ASSERT_TRUE(scheduler->Optimize());
+  mem_handler->ResetMaxHostMemNum();
+  RunAndCheckData(scheduler);
+  RunAndCheckData(scheduler);
+  // Without the file, 3 tensors are kept in host at the same time.
+  EXPECT_LE(mem_handler->max_host_mem_num(), 1);
+}
+}  // namespace mindspore::device
@@ -328,6 +328,68 @@ TEST_F(TCPTest, SendLargeMessages) {
   server->Finalize();
 }
 
+/// Feature: test sending the message body by scatter-gather without copying.
+/// Description: send a message whose body is referenced by buffers of the client.
+/// Expectation: the buffers are received as one body in order, and the releaser is called after sending.
+TEST_F(TCPTest, SendZeroCopyMessage) {
+  Init();
+
+  // Start the tcp server.
+  std::unique_ptr<TCPServer> server = std::make_unique<TCPServer>();
+  bool ret = server->Initialize();
+  ASSERT_TRUE(ret);
+
+  size_t buffer_size = 512000;
+  std::atomic<bool> body_checked(false);
+  server->SetMessageHandler([&body_checked, buffer_size](MessageBase *const message) -> MessageBase *const {
+    const auto &body = message->Body();
+    if (message->body_buffers.empty() && body.size() == buffer_size * 2) {
+      body_checked = body[0] == 'A' && body[buffer_size - 1] == 'A' && body[buffer_size] == 'B' &&
+                     body[buffer_size * 2 - 1] == 'B';
+    }
+    delete message;
+    IncrDataMsgNum(1);
+    return NULL_MSG;
+  });
+
+  // Start the tcp client.
+  auto client_url = "127.0.0.1:1234";
+  std::unique_ptr<TCPClient> client = std::make_unique<TCPClient>();
+  ret = client->Initialize();
+  ASSERT_TRUE(ret);
+
+  auto ip = server->GetIP();
+  auto port = server->GetPort();
+  auto server_url = ip + ":" + std::to_string(port);
+  client->Connect(server_url);
+
+  // Send the message whose body refers to two buffers of the client.
+  std::string buffer_a(buffer_size, 'A');
+  std::string buffer_b(buffer_size, 'B');
+  std::atomic<bool> released(false);
+  auto message = CreateMessage(server_url, client_url, 0);
+  message->AppendBodyBuffer(buffer_a.data(), buffer_a.size());
+  message->AppendBodyBuffer(buffer_b.data(), buffer_b.size());
+  message->SetBodyReleaser([&released]() { released = true; });
+  client->SendAsync(std::move(message));
+
+  // Wait timeout: 5s
+  WaitForDataMsg(1, 5);
+  for (int i = 0; i < 50 && !released; ++i) {
+    usleep(100000);
+  }
+
+  // Check result
+  EXPECT_EQ(1, GetDataMsgNum());
+  EXPECT_TRUE(body_checked);
+  EXPECT_TRUE(released);
+
+  // Destroy
+  client->Disconnect(server_url);
+  client->Finalize();
+  server->Finalize();
+}
+
 /// Feature: test creating many TCP connections.
 /// Description: create many servers and clients, then connect each client to a server.
 /// Expectation: all the servers and clients are created successfully.
@@ -14,10 +14,14 @@
  * limitations under the License.
  */
 
+#include <algorithm>
 #include <cstring>
+#include <fstream>
 #include <functional>
 #include <iostream>
 #include <memory>
+#include <numeric>
+#include <random>
 #include <string>
 #include <vector>
 
@@ -45,6 +49,7 @@ class TestShardReader : public UT::Common {
       string db_name = std::string("./imagenet.shard0") + std::to_string(i) + ".db";
       remove(common::SafeCStr(filename));
       remove(common::SafeCStr(db_name));
+      remove(common::SafeCStr(ShardIndexSnapshot::GetSnapshotPath(filename)));
     }
   }
 };
@@ -243,5 +248,185 @@ TEST_F(TestShardReader, TestShardReaderConsumer) {
   }
   dataset.Close();
 }
+
+TEST_F(TestShardReader, TestShardReaderColumnarLabel) {
+  MS_LOG(INFO) << FormatInfo("Test read imageNet with columnar label store");
+  std::string file_name = "./imagenet.shard01";
+  auto column_list = std::vector<std::string>{"file_name"};
+
+  ShardReader expected;
+  EXPECT_TRUE(expected.Open({file_name}, true, 4, column_list).IsOk());
+  EXPECT_EQ(expected.GetLabelStore(), nullptr);
+  expected.Launch();
+
+  ShardReader dataset;
+  dataset.SetColumnarLabel(true);
+  EXPECT_TRUE(dataset.Open({file_name}, true, 4, column_list).IsOk());
+  auto label_store = dataset.GetLabelStore();
+  ASSERT_NE(label_store, nullptr);
+  EXPECT_EQ(label_store->Size(), dataset.GetNumRows());
+  EXPECT_TRUE(label_store->HasColumn("file_name"));
+  dataset.Launch();
+
+  int64_t count = 0;
+  while (true) {
+    auto x = dataset.GetNext();
+    auto y = expected.GetNext();
+    ASSERT_EQ(x.size(), y.size());
+    if (x.empty()) break;
+    for (size_t i = 0; i < x.size(); ++i) {
+      EXPECT_EQ(std::get<0>(x[i]), std::get<0>(y[i]));
+      EXPECT_EQ(std::get<1>(x[i]), std::get<1>(y[i]));
+    }
+    count++;
+  }
+  EXPECT_EQ(count, dataset.GetNumRows());
+
+  // Random access returns the blob only, the fields are read from the label store by task id.
+  auto row = dataset.GetNextById(0, 0);
+  ASSERT_EQ(row.second.size(), 1);
+  EXPECT_TRUE(std::get<1>(row.second[0]).is_null());
+  const unsigned char *data = nullptr;
+  uint64_t n_bytes = 0;
+  EXPECT_TRUE(label_store->GetColumn(0, "file_name", &data, &n_bytes).IsOk());
+  json fields;
+  EXPECT_TRUE(label_store->GetRowAsJson(0, &fields).IsOk());
+  EXPECT_EQ(std::string(reinterpret_cast<const char *>(data), n_bytes), fields["file_name"].get<std::string>());
+  EXPECT_FALSE(label_store->GetColumn(label_store->Size(), "file_name", &data, &n_bytes).IsOk());
+
+  dataset.Close();
+  expected.Close();
+}
+
+TEST_F(TestShardReader, TestShardReaderIndexSnapshot) {
+  MS_LOG(INFO) << FormatInfo("Test read imageNet with index snapshot");
+  std::string file_name = "./imagenet.shard01";
+  auto column_list = std::vector<std::string>{"file_name"};
+  auto read_all = [&file_name, &column_list](bool index_snapshot) {
+    std::vector<json> rows;
+    ShardReader dataset;
+    dataset.SetIndexSnapshot(index_snapshot);
+    EXPECT_TRUE(dataset.Open({file_name}, true, 4, column_list).IsOk());
+    dataset.Launch();
+    while (true) {
+      auto x = dataset.GetNext();
+      if (x.empty()) break;
+      for (auto &j : x) {
+        rows.push_back(std::get<1>(j));
+      }
+    }
+    dataset.Close();
+    return rows;
+  };
+  auto expected = read_all(false);
+  auto snapshot_path = ShardIndexSnapshot::GetSnapshotPath(file_name);
+  EXPECT_FALSE(std::ifstream(snapshot_path).good());
+
+  // The first run saves the snapshot, the second one reads it.
+  EXPECT_EQ(read_all(true), expected);
+  EXPECT_TRUE(std::ifstream(snapshot_path).good());
+  EXPECT_EQ(read_all(true), expected);
+
+  // A damaged snapshot is ignored and rewritten.
+  {
+    std::ofstream fs(snapshot_path, std::ios::out | std::ios::binary | std::ios::trunc);
+    fs << "broken";
+  }
+  EXPECT_EQ(read_all(true), expected);
+  std::vector<std::vector<uint64_t>> offsets;
+  auto label_store = std::make_shared<ShardLabelStore>(column_list, std::vector<ColumnDataType>{ColumnString});
+  EXPECT_TRUE(ShardIndexSnapshot::Load(file_name, 0, column_list, label_store, &offsets).IsOk());
+  EXPECT_EQ(offsets.size(), expected.size());
+
+  // A snapshot of other columns does not match.
+  auto other_store = std::make_shared<ShardLabelStore>(std::vector<std::string>{"label"},
+                                                       std::vector<ColumnDataType>{ColumnInt32});
+  EXPECT_FALSE(ShardIndexSnapshot::Load(file_name, 0, {"label"}, other_store, &offsets).IsOk());
+}
+
+TEST_F(TestShardReader, TestShardReaderIoMode) {
+  MS_LOG(INFO) << FormatInfo("Test random access of imageNet with asynchronous blob reads");
+  std::string file_name = "./imagenet.shard01";
+  auto read_by_ids = [&file_name](IoMode io_mode, const std::vector<int64_t> &task_ids) {
+    std::vector<TASK_CONTENT> rows;
+    ShardReader dataset;
+    dataset.SetIoMode(io_mode, 8);
+    EXPECT_TRUE(dataset.Open({file_name}, true, 2).IsOk());
+    EXPECT_TRUE(dataset.Launch(true).IsOk());
+    EXPECT_EQ(dataset.GetIoQueueDepth(), io_mode == IoMode::kStream ? 1 : 8);
+    EXPECT_TRUE(dataset.GetNextByIds(task_ids, 1, &rows).IsOk());
+    dataset.Close();
+    return rows;
+  };
+
+  ShardReader expected;
+  EXPECT_TRUE(expected.Open({file_name}, true, 2).IsOk());
+  EXPECT_TRUE(expected.Launch(true).IsOk());
+  std::vector<int64_t> task_ids(expected.GetNumRows());
+  std::iota(task_ids.begin(), task_ids.end(), 0);
+  std::shuffle(task_ids.begin(), task_ids.end(), std::mt19937(0));
+  std::vector<TASK_CONTENT> expected_rows;
+  for (auto task_id : task_ids) {
+    expected_rows.push_back(expected.GetNextById(task_id, 0));
+  }
+  expected.Close();
+
+  // The thread pool is always available, io_uring falls back to it on kernels without support.
+  for (auto io_mode : {IoMode::kStream, IoMode::kThreadPool, IoMode::kIoUring}) {
+    auto rows = read_by_ids(io_mode, task_ids);
+    ASSERT_EQ(rows.size(), expected_rows.size());
+    for (size_t i = 0; i < rows.size(); ++i) {
+      EXPECT_EQ(rows[i].first, expected_rows[i].first);
+      EXPECT_EQ(rows[i].second, expected_rows[i].second);
+    }
+  }
+}
+
+TEST_F(TestShardReader, TestShardReaderIoModeBatches) {
+  MS_LOG(INFO) << FormatInfo("Test shuffled batch reads of imageNet for each io mode");
+  std::string file_name = "./imagenet.shard01";
+  const int kRounds = 2;
+  std::vector<int64_t> bytes_per_mode;
+  for (auto io_mode : {IoMode::kStream, IoMode::kThreadPool, IoMode::kIoUring}) {
+    ShardReader dataset;
+    dataset.SetIoMode(io_mode);
+    ASSERT_TRUE(dataset.Open({file_name}, true, 1).IsOk());
+    ASSERT_TRUE(dataset.Launch(true).IsOk());
+    std::vector<int64_t> task_ids(dataset.GetNumRows());
+    std::iota(task_ids.begin(), task_ids.end(), 0);
+    std::mt19937 rng(0);
+    auto depth = static_cast<size_t>(dataset.GetIoQueueDepth());
+
+    // Every batch of the queue depth gets a row for each id, whatever the order of the ids.
+    int64_t n_bytes = 0;
+    for (int round = 0; round < kRounds; ++round) {
+      std::shuffle(task_ids.begin(), task_ids.end(), rng);
+      for (size_t i = 0; i < task_ids.size(); i += depth) {
+        std::vector<int64_t> batch_ids(task_ids.begin() + i, task_ids.begin() + std::min(i + depth, task_ids.size()));
+        std::vector<TASK_CONTENT> rows;
+        ASSERT_TRUE(dataset.GetNextByIds(batch_ids, 0, &rows).IsOk());
+        ASSERT_EQ(rows.size(), batch_ids.size());
+        for (auto &row : rows) {
+          EXPECT_EQ(row.second.size(), 1);
+          for (auto &item : row.second) {
+            n_bytes += static_cast<int64_t>(std::get<0>(item).size());
+          }
+        }
+      }
+    }
+    EXPECT_GT(n_bytes, 0);
+    bytes_per_mode.push_back(n_bytes);
+
+    // A closed reader reports the interruption instead of returning fewer rows than asked for.
+    dataset.Close();
+    std::vector<TASK_CONTENT> rows;
+    auto rc = dataset.GetNextByIds({0, 1}, 0, &rows);
+    EXPECT_EQ(rc.StatusCode(), StatusCode::kMDInterrupted);
+    EXPECT_TRUE(rows.empty());
+  }
+  for (auto n_bytes : bytes_per_mode) {
+    EXPECT_EQ(n_bytes, bytes_per_mode[0]);
+  }
+}
 }  // namespace mindrecord
 }  // namespace mindspore
@@ -0,0 +1,174 @@
+/**
+ * Copyright 2022 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <memory>
+#include <vector>
+#include "common/common_test.h"
+#include "frontend/operator/ops.h"
+#include "runtime/device/kernel_info.h"
+#include "backend/common/session/kernel_graph_cache.h"
+#include "plugin/device/cpu/hal/device/cpu_static_mem_plan.h"
+
+namespace mindspore {
+namespace device {
+namespace cpu {
+using KernelGraph = session::KernelGraph;
+namespace {
+constexpr size_t kTensorSize = 1024;
+
+class TestDeviceAddress : public DeviceAddress {
+ public:
+  TestDeviceAddress(void *ptr, size_t size) : DeviceAddress(ptr, size) {}
+  ~TestDeviceAddress() {}
+  virtual bool SyncDeviceToHost(const ShapeVector &shape, size_t size, TypeId type, void *host_ptr) const {
+    return true;
+  }
+  virtual bool SyncHostToDevice(const ShapeVector &shape, size_t size, TypeId type, const void *host_ptr,
+                                const std::string &format) const {
+    return true;
+  }
+  virtual void *GetMutablePtr() const { return ptr_; }
+  virtual void ClearDeviceMemory() {}
+};
+
+CNodePtr NewKernel(const KernelGraphPtr &graph, const std::vector<AnfNodePtr> &inputs, size_t workspace_num) {
+  std::vector<AnfNodePtr> kernel_inputs{NewValueNode(prim::kPrimAdd)};
+  (void)kernel_inputs.insert(kernel_inputs.end(), inputs.begin(), inputs.end());
+  auto kernel = graph->NewCNode(kernel_inputs);
+  std::vector<int64_t> shp{16, 16};
+  kernel->set_abstract(std::make_shared<abstract::AbstractTensor>(kFloat32, shp));
+  auto kernel_info = std::make_shared<KernelInfo>();
+  (void)kernel_info->SetOutputAddr(std::make_shared<TestDeviceAddress>(nullptr, kTensorSize), 0);
+  for (size_t i = 0; i < workspace_num; ++i) {
+    (void)kernel_info->SetWorkspaceAddr(std::make_shared<TestDeviceAddress>(nullptr, kTensorSize), i);
+  }
+  kernel->set_kernel_info(kernel_info);
+  return kernel;
+}
+
+DeviceAddress *OutputAddress(const CNodePtr &kernel) {
+  auto kernel_info = dynamic_cast<KernelInfo *>(kernel->kernel_info());
+  return kernel_info->output_address_list()[0].get();
+}
+
+DeviceAddress *WorkspaceAddress(const CNodePtr &kernel) {
+  auto kernel_info = dynamic_cast<KernelInfo *>(kernel->kernel_info());
+  return kernel_info->workspace_address_list()[0].get();
+}
+
+// The graph: a -> (b, c) -> d(workspace) -> e, in which b and c may run concurrently.
+KernelGraphPtr NewDiamondGraph(std::vector<CNodePtr> *kernels) {
+  auto graph = std::make_shared<KernelGraph>();
+  std::vector<int64_t> shp{16, 16};
+  auto x = graph->NewParameter();
+  x->set_abstract(std::make_shared<abstract::AbstractTensor>(kFloat32, shp));
+  auto a = NewKernel(graph, {x, x}, 0);
+  auto b = NewKernel(graph, {a, a}, 0);
+  auto c = NewKernel(graph, {a, x}, 0);
+  auto d = NewKernel(graph, {b, c}, 1);
+  auto e = NewKernel(graph, {d, x}, 0);
+  auto return_node = graph->NewCNode({NewValueNode(prim::kPrimReturn), e});
+  graph->set_return(return_node);
+  *kernels = {a, b, c, d, e};
+  graph->set_execution_order(*kernels);
+  return graph;
+}
+}  // namespace
+
+class TestCPUStaticMemPlan : public UT::Common {
+ public:
+  TestCPUStaticMemPlan() {}
+};
+
+/// Feature: static memory plan of the cpu graph.
+/// Description: plan the memory of the graph: a -> (b, c) -> d(workspace) -> e, in which b and c may run concurrently.
+/// Expectation: the memory is reused only between the addresses whose users are ordered by the data dependency, and
+/// the graph output is not planned.
+TEST_F(TestCPUStaticMemPlan, PlanDiamondGraph) {
+  std::vector<CNodePtr> kernels;
+  auto graph = NewDiamondGraph(&kernels);
+  const auto &a = kernels[0];
+  const auto &b = kernels[1];
+  const auto &c = kernels[2];
+  const auto &d = kernels[3];
+  const auto &e = kernels[4];
+  ASSERT_TRUE(CPUStaticMemPlan::IsGraphSupported(graph.get()));
+
+  CPUStaticMemPlan mem_plan;
+  // The outputs of b and c conflict with each other and with a, the output of d can reuse a.
+  size_t arena_size = mem_plan.MemPlan(graph.get());
+  EXPECT_EQ(mem_plan.planned_address_num(), 5);
+  EXPECT_EQ(arena_size, 4 * kTensorSize);
+
+  std::vector<uint8_t> arena(arena_size);
+  mem_plan.MemAssign(arena.data());
+  auto a_ptr = OutputAddress(a)->GetPtr();
+  auto b_ptr = OutputAddress(b)->GetPtr();
+  auto c_ptr = OutputAddress(c)->GetPtr();
+  auto d_ptr = OutputAddress(d)->GetPtr();
+  auto d_workspace_ptr = WorkspaceAddress(d)->GetPtr();
+  EXPECT_NE(a_ptr, b_ptr);
+  EXPECT_NE(a_ptr, c_ptr);
+  EXPECT_NE(b_ptr, c_ptr);
+  EXPECT_NE(d_workspace_ptr, b_ptr);
+  EXPECT_NE(d_workspace_ptr, c_ptr);
+  EXPECT_NE(d_workspace_ptr, d_ptr);
+  EXPECT_EQ(d_ptr, a_ptr);
+  EXPECT_TRUE(OutputAddress(a)->is_ptr_persisted());
+  EXPECT_EQ(OutputAddress(a)->original_ref_count(), SIZE_MAX);
+  EXPECT_EQ(OutputAddress(e)->GetPtr(), nullptr);
+  EXPECT_FALSE(OutputAddress(e)->is_ptr_persisted());
+}
+
+/// Feature: static memory plan of the cpu graph with the compile cache.
+/// Description: plan the diamond graph, export the kernel graph cache and import it as the warm start does, after
+/// replacing the cached offsets by the ones without any reuse, then plan the same graph compiled again.
+/// Expectation: the second compile takes the offsets from the cache instead of planning them.
+TEST_F(TestCPUStaticMemPlan, ReusePlanOnWarmStart) {
+  auto &cache = session::KernelGraphCache::GetInstance();
+  cache.Clear();
+  cache.set_enable(true);
+  std::vector<CNodePtr> first_kernels;
+  auto first_graph = NewDiamondGraph(&first_kernels);
+  CPUStaticMemPlan first_plan;
+  EXPECT_EQ(first_plan.MemPlan(first_graph.get()), 4 * kTensorSize);
+  EXPECT_EQ(cache.memory_plan_num(), 1);
+
+  auto cache_json = cache.ToJson();
+  for (auto &plan : cache_json["memory_plans"].items()) {
+    auto &offsets = plan.value()["offsets"];
+    for (size_t i = 0; i < offsets.size(); ++i) {
+      offsets[i] = i * kTensorSize;
+    }
+  }
+  cache.Clear();
+  ASSERT_TRUE(cache.FromJson(cache_json));
+
+  std::vector<CNodePtr> second_kernels;
+  auto second_graph = NewDiamondGraph(&second_kernels);
+  CPUStaticMemPlan second_plan;
+  size_t arena_size = second_plan.MemPlan(second_graph.get());
+  EXPECT_EQ(arena_size, 5 * kTensorSize);
+  std::vector<uint8_t> arena(arena_size);
+  second_plan.MemAssign(arena.data());
+  // The output of d reuses the output of a in the planned offsets, but not in the cached ones.
+  EXPECT_NE(OutputAddress(second_kernels[3])->GetPtr(), OutputAddress(second_kernels[0])->GetPtr());
+  cache.set_enable(false);
+  cache.Clear();
+}
+}  // namespace cpu
+}  // namespace device
+}  // namespace mindspore
@@ -0,0 +1,142 @@
+/**
+ * Copyright 2022 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <unistd.h>
+#include <atomic>
+#include <functional>
+#include <thread>
+#include <vector>
+#include <gtest/gtest.h>
+#include "plugin/device/cpu/hal/hardware/ms_collective_shm.h"
+#include "common/common_test.h"
+
+namespace mindspore {
+namespace device {
+namespace cpu {
+class TestMSCollectiveShm : public UT::Common {
+ protected:
+  void SetUp() {}
+  void TearDown() {}
+
+  // Run the function on every local rank in its own thread with its own channel, and return the number of the ranks
+  // on which the function succeeds.
+  size_t RunLocalRanks(size_t local_rank_size, size_t slot_size,
+                       const std::function<bool(SharedMemoryChannel *)> &func) {
+    std::string name = "/mindspore_mccl_ut_" + std::to_string(getpid());
+    std::atomic<size_t> success_num{0};
+    std::vector<std::thread> threads;
+    for (size_t i = 0; i < local_rank_size; ++i) {
+      threads.emplace_back([&, i]() {
+        SharedMemoryChannel channel(name, i, local_rank_size, slot_size);
+        if (channel.Initialize() && func(&channel)) {
+          ++success_num;
+        }
+      });
+    }
+    for (auto &thread : threads) {
+      thread.join();
+    }
+    return success_num.load();
+  }
+};
+
+/// Feature: test the shared memory collectives of the cpu ranks on the same host.
+/// Description: all reduce the data larger than the slot, so that it's transferred piece by piece.
+/// Expectation: every local rank gets the sum of the data of all the local ranks.
+TEST_F(TestMSCollectiveShm, AllReduce) {
+  size_t local_rank_size = 4;
+  size_t data_num = 10000;
+  size_t slot_size = 4096;
+  auto ret = RunLocalRanks(local_rank_size, slot_size, [&](SharedMemoryChannel *channel) {
+    std::vector<float> input(data_num);
+    for (size_t j = 0; j < data_num; ++j) {
+      input[j] = static_cast<float>(channel->local_rank() + j);
+    }
+    std::vector<float> output(data_num);
+    if (!channel->AllReduce(input.data(), output.data(), data_num * sizeof(float), kNumberTypeFloat32)) {
+      return false;
+    }
+    // The input and the output can be the same.
+    if (!channel->AllReduce(input.data(), input.data(), data_num * sizeof(float), kNumberTypeFloat32)) {
+      return false;
+    }
+    for (size_t j = 0; j < data_num; ++j) {
+      float expect = static_cast<float>(local_rank_size * j + local_rank_size * (local_rank_size - 1) / 2);
+      if (output[j] != expect || input[j] != expect) {
+        return false;
+      }
+    }
+    return true;
+  });
+  ASSERT_EQ(local_rank_size, ret);
+}
+
+/// Feature: test the shared memory collectives of the cpu ranks on the same host.
+/// Description: broadcast the data from a non-zero root and all gather the data of the local ranks.
+/// Expectation: every local rank gets the data of the root and the data of all the local ranks in order.
+TEST_F(TestMSCollectiveShm, BroadcastAndAllGather) {
+  size_t local_rank_size = 3;
+  size_t data_num = 1000;
+  size_t slot_size = 1024;
+  size_t root = 1;
+  auto ret = RunLocalRanks(local_rank_size, slot_size, [&](SharedMemoryChannel *channel) {
+    auto local_rank = static_cast<int32_t>(channel->local_rank());
+    std::vector<int32_t> data(data_num, local_rank);
+    if (!channel->Broadcast(data.data(), data_num * sizeof(int32_t), root)) {
+      return false;
+    }
+    for (size_t j = 0; j < data_num; ++j) {
+      if (data[j] != static_cast<int32_t>(root)) {
+        return false;
+      }
+    }
+
+    std::vector<int32_t> input(data_num, local_rank);
+    std::vector<int32_t> output(data_num * local_rank_size);
+    if (!channel->AllGather(input.data(), output.data(), data_num * sizeof(int32_t))) {
+      return false;
+    }
+    for (size_t j = 0; j < output.size(); ++j) {
+      if (output[j] != static_cast<int32_t>(j / data_num)) {
+        return false;
+      }
+    }
+    return true;
+  });
+  ASSERT_EQ(local_rank_size, ret);
+}
+
+/// Feature: test the shared memory collectives of the cpu ranks on the same host.
+/// Description: one local rank waits at the barrier which the other local rank never arrives at.
+/// Expectation: the barrier fails after the wait timeout rather than blocking forever.
+TEST_F(TestMSCollectiveShm, BarrierTimeout) {
+  std::string name = "/mindspore_mccl_ut_timeout_" + std::to_string(getpid());
+  size_t wait_timeout = 1;
+  bool barrier_ret = true;
+  std::thread waiting_rank([&]() {
+    SharedMemoryChannel channel(name, 0, 2);
+    if (channel.Initialize(wait_timeout, wait_timeout)) {
+      barrier_ret = channel.Barrier();
+    }
+  });
+  SharedMemoryChannel channel(name, 1, 2);
+  ASSERT_TRUE(channel.Initialize(wait_timeout, wait_timeout));
+  waiting_rank.join();
+  ASSERT_FALSE(barrier_ret);
+}
+}  // namespace cpu
+}  // namespace device
+}  // namespace mindspore
@@ -0,0 +1,190 @@
+/**
+ * Copyright 2022 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "common/common_test.h"
+#include "ps/ps_cache/embedding_cache_policy.h"
+#include "ps/ps_cache/embedding_hash_map.h"
+
+namespace mindspore {
+namespace ps {
+class TestEmbeddingCachePolicy : public UT::Common {
+ public:
+  TestEmbeddingCachePolicy() = default;
+  virtual ~TestEmbeddingCachePolicy() = default;
+
+  void SetUp() override {}
+  void TearDown() override {}
+};
+
+namespace {
+// Use the id in the data step like PsCacheManager: record the access on hit, otherwise insert it. Return the id
+// swapped out, or INVALID_INDEX_VALUE if nothing is swapped out or no position can be found.
+int UseId(EmbeddingHashMap *hash_map, int id, size_t data_step, size_t graph_running_step,
+          bool *need_wait_graph = nullptr) {
+  const auto &hash_id_to_index = hash_map->hash_id_to_index();
+  auto iter = hash_id_to_index.find(id);
+  if (iter != hash_id_to_index.end()) {
+    hash_map->RecordAccess(iter->second, data_step);
+    return INVALID_INDEX_VALUE;
+  }
+  int swap_out_index = INVALID_INDEX_VALUE;
+  int swap_out_id = INVALID_INDEX_VALUE;
+  size_t swap_out_size = 0;
+  bool wait_graph = false;
+  auto index = hash_map->ParseData(id, &swap_out_index, &swap_out_id, data_step, graph_running_step, &swap_out_size,
+                                   &wait_graph);
+  if (need_wait_graph != nullptr) {
+    *need_wait_graph = wait_graph;
+  }
+  if (index == INVALID_INDEX_VALUE || swap_out_size == 0) {
+    return INVALID_INDEX_VALUE;
+  }
+  EXPECT_EQ(swap_out_index, index);
+  return swap_out_id;
+}
+
+// Keep the cached id in the data step without using it like the row swapped out of the device cache.
+void KeepId(EmbeddingHashMap *hash_map, int id, size_t data_step) {
+  const auto &hash_id_to_index = hash_map->hash_id_to_index();
+  auto iter = hash_id_to_index.find(id);
+  ASSERT_NE(iter, hash_id_to_index.end());
+  hash_map->RefreshStep(iter->second, data_step);
+}
+
+bool Cached(const EmbeddingHashMap &hash_map, int id) { return hash_map.hash_id_to_index().count(id) != 0; }
+}  // namespace
+
+/// Feature: Count-min sketch of the embedding cache admission.
+/// Description: Add the ids and estimate their frequencies until the counters are halved.
+/// Expectation: The estimation is exact without collisions, and all the counters are halved after the sample size.
+TEST_F(TestEmbeddingCachePolicy, CountMinSketch) {
+  const size_t sample_size = 10;
+  CountMinSketch sketch(1024, sample_size);
+  for (size_t i = 0; i < sample_size - 1; ++i) {
+    sketch.Add(7);
+  }
+  EXPECT_EQ(sketch.Estimate(7), sample_size - 1);
+  EXPECT_EQ(sketch.Estimate(8), 0);
+  sketch.Add(7);
+  EXPECT_EQ(sketch.Estimate(7), sample_size / 2);
+}
+
+/// Feature: LFU eviction of the embedding cache hash map.
+/// Description: Use three ids in several steps and one id only once, then insert new ids into the full hash map.
+/// Expectation: The id used once is evicted first though it isn't the least recently used one.
+TEST_F(TestEmbeddingCachePolicy, LFUEvictLeastFrequentlyUsed) {
+  // The front and back positions are reserved, so four ids can be cached.
+  EmbeddingHashMap hash_map(0, 6, kLFUCachePolicy);
+  for (int id = 1; id <= 4; ++id) {
+    EXPECT_EQ(UseId(&hash_map, id, 1, 1), INVALID_INDEX_VALUE);
+  }
+  for (size_t step = 2; step <= 3; ++step) {
+    for (int id = 1; id <= 3; ++id) {
+      EXPECT_EQ(UseId(&hash_map, id, step, step), INVALID_INDEX_VALUE);
+    }
+  }
+  EXPECT_EQ(UseId(&hash_map, 5, 4, 4), 4);
+  EXPECT_EQ(UseId(&hash_map, 6, 5, 5), 5);
+  EXPECT_TRUE(Cached(hash_map, 1));
+  EXPECT_TRUE(Cached(hash_map, 2));
+  EXPECT_TRUE(Cached(hash_map, 3));
+  EXPECT_EQ(hash_map.policy_statistics().evicted_count_, 2);
+}
+
+/// Feature: LFU eviction of the embedding cache hash map.
+/// Description: Insert the ids while the elements are used by the graph running step or the steps after it.
+/// Expectation: The element used by the graph running step is evicted after waiting for the graph, and no position is
+/// found if all the elements are used by the steps after the graph running step.
+TEST_F(TestEmbeddingCachePolicy, LFUWaitGraphRunning) {
+  EmbeddingHashMap hash_map(0, 4, kLFUCachePolicy);
+  EXPECT_EQ(UseId(&hash_map, 1, 1, 1), INVALID_INDEX_VALUE);
+  EXPECT_EQ(UseId(&hash_map, 2, 1, 1), INVALID_INDEX_VALUE);
+  bool need_wait_graph = false;
+  EXPECT_EQ(UseId(&hash_map, 3, 2, 1, &need_wait_graph), 1);
+  EXPECT_TRUE(need_wait_graph);
+  EXPECT_EQ(UseId(&hash_map, 4, 3, 2, &need_wait_graph), 2);
+  EXPECT_FALSE(need_wait_graph);
+  EXPECT_EQ(UseId(&hash_map, 5, 4, 2, &need_wait_graph), 3);
+  EXPECT_TRUE(need_wait_graph);
+  EXPECT_EQ(UseId(&hash_map, 6, 4, 2), INVALID_INDEX_VALUE);
+  EXPECT_FALSE(Cached(hash_map, 6));
+  EXPECT_TRUE(Cached(hash_map, 4));
+  EXPECT_TRUE(Cached(hash_map, 5));
+}
+
+/// Feature: LFU eviction of the embedding cache hash map.
+/// Description: Use three ids in two steps, and keep the fourth id in several later steps without using it.
+/// Expectation: Keeping the id only refreshes its step, so it's still evicted first as the least frequently used one.
+TEST_F(TestEmbeddingCachePolicy, LFUKeepIsNotAccess) {
+  EmbeddingHashMap hash_map(0, 6, kLFUCachePolicy);
+  for (int id = 1; id <= 4; ++id) {
+    EXPECT_EQ(UseId(&hash_map, id, 1, 1), INVALID_INDEX_VALUE);
+  }
+  for (int id = 1; id <= 3; ++id) {
+    EXPECT_EQ(UseId(&hash_map, id, 2, 2), INVALID_INDEX_VALUE);
+  }
+  for (size_t step = 3; step <= 5; ++step) {
+    KeepId(&hash_map, 4, step);
+  }
+  EXPECT_EQ(hash_map.hash_step(hash_map.hash_id_to_index().at(4)), 5);
+  EXPECT_EQ(UseId(&hash_map, 5, 6, 6), 4);
+  EXPECT_TRUE(Cached(hash_map, 1));
+}
+
+/// Feature: ARC eviction of the embedding cache hash map.
+/// Description: Use two hot ids in several steps, then scan many ids each of which is used only once.
+/// Expectation: The scan evicts the ids used once only, and the hot ids stay in the cache.
+TEST_F(TestEmbeddingCachePolicy, ARCResistScan) {
+  EmbeddingHashMap hash_map(0, 6, kARCCachePolicy);
+  for (size_t step = 1; step <= 3; ++step) {
+    EXPECT_EQ(UseId(&hash_map, 1, step, step), INVALID_INDEX_VALUE);
+    EXPECT_EQ(UseId(&hash_map, 2, step, step), INVALID_INDEX_VALUE);
+  }
+  const int scan_num = 10;
+  for (int i = 0; i < scan_num; ++i) {
+    auto step = static_cast<size_t>(i) + 4;
+    auto swap_out_id = UseId(&hash_map, 100 + i, step, step);
+    EXPECT_NE(swap_out_id, 1);
+    EXPECT_NE(swap_out_id, 2);
+  }
+  EXPECT_TRUE(Cached(hash_map, 1));
+  EXPECT_TRUE(Cached(hash_map, 2));
+  EXPECT_EQ(hash_map.policy_statistics().evicted_count_, scan_num - 2);
+}
+
+/// Feature: Count-min sketch admission of the embedding cache hash map.
+/// Description: Insert the ids with the admission threshold 2, use some of them again, and insert more ids.
+/// Expectation: The ids used again are promoted to the policy, and the ids used once are evicted before them.
+TEST_F(TestEmbeddingCachePolicy, AdmissionByFrequency) {
+  EmbeddingHashMap hash_map(0, 6, kLFUCachePolicy, 2);
+  EXPECT_EQ(UseId(&hash_map, 1, 1, 1), INVALID_INDEX_VALUE);
+  EXPECT_EQ(UseId(&hash_map, 2, 1, 1), INVALID_INDEX_VALUE);
+  EXPECT_EQ(UseId(&hash_map, 1, 2, 2), INVALID_INDEX_VALUE);
+  EXPECT_EQ(UseId(&hash_map, 2, 2, 2), INVALID_INDEX_VALUE);
+  EXPECT_EQ(UseId(&hash_map, 10, 3, 3), INVALID_INDEX_VALUE);
+  EXPECT_EQ(UseId(&hash_map, 11, 3, 3), INVALID_INDEX_VALUE);
+  EXPECT_EQ(UseId(&hash_map, 12, 4, 4), 10);
+  EXPECT_EQ(UseId(&hash_map, 13, 5, 5), 11);
+  EXPECT_EQ(UseId(&hash_map, 14, 6, 6), 12);
+  EXPECT_TRUE(Cached(hash_map, 1));
+  EXPECT_TRUE(Cached(hash_map, 2));
+  const auto &statistics = hash_map.policy_statistics();
+  EXPECT_EQ(statistics.probation_count_, 7);
+  EXPECT_EQ(statistics.promoted_count_, 2);
+  EXPECT_EQ(statistics.evicted_count_, 3);
+}
+}  // namespace ps
+}  // namespace mindspore
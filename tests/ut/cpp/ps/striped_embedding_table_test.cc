@@ -0,0 +1,115 @@
+/**
+ * Copyright 2022 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <atomic>
+#include <thread>
+#include <vector>
+#include "common/common_test.h"
+#include "ps/striped_embedding_table.h"
+
+namespace mindspore {
+namespace ps {
+class TestStripedEmbeddingTable : public UT::Common {
+ public:
+  TestStripedEmbeddingTable() = default;
+  virtual ~TestStripedEmbeddingTable() = default;
+
+  void SetUp() override {}
+  void TearDown() override {}
+};
+
+/// Feature: Striped embedding table of the parameter server.
+/// Description: Look up and update the rows of the shard with the ids in and out of the shard.
+/// Expectation: The rows are copied in the request order, the ids out of the shard get zeros on lookup and fail the
+/// update without modifying the table.
+TEST_F(TestStripedEmbeddingTable, LookupAndUpdate) {
+  size_t row_num = 10;
+  size_t row_size = 3;
+  int64_t offset = 100;
+  std::vector<float> data(row_num * row_size);
+  for (size_t i = 0; i < data.size(); ++i) {
+    data[i] = static_cast<float>(i);
+  }
+  StripedEmbeddingTable table(data.data(), row_num, row_size, offset, 4);
+  EXPECT_EQ(table.stripe_num(), 4);
+
+  std::vector<size_t> ids = {109, 100, 99, 104, 109};
+  std::vector<float> output(ids.size() * row_size, -1);
+  EXPECT_TRUE(table.Lookup(ids, output.data(), output.size()));
+  std::vector<float> expect = {27, 28, 29, 0, 1, 2, 0, 0, 0, 12, 13, 14, 27, 28, 29};
+  EXPECT_EQ(output, expect);
+
+  // The later one wins for the duplicated ids.
+  std::vector<size_t> update_ids = {101, 108, 101};
+  std::vector<float> values = {1, 1, 1, 8, 8, 8, 2, 2, 2};
+  EXPECT_TRUE(table.Update(update_ids, values.data(), values.size()));
+  EXPECT_EQ(data[3], 2);
+  EXPECT_EQ(data[24], 8);
+
+  std::vector<size_t> invalid_ids = {102, 110};
+  EXPECT_FALSE(table.Update(invalid_ids, values.data(), values.size()));
+  EXPECT_EQ(data[6], 6);
+  EXPECT_FALSE(table.Lookup(ids, output.data(), 1));
+}
+
+/// Feature: Striped embedding table of the parameter server.
+/// Description: Several threads look up and update the rows of the table concurrently.
+/// Expectation: Every row looked up is one written entirely by one update, never a mix of two updates.
+TEST_F(TestStripedEmbeddingTable, ConcurrentLookupAndUpdate) {
+  size_t row_num = 256;
+  size_t row_size = 64;
+  std::vector<float> data(row_num * row_size, 0);
+  StripedEmbeddingTable table(data.data(), row_num, row_size, 0);
+
+  size_t thread_num = 8;
+  size_t round_num = 200;
+  std::vector<size_t> ids(row_num);
+  for (size_t i = 0; i < row_num; ++i) {
+    ids[i] = (i * 7) % row_num;
+  }
+  std::atomic<size_t> failed_num{0};
+  std::vector<std::thread> threads;
+  for (size_t t = 0; t < thread_num; ++t) {
+    threads.emplace_back([&, t]() {
+      std::vector<float> buffer(row_num * row_size);
+      for (size_t r = 0; r < round_num; ++r) {
+        if (t % 2 == 0) {
+          std::fill(buffer.begin(), buffer.end(), static_cast<float>(t * round_num + r));
+          if (!table.Update(ids, buffer.data(), buffer.size())) {
+            ++failed_num;
+          }
+          continue;
+        }
+        if (!table.Lookup(ids, buffer.data(), buffer.size())) {
+          ++failed_num;
+        }
+        for (size_t i = 0; i < row_num; ++i) {
+          for (size_t j = 1; j < row_size; ++j) {
+            if (buffer[i * row_size + j] != buffer[i * row_size]) {
+              ++failed_num;
+            }
+          }
+        }
+      }
+    });
+  }
+  for (auto &thread : threads) {
+    thread.join();
+  }
+  EXPECT_EQ(failed_num.load(), 0);
+}
+}  // namespace ps
+}  // namespace mindspore
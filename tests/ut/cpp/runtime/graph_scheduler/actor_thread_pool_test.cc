@@ -0,0 +1,256 @@
+/**
+ * Copyright 2022 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <algorithm>
+#include <chrono>
+#include <memory>
+#include <set>
+#include <string>
+#include <thread>
+#include <vector>
+#include "common/common_test.h"
+#include "actor/actormgr.h"
+#include "actor/op_actor.h"
+#include "thread/actor_threadpool.h"
+
+namespace mindspore {
+namespace runtime {
+namespace {
+constexpr size_t kGraphWidth = 16;
+constexpr size_t kGraphDepth = 32;
+constexpr size_t kStepNum = 100;
+constexpr size_t kKernelLoop = 2000;
+constexpr size_t kFanOutNum = 8;
+constexpr size_t kFanOutThreadNum = 4;
+constexpr std::chrono::milliseconds kSlowKernelTime(20);
+
+// Stands in for the KernelActor of a small CPU op: it collects the outputs of its inputs for the step, launches a
+// tiny kernel, and sends the output along its data arrows, the same message path KernelActor takes. The kernel of a
+// slow actor also blocks its thread for the kernel time.
+class FakeKernelActor : public OpActor<int> {
+ public:
+  FakeKernelActor(const std::string &name, size_t input_num,
+                  std::chrono::milliseconds kernel_time = std::chrono::milliseconds(0))
+      : OpActor<int>(name), input_num_(input_num), kernel_time_(kernel_time) {}
+  ~FakeKernelActor() override = default;
+
+  void AddOutput(const AID &to, int to_input_index) {
+    output_data_arrows_.emplace_back(std::make_shared<DataArrow>(0, to, to_input_index));
+    output_datas_.emplace_back(std::make_unique<OpData<int>>(GetAID(), &output_, to_input_index));
+  }
+
+  void RunOpData(OpData<int> *input_data, OpContext<int> *context) override {
+    auto &input_datas = input_op_datas_[context->sequential_num_];
+    input_datas.push_back(input_data);
+    if (input_datas.size() < input_num_) {
+      return;
+    }
+    uint32_t value = 0;
+    for (auto data : input_datas) {
+      value += static_cast<uint32_t>(*data->data_);
+    }
+    (void)input_op_datas_.erase(context->sequential_num_);
+    for (size_t i = 0; i < kKernelLoop; ++i) {
+      value = value * 1664525u + 1013904223u;
+    }
+    if (kernel_time_.count() > 0) {
+      std::this_thread::sleep_for(kernel_time_);
+    }
+    run_thread_ = std::this_thread::get_id();
+    output_ = static_cast<int>(value);
+    if (output_data_arrows_.empty()) {
+      context->SetResult(0, MindrtStatus::KOK);
+      return;
+    }
+    for (size_t i = 0; i < output_data_arrows_.size(); ++i) {
+      Async(output_data_arrows_[i]->to_op_id_, &OpActor<int>::RunOpData, output_datas_[i].get(), context);
+    }
+  }
+
+  std::thread::id run_thread() const { return run_thread_; }
+
+ private:
+  size_t input_num_;
+  std::chrono::milliseconds kernel_time_;
+  std::thread::id run_thread_;
+  int output_{0};
+  std::vector<std::unique_ptr<OpData<int>>> output_datas_;
+};
+using FakeKernelActorPtr = std::shared_ptr<FakeKernelActor>;
+
+// Runs kStepNum steps of a graph of kGraphDepth layers of kGraphWidth actors, where every actor feeds two actors of
+// the next layer and the last layer feeds one sink, and returns the steps per second.
+double RunKernelActorGraph(size_t thread_num, bool work_stealing) {
+  auto pool = ActorThreadPool::CreateThreadPool(thread_num);
+  if (pool == nullptr) {
+    return 0;
+  }
+  pool->SetWorkStealing(work_stealing);
+  std::string prefix = "FakeKernelActor_" + std::to_string(thread_num) + "_" + std::to_string(work_stealing) + "_";
+
+  std::vector<std::vector<FakeKernelActorPtr>> layers(kGraphDepth);
+  for (size_t depth = 0; depth < kGraphDepth; ++depth) {
+    size_t input_num = depth == 0 ? 1 : 2;
+    for (size_t i = 0; i < kGraphWidth; ++i) {
+      auto name = prefix + std::to_string(depth) + "_" + std::to_string(i);
+      layers[depth].push_back(std::make_shared<FakeKernelActor>(name, input_num));
+    }
+  }
+  auto sink = std::make_shared<FakeKernelActor>(prefix + "sink", kGraphWidth);
+  std::vector<FakeKernelActorPtr> actors{sink};
+  for (size_t depth = 0; depth < kGraphDepth; ++depth) {
+    for (size_t i = 0; i < kGraphWidth; ++i) {
+      auto &actor = layers[depth][i];
+      if (depth + 1 < kGraphDepth) {
+        actor->AddOutput(layers[depth + 1][i]->GetAID(), 0);
+        actor->AddOutput(layers[depth + 1][(i + 1) % kGraphWidth]->GetAID(), 1);
+      } else {
+        actor->AddOutput(sink->GetAID(), static_cast<int>(i));
+      }
+      actors.push_back(actor);
+    }
+  }
+
+  auto actor_manager = ActorMgr::GetActorMgrRef();
+  for (auto &actor : actors) {
+    actor->set_thread_pool(pool);
+    (void)actor_manager->Spawn(actor);
+  }
+
+  std::vector<OpDataPtr<int>> input_datas;
+  int input_value = 1;
+  for (auto &actor : layers[0]) {
+    input_datas.emplace_back(std::make_shared<OpData<int>>(actor->GetAID(), &input_value, 0));
+  }
+  std::vector<OpDataPtr<int>> output_datas(1);
+  auto start = std::chrono::steady_clock::now();
+  bool success = true;
+  for (size_t step = 0; step < kStepNum; ++step) {
+    success = success && MindrtRun<int>(input_datas, &output_datas, nullptr, nullptr) == 0;
+  }
+  auto end = std::chrono::steady_clock::now();
+
+  for (auto &actor : actors) {
+    actor_manager->Terminate(actor->GetAID());
+  }
+  delete pool;
+  if (!success) {
+    return 0;
+  }
+  return kStepNum / std::chrono::duration<double>(end - start).count();
+}
+
+// Runs one step of an imbalanced graph: a source actor makes kFanOutNum slow actors ready at once, so they are all
+// queued on the worker of the source, and the slow actors feed one sink. Returns the seconds of the step and the
+// number of the threads which ran the slow actors.
+double RunFanOutGraph(size_t thread_num, bool work_stealing, size_t *run_thread_num) {
+  auto pool = ActorThreadPool::CreateThreadPool(thread_num);
+  if (pool == nullptr) {
+    return 0;
+  }
+  pool->SetWorkStealing(work_stealing);
+  std::string prefix = "FanOutActor_" + std::to_string(thread_num) + "_" + std::to_string(work_stealing) + "_";
+
+  auto source = std::make_shared<FakeKernelActor>(prefix + "source", 1);
+  auto sink = std::make_shared<FakeKernelActor>(prefix + "sink", kFanOutNum);
+  std::vector<FakeKernelActorPtr> slow_actors;
+  for (size_t i = 0; i < kFanOutNum; ++i) {
+    auto actor = std::make_shared<FakeKernelActor>(prefix + std::to_string(i), 1, kSlowKernelTime);
+    source->AddOutput(actor->GetAID(), 0);
+    actor->AddOutput(sink->GetAID(), static_cast<int>(i));
+    slow_actors.push_back(actor);
+  }
+  std::vector<FakeKernelActorPtr> actors{source, sink};
+  actors.insert(actors.end(), slow_actors.begin(), slow_actors.end());
+
+  auto actor_manager = ActorMgr::GetActorMgrRef();
+  for (auto &actor : actors) {
+    actor->set_thread_pool(pool);
+    (void)actor_manager->Spawn(actor);
+  }
+
+  int input_value = 1;
+  std::vector<OpDataPtr<int>> input_datas{std::make_shared<OpData<int>>(source->GetAID(), &input_value, 0)};
+  std::vector<OpDataPtr<int>> output_datas(1);
+  auto start = std::chrono::steady_clock::now();
+  bool success = MindrtRun<int>(input_datas, &output_datas, nullptr, nullptr) == 0;
+  auto end = std::chrono::steady_clock::now();
+
+  std::set<std::thread::id> run_threads;
+  for (auto &actor : slow_actors) {
+    run_threads.insert(actor->run_thread());
+  }
+  *run_thread_num = run_threads.size();
+  for (auto &actor : actors) {
+    actor_manager->Terminate(actor->GetAID());
+  }
+  delete pool;
+  if (!success) {
+    return 0;
+  }
+  return std::chrono::duration<double>(end - start).count();
+}
+}  // namespace
+
+class ActorThreadPoolTest : public UT::Common {
+ public:
+  ActorThreadPoolTest() {}
+};
+
+/// Feature: work stealing in the actor thread pool.
+/// Description: one actor makes several slow actors ready at once, which queues all of them on its own worker.
+/// Expectation: the idle workers steal the slow actors, so they run on several threads in much less time than running
+///     them one by one, and no slower than through the shared queue.
+TEST_F(ActorThreadPoolTest, StealFromImbalancedWorker) {
+  size_t thread_num = std::min<size_t>(std::thread::hardware_concurrency(), kFanOutThreadNum);
+  if (thread_num < 2) {
+    MS_LOG(WARNING) << "Work stealing needs at least two actor threads, skip the test.";
+    return;
+  }
+  size_t stealing_thread_num = 0;
+  double stealing = RunFanOutGraph(thread_num, true, &stealing_thread_num);
+  ASSERT_GT(stealing, 0);
+  size_t shared_queue_thread_num = 0;
+  double shared_queue = RunFanOutGraph(thread_num, false, &shared_queue_thread_num);
+  ASSERT_GT(shared_queue, 0);
+  MS_LOG(INFO) << "Actor threads: " << thread_num << ", seconds of the fan-out with work stealing: " << stealing
+               << " on " << stealing_thread_num << " threads, with the shared queue: " << shared_queue << " on "
+               << shared_queue_thread_num << " threads";
+
+  const double serial = kFanOutNum * std::chrono::duration<double>(kSlowKernelTime).count();
+  EXPECT_GT(stealing_thread_num, 1);
+  EXPECT_LT(stealing, 0.75 * serial);
+  // Both schedulers spread the slow actors over the same threads, the margin only absorbs the waking of the threads.
+  EXPECT_LT(stealing, shared_queue + 0.25 * serial);
+}
+
+/// Feature: work stealing in the actor thread pool.
+/// Description: benchmark a graph of small kernel actors with a growing number of actor threads, with and without
+///     stealing. Run it with --gtest_also_run_disabled_tests.
+/// Expectation: every step finishes, the steps per second are logged for both schedulers.
+TEST_F(ActorThreadPoolTest, DISABLED_KernelActorGraphScaling) {
+  size_t max_thread_num = std::max<size_t>(std::thread::hardware_concurrency(), 1);
+  for (size_t thread_num = 1; thread_num <= max_thread_num; thread_num *= 2) {
+    double shared_queue = RunKernelActorGraph(thread_num, false);
+    double stealing = RunKernelActorGraph(thread_num, true);
+    ASSERT_GT(shared_queue, 0);
+    ASSERT_GT(stealing, 0);
+    MS_LOG(INFO) << "Actor threads: " << thread_num << ", steps per second with the shared queue: " << shared_queue
+                 << ", with work stealing: " << stealing;
+  }
+}
+}  // namespace runtime
+}  // namespace mindspore
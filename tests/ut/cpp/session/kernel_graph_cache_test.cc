@@ -0,0 +1,159 @@
+/**
+ * Copyright 2022 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+#include "common/common_test.h"
+#include "frontend/operator/ops.h"
+#include "runtime/device/kernel_info.h"
+#include "backend/common/session/anf_runtime_algorithm.h"
+#include "backend/common/session/kernel_graph.h"
+#include "backend/common/session/kernel_graph_cache.h"
+
+namespace mindspore {
+namespace session {
+using KernelBuildInfoBuilder = kernel::KernelBuildInfo::KernelBuildInfoBuilder;
+
+namespace {
+// The graph of one Add kernel whose inputs are two float32 parameters.
+CNodePtr NewAddKernel(const KernelGraphPtr &graph) {
+  std::vector<int64_t> shp{2, 3};
+  auto x = graph->NewParameter();
+  x->set_abstract(std::make_shared<abstract::AbstractTensor>(kFloat32, shp));
+  auto y = graph->NewParameter();
+  y->set_abstract(std::make_shared<abstract::AbstractTensor>(kFloat32, shp));
+  auto kernel = graph->NewCNode({NewValueNode(prim::kPrimAdd), x, y});
+  kernel->set_abstract(std::make_shared<abstract::AbstractTensor>(kFloat32, shp));
+  kernel->set_kernel_info(std::make_shared<device::KernelInfo>());
+  return kernel;
+}
+}  // namespace
+
+class KernelGraphCacheTest : public UT::Common {
+ public:
+  KernelGraphCacheTest() = default;
+  void SetUp() override { KernelGraphCache::GetInstance().Clear(); }
+  void TearDown() override {
+    KernelGraphCache::GetInstance().set_enable(false);
+    KernelGraphCache::GetInstance().Clear();
+  }
+};
+
+/// Feature: kernel graph cache of the compile cache.
+/// Description: record the kernel build info and the memory plan, export them to json and import to the empty cache.
+/// Expectation: the imported records are the same as the recorded ones, and the memory plan of different block sizes
+/// misses.
+TEST_F(KernelGraphCacheTest, JsonRoundTrip) {
+  auto &cache = KernelGraphCache::GetInstance();
+  KernelBuildInfoBuilder builder;
+  builder.SetKernelType(KernelType::CPU_KERNEL);
+  builder.SetInputsFormat({kOpFormat_DEFAULT, kOpFormat_NCHW});
+  builder.SetInputsDeviceType({kNumberTypeFloat32, kNumberTypeInt32});
+  builder.SetOutputsFormat({kOpFormat_DEFAULT});
+  builder.SetOutputsDeviceType({kNumberTypeFloat16});
+  cache.RecordKernelBuildInfo("Add(k43,p34,)->(42,)", builder.Build());
+  cache.RecordMemoryPlan("cpu_5_1", {512, 1024}, {1024, 0});
+
+  auto cache_json = cache.ToJson();
+  cache.Clear();
+  ASSERT_EQ(cache.FetchKernelBuildInfo("Add(k43,p34,)->(42,)"), nullptr);
+  ASSERT_TRUE(cache.FromJson(cache_json));
+  EXPECT_EQ(cache.kernel_build_info_num(), 1);
+  EXPECT_EQ(cache.memory_plan_num(), 1);
+
+  auto build_info = cache.FetchKernelBuildInfo("Add(k43,p34,)->(42,)");
+  ASSERT_NE(build_info, nullptr);
+  EXPECT_EQ(build_info->kernel_type(), KernelType::CPU_KERNEL);
+  EXPECT_EQ(build_info->GetInputFormat(1), kOpFormat_NCHW);
+  EXPECT_EQ(build_info->GetInputDeviceType(1), kNumberTypeInt32);
+  EXPECT_EQ(build_info->GetOutputDeviceType(0), kNumberTypeFloat16);
+  // The fetched build info is a copy, modifying it doesn't change the cache.
+  build_info->SetOutputDeviceType(kNumberTypeFloat32, 0);
+  EXPECT_EQ(cache.FetchKernelBuildInfo("Add(k43,p34,)->(42,)")->GetOutputDeviceType(0), kNumberTypeFloat16);
+
+  std::vector<size_t> offsets;
+  ASSERT_TRUE(cache.FetchMemoryPlan("cpu_5_1", {512, 1024}, &offsets));
+  EXPECT_EQ(offsets, std::vector<size_t>({1024, 0}));
+  EXPECT_FALSE(cache.FetchMemoryPlan("cpu_5_1", {512, 512}, &offsets));
+  EXPECT_FALSE(cache.FetchMemoryPlan("cpu_5_2", {512, 1024}, &offsets));
+}
+
+/// Feature: kernel graph cache of the compile cache.
+/// Description: import the json exported by another version of MindSpore or another format version.
+/// Expectation: the json is rejected and nothing is imported.
+TEST_F(KernelGraphCacheTest, RejectOtherVersion) {
+  auto &cache = KernelGraphCache::GetInstance();
+  cache.RecordMemoryPlan("cpu_5_1", {512, 1024}, {1024, 0});
+  auto cache_json = cache.ToJson();
+  cache.Clear();
+
+  auto other_version_json = cache_json;
+  other_version_json["version"] = "0.0.0";
+  EXPECT_FALSE(cache.FromJson(other_version_json));
+  auto other_format_json = cache_json;
+  other_format_json["format_version"] = cache_json["format_version"].get<int>() + 1;
+  EXPECT_FALSE(cache.FromJson(other_format_json));
+  EXPECT_EQ(cache.memory_plan_num(), 0);
+  EXPECT_TRUE(cache.FromJson(cache_json));
+  EXPECT_EQ(cache.memory_plan_num(), 1);
+}
+
+/// Feature: kernel graph cache of the compile cache.
+/// Description: select the kernel of a graph, export the cache and import it as the warm start does, then select the
+/// kernel of the same graph compiled again.
+/// Expectation: the second compile takes the build info from the cache without running the kernel select, and the
+/// kernel select always runs when the cache is disabled.
+TEST_F(KernelGraphCacheTest, ReuseKernelSelectOnWarmStart) {
+  auto &cache = KernelGraphCache::GetInstance();
+  size_t select_num = 0;
+  auto select = [&select_num](const CNodePtr &kernel) {
+    ++select_num;
+    KernelBuildInfoBuilder builder;
+    builder.SetKernelType(KernelType::CPU_KERNEL);
+    builder.SetInputsFormat({kOpFormat_DEFAULT, kOpFormat_DEFAULT});
+    builder.SetInputsDeviceType({kNumberTypeFloat32, kNumberTypeFloat32});
+    builder.SetOutputsFormat({kOpFormat_DEFAULT});
+    builder.SetOutputsDeviceType({kNumberTypeFloat32});
+    AnfAlgo::SetSelectKernelBuildInfo(builder.Build(), kernel.get());
+    return std::pair<std::string, ExceptionType>();
+  };
+
+  cache.set_enable(true);
+  auto first_kernel = NewAddKernel(std::make_shared<KernelGraph>());
+  EXPECT_TRUE(cache.SelectKernelWithCache(first_kernel, select).first.empty());
+  EXPECT_EQ(select_num, 1);
+  EXPECT_EQ(cache.kernel_build_info_num(), 1);
+
+  auto cache_json = cache.ToJson();
+  cache.Clear();
+  ASSERT_TRUE(cache.FromJson(cache_json));
+  auto second_kernel = NewAddKernel(std::make_shared<KernelGraph>());
+  EXPECT_TRUE(cache.SelectKernelWithCache(second_kernel, select).first.empty());
+  EXPECT_EQ(select_num, 1);
+  auto build_info = AnfAlgo::GetSelectKernelBuildInfo(second_kernel);
+  ASSERT_NE(build_info, nullptr);
+  EXPECT_EQ(build_info->kernel_type(), KernelType::CPU_KERNEL);
+  EXPECT_EQ(build_info->GetOutputDeviceType(0), kNumberTypeFloat32);
+
+  cache.set_enable(false);
+  auto third_kernel = NewAddKernel(std::make_shared<KernelGraph>());
+  EXPECT_TRUE(cache.SelectKernelWithCache(third_kernel, select).first.empty());
+  EXPECT_EQ(select_num, 2);
+}
+}  // namespace session
+}  // namespace mindspore
@@ -206,3 +206,30 @@ class TestAutotuneWithProfiler:
                 pass
 
         ds.config.set_enable_autotune(False)
+
+    @staticmethod
+    def test_autotune_model_pipeline():
+        """
+        Feature: Autotuning
+        Description: test pipeline of autotune with the throughput model - Generator -> Map -> Batch
+        Expectation: pipeline runs successfully and the flag is restored
+        """
+        assert not ds.config.get_enable_autotune_model()
+        ds.config.set_enable_autotune(True)
+        ds.config.set_enable_autotune_model(True)
+        assert ds.config.get_enable_autotune_model()
+
+        source = [(np.array([x]),) for x in range(1024)]
+        data1 = ds.GeneratorDataset(source, ["data"])
+        data1 = data1.map(operations=[lambda x: x + 1], input_columns=["data"], num_parallel_workers=2)
+        data1 = data1.batch(32)
+
+        itr = data1.create_dict_iterator(num_epochs=5)
+        for _ in range(5):
+            for _ in itr:
+                pass
+
+        ds.config.set_enable_autotune_model(False)
+        ds.config.set_enable_autotune(False)
+        with pytest.raises(TypeError):
+            ds.config.set_enable_autotune_model(1)
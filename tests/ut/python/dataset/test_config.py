@@ -438,6 +438,27 @@ def test_multiprocessing_timeout_interval():
     assert saved_config == ds.config.get_multiprocessing_timeout_interval()
 
 
+def test_row_batch_size():
+    """
+    Feature: Test the function of get_row_batch_size and set_row_batch_size.
+    Description: Set the row batch size to valid values, the bounds and the invalid values.
+    Expectation: The default is 0, the valid values are got back, and the values out of [0, 4096] are rejected.
+    """
+    saved_config = ds.config.get_row_batch_size()
+    assert saved_config == 0
+    ds.config.set_row_batch_size(64)
+    assert ds.config.get_row_batch_size() == 64
+    ds.config.set_row_batch_size(4096)
+    assert ds.config.get_row_batch_size() == 4096
+    config_error_func(ds.config.set_row_batch_size, 4097, ValueError, "size is not within the required range")
+    config_error_func(ds.config.set_row_batch_size, -1, ValueError, "size is not within the required range")
+    config_error_func(ds.config.set_row_batch_size, 2.0, TypeError, "size isn't of type int")
+    # the rejected values don't change the config
+    assert ds.config.get_row_batch_size() == 4096
+    ds.config.set_row_batch_size(saved_config)
+    assert saved_config == ds.config.get_row_batch_size()
+
+
 def test_config_bool_type_error():
     """
     Feature: Now many interfaces of config support bool input even its valid input is int.
@@ -468,6 +489,9 @@ def test_config_bool_type_error():
     # set_multiprocessing_timeout_interval will raise TypeError if input is a boolean
     config_error_func(ds.config.set_multiprocessing_timeout_interval, True, TypeError, "interval isn't of type int")
 
+    # set_row_batch_size will raise TypeError if input is a boolean
+    config_error_func(ds.config.set_row_batch_size, True, TypeError, "size isn't of type int")
+
 
 if __name__ == '__main__':
     test_basic()
@@ -483,4 +507,5 @@ if __name__ == '__main__':
     test_auto_num_workers()
     test_enable_watchdog()
     test_multiprocessing_timeout_interval()
+    test_row_batch_size()
     test_config_bool_type_error()
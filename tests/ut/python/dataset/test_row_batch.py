@@ -0,0 +1,104 @@
+# Copyright 2022 Huawei Technologies Co., Ltd
+#
+# Licensed under the Apache License, Version 2.0 (the "License");
+# you may not use this file except in compliance with the License.
+# You may obtain a copy of the License at
+#
+# http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing, software
+# distributed under the License is distributed on an "AS IS" BASIS,
+# WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+# See the License for the specific language governing permissions and
+# limitations under the License.
+# ==============================================================================
+"""
+Testing the pipelines handing the rows over in batches between the dataset operations
+"""
+import numpy as np
+import pytest
+
+import mindspore.dataset as ds
+
+BATCH_SIZE = 4
+REPEAT_COUNT = 2
+NUM_EPOCHS = 2
+
+
+def generator(num_rows):
+    for i in range(num_rows):
+        yield (np.array([i], dtype=np.int64),)
+
+
+def expected_epoch(num_rows):
+    """
+    The batches of one epoch computed without the pipeline.
+    """
+    rows = [i * 2 for i in range(num_rows) if (i * 2) % 3 != 0]
+    batches = [rows[i:i + BATCH_SIZE] for i in range(0, len(rows), BATCH_SIZE)]
+    return batches * REPEAT_COUNT
+
+
+def run_pipeline(num_rows, row_batch_size, num_parallel_workers):
+    """
+    Run Map -> Filter -> Batch -> Repeat for several epochs with the row batch size, and return the batches of each
+    epoch.
+    """
+    original_row_batch_size = ds.config.get_row_batch_size()
+    ds.config.set_row_batch_size(row_batch_size)
+    try:
+        data = ds.GeneratorDataset(lambda: generator(num_rows), ["data"], shuffle=False)
+        data = data.map(operations=lambda x: x * 2, input_columns=["data"], num_parallel_workers=num_parallel_workers)
+        data = data.filter(predicate=lambda x: x[0] % 3 != 0, input_columns=["data"],
+                           num_parallel_workers=num_parallel_workers)
+        data = data.batch(BATCH_SIZE, drop_remainder=False, num_parallel_workers=num_parallel_workers)
+        data = data.repeat(REPEAT_COUNT)
+        epochs = []
+        iterator = data.create_tuple_iterator(num_epochs=NUM_EPOCHS, output_numpy=True)
+        for _ in range(NUM_EPOCHS):
+            epochs.append([item[0].flatten().tolist() for item in iterator])
+        return epochs
+    finally:
+        ds.config.set_row_batch_size(original_row_batch_size)
+
+
+@pytest.mark.parametrize("num_parallel_workers", [1, 4])
+@pytest.mark.parametrize("num_rows", [5, 100])
+def test_row_batch_same_output(num_rows, num_parallel_workers):
+    """
+    Feature: Row batch of the dataset pipelines.
+    Description: Run Map -> Filter -> Batch -> Repeat for two epochs with the rows handed over one by one and in
+        batches, including the batch size which doesn't divide the row number and the one larger than it.
+    Expectation: All the runs output the same batches in the same order in every epoch, and none of the rows are
+        lost or held back across the repeat and epoch boundaries.
+    """
+    expected = [expected_epoch(num_rows)] * NUM_EPOCHS
+    assert run_pipeline(num_rows, 0, num_parallel_workers) == expected
+    for row_batch_size in [1, 3, 64]:
+        assert run_pipeline(num_rows, row_batch_size, num_parallel_workers) == expected
+
+
+def test_row_batch_empty_epoch():
+    """
+    Feature: Row batch of the dataset pipelines.
+    Description: Run the pipeline whose filter drops all the rows with the rows handed over in batches.
+    Expectation: Every epoch ends without any row instead of waiting for a full batch.
+    """
+    original_row_batch_size = ds.config.get_row_batch_size()
+    ds.config.set_row_batch_size(64)
+    try:
+        data = ds.GeneratorDataset(lambda: generator(10), ["data"], shuffle=False)
+        data = data.map(operations=lambda x: x * 3, input_columns=["data"], num_parallel_workers=2)
+        data = data.filter(predicate=lambda x: x[0] % 3 != 0, input_columns=["data"], num_parallel_workers=2)
+        data = data.repeat(REPEAT_COUNT)
+        iterator = data.create_tuple_iterator(num_epochs=NUM_EPOCHS, output_numpy=True)
+        for _ in range(NUM_EPOCHS):
+            assert not list(iterator)
+    finally:
+        ds.config.set_row_batch_size(original_row_batch_size)
+
+
+if __name__ == '__main__':
+    test_row_batch_same_output(5, 1)
+    test_row_batch_same_output(100, 4)
+    test_row_batch_empty_epoch()